@@ -642,10 +642,13 @@ mufft_plan_1d *mufft_create_plan_1d_c2c(unsigned N, int direction, unsigned flag
         goto error;
     }
 
-    plan->tmp_buffer = mufft_alloc(N * sizeof(cfloat));
-    if (plan->tmp_buffer == NULL)
+    if ((flags & MUFFT_FLAG_NO_TMP_BUFFER) == 0)
     {
-        goto error;
+        plan->tmp_buffer = mufft_alloc(N * sizeof(cfloat));
+        if (plan->tmp_buffer == NULL)
+        {
+            goto error;
+        }
     }
 
     if (!build_plan_1d(&plan->steps, &plan->num_steps, N, direction, flags))
@@ -809,10 +812,16 @@ void mufft_execute_conv_output(mufft_plan_conv *plan, void *output, const void *
 }
 
 void mufft_execute_plan_1d(mufft_plan_1d *plan, void * MUFFT_RESTRICT output, const void * MUFFT_RESTRICT input)
+{
+    mufft_execute_plan_1d_with_buffer(plan, output, input, plan->tmp_buffer);
+}
+
+void mufft_execute_plan_1d_with_buffer(const mufft_plan_1d *plan, void * MUFFT_RESTRICT output, const void * MUFFT_RESTRICT input,
+        void * MUFFT_RESTRICT tmp_buffer)
 {
     const cfloat *pt = plan->twiddles;
     cfloat *out = output;
-    cfloat *in = plan->tmp_buffer;
+    cfloat *in = tmp_buffer;
     unsigned N = plan->N;
 
     // If we're doing real-to-complex, we need an extra step.
@@ -63,6 +63,9 @@ extern "C" {
 /// The second/upper half of the input array is assumed to be 0 and will not be read and memory for the second half of the input array does not have to be allocated.
 /// This is mostly useful when you want to do zero-padded FFTs which are very common for convolution-type operations, see \ref MUFFT_CONV. This flag is only recognized for 1D transforms.
 #define MUFFT_FLAG_ZERO_PAD_UPPER_HALF (1 << 17)
+/// The 1D plan does not allocate its own temporary buffer. Such plans must be executed with \ref mufft_execute_plan_1d_with_buffer.
+/// This is useful for plans shared between threads, which need a temporary buffer per thread anyway. This flag is only recognized for 1D transforms.
+#define MUFFT_FLAG_NO_TMP_BUFFER (1 << 18)
 /// @}
 
 /// \addtogroup MUFFT_1D 1D real and complex FFT
@@ -111,11 +114,21 @@ mufft_plan_1d *mufft_create_plan_1d_r2c(unsigned N, unsigned flags);
 mufft_plan_1d *mufft_create_plan_1d_c2r(unsigned N, unsigned flags);
 
 /// \brief Executes a 1D FFT plan.
-/// @param plan Previously allocated 1D FFT plan.
+/// @param plan Previously allocated 1D FFT plan. Must not be created with \ref MUFFT_FLAG_NO_TMP_BUFFER.
 /// @param output Output of the transform. The data must be aligned. See \ref MUFFT_MEMORY.
 /// @param input Input to the transform. The data must be aligned. See \ref MUFFT_MEMORY.
 void mufft_execute_plan_1d(mufft_plan_1d *plan, void * MUFFT_RESTRICT output, const void * MUFFT_RESTRICT input);
 
+/// \brief Executes a 1D FFT plan using a caller provided temporary buffer.
+///
+/// The plan is only read, so a plan can be shared between threads if each thread provides its own temporary buffer.
+/// @param plan Previously allocated 1D FFT plan.
+/// @param output Output of the transform. The data must be aligned. See \ref MUFFT_MEMORY.
+/// @param input Input to the transform. The data must be aligned. See \ref MUFFT_MEMORY.
+/// @param tmp_buffer Temporary buffer of at least N complex values where N is the transform size of the plan. The data must be aligned. See \ref MUFFT_MEMORY.
+void mufft_execute_plan_1d_with_buffer(const mufft_plan_1d *plan, void * MUFFT_RESTRICT output, const void * MUFFT_RESTRICT input,
+        void * MUFFT_RESTRICT tmp_buffer);
+
 /// \brief Free a previously allocated 1D FFT plan.
 /// @param plan A plan. May be `NULL` in which case nothing happens.
 void mufft_free_plan_1d(mufft_plan_1d *plan);
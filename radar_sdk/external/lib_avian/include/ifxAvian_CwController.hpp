@@ -38,10 +38,13 @@
 #include "ifxAvian_IPort.hpp"
 #include "ifxAvian_Types.hpp"
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -61,6 +64,27 @@ public:
     template <typename T>
     using Range = std::pair<T, T>;
 
+    /*!
+     * This type defines the callback that receives the captured data while
+     * streaming is active (see \ref start_streaming).
+     *
+     * The first argument points to the raw ADC samples of one capture. The
+     * samples of all enabled RX antennas are interleaved, so the buffer
+     * contains number of samples times number of enabled RX antennas values
+     * in the range 0...4095. The buffer is only valid during the callback,
+     * afterwards it is reused for another capture.
+     *
+     * The second argument is the number of captures that have been lost
+     * before the current one due to a data timeout. If it is not 0, there
+     * is a gap between the previous and the current capture.
+     *
+     * If the Avian device stops responding, the callback is invoked a last
+     * time with a null pointer and streaming ends. In that case the device
+     * has been reset, so continuous wave mode is disabled.
+     */
+    using Stream_Callback_t = std::function<void(const uint16_t* raw_data,
+                                                 unsigned num_lost_captures)>;
+
     /*!
      * This type enumerates the available modes of the Avian device's test
      * signal generator.
@@ -344,6 +368,7 @@ public:
      *   HW::IReadPort<HW::Packed_Raw_Data_t>,
      * - Continuous wave mode is not enabled,
      * - All RX antennas are disabled,
+     * - Streaming is active,
      * - A hardware failure occurred.
      *
      * \return The captured signals are returned as a map that uses the 0 based
@@ -354,6 +379,48 @@ public:
      */
     std::map<unsigned, std::vector<float>> capture_rx_signals();
 
+    /*!
+     * This method starts continuous capturing of RX antenna signals.
+     *
+     * In contrast to \ref capture_rx_signals the data reader is set up only
+     * once and kept running. A background thread triggers the captures back
+     * to back into a ring of raw data buffers, and a second thread passes
+     * each completed buffer to the provided callback. The next capture is
+     * armed as soon as the previous one has been read, so the callback may
+     * take longer than one capture for a while without causing gaps. Only
+     * if all buffers are waiting for the callback, acquisition waits for it.
+     *
+     * While streaming is active, \ref capture_rx_signals and the measurement
+     * methods must not be used. Changing any parameter stops streaming,
+     * because the device is reconfigured.
+     *
+     * This method throws an exception in the same cases as
+     * \ref capture_rx_signals or if streaming is already active.
+     *
+     * \param[in] callback  The function that receives the captured data. It
+     *                      is called from the delivery thread.
+     * \param[in] on_thread_start  Optional function called once by the
+     *                      acquisition and by the delivery thread before the
+     *                      first capture, e.g. to set the scheduling policy
+     *                      of the threads.
+     * \param[in] num_buffers  The number of raw data buffers in the ring,
+     *                      at least 2.
+     */
+    void start_streaming(Stream_Callback_t callback,
+                         std::function<void()> on_thread_start = {},
+                         unsigned num_buffers = 4);
+
+    /*!
+     * This method stops streaming. The capture in progress is completed and
+     * all captured buffers are delivered before the method returns. The
+     * device is reset and the continuous wave configuration is restored. If streaming is not active,
+     * nothing happens.
+     */
+    void stop_streaming();
+
+    //! This method returns true while streaming is active.
+    bool is_streaming() const;
+
     /*!
      * This method sets the gain of the Avian device's baseband high pass
      * filter.
@@ -532,17 +599,52 @@ private:
      */
     bool go_to_active_state();
 
+    /*!
+     * This method resets the Avian device and sends the continuous wave
+     * configuration to it. If the device can't be put to active power
+     * state, continuous wave mode is disabled and an exception is thrown.
+     */
+    void configure_continuous_wave();
+
+    /*!
+     * This method checks if data can be acquired and returns the port to
+     * read the data from. If acquisition is not possible, an exception is
+     * thrown.
+     */
+    HW::IReadPort<HW::Packed_Raw_Data_t>& get_read_port() const;
+
+    /*!
+     * This method prepares the Avian device for data acquisition and returns
+     * the SPI commands that trigger one capture.
+     */
+    std::vector<HW::Spi_Command_t> prepare_acquisition();
+
+    /*!
+     * This is the body of the acquisition thread. It triggers captures until
+     * \ref stop_streaming is called or the Avian device stops responding.
+     * Completed buffers are handed to a delivery thread that invokes the
+     * callback. When streaming ends, the device is reset.
+     */
+    void run_streaming(HW::IReadPort<HW::Packed_Raw_Data_t>& read_port,
+                       std::vector<HW::Spi_Command_t> trigger_commands,
+                       Stream_Callback_t callback,
+                       std::function<void()> on_thread_start,
+                       unsigned num_buffers);
+
     HW::IControlPort& m_port;
     std::unique_ptr<Driver> m_driver;
     double m_continuous_wave_frequency;
     unsigned m_continuous_wave_power;
     Test_Signal_Generator_Mode m_test_signal_mode;
     uint32_t m_test_signal_frequency_divider;
-    bool m_continuous_wave_enabled;
+    std::atomic<bool> m_continuous_wave_enabled;
     std::bitset<2> m_tx_mask;
     std::bitset<4> m_rx_mask;
     uint16_t m_num_samples;
     std::array<HW::Spi_Command_t, 2> m_toggle_commands;
+    std::thread m_stream_thread;
+    std::atomic<bool> m_stream_running;
+    std::atomic<bool> m_stream_stop_requested;
 };
 
 /* ------------------------------------------------------------------------ */
@@ -35,6 +35,7 @@
 
 // ---------------------------------------------------------------------------- includes
 #include <cstdint>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -55,6 +56,7 @@ class RegisterSet;
 namespace TimingModel {
 
 class ModelBGT60TRxxC;
+class SequenceParameters;
 struct ShapeSettings;
 
 // ---------------------------------------------------------------------------- Ticks
@@ -828,6 +830,207 @@ inline unsigned StateSequence::Iterator::getFifoFillState() const
     return m_uFifoFillState;
 }
 
+// ---------------------------------------------------------------------------- SequenceTiming
+/**
+ * @brief Closed-form timing of an acquisition sequence
+ *
+ * StateSequence runs the state machine model step by step and builds the
+ * complete list of states, which is needed to display or export a sequence.
+ * If only the repetition times and the power consumption are of interest,
+ * this class is the cheaper alternative. It computes the durations of the
+ * chirps, shape sets and frames directly from the timing parameters. The
+ * results are the same as those of StateSequence.
+ *
+ * The timing parameters can be modified one by one through the set functions.
+ * Each modification only recomputes the affected shape, so a modified
+ * configuration is evaluated with a few arithmetic operations. This allows
+ * to tune delays and to search for configurations meeting given constraints
+ * without programming a driver for each candidate.
+ */
+class SequenceTiming
+{
+public:
+    explicit SequenceTiming(const Driver& driver);
+    SequenceTiming(const HW::RegisterSet& registers, Device_Type device_type,
+                   double ref_frequency = 80.0e6);
+    SequenceTiming(SequenceTiming&&) noexcept;
+    ~SequenceTiming();
+
+    /**
+     * @brief This function reloads all timing parameters from a driver.
+     *
+     * This is needed after the driver configuration was changed. Device type
+     * and reference frequency are expected not to change.
+     *
+     * @param[in] driver    The driver the parameters are taken from.
+     */
+    void update(const Driver& driver);
+
+    /**
+     * @brief This function reloads all timing parameters from a register set.
+     *
+     * @param[in] registers The register set the parameters are taken from.
+     */
+    void update(const HW::RegisterSet& registers);
+
+    /**
+     * @brief This function returns the time period between two consecutive
+     *        chirps.
+     *
+     * @param[in] uShape     The index of the shape of interest.
+     *                       Valid range is 0...3.
+     *
+     * @return The time period in clock cycles between the start of one chirp
+     *         and the start of the following chirp of the same shape. If the
+     *         shape is not used, 0 is returned.
+     */
+    Ticks getChirpToChirpTime(unsigned uShape) const;
+
+    /**
+     * @brief This function returns the time period between two consecutive
+     *        shape sets.
+     *
+     * @return The time period in clock cycles between the start of one shape
+     *         set and the start of the following shape set.
+     */
+    Ticks getSetToSetTime() const;
+
+    /**
+     * @brief This function returns the time period between two consecutive
+     *        frames.
+     *
+     * @return The time period in clock cycles between the start of one frame
+     *         and the start of the following frame.
+     */
+    Ticks getFrameDuration() const;
+
+    /**
+     * @brief This function returns the acquisition time of a frame.
+     *
+     * @return The time in clock cycles from the start of the frame (including
+     *         the wake up from deep sleep) until the end of the last chirp.
+     */
+    Ticks getAcquisitionDuration() const;
+
+    /**
+     * @brief This function returns the amount of time spent in active mode
+     *        during a frame.
+     *
+     * @return The active time inside a frame in seconds.
+     */
+    double getFrameActiveDuration() const;
+
+    /**
+     * @brief This function returns the average power consumption during a
+     *        frame.
+     *
+     * In contrast to StateSequence the groups of an incomplete last shape
+     * set are taken into account.
+     *
+     * @return The average power consumption in Watts.
+     */
+    double getFrameAveragePowerConsumption() const;
+
+    /**
+     * @brief This function returns the time needed to wake up from a power
+     *        mode.
+     *
+     * @param[in] ePowerMode  The power mode after a shape or frame end delay.
+     *
+     * @return The number of clock cycles from the end of the delay until the
+     *         next shape starts.
+     */
+    Ticks getWakeUpTime(PowerMode ePowerMode) const;
+
+    unsigned getNumRepetitions(unsigned uShape) const;
+    unsigned getAdcDivider() const;
+
+    /**
+     * @brief This function changes the ADC sampling rate divider.
+     *
+     * The ramp times of all chirps are adapted to the new sampling time the
+     * same way the driver does.
+     */
+    void setAdcDivider(uint16_t uAdcDivider);
+
+    /**
+     * @brief This function changes the number of samples of a chirp.
+     *
+     * The ramp time of the chirp is adapted the same way the driver does.
+     *
+     * @param[in] uShape       The index of the shape (0...3).
+     * @param[in] bDownChirp   False for the first chirp of the shape, true for
+     *                         the second chirp of a triangle shape.
+     * @param[in] uNumSamples  The number of samples.
+     */
+    void setNumSamples(unsigned uShape, bool bDownChirp, uint16_t uNumSamples);
+
+    /**
+     * @brief This function changes the chirp end delay of a chirp.
+     *
+     * @param[in] uShape       The index of the shape (0...3).
+     * @param[in] bDownChirp   False for the first chirp of the shape, true for
+     *                         the second chirp (or the second delay of a saw
+     *                         tooth shape).
+     * @param[in] dDelay       The delay in clock cycles as applied by the
+     *                         state machine.
+     */
+    void setChirpEndDelay(unsigned uShape, bool bDownChirp, Ticks dDelay);
+
+    void setNumRepetitions(unsigned uShape, uint16_t uNumRepetitions);
+    void setShapeEndDelay(unsigned uShape, Ticks dDelay, PowerMode ePowerMode);
+    void setFrameEndDelay(Ticks dDelay, PowerMode ePowerMode);
+    void setNumShapeGroupsPerFrame(uint16_t uNumShapeGroups);
+
+    inline double getOscFrequency() const
+    {
+        return m_dOscFrequency;
+    }
+
+    inline double toSeconds(Ticks ticks) const
+    {
+        return ticks / m_dOscFrequency;
+    }
+
+private:
+    struct ShapeTiming
+    {
+        uint64_t uShapeTime = 0;    /* one repetition, up to shape end delay */
+        uint64_t uShapeEndTime = 0; /* shape end delay and wake up */
+        uint64_t uActiveTime = 0;   /* time in active mode during one repetition */
+        uint64_t uCarry = 0;        /* parallel timers still running when next shape starts */
+        double dShapeWork = 0.0;    /* energy of one repetition in W * ticks */
+        double dShapeEndWork = 0.0;
+    };
+
+    struct GroupTotals
+    {
+        uint64_t uTime = 0;
+        uint64_t uActiveTime = 0;
+        double dWork = 0.0;
+
+        void add(const ShapeTiming& sShape, uint64_t uNumRepetitions);
+    };
+
+    void loadParameters(const HW::RegisterSet& registers);
+    void updateShapes(unsigned uFirstShape);
+    uint64_t getWakeUpTime(PowerMode ePowerMode, uint64_t* pCarry, double* pWork) const;
+    uint64_t getChirpTime(unsigned uShape, bool bDownChirp, uint64_t uCarry,
+                          uint64_t* pActiveTime, double* pWork) const;
+    GroupTotals getFrameTotals() const;
+
+    Device_Type m_eDeviceType;
+    double m_dOscFrequency;
+    std::unique_ptr<SequenceParameters> m_pParameters;
+    std::unique_ptr<ModelBGT60TRxxC> m_pModel;
+
+    unsigned m_uNumUsedShapes = 1;
+    uint64_t m_uPrefixTime = 0;
+    uint64_t m_uPrefixCarry = 0;
+    double m_dPrefixWork = 0.0;
+    ShapeTiming m_sShapes[4];
+};
+
 /* ------------------------------------------------------------------------ */
 }  // namespace TimingModel
 }  // namespace Avian
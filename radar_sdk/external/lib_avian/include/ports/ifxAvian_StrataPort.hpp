@@ -87,6 +87,12 @@ public:
 
     void onNewFrame(IFrame* frame) override;
 
+    /**
+     * \brief The raw data is unpacked in the data ready callback, so the
+     * forwarder thread calling onNewFrame takes the converter role.
+     */
+    ThreadRole getThreadRole() const override;
+
     /**
      * \brief Register error callback.
      *
@@ -44,6 +44,7 @@
 #include <algorithm>
 #include <cmath>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <stdexcept>
 
@@ -88,7 +89,9 @@ Continuous_Wave_Controller::Continuous_Wave_Controller(HW::IControlPort& port,
     m_tx_mask(1),
     m_rx_mask(1),
     m_num_samples(64),
-    m_toggle_commands {0}
+    m_toggle_commands {0},
+    m_stream_running(false),
+    m_stream_stop_requested(false)
 {
     /*
      * A frame with just one chirp per frame is defined.That frame type is used
@@ -137,173 +140,178 @@ Device_Type Continuous_Wave_Controller::get_device_type() const
 // ---------------------------------------------------------------------------- enable_continuous_wave
 void Continuous_Wave_Controller::enable_continuous_wave(bool enable)
 {
+    // Streaming can't continue while the device is reconfigured.
+    stop_streaming();
+
     m_continuous_wave_enabled = enable;
     if (enable)
-    {
-        auto& device_traits = Device_Traits::get(m_driver->get_device_type());
+        configure_continuous_wave();
+    else
+        m_port.generate_reset_sequence();
+}
 
-        uint32_t frequency_kHz = unsigned(m_continuous_wave_frequency / 1000.0);
+// ---------------------------------------------------------------------------- configure_continuous_wave
+void Continuous_Wave_Controller::configure_continuous_wave()
+{
+    auto& device_traits = Device_Traits::get(m_driver->get_device_type());
 
-        // First the driver is used to configure the chip for normal operation
-        Frame_Format cfg_frame {};
-        cfg_frame.num_chirps_per_frame = 1;
-        cfg_frame.rx_mask = uint8_t(m_rx_mask.to_ulong());
-        cfg_frame.num_samples_per_chirp = m_num_samples;
-        m_driver->set_frame_format(&cfg_frame);
+    uint32_t frequency_kHz = unsigned(m_continuous_wave_frequency / 1000.0);
 
-        Fmcw_Configuration cfg_fmcw {};
-        cfg_fmcw.lower_frequency_kHz = frequency_kHz;
-        cfg_fmcw.upper_frequency_kHz = frequency_kHz;
-        cfg_fmcw.shape_type = Shape_Type::Saw_Up;
-        cfg_fmcw.tx_power = uint8_t(m_continuous_wave_power);
-        m_driver->set_fmcw_configuration(&cfg_fmcw);
+    // First the driver is used to configure the chip for normal operation
+    Frame_Format cfg_frame {};
+    cfg_frame.num_chirps_per_frame = 1;
+    cfg_frame.rx_mask = uint8_t(m_rx_mask.to_ulong());
+    cfg_frame.num_samples_per_chirp = m_num_samples;
+    m_driver->set_frame_format(&cfg_frame);
 
-        m_driver->set_tx_mode(m_tx_mask[0]
-                                  ? (m_tx_mask[1] ? Tx_Mode::Alternating
-                                                  : Tx_Mode::Tx1_Only)
-                                  : (m_tx_mask[1] ? Tx_Mode::Tx2_Only
-                                                  : Tx_Mode::Off));
+    Fmcw_Configuration cfg_fmcw {};
+    cfg_fmcw.lower_frequency_kHz = frequency_kHz;
+    cfg_fmcw.upper_frequency_kHz = frequency_kHz;
+    cfg_fmcw.shape_type = Shape_Type::Saw_Up;
+    cfg_fmcw.tx_power = uint8_t(m_continuous_wave_power);
+    m_driver->set_fmcw_configuration(&cfg_fmcw);
 
-        m_driver->set_slice_size(uint16_t(m_num_samples * m_rx_mask.count()));
+    m_driver->set_tx_mode(m_tx_mask[0]
+                              ? (m_tx_mask[1] ? Tx_Mode::Alternating
+                                              : Tx_Mode::Tx1_Only)
+                              : (m_tx_mask[1] ? Tx_Mode::Tx2_Only
+                                              : Tx_Mode::Off));
 
-        /*
-         * Afterwards the register set generated by the driver is modified
-         * to adjust it continuous wave mode.
-         */
-        auto registers = m_driver->get_device_configuration();
+    m_driver->set_slice_size(uint16_t(m_num_samples * m_rx_mask.count()));
 
-        // TX power sensors are enabled for measurement.
-        registers.set(registers[BGT60TRxxC_REG_CS1_U_0]
-                      | BGT60TRxxC_SET(CS1_U_0, PD1_EN, 1)
-                      | BGT60TRxxC_SET(CS1_U_0, PD2_EN, 1));
+    /*
+     * Afterwards the register set generated by the driver is modified
+     * to adjust it continuous wave mode.
+     */
+    auto registers = m_driver->get_device_configuration();
 
-        /*
-         * CW mode is enabled
-         * - Setting the CW mode bit makes the state machine wait for a new
-         *   trigger before going to the next state.
-         * - Setting the BYPRMPEN lets PLL stay at start frequency instead of
-         *   generating a ramp.
-         */
-        registers.set(BGT60TRxxC_SET(PDFT0, BYPRMPEN, 1));
-        registers.set(registers[BGT60TRxxC_REG_MAIN]
-                      | BGT60TRxxC_SET(MAIN, CW_MODE, 1));
+    // TX power sensors are enabled for measurement.
+    registers.set(registers[BGT60TRxxC_REG_CS1_U_0]
+                  | BGT60TRxxC_SET(CS1_U_0, PD1_EN, 1)
+                  | BGT60TRxxC_SET(CS1_U_0, PD2_EN, 1));
 
-        /*
-         * If the device does not have an SADC, MADC must be enabled to be
-         * ready for temperature and power measurement. MADC can't be enabled
-         * directly, it must be enabled implicitly by enabling at least one RX
-         * channel.
-         */
-        if (!device_traits.has_sadc)
-        {
-            registers.set(registers[BGT60TRxxC_REG_CS1_U_1]
-                          | BGT60TRxxC_SET(CS1_U_1, BBCH_SEL, 1));
-        }
+    /*
+     * CW mode is enabled
+     * - Setting the CW mode bit makes the state machine wait for a new
+     *   trigger before going to the next state.
+     * - Setting the BYPRMPEN lets PLL stay at start frequency instead of
+     *   generating a ramp.
+     */
+    registers.set(BGT60TRxxC_SET(PDFT0, BYPRMPEN, 1));
+    registers.set(registers[BGT60TRxxC_REG_MAIN]
+                  | BGT60TRxxC_SET(MAIN, CW_MODE, 1));
 
-        // By default toggle command sequence is cleared.
-        m_toggle_commands[0] = 0;
+    /*
+     * If the device does not have an SADC, MADC must be enabled to be
+     * ready for temperature and power measurement. MADC can't be enabled
+     * directly, it must be enabled implicitly by enabling at least one RX
+     * channel.
+     */
+    if (!device_traits.has_sadc)
+    {
+        registers.set(registers[BGT60TRxxC_REG_CS1_U_1]
+                      | BGT60TRxxC_SET(CS1_U_1, BBCH_SEL, 1));
+    }
+
+    // By default toggle command sequence is cleared.
+    m_toggle_commands[0] = 0;
 
-        // Test signal generator is configured.
-        if (m_test_signal_mode == Test_Signal_Generator_Mode::Off)
+    // Test signal generator is configured.
+    if (m_test_signal_mode == Test_Signal_Generator_Mode::Off)
+    {
+        registers.set(BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV_EN, 0));
+    }
+    else if (m_test_signal_mode == Test_Signal_Generator_Mode::Test_Baseband)
+    {
+        registers.set(BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV,
+                                     m_test_signal_frequency_divider)
+                      | BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV_EN, 1)
+                      | BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 0)
+                      | BGT60TRxxC_SET(RFT0, TEST_SIG_IF_EN, m_rx_mask.to_ulong()));
+
+        // For baseband testing, RX mixers are disabled
+        uint32_t reg_cs1u = registers[BGT60TRxxC_REG_CS1_U_0];
+        if (m_rx_mask[0])
+            reg_cs1u &= ~BGT60TRxxC_CS1_U_0_RX1LOBUF_EN_msk
+                        & ~BGT60TRxxC_CS1_U_0_RX1MIX_EN_msk;
+        if (m_rx_mask[1])
+            reg_cs1u &= ~BGT60TRxxC_CS1_U_0_RX2LOBUF_EN_msk
+                        & ~BGT60TRxxC_CS1_U_0_RX2MIX_EN_msk;
+        if (m_rx_mask[2])
+            reg_cs1u &= ~BGT60TRxxC_CS1_U_0_RX3LOBUF_EN_msk
+                        & ~BGT60TRxxC_CS1_U_0_RX3MIX_EN_msk;
+        if (m_rx_mask[3])
+            reg_cs1u &= ~BGT60TRxxC_CS1_U_0_RX4LOBUF_EN_msk
+                        & ~BGT60TRxxC_CS1_U_0_RX4MIX_EN_msk;
+        registers.set(BGT60TRxxC_REG_CS1_U_0, reg_cs1u);
+    }
+    else if (device_traits.supports_tx_toggling)
+    {
+        auto command_RFT0 = BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV,
+                                           m_test_signal_frequency_divider)
+                            | BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV_EN, 1)
+                            | BGT60TRxxC_SET(RFT0, TEST_SIG_IF_EN, 0);
+
+        if (m_test_signal_mode == Test_Signal_Generator_Mode::Toggle_Tx_Enable)
         {
-            registers.set(BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV_EN, 0));
+            command_RFT0 |= BGT60TRxxD_SET(RFT0, RF_TEST_MODE, 1)
+                            | BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 0);
         }
-        else if (m_test_signal_mode == Test_Signal_Generator_Mode::Test_Baseband)
+        else if (m_test_signal_mode == Test_Signal_Generator_Mode::Toggle_Dac_Value)
         {
-            registers.set(BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV,
-                                         m_test_signal_frequency_divider)
-                          | BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV_EN, 1)
-                          | BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 0)
-                          | BGT60TRxxC_SET(RFT0, TEST_SIG_IF_EN, m_rx_mask.to_ulong()));
-
-            // For baseband testing, RX mixers are disabled
-            uint32_t reg_cs1u = registers[BGT60TRxxC_REG_CS1_U_0];
-            if (m_rx_mask[0])
-                reg_cs1u &= ~BGT60TRxxC_CS1_U_0_RX1LOBUF_EN_msk
-                            & ~BGT60TRxxC_CS1_U_0_RX1MIX_EN_msk;
-            if (m_rx_mask[1])
-                reg_cs1u &= ~BGT60TRxxC_CS1_U_0_RX2LOBUF_EN_msk
-                            & ~BGT60TRxxC_CS1_U_0_RX2MIX_EN_msk;
-            if (m_rx_mask[2])
-                reg_cs1u &= ~BGT60TRxxC_CS1_U_0_RX3LOBUF_EN_msk
-                            & ~BGT60TRxxC_CS1_U_0_RX3MIX_EN_msk;
-            if (m_rx_mask[3])
-                reg_cs1u &= ~BGT60TRxxC_CS1_U_0_RX4LOBUF_EN_msk
-                            & ~BGT60TRxxC_CS1_U_0_RX4MIX_EN_msk;
-            registers.set(BGT60TRxxC_REG_CS1_U_0, reg_cs1u);
+            command_RFT0 |= BGT60TRxxD_SET(RFT0, RF_TEST_MODE, 2)
+                            | BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 0);
         }
-        else if (device_traits.supports_tx_toggling)
+        else if (m_test_signal_mode == Test_Signal_Generator_Mode::Rx_Self_Test)
         {
-            auto command_RFT0 = BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV,
-                                               m_test_signal_frequency_divider)
-                                | BGT60TRxxC_SET(RFT0, RFTSIGCLK_DIV_EN, 1)
-                                | BGT60TRxxC_SET(RFT0, TEST_SIG_IF_EN, 0);
-
-            if (m_test_signal_mode == Test_Signal_Generator_Mode::Toggle_Tx_Enable)
-            {
-                command_RFT0 |= BGT60TRxxD_SET(RFT0, RF_TEST_MODE, 1)
-                                | BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 0);
-            }
-            else if (m_test_signal_mode == Test_Signal_Generator_Mode::Toggle_Dac_Value)
-            {
-                command_RFT0 |= BGT60TRxxD_SET(RFT0, RF_TEST_MODE, 2)
-                                | BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 0);
-            }
-            else if (m_test_signal_mode == Test_Signal_Generator_Mode::Rx_Self_Test)
-            {
-                command_RFT0 |= BGT60TRxxD_SET(RFT0, RF_TEST_MODE, 3)
-                                | BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 1);
-            }
-            registers.set(command_RFT0);
+            command_RFT0 |= BGT60TRxxD_SET(RFT0, RF_TEST_MODE, 3)
+                            | BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 1);
         }
-        else
+        registers.set(command_RFT0);
+    }
+    else
+    {
+        /*
+         * If the Avian device does not support the selected generator
+         * mode. The test signal is generated by toggling the according
+         * bit field via SPI, while data is acquired. In this case the test
+         * signal frequency is ignored. The resulting test signal frequency
+         * depends only on SPI clock rate.
+         * At this point the commands for toggling a bit field are setup.
+         * The actual toggling happens in the method capture_rx_signals.
+         */
+        if (m_test_signal_mode == Test_Signal_Generator_Mode::Toggle_Tx_Enable)
         {
-            /*
-             * If the Avian device does not support the selected generator
-             * mode. The test signal is generated by toggling the according
-             * bit field via SPI, while data is acquired. In this case the test
-             * signal frequency is ignored. The resulting test signal frequency
-             * depends only on SPI clock rate.
-             * At this point the commands for toggling a bit field are setup.
-             * The actual toggling happens in the method capture_rx_signals.
-             */
-            if (m_test_signal_mode == Test_Signal_Generator_Mode::Toggle_Tx_Enable)
-            {
-                m_toggle_commands[1] = registers[BGT60TRxxC_REG_CS1_U_0]
-                                       | BGT60TRxxC_SET(CS1_U_0, TX1_EN, 0);
-                m_toggle_commands[0] = m_toggle_commands[1]
-                                       & ~BGT60TRxxC_CS1_U_0_TX1_EN_msk;
-            }
-            else if (m_test_signal_mode == Test_Signal_Generator_Mode::Toggle_Dac_Value)
-            {
-                m_toggle_commands[1] = registers[BGT60TRxxC_REG_CS1_U_1]
-                                       | BGT60TRxxC_SET(CS1_U_1, TX1_DAC, 0);
-                m_toggle_commands[0] = m_toggle_commands[1]
-                                       & ~BGT60TRxxC_CS1_U_1_TX1_DAC_msk;
-            }
-            else if (m_test_signal_mode == Test_Signal_Generator_Mode::Rx_Self_Test)
-            {
-                m_toggle_commands[0] = BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 1);
-                m_toggle_commands[1] = BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 0);
-            }
+            m_toggle_commands[1] = registers[BGT60TRxxC_REG_CS1_U_0]
+                                   | BGT60TRxxC_SET(CS1_U_0, TX1_EN, 0);
+            m_toggle_commands[0] = m_toggle_commands[1]
+                                   & ~BGT60TRxxC_CS1_U_0_TX1_EN_msk;
         }
-
-        // The final configuration is sent to the Avian device.
-        m_port.generate_reset_sequence();
-        initialize_reference_clock(m_port, m_driver->get_clock_config_command());
-        registers.send_to_device(m_port, false);
-
-        // Power amplifiers are enabled.
-        if (!go_to_active_state())
+        else if (m_test_signal_mode == Test_Signal_Generator_Mode::Toggle_Dac_Value)
         {
-            m_port.generate_reset_sequence();
-            m_continuous_wave_enabled = false;
-            throw std::runtime_error("A hardware failure occurred.");
+            m_toggle_commands[1] = registers[BGT60TRxxC_REG_CS1_U_1]
+                                   | BGT60TRxxC_SET(CS1_U_1, TX1_DAC, 0);
+            m_toggle_commands[0] = m_toggle_commands[1]
+                                   & ~BGT60TRxxC_CS1_U_1_TX1_DAC_msk;
+        }
+        else if (m_test_signal_mode == Test_Signal_Generator_Mode::Rx_Self_Test)
+        {
+            m_toggle_commands[0] = BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 1);
+            m_toggle_commands[1] = BGT60TRxxC_SET(RFT0, TEST_SIG_RF_EN, 0);
         }
     }
-    else
+
+    // The final configuration is sent to the Avian device.
+    m_port.generate_reset_sequence();
+    initialize_reference_clock(m_port, m_driver->get_clock_config_command());
+    registers.send_to_device(m_port, false);
+
+    // Power amplifiers are enabled.
+    if (!go_to_active_state())
     {
         m_port.generate_reset_sequence();
+        m_continuous_wave_enabled = false;
+        throw std::runtime_error("A hardware failure occurred.");
     }
 }
 
@@ -581,50 +589,28 @@ float Continuous_Wave_Controller::get_sampling_rate() const
     return float(sampling_rate);
 }
 
-// ---------------------------------------------------------------------------- capture_rx_signals
-std::map<unsigned, std::vector<float>> Continuous_Wave_Controller::capture_rx_signals()
+// ---------------------------------------------------------------------------- get_read_port
+HW::IReadPort<HW::Packed_Raw_Data_t>& Continuous_Wave_Controller::get_read_port() const
 {
-    auto& device_traits = Device_Traits::get(m_driver->get_device_type());
-
     // First it's checked if data can be acquired.
     if (!m_continuous_wave_enabled)
         throw std::runtime_error("continuous wave is not active.");
     if (m_rx_mask == 0)
         throw std::runtime_error("No RX antenna selected.");
+    if (m_stream_running)
+        throw std::runtime_error("Streaming is active.");
 
     auto read_port = dynamic_cast<HW::IReadPort<HW::Packed_Raw_Data_t>*>(&m_port);
     if (read_port == nullptr)
         throw std::runtime_error("The provided port does not support data acquisition.");
 
-    // Now a memory block is allocated to store received raw data.
-    auto num_rx_antennas = m_rx_mask.count();
-    size_t raw_block_size = m_num_samples * num_rx_antennas;
-    std::vector<uint16_t> raw_data(raw_block_size);
-
-    /*
-     * Usually, the data receive callbacks is invoked in a separate thread.
-     * Therefore some synchronization objects are initialized.
-     */
-    volatile bool data_received = false;
-    std::condition_variable receive_notifier;
-    std::mutex wait_guard;
+    return *read_port;
+}
 
-    /*
-     * The data converter is used as a wrapper around the Avian port and takes
-     * care for data unpacking. After starting the converter and assigning a
-     * buffer to it, it is ready to receive acquired data. The callback data
-     * does nothing more than unblocking the waiting main thread.
-     */
-    DataConverter<uint16_t> converter(*read_port);
-    converter.start_reader(m_driver->get_burst_prefix(), raw_block_size,
-                           [&](uint32_t) -> void {
-                               {
-                                   std::unique_lock<std::mutex> lock(wait_guard);
-                                   data_received = true;
-                               }
-                               receive_notifier.notify_one();
-                           });
-    converter.set_buffer(raw_data.data());
+// ---------------------------------------------------------------------------- prepare_acquisition
+std::vector<HW::Spi_Command_t> Continuous_Wave_Controller::prepare_acquisition()
+{
+    auto& device_traits = Device_Traits::get(m_driver->get_device_type());
 
     /*
      * For Avian devices without SADC the MADC input may be set to temperature
@@ -683,6 +669,46 @@ std::map<unsigned, std::vector<float>> Continuous_Wave_Controller::capture_rx_si
         }
     }
 
+    return spi_commands;
+}
+
+// ---------------------------------------------------------------------------- capture_rx_signals
+std::map<unsigned, std::vector<float>> Continuous_Wave_Controller::capture_rx_signals()
+{
+    auto& read_port = get_read_port();
+
+    // Now a memory block is allocated to store received raw data.
+    auto num_rx_antennas = m_rx_mask.count();
+    size_t raw_block_size = m_num_samples * num_rx_antennas;
+    std::vector<uint16_t> raw_data(raw_block_size);
+
+    /*
+     * Usually, the data receive callbacks is invoked in a separate thread.
+     * Therefore some synchronization objects are initialized.
+     */
+    volatile bool data_received = false;
+    std::condition_variable receive_notifier;
+    std::mutex wait_guard;
+
+    /*
+     * The data converter is used as a wrapper around the Avian port and takes
+     * care for data unpacking. After starting the converter and assigning a
+     * buffer to it, it is ready to receive acquired data. The callback data
+     * does nothing more than unblocking the waiting main thread.
+     */
+    DataConverter<uint16_t> converter(read_port);
+    converter.start_reader(m_driver->get_burst_prefix(), raw_block_size,
+                           [&](uint32_t) -> void {
+                               {
+                                   std::unique_lock<std::mutex> lock(wait_guard);
+                                   data_received = true;
+                               }
+                               receive_notifier.notify_one();
+                           });
+    converter.set_buffer(raw_data.data());
+
+    auto spi_commands = prepare_acquisition();
+
     /*
      * After starting the ADC the execution blocks and waits for data. The
      * receive callback handler above will unblock this thread.
@@ -738,6 +764,225 @@ std::map<unsigned, std::vector<float>> Continuous_Wave_Controller::capture_rx_si
     return rx_signals;
 }
 
+// ---------------------------------------------------------------------------- start_streaming
+void Continuous_Wave_Controller::start_streaming(Stream_Callback_t callback,
+                                                 std::function<void()> on_thread_start,
+                                                 unsigned num_buffers)
+{
+    if (!callback)
+        throw std::invalid_argument("No stream callback provided.");
+    if (num_buffers < 2)
+        throw std::invalid_argument("At least two stream buffers are required.");
+
+    auto& read_port = get_read_port();
+
+    // A previous stream may have ended due to a hardware failure.
+    stop_streaming();
+
+    auto trigger_commands = prepare_acquisition();
+
+    m_stream_stop_requested = false;
+    m_stream_running = true;
+    m_stream_thread = std::thread(&Continuous_Wave_Controller::run_streaming, this,
+                                  std::ref(read_port), std::move(trigger_commands),
+                                  std::move(callback), std::move(on_thread_start),
+                                  num_buffers);
+}
+
+// ---------------------------------------------------------------------------- stop_streaming
+void Continuous_Wave_Controller::stop_streaming()
+{
+    if (!m_stream_thread.joinable())
+        return;
+
+    m_stream_stop_requested = true;
+    m_stream_thread.join();
+}
+
+// ---------------------------------------------------------------------------- is_streaming
+bool Continuous_Wave_Controller::is_streaming() const
+{
+    return m_stream_running;
+}
+
+// ---------------------------------------------------------------------------- run_streaming
+void Continuous_Wave_Controller::run_streaming(HW::IReadPort<HW::Packed_Raw_Data_t>& read_port,
+                                               std::vector<HW::Spi_Command_t> trigger_commands,
+                                               Stream_Callback_t callback,
+                                               std::function<void()> on_thread_start,
+                                               unsigned num_buffers)
+{
+    if (on_thread_start)
+        on_thread_start();
+
+    /*
+     * The captures are written into a ring of raw data buffers. A completed
+     * buffer is queued for the delivery thread and the next buffer is armed
+     * right away, so the device does not wait for the callback unless all
+     * buffers are still queued.
+     */
+    size_t raw_block_size = m_num_samples * m_rx_mask.count();
+    std::vector<std::vector<uint16_t>> raw_buffers(num_buffers,
+                                                   std::vector<uint16_t>(raw_block_size));
+    unsigned armed_buffer = 0;
+
+    // Queue of completed buffers (index and number of lost captures before).
+    std::deque<std::pair<unsigned, unsigned>> completed;
+    bool delivery_done = false;
+    std::condition_variable delivery_notifier;
+    std::mutex delivery_guard;
+
+    std::thread delivery_thread([&]() {
+        if (on_thread_start)
+            on_thread_start();
+
+        std::unique_lock<std::mutex> lock(delivery_guard);
+        while (true)
+        {
+            delivery_notifier.wait(lock, [&]() { return delivery_done || !completed.empty(); });
+            if (completed.empty())
+                break;
+
+            auto entry = completed.front();
+            lock.unlock();
+            callback(raw_buffers[entry.first].data(), entry.second);
+            lock.lock();
+
+            // The buffer is released only now, so it is not overwritten
+            // while the callback reads it.
+            completed.pop_front();
+            delivery_notifier.notify_all();
+        }
+    });
+
+    bool data_received = false;
+    std::condition_variable receive_notifier;
+    std::mutex wait_guard;
+
+    // The reader is started once and stays active for the whole stream.
+    DataConverter<uint16_t> converter(read_port);
+
+    auto trigger_capture = [&]() {
+        converter.set_buffer(raw_buffers[armed_buffer].data());
+        m_port.send_commands(trigger_commands.data(), trigger_commands.size());
+    };
+
+    /*
+     * A lost capture is retried a few times before the device is considered
+     * unresponsive. Each retry leaves a gap in the data stream that is
+     * reported to the callback with the next capture.
+     */
+    const unsigned max_retries = 3;
+    unsigned num_lost_captures = 0;
+    bool failed = false;
+
+    try
+    {
+        converter.start_reader(m_driver->get_burst_prefix(), raw_block_size,
+                               [&](uint32_t) -> void {
+                                   {
+                                       std::unique_lock<std::mutex> lock(wait_guard);
+                                       data_received = true;
+                                   }
+                                   receive_notifier.notify_one();
+                               });
+
+        trigger_capture();
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(wait_guard);
+                receive_notifier.wait_for(lock, std::chrono::seconds(1),
+                                          [&]() { return data_received; });
+                if (!data_received)
+                {
+                    lock.unlock();
+                    if ((++num_lost_captures > max_retries) || !go_to_active_state())
+                    {
+                        failed = true;
+                        break;
+                    }
+                    if (m_stream_stop_requested)
+                        break;
+                    trigger_capture();
+                    continue;
+                }
+                data_received = false;
+            }
+
+            if (!go_to_active_state())
+            {
+                failed = true;
+                break;
+            }
+
+            const bool stop = m_stream_stop_requested;
+            {
+                std::unique_lock<std::mutex> lock(delivery_guard);
+                completed.emplace_back(armed_buffer, num_lost_captures);
+                delivery_notifier.notify_all();
+
+                // The next buffer must not be armed while it is still queued.
+                if (!stop)
+                    delivery_notifier.wait(lock, [&]() { return completed.size() < num_buffers; });
+            }
+            num_lost_captures = 0;
+
+            if (stop)
+                break;
+
+            armed_buffer = (armed_buffer + 1) % num_buffers;
+            trigger_capture();
+        }
+    }
+    catch (...)
+    {
+        failed = true;
+    }
+
+    /*
+     * Every stream ends with a reset of the device. After a regular stop the
+     * continuous wave configuration is restored, which also undoes the
+     * acquisition setup. After a failure the device is left reset and
+     * continuous wave mode is disabled, like capture_rx_signals does.
+     */
+    try
+    {
+        converter.stop_reader();
+        if (!failed)
+            configure_continuous_wave();
+    }
+    catch (...)
+    {
+        failed = true;
+    }
+
+    if (failed)
+    {
+        try
+        {
+            m_port.generate_reset_sequence();
+        }
+        catch (...)
+        {
+            // The device may be unplugged, there is nothing left to do.
+        }
+        m_continuous_wave_enabled = false;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(delivery_guard);
+        delivery_done = true;
+    }
+    delivery_notifier.notify_all();
+    delivery_thread.join();
+
+    m_stream_running = false;
+
+    if (failed)
+        callback(nullptr, num_lost_captures);
+}
+
 // ---------------------------------------------------------------------------- set_hp_gain
 void Continuous_Wave_Controller::set_hp_gain(Hp_Gain gain)
 {
@@ -942,6 +1187,9 @@ bool Continuous_Wave_Controller::get_adc_double_msb_time() const
 // ---------------------------------------------------------------------------- measure_temperature
 float Continuous_Wave_Controller::measure_temperature()
 {
+    if (m_stream_running)
+        throw std::runtime_error("Streaming is active.");
+
     Sensor_Meter meter(m_port, m_driver->get_device_type());
     if (m_continuous_wave_enabled)
         return meter.measure_temperature();
@@ -958,6 +1206,8 @@ float Continuous_Wave_Controller::measure_tx_power(unsigned antenna,
     auto& device_traits = Device_Traits::get(m_driver->get_device_type());
     if (antenna >= device_traits.num_tx_antennas)
         throw std::runtime_error("Selected TX antenna does not exist.");
+    if (m_stream_running)
+        throw std::runtime_error("Streaming is active.");
     if ((device_traits.cs_register_layout != Cs_Layout::Version3)
         && (detector != Power_Detector::Forward))
     {
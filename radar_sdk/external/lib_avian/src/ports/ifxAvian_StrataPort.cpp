@@ -34,6 +34,7 @@
 #include "ports/ifxAvian_StrataPort.hpp"
 
 // universal
+#include <common/ThreadPolicy.hpp>
 #include <common/endian/General.hpp>
 #include <universal/error_definitions.h>
 #include <universal/types/DataSettingsBgtRadar.h>
@@ -140,6 +141,12 @@ void StrataPort::register_error_callback(Error_Callback_t callback)
     m_errorCallback = callback;
 }
 
+// ---------------------------------------------------------------------------- getThreadRole
+ThreadRole StrataPort::getThreadRole() const
+{
+    return ThreadRole::Converter;
+}
+
 // ---------------------------------------------------------------------------- onNewFrame
 void StrataPort::onNewFrame(IFrame* frame)
 {
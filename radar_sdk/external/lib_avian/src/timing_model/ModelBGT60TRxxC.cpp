@@ -32,6 +32,8 @@
 
 // ---------------------------------------------------------------------------- includes
 #include "ModelBGT60TRxxC.hpp"
+#include "ModelBGT60TR11D.hpp"
+#include "ModelBGT60TRxxD.hpp"
 #include <algorithm>
 #include <limits>
 #include <sstream>
@@ -324,6 +326,18 @@ double ModelBGT60TRxxC::getPowerConsumption(PowerMode ePowerMode) const
     }
 }
 
+// ---------------------------------------------------------------------------- getInit0PowerConsumption
+double ModelBGT60TRxxC::getInit0PowerConsumption() const
+{
+    return m_sPowerConsumptionTable.dPowerInit0;
+}
+
+// ---------------------------------------------------------------------------- getPllLockTime
+uint64_t ModelBGT60TRxxC::getPllLockTime()
+{
+    return s_uLockTime;
+}
+
 // ---------------------------------------------------------------------------- getCurrentShapeSettings
 const ShapeSettings& ModelBGT60TRxxC::getCurrentShapeSettings() const
 {
@@ -618,6 +632,18 @@ void ModelBGT60TRxxC::startPllPostDelay(TimerList_t& aTimers)
                          });
 }
 
+// ---------------------------------------------------------------------------- createModel
+std::unique_ptr<ModelBGT60TRxxC> createModel(const SequenceParameters& sParameters,
+                                             bool bIgnoreRepetitions)
+{
+    if (auto pParameters11D = dynamic_cast<const SequenceParameters11D*>(&sParameters))
+        return std::make_unique<ModelBGT60TR11D>(*pParameters11D, bIgnoreRepetitions);
+    else if (auto pParametersD = dynamic_cast<const SequenceParametersD*>(&sParameters))
+        return std::make_unique<ModelBGT60TRxxD>(*pParametersD, bIgnoreRepetitions);
+    else
+        return std::make_unique<ModelBGT60TRxxC>(sParameters, bIgnoreRepetitions);
+}
+
 /* ------------------------------------------------------------------------ */
 }  // namespace TimingModel
 }  // namespace Avian
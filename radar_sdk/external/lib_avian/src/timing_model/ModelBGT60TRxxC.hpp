@@ -38,6 +38,7 @@
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <memory>
 #include <string>
 
 // ---------------------------------------------------------------------------- namespaces
@@ -75,6 +76,9 @@ public:
 
     double getPowerConsumption() const;
     double getPowerConsumption(PowerMode ePowerMode) const;
+    double getInit0PowerConsumption() const;
+
+    static uint64_t getPllLockTime();
 
 protected:
     struct PowerConsumptionTable
@@ -201,6 +205,14 @@ private:
     static const PowerConsumptionTable s_sPowerConsumptionTableBGT60ATR24C;
 };
 
+// ---------------------------------------------------------------------------- createModel
+/**
+ * Creates the state machine model matching the type of the given parameter
+ * set (see createSequenceParameters).
+ */
+std::unique_ptr<ModelBGT60TRxxC> createModel(const SequenceParameters& sParameters,
+                                             bool bIgnoreRepetitions);
+
 /* ------------------------------------------------------------------------ */
 }  // namespace TimingModel
 }  // namespace Avian
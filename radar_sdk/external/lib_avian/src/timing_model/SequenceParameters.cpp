@@ -38,6 +38,7 @@
 #include "../Driver/registers_BGT60TRxxD.h"
 #include "../Driver/registers_BGT60TRxxE.h"
 #include "ifxAvian_DeviceTraits.hpp"
+#include "ifxAvian_Driver.hpp"
 #include "ifxAvian_RegisterSet.hpp"
 #include "ifxAvian_Types.hpp"
 
@@ -394,6 +395,44 @@ SequenceParameters11D::SequenceParameters11D(const HW::RegisterSet& registers,
     uMadcSwitchTime = uint16_t(1.0e-6 * ref_frequency + 0.5);
 }
 
+// ---------------------------------------------------------------------------- createSequenceParameters
+std::unique_ptr<SequenceParameters> createSequenceParameters(const HW::RegisterSet& registers,
+                                                             Device_Type device_type,
+                                                             double ref_frequency)
+{
+    switch (device_type)
+    {
+        case Device_Type::BGT60UTR11AIP:
+            return std::make_unique<SequenceParameters11D>(registers, device_type, ref_frequency);
+
+        case Device_Type::BGT60UTR13D:
+        case Device_Type::BGT60TR12E:
+        case Device_Type::BGT120UTR13E:
+        case Device_Type::BGT120UTR24:
+        case Device_Type::BGT60ATR24E:
+        case Device_Type::BGT24LTR13E:
+            return std::make_unique<SequenceParametersD>(registers, device_type, ref_frequency);
+
+        case Device_Type::BGT60TR13C:
+        case Device_Type::BGT60ATR24C:
+        case Device_Type::BGT24LTR24:
+        default:
+            return std::make_unique<SequenceParameters>(registers, device_type, ref_frequency);
+    }
+}
+
+// ---------------------------------------------------------------------------- getReferenceFrequency
+double getReferenceFrequency(const Driver& driver)
+{
+    Reference_Clock_Frequency eReferenceFrequency;
+    driver.get_reference_clock_frequency(&eReferenceFrequency);
+    if ((eReferenceFrequency == Reference_Clock_Frequency::_76_8MHz)
+        || (eReferenceFrequency == Reference_Clock_Frequency::_38_4MHz))
+        return 76800000.0;
+    else
+        return 80000000.0;
+}
+
 /* ------------------------------------------------------------------------ */
 }  // namespace TimingModel
 }  // namespace Avian
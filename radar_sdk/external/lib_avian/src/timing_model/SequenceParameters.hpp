@@ -36,6 +36,7 @@
 // ---------------------------------------------------------------------------- includes
 #include "ifxAvian_TimingModel.hpp"
 #include <cstdint>
+#include <memory>
 
 namespace Infineon {
 namespace Avian {
@@ -49,6 +50,7 @@ class RegisterSet;
 namespace Infineon {
 namespace Avian {
 
+class Driver;
 enum class Device_Type;
 
 }  // namespace Avian
@@ -158,6 +160,22 @@ public:
                           double ref_frequency);
 };
 
+// ---------------------------------------------------------------------------- createSequenceParameters
+/**
+ * Creates the parameter set matching the device type. Depending on the
+ * device this is an instance of SequenceParameters, SequenceParametersD or
+ * SequenceParameters11D.
+ */
+std::unique_ptr<SequenceParameters> createSequenceParameters(const Infineon::Avian::HW::RegisterSet& registers,
+                                                             Infineon::Avian::Device_Type device_type,
+                                                             double ref_frequency);
+
+// ---------------------------------------------------------------------------- getReferenceFrequency
+/**
+ * Returns the frequency of the reference clock a driver is configured for.
+ */
+double getReferenceFrequency(const Infineon::Avian::Driver& driver);
+
 /* ------------------------------------------------------------------------ */
 }  // namespace TimingModel
 }  // namespace Avian
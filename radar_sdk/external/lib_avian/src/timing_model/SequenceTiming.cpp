@@ -0,0 +1,495 @@
+/**
+ * @file SequenceTiming.cpp
+ */
+/* ===========================================================================
+** Copyright (C) 2017-2023 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+// ---------------------------------------------------------------------------- includes
+#include "ifxAvian_Driver.hpp"
+#include "ifxAvian_TimingModel.hpp"
+#include "ModelBGT60TRxxC.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// ---------------------------------------------------------------------------- namespaces
+namespace Infineon {
+namespace Avian {
+namespace TimingModel {
+
+/*
+ * The state machine model has two kinds of timers. The FSM timers (PA delay,
+ * ADC delay, sampling, chirp end delay, shape end delay, ...) are executed
+ * one after the other. All other timers (PLL ramp, startup delays, MADC
+ * measurements) run in parallel. The only synchronization point is the state
+ * WaitForPll at the end of sampling, which is left when all timers have
+ * expired. Because of that the durations of chirps and shapes can be
+ * calculated as the maximum of a few sums. Parallel timers still running at
+ * the start of a shape are passed on as "carry" to the first chirp of that
+ * shape.
+ */
+
+// ---------------------------------------------------------------------------- toTicks
+static uint64_t toTicks(Ticks dTicks)
+{
+    return (dTicks > 0.0) ? uint64_t(std::llround(dTicks)) : 0;
+}
+
+// ---------------------------------------------------------------------------- positiveDifference
+static uint64_t positiveDifference(uint64_t uMinuend, uint64_t uSubtrahend)
+{
+    return (uMinuend > uSubtrahend) ? uMinuend - uSubtrahend : 0;
+}
+
+// ---------------------------------------------------------------------------- calculateRampTime
+static uint32_t calculateRampTime(const SequenceParameters& sParameters, uint16_t uNumSamples)
+{
+    // this is the same calculation the driver does when programming RTU/RTD
+    uint64_t uChirpLength = uint64_t(uNumSamples) * sParameters.uAdcDivider
+                            + sParameters.uAdcDelay
+                            + positiveDifference(sParameters.uPaDelay, sParameters.uPreChirpDelay);
+    return uint32_t((uChirpLength + 7) / 8 * 8);
+}
+
+// ---------------------------------------------------------------------------- GroupTotals::add
+void SequenceTiming::GroupTotals::add(const ShapeTiming& sShape, uint64_t uNumRepetitions)
+{
+    uTime += uNumRepetitions * sShape.uShapeTime + sShape.uShapeEndTime;
+    uActiveTime += uNumRepetitions * sShape.uActiveTime;
+    dWork += uNumRepetitions * sShape.dShapeWork + sShape.dShapeEndWork;
+}
+
+// ---------------------------------------------------------------------------- SequenceTiming
+SequenceTiming::SequenceTiming(const Driver& driver) :
+    SequenceTiming(driver.get_device_configuration(), driver.get_device_type(),
+                   getReferenceFrequency(driver))
+{}
+
+// ---------------------------------------------------------------------------- SequenceTiming
+SequenceTiming::SequenceTiming(const HW::RegisterSet& registers,
+                               Device_Type device_type,
+                               double ref_frequency) :
+    m_eDeviceType(device_type),
+    m_dOscFrequency(ref_frequency)
+{
+    loadParameters(registers);
+}
+
+// ---------------------------------------------------------------------------- SequenceTiming
+SequenceTiming::SequenceTiming(SequenceTiming&&) noexcept = default;
+
+// ---------------------------------------------------------------------------- ~SequenceTiming
+SequenceTiming::~SequenceTiming() = default;
+
+// ---------------------------------------------------------------------------- update
+void SequenceTiming::update(const Driver& driver)
+{
+    loadParameters(driver.get_device_configuration());
+}
+
+// ---------------------------------------------------------------------------- update
+void SequenceTiming::update(const HW::RegisterSet& registers)
+{
+    loadParameters(registers);
+}
+
+// ---------------------------------------------------------------------------- loadParameters
+void SequenceTiming::loadParameters(const HW::RegisterSet& registers)
+{
+    // the model is only used to look up power consumptions, it is never run
+    m_pModel.reset();
+    m_pParameters = createSequenceParameters(registers, m_eDeviceType, m_dOscFrequency);
+    m_pModel = createModel(*m_pParameters, true);
+
+    m_uPrefixTime = getWakeUpTime(PowerMode::Deep_Sleep, &m_uPrefixCarry, &m_dPrefixWork);
+
+    updateShapes(0);
+}
+
+// ---------------------------------------------------------------------------- getWakeUpTime
+uint64_t SequenceTiming::getWakeUpTime(PowerMode ePowerMode, uint64_t* pCarry, double* pWork) const
+{
+    const SequenceParameters& sParameters = *m_pParameters;
+
+    const bool bWakeUp = (ePowerMode == PowerMode::Deep_Sleep)
+                         || (ePowerMode == PowerMode::Deep_Sleep_Continue);
+    if (!bWakeUp && (ePowerMode != PowerMode::Idle))
+    {
+        // from interchirp mode the next shape starts immediately
+        *pCarry = 0;
+        *pWork = 0.0;
+        return 0;
+    }
+
+    const uint64_t uInitTime = uint64_t(sParameters.uInit0Time) + sParameters.uInit1Time;
+    const uint64_t uWakeUpTime = bWakeUp ? sParameters.uWakeUpTime : 0;
+
+    *pWork = m_pModel->getPowerConsumption(PowerMode::Idle) * uWakeUpTime
+             + m_pModel->getInit0PowerConsumption() * sParameters.uInit0Time
+             + m_pModel->getPowerConsumption(PowerMode::Interchirp) * sParameters.uInit1Time;
+
+    // the startup timers are started in parallel to WU, INIT0 and INIT1
+    if (auto pParametersD = dynamic_cast<const SequenceParametersD*>(&sParameters))
+    {
+        uint64_t uCarry = positiveDifference(pParametersD->uStartupDelayMadc, uInitTime);
+        uCarry = std::max(uCarry, positiveDifference(pParametersD->uStartupDelayPllEnable, uInitTime));
+        uCarry = std::max(uCarry, positiveDifference(uint64_t(pParametersD->uStartupDelayPllDivider)
+                                                         + ModelBGT60TRxxC::getPllLockTime(),
+                                                     sParameters.uInit1Time));
+        if (bWakeUp)
+            uCarry = std::max(uCarry, positiveDifference(pParametersD->uStartupDelayBandgap,
+                                                         uWakeUpTime + uInitTime));
+        *pCarry = uCarry;
+    }
+    else
+    {
+        *pCarry = positiveDifference(ModelBGT60TRxxC::getPllLockTime(), uInitTime);
+    }
+
+    return uWakeUpTime + uInitTime;
+}
+
+// ---------------------------------------------------------------------------- getChirpTime
+uint64_t SequenceTiming::getChirpTime(unsigned uShape, bool bDownChirp, uint64_t uCarry,
+                                      uint64_t* pActiveTime, double* pWork) const
+{
+    const SequenceParameters& sParameters = *m_pParameters;
+    const ShapeSettings& sShape = sParameters.sShape[uShape];
+    const ChirpSettings& sChirp = bDownChirp ? sShape.sDown : sShape.sUp;
+
+    // FSM path: PA delay, ADC delay and sampling
+    const uint64_t uSamplingTime = uint64_t(sChirp.uNumSamples) * sParameters.uAdcDivider;
+    const uint64_t uFsmTime = uint64_t(sParameters.uPaDelay) + sParameters.uAdcDelay + uSamplingTime;
+
+    // PLL path: pre-chirp delay, ramp, fast down ramp and post-chirp delay
+    uint64_t uPllTime = uint64_t(sParameters.uPreChirpDelay) + sChirp.uRampTime + sParameters.uPostChirpDelay;
+    if (sShape.bFastDownRamp)
+        uPllTime += sParameters.uFastDownTime;
+
+    uint64_t uTime = std::max({uFsmTime, uPllTime, uCarry});
+
+    // BGT60TR11D measures power and temperature with the MADC
+    if (auto pParameters11D = dynamic_cast<const SequenceParameters11D*>(&sParameters))
+    {
+        if (pParameters11D->bPowerSensEnabled[uShape])
+        {
+            uTime = std::max(uTime, uint64_t(pParameters11D->uMadcSwitchTime));
+            uTime = std::max(uTime, uint64_t(sParameters.uPaDelay)
+                                        + pParameters11D->uPowerSensDelay
+                                        + pParameters11D->uMadcAcquisitionTime
+                                        + pParameters11D->uMadcSwitchTime);
+        }
+
+        if (pParameters11D->bTemperatureSensEnabled[uShape]
+            && (bDownChirp != sShape.bFastDownRamp))
+        {
+            uTime = std::max(uTime, uFsmTime + pParameters11D->uMadcSwitchTime);
+        }
+    }
+
+    const double dPowerInterchirp = m_pModel->getPowerConsumption(PowerMode::Interchirp);
+    *pActiveTime = sParameters.uAdcDelay + uSamplingTime;
+    *pWork = dPowerInterchirp * (sParameters.uPaDelay + uTime - uFsmTime)
+             + m_pModel->getPowerConsumption(PowerMode::Active) * (*pActiveTime);
+
+    return uTime;
+}
+
+// ---------------------------------------------------------------------------- updateShapes
+void SequenceTiming::updateShapes(unsigned uFirstShape)
+{
+    const SequenceParameters& sParameters = *m_pParameters;
+    const double dPowerInterchirp = m_pModel->getPowerConsumption(PowerMode::Interchirp);
+
+    /*
+     * The shape set ends with the first shape that has no repetitions, but
+     * shape 1 is always executed.
+     */
+    m_uNumUsedShapes = 1;
+    while ((m_uNumUsedShapes < 4) && (sParameters.sShape[m_uNumUsedShapes].uNumRepetitions > 0))
+        ++m_uNumUsedShapes;
+
+    uint64_t uCarry = (uFirstShape == 0) ? m_uPrefixCarry : m_sShapes[uFirstShape - 1].uCarry;
+
+    for (unsigned uShape = uFirstShape; uShape < 4; ++uShape)
+    {
+        ShapeTiming& sTiming = m_sShapes[uShape];
+        sTiming = ShapeTiming();
+        if (uShape >= m_uNumUsedShapes)
+            continue;
+
+        const ShapeSettings& sShape = sParameters.sShape[uShape];
+
+        // first chirp
+        uint64_t uActiveTime;
+        double dWork;
+        sTiming.uShapeTime = getChirpTime(uShape, false, uCarry, &uActiveTime, &dWork)
+                             + sShape.sUp.uChirpEndDelay;
+        sTiming.uActiveTime = uActiveTime;
+        sTiming.dShapeWork = dWork + dPowerInterchirp * sShape.sUp.uChirpEndDelay;
+
+        // second chirp (or just the second chirp end delay in saw tooth mode)
+        uint64_t uLastEndDelays = sShape.sDown.uChirpEndDelay;
+        if (sShape.bFastDownRamp)
+        {
+            uLastEndDelays += sShape.sUp.uChirpEndDelay;
+        }
+        else
+        {
+            sTiming.uShapeTime += getChirpTime(uShape, true, 0, &uActiveTime, &dWork);
+            sTiming.uActiveTime += uActiveTime;
+            sTiming.dShapeWork += dWork;
+        }
+        sTiming.uShapeTime += sShape.sDown.uChirpEndDelay;
+        sTiming.dShapeWork += dPowerInterchirp * sShape.sDown.uChirpEndDelay;
+
+        // shape end delay and wake up for next shape
+        double dWakeUpWork;
+        sTiming.uShapeEndTime = sShape.uShapeEndDelay
+                                + getWakeUpTime(sShape.eShapeEndPowerMode, &uCarry, &dWakeUpWork);
+        sTiming.dShapeEndWork = m_pModel->getPowerConsumption(sShape.eShapeEndPowerMode) * sShape.uShapeEndDelay
+                                + dWakeUpWork;
+
+        // a temperature measurement started with the last chirp end delay may still be running
+        if (auto pParameters11D = dynamic_cast<const SequenceParameters11D*>(&sParameters))
+        {
+            if (pParameters11D->bTemperatureSensEnabled[uShape])
+            {
+                uint64_t uMeasurementTime = uint64_t(pParameters11D->uMadcAcquisitionTime)
+                                            + pParameters11D->uMadcSwitchTime;
+                uCarry = std::max(uCarry, positiveDifference(uMeasurementTime,
+                                                             uLastEndDelays + sTiming.uShapeEndTime));
+            }
+        }
+
+        sTiming.uCarry = uCarry;
+    }
+}
+
+// ---------------------------------------------------------------------------- getFrameTotals
+SequenceTiming::GroupTotals SequenceTiming::getFrameTotals() const
+{
+    const SequenceParameters& sParameters = *m_pParameters;
+
+    const unsigned uNumSets = sParameters.uNumShapeGroupsPerFrame / m_uNumUsedShapes;
+    const unsigned uNumAdditionalGroups = sParameters.uNumShapeGroupsPerFrame % m_uNumUsedShapes;
+    const unsigned uLastUsedShape = (uNumAdditionalGroups != 0) ? uNumAdditionalGroups - 1 : m_uNumUsedShapes - 1;
+
+    GroupTotals sSet;
+    for (unsigned uShape = 0; uShape < m_uNumUsedShapes; ++uShape)
+        sSet.add(m_sShapes[uShape], sParameters.sShape[uShape].uNumRepetitions);
+
+    GroupTotals sFrame;
+    sFrame.uTime = m_uPrefixTime + uNumSets * sSet.uTime;
+    sFrame.uActiveTime = uNumSets * sSet.uActiveTime;
+    sFrame.dWork = m_dPrefixWork + uNumSets * sSet.dWork;
+
+    for (unsigned uShape = 0; uShape < uNumAdditionalGroups; ++uShape)
+        sFrame.add(m_sShapes[uShape], sParameters.sShape[uShape].uNumRepetitions);
+
+    // the last shape end delay is replaced by the frame end delay
+    sFrame.uTime -= m_sShapes[uLastUsedShape].uShapeEndTime;
+    sFrame.dWork -= m_sShapes[uLastUsedShape].dShapeEndWork;
+
+    return sFrame;
+}
+
+// ---------------------------------------------------------------------------- getChirpToChirpTime
+Ticks SequenceTiming::getChirpToChirpTime(unsigned uShape) const
+{
+    return (uShape < 4) ? Ticks(m_sShapes[uShape].uShapeTime) : 0.0;
+}
+
+// ---------------------------------------------------------------------------- getSetToSetTime
+Ticks SequenceTiming::getSetToSetTime() const
+{
+    GroupTotals sSet;
+    for (unsigned uShape = 0; uShape < m_uNumUsedShapes; ++uShape)
+        sSet.add(m_sShapes[uShape], m_pParameters->sShape[uShape].uNumRepetitions);
+
+    return Ticks(sSet.uTime);
+}
+
+// ---------------------------------------------------------------------------- getFrameDuration
+Ticks SequenceTiming::getFrameDuration() const
+{
+    const SequenceParameters& sParameters = *m_pParameters;
+
+    /*
+     * If the frame does not end in deep sleep, the next frame does not start
+     * with a wake up, and if it does not end in idle mode either, the PLL
+     * initialization is skipped, too.
+     */
+    uint64_t uSkippedTime = 0;
+    if (sParameters.eFrameEndPowerMode == PowerMode::Idle)
+        uSkippedTime = sParameters.uWakeUpTime;
+    else if ((sParameters.eFrameEndPowerMode != PowerMode::Deep_Sleep)
+             && (sParameters.eFrameEndPowerMode != PowerMode::Deep_Sleep_Continue))
+        uSkippedTime = m_uPrefixTime;
+
+    return Ticks(getFrameTotals().uTime + sParameters.uFrameEndDelay - uSkippedTime);
+}
+
+// ---------------------------------------------------------------------------- getAcquisitionDuration
+Ticks SequenceTiming::getAcquisitionDuration() const
+{
+    return Ticks(getFrameTotals().uTime);
+}
+
+// ---------------------------------------------------------------------------- getFrameActiveDuration
+double SequenceTiming::getFrameActiveDuration() const
+{
+    return toSeconds(Ticks(getFrameTotals().uActiveTime));
+}
+
+// ---------------------------------------------------------------------------- getFrameAveragePowerConsumption
+double SequenceTiming::getFrameAveragePowerConsumption() const
+{
+    const SequenceParameters& sParameters = *m_pParameters;
+    const GroupTotals sFrame = getFrameTotals();
+
+    const uint64_t uTotalTime = sFrame.uTime + sParameters.uFrameEndDelay;
+    const double dTotalWork = sFrame.dWork
+                              + m_pModel->getPowerConsumption(sParameters.eFrameEndPowerMode)
+                                    * sParameters.uFrameEndDelay;
+
+    return (uTotalTime > 0) ? dTotalWork / uTotalTime
+                            : std::numeric_limits<double>::quiet_NaN();
+}
+
+// ---------------------------------------------------------------------------- getWakeUpTime
+Ticks SequenceTiming::getWakeUpTime(PowerMode ePowerMode) const
+{
+    uint64_t uCarry;
+    double dWork;
+    return Ticks(getWakeUpTime(ePowerMode, &uCarry, &dWork));
+}
+
+// ---------------------------------------------------------------------------- getNumRepetitions
+unsigned SequenceTiming::getNumRepetitions(unsigned uShape) const
+{
+    return (uShape < 4) ? m_pParameters->sShape[uShape].uNumRepetitions : 0;
+}
+
+// ---------------------------------------------------------------------------- getAdcDivider
+unsigned SequenceTiming::getAdcDivider() const
+{
+    return m_pParameters->uAdcDivider;
+}
+
+// ---------------------------------------------------------------------------- setAdcDivider
+void SequenceTiming::setAdcDivider(uint16_t uAdcDivider)
+{
+    SequenceParameters& sParameters = *m_pParameters;
+    sParameters.uAdcDivider = uAdcDivider;
+
+    for (auto& sShape : sParameters.sShape)
+    {
+        sShape.sUp.uRampTime = calculateRampTime(sParameters, sShape.sUp.uNumSamples);
+        if (!sShape.bFastDownRamp)
+            sShape.sDown.uRampTime = calculateRampTime(sParameters, sShape.sDown.uNumSamples);
+    }
+
+    updateShapes(0);
+}
+
+// ---------------------------------------------------------------------------- setNumSamples
+void SequenceTiming::setNumSamples(unsigned uShape, bool bDownChirp, uint16_t uNumSamples)
+{
+    if (uShape >= 4)
+        return;
+
+    SequenceParameters& sParameters = *m_pParameters;
+    ShapeSettings& sShape = sParameters.sShape[uShape];
+    ChirpSettings& sChirp = bDownChirp ? sShape.sDown : sShape.sUp;
+
+    sChirp.uNumSamples = uNumSamples;
+    if (!bDownChirp || !sShape.bFastDownRamp)
+        sChirp.uRampTime = calculateRampTime(sParameters, uNumSamples);
+
+    updateShapes(uShape);
+}
+
+// ---------------------------------------------------------------------------- setChirpEndDelay
+void SequenceTiming::setChirpEndDelay(unsigned uShape, bool bDownChirp, Ticks dDelay)
+{
+    if (uShape >= 4)
+        return;
+
+    ShapeSettings& sShape = m_pParameters->sShape[uShape];
+    ChirpSettings& sChirp = bDownChirp ? sShape.sDown : sShape.sUp;
+    sChirp.uChirpEndDelay = uint16_t(std::min<uint64_t>(toTicks(dDelay),
+                                                        std::numeric_limits<uint16_t>::max()));
+
+    updateShapes(uShape);
+}
+
+// ---------------------------------------------------------------------------- setNumRepetitions
+void SequenceTiming::setNumRepetitions(unsigned uShape, uint16_t uNumRepetitions)
+{
+    if (uShape >= 4)
+        return;
+
+    m_pParameters->sShape[uShape].uNumRepetitions = uNumRepetitions;
+
+    updateShapes(uShape);
+}
+
+// ---------------------------------------------------------------------------- setShapeEndDelay
+void SequenceTiming::setShapeEndDelay(unsigned uShape, Ticks dDelay, PowerMode ePowerMode)
+{
+    if (uShape >= 4)
+        return;
+
+    ShapeSettings& sShape = m_pParameters->sShape[uShape];
+    sShape.uShapeEndDelay = toTicks(dDelay);
+    sShape.eShapeEndPowerMode = ePowerMode;
+
+    updateShapes(uShape);
+}
+
+// ---------------------------------------------------------------------------- setFrameEndDelay
+void SequenceTiming::setFrameEndDelay(Ticks dDelay, PowerMode ePowerMode)
+{
+    m_pParameters->uFrameEndDelay = toTicks(dDelay);
+    m_pParameters->eFrameEndPowerMode = ePowerMode;
+}
+
+// ---------------------------------------------------------------------------- setNumShapeGroupsPerFrame
+void SequenceTiming::setNumShapeGroupsPerFrame(uint16_t uNumShapeGroups)
+{
+    m_pParameters->uNumShapeGroupsPerFrame = uNumShapeGroups;
+}
+
+/* ------------------------------------------------------------------------ */
+}  // namespace TimingModel
+}  // namespace Avian
+}  // namespace Infineon
+
+/* --- End of File -------------------------------------------------------- */
@@ -216,22 +216,10 @@ double StateSequence::ShapeGroup::getTotalWork() const
     return dWorkShapeStates + dWorkShapeEnd;
 }
 
-// ---------------------------------------------------------------------------- get_ref_frequency_from_driver
-static double get_ref_frequency_from_driver(const Driver& driver)
-{
-    Reference_Clock_Frequency eReferenceFrequency;
-    driver.get_reference_clock_frequency(&eReferenceFrequency);
-    if ((eReferenceFrequency == Reference_Clock_Frequency::_76_8MHz)
-        || (eReferenceFrequency == Reference_Clock_Frequency::_38_4MHz))
-        return 76800000.0;
-    else
-        return 80000000.0;
-}
-
 // ---------------------------------------------------------------------------- StateSequence
 StateSequence::StateSequence(const Driver& driver) :
     StateSequence(driver.get_device_configuration(), driver.get_device_type(),
-                  get_ref_frequency_from_driver(driver))
+                  getReferenceFrequency(driver))
 {}
 
 // ---------------------------------------------------------------------------- StateSequence
@@ -242,46 +230,10 @@ StateSequence::StateSequence(const HW::RegisterSet& registers,
 {
     // init state machine
     // ------------------
-    std::unique_ptr<SequenceParameters> pParameters;
-    std::unique_ptr<ModelBGT60TRxxC> pFsm;
-
-    switch (device_type)
-    {
-        case Device_Type::BGT60UTR11AIP:
-            {
-                auto pParameters11D = std::make_unique<SequenceParameters11D>(registers,
-                                                                              device_type,
-                                                                              m_dOscFrequency);
-                pFsm = std::make_unique<ModelBGT60TR11D>(*pParameters11D, true);
-                pParameters = std::move(pParameters11D);
-            }
-            break;
-
-        case Device_Type::BGT60UTR13D:
-        case Device_Type::BGT60TR12E:
-        case Device_Type::BGT120UTR13E:
-        case Device_Type::BGT120UTR24:
-        case Device_Type::BGT60ATR24E:
-        case Device_Type::BGT24LTR13E:
-            {
-                auto pParametersD = std::make_unique<SequenceParametersD>(registers,
-                                                                          device_type,
-                                                                          m_dOscFrequency);
-                pFsm = std::make_unique<ModelBGT60TRxxD>(*pParametersD, true);
-                pParameters = std::move(pParametersD);
-            }
-            break;
-
-        case Device_Type::BGT60TR13C:
-        case Device_Type::BGT60ATR24C:
-        case Device_Type::BGT24LTR24:
-        default:
-            pParameters = std::make_unique<SequenceParameters>(registers,
-                                                               device_type,
-                                                               m_dOscFrequency);
-            pFsm = std::make_unique<ModelBGT60TRxxC>(*pParameters, true);
-            break;
-    };
+    std::unique_ptr<SequenceParameters> pParameters = createSequenceParameters(registers,
+                                                                               device_type,
+                                                                               m_dOscFrequency);
+    std::unique_ptr<ModelBGT60TRxxC> pFsm = createModel(*pParameters, true);
 
     m_jTotalFrequencyRange = std::make_pair(pParameters->dPllMinFrequency,
                                             pParameters->dPllMaxFrequency);
@@ -0,0 +1,918 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#include "AsyncLogger.hpp"
+#include "Time.hpp"
+
+#include <cstdio>
+#include <map>
+
+
+using namespace AsyncLog;
+
+
+namespace
+{
+    // binary log file: magic, followed by records.
+    // Before the first record of a call site, a record with level formatLevel
+    // holds the format string of that site.
+    const char binaryMagic[8]       = {'S', 'T', 'R', 'A', 'L', 'O', 'G', '1'};
+    constexpr uint8_t formatLevel   = 0xFF;
+    constexpr uint32_t defaultLimit = 1000;
+    constexpr std::size_t defaultBufferSize = 64 * 1024;
+    constexpr std::size_t minBufferSize     = 4 * 1024;
+    constexpr std::size_t maxArgs           = 32;
+
+    const auto drainInterval = std::chrono::milliseconds(10);
+    const int64_t rateWindow = 1000000000;  // ns
+
+    /// One conversion specification of a printf-style format string
+    struct Spec
+    {
+        std::string flags;
+        std::string width;      // empty: not given, "*": taken from the arguments
+        std::string precision;  // empty: not given, "*": taken from the arguments
+        char length[3];
+        char conversion;
+
+        std::string prefix() const
+        {
+            return '%' + flags + width + (precision.empty() ? "" : '.' + precision);
+        }
+    };
+
+    /// Parse the specification starting after '%'. Returns false for "%%" and malformed specs.
+    bool parseSpec(const char *&p, Spec &spec)
+    {
+        spec.flags.clear();
+        spec.width.clear();
+        spec.precision.clear();
+        spec.length[0]  = '\0';
+        spec.conversion = '\0';
+
+        while (*p && std::strchr("-+ #0", *p))
+        {
+            spec.flags += *p++;
+        }
+        if (*p == '*')
+        {
+            spec.width = *p++;
+        }
+        while (*p >= '0' && *p <= '9')
+        {
+            spec.width += *p++;
+        }
+        if (*p == '.')
+        {
+            p++;
+            spec.precision = "0";
+            if (*p == '*')
+            {
+                spec.precision = *p++;
+            }
+            else if (*p >= '0' && *p <= '9')
+            {
+                spec.precision.clear();
+                while (*p >= '0' && *p <= '9')
+                {
+                    spec.precision += *p++;
+                }
+            }
+        }
+
+        std::size_t n = 0;
+        while (*p && std::strchr("hljztL", *p) && n < 2)
+        {
+            spec.length[n++] = *p++;
+        }
+        spec.length[n] = '\0';
+
+        if (!*p)
+        {
+            return false;
+        }
+        spec.conversion = *p++;
+        return spec.conversion != '%';
+    }
+
+    bool isSigned(char conversion)
+    {
+        return conversion == 'd' || conversion == 'i';
+    }
+
+    bool isUnsigned(char conversion)
+    {
+        return std::strchr("uoxXc", conversion) != nullptr;
+    }
+
+    bool isFloat(char conversion)
+    {
+        return std::strchr("fFeEgGaA", conversion) != nullptr;
+    }
+
+    /// Decoded argument of a record
+    struct Arg
+    {
+        uint8_t type;
+        union
+        {
+            int64_t i;
+            uint64_t u;
+            double f;
+        };
+        const char *str;
+        std::size_t len;
+    };
+
+    std::size_t argSize(const Arg &arg)
+    {
+        return (arg.type == ArgString) ? (2 + arg.len) : (1 + sizeof(uint64_t));
+    }
+
+    void encodeArg(uint8_t *&dst, const Arg &arg)
+    {
+        if (arg.type == ArgString)
+        {
+            encodeString(dst, arg.str, arg.len);
+        }
+        else
+        {
+            *dst++ = arg.type;
+            std::memcpy(dst, &arg.u, sizeof(arg.u));
+            dst += sizeof(arg.u);
+        }
+    }
+
+    class ArgReader
+    {
+    public:
+        explicit ArgReader(const RecordHeader *record) :
+            m_pos {reinterpret_cast<const uint8_t *>(record) + sizeof(RecordHeader)},
+            m_end {reinterpret_cast<const uint8_t *>(record) + record->size},
+            m_remaining {record->argc}
+        {}
+
+        bool next(Arg &arg)
+        {
+            if (!m_remaining || m_pos >= m_end)
+            {
+                return false;
+            }
+            m_remaining--;
+            arg.type = *m_pos++;
+            if (arg.type == ArgString)
+            {
+                if (m_pos >= m_end)
+                {
+                    return false;
+                }
+                arg.len = *m_pos++;
+                arg.str = reinterpret_cast<const char *>(m_pos);
+                if (arg.len > static_cast<std::size_t>(m_end - m_pos))
+                {
+                    return false;
+                }
+                m_pos += arg.len;
+            }
+            else
+            {
+                if (sizeof(arg.u) > static_cast<std::size_t>(m_end - m_pos))
+                {
+                    return false;
+                }
+                std::memcpy(&arg.u, m_pos, sizeof(arg.u));
+                m_pos += sizeof(arg.u);
+            }
+            return true;
+        }
+
+    private:
+        const uint8_t *m_pos;
+        const uint8_t *m_end;
+        uint8_t m_remaining;
+    };
+
+    int64_t argAsInt(const Arg &arg)
+    {
+        switch (arg.type)
+        {
+            case ArgFloat:
+                return static_cast<int64_t>(arg.f);
+            case ArgString:
+                return 0;
+            default:
+                return arg.i;
+        }
+    }
+
+    void appendSpec(std::string &out, const Spec &spec, const Arg *arg)
+    {
+        if (!arg)
+        {
+            out += "<missing>";
+            return;
+        }
+
+        char text[maxStringLength + 64];
+        const std::string prefix = spec.prefix();
+        std::string fmt          = prefix + spec.conversion;
+        int n                    = 0;
+
+        if (spec.conversion == 's')
+        {
+            if (arg->type == ArgString)
+            {
+                const std::string str(arg->str, arg->len);
+                n = std::snprintf(text, sizeof(text), fmt.c_str(), str.c_str());
+            }
+            else
+            {
+                const auto str = (arg->type == ArgFloat) ? std::to_string(arg->f) : std::to_string(arg->i);
+                n              = std::snprintf(text, sizeof(text), fmt.c_str(), str.c_str());
+            }
+        }
+        else if (isFloat(spec.conversion))
+        {
+            const double value = (arg->type == ArgFloat) ? arg->f : static_cast<double>(argAsInt(*arg));
+            n                  = std::snprintf(text, sizeof(text), fmt.c_str(), value);
+        }
+        else if (spec.conversion == 'p')
+        {
+            const auto value = static_cast<uintptr_t>(argAsInt(*arg));
+            n                = std::snprintf(text, sizeof(text), fmt.c_str(), reinterpret_cast<void *>(value));
+        }
+        else if (spec.conversion == 'c')
+        {
+            n = std::snprintf(text, sizeof(text), fmt.c_str(), static_cast<int>(argAsInt(*arg)));
+        }
+        else if (isSigned(spec.conversion))
+        {
+            fmt = prefix + "lld";
+            n   = std::snprintf(text, sizeof(text), fmt.c_str(), static_cast<long long>(argAsInt(*arg)));
+        }
+        else if (isUnsigned(spec.conversion))
+        {
+            fmt = prefix + "ll" + spec.conversion;
+            n   = std::snprintf(text, sizeof(text), fmt.c_str(), static_cast<unsigned long long>(argAsInt(*arg)));
+        }
+        else
+        {
+            // %n and unknown conversions are not supported
+            return;
+        }
+
+        if (n > 0)
+        {
+            out.append(text, std::min(static_cast<std::size_t>(n), sizeof(text) - 1));
+        }
+    }
+
+    const char *levelName(uint8_t level)
+    {
+        switch (level)
+        {
+            case Logger::LOG_INFO:
+                return "INFO: ";
+            case Logger::LOG_DEBUG:
+                return "DEBUG: ";
+            case Logger::LOG_WARN:
+                return "WARN: ";
+            case Logger::LOG_ERROR:
+                return "ERROR: ";
+            default:
+                return "";
+        }
+    }
+
+    /// Holds the ring buffer of a thread and releases it to the drain thread on exit
+    struct ThreadBuffer
+    {
+        ~ThreadBuffer()
+        {
+            if (buffer)
+            {
+                buffer->orphaned.store(true, std::memory_order_release);
+            }
+        }
+
+        std::shared_ptr<RingBuffer> buffer;
+    };
+
+    thread_local ThreadBuffer t_buffer;
+}
+
+
+RingBuffer::RingBuffer(std::size_t capacity)
+{
+    std::size_t size = minBufferSize;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    m_storage.reset(new uint64_t[size / sizeof(uint64_t)]);
+    m_data = reinterpret_cast<uint8_t *>(m_storage.get());
+    m_mask = size - 1;
+}
+
+uint8_t *RingBuffer::reserve(std::size_t size)
+{
+    const std::size_t capacity = m_mask + 1;
+    uint64_t head              = m_head.load(std::memory_order_relaxed);
+    const uint64_t tail        = m_tail.load(std::memory_order_acquire);
+
+    // records are never split, the rest of the buffer is skipped with a padding record
+    const std::size_t offset     = head & m_mask;
+    const std::size_t contiguous = capacity - offset;
+    const std::size_t padding    = (size > contiguous) ? contiguous : 0;
+
+    if (size > capacity || (head - tail) + padding + size > capacity)
+    {
+        return nullptr;
+    }
+
+    if (padding)
+    {
+        // only size and site are read from padding records, they fit into the minimum of 8 bytes
+        auto *record = reinterpret_cast<RecordHeader *>(m_data + offset);
+        record->size = static_cast<uint32_t>(padding);
+        record->site = paddingSite;
+        head += padding;
+    }
+
+    m_reserved = head + size;
+    return m_data + (head & m_mask);
+}
+
+void RingBuffer::commit()
+{
+    m_head.store(m_reserved, std::memory_order_release);
+}
+
+
+AsyncLogger &AsyncLogger::instance()
+{
+    static AsyncLogger logger;
+    return logger;
+}
+
+AsyncLogger::AsyncLogger() :
+    m_rateLimit {defaultLimit},
+    m_bufferSize {defaultBufferSize},
+    m_binaryFormatWritten(maxSites, false)
+{
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    shutdown();
+}
+
+int AsyncLogger::acquireSite(const char *format)
+{
+    const auto hash   = reinterpret_cast<uintptr_t>(format);
+    const auto start  = static_cast<std::size_t>((hash >> 3) ^ (hash >> 13));
+    for (std::size_t i = 0; i < maxSites; i++)
+    {
+        const std::size_t index = (start + i) & (maxSites - 1);
+        auto &site              = m_sites[index].format;
+
+        const char *current = site.load(std::memory_order_acquire);
+        if (current == format)
+        {
+            return static_cast<int>(index);
+        }
+        if (current == nullptr)
+        {
+            if (site.compare_exchange_strong(current, format, std::memory_order_acq_rel) || (current == format))
+            {
+                return static_cast<int>(index);
+            }
+        }
+    }
+
+    m_siteOverflows.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
+
+bool AsyncLogger::admit(int index, uint32_t &suppressed, int64_t timestamp)
+{
+    auto &site          = m_sites[index];
+    const uint32_t limit = m_rateLimit.load(std::memory_order_relaxed);
+    if (limit == 0)
+    {
+        suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    int64_t windowStart = site.windowStart.load(std::memory_order_relaxed);
+    if (timestamp - windowStart >= rateWindow)
+    {
+        if (site.windowStart.compare_exchange_strong(windowStart, timestamp, std::memory_order_relaxed))
+        {
+            site.count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    if (site.count.fetch_add(1, std::memory_order_relaxed) >= limit)
+    {
+        site.suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+RingBuffer *AsyncLogger::threadBuffer()
+{
+    if (t_buffer.buffer)
+    {
+        return t_buffer.buffer.get();
+    }
+
+    try
+    {
+        auto buffer = std::make_shared<RingBuffer>(m_bufferSize.load(std::memory_order_relaxed));
+        {
+            std::lock_guard<std::mutex> lock(m_buffersLock);
+            m_buffers.push_back(buffer);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_threadLock);
+            if (!m_stop && !m_thread.joinable())
+            {
+                m_thread = std::thread(&AsyncLogger::run, this);
+            }
+        }
+        t_buffer.buffer = std::move(buffer);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+
+    return t_buffer.buffer.get();
+}
+
+int64_t AsyncLogger::now()
+{
+    return getEpochTime<std::chrono::nanoseconds>();
+}
+
+void AsyncLogger::logv(Logger::LogLevel level, const char *format, va_list args)
+{
+    if (!isEnabled(level))
+    {
+        return;
+    }
+
+    const int site = acquireSite(format);
+    if (site < 0)
+    {
+        return;
+    }
+
+    const int64_t timestamp = now();
+    uint32_t suppressed;
+    if (!admit(site, suppressed, timestamp))
+    {
+        return;
+    }
+
+    // collect the arguments according to the conversion specifications
+    Arg values[maxArgs] {};
+    std::size_t argc = 0;
+    std::size_t size = sizeof(RecordHeader);
+
+    auto add = [&](const Arg &arg) {
+        if (argc < maxArgs)
+        {
+            values[argc++] = arg;
+            size += argSize(arg);
+        }
+    };
+
+    Spec spec;
+    for (const char *p = format; *p;)
+    {
+        if (*p++ != '%')
+        {
+            continue;
+        }
+        if (!parseSpec(p, spec))
+        {
+            continue;
+        }
+
+        Arg arg {};
+        if (spec.width == "*")
+        {
+            arg.type = ArgInt;
+            arg.i    = va_arg(args, int);
+            add(arg);
+        }
+        if (spec.precision == "*")
+        {
+            arg.type = ArgInt;
+            arg.i    = va_arg(args, int);
+            add(arg);
+        }
+
+        const std::string length(spec.length);
+        if (isSigned(spec.conversion))
+        {
+            arg.type = ArgInt;
+            if (length == "l")
+                arg.i = va_arg(args, long);
+            else if (length == "ll")
+                arg.i = va_arg(args, long long);
+            else if (length == "j")
+                arg.i = va_arg(args, intmax_t);
+            else if (length == "z")
+                arg.i = static_cast<int64_t>(va_arg(args, size_t));
+            else if (length == "t")
+                arg.i = va_arg(args, ptrdiff_t);
+            else
+                arg.i = va_arg(args, int);
+        }
+        else if (isUnsigned(spec.conversion))
+        {
+            arg.type = ArgUint;
+            if (length == "l")
+                arg.u = va_arg(args, unsigned long);
+            else if (length == "ll")
+                arg.u = va_arg(args, unsigned long long);
+            else if (length == "j")
+                arg.u = va_arg(args, uintmax_t);
+            else if (length == "z")
+                arg.u = va_arg(args, size_t);
+            else if (length == "t")
+                arg.u = static_cast<uint64_t>(va_arg(args, ptrdiff_t));
+            else
+                arg.u = va_arg(args, unsigned int);
+        }
+        else if (isFloat(spec.conversion))
+        {
+            arg.type = ArgFloat;
+            if (length == "L")
+                arg.f = static_cast<double>(va_arg(args, long double));
+            else
+                arg.f = va_arg(args, double);
+        }
+        else if (spec.conversion == 's')
+        {
+            arg.str  = va_arg(args, const char *);
+            arg.type = ArgString;
+            arg.len  = stringLength(arg.str);
+        }
+        else if (spec.conversion == 'p')
+        {
+            arg.type = ArgPointer;
+            arg.u    = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(va_arg(args, void *)));
+        }
+        else
+        {
+            if (spec.conversion == 'n')
+            {
+                (void)va_arg(args, void *);
+            }
+            continue;
+        }
+        add(arg);
+    }
+    size = (size + 7) & ~static_cast<std::size_t>(7);
+
+    RingBuffer *buffer = threadBuffer();
+    uint8_t *dst       = buffer ? buffer->reserve(size) : nullptr;
+    if (!dst)
+    {
+        if (buffer)
+        {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    auto *header       = reinterpret_cast<RecordHeader *>(dst);
+    header->size       = static_cast<uint32_t>(size);
+    header->site       = static_cast<uint16_t>(site);
+    header->level      = static_cast<uint8_t>(level);
+    header->argc       = static_cast<uint8_t>(argc);
+    header->suppressed = suppressed;
+    header->reserved   = 0;
+    header->timestamp  = timestamp;
+
+    uint8_t *p = dst + sizeof(RecordHeader);
+    for (std::size_t i = 0; i < argc; i++)
+    {
+        encodeArg(p, values[i]);
+    }
+
+    buffer->commit();
+}
+
+void AsyncLogger::run()
+{
+    std::unique_lock<std::mutex> lock(m_threadLock);
+    while (true)
+    {
+        m_wakeup.wait_for(lock, drainInterval, [this] { return m_stop || m_flushRequested; });
+        const bool stop  = m_stop;
+        m_flushRequested = false;
+
+        lock.unlock();
+        drain();
+        lock.lock();
+
+        m_drainCount++;
+        m_flushed.notify_all();
+
+        if (stop)
+        {
+            break;
+        }
+    }
+}
+
+void AsyncLogger::drain()
+{
+    std::lock_guard<std::mutex> drainLock(m_drainLock);
+
+    std::vector<std::shared_ptr<RingBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_buffersLock);
+        buffers = m_buffers;
+    }
+
+    std::vector<RingBuffer *> orphans;
+    uint64_t dropped = 0;
+    for (auto &buffer : buffers)
+    {
+        // an orphaned buffer does not receive new records, so it is empty after this pass
+        const bool orphaned = buffer->orphaned.load(std::memory_order_acquire);
+
+        buffer->consume([this](const RecordHeader *record) {
+            const char *format = m_sites[record->site].format.load(std::memory_order_acquire);
+
+            if (m_binaryFile.is_open())
+            {
+                if (!m_binaryFormatWritten[record->site])
+                {
+                    writeBinaryFormat(record->site, format);
+                }
+                m_binaryFile.write(reinterpret_cast<const char *>(record), record->size);
+            }
+
+            const auto level = static_cast<Logger::LogLevel>(record->level);
+            if (LoggerInstance.isEnabled(level))
+            {
+                const auto logtime = static_cast<std::time_t>(record->timestamp / 1000000000);
+                auto line          = LoggerInstance.log(level, logtime);
+                line << AsyncLogger::format(format, record);
+                if (record->suppressed)
+                {
+                    line << " (" << std::dec << record->suppressed << " similar messages suppressed)";
+                }
+            }
+        });
+
+        dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+        if (orphaned)
+        {
+            orphans.push_back(buffer.get());
+        }
+    }
+
+    if (dropped)
+    {
+        m_droppedTotal.fetch_add(dropped, std::memory_order_relaxed);
+        LOG(WARN) << "AsyncLogger: " << std::dec << dropped << " messages dropped because the buffer was full";
+    }
+
+    if (!orphans.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_buffersLock);
+        m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                       [&orphans](const std::shared_ptr<RingBuffer> &b) {
+                                           return std::find(orphans.begin(), orphans.end(), b.get()) != orphans.end();
+                                       }),
+                        m_buffers.end());
+    }
+
+    if (m_binaryFile.is_open())
+    {
+        m_binaryFile.flush();
+    }
+}
+
+void AsyncLogger::writeBinaryFormat(uint16_t site, const char *format)
+{
+    const std::size_t length = std::strlen(format) + 1;
+    const std::size_t size   = (sizeof(RecordHeader) + length + 7) & ~static_cast<std::size_t>(7);
+
+    RecordHeader header {};
+    header.size  = static_cast<uint32_t>(size);
+    header.site  = site;
+    header.level = formatLevel;
+
+    const char zeros[8] = {};
+    m_binaryFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    m_binaryFile.write(format, length);
+    m_binaryFile.write(zeros, size - sizeof(header) - length);
+
+    m_binaryFormatWritten[site] = true;
+}
+
+void AsyncLogger::flush()
+{
+    std::unique_lock<std::mutex> lock(m_threadLock);
+    if (!m_thread.joinable())
+    {
+        lock.unlock();
+        drain();
+        return;
+    }
+
+    // the drain running at the moment may have missed records committed before this call
+    const uint64_t target = m_drainCount + 2;
+    m_flushRequested      = true;
+    m_wakeup.notify_one();
+    m_flushed.wait(lock, [this, target] { return m_drainCount >= target || m_stop; });
+}
+
+void AsyncLogger::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_threadLock);
+        m_stop = true;
+    }
+    m_wakeup.notify_one();
+    if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id())
+    {
+        m_thread.join();
+    }
+
+    // records of threads that logged after the background thread stopped
+    drain();
+}
+
+void AsyncLogger::setRateLimit(uint32_t recordsPerSecond)
+{
+    m_rateLimit.store(recordsPerSecond, std::memory_order_relaxed);
+}
+
+void AsyncLogger::setBufferSize(std::size_t bytes)
+{
+    m_bufferSize.store(bytes, std::memory_order_relaxed);
+}
+
+void AsyncLogger::setBinaryFile(const char *filename)
+{
+    std::lock_guard<std::mutex> lock(m_drainLock);
+
+    if (m_binaryFile.is_open())
+    {
+        m_binaryFile.close();
+    }
+    m_binaryFileOpen.store(false, std::memory_order_relaxed);
+    std::fill(m_binaryFormatWritten.begin(), m_binaryFormatWritten.end(), false);
+
+    if (filename && filename[0])
+    {
+        m_binaryFile.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (m_binaryFile.is_open())
+        {
+            m_binaryFile.write(binaryMagic, sizeof(binaryMagic));
+            m_binaryFileOpen.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t AsyncLogger::getDroppedCount()
+{
+    return m_droppedTotal.load(std::memory_order_relaxed);
+}
+
+bool AsyncLogger::decode(std::istream &in, std::ostream &out)
+{
+    char magic[sizeof(binaryMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, binaryMagic, sizeof(magic)))
+    {
+        return false;
+    }
+
+    std::map<uint16_t, std::string> formats;
+    std::vector<uint64_t> storage;
+    RecordHeader header;
+    while (in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    {
+        if (header.size < sizeof(header) || (header.size & 7))
+        {
+            return false;
+        }
+
+        storage.resize(header.size / sizeof(uint64_t));
+        auto *data = reinterpret_cast<char *>(storage.data());
+        std::memcpy(data, &header, sizeof(header));
+        if (!in.read(data + sizeof(header), header.size - sizeof(header)))
+        {
+            return false;
+        }
+
+        if (header.level == formatLevel)
+        {
+            formats[header.site].assign(data + sizeof(header));
+            continue;
+        }
+
+        const auto it = formats.find(header.site);
+        if (it == formats.end())
+        {
+            return false;
+        }
+
+        const auto seconds = static_cast<std::time_t>(header.timestamp / 1000000000);
+        const auto millis  = static_cast<int>((header.timestamp / 1000000) % 1000);
+        std::tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &seconds);
+#else
+        localtime_r(&seconds, &tm);
+#endif
+        char timestamp[32];
+        std::strftime(timestamp, sizeof(timestamp), "[%Y-%m-%d %H:%M:%S", &tm);
+        char fraction[8];
+        std::snprintf(fraction, sizeof(fraction), ".%03d] ", millis);
+
+        out << timestamp << fraction << levelName(header.level)
+            << format(it->second.c_str(), reinterpret_cast<const RecordHeader *>(data));
+        if (header.suppressed)
+        {
+            out << " (" << std::dec << header.suppressed << " similar messages suppressed)";
+        }
+        out << '\n';
+    }
+
+    return in.eof();
+}
+
+std::string AsyncLogger::format(const char *format, const RecordHeader *record)
+{
+    std::string out;
+    if (!format)
+    {
+        return out;
+    }
+
+    ArgReader reader(record);
+    Arg arg {};
+    Spec spec;
+    for (const char *p = format; *p;)
+    {
+        if (*p != '%')
+        {
+            out += *p++;
+            continue;
+        }
+        p++;
+
+        const char *start = p;
+        if (!parseSpec(p, spec))
+        {
+            if (spec.conversion == '%')
+            {
+                out += '%';
+            }
+            else
+            {
+                out.append(start - 1, p);
+            }
+            continue;
+        }
+
+        if (spec.width == "*")
+        {
+            spec.width = std::to_string(reader.next(arg) ? argAsInt(arg) : 0);
+            if (spec.width[0] == '-')
+            {
+                spec.flags += '-';
+                spec.width.erase(0, 1);
+            }
+        }
+        if (spec.precision == "*")
+        {
+            const auto precision = reader.next(arg) ? argAsInt(arg) : 0;
+            spec.precision       = (precision < 0) ? "" : std::to_string(precision);
+        }
+
+        appendSpec(out, spec, reader.next(arg) ? &arg : nullptr);
+    }
+
+    return out;
+}
@@ -0,0 +1,437 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#pragma once
+
+#include "Logger.hpp"
+
+#include <Definitions.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+/**
+ * @brief Log a printf-style message without formatting it on the calling thread
+ *
+ * The format string must be a string literal (its address identifies the
+ * call site). The arguments are copied into a per-thread ring buffer and
+ * formatted later by a background thread, so the call never blocks and does
+ * no I/O. If the ring buffer of the thread is full the message is dropped
+ * and counted.
+ *
+ * Example: LOGF(DEBUG, "Packet type error: 0x%02x", bmPktType);
+ */
+#define LOGF(X, ...)                                                  \
+    do                                                                \
+    {                                                                 \
+        auto &asyncLogger_ = AsyncLogger::instance();                 \
+        if (asyncLogger_.isEnabled(Logger::LOG_##X))                  \
+        {                                                             \
+            asyncLogger_.log(Logger::LOG_##X, __VA_ARGS__);           \
+        }                                                             \
+    } while (0)
+
+
+namespace AsyncLog
+{
+    /// Type tags of the encoded arguments
+    enum ArgType : uint8_t
+    {
+        ArgInt     = 'i',
+        ArgUint    = 'u',
+        ArgFloat   = 'f',
+        ArgString  = 's',
+        ArgPointer = 'p',
+    };
+
+    /// Strings are truncated to this length
+    constexpr std::size_t maxStringLength = 255;
+
+    /// Header of a record in the ring buffer and in the binary log file
+    struct RecordHeader
+    {
+        uint32_t size;        ///< size of the record including header and padding
+        uint16_t site;        ///< index of the format string
+        uint8_t level;        ///< Logger::LogLevel
+        uint8_t argc;         ///< number of encoded arguments
+        uint32_t suppressed;  ///< number of records of this site dropped by the rate limit before this one
+        uint32_t reserved;
+        int64_t timestamp;    ///< nanoseconds since epoch (system clock)
+    };
+    static_assert(sizeof(RecordHeader) == 24, "unexpected padding");
+
+    /// site value of a padding record at the end of the ring buffer
+    constexpr uint16_t paddingSite = 0xFFFF;
+
+    // encodedSize() / encode() for the supported argument types
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, std::size_t>::type
+    encodedSize(const T &)
+    {
+        return 1 + sizeof(int64_t);
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    encode(uint8_t *&dst, const T &value)
+    {
+        const auto v = static_cast<int64_t>(value);
+        *dst++       = ArgInt;
+        std::memcpy(dst, &v, sizeof(v));
+        dst += sizeof(v);
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, std::size_t>::type
+    encodedSize(const T &)
+    {
+        return 1 + sizeof(uint64_t);
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    encode(uint8_t *&dst, const T &value)
+    {
+        const auto v = static_cast<uint64_t>(value);
+        *dst++       = ArgUint;
+        std::memcpy(dst, &v, sizeof(v));
+        dst += sizeof(v);
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_enum<T>::value, std::size_t>::type
+    encodedSize(const T &value)
+    {
+        return encodedSize(static_cast<typename std::underlying_type<T>::type>(value));
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_enum<T>::value>::type
+    encode(uint8_t *&dst, const T &value)
+    {
+        encode(dst, static_cast<typename std::underlying_type<T>::type>(value));
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_floating_point<T>::value, std::size_t>::type
+    encodedSize(const T &)
+    {
+        return 1 + sizeof(double);
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_floating_point<T>::value>::type
+    encode(uint8_t *&dst, const T &value)
+    {
+        const auto v = static_cast<double>(value);
+        *dst++       = ArgFloat;
+        std::memcpy(dst, &v, sizeof(v));
+        dst += sizeof(v);
+    }
+
+    inline std::size_t stringLength(const char *str)
+    {
+        if (!str)
+        {
+            return 0;
+        }
+        std::size_t len = 0;
+        while (len < maxStringLength && str[len])
+        {
+            len++;
+        }
+        return len;
+    }
+
+    inline std::size_t encodedSize(const char *str)
+    {
+        return 1 + 1 + stringLength(str);
+    }
+
+    inline void encodeString(uint8_t *&dst, const char *str, std::size_t len)
+    {
+        *dst++ = ArgString;
+        *dst++ = static_cast<uint8_t>(len);
+        std::memcpy(dst, str, len);
+        dst += len;
+    }
+
+    inline void encode(uint8_t *&dst, const char *str)
+    {
+        encodeString(dst, str, stringLength(str));
+    }
+
+    inline std::size_t encodedSize(const std::string &str)
+    {
+        return 1 + 1 + std::min(str.size(), maxStringLength);
+    }
+
+    inline void encode(uint8_t *&dst, const std::string &str)
+    {
+        encodeString(dst, str.data(), std::min(str.size(), maxStringLength));
+    }
+
+    template <typename T>
+    inline typename std::enable_if<!std::is_same<typename std::remove_cv<T>::type, char>::value, std::size_t>::type
+    encodedSize(const T *)
+    {
+        return 1 + sizeof(uint64_t);
+    }
+
+    template <typename T>
+    inline typename std::enable_if<!std::is_same<typename std::remove_cv<T>::type, char>::value>::type
+    encode(uint8_t *&dst, const T *ptr)
+    {
+        const auto v = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+        *dst++       = ArgPointer;
+        std::memcpy(dst, &v, sizeof(v));
+        dst += sizeof(v);
+    }
+
+    /**
+     * @brief Single producer / single consumer ring buffer of records
+     *
+     * The producer is the thread owning the buffer, the consumer is the
+     * background thread of the AsyncLogger. Neither side blocks.
+     */
+    class RingBuffer
+    {
+    public:
+        STRATA_API explicit RingBuffer(std::size_t capacity);
+
+        /// Reserve size bytes (multiple of 8). Returns nullptr if the buffer is full.
+        STRATA_API uint8_t *reserve(std::size_t size);
+        /// Publish the record written to the memory returned by reserve()
+        STRATA_API void commit();
+
+        /// Consume all published records, calls f(const RecordHeader *) for each record
+        template <typename F>
+        void consume(F f);
+
+        bool empty() const
+        {
+            return m_tail.load(std::memory_order_relaxed) == m_head.load(std::memory_order_acquire);
+        }
+
+        std::atomic<uint64_t> dropped {0};
+        std::atomic<bool> orphaned {false};
+
+    private:
+        std::unique_ptr<uint64_t[]> m_storage;  // uint64_t for alignment
+        uint8_t *m_data;
+        std::size_t m_mask;
+        uint64_t m_reserved = 0;  // head after the pending record (producer only)
+        alignas(64) std::atomic<uint64_t> m_head {0};
+        alignas(64) std::atomic<uint64_t> m_tail {0};
+    };
+
+    template <typename F>
+    void RingBuffer::consume(F f)
+    {
+        uint64_t tail       = m_tail.load(std::memory_order_relaxed);
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        while (tail != head)
+        {
+            const auto *record = reinterpret_cast<const RecordHeader *>(m_data + (tail & m_mask));
+            if (record->site != paddingSite)
+            {
+                f(record);
+            }
+            tail += record->size;
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+}
+
+
+/**
+ * @brief Asynchronous logger with binary records
+ *
+ * Messages are stored as binary records (format id plus raw arguments) in
+ * per-thread lock-free ring buffers. A background thread drains the
+ * buffers, formats the records and writes them to the Logger (console and
+ * log file). Optionally the raw records are also written to a binary file
+ * that can be converted to text later with decode(), e.g. by the
+ * log-decoder tool.
+ *
+ * To limit the load caused by a single call site (e.g. a message in a
+ * packet loop), the number of records per call site and second can be
+ * limited. Dropped records are reported with the next accepted record of
+ * the same call site.
+ */
+class AsyncLogger
+{
+public:
+    STRATA_API static AsyncLogger &instance();
+
+    AsyncLogger(const AsyncLogger &) = delete;
+    AsyncLogger &operator=(const AsyncLogger &) = delete;
+
+    /// True if a message of level is written to the Logger or to the binary file
+    bool isEnabled(Logger::LogLevel level) const
+    {
+        return LoggerInstance.isEnabled(level) || m_binaryFileOpen.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Enqueue a message with printf-style format
+     *
+     * The format string must have static storage duration.
+     */
+    template <typename... Args>
+    void log(Logger::LogLevel level, const char *format, const Args &... args);
+
+    /**
+     * @brief Enqueue a message whose arguments are given as va_list
+     *
+     * The argument types are derived from the conversion specifications of
+     * the format string. This is meant for C interfaces. The format string
+     * must have static storage duration.
+     */
+    STRATA_API void logv(Logger::LogLevel level, const char *format, va_list args);
+
+    /// Block until all records enqueued before this call have been written
+    STRATA_API void flush();
+
+    /// Stop the background thread after writing all pending records
+    STRATA_API void shutdown();
+
+    /// Maximum number of records per call site and second (0: unlimited)
+    STRATA_API void setRateLimit(uint32_t recordsPerSecond);
+
+    /// Size of the ring buffers of threads that log for the first time
+    STRATA_API void setBufferSize(std::size_t bytes);
+
+    /// Additionally write the binary records to filename (nullptr to close)
+    STRATA_API void setBinaryFile(const char *filename);
+
+    /// Total number of records dropped because a ring buffer was full
+    STRATA_API uint64_t getDroppedCount();
+
+    /**
+     * @brief Convert a binary log file to text
+     *
+     * @return false if the input is not a valid binary log
+     */
+    STRATA_API static bool decode(std::istream &in, std::ostream &out);
+
+    /// Format a record with the printf-style format string
+    STRATA_API static std::string format(const char *format, const AsyncLog::RecordHeader *record);
+
+private:
+    struct Site
+    {
+        std::atomic<const char *> format {nullptr};
+        std::atomic<int64_t> windowStart {0};
+        std::atomic<uint32_t> count {0};
+        std::atomic<uint32_t> suppressed {0};
+    };
+
+    static constexpr std::size_t maxSites = 1024;
+
+    AsyncLogger();
+    ~AsyncLogger();
+
+    STRATA_API int acquireSite(const char *format);
+    STRATA_API bool admit(int site, uint32_t &suppressed, int64_t now);
+    STRATA_API AsyncLog::RingBuffer *threadBuffer();
+    STRATA_API static int64_t now();
+
+    void run();
+    void drain();
+    void writeBinaryFormat(uint16_t site, const char *format);
+
+    Site m_sites[maxSites];
+    std::atomic<uint32_t> m_rateLimit;
+    std::atomic<std::size_t> m_bufferSize;
+    std::atomic<uint64_t> m_siteOverflows {0};
+
+    std::mutex m_buffersLock;
+    std::vector<std::shared_ptr<AsyncLog::RingBuffer>> m_buffers;
+    std::atomic<uint64_t> m_droppedTotal {0};
+
+    std::mutex m_drainLock;  // serializes drain() and the binary file
+    std::ofstream m_binaryFile;
+    std::atomic<bool> m_binaryFileOpen {false};
+    std::vector<bool> m_binaryFormatWritten;
+
+    std::mutex m_threadLock;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_flushed;
+    std::thread m_thread;
+    bool m_stop           = false;
+    bool m_flushRequested = false;
+    uint64_t m_drainCount = 0;
+};
+
+
+template <typename... Args>
+void AsyncLogger::log(Logger::LogLevel level, const char *format, const Args &... args)
+{
+    const int site = acquireSite(format);
+    if (site < 0)
+    {
+        return;
+    }
+
+    const int64_t timestamp = now();
+    uint32_t suppressed;
+    if (!admit(site, suppressed, timestamp))
+    {
+        return;
+    }
+
+    const std::size_t sizes[] = {sizeof(AsyncLog::RecordHeader), AsyncLog::encodedSize(args)...};
+    std::size_t size          = 0;
+    for (auto s : sizes)
+    {
+        size += s;
+    }
+    size = (size + 7) & ~static_cast<std::size_t>(7);
+
+    AsyncLog::RingBuffer *buffer = threadBuffer();
+    uint8_t *dst                 = buffer ? buffer->reserve(size) : nullptr;
+    if (!dst)
+    {
+        if (buffer)
+        {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    auto *header       = reinterpret_cast<AsyncLog::RecordHeader *>(dst);
+    header->size       = static_cast<uint32_t>(size);
+    header->site       = static_cast<uint16_t>(site);
+    header->level      = static_cast<uint8_t>(level);
+    header->argc       = static_cast<uint8_t>(sizeof...(args));
+    header->suppressed = suppressed;
+    header->reserved   = 0;
+    header->timestamp  = timestamp;
+
+    uint8_t *p = dst + sizeof(AsyncLog::RecordHeader);
+    const int dummy[] = {0, (AsyncLog::encode(p, args), 0)...};
+    (void)dummy;
+    (void)p;  // unused if there are no arguments
+
+    buffer->commit();
+}
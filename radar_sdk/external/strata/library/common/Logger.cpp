@@ -100,7 +100,16 @@ Logger::Line Logger::log(Logger::LogLevel level)
         return Logger::Line(nullptr);
     }
 
-    std::time_t logtime = std::time(nullptr);
+    return log(level, std::time(nullptr));
+}
+
+Logger::Line Logger::log(Logger::LogLevel level, std::time_t logtime)
+{
+    if (level > m_logLevel)
+    {
+        return Logger::Line(nullptr);
+    }
+
     std::tm tm;
 #ifdef _WIN32
     localtime_s(&tm, &logtime);
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -100,7 +101,13 @@ public:
     void setLevel(LogLevel level);
     void setFile(const char *filename);
 
+    bool isEnabled(LogLevel level) const
+    {
+        return level <= m_logLevel;
+    }
+
     Line log(LogLevel level);
+    Line log(LogLevel level, std::time_t logtime);
 
 protected:
     std::mutex m_lineLock;
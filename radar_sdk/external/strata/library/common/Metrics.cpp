@@ -0,0 +1,328 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#include "Metrics.hpp"
+
+#include <chrono>
+#include <limits>
+#include <sstream>
+
+
+namespace
+{
+    std::atomic<bool> metricsEnabled {true};
+
+    // quantiles exported by toJson() and toPrometheus()
+    const struct
+    {
+        double quantile;
+        const char *name;
+    } exportedQuantiles[] = {
+        {0.5, "p50"},
+        {0.9, "p90"},
+        {0.99, "p99"},
+        {0.999, "p999"},
+    };
+
+    template <typename T>
+    T &findOrCreate(std::vector<std::unique_ptr<T>> &list, const char *name)
+    {
+        for (auto &entry : list)
+        {
+            if (entry->getName() == name)
+            {
+                return *entry;
+            }
+        }
+        list.emplace_back(new T(name));
+        return *list.back();
+    }
+
+    template <typename T>
+    std::vector<T *> copyList(const std::vector<std::unique_ptr<T>> &list)
+    {
+        std::vector<T *> result;
+        result.reserve(list.size());
+        for (auto &entry : list)
+        {
+            result.push_back(entry.get());
+        }
+        return result;
+    }
+
+    // metric names are chosen by the code, but make sure they are valid in the exports
+    std::string sanitizeName(const std::string &name)
+    {
+        std::string result(name);
+        for (auto &c : result)
+        {
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'))
+            {
+                c = '_';
+            }
+        }
+        return result;
+    }
+
+    double toSeconds(uint64_t ns)
+    {
+        return static_cast<double>(ns) * 1e-9;
+    }
+}
+
+
+LatencyHistogram::LatencyHistogram(const char *name) :
+    m_name {name},
+    m_buckets {new std::atomic<uint64_t>[bucketCount]}
+{
+    for (std::size_t i = 0; i < bucketCount; i++)
+    {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getSum() const
+{
+    return m_sum.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMin() const
+{
+    const auto min = m_min.load(std::memory_order_relaxed);
+    return (min == std::numeric_limits<uint64_t>::max()) ? 0 : min;
+}
+
+uint64_t LatencyHistogram::getMax() const
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(std::size_t index)
+{
+    if (index < subBucketCount)
+    {
+        return index;
+    }
+    const auto shift = static_cast<unsigned>((index >> subBucketBits) - 1);
+    const auto lower = static_cast<uint64_t>(subBucketCount + (index & (subBucketCount - 1))) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+uint64_t LatencyHistogram::getPercentile(double quantile) const
+{
+    // the buckets are read one by one while other threads may record, so
+    // the total is taken from the buckets themselves
+    uint64_t total = 0;
+    for (std::size_t i = 0; i < bucketCount; i++)
+    {
+        total += m_buckets[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    quantile            = (quantile < 0.0) ? 0.0 : ((quantile > 1.0) ? 1.0 : quantile);
+    auto rank           = static_cast<uint64_t>(quantile * static_cast<double>(total) + 0.5);
+    rank                = (rank == 0) ? 1 : rank;
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < bucketCount; i++)
+    {
+        cumulative += m_buckets[i].load(std::memory_order_relaxed);
+        if (cumulative >= rank)
+        {
+            const auto max = getMax();
+            const auto upper = bucketUpperBound(i);
+            return (max && upper > max) ? max : upper;
+        }
+    }
+    return getMax();
+}
+
+void LatencyHistogram::reset()
+{
+    for (std::size_t i = 0; i < bucketCount; i++)
+    {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+
+Metrics &Metrics::instance()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+LatencyHistogram &Metrics::latency(const char *name)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return findOrCreate(m_latencies, name);
+}
+
+MetricsCounter &Metrics::counter(const char *name)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return findOrCreate(m_counters, name);
+}
+
+MetricsGauge &Metrics::gauge(const char *name)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return findOrCreate(m_gauges, name);
+}
+
+std::vector<LatencyHistogram *> Metrics::getLatencies()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return copyList(m_latencies);
+}
+
+std::vector<MetricsCounter *> Metrics::getCounters()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return copyList(m_counters);
+}
+
+std::vector<MetricsGauge *> Metrics::getGauges()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return copyList(m_gauges);
+}
+
+void Metrics::reset()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (auto &latency : m_latencies)
+    {
+        latency->reset();
+    }
+    for (auto &counter : m_counters)
+    {
+        counter->reset();
+    }
+    for (auto &gauge : m_gauges)
+    {
+        gauge->reset();
+    }
+}
+
+void Metrics::setEnabled(bool enabled)
+{
+    metricsEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Metrics::isEnabled()
+{
+    return metricsEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t Metrics::now()
+{
+    const auto time = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+}
+
+std::string Metrics::toJson()
+{
+    std::ostringstream out;
+    out << "{\"latencies\":{";
+    const char *separator = "";
+    for (auto *latency : getLatencies())
+    {
+        const auto count = latency->getCount();
+        out << separator << "\"" << sanitizeName(latency->getName()) << "\":{"
+            << "\"count\":" << count
+            << ",\"sum_ns\":" << latency->getSum()
+            << ",\"mean_ns\":" << (count ? latency->getSum() / count : 0)
+            << ",\"min_ns\":" << latency->getMin()
+            << ",\"max_ns\":" << latency->getMax();
+        for (const auto &q : exportedQuantiles)
+        {
+            out << ",\"" << q.name << "_ns\":" << latency->getPercentile(q.quantile);
+        }
+        out << "}";
+        separator = ",";
+    }
+
+    out << "},\"counters\":{";
+    separator = "";
+    for (auto *counter : getCounters())
+    {
+        out << separator << "\"" << sanitizeName(counter->getName()) << "\":" << counter->get();
+        separator = ",";
+    }
+
+    out << "},\"gauges\":{";
+    separator = "";
+    for (auto *gauge : getGauges())
+    {
+        out << separator << "\"" << sanitizeName(gauge->getName()) << "\":{\"value\":" << gauge->get()
+            << ",\"max\":" << gauge->getMax() << "}";
+        separator = ",";
+    }
+    out << "}}";
+
+    return out.str();
+}
+
+std::string Metrics::toPrometheus()
+{
+    std::ostringstream out;
+    out.precision(9);
+
+    const auto latencies = getLatencies();
+    if (!latencies.empty())
+    {
+        out << "# HELP rdk_stage_latency_seconds Latency of a pipeline stage\n"
+            << "# TYPE rdk_stage_latency_seconds summary\n";
+        for (auto *latency : latencies)
+        {
+            const auto name = sanitizeName(latency->getName());
+            for (const auto &q : exportedQuantiles)
+            {
+                out << "rdk_stage_latency_seconds{stage=\"" << name << "\",quantile=\"" << q.quantile << "\"} "
+                    << toSeconds(latency->getPercentile(q.quantile)) << "\n";
+            }
+            out << "rdk_stage_latency_seconds_sum{stage=\"" << name << "\"} " << toSeconds(latency->getSum()) << "\n"
+                << "rdk_stage_latency_seconds_count{stage=\"" << name << "\"} " << latency->getCount() << "\n";
+        }
+    }
+
+    for (auto *counter : getCounters())
+    {
+        const auto name = "rdk_" + sanitizeName(counter->getName()) + "_total";
+        out << "# TYPE " << name << " counter\n"
+            << name << " " << counter->get() << "\n";
+    }
+
+    for (auto *gauge : getGauges())
+    {
+        const auto name = "rdk_" + sanitizeName(gauge->getName());
+        out << "# TYPE " << name << " gauge\n"
+            << name << " " << gauge->get() << "\n"
+            << "# TYPE " << name << "_max gauge\n"
+            << name << "_max " << gauge->getMax() << "\n";
+    }
+
+    return out.str();
+}
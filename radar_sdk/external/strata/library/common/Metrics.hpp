@@ -0,0 +1,278 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#pragma once
+
+#include <Definitions.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Latency histogram with logarithmic buckets
+ *
+ * Values (nanoseconds) below 16 have their own bucket, above that every
+ * power of two is split into 16 linear sub-buckets, so the relative error
+ * of a percentile is at most 6.25%. Recording is lock-free and can be done
+ * from any thread.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned subBucketBits    = 4;
+    static constexpr unsigned subBucketCount   = 1u << subBucketBits;
+    static constexpr std::size_t bucketCount   = (64 - subBucketBits + 1) * subBucketCount;
+
+    STRATA_API explicit LatencyHistogram(const char *name);
+
+    const std::string &getName() const
+    {
+        return m_name;
+    }
+
+    void record(uint64_t ns)
+    {
+        m_buckets[bucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(ns, std::memory_order_relaxed);
+
+        uint64_t current = m_min.load(std::memory_order_relaxed);
+        while (ns < current && !m_min.compare_exchange_weak(current, ns, std::memory_order_relaxed))
+        {
+        }
+        current = m_max.load(std::memory_order_relaxed);
+        while (ns > current && !m_max.compare_exchange_weak(current, ns, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    STRATA_API uint64_t getCount() const;
+    STRATA_API uint64_t getSum() const;
+    STRATA_API uint64_t getMin() const;
+    STRATA_API uint64_t getMax() const;
+
+    /// Upper bound of the bucket containing the given quantile (0.0 ... 1.0), 0 if empty
+    STRATA_API uint64_t getPercentile(double quantile) const;
+
+    STRATA_API void reset();
+
+    static std::size_t bucketIndex(uint64_t ns)
+    {
+        if (ns < subBucketCount)
+        {
+            return static_cast<std::size_t>(ns);
+        }
+        const unsigned exponent = highestBit(ns);
+        const unsigned shift    = exponent - subBucketBits;
+        return ((exponent - subBucketBits + 1) << subBucketBits) + static_cast<std::size_t>((ns >> shift) - subBucketCount);
+    }
+
+    /// Largest value that falls into a bucket
+    STRATA_API static uint64_t bucketUpperBound(std::size_t index);
+
+private:
+    static unsigned highestBit(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        while (value >>= 1)
+        {
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    const std::string m_name;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_min;
+    std::atomic<uint64_t> m_max;
+};
+
+
+/**
+ * @brief Monotonic event counter (drops, reallocations, ...)
+ */
+class MetricsCounter
+{
+public:
+    explicit MetricsCounter(const char *name) :
+        m_name {name},
+        m_value {0}
+    {}
+
+    const std::string &getName() const
+    {
+        return m_name;
+    }
+
+    void add(uint64_t count = 1)
+    {
+        m_value.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    uint64_t get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        m_value.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    const std::string m_name;
+    std::atomic<uint64_t> m_value;
+};
+
+
+/**
+ * @brief Current value of a level (e.g. queue depth) and its maximum
+ */
+class MetricsGauge
+{
+public:
+    explicit MetricsGauge(const char *name) :
+        m_name {name},
+        m_value {0},
+        m_max {0}
+    {}
+
+    const std::string &getName() const
+    {
+        return m_name;
+    }
+
+    void set(int64_t value)
+    {
+        m_value.store(value, std::memory_order_relaxed);
+        int64_t current = m_max.load(std::memory_order_relaxed);
+        while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    int64_t get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    int64_t getMax() const
+    {
+        return m_max.load(std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        m_max.store(m_value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+private:
+    const std::string m_name;
+    std::atomic<int64_t> m_value;
+    std::atomic<int64_t> m_max;
+};
+
+
+/**
+ * @brief Registry of the pipeline metrics
+ *
+ * Metrics are created on first use and live until the end of the process,
+ * so call sites can keep a reference in a function-local static:
+ *
+ *     static auto &latency = Metrics::instance().latency("bridge_receive");
+ *     MetricsScope measure(latency);
+ *
+ * Collection is enabled by default and costs two clock reads and a few
+ * relaxed atomic increments per measured scope.
+ */
+class Metrics
+{
+public:
+    STRATA_API static Metrics &instance();
+
+    Metrics(const Metrics &) = delete;
+    Metrics &operator=(const Metrics &) = delete;
+
+    STRATA_API LatencyHistogram &latency(const char *name);
+    STRATA_API MetricsCounter &counter(const char *name);
+    STRATA_API MetricsGauge &gauge(const char *name);
+
+    /// Copies of the registered metrics lists (the metrics themselves are never deleted)
+    STRATA_API std::vector<LatencyHistogram *> getLatencies();
+    STRATA_API std::vector<MetricsCounter *> getCounters();
+    STRATA_API std::vector<MetricsGauge *> getGauges();
+
+    /// Clear all values (the metrics stay registered)
+    STRATA_API void reset();
+
+    STRATA_API static void setEnabled(bool enabled);
+    STRATA_API static bool isEnabled();
+
+    /// Monotonic timestamp in nanoseconds
+    STRATA_API static uint64_t now();
+
+    /// All metrics as JSON object
+    STRATA_API std::string toJson();
+
+    /// All metrics in the Prometheus text exposition format
+    STRATA_API std::string toPrometheus();
+
+private:
+    Metrics() = default;
+
+    std::mutex m_lock;
+    std::vector<std::unique_ptr<LatencyHistogram>> m_latencies;
+    std::vector<std::unique_ptr<MetricsCounter>> m_counters;
+    std::vector<std::unique_ptr<MetricsGauge>> m_gauges;
+};
+
+
+/**
+ * @brief Records the lifetime of the object in a latency histogram
+ */
+class MetricsScope
+{
+public:
+    explicit MetricsScope(LatencyHistogram &histogram) :
+        m_histogram {histogram},
+        m_start {Metrics::isEnabled() ? Metrics::now() : 0}
+    {}
+
+    ~MetricsScope()
+    {
+        if (m_start)
+        {
+            m_histogram.record(Metrics::now() - m_start);
+        }
+    }
+
+    MetricsScope(const MetricsScope &) = delete;
+    MetricsScope &operator=(const MetricsScope &) = delete;
+
+    /// Do not record anything, e.g. if a read returned without data
+    void dismiss()
+    {
+        m_start = 0;
+    }
+
+private:
+    LatencyHistogram &m_histogram;
+    uint64_t m_start;
+};
@@ -0,0 +1,66 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#pragma once
+
+#include <common/Finally.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace strata
+{
+
+    /// Calls function(i) for every i in [0, count) on at most maxThreads threads,
+    /// the calling thread included. Items are taken in ascending order.
+    ///
+    /// All started threads are joined before returning. If a thread cannot be started,
+    /// the remaining items are processed by the threads that are running.
+    /// The function must not throw when called on another thread.
+    template <typename FunctionType>
+    void parallelFor(std::size_t count, std::size_t maxThreads, FunctionType &&function)
+    {
+        std::atomic<std::size_t> next {0};
+        auto worker = [&next, &function, count]() {
+            for (auto i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+            {
+                function(i);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        auto joinThreads = finally([&threads]() {
+            for (auto &t : threads)
+            {
+                t.join();
+            }
+        });
+
+        const auto extraThreads = std::min(count, std::max<std::size_t>(maxThreads, 1)) - std::min<std::size_t>(count, 1);
+        try
+        {
+            threads.reserve(extraThreads);
+            for (std::size_t t = 0; t < extraThreads; t++)
+            {
+                threads.emplace_back(worker);
+            }
+        }
+        catch (...)
+        {
+            // continue with the threads started so far
+        }
+
+        worker();
+    }
+
+}
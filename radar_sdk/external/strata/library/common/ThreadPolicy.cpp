@@ -0,0 +1,255 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#include "ThreadPolicy.hpp"
+
+#include "Logger.hpp"
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+#endif
+
+
+namespace
+{
+    const unsigned roleCount = static_cast<unsigned>(ThreadRole::Count);
+
+    // thread names are limited to 15 characters on Linux
+    const char *const threadNames[roleCount] = {
+        "strata-reader",
+        "strata-forward",
+        "strata-convert",
+        "strata-dsp",
+    };
+
+    const char *const wakeupNames[roleCount] = {
+        "thread_wakeup_reader",
+        "thread_wakeup_forwarder",
+        "thread_wakeup_converter",
+        "thread_wakeup_dsp",
+    };
+
+    thread_local ThreadRole threadRole = ThreadRole::Count;
+
+    std::atomic<bool> prefaultEnabled {false};
+}
+
+
+ThreadPolicies &ThreadPolicies::instance()
+{
+    static ThreadPolicies policies;
+    return policies;
+}
+
+ThreadPolicies::ThreadPolicies() :
+    m_warned {false}
+{
+    for (unsigned i = 0; i < roleCount; i++)
+    {
+        m_policies[i] = {ThreadPolicy::Default, 0, 0};
+        m_wakeups[i]  = &Metrics::instance().latency(wakeupNames[i]);
+    }
+}
+
+void ThreadPolicies::set(ThreadRole role, const ThreadPolicy &policy)
+{
+    const auto index = static_cast<unsigned>(role);
+    if (index >= roleCount)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_policies[index] = policy;
+}
+
+ThreadPolicy ThreadPolicies::get(ThreadRole role)
+{
+    const auto index = static_cast<unsigned>(role);
+    if (index >= roleCount)
+    {
+        return {ThreadPolicy::Default, 0, 0};
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_policies[index];
+}
+
+bool ThreadPolicies::apply(ThreadRole role)
+{
+    const auto index = static_cast<unsigned>(role);
+    if (index >= roleCount)
+    {
+        return false;
+    }
+
+    if (threadRole != ThreadRole::Count)
+    {
+        // roles are assigned once per thread, a second role would override the first policy
+        if (threadRole != role)
+        {
+            LOG(DEBUG) << "ThreadPolicies - thread " << threadNames[static_cast<unsigned>(threadRole)] << " keeps its role";
+            return false;
+        }
+        return true;
+    }
+
+    threadRole        = role;
+    const auto policy = get(role);
+    bool success      = true;
+
+#ifdef _WIN32
+    if (policy.cpuMask)
+    {
+        if (!SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(policy.cpuMask)))
+        {
+            denied("CPU affinity", static_cast<int>(GetLastError()));
+            success = false;
+        }
+    }
+
+    if (policy.scheduling != ThreadPolicy::Default)
+    {
+        const int priority = (policy.scheduling == ThreadPolicy::Fifo) ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST;
+        if (!SetThreadPriority(GetCurrentThread(), priority))
+        {
+            denied("thread priority", static_cast<int>(GetLastError()));
+            success = false;
+        }
+    }
+#else
+    const auto self = pthread_self();
+
+    #if defined(__linux__)
+    pthread_setname_np(self, threadNames[index]);
+
+    if (policy.cpuMask)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (unsigned cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++)
+        {
+            if (policy.cpuMask & (uint64_t(1) << cpu))
+            {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        const int error = pthread_setaffinity_np(self, sizeof(cpus), &cpus);
+        if (error)
+        {
+            denied("CPU affinity", error);
+            success = false;
+        }
+    }
+    #elif defined(__APPLE__)
+    pthread_setname_np(threadNames[index]);
+
+    if (policy.cpuMask)
+    {
+        LOG(DEBUG) << "ThreadPolicies - CPU affinity is not supported on this platform";
+    }
+    #endif
+
+    if (policy.scheduling != ThreadPolicy::Default)
+    {
+        const int schedPolicy = (policy.scheduling == ThreadPolicy::Fifo) ? SCHED_FIFO : SCHED_RR;
+        sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        param.sched_priority = std::min(std::max(policy.priority, sched_get_priority_min(schedPolicy)),
+                                        sched_get_priority_max(schedPolicy));
+
+        const int error = pthread_setschedparam(self, schedPolicy, &param);
+        if (error)
+        {
+            denied("real-time scheduling", error);
+            success = false;
+        }
+    }
+#endif
+
+    return success;
+}
+
+ThreadRole ThreadPolicies::currentRole()
+{
+    return threadRole;
+}
+
+void ThreadPolicies::recordWakeup(uint64_t ns)
+{
+    const auto index = static_cast<unsigned>(threadRole);
+    if (index < roleCount)
+    {
+        instance().m_wakeups[index]->record(ns);
+    }
+}
+
+bool ThreadPolicies::lockMemory(bool enable)
+{
+#ifdef _WIN32
+    if (enable)
+    {
+        LOG(WARN) << "ThreadPolicies - locking all process memory is not supported on this platform, use FramePool::setLockMemory() instead";
+        return false;
+    }
+    return true;
+#else
+    const int result = enable ? mlockall(MCL_CURRENT | MCL_FUTURE) : munlockall();
+    if (result)
+    {
+        denied("memory locking", errno);
+        return false;
+    }
+    return true;
+#endif
+}
+
+void ThreadPolicies::setPrefault(bool enable)
+{
+    prefaultEnabled = enable;
+}
+
+bool ThreadPolicies::isPrefault()
+{
+    return prefaultEnabled.load(std::memory_order_relaxed);
+}
+
+const char *ThreadPolicies::getThreadName(ThreadRole role)
+{
+    const auto index = static_cast<unsigned>(role);
+    return (index < roleCount) ? threadNames[index] : "";
+}
+
+const char *ThreadPolicies::getWakeupName(ThreadRole role)
+{
+    const auto index = static_cast<unsigned>(role);
+    return (index < roleCount) ? wakeupNames[index] : "";
+}
+
+void ThreadPolicies::denied(const char *what, int error)
+{
+    static auto &deniedCount = Metrics::instance().counter("thread_policy_denied");
+    deniedCount.add();
+
+    // missing privileges are the common case, so do not flood the log
+    if (!m_warned.exchange(true))
+    {
+        LOG(WARN) << "ThreadPolicies - " << what << " could not be applied (error " << std::dec << error
+                  << "), continuing with default settings. Further failures are only counted in \"thread_policy_denied\".";
+    }
+}
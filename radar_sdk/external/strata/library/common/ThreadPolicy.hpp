@@ -0,0 +1,115 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#pragma once
+
+#include <Definitions.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+
+class LatencyHistogram;
+
+
+/**
+ * @brief Roles of the threads in the acquisition pipeline
+ */
+enum class ThreadRole : uint8_t
+{
+    BridgeReader = 0,  ///< threads receiving data from a board (USB, Ethernet, serial)
+    Forwarder,         ///< thread passing frames from the queue to the registered listener
+    Converter,         ///< threads unpacking raw frames (a forwarder thread whose listener converts takes this role)
+    DspWorker,         ///< threads processing converted frames
+    Count
+};
+
+
+/**
+ * @brief Scheduling settings for the threads of one role
+ */
+struct ThreadPolicy
+{
+    enum Scheduling : uint8_t
+    {
+        Default = 0,  ///< leave the scheduling class and priority unchanged
+        Fifo,         ///< SCHED_FIFO (Windows: time critical priority)
+        RoundRobin,   ///< SCHED_RR (Windows: highest priority)
+    };
+
+    Scheduling scheduling;  ///< scheduling class
+    int priority;           ///< real-time priority for Fifo and RoundRobin (1 = lowest)
+    uint64_t cpuMask;       ///< bit n allows CPU n, 0 means no restriction
+};
+
+
+/**
+ * @brief Process wide scheduling, affinity and memory locking policy for acquisition threads
+ *
+ * Each thread of the pipeline calls apply() with its role when it starts.
+ * This names the thread (e.g. "strata-reader"), restricts it to the CPUs
+ * of the policy and switches it to the requested scheduling class.
+ * Policies have to be set before the acquisition is started to take effect.
+ * A thread keeps the first role applied to it; later calls of apply() with
+ * another role are ignored.
+ *
+ * Real-time scheduling and memory locking need privileges (CAP_SYS_NICE /
+ * CAP_IPC_LOCK on Linux). If they are missing, a warning is logged once,
+ * the "thread_policy_denied" counter is incremented and the thread keeps
+ * running with its previous settings.
+ *
+ * Threads that block on a frame queue record their wake-up latency (time
+ * from notification until running again) in the latency histogram
+ * "thread_wakeup_<role>" of their role.
+ */
+class ThreadPolicies
+{
+public:
+    STRATA_API static ThreadPolicies &instance();
+
+    ThreadPolicies(const ThreadPolicies &) = delete;
+    ThreadPolicies &operator=(const ThreadPolicies &) = delete;
+
+    STRATA_API void set(ThreadRole role, const ThreadPolicy &policy);
+    STRATA_API ThreadPolicy get(ThreadRole role);
+
+    /// Applies the policy of the role to the calling thread, returns false if parts of it were denied
+    /// or the thread already has another role
+    STRATA_API bool apply(ThreadRole role);
+
+    /// Role applied to the calling thread, ThreadRole::Count if none
+    STRATA_API static ThreadRole currentRole();
+
+    /// Records a wake-up latency for the role of the calling thread
+    STRATA_API static void recordWakeup(uint64_t ns);
+
+    /// Locks all current and future pages of the process into memory (mlockall)
+    STRATA_API bool lockMemory(bool enable);
+
+    /// If enabled, frame buffers are touched on allocation so that no page faults occur during acquisition
+    STRATA_API void setPrefault(bool enable);
+    STRATA_API static bool isPrefault();
+
+    /// Thread name used for a role
+    STRATA_API static const char *getThreadName(ThreadRole role);
+
+    /// Name of the wake-up latency histogram of a role
+    STRATA_API static const char *getWakeupName(ThreadRole role);
+
+private:
+    ThreadPolicies();
+
+    void denied(const char *what, int error);
+
+    std::mutex m_lock;
+    ThreadPolicy m_policies[static_cast<unsigned>(ThreadRole::Count)];
+    LatencyHistogram *m_wakeups[static_cast<unsigned>(ThreadRole::Count)];
+    std::atomic<bool> m_warned;
+};
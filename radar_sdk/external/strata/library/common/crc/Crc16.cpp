@@ -9,6 +9,32 @@
 
 #include "Crc16.hpp"
 
+#if defined(__x86_64__) || defined(_M_X64)
+    #define CRC16_CLMUL
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+    #if defined(__GNUC__) || defined(__clang__)
+        #define CRC16_CLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+    #else
+        #define CRC16_CLMUL_TARGET
+    #endif
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    // PMULL is part of the crypto extension, which is optional, so it is enabled per function
+    #define CRC16_CLMUL
+    #include <arm_neon.h>
+    #ifdef __clang__
+        #define CRC16_CLMUL_TARGET __attribute__((target("aes")))
+    #else
+        #define CRC16_CLMUL_TARGET __attribute__((target("+crypto")))
+    #endif
+    #ifdef __linux__
+        #include <asm/hwcap.h>
+        #include <sys/auxv.h>
+    #endif
+#endif
+
 
 #ifdef CRC16_LUT
 static uint16_t crcTable[256] = {
@@ -45,32 +71,306 @@ static uint16_t crcTable[256] = {
     0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
     0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0  // clang-format
 };
+
+namespace
+{
+    // tables for slicing-by-8: table[k][x] is the CRC of byte x followed by k zero bytes
+    struct Crc16Slices
+    {
+        uint16_t table[8][256];
+
+        Crc16Slices()
+        {
+            for (unsigned int x = 0; x < 256; x++)
+            {
+                table[0][x] = crcTable[x];
+            }
+            for (unsigned int k = 1; k < 8; k++)
+            {
+                for (unsigned int x = 0; x < 256; x++)
+                {
+                    const uint16_t previous = table[k - 1][x];
+                    table[k][x]             = static_cast<uint16_t>(previous << 8) ^ crcTable[previous >> 8];
+                }
+            }
+        }
+    };
+
+    // crcTable is constant-initialized, so it is valid when this is constructed
+    const Crc16Slices crcSlices;
+}
 #endif
 
 
-uint16_t Crc16CcittFalse(const uint8_t buf[], unsigned int len, uint16_t crc)
+namespace
 {
-    while (len--)
+    constexpr uint16_t crcPolynomial = 0x1021;
+
+    // shift a CRC register by the given number of zero bits
+    uint16_t shiftZeroBits(uint16_t crc, unsigned int bits)
+    {
+        while (bits--)
+        {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ crcPolynomial) : static_cast<uint16_t>(crc << 1);
+        }
+        return crc;
+    }
+
+    // table for processing 12 bit words (e.g. raw ADC samples) in a single step
+    struct Crc16Table12
     {
-        const uint8_t x = (crc >> 8) ^ *buf++;
+        uint16_t table[1 << 12];
+
+        Crc16Table12()
+        {
+            for (unsigned int x = 0; x < (1 << 12); x++)
+            {
+                table[x] = shiftZeroBits(static_cast<uint16_t>(x << 4), 12);
+            }
+        }
+    };
+
+    uint16_t crc16Bytes(const uint8_t buf[], unsigned int len, uint16_t crc)
+    {
+#ifdef CRC16_LUT
+        // process 8 bytes per step, the current CRC only affects the first two of them
+        const auto &t = crcSlices.table;
+        while (len >= 8)
+        {
+            crc = t[7][(crc >> 8) ^ buf[0]] ^ t[6][(crc & 0xFF) ^ buf[1]] ^ t[5][buf[2]] ^ t[4][buf[3]] ^
+                  t[3][buf[4]] ^ t[2][buf[5]] ^ t[1][buf[6]] ^ t[0][buf[7]];
+            buf += 8;
+            len -= 8;
+        }
+#endif
+
+        while (len--)
+        {
 #ifndef CRC16_LUT
-        x ^= x >> 4;
-        crc = static_cast<uint16_t>((crc << 8) ^ (x << 12) ^ (x << 5) ^ x);
+            uint8_t x = (crc >> 8) ^ *buf++;
+            x ^= x >> 4;
+            crc = static_cast<uint16_t>((crc << 8) ^ (x << 12) ^ (x << 5) ^ x);
 #else
-        crc = static_cast<uint16_t>(crc << 8) ^ crcTable[x];
+            const uint8_t x = (crc >> 8) ^ *buf++;
+            crc             = static_cast<uint16_t>(crc << 8) ^ crcTable[x];
 #endif
+        }
+        return crc;
     }
-    return crc;
+
+#ifdef CRC16_CLMUL
+    /*
+     * Carry-less multiplication folding
+     *
+     * The input is interpreted as polynomial with the first bit as highest coefficient.
+     * A 128 bit block X = H * x^64 + L followed by n further bits is replaced by
+     * H * (x^(64+n) mod P) + L * (x^n mod P), which has the same remainder, but only 80 bits.
+     * Four blocks are folded in parallel, the final 128 bits are reduced with the table.
+     */
+    constexpr unsigned int clmulMinLength = 64;
+
+    struct ClmulConstants
+    {
+        uint64_t fold4[2];  // fold across 4 blocks
+        uint64_t fold3[2];
+        uint64_t fold2[2];
+        uint64_t fold1[2];  // fold to the next block
+
+        ClmulConstants() :
+            fold4 {shiftZeroBits(1, 512), shiftZeroBits(1, 512 + 64)},
+            fold3 {shiftZeroBits(1, 384), shiftZeroBits(1, 384 + 64)},
+            fold2 {shiftZeroBits(1, 256), shiftZeroBits(1, 256 + 64)},
+            fold1 {shiftZeroBits(1, 128), shiftZeroBits(1, 128 + 64)}
+        {}
+    };
+
+    const ClmulConstants clmulConstants;
+
+    #if defined(__x86_64__) || defined(_M_X64)
+    struct Clmul
+    {
+        using Vector = __m128i;
+
+        static CRC16_CLMUL_TARGET inline Vector load(const uint8_t buf[])
+        {
+            const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(buf)), reverse);
+        }
+
+        static CRC16_CLMUL_TARGET inline void store(uint8_t buf[], Vector x)
+        {
+            const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(buf), _mm_shuffle_epi8(x, reverse));
+        }
+
+        static CRC16_CLMUL_TARGET inline Vector constant(const uint64_t k[2])
+        {
+            return _mm_set_epi64x(static_cast<long long>(k[1]), static_cast<long long>(k[0]));
+        }
+
+        static CRC16_CLMUL_TARGET inline Vector seed(uint16_t crc)
+        {
+            return _mm_set_epi64x(static_cast<long long>(static_cast<uint64_t>(crc) << 48), 0);
+        }
+
+        static CRC16_CLMUL_TARGET inline Vector combine(Vector a, Vector b)
+        {
+            return _mm_xor_si128(a, b);
+        }
+
+        static CRC16_CLMUL_TARGET inline Vector fold(Vector x, Vector k)
+        {
+            return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00));
+        }
+
+        static bool available()
+        {
+        #if defined(__GNUC__) || defined(__clang__)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+        #else
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 1)) && (info[2] & (1 << 9));
+        #endif
+        }
+    };
+    #else
+    struct Clmul
+    {
+        using Vector = uint64x2_t;
+
+        static CRC16_CLMUL_TARGET inline Vector load(const uint8_t buf[])
+        {
+            const uint64x2_t x = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(buf)));
+            return vextq_u64(x, x, 1);
+        }
+
+        static CRC16_CLMUL_TARGET inline void store(uint8_t buf[], Vector x)
+        {
+            vst1q_u8(buf, vrev64q_u8(vreinterpretq_u8_u64(vextq_u64(x, x, 1))));
+        }
+
+        static CRC16_CLMUL_TARGET inline Vector constant(const uint64_t k[2])
+        {
+            return vcombine_u64(vcreate_u64(k[0]), vcreate_u64(k[1]));
+        }
+
+        static CRC16_CLMUL_TARGET inline Vector seed(uint16_t crc)
+        {
+            return vcombine_u64(vcreate_u64(0), vcreate_u64(static_cast<uint64_t>(crc) << 48));
+        }
+
+        static CRC16_CLMUL_TARGET inline Vector combine(Vector a, Vector b)
+        {
+            return veorq_u64(a, b);
+        }
+
+        static CRC16_CLMUL_TARGET inline Vector fold(Vector x, Vector k)
+        {
+            const poly64x2_t px = vreinterpretq_p64_u64(x);
+            const poly64x2_t pk = vreinterpretq_p64_u64(k);
+            const auto high     = vmull_p64(vgetq_lane_p64(px, 1), vgetq_lane_p64(pk, 1));
+            const auto low      = vmull_p64(vgetq_lane_p64(px, 0), vgetq_lane_p64(pk, 0));
+            return veorq_u64(vreinterpretq_u64_p128(high), vreinterpretq_u64_p128(low));
+        }
+
+        static bool available()
+        {
+        #if defined(__linux__)
+            return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+        #elif defined(__APPLE__)
+            return true;  // all Apple aarch64 CPUs implement the crypto extension
+        #else
+            return false;
+        #endif
+        }
+    };
+    #endif
+
+    // processes all whole 16 byte blocks (len >= clmulMinLength)
+    CRC16_CLMUL_TARGET uint16_t crc16Clmul(const uint8_t buf[], unsigned int len, uint16_t crc)
+    {
+        const auto k4 = Clmul::constant(clmulConstants.fold4);
+        const auto k1 = Clmul::constant(clmulConstants.fold1);
+
+        auto x0 = Clmul::combine(Clmul::load(buf), Clmul::seed(crc));
+        auto x1 = Clmul::load(buf + 16);
+        auto x2 = Clmul::load(buf + 32);
+        auto x3 = Clmul::load(buf + 48);
+        buf += 64;
+        len -= 64;
+
+        while (len >= 64)
+        {
+            x0 = Clmul::combine(Clmul::fold(x0, k4), Clmul::load(buf));
+            x1 = Clmul::combine(Clmul::fold(x1, k4), Clmul::load(buf + 16));
+            x2 = Clmul::combine(Clmul::fold(x2, k4), Clmul::load(buf + 32));
+            x3 = Clmul::combine(Clmul::fold(x3, k4), Clmul::load(buf + 48));
+            buf += 64;
+            len -= 64;
+        }
+
+        auto x = Clmul::combine(Clmul::fold(x0, Clmul::constant(clmulConstants.fold3)), Clmul::fold(x1, Clmul::constant(clmulConstants.fold2)));
+        x      = Clmul::combine(x, Clmul::combine(Clmul::fold(x2, k1), x3));
+
+        while (len >= 16)
+        {
+            x = Clmul::combine(Clmul::fold(x, k1), Clmul::load(buf));
+            buf += 16;
+            len -= 16;
+        }
+
+        // the CRC register of the remaining 128 bit polynomial is its CRC with zero seed
+        uint8_t remainder[16];
+        Clmul::store(remainder, x);
+        return crc16Bytes(remainder, sizeof(remainder), 0);
+    }
+
+    bool clmulAvailable()
+    {
+        static const bool available = Clmul::available();
+        return available;
+    }
+#endif
+}
+
+
+uint16_t Crc16CcittFalse(const uint8_t buf[], unsigned int len, uint16_t crc)
+{
+#ifdef CRC16_CLMUL
+    if ((len >= clmulMinLength) && clmulAvailable())
+    {
+        const unsigned int blocks = len & ~15u;
+        crc                       = crc16Clmul(buf, blocks, crc);
+        buf += blocks;
+        len -= blocks;
+    }
+#endif
+
+    return crc16Bytes(buf, len, crc);
 }
 
 uint16_t Crc16CcittFalse(const uint16_t buf[], unsigned int len, unsigned int bits, uint16_t crc)
 {
-    const uint16_t poly      = 0x1021;
+    if (bits == 12)
+    {
+        static const Crc16Table12 crcTable12;
+        while (len--)
+        {
+            crc = static_cast<uint16_t>(crc << 12) ^ crcTable12.table[((crc >> 4) ^ *buf++) & 0xFFF];
+        }
+        return crc;
+    }
+
+    const uint16_t poly      = crcPolynomial;
     const unsigned int order = 16;
     const unsigned int mask  = (1 << (bits - 1));
 
-    // check if we have a whole byte to process at the end (to use optimized calculation for it)
-    const unsigned int limit = (static_cast<unsigned int>(bits > 7) << 8) - 1;
+    // process the leading bits one by one, all remaining whole bytes with the optimized calculation
+    // (words with less than 8 bits are processed as whole byte)
+    const unsigned int byteBits = (bits > 7) ? (bits & ~7u) : 8;
+    const unsigned int limit    = (1u << byteBits) - 1;
 
     while (len--)
     {
@@ -87,15 +387,11 @@ uint16_t Crc16CcittFalse(const uint16_t buf[], unsigned int len, unsigned int bi
             }
         }
 
-        if (limit)
+        for (unsigned int i = byteBits; i;)
         {
-            const uint8_t x = (crc >> 8) ^ static_cast<uint8_t>(data);
-#ifndef CRC16_LUT
-            x ^= x >> 4;
-            crc = static_cast<uint16_t>((crc << 8) ^ (x << 12) ^ (x << 5) ^ x);
-#else
-            crc = static_cast<uint16_t>(crc << 8) ^ crcTable[x];
-#endif
+            i -= 8;
+            const uint8_t x = static_cast<uint8_t>(data >> i);
+            crc             = crc16Bytes(&x, 1, crc);
         }
     }
 
@@ -16,7 +16,10 @@
 #define CRC16_CCITT_FALSE_SEED 0xFFFF
 
 
+// Longer buffers are processed with carry-less multiplication (PCLMULQDQ / PMULL) if the CPU supports it,
+// otherwise with slicing-by-8 tables.
 uint16_t Crc16CcittFalse(const uint8_t buf[], unsigned int len, uint16_t crc = CRC16_CCITT_FALSE_SEED);
+// 12 bit words are processed with a dedicated table in a single step.
 uint16_t Crc16CcittFalse(const uint16_t buf[], unsigned int len, unsigned int bits, uint16_t crc = CRC16_CCITT_FALSE_SEED);
 
 
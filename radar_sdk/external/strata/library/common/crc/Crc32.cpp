@@ -9,6 +9,21 @@
 
 #include "Crc32.hpp"
 
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    // the CRC32 instructions are optional before ARMv8.1, so they are enabled per function
+    #define CRC32_ARM_CRC
+    #include <arm_acle.h>
+    #ifdef __clang__
+        #define CRC32_ARM_CRC_TARGET __attribute__((target("crc")))
+    #else
+        #define CRC32_ARM_CRC_TARGET __attribute__((target("+crc")))
+    #endif
+    #ifdef __linux__
+        #include <asm/hwcap.h>
+        #include <sys/auxv.h>
+    #endif
+#endif
+
 namespace
 {
 #ifdef CRC32_LUT
@@ -66,20 +81,194 @@ namespace
         }
         return result;
     }
+
+    constexpr uint32_t mpeg2Polynomial    = 0x04C11DB7;
+    constexpr uint32_t ethernetPolynomial = 0xEDB88320;  // reversed 0x04C11DB7
+
+    // shift a (not reflected) CRC register by the given number of zero bits
+    uint32_t shiftZeroBits(uint32_t crc, unsigned int bits, uint32_t poly)
+    {
+        while (bits--)
+        {
+            crc = (crc & 0x80000000) ? ((crc << 1) ^ poly) : (crc << 1);
+        }
+        return crc;
+    }
+
+    // table for processing 12 bit words (e.g. raw ADC samples) in a single step
+    struct Crc32Table12
+    {
+        uint32_t table[1 << 12];
+
+        Crc32Table12()
+        {
+            for (uint32_t x = 0; x < (1 << 12); x++)
+            {
+                table[x] = shiftZeroBits(x << 20, 12, mpeg2Polynomial);
+            }
+        }
+    };
+
+    // tables for slicing-by-4: table[k][x] is the CRC of byte x followed by k zero bytes
+    struct Crc32Slices
+    {
+        uint32_t table[4][256];
+
+        Crc32Slices()
+        {
+            for (uint32_t x = 0; x < 256; x++)
+            {
+                table[0][x] = shiftZeroBits(x << 24, 8, mpeg2Polynomial);
+            }
+            fillSlices();
+        }
+
+        explicit Crc32Slices(const uint32_t byteTable[256])
+        {
+            for (uint32_t x = 0; x < 256; x++)
+            {
+                table[0][x] = byteTable[x];
+            }
+            fillSlices();
+        }
+
+        uint32_t update(uint32_t crc, uint8_t data) const
+        {
+            return (crc << 8) ^ table[0][(crc >> 24) ^ data];
+        }
+
+        uint32_t update16(uint32_t crc, uint16_t data) const
+        {
+            crc ^= uint32_t(data) << 16;
+            return (crc << 16) ^ table[1][crc >> 24] ^ table[0][(crc >> 16) & 0xFF];
+        }
+
+        uint32_t update(uint32_t crc, const uint8_t buf[]) const
+        {
+            crc ^= (uint32_t(buf[0]) << 24) | (uint32_t(buf[1]) << 16) | (uint32_t(buf[2]) << 8) | buf[3];
+            return table[3][crc >> 24] ^ table[2][(crc >> 16) & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^ table[0][crc & 0xFF];
+        }
+
+    private:
+        void fillSlices()
+        {
+            for (unsigned int k = 1; k < 4; k++)
+            {
+                for (unsigned int x = 0; x < 256; x++)
+                {
+                    const uint32_t previous = table[k - 1][x];
+                    table[k][x]             = (previous << 8) ^ table[0][previous >> 24];
+                }
+            }
+        }
+    };
+
+    const Crc32Slices &mpeg2Slices()
+    {
+        static const Crc32Slices slices;
+        return slices;
+    }
+
+    // byte table for the reflected calculation
+    struct Crc32ReflectedTable
+    {
+        uint32_t table[256];
+
+        Crc32ReflectedTable()
+        {
+            for (uint32_t x = 0; x < 256; x++)
+            {
+                uint32_t crc = x;
+                for (unsigned int i = 0; i < 8; i++)
+                {
+                    crc = (crc & 1) ? ((crc >> 1) ^ ethernetPolynomial) : (crc >> 1);
+                }
+                table[x] = crc;
+            }
+        }
+    };
+
+    const Crc32ReflectedTable &reflectedTable()
+    {
+        static const Crc32ReflectedTable table;
+        return table;
+    }
+
+    // processes the whole bytes of each word (byteBits = 8 or 16)
+    uint32_t crc32EthernetBytes(const uint16_t buf[], uint16_t len, unsigned int byteBits, uint32_t crc)
+    {
+        const auto &table = reflectedTable().table;
+        while (len--)
+        {
+            const uint16_t data = *buf++;
+            for (unsigned int i = 0; i < byteBits; i += 8)
+            {
+                crc = (crc >> 8) ^ table[(crc ^ (data >> i)) & 0xFF];
+            }
+        }
+        return crc;
+    }
+
+#ifdef CRC32_ARM_CRC
+    CRC32_ARM_CRC_TARGET uint32_t crc32EthernetArm(const uint16_t buf[], uint16_t len, unsigned int byteBits, uint32_t crc)
+    {
+        if (byteBits == 16)
+        {
+            while (len--)
+            {
+                crc = __crc32h(crc, *buf++);
+            }
+        }
+        else
+        {
+            while (len--)
+            {
+                crc = __crc32b(crc, static_cast<uint8_t>(*buf++));
+            }
+        }
+        return crc;
+    }
+
+    bool armCrcAvailable()
+    {
+    #if defined(__linux__)
+        static const bool available = (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+        return available;
+    #elif defined(__APPLE__)
+        return true;  // all Apple aarch64 CPUs implement the CRC32 instructions
+    #else
+        return false;
+    #endif
+    }
+#endif
 }
 
 uint32_t Crc32Ethernet(const uint16_t buf[], uint16_t len, unsigned int bits, uint32_t crc)
 {
-    const uint32_t poly = 0xEDB88320;  // reversed 0x04C11DB7, since both input and output should be reflected
+    const uint32_t poly = ethernetPolynomial;  // since both input and output should be reflected
     //const unsigned int order = 32;
     const unsigned int mask = 1u << (bits - 1);
 
-    // check if we have a whole byte to process at the end (to use optimized calculation for it)
-    const unsigned int limit = 0;  // (static_cast<unsigned int>(bits > 7) << 8) - 1;
+    // the bits are processed starting with the LSB, so first process all whole bytes with the optimized calculation
+    const unsigned int byteBits = bits & ~7u;
+    const unsigned int limit    = (1u << byteBits) - 1;
+
+    if (bits == byteBits)
+    {
+#ifdef CRC32_ARM_CRC
+        if (armCrcAvailable())
+        {
+            return ~crc32EthernetArm(buf, len, byteBits, crc);
+        }
+#endif
+        return ~crc32EthernetBytes(buf, len, byteBits, crc);
+    }
 
     while (len--)
     {
-        uint16_t data = *buf++;
+        const uint16_t data = *buf++;
+
+        crc = crc32EthernetBytes(&data, 1, byteBits, crc);
 
         for (unsigned int b = limit + 1; b <= mask; b <<= 1)
         {
@@ -99,7 +288,17 @@ uint32_t Crc32Ethernet(const uint16_t buf[], uint16_t len, unsigned int bits, ui
 
 uint32_t Crc32Mpeg2(const uint16_t buf[], uint16_t len, unsigned int bits, uint32_t crc)
 {
-    const uint32_t poly      = 0x04C11DB7;
+    if (bits == 12)
+    {
+        static const Crc32Table12 crcTable12;
+        while (len--)
+        {
+            crc = (crc << 12) ^ crcTable12.table[((crc >> 20) ^ *buf++) & 0xFFF];
+        }
+        return crc;
+    }
+
+    const uint32_t poly      = mpeg2Polynomial;
     const unsigned int order = 32;
     const unsigned int mask  = 1u << (bits - 1);
 
@@ -110,6 +309,8 @@ uint32_t Crc32Mpeg2(const uint16_t buf[], uint16_t len, unsigned int bits, uint3
     const unsigned int dataLutBits = bits / lutBitSize * lutBitSize;
     const unsigned int limit       = (1u << dataLutBits) - 1;
     const unsigned int lutBitMask  = (1u << lutBitSize) - 1;
+
+    const auto &slices = mpeg2Slices();
 #else
     const unsigned int limit = 0;
 #endif
@@ -131,7 +332,17 @@ uint32_t Crc32Mpeg2(const uint16_t buf[], uint16_t len, unsigned int bits, uint3
 
 #ifdef CRC32_LUT
         unsigned int i = dataLutBits;
-        while (i)
+        if (i == 16)
+        {
+            i   = 0;
+            crc = slices.update16(crc, data);
+        }
+        while (i >= 8)
+        {
+            i -= 8;
+            crc = slices.update(crc, static_cast<uint8_t>(data >> i));
+        }
+        if (i)
         {
             i -= lutBitSize;
 
@@ -146,32 +357,57 @@ uint32_t Crc32Mpeg2(const uint16_t buf[], uint16_t len, unsigned int bits, uint3
 
 uint32_t Crc32Autosar(const uint8_t buf[], uint16_t len, uint32_t crc)
 {
+    static const Crc32Slices autosarSlices(crcAutosarTable);
+    while (len >= 4)
+    {
+        crc = autosarSlices.update(crc, buf);
+        buf += 4;
+        len -= 4;
+    }
     while (len--)
     {
-        uint8_t data = *buf++;
-        crc          = ((crc << 8) ^ crcAutosarTable[(crc >> 24) ^ data]);
+        crc = autosarSlices.update(crc, *buf++);
     }
     return crc;
 }
 
 uint32_t Crc32(const uint8_t buf[], uint16_t len, uint32_t polynomial, bool reflectIn, bool reflectOut, bool invertOut, uint32_t crc)
 {
-    while (len--)
+    if (polynomial == mpeg2Polynomial)
     {
-        uint8_t val = *buf++;
-        if (reflectIn)
+        // most common polynomial (MPEG-2, BZIP2), so use the optimized calculation
+        const auto &slices = mpeg2Slices();
+        while (!reflectIn && (len >= 4))
         {
-            val = reflect(val);
+            crc = slices.update(crc, buf);
+            buf += 4;
+            len -= 4;
         }
-
-        for (unsigned int b = 0x80; b >= 0x01; b >>= 1)
+        while (len--)
         {
-            const bool xor_flag = static_cast<bool>(crc & 0x80000000);
-            crc <<= 1;
+            const uint8_t val = *buf++;
+            crc               = slices.update(crc, reflectIn ? reflect(val) : val);
+        }
+    }
+    else
+    {
+        while (len--)
+        {
+            uint8_t val = *buf++;
+            if (reflectIn)
+            {
+                val = reflect(val);
+            }
 
-            if (static_cast<bool>(val & b) != xor_flag)  // bool != is the same as bool xor
+            for (unsigned int b = 0x80; b >= 0x01; b >>= 1)
             {
-                crc ^= polynomial;
+                const bool xor_flag = static_cast<bool>(crc & 0x80000000);
+                crc <<= 1;
+
+                if (static_cast<bool>(val & b) != xor_flag)  // bool != is the same as bool xor
+                {
+                    crc ^= polynomial;
+                }
             }
         }
     }
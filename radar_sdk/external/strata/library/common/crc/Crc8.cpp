@@ -20,6 +20,30 @@ namespace
         0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B, 0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13,
         0xAE, 0xA9, 0xA0, 0xA7, 0xB2, 0xB5, 0xBC, 0xBB, 0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
         0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB, 0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3};
+
+    // tables for slicing-by-4: table[k][x] is the CRC of byte x followed by k zero bytes
+    struct Crc8SmbusSlices
+    {
+        uint8_t table[4][256];
+
+        Crc8SmbusSlices()
+        {
+            for (unsigned int x = 0; x < 256; x++)
+            {
+                table[0][x] = crcSmbusTable[x];
+            }
+            for (unsigned int k = 1; k < 4; k++)
+            {
+                for (unsigned int x = 0; x < 256; x++)
+                {
+                    table[k][x] = crcSmbusTable[table[k - 1][x]];
+                }
+            }
+        }
+    };
+
+    // crcSmbusTable is constant-initialized, so it is valid when this is constructed
+    const Crc8SmbusSlices crcSmbusSlices;
 }
 
 uint8_t Crc8(const uint8_t buf[], uint16_t len, uint16_t polynomial, uint8_t crcInitial)
@@ -49,6 +73,15 @@ uint8_t Crc8(const uint8_t buf[], uint16_t len, uint16_t polynomial, uint8_t crc
 uint8_t Crc8Smbus(const uint8_t buf[], uint16_t len)
 {
     uint8_t crc = 0;
+
+    const auto &t = crcSmbusSlices.table;
+    while (len >= 4)
+    {
+        crc = t[3][crc ^ buf[0]] ^ t[2][buf[1]] ^ t[1][buf[2]] ^ t[0][buf[3]];
+        buf += 4;
+        len -= 4;
+    }
+
     while (len--)
     {
         uint8_t currByte = *buf++;
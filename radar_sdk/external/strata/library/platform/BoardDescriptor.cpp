@@ -39,12 +39,35 @@ std::shared_ptr<IBridge> BoardDescriptor::createBridge()
     throw EConnection("BoardDescriptor does not contain any bridge");
 }
 
+bool BoardDescriptor::closeIdleBridge()
+{
+    if (!m_bridge)
+    {
+        return true;
+    }
+    if (m_bridge.use_count() > 1)
+    {
+        return false;
+    }
+    if (!m_closed && m_bridge->isConnected())
+    {
+        m_bridge->closeConnection();
+        m_closed = true;
+    }
+    return true;
+}
+
 void BoardDescriptor::checkBridge()
 {
     if (!m_bridge)
     {
         m_bridge = createBridge();
     }
+    else if (m_closed)
+    {
+        m_bridge->openConnection();
+        m_closed = false;
+    }
     if (!m_checked)
     {
         auto bridge = m_bridge.get();
@@ -86,6 +86,13 @@ public:
     STRATA_API std::unique_ptr<BoardInstance> createBoardInstance();
     STRATA_API IBridge *getIBridge();
 
+    /**
+     * @brief Closes the connection if no board instance uses it any more
+     * The connection is opened again by the next createBoardInstance() or getIBridge() call.
+     * @return false if a board instance still uses the connection
+     */
+    STRATA_API bool closeIdleBridge();
+
 protected:
     virtual std::shared_ptr<IBridge> createBridge();
 
@@ -98,4 +105,5 @@ private:
     void checkBridge();
 
     bool m_checked = false;
+    bool m_closed  = false;
 };
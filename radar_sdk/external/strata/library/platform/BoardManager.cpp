@@ -10,6 +10,7 @@
 #include "BoardManager.hpp"
 
 #include <common/Logger.hpp>
+#include <common/Metrics.hpp>
 #include <common/exception/ENotImplemented.hpp>
 #include <platform/BoardListProtocol.hpp>
 #include <platform/exception/EAlreadyOpened.hpp>
@@ -27,22 +28,109 @@
     #include <platform/wiggler/EnumeratorWiggler.hpp>
 #endif
 
+#include <common/ParallelFor.hpp>
 #include <common/cpp11/memory.hpp>
 #include <cstring>
+#include <exception>
+
+
+namespace
+{
+    ///
+    /// Result of the last complete enumeration, shared by all BoardManager instances.
+    /// A manager that reuses the result takes the list out of the cache and returns it on destruction,
+    /// so a descriptor is never used by two managers at the same time.
+    ///
+    struct EnumerationCache
+    {
+        std::mutex lock;
+        bool valid = false;
+        uint32_t types;
+        BoardData::const_iterator begin;
+        BoardData::const_iterator end;
+        std::vector<uint64_t> signatures;
+        std::chrono::steady_clock::time_point time;
+        BoardDescriptorList list;
+    };
+
+    EnumerationCache &getCache()
+    {
+        // intentionally never destroyed, so that managers destroyed during static destruction can still return their list
+        static auto cache = new EnumerationCache;
+        return *cache;
+    }
+}
+
+
+BoardManager::Collector::Collector(BoardManager &manager, std::size_t index) :
+    m_manager {manager},
+    m_index {index}
+{
+}
+
+bool BoardManager::Collector::onEnumerate(std::unique_ptr<BoardDescriptor> &&descriptor)
+{
+    bool select;
+    if (m_manager.m_selector)
+    {
+        std::lock_guard<std::mutex> lock(m_manager.m_selectorLock);
+        select = m_manager.m_selector->select(descriptor.get());
+    }
+    else
+    {
+        select = true;
+    }
+
+    if (select)
+    {
+        m_list.push_back(std::move(descriptor));
+        ++m_manager.m_found[m_index];
+    }
+
+    return foundEnough();
+}
+
+bool BoardManager::Collector::isStopped()
+{
+    return foundEnough() || (std::chrono::steady_clock::now() > m_manager.m_deadline);
+}
+
+bool BoardManager::Collector::foundEnough() const
+{
+    if (!m_manager.m_maxCount)
+    {
+        return false;
+    }
+
+    // the counts of the enumerators before this one only grow, so once they reach
+    // maxCount together with this one, later boards of this one would be truncated anyway
+    uint32_t found = 0;
+    for (std::size_t i = 0; i <= m_index; i++)
+    {
+        found += m_manager.m_found[i];
+    }
+    return found >= m_manager.m_maxCount;
+}
+
 
 BoardManager::BoardManager() :
-    m_selector {nullptr}
+    m_selector {nullptr},
+    m_maxCount {0},
+    m_timeout {0},
+    m_cacheLifetime {0},
+    m_fromCache {false},
+    m_cacheable {false}
 {
 }
 
 BoardManager::BoardManager(const char *interfaces) :
-    m_selector {nullptr}
+    BoardManager()
 {
     parseConnectionTypes(interfaces, ',');
 }
 
 BoardManager::BoardManager(bool serial, bool ethernetUdp, bool uvc, bool wiggler, bool libusb) :
-    m_selector {nullptr}
+    BoardManager()
 {
     LOG(WARN) << "This BoardManager constructor implementation is deprecated. Please don't use it anymore.";
     if (serial)
@@ -59,6 +147,7 @@ BoardManager::BoardManager(bool serial, bool ethernetUdp, bool uvc, bool wiggler
 
 BoardManager::~BoardManager()
 {
+    storeCache();
 }
 
 BoardManager &BoardManager::useSerial()
@@ -226,9 +315,119 @@ uint16_t BoardManager::enumerate(uint16_t maxCount)
     return enumerate(BoardListProtocol::begin, BoardListProtocol::end, maxCount);
 }
 
+void BoardManager::setEnumerationTimeout(uint16_t timeoutMs)
+{
+    m_timeout = timeoutMs;
+}
+
+void BoardManager::setCacheLifetime(uint32_t lifetimeMs)
+{
+    m_cacheLifetime = lifetimeMs;
+}
+
+bool BoardManager::isFromCache() const
+{
+    return m_fromCache;
+}
+
+void BoardManager::invalidateCache()
+{
+    auto &cache = getCache();
+    BoardDescriptorList stale;
+    {
+        std::lock_guard<std::mutex> lock(cache.lock);
+        cache.valid = false;
+        stale.swap(cache.list);
+    }
+}
+
+uint32_t BoardManager::getTypeMask() const
+{
+    uint32_t mask = 0;
+    for (auto &e : m_enumerators)
+    {
+        mask |= 1u << static_cast<unsigned>(e.first);
+    }
+    return mask;
+}
+
+bool BoardManager::loadCache(BoardData::const_iterator begin, BoardData::const_iterator end)
+{
+    auto &cache = getCache();
+    BoardDescriptorList stale;  // destroyed outside of the lock
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    if (!cache.valid || (cache.types != getTypeMask()) || (cache.begin != begin) || (cache.end != end))
+    {
+        return false;
+    }
+
+    const auto age = std::chrono::steady_clock::now() - cache.time;
+    if ((cache.signatures != m_signatures) || (age > std::chrono::milliseconds(m_cacheLifetime)))
+    {
+        cache.valid = false;
+        stale.swap(cache.list);
+        return false;
+    }
+
+    cache.valid = false;
+    m_enumeratedList.clear();
+    m_enumeratedList.swap(cache.list);
+    m_enumerationTime = cache.time;
+    return true;
+}
+
+void BoardManager::storeCache()
+{
+    if (!m_cacheable)
+    {
+        return;
+    }
+    m_cacheable = false;
+
+    for (auto &d : m_enumeratedList)
+    {
+        if (!d->closeIdleBridge())
+        {
+            // a board of the list is still open, so the list cannot be shared
+            return;
+        }
+    }
+
+    auto &cache = getCache();
+    BoardDescriptorList replaced;  // destroyed outside of the lock
+    std::lock_guard<std::mutex> lock(cache.lock);
+
+    if (cache.valid && (cache.time > m_enumerationTime))
+    {
+        // a newer result has been stored in the meantime
+        return;
+    }
+
+    replaced.swap(cache.list);
+    cache.list.swap(m_enumeratedList);
+    cache.valid      = true;
+    cache.types      = getTypeMask();
+    cache.begin      = m_begin;
+    cache.end        = m_end;
+    cache.signatures = m_signatures;
+    cache.time       = m_enumerationTime;
+}
+
 uint16_t BoardManager::enumerate(BoardData::const_iterator begin, BoardData::const_iterator end, uint16_t maxCount)
 {
-    m_maxCount = maxCount;
+    static auto &enumerateLatency = Metrics::instance().latency("board_enumerate");
+    static auto &cacheHits        = Metrics::instance().counter("board_enumerate_cache_hits");
+    MetricsScope measure(enumerateLatency);
+
+    // a previous result is dropped, not returned to the cache, so that a caller can
+    // enumerate again after invalidateCache() when a cached board could not be opened
+    m_cacheable = false;
+
+    m_maxCount  = maxCount;
+    m_fromCache = false;
+    m_begin     = begin;
+    m_end       = end;
     m_enumeratedList.clear();
 
     if (m_enumerators.empty())
@@ -236,15 +435,83 @@ uint16_t BoardManager::enumerate(BoardData::const_iterator begin, BoardData::con
         LOG(WARN) << "No enumerators (connection types) selected. No boards will be found.";
     }
 
+    // only complete results can be reused
+    const bool complete = (m_cacheLifetime != 0) && !m_selector && !maxCount;
+
+    if (complete)
+    {
+        m_signatures.clear();
+        for (auto &e : m_enumerators)
+        {
+            m_signatures.push_back(e.second->getDeviceSignature());
+        }
+
+        if (loadCache(begin, end))
+        {
+            LOG(DEBUG) << "Reusing cached enumeration result";
+            cacheHits.add();
+            m_fromCache = true;
+            m_cacheable = true;
+            return static_cast<uint16_t>(m_enumeratedList.size());
+        }
+    }
+
+    m_enumerationTime = std::chrono::steady_clock::now();
+    if (m_timeout)
+    {
+        m_deadline = m_enumerationTime + std::chrono::milliseconds(m_timeout);
+    }
+    else
+    {
+        m_deadline = std::chrono::steady_clock::time_point::max();
+    }
+
+    // run all enumerators in parallel (one thread per connection type), each one with its own collector
+    const auto count = m_enumerators.size();
+    std::vector<std::unique_ptr<Collector>> collectors;
+    std::vector<IEnumerator *> enumerators;
+    std::vector<std::exception_ptr> errors(count);
+    m_found = std::vector<std::atomic<uint16_t>>(count);
     for (auto &e : m_enumerators)
     {
-        e.second->enumerate(*this, begin, end);
-        if (m_maxCount && (m_enumeratedList.size() >= m_maxCount))
+        collectors.push_back(std::make_unique<Collector>(*this, collectors.size()));
+        enumerators.push_back(e.second.get());
+    }
+
+    strata::parallelFor(count, count, [&enumerators, &collectors, &errors, begin, end](std::size_t index) {
+        try
         {
-            break;
+            enumerators[index]->enumerate(*collectors[index], begin, end);
+        }
+        catch (...)
+        {
+            errors[index] = std::current_exception();
+        }
+    });
+
+    for (auto &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // concatenate in the order of the connection types, independent of which enumerator finished first
+    for (auto &c : collectors)
+    {
+        for (auto &d : c->m_list)
+        {
+            if (m_maxCount && (m_enumeratedList.size() >= m_maxCount))
+            {
+                break;
+            }
+            m_enumeratedList.push_back(std::move(d));
         }
     }
 
+    m_cacheable = complete && (std::chrono::steady_clock::now() <= m_deadline);
+
     return static_cast<uint16_t>(m_enumeratedList.size());
 }
 
@@ -376,23 +643,3 @@ STRATA_API std::unique_ptr<BoardInstance> BoardManager::createSpecificBoardInsta
 
     throw EConnection("Specified board not found");
 }
-
-bool BoardManager::onEnumerate(std::unique_ptr<BoardDescriptor> &&descriptor)
-{
-    bool select;
-    if (m_selector)
-    {
-        select = m_selector->select(descriptor.get());
-    }
-    else
-    {
-        select = true;
-    }
-
-    if (select)
-    {
-        m_enumeratedList.push_back(std::move(descriptor));
-    }
-
-    return (m_maxCount && (m_enumeratedList.size() >= m_maxCount));
-}
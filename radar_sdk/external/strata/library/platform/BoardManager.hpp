@@ -13,9 +13,13 @@
 #include <platform/BoardInstance.hpp>
 #include <platform/interfaces/IEnumerator.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #define UUID_LENGTH 16
 
@@ -29,6 +33,7 @@ public:
     /// This can be implemented by a caller to filter found boards by additional criteria.
     /// If specified, it will be called within onEnumerate and
     /// only add the descriptor to the list when true is returned.
+    /// The calls come from the enumeration threads, but never overlap.
     ///
     virtual bool select(BoardDescriptor *descriptor) = 0;
 };
@@ -55,9 +60,16 @@ private:
 
 /**
  * @brief Class to enumerate and create board instances
+ *
+ * The enumerators of all selected connection types run in parallel, each on its own thread.
+ * The result list is ordered by connection type, independent of which enumerator finishes first.
+ *
+ * Complete enumeration results (no selector, no maximum count, finished in time) can be
+ * kept in a process wide cache for a configurable lifetime, see setCacheLifetime().
+ * A cached result is only reused while the device signatures of all enumerators are unchanged,
+ * so attaching or removing a board always leads to a new enumeration.
  */
-class BoardManager :
-    private IEnumerationListener
+class BoardManager
 {
 public:
     /**
@@ -90,7 +102,7 @@ public:
      */
     STRATA_API BoardManager(bool serial, bool ethernetUdp = true, bool uvc = false, bool wiggler = false, bool libusb = true);
 
-    STRATA_API virtual ~BoardManager() override;
+    STRATA_API virtual ~BoardManager();
 
     /**
      * @brief Add the serial connection type to be used during board enumeration
@@ -130,6 +142,32 @@ public:
 
     STRATA_API void setEnumerationSelector(IEnumerationSelector *selector);
 
+    /**
+     * @brief Limit the time spent in enumerate()
+     * When the timeout has elapsed, no further ports or devices are probed.
+     * A probe that is already running is completed, so the actual duration can exceed the timeout slightly.
+     * @param timeoutMs The timeout in milliseconds, 0 (default) for no limit
+     */
+    STRATA_API void setEnumerationTimeout(uint16_t timeoutMs);
+
+    /**
+     * @brief Allow enumerate() to reuse the result of a previous complete enumeration
+     * The cached boards stay valid as long as the device signatures of the enumerators do not change.
+     * Connections of cached boards that are not in use are closed while they are in the cache.
+     * @param lifetimeMs The maximum age of a reused result in milliseconds, 0 (default) disables the cache
+     */
+    STRATA_API void setCacheLifetime(uint32_t lifetimeMs);
+
+    /**
+     * @brief Discard the cached enumeration result, e.g. after a cached board could not be opened
+     */
+    STRATA_API static void invalidateCache();
+
+    /**
+     * @brief Check whether the last enumerate() call returned a cached result
+     */
+    STRATA_API bool isFromCache() const;
+
     /**
      * @brief Enumerate (collect) all boards on the activated interfaces (see constructor)
      * @note The function used an internal list to identify the board type.
@@ -219,11 +257,48 @@ protected:
 
 private:
     ///
-    /// This will be called by enumerators with descriptors of found board.
+    /// Collects the descriptors reported by one enumerator.
+    /// The result lists the boards in the order of the enumerators, so an enumerator only stops
+    /// once it and the enumerators before it found maxCount boards. Its further boards could not
+    /// be part of the result then, independent of the timing of the other enumerators.
     ///
-    bool onEnumerate(std::unique_ptr<BoardDescriptor> &&descriptor) override;
+    class Collector :
+        public IEnumerationListener
+    {
+    public:
+        Collector(BoardManager &manager, std::size_t index);
+
+        bool onEnumerate(std::unique_ptr<BoardDescriptor> &&descriptor) override;
+        bool isStopped() override;
+
+        BoardDescriptorList m_list;
+
+    private:
+        bool foundEnough() const;
+
+        BoardManager &m_manager;
+        const std::size_t m_index;
+    };
+
+    bool loadCache(BoardData::const_iterator begin, BoardData::const_iterator end);
+    void storeCache();
+    uint32_t getTypeMask() const;
+
     IEnumerationSelector *m_selector;
     uint16_t m_maxCount;
+    uint16_t m_timeout;
+    uint32_t m_cacheLifetime;
+    bool m_fromCache;
+    bool m_cacheable;
+
+    std::mutex m_selectorLock;
+    std::vector<std::atomic<uint16_t>> m_found;  // boards found per enumerator, in the order of m_enumerators
+    std::chrono::steady_clock::time_point m_deadline;
+
+    BoardData::const_iterator m_begin;
+    BoardData::const_iterator m_end;
+    std::vector<uint64_t> m_signatures;
+    std::chrono::steady_clock::time_point m_enumerationTime;
 
     static ConnectionType getConnectionTypeByName(std::string name);
     void addConnectionType(ConnectionType type);
@@ -10,8 +10,11 @@
 #include "BridgeEthernetData.hpp"
 
 #include <array>
+#include <common/AsyncLogger.hpp>
 #include <common/Logger.hpp>
+#include <common/Metrics.hpp>
 #include <common/Serialization.hpp>
+#include <common/ThreadPolicy.hpp>
 #include <common/Time.hpp>
 #include <platform/exception/EBridgeData.hpp>
 #include <platform/exception/EProtocol.hpp>
@@ -41,7 +44,8 @@ namespace
 
 BridgeEthernetData::BridgeEthernetData(ISocket &socket, ipAddress_t ipAddr) :
     m_socket(socket),
-    m_ipAddr {ipAddr[0], ipAddr[1], ipAddr[2], ipAddr[3]}
+    m_ipAddr {ipAddr[0], ipAddr[1], ipAddr[2], ipAddr[3]},
+    m_frameStart {0}
 {
     openConnection();
 }
@@ -132,6 +136,8 @@ void BridgeEthernetData::cleanupStreaming()
 
 void BridgeEthernetData::dataThreadFunctionDatagrams()
 {
+    ThreadPolicies::instance().apply(ThreadRole::BridgeReader);
+
     IFrame *frame = nullptr;
     uint8_t *bufBegin, *bufEnd;
     uint8_t *buf;
@@ -139,6 +145,11 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
     bool firstFrame         = true;
     uint64_t epochTimestamp = 0;
     uint8_t virtualChannel  = 0;
+    uint64_t frameStart     = 0;
+
+    static auto &receiveLatency  = Metrics::instance().latency("bridge_receive");
+    static auto &assemblyLatency = Metrics::instance().latency("frame_assembly");
+    static auto &packetsLost     = Metrics::instance().counter("bridge_packets_lost");
 
     // in our frame buffer, we overwrite the last bytes of the previous packet with the header of the new one.
     // so we have to restore them after reading a new packet, but we don't have to copy the whole payload every time.
@@ -157,7 +168,7 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
                 // try to discard one packet and try again
                 if (m_socket.dumpPacket())
                 {
-                    LOG(DEBUG) << "Data read thread - dumped packet";
+                    LOGF(DEBUG, "Data read thread - dumped packet");
                     m_packetCounter++;
                 }
                 continue;
@@ -176,23 +187,25 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
             {
                 const auto remainingSize    = bufEnd - buf;
                 const uint16_t readSize     = (remainingSize > m_socket.maxPayload()) ? m_socket.maxPayload() : static_cast<uint16_t>(remainingSize);
+                MetricsScope measure(receiveLatency);  // includes waiting for the packet
                 const uint16_t returnedSize = m_socket.receive(buf, readSize);
                 if (returnedSize == 0)
                 {
                     // no packet available, continue while loop
+                    measure.dismiss();
                     continue;
                 }
 
                 if (returnedSize < frameHeaderSize)
                 {
-                    LOG(DEBUG) << "Data read thread - Packet header incomplete";
+                    LOGF(DEBUG, "Data read thread - Packet header incomplete");
                     continue;
                 }
 
                 const auto bmPktType = serialToHost<uint8_t>(buf);
                 if ((bmPktType & 0xF0) != DATA_FRAME_PACKET)
                 {
-                    LOG(DEBUG) << "Data read thread - Packet type error: 0x" << std::hex << static_cast<int>(bmPktType);
+                    LOGF(DEBUG, "Data read thread - Packet type error: 0x%x", bmPktType);
                     continue;
                 }
 
@@ -204,6 +217,7 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
                         epochTimestamp = getEpochTime();
                     }
                     virtualChannel = bChannel;
+                    frameStart     = Metrics::isEnabled() ? Metrics::now() : 0;
                 }
 
                 const auto wLength = serialToHost<uint16_t>(buf + 4);
@@ -212,11 +226,11 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
                     if (remainingSize < frameHeaderSize + wLength)
                     {
                         queueFrame(ErrorFrame::create(DataError_FrameSizeExceeded, bChannel));
-                        LOG(DEBUG) << "Data read thread - Frame buffer insufficient - " << wLength + frameHeaderSize - remainingSize << " bytes discarded";
+                        LOGF(DEBUG, "Data read thread - Frame buffer insufficient - %u bytes discarded", wLength + frameHeaderSize - remainingSize);
                     }
                     else
                     {
-                        LOG(DEBUG) << "Data read thread - Packet length wrong: " << returnedSize << "; expected: " << (frameHeaderSize + wLength);
+                        LOGF(DEBUG, "Data read thread - Packet length wrong: %d; expected: %u", returnedSize, frameHeaderSize + wLength);
                     }
                     continue;
                 }
@@ -227,7 +241,7 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
                     if (wCounter != m_packetCounter)
                     {
-                        LOG(DEBUG) << "Data read thread - First frame packet counter reset: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
+                        LOGF(DEBUG, "Data read thread - First frame packet counter reset: received = 0x%x , current = 0x%x", wCounter, m_packetCounter);
                     }
 #endif
                     firstFrame      = false;
@@ -235,9 +249,10 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
                 }
                 else if (wCounter != m_packetCounter)
                 {
-                    LOG(INFO) << "Data read thread - Packet loss";
+                    LOGF(INFO, "Data read thread - Packet loss");
+                    packetsLost.add();
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                    LOG(DEBUG) << "     counter mismatch: received = 0x" << std::hex << wCounter << " , expected = 0x" << m_packetCounter;
+                    LOGF(DEBUG, "     counter mismatch: received = 0x%x , expected = 0x%x", wCounter, m_packetCounter);
 #endif
                     m_packetCounter = wCounter + 1;
 
@@ -249,7 +264,7 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
                         buf = bufBegin;
 
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - discarding current frame";
+                        LOGF(DEBUG, "Data read thread - discarding current frame");
 #endif
                         continue;
                     }
@@ -268,7 +283,7 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
                         std::copy(buf + frameHeaderSize, buf + frameHeaderSize + wLength, bufBegin);
                         buf = bufBegin;  // continue normally for a single/first packet
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - previous frame incomplete: wCounter = 0x" << std::hex << wCounter;
+                        LOGF(DEBUG, "Data read thread - previous frame incomplete: wCounter = 0x%x", wCounter);
 #endif
                     }
                 }
@@ -278,7 +293,7 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
                     {
                         // we expected a new frame, but we received a follow-up packet
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - discarding unexpected follow-up packet";
+                        LOGF(DEBUG, "Data read thread - discarding unexpected follow-up packet");
 #endif
                         continue;  // don't do anything with the received packet and start over
                     }
@@ -286,7 +301,7 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
                     if (virtualChannel != bChannel)
                     {
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - Channel mismatch: received = 0x" << std::hex << static_cast<int>(bChannel) << " , expected = 0x" << static_cast<int>(virtualChannel);
+                        LOGF(DEBUG, "Data read thread - Channel mismatch: received = 0x%x , expected = 0x%x", bChannel, virtualChannel);
 #endif
                         continue;  // don't do anything with the received packet and start over
                     }
@@ -336,6 +351,10 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
                         frame->setVirtualChannel(virtualChannel);
                         frame->setTimestamp(epochTimestamp);
 
+                        if (frameStart)
+                        {
+                            assemblyLatency.record(Metrics::now() - frameStart);
+                        }
                         queueFrame(frame);
                         frame = nullptr;
                     }
@@ -351,7 +370,7 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
             catch (const std::exception &e)
             {
                 queueFrame(ErrorFrame::create(DataError_LowLevelError, VIRTUAL_CHANNEL_UNDEFINED));
-                LOG(DEBUG) << "Data read thread - " << e.what();
+                LOGF(DEBUG, "Data read thread - %s", e.what());
             }
         }
     }
@@ -365,18 +384,26 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
 
 void BridgeEthernetData::dataThreadFunctionStreaming()
 {
+    ThreadPolicies::instance().apply(ThreadRole::BridgeReader);
+
     uint8_t header[frameHeaderSize];
     IFrame *frame   = nullptr;
     State state     = WaitForFrameStart;
     bool firstFrame = true;
 
+    static auto &receiveLatency = Metrics::instance().latency("bridge_receive");
+
     try
     {
         while (isBridgeDataStarted())
         {
             // 1. retrieve the frame header
+            MetricsScope measure(receiveLatency);  // includes waiting for the packet
             if (!receive(header, frameHeaderSize))
+            {
+                measure.dismiss();
                 break;
+            }
 
             // 2. parse the header and change the state in the state machine
             const auto bmPktType = serialToHost<uint8_t>(&header[0]);
@@ -468,15 +495,18 @@ void BridgeEthernetData::dataThreadFunctionStreaming()
 
 bool BridgeEthernetData::checkCounter(bool &firstFrame, uint16_t actualCounter, uint16_t expectedCounter, uint8_t channel)
 {
+    static auto &packetsLost = Metrics::instance().counter("bridge_packets_lost");
+
     if (firstFrame)
     {
         firstFrame = false;
     }
     else if (actualCounter != expectedCounter)
     {
-        LOG(INFO) << "Data read thread - Packet loss";
+        LOGF(INFO, "Data read thread - Packet loss");
+        packetsLost.add();
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-        LOG(DEBUG) << "    Packet loss, counter mismatch: received = 0x" << std::hex << actualCounter << " , current = 0x" << expectedCounter;
+        LOGF(DEBUG, "    Packet loss, counter mismatch: received = 0x%x , current = 0x%x", actualCounter, expectedCounter);
 #endif
         queueFrame(ErrorFrame::create(DataError_FrameDropped, channel));
 
@@ -525,6 +555,11 @@ BridgeEthernetData::State BridgeEthernetData::receivePayload(IFrame *&frame, uin
         }
         else
         {
+            static auto &assemblyLatency = Metrics::instance().latency("frame_assembly");
+            if (m_frameStart)
+            {
+                assemblyLatency.record(Metrics::now() - m_frameStart);
+            }
             queueFrame(frame);
             frame = nullptr;
         }
@@ -564,6 +599,7 @@ BridgeEthernetData::State BridgeEthernetData::handleFirstPacket(IFrame *&frame,
     frame->setVirtualChannel(bChannel);
     frame->setDataSize(0);
     frame->setTimestamp(setLocalTimestamp ? getEpochTime() : 0);
+    m_frameStart = Metrics::isEnabled() ? Metrics::now() : 0;
 
     return receivePayload(frame, wLength, bmPktType);
 }
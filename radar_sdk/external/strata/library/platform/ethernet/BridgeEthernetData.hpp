@@ -42,6 +42,7 @@ private:
     uint8_t m_ipAddr[4];
     std::thread m_dataThread;
     uint16_t m_packetCounter;
+    uint64_t m_frameStart;  // monotonic time of the first packet of the current frame
 
     // Variables used by frame streaming
 
@@ -105,7 +105,7 @@ inline void EnumeratorEthernet::getResponses(IEnumerationListener &listener, Boa
 {
     const auto expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
 
-    while (std::chrono::steady_clock::now() < expiry)
+    while ((std::chrono::steady_clock::now() < expiry) && !listener.isStopped())
     {
         constexpr const uint16_t receiveSize = m_responseHeaderSize + maxLengthReceive;
         uint8_t packet[receiveSize];
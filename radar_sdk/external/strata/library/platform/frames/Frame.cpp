@@ -17,17 +17,36 @@ Frame::Frame(IFramePool *owner, uint32_t bufferSize) :
     m_owner {owner},
     m_offset {0},
     m_dataSize {0},
-    m_bufferSize {bufferSize}
+    m_bufferSize {bufferSize},
+    m_ownsBuffer {true}
+{
+}
+
+Frame::Frame(IFramePool *owner, uint8_t *buffer, uint32_t bufferSize) :
+    m_buffer {reinterpret_cast<AlignmentType *>(buffer)},
+    m_owner {owner},
+    m_offset {0},
+    m_dataSize {0},
+    m_bufferSize {bufferSize},
+    m_ownsBuffer {false}
 {
 }
 
 Frame::~Frame()
 {
-    delete[] m_buffer;
+    if (m_ownsBuffer)
+    {
+        delete[] m_buffer;
+    }
 }
 
 void Frame::resizeBuffer(uint32_t bufferSize)
 {
+    if (!m_ownsBuffer)
+    {
+        throw std::logic_error("Resizing an external buffer");
+    }
+
     delete[] m_buffer;
     m_offset     = 0;
     m_dataSize   = 0;
@@ -20,8 +20,12 @@ public:
     using AlignmentType = uint64_t;
 
     Frame(IFramePool *owner, uint32_t bufferSize);
+
+    /* Use external memory (e.g. a slab of a frame pool) as buffer, which is not freed by the frame */
+    Frame(IFramePool *owner, uint8_t *buffer, uint32_t bufferSize);
     virtual ~Frame() override;
 
+    /* Only supported for frames owning their buffer */
     void resizeBuffer(uint32_t bufferSize);
 
     /* Release the frame from the pool */
@@ -48,4 +52,5 @@ private:
     uint32_t m_offset;
     uint32_t m_dataSize;
     uint32_t m_bufferSize;
+    bool m_ownsBuffer;
 };
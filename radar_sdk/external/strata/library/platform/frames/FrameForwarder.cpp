@@ -8,6 +8,7 @@
  */
 
 #include "FrameForwarder.hpp"
+#include <common/ThreadPolicy.hpp>
 
 
 FrameForwarder::FrameForwarder(IFrameQueue *queue) :
@@ -91,6 +92,10 @@ void FrameForwarder::waitForThreadReturn()
 
 void FrameForwarder::forwardingThreadFunction()
 {
+    // The listener is called on this thread, so it decides the role. It is
+    // applied once, a listener registered later runs with the same role.
+    ThreadPolicies::instance().apply(FrameListenerCaller::getListenerThreadRole());
+
     do
     {
         auto *frame = m_queue->blockingDequeue();
@@ -44,6 +44,12 @@ public:
      */
     void callListener(FrameType *frame);
 
+    /**
+     * Thread role requested by the registered listener
+     * @return The role of the listener, ThreadRole::Forwarder if there is none
+     */
+    ThreadRole getListenerThreadRole();
+
 private:
     IFrameListener<FrameType> *m_listener;
     std::mutex m_listenerMutex;
@@ -78,3 +84,10 @@ void FrameListenerCaller<FrameType>::callListener(FrameType *frame)
         frame->release();
     }
 }
+
+template <typename FrameType>
+ThreadRole FrameListenerCaller<FrameType>::getListenerThreadRole()
+{
+    std::lock_guard<std::mutex> lock(m_listenerMutex);
+    return m_listener ? m_listener->getThreadRole() : ThreadRole::Forwarder;
+}
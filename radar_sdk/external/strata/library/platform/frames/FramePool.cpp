@@ -10,38 +10,251 @@
 #include "FramePool.hpp"
 
 #include <common/Logger.hpp>
-#include <common/cpp11/memory.hpp>
+#include <common/Metrics.hpp>
+#include <common/ThreadPolicy.hpp>
 #include <common/exception/EGenericException.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#if defined(_WIN32)
+    #include <malloc.h>
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+
+namespace
+{
+    constexpr size_t cacheLineSize  = 64;
+    constexpr size_t hugePageSize   = 2 * 1024 * 1024;
+    constexpr size_t prefaultStride = 4096;  // smallest page size of the supported platforms
+
+    constexpr uint32_t noSlot = std::numeric_limits<uint32_t>::max();
+
+    // a pool has at most 65535 frames, so 0xFFFF is never a valid index
+    constexpr uint32_t maxFrames  = std::numeric_limits<uint16_t>::max();
+    constexpr uint64_t emptyIndex = 0xFFFF;
+
+    // the refill thread checks for requests at least this often, so a
+    // request is not lost if it is signalled right before the thread waits
+    constexpr auto refillInterval = std::chrono::milliseconds(10);
+
+    // The freelist head packs the index of the first free slot (bits 0..15),
+    // the number of free slots (bits 16..31) and a modification tag
+    // (bits 32..63), so a single exchange updates all of them.
+    inline uint64_t makeHead(uint64_t tag, uint64_t available, uint32_t index)
+    {
+        const uint64_t packedIndex = (index == noSlot) ? emptyIndex : index;
+        return ((tag & 0xFFFFFFFF) << 32) | ((available & 0xFFFF) << 16) | packedIndex;
+    }
+
+    inline uint64_t headTag(uint64_t head)
+    {
+        return head >> 32;
+    }
+
+    inline uint32_t headAvailable(uint64_t head)
+    {
+        return static_cast<uint32_t>((head >> 16) & 0xFFFF);
+    }
+
+    inline uint32_t headIndex(uint64_t head)
+    {
+        return ((head & 0xFFFF) == emptyIndex) ? noSlot : static_cast<uint32_t>(head & 0xFFFF);
+    }
+
+    // the pool asks for a refill when less than a quarter of the frames are available
+    inline bool needsRefill(uint32_t available, uint32_t frameCount)
+    {
+        return available < (frameCount + 3) / 4;
+    }
+
+    struct PoolMetrics
+    {
+        MetricsCounter &depleted      = Metrics::instance().counter("frame_pool_depleted");
+        MetricsCounter &reallocations = Metrics::instance().counter("frame_pool_reallocations");
+        MetricsCounter &grown         = Metrics::instance().counter("frame_pool_grown");
+        MetricsGauge &available       = Metrics::instance().gauge("frame_pool_available");
+        MetricsGauge &highWater       = Metrics::instance().gauge("frame_pool_high_water");
+    };
+
+    PoolMetrics &poolMetrics()
+    {
+        static PoolMetrics metrics;
+        return metrics;
+    }
+
+    inline size_t alignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    /**
+     * Allocates cache line aligned memory. On Linux, blocks of at least one
+     * huge page are mapped huge page aligned and advised to use transparent
+     * huge pages. Returns the number of bytes to pass to freeMemory() in size.
+     */
+    void *allocateMemory(size_t &size, bool hugePages, bool &mapped)
+    {
+        mapped = false;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (hugePages && (size >= hugePageSize))
+        {
+            const size_t mapSize = alignUp(size, hugePageSize);
+            void *raw            = mmap(nullptr, mapSize + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw != MAP_FAILED)
+            {
+                // trim the mapping to a huge page aligned range
+                auto begin         = reinterpret_cast<uintptr_t>(raw);
+                const auto aligned = alignUp(begin, hugePageSize);
+                if (aligned != begin)
+                {
+                    munmap(raw, aligned - begin);
+                }
+                const auto end = begin + mapSize + hugePageSize;
+                if (end != aligned + mapSize)
+                {
+                    munmap(reinterpret_cast<void *>(aligned + mapSize), end - (aligned + mapSize));
+                }
+
+                void *memory = reinterpret_cast<void *>(aligned);
+                madvise(memory, mapSize, MADV_HUGEPAGE);
+                size   = mapSize;
+                mapped = true;
+                return memory;
+            }
+        }
+#else
+        (void)hugePages;
+#endif
+
+#if defined(_WIN32)
+        return _aligned_malloc(size, cacheLineSize);
+#else
+        void *memory;
+        return posix_memalign(&memory, cacheLineSize, size) ? nullptr : memory;
+#endif
+    }
+
+    void freeMemory(void *memory, size_t size, bool mapped)
+    {
+#if defined(_WIN32)
+        (void)size;
+        (void)mapped;
+        _aligned_free(memory);
+#else
+        if (mapped)
+        {
+            munmap(memory, size);
+        }
+        else
+        {
+            std::free(memory);
+        }
+#endif
+    }
+
+    bool lockMemory(void *memory, size_t size)
+    {
+#if defined(_WIN32)
+        return VirtualLock(memory, size) != 0;
+#else
+        return mlock(memory, size) == 0;
+#endif
+    }
+
+    void unlockMemory(void *memory, size_t size)
+    {
+#if defined(_WIN32)
+        VirtualUnlock(memory, size);
+#else
+        munlock(memory, size);
+#endif
+    }
+}
+
+
+/**
+ * Descriptor of one frame in a slab. Each slot occupies whole cache lines,
+ * so recycling frames on different threads does not cause false sharing.
+ */
+struct alignas(cacheLineSize) FramePool::Slot
+{
+    Slot(IFramePool *owner, uint8_t *buffer, uint32_t bufferSize) :
+        frame(owner, buffer, bufferSize),
+        next {noSlot},
+        queued {true}
+    {
+    }
+
+    Frame frame;
+    std::atomic<uint32_t> next;
+    std::atomic<bool> queued;  // double-queueing check
+};
+
+/**
+ * One block of memory holding the slots of a range of frames, followed by
+ * their buffers.
+ */
+struct FramePool::Slab
+{
+    Slot *slots;
+    uint32_t first;
+    uint32_t count;
+    void *memory;
+    size_t size;
+    bool mapped;
+    bool locked;
+};
+
 
 FramePool::FramePool() :
-    m_size {0}
+    m_size {0},
+    m_count {0},
+    m_maxCount {0},
+    m_hugePages {true},
+    m_lockMemory {false},
+    m_slabs {new Slab[maxSlabs]},
+    m_slabCount {0},
+    m_frameCount {0},
+    m_head {makeHead(0, 0, noSlot)},
+    m_highWater {0},
+    m_starvations {0},
+    m_growths {0},
+    m_growLimit {0},
+    m_refillRequested {false},
+    m_refillStop {false}
 {
 }
 
 FramePool::~FramePool()
 {
-    // All buffers will be automatically deleted when m_pool is destroyed after this
-    // function returns. They should all be queued.
+    if (m_refillThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_refillStop = true;
+        }
+        m_refillSignal.notify_one();
+        m_refillThread.join();
+    }
+
+    // All frames should be queued when the pool is destroyed.
     //
-    // If any of the buffers aren't queued then something else is still claiming ownership, and may
+    // If any of the frames aren't queued then something else is still claiming ownership, and may
     // still access them.  This would indicate a bug, but we leave the still-accessible buffers
     // still allocated to hopefully avoid memory corruption.
-    // If the size was not yet set (still 0), we don't need to worry about dequeued buffers
-    const auto dequedCount = m_pool.size() - m_queue.size();
-    if (dequedCount && (m_size != 0))
+    const auto dequeuedCount = inUse();
+    if (dequeuedCount)
     {
-        LOG(ERROR) << "Destroying FramePool with some buffers still dequeued: " << std::dec << dequedCount << " of " << m_pool.size();
-        for (auto &buffer : m_pool)
-        {
-            buffer->unpool();
-            buffer.release();  // NOLINT - we rather release the buffer, preferring a memory leak over memory corruption
-        }
-        for (auto buffer : m_queue)
-        {
-            delete buffer;
-        }
+        LOG(ERROR) << "Destroying FramePool with some buffers still dequeued: " << std::dec << dequeuedCount << " of " << m_frameCount.load();
     }
+    releaseSlabs(dequeuedCount != 0);
 }
 
 void FramePool::setFrameBufferSize(uint32_t size)
@@ -55,21 +268,8 @@ void FramePool::setFrameBufferSize(uint32_t size)
 
     if (m_size != size)
     {
-        for (auto &b : m_pool)
-        {
-            if (b)
-            {
-                //Only resize if there are already real buffers in the queue
-                b->resizeBuffer(size);
-            }
-            else
-            {
-                //Create a real buffer
-                b.reset(new Frame(this, size));
-                m_queue.push_back(b.get());
-            }
-        }
         m_size = size;
+        rebuild();
     }
 }
 
@@ -77,86 +277,340 @@ void FramePool::setFrameCount(uint16_t count)
 {
     std::lock_guard<std::mutex> lock(m_lock);
 
-    if ((m_size == 0) && (m_pool.size() != count))
+    if (m_count != count)
     {
-        //Fill the queue with empty pointers, will be initialized when setting size
-        m_pool.resize(count);
-        return;
+        m_count = count;
+        rebuild();
+    }
+}
+
+void FramePool::setMaxFrameCount(uint16_t count)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_maxCount = count;
+    updateGrowLimit();
+
+    if (m_growLimit.load() && !m_refillThread.joinable())
+    {
+        m_refillThread = std::thread(&FramePool::refillThreadFunction, this);
+    }
+}
+
+void FramePool::setHugePages(bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_hugePages = enable;
+}
+
+void FramePool::setLockMemory(bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_lockMemory = enable;
+}
+
+FramePool::Statistics FramePool::getStatistics() const
+{
+    Statistics statistics;
+    statistics.frameCount  = m_frameCount.load();
+    statistics.available   = headAvailable(m_head.load());
+    statistics.highWater   = m_highWater.load();
+    statistics.starvations = m_starvations.load();
+    statistics.growths     = m_growths.load();
+    return statistics;
+}
+
+void FramePool::rebuild()
+{
+    const auto dequeuedCount = inUse();
+    if (dequeuedCount)
+    {
+        LOG(ERROR) << "Reconfiguring FramePool with some buffers still dequeued: " << std::dec << dequeuedCount << " of " << m_frameCount.load();
+    }
+    releaseSlabs(dequeuedCount != 0);
+
+    m_head       = makeHead(headTag(m_head.load()) + 1, 0, noSlot);
+    m_highWater  = 0;
+    m_frameCount = 0;
+    m_slabCount  = 0;
+    updateGrowLimit();
+
+    if (m_size && m_count)
+    {
+        if (!addSlab(m_count))
+        {
+            throw EGenericException("Failed to allocate frame pool");
+        }
+        poolMetrics().reallocations.add(m_count);
+    }
+}
+
+void FramePool::updateGrowLimit()
+{
+    m_growLimit = (m_maxCount > m_count) ? m_maxCount : 0;
+}
+
+bool FramePool::addSlab(uint32_t count)
+{
+    const auto index = m_slabCount.load();
+    if ((index == maxSlabs) || (m_frameCount.load() + count > maxFrames))
+    {
+        return false;
+    }
+
+    // the slots are followed by the buffers, each starting on a cache line
+    const size_t stride = alignUp(m_size, cacheLineSize);
+    size_t size         = count * (sizeof(Slot) + stride);
+    bool mapped;
+    void *memory = allocateMemory(size, m_hugePages, mapped);
+    if (memory == nullptr)
+    {
+        LOG(ERROR) << "FramePool - failed to allocate " << std::dec << size << " bytes";
+        return false;
+    }
+
+    bool locked = false;
+    if (m_lockMemory)
+    {
+        locked = lockMemory(memory, size);
+        if (!locked)
+        {
+            LOG(WARN) << "FramePool - failed to lock " << std::dec << size << " bytes into memory";
+        }
     }
 
-    if (m_pool.size() > count)
+    if (ThreadPolicies::isPrefault())
     {
-        size_t delta = m_pool.size() - count;
-        if (delta > m_queue.size())
+        // touch every page now, so the first frames do not take page faults during acquisition
+        auto bytes = static_cast<volatile uint8_t *>(memory);
+        for (size_t offset = 0; offset < size; offset += prefaultStride)
         {
-            LOG(ERROR) << "Too many buffers dequeued to reduce pool count";
-            delta = m_queue.size();  // only dequeue what we can
+            bytes[offset] = 0;
         }
+    }
+
+    auto slots   = static_cast<Slot *>(memory);
+    auto buffers = static_cast<uint8_t *>(memory) + count * sizeof(Slot);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        new (&slots[i]) Slot(this, buffers + i * stride, m_size);
+    }
+
+    const auto first = m_frameCount.load();
+    m_slabs[index]   = {slots, first, count, memory, size, mapped, locked};
+    m_slabCount.store(index + 1, std::memory_order_release);
 
-        for (auto i = delta; i > 0; i--)
+    // push in reverse order, so the frames are handed out in address order
+    for (auto i = count; i > 0; i--)
+    {
+        push(first + i - 1);
+    }
+
+    // Update the frame count only now, so the number of frames in use is
+    // never overestimated by a concurrent dequeueFrame().
+    m_frameCount.store(first + count, std::memory_order_release);
+    poolMetrics().available.set(static_cast<int64_t>(headAvailable(m_head.load())));
+    return true;
+}
+
+void FramePool::releaseSlabs(bool detach)
+{
+    const auto slabCount = m_slabCount.load();
+    if (detach)
+    {
+        // keep the memory of dequeued frames, but make sure they don't come back
+        for (uint32_t s = 0; s < slabCount; s++)
         {
-            IFrame *frame = m_queue.back();
-            m_queue.pop_back();
-            for (auto it = m_pool.begin(); it != m_pool.end(); it++)
+            for (uint32_t i = 0; i < m_slabs[s].count; i++)
             {
-                if (frame == it->get())
-                {
-                    m_pool.erase(it);
-                    break;
-                }
+                m_slabs[s].slots[i].frame.unpool();
             }
         }
+        m_slabs.release();  // NOLINT - we rather leak the slabs, preferring a memory leak over memory corruption
+        m_slabs.reset(new Slab[maxSlabs]);
+        return;
     }
 
-    if (m_pool.size() < count)
+    for (uint32_t s = 0; s < slabCount; s++)
     {
-        m_queue.reserve(count);
-        m_pool.reserve(count);
+        auto &slab = m_slabs[s];
+        for (uint32_t i = 0; i < slab.count; i++)
+        {
+            slab.slots[i].~Slot();
+        }
+        if (slab.locked)
+        {
+            unlockMemory(slab.memory, slab.size);
+        }
+        freeMemory(slab.memory, slab.size, slab.mapped);
+    }
+}
 
-        const size_t delta = count - m_pool.size();
-        for (auto i = delta; i > 0; i--)
+void FramePool::refillThreadFunction()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (!m_refillStop)
+    {
+        m_refillSignal.wait_for(lock, refillInterval, [this]() {
+            return m_refillStop || m_refillRequested.load();
+        });
+        if (!m_refillStop && m_refillRequested.exchange(false))
         {
-            auto buffer = std::make_unique<Frame>(this, m_size);
-            m_queue.push_back(buffer.get());
-            m_pool.push_back(std::move(buffer));
+            grow();
         }
     }
 }
 
-void FramePool::queueFrame(IFrame *frame)
+bool FramePool::grow()
 {
-    std::lock_guard<std::mutex> lock(m_lock);
-    auto buffer = dynamic_cast<Frame *>(frame);
-    if (buffer == nullptr)
+    // called by the refill thread with m_lock held
+    const auto frameCount = m_frameCount.load();
+    const auto maxCount   = m_growLimit.load();
+    if (!m_size || !frameCount || (frameCount >= maxCount))
     {
-        throw EGenericException("Queueing a buffer that wasn't allocated by this class");
+        return false;
+    }
+    if (!needsRefill(headAvailable(m_head.load()), frameCount))
+    {
+        // enough frames have been queued again in the meantime
+        return false;
+    }
+
+    const auto count = std::min(frameCount, maxCount - frameCount);
+    if (!addSlab(count))
+    {
+        return false;
+    }
+
+    m_growths++;
+    poolMetrics().grown.add(count);
+    LOG(DEBUG) << "FramePool - grown by " << std::dec << count << " to " << (frameCount + count) << " frames";
+    return true;
+}
+
+FramePool::Slot *FramePool::slotAt(uint32_t index) const
+{
+    const auto slabCount = m_slabCount.load(std::memory_order_acquire);
+    for (uint32_t s = 0; s < slabCount; s++)
+    {
+        const auto &slab = m_slabs[s];
+        if (index - slab.first < slab.count)
+        {
+            return &slab.slots[index - slab.first];
+        }
     }
+    return nullptr;
+}
 
-    for (auto &b : m_queue)
+uint32_t FramePool::inUse() const
+{
+    const auto frameCount = m_frameCount.load();
+    const auto available  = headAvailable(m_head.load());
+    return (frameCount > available) ? frameCount - available : 0;
+}
+
+uint32_t FramePool::findSlot(const IFrame *frame) const
+{
+    const auto address   = reinterpret_cast<uintptr_t>(frame);
+    const auto slabCount = m_slabCount.load(std::memory_order_acquire);
+    for (uint32_t s = 0; s < slabCount; s++)
     {
-        if (b == buffer)
+        const auto &slab  = m_slabs[s];
+        const auto offset = address - reinterpret_cast<uintptr_t>(slab.slots);
+        if (offset < slab.count * sizeof(Slot))
         {
-            throw EGenericException("Queueing already-queued buffer");
+            const auto i = static_cast<uint32_t>(offset / sizeof(Slot));
+            return (static_cast<const IFrame *>(&slab.slots[i].frame) == frame) ? slab.first + i : noSlot;
         }
     }
+    return noSlot;
+}
 
-    m_queue.push_back(buffer);
+void FramePool::push(uint32_t index)
+{
+    auto slot = slotAt(index);
+    auto head = m_head.load(std::memory_order_relaxed);
+    uint64_t newHead;
+    do
+    {
+        slot->next.store(headIndex(head), std::memory_order_relaxed);
+        newHead = makeHead(headTag(head) + 1, headAvailable(head) + 1, index);
+    } while (!m_head.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+uint32_t FramePool::pop(uint32_t &available)
+{
+    auto head = m_head.load(std::memory_order_acquire);
+    while (headIndex(head) != noSlot)
+    {
+        // The slot may be popped and pushed again by another thread before
+        // the exchange below, but the changed tag makes the exchange fail then.
+        const auto index   = headIndex(head);
+        const auto next    = slotAt(index)->next.load(std::memory_order_relaxed);
+        const auto newHead = makeHead(headTag(head) + 1, headAvailable(head) - 1, next);
+        if (m_head.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            available = headAvailable(newHead);
+            return index;
+        }
+    }
+    available = 0;
+    return noSlot;
+}
+
+void FramePool::queueFrame(IFrame *frame)
+{
+    const auto index = findSlot(frame);
+    if (index == noSlot)
+    {
+        throw EGenericException("Queueing a buffer that wasn't allocated by this class");
+    }
+    if (slotAt(index)->queued.exchange(true, std::memory_order_relaxed))
+    {
+        throw EGenericException("Queueing already-queued buffer");
+    }
+
+    push(index);
 }
 
 bool FramePool::initialized() const
 {
-    return m_size && !m_pool.empty();
+    return m_frameCount.load() != 0;
 }
 
 IFrame *FramePool::dequeueFrame()
 {
-    std::lock_guard<std::mutex> lock(m_lock);
+    uint32_t available;
+    const auto index      = pop(available);
+    const auto frameCount = m_frameCount.load(std::memory_order_relaxed);
+
+    // Growing allocates memory, so it is left to the refill thread.
+    if ((m_growLimit.load(std::memory_order_relaxed) > frameCount) && needsRefill(available, frameCount) &&
+        !m_refillRequested.exchange(true, std::memory_order_relaxed))
+    {
+        m_refillSignal.notify_one();
+    }
 
-    if (m_queue.empty())
+    if (index == noSlot)
     {
+        m_starvations++;
+        poolMetrics().depleted.add();
         return nullptr;
     }
-    IFrame *frame = m_queue.back();
-    m_queue.pop_back();
-    return frame;
+
+    auto slot = slotAt(index);
+    slot->queued.store(false, std::memory_order_relaxed);
+
+    // The high-water mark is only updated when frames are dequeued, since the
+    // number of frames in use can't grow otherwise.
+    const auto used       = (frameCount > available) ? frameCount - available : 0;
+    auto highWater        = m_highWater.load(std::memory_order_relaxed);
+    if (used > highWater)
+    {
+        while ((used > highWater) && !m_highWater.compare_exchange_weak(highWater, used, std::memory_order_relaxed))
+        {
+        }
+        poolMetrics().highWater.set(static_cast<int64_t>(used));
+    }
+
+    return &slot->frame;
 }
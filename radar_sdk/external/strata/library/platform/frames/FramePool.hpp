@@ -12,15 +12,50 @@
 #include <platform/frames/Frame.hpp>
 #include <platform/interfaces/IFramePool.hpp>
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
-#include <vector>
+#include <thread>
 
 
+/**
+ * Pool of frame buffers.
+ *
+ * All frames of the pool and their buffers are carved from a few large slabs,
+ * each buffer starting on a cache line. On Linux, slabs larger than a huge page
+ * are backed by transparent huge pages; optionally, slabs are locked into
+ * physical memory.
+ *
+ * Frames are recycled through a lock-free freelist, so dequeueFrame() and
+ * queueFrame() can be called from different threads without taking a lock.
+ * The freelist is protected against ABA by a 32-bit modification tag. It
+ * could only fail if a thread was suspended inside dequeueFrame() while
+ * exactly a multiple of 2^32 frames were dequeued and queued by others.
+ *
+ * By default the pool never grows. If a maximum frame count larger than the
+ * frame count is set, a background thread of the pool grows it by up to the
+ * current number of frames whenever dequeueFrame() finds less than a quarter
+ * of the frames available. dequeueFrame() itself never allocates memory, it
+ * still reports a starvation while the pool is empty.
+ *
+ * setFrameBufferSize(), setFrameCount() and the other configuration functions
+ * rebuild the pool. They must not be called concurrently to dequeueFrame();
+ * frames still dequeued at that point are detached from the pool.
+ */
 class FramePool :
     public IFramePool
 {
 public:
+    struct Statistics
+    {
+        uint32_t frameCount;    ///< number of frames currently allocated
+        uint32_t available;     ///< number of frames currently in the pool
+        uint32_t highWater;     ///< maximum number of frames dequeued at the same time
+        uint64_t starvations;   ///< number of dequeueFrame() calls that found the pool empty
+        uint64_t growths;       ///< number of times the pool was grown
+    };
+
     FramePool();
     ~FramePool();
 
@@ -31,11 +66,70 @@ public:
 
     bool initialized() const override;
 
+    /**
+     * Set the number of frames the pool may grow to under backpressure.
+     * A value not larger than the frame count (default: 0) disables growing.
+     */
+    void setMaxFrameCount(uint16_t count);
+
+    /**
+     * Back large slabs by huge pages where supported (default: enabled)
+     */
+    void setHugePages(bool enable);
+
+    /**
+     * Lock slabs into physical memory, so frame buffers are never paged out (default: disabled)
+     */
+    void setLockMemory(bool enable);
+
+    Statistics getStatistics() const;
+
 private:
+    struct Slot;
+    struct Slab;
+
+    void rebuild();
+    void updateGrowLimit();
+    void refillThreadFunction();
+    bool grow();
+    bool addSlab(uint32_t count);
+    void releaseSlabs(bool detach);
+
+    uint32_t findSlot(const IFrame *frame) const;
+    Slot *slotAt(uint32_t index) const;
+    uint32_t inUse() const;
+    void push(uint32_t index);
+    uint32_t pop(uint32_t &available);
+
+    // protects the configuration and growing of the pool
     std::mutex m_lock;
 
     uint32_t m_size;
+    uint16_t m_count;
+    uint16_t m_maxCount;
+    bool m_hugePages;
+    bool m_lockMemory;
+
+    // Slabs are only appended while the pool is in use, so the lock-free
+    // paths can access the first m_slabCount entries without locking.
+    static constexpr uint32_t maxSlabs = 32;
+    std::unique_ptr<Slab[]> m_slabs;
+    std::atomic<uint32_t> m_slabCount;
+    std::atomic<uint32_t> m_frameCount;
+
+    // freelist head: index of the first free slot, number of free slots and
+    // a modification tag to prevent ABA problems
+    std::atomic<uint64_t> m_head;
+
+    std::atomic<uint32_t> m_highWater;
+    std::atomic<uint64_t> m_starvations;
+    std::atomic<uint64_t> m_growths;
 
-    std::vector<std::unique_ptr<Frame>> m_pool;
-    std::vector<IFrame *> m_queue;
+    // Growing is done by the refill thread, which is only started once
+    // growing is enabled. m_growLimit is 0 while growing is disabled.
+    std::atomic<uint32_t> m_growLimit;
+    std::atomic<bool> m_refillRequested;
+    bool m_refillStop;
+    std::condition_variable m_refillSignal;
+    std::thread m_refillThread;
 };
@@ -9,12 +9,32 @@
 
 #include "FrameQueue.hpp"
 #include "ErrorFrame.hpp"
+#include <common/Metrics.hpp>
+#include <common/ThreadPolicy.hpp>
 #include <universal/data_definitions.h>
 
 
+namespace
+{
+    struct QueueMetrics
+    {
+        MetricsCounter &trimmed = Metrics::instance().counter("frame_queue_trimmed");
+        MetricsGauge &depth     = Metrics::instance().gauge("frame_queue_depth");
+    };
+
+    QueueMetrics &queueMetrics()
+    {
+        static QueueMetrics metrics;
+        return metrics;
+    }
+}
+
+
 FrameQueue::FrameQueue() :
     m_queueing {false},
-    m_maxCount {0}
+    m_maxCount {0},
+    m_waiting {0},
+    m_notifyTime {0}
 {
 }
 
@@ -36,6 +56,7 @@ void FrameQueue::trimQueue()
     {
         // try to remove one more frame, since in the end we also want to prepend an error frame
         auto count = m_queue.size() - m_maxCount + 1;
+        queueMetrics().trimmed.add(count);
         while (count--)
         {
             auto frame = m_queue.front();
@@ -60,6 +81,11 @@ void FrameQueue::enqueue(IFrame *frame)
         std::unique_lock<std::mutex> lock(m_lock);
         m_queue.push_back(frame);
         trimQueue();
+        queueMetrics().depth.set(static_cast<int64_t>(m_queue.size()));
+        if (m_waiting && Metrics::isEnabled())
+        {
+            m_notifyTime = Metrics::now();
+        }
         m_cv.notify_one();
     }
     else
@@ -78,6 +104,7 @@ IFrame *FrameQueue::dequeue()
 
     auto frame = m_queue.front();
     m_queue.pop_front();
+    queueMetrics().depth.set(static_cast<int64_t>(m_queue.size()));
     return frame;
 }
 
@@ -91,13 +118,20 @@ IFrame *FrameQueue::blockingDequeue(uint16_t timeoutMs)
     std::unique_lock<std::mutex> lock(m_lock);
 
     //Wait for new frames or timeout. The condition variable checks the predicate before blocking.
-    if (timeoutMs != 0)
+    const bool waiting = !predicate();
+    if (waiting)
     {
-        m_cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), predicate);
-    }
-    else
-    {
-        m_cv.wait(lock, predicate);
+        m_waiting++;
+        m_notifyTime = 0;
+        if (timeoutMs != 0)
+        {
+            m_cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), predicate);
+        }
+        else
+        {
+            m_cv.wait(lock, predicate);
+        }
+        m_waiting--;
     }
 
     if (m_queue.empty())
@@ -105,8 +139,16 @@ IFrame *FrameQueue::blockingDequeue(uint16_t timeoutMs)
         return nullptr;
     }
 
+    if (waiting && m_notifyTime)
+    {
+        // time from the notification until this thread was scheduled again
+        ThreadPolicies::recordWakeup(Metrics::now() - m_notifyTime);
+        m_notifyTime = 0;
+    }
+
     auto frame = m_queue.front();
     m_queue.pop_front();
+    queueMetrics().depth.set(static_cast<int64_t>(m_queue.size()));
     return frame;
 }
 
@@ -121,6 +163,7 @@ void FrameQueue::clear()
             frame->release();
         }
         m_queue.clear();
+        queueMetrics().depth.set(0);
     }
 }
 
@@ -75,4 +75,6 @@ private:
 
     std::atomic<bool> m_queueing;  //true as long as the queue works
     uint32_t m_maxCount;           //maximum number of elements in the queue
+    uint32_t m_waiting;            //number of threads blocked in blockingDequeue
+    uint64_t m_notifyTime;         //time of the last notification of a waiting thread
 };
@@ -56,6 +56,11 @@ void EnumeratorSerialImpl::enumerate(IEnumerationListener &listener, BoardData::
 
     do
     {
+        if (listener.isStopped())
+        {
+            break;
+        }
+
         dwValNameSize = sizeof(cValName);
         dwValueSize   = sizeof(cValue);
         lResult       = RegEnumValue(hKey, dwIndex++, cValName, &dwValNameSize, NULL, NULL, reinterpret_cast<LPBYTE>(cValue), &dwValueSize);
@@ -9,10 +9,57 @@
 
 #include "EnumeratorSerialImplBase.hpp"
 
+#include <common/Finally.hpp>
+#include <common/ParallelFor.hpp>
 #include <platform/serial/BoardSerial.hpp>
 #include <platform/templates/enumerateFunction.hpp>
 
+#include <functional>
+#include <string>
+#include <vector>
+
 #include <glob.h>
+#include <sys/stat.h>
+
+
+namespace
+{
+    /// Number of ports probed at the same time
+    constexpr std::size_t maxProbeThreads = 8;
+
+    /// Keeps the board found on one port, so that boards are reported in port order
+    class PortListener :
+        public IEnumerationListener
+    {
+    public:
+        explicit PortListener(IEnumerationListener &listener) :
+            m_listener {listener}
+        {
+        }
+
+        bool onEnumerate(std::unique_ptr<BoardDescriptor> &&descriptor) override
+        {
+            m_descriptor = std::move(descriptor);
+            return true;
+        }
+
+        bool isStopped() override
+        {
+            return m_listener.isStopped();
+        }
+
+        std::unique_ptr<BoardDescriptor> m_descriptor;
+
+    private:
+        IEnumerationListener &m_listener;
+    };
+
+    inline void mix(uint64_t &signature, uint64_t value)
+    {
+        // FNV-1a on 64 bit words
+        signature = (signature ^ value) * 0x100000001b3ull;
+    }
+}
 
 
 EnumeratorSerialImplBase::EnumeratorSerialImplBase(const char *devBegin[], const char *devEnd[]) :
@@ -21,22 +68,72 @@ EnumeratorSerialImplBase::EnumeratorSerialImplBase(const char *devBegin[], const
 {
 }
 
+void EnumeratorSerialImplBase::findPorts(glob_t &results)
+{
+    for (auto d = m_devBegin; d < m_devEnd; d++)
+    {
+        glob(*d, GLOB_APPEND, nullptr, &results);
+    }
+}
+
 void EnumeratorSerialImplBase::enumerate(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator end)
 {
     glob_t glob_results = {};
+    auto freeGlob       = strata::finally([&glob_results]() {
+        globfree(&glob_results);
+    });
+    findPorts(glob_results);
 
-    for (auto d = m_devBegin; d < m_devEnd; d++)
+    const auto count = glob_results.gl_pathc;
+    std::vector<PortListener> portListeners;
+    portListeners.reserve(count);
+    for (uint_fast16_t i = 0; i < count; i++)
     {
-        glob(*d, GLOB_APPEND, nullptr, &glob_results);
+        portListeners.emplace_back(listener);
     }
 
-    for (uint_fast16_t i = 0; i < glob_results.gl_pathc; i++)
+    // A port without a board costs a full response timeout,
+    // so several ports are probed at the same time.
+    strata::parallelFor(count, maxProbeThreads, [&portListeners, &glob_results, begin, end](std::size_t i) {
+        auto &portListener = portListeners[i];
+        const char *port   = glob_results.gl_pathv[i];
+        if (!portListener.isStopped())
+        {
+            enumerateFunction<BoardSerial>(portListener, begin, end, port);
+        }
+    });
+
+    for (auto &portListener : portListeners)
     {
-        if (enumerateFunction<BoardSerial>(listener, begin, end, glob_results.gl_pathv[i]))
+        if (portListener.m_descriptor && listener.onEnumerate(std::move(portListener.m_descriptor)))
         {
             break;
         }
     }
+}
+
+uint64_t EnumeratorSerialImplBase::getDeviceSignature()
+{
+    glob_t glob_results = {};
+    findPorts(glob_results);
+
+    // Device nodes are created again when a device is plugged in or reset,
+    // so their inode and change time identify the current devices.
+    uint64_t signature = 0xcbf29ce484222325ull;
+    for (uint_fast16_t i = 0; i < glob_results.gl_pathc; i++)
+    {
+        const char *port = glob_results.gl_pathv[i];
+        struct stat status;
+        if (stat(port, &status) != 0)
+        {
+            continue;
+        }
+        mix(signature, std::hash<std::string>()(port));
+        mix(signature, static_cast<uint64_t>(status.st_ino));
+        mix(signature, static_cast<uint64_t>(status.st_rdev));
+        mix(signature, static_cast<uint64_t>(status.st_ctime));
+    }
 
     globfree(&glob_results);
+    return signature;
 }
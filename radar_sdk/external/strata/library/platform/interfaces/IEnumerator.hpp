@@ -18,6 +18,16 @@ public:
     virtual ~IEnumerationListener() = default;
 
     virtual bool onEnumerate(std::unique_ptr<BoardDescriptor> &&descriptor) = 0;
+
+    ///
+    /// Enumerators check this before probing the next device and return early when it is true,
+    /// e.g. because the enumeration deadline expired or enough boards have been found.
+    /// It may be called from several threads at the same time.
+    ///
+    virtual bool isStopped()
+    {
+        return false;
+    }
 };
 
 
@@ -27,4 +37,14 @@ public:
     virtual ~IEnumerator() = default;
 
     virtual void enumerate(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator end) = 0;
+
+    ///
+    /// Returns a value that changes whenever a device of this connection type is attached, removed or reset.
+    /// It is used to invalidate cached enumeration results, so it has to be much cheaper than enumerate().
+    /// Enumerators that cannot detect changes return 0, their results are only reused within the cache lifetime.
+    ///
+    virtual uint64_t getDeviceSignature()
+    {
+        return 0;
+    }
 };
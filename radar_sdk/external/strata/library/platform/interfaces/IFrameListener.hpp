@@ -11,6 +11,8 @@
 
 #include "IFrame.hpp"
 
+#include <common/ThreadPolicy.hpp>
+
 
 template <typename FrameType = IFrame>
 class IFrameListener
@@ -23,4 +25,13 @@ public:
      * @param frame Pointer to a frame containing the received data
      */
     virtual void onNewFrame(FrameType *frame) = 0;
+
+    /**
+     * Role of a thread that only calls this listener, e.g. the thread of a FrameForwarder.
+     * Listeners that unpack the frames themselves return ThreadRole::Converter.
+     */
+    virtual ThreadRole getThreadRole() const
+    {
+        return ThreadRole::Forwarder;
+    }
 };
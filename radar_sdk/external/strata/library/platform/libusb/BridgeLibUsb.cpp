@@ -10,8 +10,11 @@
 #include "BridgeLibUsb.hpp"
 #include "LibUsbHelper.hpp"
 #include <common/Buffer.hpp>
+#include <common/AsyncLogger.hpp>
 #include <common/Logger.hpp>
+#include <common/Metrics.hpp>
 #include <common/Serialization.hpp>
+#include <common/ThreadPolicy.hpp>
 #include <common/Time.hpp>
 #include <platform/exception/EBridgeData.hpp>
 #include <platform/exception/EConnection.hpp>
@@ -280,6 +283,8 @@ bool BridgeLibUsb::dumpPacket()
 
 void BridgeLibUsb::dataThreadFunction()
 {
+    ThreadPolicies::instance().apply(ThreadRole::BridgeReader);
+
     IFrame *frame = nullptr;
     uint8_t *bufBegin, *bufEnd;
     uint8_t *buf;
@@ -287,6 +292,11 @@ void BridgeLibUsb::dataThreadFunction()
     bool firstFrame         = true;
     uint64_t epochTimestamp = 0;
     uint8_t virtualChannel  = 0;
+    uint64_t frameStart     = 0;
+
+    static auto &receiveLatency  = Metrics::instance().latency("bridge_receive");
+    static auto &assemblyLatency = Metrics::instance().latency("frame_assembly");
+    static auto &packetsLost     = Metrics::instance().counter("bridge_packets_lost");
 
     // in our frame buffer, we overwrite the last bytes of the previous packet with the header of the new one.
     // so we have to restore them after reading a new packet, but we don't have to copy the whole payload every time.
@@ -305,7 +315,7 @@ void BridgeLibUsb::dataThreadFunction()
                 // try to discard one packet and try again
                 if (dumpPacket())
                 {
-                    LOG(DEBUG) << "Data read thread - dumped packet";
+                    LOGF(DEBUG, "Data read thread - dumped packet");
                     m_packetCounter++;
                 }
                 continue;
@@ -324,24 +334,26 @@ void BridgeLibUsb::dataThreadFunction()
             {
                 const auto remainingSize = static_cast<int>(bufEnd - buf);
                 const auto readSize      = (remainingSize > m_maxPacketSize) ? m_maxPacketSize : remainingSize;
+                MetricsScope measure(receiveLatency);  // includes waiting for the packet
                 const auto returnedSize  = LibUsbHelper::readBulk(m_deviceHandle, (LIBUSB_ENDPOINT_IN | dataEndpoint), buf, readSize, dataTimeout);
 
                 if (returnedSize == 0)
                 {
                     // no packet available, continue while loop
+                    measure.dismiss();
                     continue;
                 }
 
                 if (returnedSize < frameHeaderSize)
                 {
-                    LOG(DEBUG) << "Data read thread - Packet header incomplete";
+                    LOGF(DEBUG, "Data read thread - Packet header incomplete");
                     continue;
                 }
 
                 const auto bmPktType = serialToHost<uint8_t>(buf);
                 if ((bmPktType & 0xF0) != DATA_FRAME_PACKET)
                 {
-                    LOG(DEBUG) << "Data read thread - Packet type error: 0x" << std::hex << static_cast<int>(bmPktType);
+                    LOGF(DEBUG, "Data read thread - Packet type error: 0x%x", bmPktType);
                     continue;
                 }
 
@@ -353,6 +365,7 @@ void BridgeLibUsb::dataThreadFunction()
                         epochTimestamp = getEpochTime();
                     }
                     virtualChannel = bChannel;
+                    frameStart     = Metrics::isEnabled() ? Metrics::now() : 0;
                 }
 
                 const auto wLength = serialToHost<uint16_t>(buf + 4);
@@ -361,11 +374,11 @@ void BridgeLibUsb::dataThreadFunction()
                     if (remainingSize < frameHeaderSize + wLength)
                     {
                         queueFrame(ErrorFrame::create(DataError_FrameSizeExceeded, bChannel));
-                        LOG(DEBUG) << "Data read thread - Frame buffer insufficient - " << wLength + frameHeaderSize - remainingSize << " bytes discarded";
+                        LOGF(DEBUG, "Data read thread - Frame buffer insufficient - %u bytes discarded", wLength + frameHeaderSize - remainingSize);
                     }
                     else
                     {
-                        LOG(DEBUG) << "Data read thread - Packet length wrong: " << returnedSize << "; expected: " << (frameHeaderSize + wLength);
+                        LOGF(DEBUG, "Data read thread - Packet length wrong: %d; expected: %u", returnedSize, frameHeaderSize + wLength);
                     }
                     continue;
                 }
@@ -376,7 +389,7 @@ void BridgeLibUsb::dataThreadFunction()
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
                     if (wCounter != m_packetCounter)
                     {
-                        LOG(DEBUG) << "Data read thread - First frame packet counter reset: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
+                        LOGF(DEBUG, "Data read thread - First frame packet counter reset: received = 0x%x , current = 0x%x", wCounter, m_packetCounter);
                     }
 #endif
                     firstFrame      = false;
@@ -384,9 +397,10 @@ void BridgeLibUsb::dataThreadFunction()
                 }
                 else if (wCounter != m_packetCounter)
                 {
-                    LOG(INFO) << "Data read thread - Packet loss";
+                    LOGF(INFO, "Data read thread - Packet loss");
+                    packetsLost.add();
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                    LOG(DEBUG) << "    counter mismatch: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
+                    LOGF(DEBUG, "    counter mismatch: received = 0x%x , current = 0x%x", wCounter, m_packetCounter);
 #endif
                     m_packetCounter = wCounter + 1;
 
@@ -398,7 +412,7 @@ void BridgeLibUsb::dataThreadFunction()
                         buf = bufBegin;
 
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - discarding current frame";
+                        LOGF(DEBUG, "Data read thread - discarding current frame");
 #endif
                         continue;
                     }
@@ -417,7 +431,7 @@ void BridgeLibUsb::dataThreadFunction()
                         std::copy(buf + frameHeaderSize, buf + frameHeaderSize + wLength, bufBegin);
                         buf = bufBegin;  // continue normally for a single/first packet
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - previous frame incomplete: wCounter = 0x" << std::hex << wCounter;
+                        LOGF(DEBUG, "Data read thread - previous frame incomplete: wCounter = 0x%x", wCounter);
 #endif
                     }
                 }
@@ -427,7 +441,7 @@ void BridgeLibUsb::dataThreadFunction()
                     {
                         // we expected a new frame, but we received a follow-up packet
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - discarding unexpected follow-up packet";
+                        LOGF(DEBUG, "Data read thread - discarding unexpected follow-up packet");
 #endif
                         continue;  // don't do anything with the received packet and start over
                     }
@@ -435,7 +449,7 @@ void BridgeLibUsb::dataThreadFunction()
                     if (virtualChannel != bChannel)
                     {
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - Channel mismatch: received = 0x" << std::hex << static_cast<int>(bChannel) << " , expected = 0x" << static_cast<int>(virtualChannel);
+                        LOGF(DEBUG, "Data read thread - Channel mismatch: received = 0x%x , expected = 0x%x", bChannel, virtualChannel);
 #endif
                         continue;  // don't do anything with the received packet and start over
                     }
@@ -485,6 +499,10 @@ void BridgeLibUsb::dataThreadFunction()
                         frame->setVirtualChannel(virtualChannel);
                         frame->setTimestamp(epochTimestamp);
 
+                        if (frameStart)
+                        {
+                            assemblyLatency.record(Metrics::now() - frameStart);
+                        }
                         queueFrame(frame);
                         frame = nullptr;
                     }
@@ -500,7 +518,7 @@ void BridgeLibUsb::dataThreadFunction()
             catch (const std::exception &e)
             {
                 queueFrame(ErrorFrame::create(DataError_LowLevelError, VIRTUAL_CHANNEL_UNDEFINED));
-                LOG(DEBUG) << "Data read thread - " << e.what();
+                LOGF(DEBUG, "Data read thread - %s", e.what());
             }
         }
     }
@@ -57,7 +57,7 @@ void EnumeratorLibUsbImpl::enumerate(IEnumerationListener &listener, BoardData::
     const ssize_t count = libusb_get_device_list(defaultContext, &devices);
     char cName[64];
 
-    for (ssize_t i = 0; i < count; i++)
+    for (ssize_t i = 0; (i < count) && !listener.isStopped(); i++)
     {
         libusb_device *dev = devices[i];
         struct libusb_device_descriptor descriptor;
@@ -102,3 +102,25 @@ void EnumeratorLibUsbImpl::enumerate(IEnumerationListener &listener, BoardData::
 
     libusb_free_device_list(devices, 1);
 }
+
+uint64_t EnumeratorLibUsbImpl::getDeviceSignature()
+{
+    // libusb keeps its device list up to date with hotplug events (udev / netlink on Linux),
+    // a device that is plugged in or reset gets a new address on its bus.
+    libusb_device **devices;
+    const ssize_t count = libusb_get_device_list(defaultContext, &devices);
+    if (count < 0)
+    {
+        return 0;
+    }
+
+    uint64_t signature = 0xcbf29ce484222325ull;
+    for (ssize_t i = 0; i < count; i++)
+    {
+        const uint64_t location = (libusb_get_bus_number(devices[i]) << 16) | (libusb_get_port_number(devices[i]) << 8) | libusb_get_device_address(devices[i]);
+        signature               = (signature ^ location) * 0x100000001b3ull;
+    }
+
+    libusb_free_device_list(devices, 1);
+    return signature;
+}
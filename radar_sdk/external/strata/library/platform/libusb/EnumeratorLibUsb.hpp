@@ -69,6 +69,7 @@ public:
     ~EnumeratorLibUsbImpl();
 
     void enumerate(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator end) override;
+    uint64_t getDeviceSignature() override;
 
 private:
     const uint8_t m_classCode;
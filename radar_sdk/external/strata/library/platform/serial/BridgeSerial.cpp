@@ -9,13 +9,16 @@
 
 #include "BridgeSerial.hpp"
 
+#include <common/AsyncLogger.hpp>
 #include <common/Buffer.hpp>
 #include <common/Finally.hpp>
 #include <common/Logger.hpp>
 #include <common/Serialization.hpp>
+#include <common/ThreadPolicy.hpp>
 #include <common/Time.hpp>
 #include <common/crc/Crc16.hpp>
 #include <platform/exception/EBridgeData.hpp>
+#include <platform/exception/EConnection.hpp>
 #include <platform/exception/EProtocol.hpp>
 #include <platform/exception/EProtocolFunction.hpp>
 #include <platform/frames/DebugFrame.hpp>
@@ -37,6 +40,9 @@ namespace
     constexpr const uint32_t defaultBaudrate = 921600;
     constexpr const uint16_t portTimeout     = 100;
 
+    // large enough to hold several maximum size packets
+    constexpr const std::size_t receiveBufferSize = 4 * (SERIAL_MAX_PACKET_SIZE + 1);
+
     constexpr const std::chrono::milliseconds enumerateTimeout(portTimeout);
     constexpr const std::chrono::milliseconds defaultTimeout(1000);
 }
@@ -44,7 +50,23 @@ namespace
 
 BridgeSerial::BridgeSerial(const char port[]) :
     m_protocol(this),
-    m_portName {port}
+    m_portName {port},
+    m_resynchronize {false},
+    m_receiving {false},
+    m_flushRequested {false},
+    m_receiveBuffer(receiveBufferSize),
+    m_receiveBegin {0},
+    m_receiveEnd {0},
+    m_response {},
+    m_responsePayload(m_maxPayload),
+    m_firstPacket {true},
+    m_packetCounter {0},
+    m_frame {nullptr},
+    m_bufBegin {nullptr},
+    m_bufEnd {nullptr},
+    m_buf {nullptr},
+    m_virtualChannel {0},
+    m_epochTimestamp {0}
 {
     BridgeSerial::openConnection();
 }
@@ -62,20 +84,34 @@ bool BridgeSerial::isConnected()
 void BridgeSerial::openConnection()
 {
     m_packetCounter = 0;
-    m_commandActive = false;
     m_resynchronize = false;
 
-    m_cachedPacket = None;
+    m_response.state = ResponseState::Idle;
+    m_receiveBegin   = 0;
+    m_receiveEnd     = 0;
 
     m_port.open(m_portName.c_str(), defaultBaudrate, portTimeout);
     m_port.clearInputBuffer();  // if the previous connection was not closed gracefully, there might be stale data left
 
     m_timeout = enumerateTimeout;
+
+    if (m_receiveThread.joinable())
+    {
+        m_receiveThread.join();  // receive thread of a previous connection stopped with an error
+    }
+    m_receiving     = true;
+    m_receiveThread = std::thread(&BridgeSerial::receiveThreadFunction, this);
 }
 
 void BridgeSerial::closeConnection()
 {
     BridgeSerial::stopStreaming();
+
+    m_receiving = false;
+    if (m_receiveThread.joinable())
+    {
+        m_receiveThread.join();
+    }
     m_port.close();
 }
 
@@ -117,17 +153,20 @@ void BridgeSerial::startStreaming()
 
     if (m_resynchronize)
     {
-        std::unique_lock<std::mutex> lock(m_lock);
-        m_cv.wait(lock, [this] { return (!m_commandActive); });
+        std::lock_guard<std::mutex> lock(m_commandLock);
         if (m_resynchronize)  // check again if it has been cleared in the mean time
         {
-            m_port.clearInputBuffer();
+            flushInput();
             m_resynchronize = false;
         }
     }
-    startBridgeData();
 
-    m_dataThread = std::thread(&BridgeSerial::dataThreadFunction, this);
+    {
+        std::lock_guard<std::mutex> lock(m_dataLock);
+        m_firstPacket = true;
+        m_frame       = nullptr;
+    }
+    startBridgeData();
 }
 
 void BridgeSerial::stopStreaming()
@@ -139,11 +178,13 @@ void BridgeSerial::stopStreaming()
 
     stopBridgeData();
 
+    // once we hold the lock, the receive thread does not access the current frame any more
+    std::lock_guard<std::mutex> lock(m_dataLock);
+    if (m_frame)
     {
-        std::lock_guard<std::mutex> lock(m_lock);  // lock to update CV without race condition
+        m_framePool.queueFrame(m_frame);
+        m_frame = nullptr;
     }
-    m_cv.notify_all();
-    m_dataThread.join();
 }
 
 void BridgeSerial::setDefaultTimeout()
@@ -156,109 +197,441 @@ uint16_t BridgeSerial::getMaxTransfer() const
     return m_maxPayload - m_commandHeaderSize - packetCrcSize;
 }
 
-bool BridgeSerial::readPacketStart(uint8_t buffer[], PacketType type, bool discardOther)
+void BridgeSerial::flushInput()
 {
-    if (m_cachedPacket == type)
-    {
-        std::copy(std::begin(m_packetStartCache), std::end(m_packetStartCache), buffer);
-
-        // lock to update CV without race condition is already acquired by caller
-        m_cachedPacket = None;
-        m_cv.notify_one();
+    std::unique_lock<std::mutex> lock(m_responseLock);
+    m_flushRequested = true;
+    m_responseCv.wait_for(lock, m_timeout, [this] { return !m_flushRequested; });
+}
 
-        return true;
+void BridgeSerial::setResponseState(ResponseState state)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_responseLock);
+        if (m_response.state != ResponseState::Pending)
+        {
+            return;
+        }
+        m_response.state = state;
     }
-    else if (m_cachedPacket == None)
+    m_responseCv.notify_all();
+}
+
+bool BridgeSerial::fillReceiveBuffer(std::size_t count)
+{
+    while (m_receiveEnd - m_receiveBegin < count)
     {
-        const uint16_t returnedSize = m_port.receive(buffer, packetStartSize);
-        if (!returnedSize)
+        if (m_receiveBegin + count > m_receiveBuffer.size())
+        {
+            // move the remaining bytes to the front, so a packet header is always contiguous
+            std::copy(m_receiveBuffer.begin() + m_receiveBegin, m_receiveBuffer.begin() + m_receiveEnd, m_receiveBuffer.begin());
+            m_receiveEnd -= m_receiveBegin;
+            m_receiveBegin = 0;
+        }
+
+        const auto space    = std::min<std::size_t>(m_receiveBuffer.size() - m_receiveEnd, UINT16_MAX);
+        const auto received = m_port.receiveAvailable(&m_receiveBuffer[m_receiveEnd], static_cast<uint16_t>(space));
+        if (!received)
         {
             return false;
         }
-        else if (returnedSize < packetStartSize)
+        m_receiveEnd += received;
+    }
+    return true;
+}
+
+void BridgeSerial::consumeReceiveBuffer(std::size_t count)
+{
+    m_receiveBegin += count;
+    if (m_receiveBegin == m_receiveEnd)
+    {
+        m_receiveBegin = 0;
+        m_receiveEnd   = 0;
+    }
+}
+
+bool BridgeSerial::receivePayload(uint8_t buffer[], uint16_t length)
+{
+    // first use what has already been read ahead
+    const auto buffered = static_cast<uint16_t>(std::min<std::size_t>(m_receiveEnd - m_receiveBegin, length));
+    if (buffer)
+    {
+        std::copy_n(m_receiveBuffer.begin() + m_receiveBegin, buffered, buffer);
+    }
+    consumeReceiveBuffer(buffered);
+
+    uint16_t remaining = length - buffered;
+    if (buffer)
+    {
+        // read the rest directly into the destination
+        return !remaining || (m_port.receive(buffer + buffered, remaining) == remaining);
+    }
+
+    // no destination, so just dump the data
+    while (remaining)
+    {
+        if (!fillReceiveBuffer(1))
         {
-            throw EProtocol("readPacketStart() - incomplete", returnedSize);
+            return false;
         }
-        else
+        const auto count = static_cast<uint16_t>(std::min<std::size_t>(m_receiveEnd - m_receiveBegin, remaining));
+        consumeReceiveBuffer(count);
+        remaining -= count;
+    }
+    return true;
+}
+
+bool BridgeSerial::isControlPacket(uint8_t bmPktType) const
+{
+    switch (bmPktType)
+    {
+#ifdef STRATA_LEGACY_PROTOCOL_3
+        case VENDOR_REQ_READ_LEGACY:
+        case VENDOR_REQ_WRITE_LEGACY:
+        case VENDOR_REQ_TRANSFER_LEGACY:
+#endif
+        case VENDOR_REQ_READ:
+        case VENDOR_REQ_WRITE:
+        case VENDOR_REQ_TRANSFER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void BridgeSerial::receiveThreadFunction()
+{
+    ThreadPolicies::instance().apply(ThreadRole::BridgeReader);
+
+    while (m_receiving)
+    {
+        try
         {
-            PacketType currentPacket;
-            const auto &bmPktType = buffer[0];
+            if (m_flushRequested)
+            {
+                m_receiveBegin = 0;
+                m_receiveEnd   = 0;
+                m_port.clearInputBuffer();
+                {
+                    std::lock_guard<std::mutex> lock(m_responseLock);
+                    m_flushRequested = false;
+                }
+                m_responseCv.notify_all();
+            }
+
+            if (!fillReceiveBuffer(packetStartSize))
+            {
+                // no packet available, continue while loop
+                continue;
+            }
 
+            const auto bmPktType = m_receiveBuffer[m_receiveBegin];
             if ((bmPktType & 0xF0) == DATA_FRAME_PACKET)
             {
-                currentPacket = Data;
+                receiveDataPacket();
+            }
+            else if (isControlPacket(bmPktType))
+            {
+                receiveControlPacket();
             }
             else
             {
-                switch (bmPktType)
+                // or implement synchronization recovery mechanism
+                LOGF(DEBUG, "Receive thread - unknown packet type, synchronization lost!");
+                m_resynchronize = true;
+                m_receiveBegin  = 0;
+                m_receiveEnd    = 0;
+                m_port.clearInputBuffer();
+                setResponseState(ResponseState::SynchronizationLost);
+                if (isBridgeDataStarted())
                 {
-#ifdef STRATA_LEGACY_PROTOCOL_3
-                    case VENDOR_REQ_READ_LEGACY:
-                    case VENDOR_REQ_WRITE_LEGACY:
-                    case VENDOR_REQ_TRANSFER_LEGACY:
-#endif
-                    case VENDOR_REQ_READ:
-                    case VENDOR_REQ_WRITE:
-                    case VENDOR_REQ_TRANSFER:
-                        currentPacket = Control;
-                        break;
-                    default:
-                        m_resynchronize = true;
-                        // or implement synchronization recovery mechanism
-                        throw EProtocol("readPacketStart() - unknown packet type, synchronization lost!", (buffer[0] << 24) | (buffer[1] << 24) | (buffer[2] << 8) | buffer[3]);
+                    queueFrame(ErrorFrame::create(DataError_FrameDropped, VIRTUAL_CHANNEL_UNDEFINED));
                 }
             }
-
-            if (currentPacket == type)
+        }
+        catch (const std::exception &e)
+        {
+            // the port is not usable any more (e.g. device disconnected)
+            LOGF(DEBUG, "Receive thread - %s", e.what());
+            if (isBridgeDataStarted())
             {
-                return true;
+                queueFrame(ErrorFrame::create(DataError_LowLevelError, VIRTUAL_CHANNEL_UNDEFINED));
             }
+            break;
+        }
+    }
 
-            std::copy(buffer, buffer + packetStartSize, m_packetStartCache);
-            m_cachedPacket = currentPacket;
+    // fail the current and all following commands
+    std::lock_guard<std::mutex> lock(m_responseLock);
+    m_receiving = false;
+    if (m_response.state == ResponseState::Pending)
+    {
+        m_response.state = ResponseState::ReceiverStopped;
+    }
+    m_responseCv.notify_all();
+}
+
+void BridgeSerial::receiveControlPacket()
+{
+    uint8_t packet[m_responseHeaderSize + packetCrcSize];
+    std::copy_n(m_receiveBuffer.begin() + m_receiveBegin, packetStartSize, packet);
+    consumeReceiveBuffer(packetStartSize);
+
+    const auto wLength = serialToHost<uint16_t>(packet + 2);
+
+    /*
+     * The packet is read into m_responsePayload without holding m_responseLock,
+     * so a command timing out in the mean time is not blocked by a slow read,
+     * and its buffer is never written after it has returned.
+     */
+    const bool fits     = (wLength <= m_responsePayload.size());
+    const bool complete = receivePayload(fits ? m_responsePayload.data() : nullptr, wLength) &&
+                          receivePayload(&packet[m_responseHeaderSize], packetCrcSize);
+
+    {
+        std::lock_guard<std::mutex> lock(m_responseLock);
+        if (m_response.state != ResponseState::Pending)
+        {
+            // control response received, but no command is waiting for it, so we just dump it...
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+            LOGF(DEBUG, "Receive thread - discarding control packet");
+#endif
+            return;
+        }
+
+        std::copy(std::begin(packet), std::end(packet), m_response.packet);
+        m_response.wLength = wLength;
+
+        if (!complete)
+        {
+            m_response.state = ResponseState::Incomplete;
+        }
+        else if (!fits || (wLength > m_response.maxLength))
+        {
+            m_response.state = ResponseState::TooLong;
+        }
+        else
+        {
+            std::copy_n(m_responsePayload.begin(), wLength, m_response.buffer);
+            m_response.state = ResponseState::Received;
+        }
+    }
+    m_responseCv.notify_all();
+}
+
+void BridgeSerial::receiveDataPacket()
+{
+    if (!fillReceiveBuffer(frameHeaderSize))
+    {
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+        LOGF(DEBUG, "Receive thread - Packet header incomplete");
+#endif
+        return;
+    }
+
+    uint8_t packetHeader[frameHeaderSize];
+    std::copy_n(m_receiveBuffer.begin() + m_receiveBegin, frameHeaderSize, packetHeader);
+    consumeReceiveBuffer(frameHeaderSize);
+
+    const auto bmPktType = serialToHost<uint8_t>(packetHeader + 0);
+    const auto bChannel  = serialToHost<uint8_t>(packetHeader + 1);
+    const auto wLength   = serialToHost<uint16_t>(packetHeader + 4);
+
+    std::lock_guard<std::mutex> lock(m_dataLock);
+    if (!isBridgeDataStarted())
+    {
+        // data is not started, but we received a data packet, so we just dump it...
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+        LOGF(DEBUG, "Receive thread - discarding data packet");
+#endif
+        receivePayload(nullptr, wLength + packetCrcSize);
+        return;
+    }
+
+    const auto wCounter = serialToHost<uint16_t>(packetHeader + 2);
+    if (m_firstPacket)
+    {
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+        if (wCounter != m_packetCounter)
+        {
+            LOGF(DEBUG, "Data read thread - First frame packet counter reset: received = 0x%x , current = 0x%x", wCounter, m_packetCounter);
+        }
+#endif
+        m_firstPacket   = false;
+        m_packetCounter = wCounter + 1;
+    }
+    else if (wCounter != m_packetCounter)
+    {
+        LOGF(INFO, "Data read thread - Packet loss");
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+        LOGF(DEBUG, "    counter mismatch: received = 0x%x , expected = 0x%x", wCounter, m_packetCounter);
+#endif
+        m_packetCounter = wCounter + 1;
+
+        queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
+
+        if (!(bmPktType & DATA_FRAME_FLAG_FIRST))
+        {
+            // if this was a follow-up frame, discard the whole already received part
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+            LOGF(DEBUG, "Data read thread - discarding current frame");
+#endif
+            receivePayload(nullptr, wLength + packetCrcSize);
+            return;
         }
     }
-    else if (discardOther)
+    else
     {
-        uint16_t wLength;
-        if (m_cachedPacket == Data)
+        m_packetCounter++;
+    }
+
+    if (!m_frame)
+    {
+        // try to dequeue frame to read data into
+        m_frame = m_framePool.dequeueFrame();
+
+        if (m_frame)
         {
-            // data is not started, but we received a data packet, so we just dump it...
-            m_port.receive(reinterpret_cast<uint8_t *>(&wLength), 2);
-            littleToHost(wLength);
+            // prepare frame buffer variables
+            m_bufBegin = m_frame->getBuffer();
+            m_bufEnd   = m_bufBegin + m_frame->getBufferSize();
+            m_buf      = m_bufBegin;
+        }
+    }
+    if (!m_frame || (wLength > m_bufEnd - m_buf))
+    {
+        receivePayload(nullptr, wLength + packetCrcSize);
+
+        if (m_frame == nullptr)
+        {
+            queueFrame(ErrorFrame::create(DataError_FramePoolDepleted, VIRTUAL_CHANNEL_UNDEFINED));
 #ifdef BRIDGE_SERIAL_DATA_DEBUG
-            LOG(DEBUG) << "BridgeSerial::readPacketStart() - discarding cached data packet";
+            LOGF(DEBUG, "Data read thread - frame pool depleted, dumping packet");
 #endif
         }
-        else  // Control
+        else
         {
-            // control response received, but no command is active, so we just dump it...
-            wLength = serialToHost<uint16_t>(m_packetStartCache + 2);
+            queueFrame(ErrorFrame::create(DataError_FrameSizeExceeded, bChannel));
 #ifdef BRIDGE_SERIAL_DATA_DEBUG
-            LOG(DEBUG) << "BridgeSerial::readPacketStart() - discarding cached control packet";
+            LOGF(DEBUG, "Data read thread - frame size exceeded, dumping packet");
 #endif
         }
+        return;  // the next packet will again try to dequeue frame buffer
+    }
+
+    if (bmPktType & DATA_FRAME_FLAG_FIRST)
+    {
+        if (setLocalTimestamp)
+        {
+            m_epochTimestamp = getEpochTime();
+        }
+        m_virtualChannel = bChannel;
 
-        strata::buffer<uint8_t> dump(wLength + packetCrcSize);
-        m_port.receive(dump.data(), wLength + packetCrcSize);
+        if (m_buf != m_bufBegin)
+        {
+            // we already started receiving a frame, but now a new frame starts
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+            LOGF(DEBUG, "Data read thread - previous frame incomplete");
+#endif
+            m_buf = m_bufBegin;  // continue normally for a single/first packet
+        }
+    }
 
-        m_cachedPacket = None;
+    // the payload goes straight into the frame buffer
+    uint8_t packetCrc[packetCrcSize];
+    if (!receivePayload(m_buf, wLength) || !receivePayload(packetCrc, packetCrcSize))
+    {
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+        LOGF(DEBUG, "Data read thread - Packet payload incomplete");
+#endif
+        m_buf = m_bufBegin;  // the frame is corrupted, so reset everyting for the next frame start
+        queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
+        return;
     }
 
-    // lock to update CV without race condition is already acquired by caller
-    m_cv.notify_one();
-    return false;
-}
+    uint16_t crc = Crc16CcittFalse(packetHeader, frameHeaderSize);
+    crc          = Crc16CcittFalse(m_buf, wLength, crc);
+    crc          = Crc16CcittFalse(packetCrc, packetCrcSize, crc);
+    if (crc)
+    {
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+        LOGF(DEBUG, "Data read thread - Packet CRC error: 0x%x", crc);
+#endif
+        m_buf = m_bufBegin;  // the frame is corrupted, so reset everyting for the next frame start
+        queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
+        return;
+    }
 
-void BridgeSerial::dumpRemainder(uint16_t wLength)
-{
-    strata::buffer<uint8_t> dump(wLength + packetCrcSize);
-    m_port.receive(dump.data(), wLength + packetCrcSize);  // try to not lose the snyc by reading the remaining data packet
+    if (!(bmPktType & DATA_FRAME_FLAG_FIRST))
+    {
+        if (m_buf == m_bufBegin)
+        {
+            // we expected a new frame, but we received a follow-up packet
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+            LOGF(DEBUG, "Data read thread - discarding unexpected follow-up packet");
+#endif
+            return;  // don't do anything with the received packet and start over
+        }
+
+        if (m_virtualChannel != bChannel)
+        {
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+            LOGF(DEBUG, "Data read thread - Channel mismatch: received = 0x%x , expected = 0x%x", bChannel, m_virtualChannel);
+#endif
+            m_buf = m_bufBegin;  // the frame might be corrupted, so reset everyting for the next frame start
+            queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
+            return;              // don't do anything with the received packet and start over
+        }
+    }
+
+    m_buf += wLength;
+
+    if (bmPktType & DATA_FRAME_FLAG_LAST)
+    {
+        if (bmPktType & DATA_FRAME_FLAG_TIMESTAMP)
+        {
+            m_buf -= sizeof(m_epochTimestamp);
+            if (!setLocalTimestamp)
+            {
+                serialToHost(m_buf, m_epochTimestamp);
+            }
+        }
+        else if (!setLocalTimestamp)
+        {
+            m_epochTimestamp = 0;
+        }
+
+        if (bmPktType & DATA_FRAME_FLAG_ERROR)
+        {
+            uint32_t code;
+            const auto errorFrameLength = sizeof(code) + ((bmPktType & DATA_FRAME_FLAG_TIMESTAMP) ? sizeof(m_epochTimestamp) : 0);
+            if (wLength == errorFrameLength)
+            {
+                serialToHost(m_buf - sizeof(code), code);
+                queueFrame(ErrorFrame::create(code, bChannel, m_epochTimestamp));
+            }
+            else
+            {
+                DebugFrame::log(m_buf - wLength, wLength, m_epochTimestamp);
+            }
+            m_buf = m_bufBegin;
+        }
+        else
+        {
+            m_frame->setDataOffset(0);
+            m_frame->setDataSize(static_cast<uint32_t>(m_buf - m_bufBegin));
+            m_frame->setVirtualChannel(m_virtualChannel);
+            m_frame->setTimestamp(m_epochTimestamp);
+
+            queueFrame(m_frame);
+            m_frame = nullptr;
+        }
+    }
 }
 
 
 #ifdef STRATA_LEGACY_PROTOCOL_3
-    // this has to be done after the defines are used in the case statement in readPacketStart()
+    // this has to be done after the defines are used in the case statement in isControlPacket()
     #undef VENDOR_REQ_WRITE
     #undef VENDOR_REQ_READ
     #undef VENDOR_REQ_TRANSFER
@@ -269,6 +642,14 @@ void BridgeSerial::dumpRemainder(uint16_t wLength)
 #endif
 
 
+void BridgeSerial::expectResponse(uint16_t maxLength, uint8_t buffer[])
+{
+    std::lock_guard<std::mutex> lock(m_responseLock);
+    m_response.state     = ResponseState::Pending;
+    m_response.buffer    = buffer;
+    m_response.maxLength = maxLength;
+}
+
 void BridgeSerial::sendRequest(uint8_t bmReqType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t wLength, const uint8_t buffer[])
 {
     uint8_t packet[m_commandHeaderSize + packetCrcSize] = {
@@ -297,8 +678,7 @@ void BridgeSerial::sendRequest(uint8_t bmReqType, uint8_t bRequest, uint16_t wVa
 
     if (m_resynchronize && !isBridgeDataStarted())
     {
-        m_commandActive = true;  // block access to port already here
-        m_port.clearInputBuffer();
+        flushInput();
     }
 
     if (wLength)
@@ -311,7 +691,6 @@ void BridgeSerial::sendRequest(uint8_t bmReqType, uint8_t bRequest, uint16_t wVa
     {
         m_port.send(packet, m_commandHeaderSize + packetCrcSize);
     }
-    m_commandActive = true;
 }
 
 void BridgeSerial::receiveResponse(uint8_t bmReqType, uint8_t bRequest, uint16_t &wLength, uint8_t buffer[])
@@ -319,45 +698,36 @@ void BridgeSerial::receiveResponse(uint8_t bmReqType, uint8_t bRequest, uint16_t
     const auto maxLength = wLength;
     uint8_t packet[m_responseHeaderSize + packetCrcSize];
     {
-        std::unique_lock<std::mutex> lock(m_lock);
+        std::unique_lock<std::mutex> lock(m_responseLock);
         auto endCommand = strata::finally([this] {
-            m_commandActive = false;
-            m_cv.notify_one();
+            m_response.state = ResponseState::Idle;
         });
 
-        m_resynchronize       = true;  // if we exit this block with an error, this has to be set
-        uint16_t returnedSize = 0;
-        const auto expiry     = std::chrono::steady_clock::now() + m_timeout;
-        do
+        m_resynchronize = true;  // if we exit this block with an error, this has to be set
+        if (!m_receiving && (m_response.state == ResponseState::Pending))
         {
-            m_cv.wait(lock, [this] { return (m_cachedPacket == Control) || !isBridgeDataStarted(); });
-            if (readPacketStart(packet, Control, !isBridgeDataStarted()))
-            {
-                returnedSize = packetStartSize;  // no further read necessary, since (m_responseHeaderSize == packetStartSize)
-                break;
-            }
-        } while (std::chrono::steady_clock::now() < expiry);
-        if (returnedSize < m_responseHeaderSize)
-        {
-            throw EProtocol("Request response header not received", returnedSize);
+            m_response.state = ResponseState::ReceiverStopped;
         }
+        m_responseCv.wait_for(lock, m_timeout, [this] { return (m_response.state != ResponseState::Pending); });
 
-        wLength = serialToHost<uint16_t>(&packet[2]);
-        if (wLength > maxLength)
-        {
-            throw EProtocol("Request response too long for buffer", (wLength << 16) | (bmReqType << 8) | bRequest);
-        }
-        if (wLength != 0)
+        switch (m_response.state)
         {
-            if (m_port.receive(buffer, wLength) != wLength)
-            {
+            case ResponseState::Received:
+                break;
+            case ResponseState::TooLong:
+                throw EProtocol("Request response too long for buffer", (m_response.wLength << 16) | (bmReqType << 8) | bRequest);
+            case ResponseState::Incomplete:
                 throw EProtocol("Request response payload not completely received");
-            }
-        }
-        if (m_port.receive(&packet[m_responseHeaderSize], packetCrcSize) != packetCrcSize)
-        {
-            throw EProtocol("Request response CRC not completely received");
+            case ResponseState::SynchronizationLost:
+                throw EProtocol("Request response - unknown packet type, synchronization lost!");
+            case ResponseState::ReceiverStopped:
+                throw EConnection("Request response - serial port not readable");
+            default:
+                throw EProtocol("Request response header not received", 0);
         }
+
+        wLength = m_response.wLength;
+        std::copy(std::begin(m_response.packet), std::end(m_response.packet), packet);
         m_resynchronize = false;  // if we make it here, we are synchronous
     }
 
@@ -401,6 +771,7 @@ void BridgeSerial::vendorWrite(uint8_t bRequest, uint16_t wValue, uint16_t wInde
 {
     std::lock_guard<std::mutex> lock(m_commandLock);
 
+    expectResponse(0, nullptr);
     sendRequest(VENDOR_REQ_WRITE, bRequest, wValue, wIndex, wLength, buffer);
     wLength = 0;
     receiveResponse(VENDOR_REQ_WRITE, bRequest, wLength, nullptr);
@@ -410,6 +781,7 @@ void BridgeSerial::vendorRead(uint8_t bRequest, uint16_t wValue, uint16_t wIndex
 {
     std::lock_guard<std::mutex> lock(m_commandLock);
 
+    expectResponse(wLength, buffer);
     sendRequest(VENDOR_REQ_READ, bRequest, wValue, wIndex, wLength, nullptr);
     receiveResponse(VENDOR_REQ_READ, bRequest, wLength, buffer);
 }
@@ -418,265 +790,7 @@ void BridgeSerial::vendorTransfer(uint8_t bRequest, uint16_t wValue, uint16_t wI
 {
     std::lock_guard<std::mutex> lock(m_commandLock);
 
+    expectResponse(wLengthReceive, bufferReceive);
     sendRequest(VENDOR_REQ_TRANSFER, bRequest, wValue, wIndex, wLengthSend, bufferSend);
     receiveResponse(VENDOR_REQ_TRANSFER, bRequest, wLengthReceive, bufferReceive);
 }
-
-void BridgeSerial::dataThreadFunction()
-{
-    bool firstFrame = true;
-    IFrame *frame   = nullptr;
-    uint64_t epochTimestamp;
-
-    // the following initializations are only to avoid false positive warnings of uninitialized variable
-    uint8_t virtualChannel = 0;
-    uint8_t *bufBegin      = nullptr;
-    uint8_t *bufEnd        = nullptr;
-    uint8_t *buf           = nullptr;
-
-    // fill frame buffer from multiple data packets
-    while (isBridgeDataStarted())
-    {
-        // read one data packet
-        std::unique_lock<std::mutex> lock(m_lock);
-        m_cv.wait(lock, [this] { return ((m_cachedPacket != Control) || !m_commandActive); });
-
-        try
-        {
-            uint8_t packetHeader[frameHeaderSize];
-            uint16_t returnedSize = 0;
-            if (readPacketStart(packetHeader, Data, !m_commandActive))
-            {
-                returnedSize = packetStartSize + m_port.receive(packetHeader + packetStartSize, frameHeaderSize - packetStartSize);
-            }
-            if (returnedSize < frameHeaderSize)
-            {
-                // no data packet available, continue while loop
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                if (returnedSize)
-                {
-                    LOG(DEBUG) << "Data read thread - Packet header incomplete";
-                }
-#endif
-                continue;
-            }
-
-            const auto bmPktType = serialToHost<uint8_t>(packetHeader + 0);
-            if ((bmPktType & 0xF0) != DATA_FRAME_PACKET)
-            {
-                {
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                    LOG(DEBUG) << "Data read thread - Packet type error: 0x" << std::hex << static_cast<int>(bmPktType);
-#endif
-                    continue;
-                }
-            }
-            const auto bChannel = serialToHost<uint8_t>(packetHeader + 1);
-            const auto wLength  = serialToHost<uint16_t>(packetHeader + 4);
-
-            const auto wCounter = serialToHost<uint16_t>(packetHeader + 2);
-            if (firstFrame)
-            {
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                if (wCounter != m_packetCounter)
-                {
-                    LOG(DEBUG) << "Data read thread - First frame packet counter reset: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
-                }
-#endif
-                firstFrame      = false;
-                m_packetCounter = wCounter + 1;
-            }
-            else if (wCounter != m_packetCounter)
-            {
-                LOG(INFO) << "Data read thread - Packet loss";
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                LOG(DEBUG) << "    counter mismatch: received = 0x" << std::hex << wCounter << " , expected = 0x" << m_packetCounter;
-#endif
-                m_packetCounter = wCounter + 1;
-
-                queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
-
-                if (!(bmPktType & DATA_FRAME_FLAG_FIRST))
-                {
-                    // if this was a follow-up frame, discard the whole already received part
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                    LOG(DEBUG) << "Data read thread - discarding current frame";
-#endif
-                    dumpRemainder(wLength);
-                    continue;
-                }
-            }
-            else
-            {
-                m_packetCounter++;
-            }
-
-            if (!frame)
-            {
-                // try to dequeue frame to read data into
-                frame = m_framePool.dequeueFrame();
-
-                if (frame)
-                {
-                    // prepare frame buffer variables
-                    bufBegin = frame->getBuffer();
-                    bufEnd   = bufBegin + frame->getBufferSize();
-                    buf      = bufBegin;
-                }
-            }
-            const auto remainingSize = bufEnd - buf;
-            if (!frame || (wLength > remainingSize))
-            {
-                dumpRemainder(wLength);
-
-                if (frame == nullptr)
-                {
-                    queueFrame(ErrorFrame::create(DataError_FramePoolDepleted, VIRTUAL_CHANNEL_UNDEFINED));
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                    LOG(DEBUG) << "Data read thread - frame pool depleted, dumping packet";
-#endif
-                }
-                else
-                {
-                    queueFrame(ErrorFrame::create(DataError_FrameSizeExceeded, bChannel));
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                    LOG(DEBUG) << "Data read thread - frame size exceeded, dumping packet";
-#endif
-                }
-                continue;  // restart loop which will again try to dequeue frame buffer
-            }
-
-            if (bmPktType & DATA_FRAME_FLAG_FIRST)
-            {
-                if (setLocalTimestamp)
-                {
-                    epochTimestamp = getEpochTime();
-                }
-                virtualChannel = bChannel;
-
-                if (buf != bufBegin)
-                {
-                    // we already started receiving a frame, but now a new frame starts
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                    LOG(DEBUG) << "Data read thread - previous frame incomplete";
-#endif
-                    buf = bufBegin;  // continue normally for a single/first packet
-                }
-            }
-
-            if (m_port.receive(buf, wLength) != wLength)
-            {
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                LOG(DEBUG) << "Data read thread - Packet payload incomplete";
-#endif
-                buf = bufBegin;  // the frame is corrupted, so reset everyting for the next frame start
-                queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
-                continue;
-            }
-
-            uint8_t packetCrc[packetCrcSize];
-            if (m_port.receive(packetCrc, packetCrcSize) != packetCrcSize)
-            {
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                LOG(DEBUG) << "Data read thread - Packet CRC incomplete";
-#endif
-                buf = bufBegin;  // the frame is corrupted, so reset everyting for the next frame start
-                queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
-                continue;
-            }
-
-            // we do not need to read from the serial port for this data packet any more
-            lock.unlock();
-
-            uint16_t crc = Crc16CcittFalse(packetHeader, frameHeaderSize);
-            crc          = Crc16CcittFalse(buf, wLength, crc);
-            crc          = Crc16CcittFalse(packetCrc, packetCrcSize, crc);
-            if (crc)
-            {
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                LOG(DEBUG) << "Data read thread - Packet CRC error: 0x" << std::hex << crc;
-#endif
-                buf = bufBegin;  // the frame is corrupted, so reset everyting for the next frame start
-                queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
-                continue;
-            }
-
-            if (!(bmPktType & DATA_FRAME_FLAG_FIRST))
-            {
-                if (buf == bufBegin)
-                {
-                    // we expected a new frame, but we received a follow-up packet
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                    LOG(DEBUG) << "Data read thread - discarding unexpected follow-up packet";
-#endif
-                    continue;  // don't do anything with the received packet and start over
-                }
-
-                if (virtualChannel != bChannel)
-                {
-#ifdef BRIDGE_SERIAL_DATA_DEBUG
-                    LOG(DEBUG) << "Data read thread - Channel mismatch: received = 0x" << std::hex << static_cast<int>(bChannel) << " , expected = 0x" << static_cast<int>(virtualChannel);
-#endif
-                    buf = bufBegin;  // the frame might be corrupted, so reset everyting for the next frame start
-                    queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
-                    continue;        // don't do anything with the received packet and start over
-                }
-            }
-
-            buf += wLength;
-
-            if (bmPktType & DATA_FRAME_FLAG_LAST)
-            {
-                if (bmPktType & DATA_FRAME_FLAG_TIMESTAMP)
-                {
-                    buf -= sizeof(epochTimestamp);
-                    if (!setLocalTimestamp)
-                    {
-                        serialToHost(buf, epochTimestamp);
-                    }
-                }
-                else if (!setLocalTimestamp)
-                {
-                    epochTimestamp = 0;
-                }
-
-                if (bmPktType & DATA_FRAME_FLAG_ERROR)
-                {
-                    uint32_t code;
-                    const auto errorFrameLength = sizeof(code) + ((bmPktType & DATA_FRAME_FLAG_TIMESTAMP) ? sizeof(epochTimestamp) : 0);
-                    if (wLength == errorFrameLength)
-                    {
-                        serialToHost(buf - sizeof(code), code);
-                        queueFrame(ErrorFrame::create(code, bChannel, epochTimestamp));
-                    }
-                    else
-                    {
-                        DebugFrame::log(buf - wLength, wLength, epochTimestamp);
-                    }
-                    buf = bufBegin;
-                }
-                else
-                {
-                    frame->setDataOffset(0);
-                    frame->setDataSize(static_cast<uint32_t>(buf - bufBegin));
-                    frame->setVirtualChannel(virtualChannel);
-                    frame->setTimestamp(epochTimestamp);
-
-                    queueFrame(frame);
-                    frame = nullptr;
-                }
-            }
-        }
-        catch (const std::exception &e)
-        {
-            queueFrame(ErrorFrame::create(DataError_LowLevelError, VIRTUAL_CHANNEL_UNDEFINED));
-            LOG(DEBUG) << "Data read thread - " << e.what();
-        }
-    }
-
-    // when stopping the data transfer, check if we still have a frame buffer dequeued
-    if (frame)
-    {
-        m_framePool.queueFrame(frame);
-    }
-}
@@ -17,10 +17,12 @@
 #include <serial/SerialPortImplBridge.hpp>
 #include <universal/link_definitions.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 
 class BridgeSerial :
@@ -57,8 +59,10 @@ public:
     void vendorTransfer(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t wLengthSend, const uint8_t bufferSend[], uint16_t &wLengthReceive, uint8_t bufferReceive[]) override;
 
 private:
+    void expectResponse(uint16_t maxLength, uint8_t buffer[]);
     void sendRequest(uint8_t bmReqType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t wHeaderLength, const uint8_t buffer[]);
     void receiveResponse(uint8_t bmReqType, uint8_t bRequest, uint16_t &wLength, uint8_t buffer[]);
+    void flushInput();
 
     FramePool m_framePool;
     BridgeProtocol m_protocol;
@@ -66,26 +70,73 @@ private:
     std::string m_portName;
     std::chrono::duration<unsigned int, std::milli> m_timeout;
 
-    std::condition_variable m_cv;
-    std::mutex m_lock;
     std::mutex m_commandLock;
 
-    // flags used in CV do not need to be atomic: setting is not critical, and clearing needs to happen with the CV mutex anyways
-    bool m_commandActive;
-    bool m_resynchronize;
-    uint16_t m_packetCounter;
-
-    enum PacketType
+    // set when a command failed, so the input has to be flushed before the next one
+    std::atomic<bool> m_resynchronize;
+
+    /*
+     * All reading from the port is done by the receive thread. It reads as much as
+     * available into m_receiveBuffer and parses the packets from there, so usually
+     * several packets are handled per read call. Larger payloads are read directly
+     * into their destination buffer.
+     */
+    std::thread m_receiveThread;
+    std::atomic<bool> m_receiving;
+    std::atomic<bool> m_flushRequested;
+    std::vector<uint8_t> m_receiveBuffer;
+    std::size_t m_receiveBegin;
+    std::size_t m_receiveEnd;
+
+    void receiveThreadFunction();
+    bool fillReceiveBuffer(std::size_t count);
+    bool receivePayload(uint8_t buffer[], uint16_t length);
+    void consumeReceiveBuffer(std::size_t count);
+    bool isControlPacket(uint8_t bmPktType) const;
+    void receiveControlPacket();
+    void receiveDataPacket();
+
+    /*
+     * A command registers its response buffer before sending the request.
+     * The receive thread fills it and signals the result, so control packets are
+     * handled independently of the data path.
+     */
+    enum class ResponseState
+    {
+        Idle,
+        Pending,
+        Received,
+        TooLong,
+        Incomplete,
+        SynchronizationLost,
+        ReceiverStopped
+    };
+
+    struct
     {
-        None,
-        Control,
-        Data
-    } m_cachedPacket;
-    uint8_t m_packetStartCache[4];
+        ResponseState state;
+        uint8_t *buffer;
+        uint16_t maxLength;
+        uint16_t wLength;
+        uint8_t packet[m_responseHeaderSize + 2];  // header and CRC
+    } m_response;
 
-    bool readPacketStart(uint8_t buffer[], PacketType type, bool discardOther);
-    void dumpRemainder(uint16_t wLength);
+    // the receive thread reads a response payload here before publishing it to the command
+    std::vector<uint8_t> m_responsePayload;
 
-    std::thread m_dataThread;
-    void dataThreadFunction();
+    std::condition_variable m_responseCv;
+    std::mutex m_responseLock;
+
+    void setResponseState(ResponseState state);
+
+    // state of the data frame currently being received, protected by m_dataLock
+    std::mutex m_dataLock;
+    bool m_firstPacket;
+    uint16_t m_packetCounter;
+    IFrame *m_frame;
+    uint8_t *m_bufBegin;
+    uint8_t *m_bufEnd;
+    uint8_t *m_buf;
+    uint8_t m_virtualChannel;
+    uint64_t m_epochTimestamp;
 };
@@ -32,6 +32,11 @@ uint16_t SerialPort::receive(uint8_t buffer[], uint16_t length)
     return count;
 }
 
+uint16_t SerialPort::receiveAvailable(uint8_t buffer[], uint16_t length)
+{
+    return readInputBuffer(buffer, length);
+}
+
 void SerialPort::sendString(const char data[])
 {
     send(reinterpret_cast<const uint8_t *>(data), static_cast<uint16_t>(strlen(data)));
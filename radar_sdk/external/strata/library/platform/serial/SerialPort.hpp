@@ -21,6 +21,18 @@ namespace strata
         //ISerialPort
         uint16_t receive(uint8_t buffer[], uint16_t length) override;
 
+        /**
+        * Receive the data that is currently available from the remote device.
+        * The function waits up to the set timeout for data to arrive,
+        * but returns as soon as any data has been read.
+        *
+        * @param buffer a buffer of the specified maximum length
+        * @param length maximum number of bytes to be read (size of buffer)
+        *
+        * @return the actual number of bytes received, 0 on timeout
+        */
+        uint16_t receiveAvailable(uint8_t buffer[], uint16_t length);
+
         void sendString(const char data[]);
 
     protected:
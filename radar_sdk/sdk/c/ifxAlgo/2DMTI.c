@@ -27,17 +27,22 @@
 ** ===========================================================================
 */
 
+
 /*
 ==============================================================================
    1. INCLUDE FILES
 ==============================================================================
 */
 
+#include <string.h>
+
 #include "ifxAlgo/2DMTI.h"
 
 #include "ifxBase/Complex.h"
 #include "ifxBase/Error.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Simd.h"
+#include "ifxBase/internal/SimdMti.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
 
@@ -47,21 +52,48 @@
 ==============================================================================
 */
 
+/* rows of a matrix are contiguous arrays of float */
+#define MAT_ROWS_CONTIGUOUS(m) (mStride(m, 1) == 1 && sizeof(ifx_Float_t) == sizeof(float))
+
+/* rows of a cube (columns x slices) are contiguous arrays of float */
+#define CUBE_ROWS_CONTIGUOUS(c) (cStride(c, 2) == 1 && cStride(c, 1) == cSlices(c) && sizeof(ifx_Float_t) == sizeof(float))
+
 /*
 ==============================================================================
    3. LOCAL TYPES
 ==============================================================================
 */
 
+/**
+ * @brief Filter state shared by the real and complex 2D MTI filter.
+ *
+ * The history is stored row by row, a row holds columns x slices values
+ * (interleaved real and imaginary part for complex data), i.e. exactly the
+ * layout of a contiguous matrix or cube.
+ */
+typedef struct
+{
+    ifx_MTI_Type_t type;       /**< Clutter removal filter.*/
+    ifx_Float_t alpha;         /**< Decides the weight \f$ alpha \f$ of the 2D MTI filter.*/
+    ifx_Float_t* alpha_per_row; /**< Filter coefficient per row (range bin), NULL if alpha is used.*/
+    uint32_t decimation;       /**< The history is updated every decimation-th run.*/
+    uint32_t run_count;        /**< Number of runs modulo decimation.*/
+    uint32_t rows;             /**< Number of rows.*/
+    uint32_t columns;          /**< Number of columns.*/
+    uint32_t slices;           /**< Number of slices, 1 for matrix filters.*/
+    uint32_t row_size;         /**< Number of floats per row.*/
+    float* history;            /**< Filter history (last input for the pulse cancellers).*/
+    float* history2;           /**< Second last input for \ref IFX_MTI_TYPE_THREE_PULSE, NULL otherwise.*/
+    float* row_buffer;         /**< Copy of a row of a non-contiguous input.*/
+} MTI_State_t;
+
 /**
  * @brief Defines the structure for 2D MTI filter to operate on real matrix.
  *        Use type ifx_2DMTI_R_t for this struct.
  */
 struct ifx_2DMTI_R_s
 {
-    ifx_Float_t alpha_MTI_filter;     /**< Decides the weight \f$ alpha \f$ of the 2D MTI filter.*/
-    ifx_Matrix_R_t* filter_history_r; /**< A real matrix container that stores the historical
-                                           data to be subtracted from the next incoming matrix data.*/
+    MTI_State_t state; /**< Filter state.*/
 };
 
 /**
@@ -70,9 +102,7 @@ struct ifx_2DMTI_R_s
  */
 struct ifx_2DMTI_C_s
 {
-    ifx_Float_t alpha_MTI_filter;     /**< Decides the weight \f$ alpha \f$ of the 2D MTI filter.*/
-    ifx_Matrix_C_t* filter_history_c; /**< A complex matrix container that stores the historical
-                                           data to be subtracted from the next incoming matrix data.*/
+    MTI_State_t state; /**< Filter state.*/
 };
 
 /*
@@ -87,12 +117,199 @@ struct ifx_2DMTI_C_s
 ==============================================================================
 */
 
+static bool state_init(MTI_State_t* state,
+                       ifx_Float_t alpha,
+                       uint32_t rows,
+                       uint32_t columns,
+                       uint32_t slices,
+                       uint32_t values_per_element);
+
+static void state_free(MTI_State_t* state);
+
+static bool state_begin(MTI_State_t* state);
+
+static void state_filter_row(const MTI_State_t* state,
+                             bool update,
+                             uint32_t row,
+                             const float* x,
+                             float* y);
+
+static void state_end(MTI_State_t* state,
+                      bool update);
+
+static void state_set_type(MTI_State_t* state,
+                           ifx_MTI_Type_t type);
+
+static void state_set_alpha_per_row(MTI_State_t* state,
+                                    const ifx_Vector_R_t* alpha);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
 ==============================================================================
 */
 
+static bool state_init(MTI_State_t* state,
+                       ifx_Float_t alpha,
+                       uint32_t rows,
+                       uint32_t columns,
+                       uint32_t slices,
+                       uint32_t values_per_element)
+{
+    const size_t size = (size_t)rows * columns * slices * values_per_element;
+
+    state->type = IFX_MTI_TYPE_EXPONENTIAL;
+    state->alpha = alpha;
+    state->alpha_per_row = NULL;
+    state->decimation = 1;
+    state->run_count = 0;
+    state->rows = rows;
+    state->columns = columns;
+    state->slices = slices;
+    state->row_size = columns * slices * values_per_element;
+    state->history2 = NULL;
+    state->history = ifx_mem_calloc(size, sizeof(float));
+    state->row_buffer = ifx_mem_alloc(sizeof(float) * state->row_size);
+
+    return state->history != NULL && state->row_buffer != NULL;
+}
+
+//----------------------------------------------------------------------------
+
+static void state_free(MTI_State_t* state)
+{
+    ifx_mem_free(state->alpha_per_row);
+    ifx_mem_free(state->history);
+    ifx_mem_free(state->history2);
+    ifx_mem_free(state->row_buffer);
+}
+
+//----------------------------------------------------------------------------
+
+static bool state_begin(MTI_State_t* state)
+{
+    const bool update = (state->run_count == 0);
+    state->run_count = (state->run_count + 1 < state->decimation) ? state->run_count + 1 : 0;
+    return update;
+}
+
+//----------------------------------------------------------------------------
+
+static void state_filter_row(const MTI_State_t* state,
+                             bool update,
+                             uint32_t row,
+                             const float* x,
+                             float* y)
+{
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+    const ifx_Simd_Mti_Kernels_t* mti_kernels = ifx_simd_mti_kernels();
+    const size_t len = state->row_size;
+    const size_t offset = (size_t)row * len;
+    float* history = &state->history[offset];
+
+    // output_n := input_n - history_n
+    // history_n := history_{n-1} + alpha*output_n
+    //            = alpha*input_n + (1-alpha)*history_{n-1}
+    switch (state->type)
+    {
+        case IFX_MTI_TYPE_THREE_PULSE:
+            if (update)
+            {
+                mti_kernels->cancel3_r(x, history, &state->history2[offset], y, len);
+            }
+            else
+            {
+                kernels->mac_r(x, history, -2, y, len);
+                kernels->add_r(y, &state->history2[offset], y, len);
+            }
+            break;
+
+        case IFX_MTI_TYPE_TWO_PULSE:
+            if (update)
+                mti_kernels->mti_r(x, history, 1, y, len);
+            else
+                kernels->sub_r(x, history, y, len);
+            break;
+
+        default:  // IFX_MTI_TYPE_EXPONENTIAL
+            if (update)
+            {
+                // the coefficient of a row applies to all of its columns and slices
+                const ifx_Float_t alpha = state->alpha_per_row ? state->alpha_per_row[row] : state->alpha;
+                mti_kernels->mti_r(x, history, alpha, y, len);
+            }
+            else
+            {
+                kernels->sub_r(x, history, y, len);
+            }
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void state_end(MTI_State_t* state,
+                      bool update)
+{
+    // the second last input is now in history2: swap so history holds the last one
+    if (update && state->type == IFX_MTI_TYPE_THREE_PULSE)
+    {
+        float* tmp = state->history;
+        state->history = state->history2;
+        state->history2 = tmp;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void state_set_type(MTI_State_t* state,
+                           ifx_MTI_Type_t type)
+{
+    IFX_ERR_BRK_ARGUMENT(type > IFX_MTI_TYPE_THREE_PULSE);
+
+    const size_t size = (size_t)state->rows * state->row_size;
+
+    if (type == IFX_MTI_TYPE_THREE_PULSE && state->history2 == NULL)
+    {
+        state->history2 = ifx_mem_alloc(sizeof(float) * size);
+        IFX_ERR_BRK_MEMALLOC(state->history2);
+    }
+
+    state->type = type;
+    state->run_count = 0;
+    memset(state->history, 0, sizeof(float) * size);
+    if (state->history2)
+        memset(state->history2, 0, sizeof(float) * size);
+}
+
+//----------------------------------------------------------------------------
+
+static void state_set_alpha_per_row(MTI_State_t* state,
+                                    const ifx_Vector_R_t* alpha)
+{
+    if (alpha == NULL)
+    {
+        ifx_mem_free(state->alpha_per_row);
+        state->alpha_per_row = NULL;
+        return;
+    }
+
+    IFX_VEC_BRK_VALID(alpha);
+    IFX_ERR_BRK_COND(vLen(alpha) != state->rows, IFX_ERROR_DIMENSION_MISMATCH);
+    for (uint32_t r = 0; r < vLen(alpha); r++)
+    {
+        IFX_ERR_BRK_ARGUMENT(vAt(alpha, r) < 0 || vAt(alpha, r) > 1);
+    }
+
+    if (state->alpha_per_row == NULL)
+    {
+        state->alpha_per_row = ifx_mem_alloc(sizeof(ifx_Float_t) * state->rows);
+        IFX_ERR_BRK_MEMALLOC(state->alpha_per_row);
+    }
+    for (uint32_t r = 0; r < vLen(alpha); r++)
+        state->alpha_per_row[r] = vAt(alpha, r);
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -102,39 +319,65 @@ struct ifx_2DMTI_C_s
 ifx_2DMTI_R_t* ifx_2dmti_create_r(ifx_Float_t alpha_mti_filter,
                                   uint32_t rows,
                                   uint32_t columns)
+{
+    return ifx_2dmti_create_cube_r(alpha_mti_filter, rows, columns, 1);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_2DMTI_C_t* ifx_2dmti_create_c(ifx_Float_t alpha_mti_filter,
+                                  uint32_t rows,
+                                  uint32_t columns)
+{
+    return ifx_2dmti_create_cube_c(alpha_mti_filter, rows, columns, 1);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_2DMTI_R_t* ifx_2dmti_create_cube_r(ifx_Float_t alpha_mti_filter,
+                                       uint32_t rows,
+                                       uint32_t columns,
+                                       uint32_t slices)
 {
     IFX_ERR_BRN_ARGUMENT(alpha_mti_filter < 0 || alpha_mti_filter > 1);
     IFX_ERR_BRN_ARGUMENT(rows == 0);
     IFX_ERR_BRN_ARGUMENT(columns == 0);
+    IFX_ERR_BRN_ARGUMENT(slices == 0);
 
-    ifx_2DMTI_R_t* h = ifx_mem_alloc(sizeof(struct ifx_2DMTI_R_s));
+    ifx_2DMTI_R_t* h = ifx_mem_calloc(1, sizeof(struct ifx_2DMTI_R_s));
     IFX_ERR_BRN_MEMALLOC(h);
 
-    IFX_ERR_HANDLE_N(h->filter_history_r = ifx_mat_create_r(rows, columns),
-                     ifx_2dmti_destroy_r(h));
-
-    h->alpha_MTI_filter = alpha_mti_filter;
+    if (!state_init(&h->state, alpha_mti_filter, rows, columns, slices, 1))
+    {
+        ifx_2dmti_destroy_r(h);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
 
     return h;
 }
 
 //----------------------------------------------------------------------------
 
-ifx_2DMTI_C_t* ifx_2dmti_create_c(ifx_Float_t alpha_mti_filter,
-                                  uint32_t rows,
-                                  uint32_t columns)
+ifx_2DMTI_C_t* ifx_2dmti_create_cube_c(ifx_Float_t alpha_mti_filter,
+                                       uint32_t rows,
+                                       uint32_t columns,
+                                       uint32_t slices)
 {
     IFX_ERR_BRN_ARGUMENT(alpha_mti_filter < 0 || alpha_mti_filter > 1);
     IFX_ERR_BRN_ARGUMENT(rows == 0);
     IFX_ERR_BRN_ARGUMENT(columns == 0);
+    IFX_ERR_BRN_ARGUMENT(slices == 0);
 
-    ifx_2DMTI_C_t* h = ifx_mem_alloc(sizeof(struct ifx_2DMTI_C_s));
+    ifx_2DMTI_C_t* h = ifx_mem_calloc(1, sizeof(struct ifx_2DMTI_C_s));
     IFX_ERR_BRN_MEMALLOC(h);
 
-    IFX_ERR_HANDLE_N(h->filter_history_c = ifx_mat_create_c(rows, columns),
-                     ifx_2dmti_destroy_c(h));
-
-    h->alpha_MTI_filter = alpha_mti_filter;
+    if (!state_init(&h->state, alpha_mti_filter, rows, columns, slices, 2))
+    {
+        ifx_2dmti_destroy_c(h);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
 
     return h;
 }
@@ -148,7 +391,7 @@ void ifx_2dmti_destroy_r(ifx_2DMTI_R_t* handle)
         return;
     }
 
-    ifx_mat_destroy_r(handle->filter_history_r);
+    state_free(&handle->state);
 
     ifx_mem_free(handle);
 }
@@ -162,7 +405,7 @@ void ifx_2dmti_destroy_c(ifx_2DMTI_C_t* handle)
         return;
     }
 
-    ifx_mat_destroy_c(handle->filter_history_c);
+    state_free(&handle->state);
 
     ifx_mem_free(handle);
 }
@@ -176,27 +419,32 @@ void ifx_2dmti_run_r(ifx_2DMTI_R_t* handle,
     IFX_ERR_BRK_NULL(handle);
     IFX_MAT_BRK_VALID(input);
     IFX_MAT_BRK_VALID(output);
-    IFX_MAT_BRK_DIM(handle->filter_history_r, input);
+    IFX_ERR_BRK_COND(handle->state.slices != 1, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(mRows(input) != handle->state.rows || mCols(input) != handle->state.columns, IFX_ERROR_DIMENSION_MISMATCH);
     IFX_MAT_BRK_DIM(input, output);
 
-    // for shorter names
-    const uint32_t rows = mRows(input);
-    const uint32_t cols = mCols(input);
-    const ifx_Float_t alpha = handle->alpha_MTI_filter;
-    ifx_Matrix_R_t* history = handle->filter_history_r;
+    MTI_State_t* state = &handle->state;
+    const bool contiguous = MAT_ROWS_CONTIGUOUS(input) && MAT_ROWS_CONTIGUOUS(output);
+    const bool update = state_begin(state);
 
-    // output_n := input_n - history_n
-    // history_n := alpha*input_n + (1-alpha)*history_{n-1}
-    for (uint32_t r = 0; r < rows; r++)
+    for (uint32_t r = 0; r < mRows(input); r++)
     {
-        for (uint32_t c = 0; c < cols; c++)
+        if (contiguous)
         {
-            const ifx_Float_t input_rc = mAt(input, r, c);
-            const ifx_Float_t history_rc = mAt(history, r, c);
-            mAt(output, r, c) = input_rc - history_rc;
-            mAt(history, r, c) = alpha * input_rc + (1 - alpha) * history_rc;
+            state_filter_row(state, update, r, (const float*)&mAt(input, r, 0), (float*)&mAt(output, r, 0));
+            continue;
         }
+
+        for (uint32_t c = 0; c < mCols(input); c++)
+            state->row_buffer[c] = mAt(input, r, c);
+
+        state_filter_row(state, update, r, state->row_buffer, state->row_buffer);
+
+        for (uint32_t c = 0; c < mCols(input); c++)
+            mAt(output, r, c) = state->row_buffer[c];
     }
+
+    state_end(state, update);
 }
 
 //----------------------------------------------------------------------------
@@ -208,29 +456,118 @@ void ifx_2dmti_run_c(ifx_2DMTI_C_t* handle,
     IFX_ERR_BRK_NULL(handle);
     IFX_MAT_BRK_VALID(input);
     IFX_MAT_BRK_VALID(output);
-    IFX_MAT_BRK_DIM(handle->filter_history_c, input);
+    IFX_ERR_BRK_COND(handle->state.slices != 1, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(mRows(input) != handle->state.rows || mCols(input) != handle->state.columns, IFX_ERROR_DIMENSION_MISMATCH);
     IFX_MAT_BRK_DIM(input, output);
 
-    // for shorter names
-    const uint32_t rows = mRows(input);
-    const uint32_t cols = mCols(input);
-    const ifx_Float_t alpha = handle->alpha_MTI_filter;
-    ifx_Matrix_C_t* history = handle->filter_history_c;
+    MTI_State_t* state = &handle->state;
+    const bool contiguous = MAT_ROWS_CONTIGUOUS(input) && MAT_ROWS_CONTIGUOUS(output);
+    const bool update = state_begin(state);
+    ifx_Complex_t* buffer = (ifx_Complex_t*)state->row_buffer;
 
-    // output_n := input_n - history_n
-    // history_n := alpha*input_n + (1-alpha)*history_{n-1}
-    for (uint32_t r = 0; r < rows; r++)
+    for (uint32_t r = 0; r < mRows(input); r++)
+    {
+        if (contiguous)
+        {
+            state_filter_row(state, update, r, (const float*)&mAt(input, r, 0), (float*)&mAt(output, r, 0));
+            continue;
+        }
+
+        for (uint32_t c = 0; c < mCols(input); c++)
+            buffer[c] = mAt(input, r, c);
+
+        state_filter_row(state, update, r, state->row_buffer, state->row_buffer);
+
+        for (uint32_t c = 0; c < mCols(input); c++)
+            mAt(output, r, c) = buffer[c];
+    }
+
+    state_end(state, update);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_run_cube_r(ifx_2DMTI_R_t* handle,
+                          const ifx_Cube_R_t* input,
+                          ifx_Cube_R_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(input);
+    IFX_CUBE_BRK_VALID(output);
+    IFX_ERR_BRK_COND(cRows(input) != handle->state.rows || cCols(input) != handle->state.columns
+                         || cSlices(input) != handle->state.slices,
+                     IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_CUBE_BRK_DIM(input, output);
+
+    MTI_State_t* state = &handle->state;
+    const bool contiguous = CUBE_ROWS_CONTIGUOUS(input) && CUBE_ROWS_CONTIGUOUS(output);
+    const bool update = state_begin(state);
+
+    for (uint32_t r = 0; r < cRows(input); r++)
     {
-        for (uint32_t c = 0; c < cols; c++)
+        if (contiguous)
         {
-            const ifx_Complex_t input_rc = mAt(input, r, c);
-            const ifx_Complex_t history_rc = mAt(history, r, c);
-            mAt(output, r, c) = ifx_complex_sub(input_rc, history_rc);
-            mAt(history, r, c) = ifx_complex_add(
-                ifx_complex_mul_real(input_rc, alpha),
-                ifx_complex_mul_real(history_rc, (1 - alpha)));
+            state_filter_row(state, update, r, (const float*)&cAt(input, r, 0, 0), (float*)&cAt(output, r, 0, 0));
+            continue;
         }
+
+        uint32_t i = 0;
+        for (uint32_t c = 0; c < cCols(input); c++)
+            for (uint32_t s = 0; s < cSlices(input); s++)
+                state->row_buffer[i++] = cAt(input, r, c, s);
+
+        state_filter_row(state, update, r, state->row_buffer, state->row_buffer);
+
+        i = 0;
+        for (uint32_t c = 0; c < cCols(input); c++)
+            for (uint32_t s = 0; s < cSlices(input); s++)
+                cAt(output, r, c, s) = state->row_buffer[i++];
     }
+
+    state_end(state, update);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_run_cube_c(ifx_2DMTI_C_t* handle,
+                          const ifx_Cube_C_t* input,
+                          ifx_Cube_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(input);
+    IFX_CUBE_BRK_VALID(output);
+    IFX_ERR_BRK_COND(cRows(input) != handle->state.rows || cCols(input) != handle->state.columns
+                         || cSlices(input) != handle->state.slices,
+                     IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_CUBE_BRK_DIM(input, output);
+
+    MTI_State_t* state = &handle->state;
+    const bool contiguous = CUBE_ROWS_CONTIGUOUS(input) && CUBE_ROWS_CONTIGUOUS(output);
+    const bool update = state_begin(state);
+    ifx_Complex_t* buffer = (ifx_Complex_t*)state->row_buffer;
+
+    for (uint32_t r = 0; r < cRows(input); r++)
+    {
+        if (contiguous)
+        {
+            state_filter_row(state, update, r, (const float*)&cAt(input, r, 0, 0), (float*)&cAt(output, r, 0, 0));
+            continue;
+        }
+
+        uint32_t i = 0;
+        for (uint32_t c = 0; c < cCols(input); c++)
+            for (uint32_t s = 0; s < cSlices(input); s++)
+                buffer[i++] = cAt(input, r, c, s);
+
+        state_filter_row(state, update, r, state->row_buffer, state->row_buffer);
+
+        i = 0;
+        for (uint32_t c = 0; c < cCols(input); c++)
+            for (uint32_t s = 0; s < cSlices(input); s++)
+                cAt(output, r, c, s) = buffer[i++];
+    }
+
+    state_end(state, update);
 }
 
 //----------------------------------------------------------------------------
@@ -241,7 +578,7 @@ void ifx_2dmti_set_filter_coeff_r(ifx_2DMTI_R_t* handle,
     IFX_ERR_BRK_NULL(handle);
     IFX_ERR_BRK_ARGUMENT(alpha_mti_filter < 0 || alpha_mti_filter > 1);
 
-    handle->alpha_MTI_filter = alpha_mti_filter;
+    handle->state.alpha = alpha_mti_filter;
 }
 
 //----------------------------------------------------------------------------
@@ -250,7 +587,7 @@ ifx_Float_t ifx_2dmti_get_filter_coeff_r(ifx_2DMTI_R_t* handle)
 {
     IFX_ERR_BRV_NULL(handle, 0);
 
-    return handle->alpha_MTI_filter;
+    return handle->state.alpha;
 }
 
 //----------------------------------------------------------------------------
@@ -261,7 +598,7 @@ void ifx_2dmti_set_filter_coeff_c(ifx_2DMTI_C_t* handle,
     IFX_ERR_BRK_NULL(handle);
     IFX_ERR_BRK_ARGUMENT(alpha_mti_filter < 0 || alpha_mti_filter > 1);
 
-    handle->alpha_MTI_filter = alpha_mti_filter;
+    handle->state.alpha = alpha_mti_filter;
 }
 
 //----------------------------------------------------------------------------
@@ -270,5 +607,63 @@ ifx_Float_t ifx_2dmti_get_filter_coeff_c(ifx_2DMTI_C_t* handle)
 {
     IFX_ERR_BRV_NULL(handle, 0);
 
-    return handle->alpha_MTI_filter;
+    return handle->state.alpha;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_set_type_r(ifx_2DMTI_R_t* handle,
+                          ifx_MTI_Type_t type)
+{
+    IFX_ERR_BRK_NULL(handle);
+    state_set_type(&handle->state, type);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_set_type_c(ifx_2DMTI_C_t* handle,
+                          ifx_MTI_Type_t type)
+{
+    IFX_ERR_BRK_NULL(handle);
+    state_set_type(&handle->state, type);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_set_alpha_per_row_r(ifx_2DMTI_R_t* handle,
+                                   const ifx_Vector_R_t* alpha)
+{
+    IFX_ERR_BRK_NULL(handle);
+    state_set_alpha_per_row(&handle->state, alpha);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_set_alpha_per_row_c(ifx_2DMTI_C_t* handle,
+                                   const ifx_Vector_R_t* alpha)
+{
+    IFX_ERR_BRK_NULL(handle);
+    state_set_alpha_per_row(&handle->state, alpha);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_set_decimation_r(ifx_2DMTI_R_t* handle,
+                                uint32_t decimation)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    handle->state.decimation = (decimation == 0) ? 1 : decimation;
+    handle->state.run_count = 0;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_set_decimation_c(ifx_2DMTI_C_t* handle,
+                                uint32_t decimation)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    handle->state.decimation = (decimation == 0) ? 1 : decimation;
+    handle->state.run_count = 0;
 }
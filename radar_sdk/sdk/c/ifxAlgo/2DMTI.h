@@ -44,6 +44,8 @@
 ==============================================================================
 */
 
+#include "ifxAlgo/MTI.h"
+#include "ifxBase/Cube.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Types.h"
 
@@ -95,6 +97,11 @@ typedef struct ifx_2DMTI_C_s ifx_2DMTI_C_t;
  * The formulae are equivalent to the 1D MTI case. For more information refer to
  * the documentation of \ref gr_mti.
  *
+ * Besides matrices, the filter can also operate on cubes, e.g., a range-Doppler
+ * cube with one slice per antenna. The filter coefficient, the filter type and
+ * the decimation apply to all columns and slices of a row; see
+ * \ref ifx_2dmti_set_alpha_per_row_r for a coefficient per row (range bin).
+ *
  * @if ssct_radarsdk_algorithms_2dmti
  * An algorithm explanation is also available at the \ref ssct_radarsdk_algorithms_2dmti SDK documentation.
  * @endif
@@ -130,6 +137,44 @@ ifx_2DMTI_C_t* ifx_2dmti_create_c(ifx_Float_t alpha_mti_filter,
                                   uint32_t rows,
                                   uint32_t columns);
 
+/**
+ * @brief Creates 2D MTI filter handle to operate on real cube.
+ *
+ * The handle can be used with \ref ifx_2dmti_run_cube_r. If slices is 1 it
+ * can also be used with \ref ifx_2dmti_run_r.
+ *
+ * @param [in]     alpha_mti_filter    Scalar for 2D MTI Filter parameter. Valid range [0.0, 1.0]
+ * @param [in]     rows                Number of rows of cube used within 2D MTI filter
+ * @param [in]     columns             Number of columns of cube used within 2D MTI filter
+ * @param [in]     slices              Number of slices of cube used within 2D MTI filter
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_2DMTI_R_t* ifx_2dmti_create_cube_r(ifx_Float_t alpha_mti_filter,
+                                       uint32_t rows,
+                                       uint32_t columns,
+                                       uint32_t slices);
+
+/**
+ * @brief Creates 2D MTI filter handle to operate on complex cube.
+ *
+ * The handle can be used with \ref ifx_2dmti_run_cube_c. If slices is 1 it
+ * can also be used with \ref ifx_2dmti_run_c.
+ *
+ * @param [in]     alpha_mti_filter    Scalar for 2D MTI Filter parameter. Valid range [0.0, 1.0]
+ * @param [in]     rows                Number of rows of cube used within 2D MTI filter
+ * @param [in]     columns             Number of columns of cube used within 2D MTI filter
+ * @param [in]     slices              Number of slices of cube used within 2D MTI filter
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_2DMTI_C_t* ifx_2dmti_create_cube_c(ifx_Float_t alpha_mti_filter,
+                                       uint32_t rows,
+                                       uint32_t columns,
+                                       uint32_t slices);
+
 /**
  * @brief Destroys the 2D MTI filter handle for real Matrix.
  *
@@ -174,6 +219,36 @@ void ifx_2dmti_run_c(ifx_2DMTI_C_t* handle,
                      const ifx_Matrix_C_t* input,
                      ifx_Matrix_C_t* output);
 
+/**
+ * @brief Removes static parts from real cube using 2D MTI filtering.
+ *
+ * All slices are filtered in one pass. Input and output may be the same cube.
+ *
+ * @param [in]     handle    A handle to the 2D MTI filter to operate on real cube
+ * @param [in]     input     Real value cube used as an input for 2D MTI filter
+ * @param [out]    output    Real value cube used as an output of 2D MTI filter
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_2dmti_run_cube_r(ifx_2DMTI_R_t* handle,
+                          const ifx_Cube_R_t* input,
+                          ifx_Cube_R_t* output);
+
+/**
+ * @brief Removes static parts from complex cube using 2D MTI filtering.
+ *
+ * All slices are filtered in one pass. Input and output may be the same cube.
+ *
+ * @param [in]     handle    A handle to the 2D MTI filter to operate on complex cube
+ * @param [in]     input     Complex value cube used as an input for 2D MTI filter
+ * @param [out]    output    Complex value cube used as an output of 2D MTI filter
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_2dmti_run_cube_c(ifx_2DMTI_C_t* handle,
+                          const ifx_Cube_C_t* input,
+                          ifx_Cube_C_t* output);
+
 /**
  * @brief Runtime modification of 2D MTI filter scalar coefficient on real matrix.
  *
@@ -224,6 +299,90 @@ void ifx_2dmti_set_filter_coeff_c(ifx_2DMTI_C_t* handle,
 IFX_DLL_PUBLIC
 ifx_Float_t ifx_2dmti_get_filter_coeff_c(ifx_2DMTI_C_t* handle);
 
+/**
+ * @brief Selects the clutter removal filter on real data.
+ *
+ * Changing the type resets the filter history.
+ *
+ * @param [in]     handle    A handle to the 2D MTI filter for real operation
+ * @param [in]     type      Filter type, see \ref ifx_MTI_Type_t
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_2dmti_set_type_r(ifx_2DMTI_R_t* handle,
+                          ifx_MTI_Type_t type);
+
+/**
+ * @brief Selects the clutter removal filter on complex data.
+ *
+ * Changing the type resets the filter history.
+ *
+ * @param [in]     handle    A handle to the 2D MTI filter for complex operation
+ * @param [in]     type      Filter type, see \ref ifx_MTI_Type_t
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_2dmti_set_type_c(ifx_2DMTI_C_t* handle,
+                          ifx_MTI_Type_t type);
+
+/**
+ * @brief Sets a filter coefficient per row on real data.
+ *
+ * Used by \ref IFX_MTI_TYPE_EXPONENTIAL instead of the scalar coefficient,
+ * e.g., to adapt faster to clutter close to the sensor. Pass NULL to use
+ * the scalar coefficient again.
+ *
+ * @param [in]     handle    A handle to the 2D MTI filter for real operation
+ * @param [in]     alpha     Coefficient per row, valid range [0.0, 1.0], or NULL
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_2dmti_set_alpha_per_row_r(ifx_2DMTI_R_t* handle,
+                                   const ifx_Vector_R_t* alpha);
+
+/**
+ * @brief Sets a filter coefficient per row on complex data.
+ *
+ * Used by \ref IFX_MTI_TYPE_EXPONENTIAL instead of the scalar coefficient,
+ * e.g., to adapt faster to clutter close to the sensor. Pass NULL to use
+ * the scalar coefficient again.
+ *
+ * @param [in]     handle    A handle to the 2D MTI filter for complex operation
+ * @param [in]     alpha     Coefficient per row, valid range [0.0, 1.0], or NULL
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_2dmti_set_alpha_per_row_c(ifx_2DMTI_C_t* handle,
+                                   const ifx_Vector_R_t* alpha);
+
+/**
+ * @brief Updates the filter history only every n-th run on real data.
+ *
+ * The clutter estimate changes slowly, so with high frame rates the history
+ * update can be skipped for most frames. Every run still produces output.
+ *
+ * @param [in]     handle        A handle to the 2D MTI filter for real operation
+ * @param [in]     decimation    Update interval in runs (0 and 1 update every run)
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_2dmti_set_decimation_r(ifx_2DMTI_R_t* handle,
+                                uint32_t decimation);
+
+/**
+ * @brief Updates the filter history only every n-th run on complex data.
+ *
+ * The clutter estimate changes slowly, so with high frame rates the history
+ * update can be skipped for most frames. Every run still produces output.
+ *
+ * @param [in]     handle        A handle to the 2D MTI filter for complex operation
+ * @param [in]     decimation    Update interval in runs (0 and 1 update every run)
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_2dmti_set_decimation_c(ifx_2DMTI_C_t* handle,
+                                uint32_t decimation);
+
 /**
  * @}
  */
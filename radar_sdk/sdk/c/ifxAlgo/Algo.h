@@ -49,6 +49,8 @@
 #include <ifxAlgo/2DMTI.h>
 #include <ifxAlgo/DBSCAN.h>
 #include <ifxAlgo/FFT.h>
+#include <ifxAlgo/FFTQ15.h>
+#include <ifxAlgo/Inference.h>
 #include <ifxAlgo/MTI.h>
 #include <ifxAlgo/OSCFAR.h>
 #include <ifxAlgo/PreprocessedFFT.h>
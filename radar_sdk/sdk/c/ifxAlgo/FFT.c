@@ -33,7 +33,9 @@
 
 #include "ifxBase/Complex.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/Cache.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Metrics.h"
 #include "ifxBase/Math.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
@@ -50,6 +52,12 @@
 // For muFFT the data must be aligned to 32bytes boundary
 #define MUFFT_REQUIRED_ALIGNMENT (32U)
 
+// muFFT planning flags
+// TODO: Info: "NO_AVX seems to be faster for small transforms, maybe even NO_SSE3" - to be aligned with smart-tv
+// Plans are shared and every handle brings its own scratch buffer, so the
+// plans do not need one.
+#define MUFFT_FLAGS (MUFFT_FLAG_CPU_NO_AVX | MUFFT_FLAG_NO_TMP_BUFFER)
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -67,16 +75,58 @@ struct ifx_FFT_s
     ifx_Complex_t* zero_pad_fft_input_c; /**< Container to store complex zero padded FFT input
                                             in case fft_type is \ref IFX_FFT_TYPE_C2C. Otherwise ignored.*/
     ifx_Complex_t* fft_output_c;         /**< Container to store complex input FFT with half output use case.*/
-    mufft_plan_1d* plan_r2c;             /**< muFFT plan .*/
-    mufft_plan_1d* plan_c2c;             /**< muFFT plan .*/
+    ifx_Complex_t* tmp_buffer;           /**< Scratch buffer of muFFT, one per handle because the plan is shared.*/
+    const mufft_plan_1d* plan;           /**< Shared muFFT plan for fft_type, see \ref acquire_plan.*/
 };
 
+/**
+ * @brief Key of a muFFT plan in the cache.
+ *
+ * The flags select the instruction sets muFFT may use, so plans for
+ * different instruction sets are kept apart.
+ */
+typedef struct
+{
+    uint32_t fft_type; /**< FFT type defined by \ref ifx_FFT_Type_t.*/
+    uint32_t fft_size; /**< FFT size.*/
+    uint32_t flags;    /**< muFFT planning flags.*/
+} Plan_Key_t;
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
 ==============================================================================
 */
 
+static void* create_plan(const void* key)
+{
+    const Plan_Key_t* k = key;
+
+    if (k->fft_type == IFX_FFT_TYPE_C2C)
+        return mufft_create_plan_1d_c2c(k->fft_size, MUFFT_FORWARD, k->flags);
+    else
+        return mufft_create_plan_1d_r2c(k->fft_size, k->flags);
+}
+
+static void destroy_plan(void* plan)
+{
+    mufft_free_plan_1d(plan);
+}
+
+/** @brief Returns a shared muFFT plan
+ *
+ * muFFT plans only hold twiddle factors and the sequence of passes once they
+ * are created, so handles with the same FFT type and size share one plan
+ * from the process-wide cache. The plan is executed with the scratch buffer
+ * of the handle, which makes concurrent use of a shared plan safe.
+ */
+static const mufft_plan_1d* acquire_plan(ifx_FFT_Type_t fft_type, uint32_t fft_size)
+{
+    const Plan_Key_t key = {fft_type, fft_size, MUFFT_FLAGS};
+    return ifx_cache_acquire(&key, sizeof(key), create_plan, destroy_plan);
+}
+
+
 /** @brief Copy vector to zero padded buffer
  *
  * Copy at most fft_size elements of the vector input to buffer. If the length
@@ -154,13 +204,11 @@ ifx_FFT_t* ifx_fft_create(ifx_FFT_Type_t fft_type,
     h->zero_pad_fft_input_c = ifx_mem_aligned_alloc(fft_size * sizeof(ifx_Complex_t), MUFFT_REQUIRED_ALIGNMENT);
     IFX_ERR_BRF_MEMALLOC(h->zero_pad_fft_input_c);
 
-    // TODO: Info: "NO_AVX seems to be faster for small transforms, maybe even NO_SSE3" - to be aligned with smart-tv
-    const unsigned int flags = MUFFT_FLAG_CPU_NO_AVX;
-    h->plan_c2c = mufft_create_plan_1d_c2c(fft_size, MUFFT_FORWARD, flags);
-    IFX_ERR_BRF_MEMALLOC(h->plan_c2c);
+    h->tmp_buffer = ifx_mem_aligned_alloc(fft_size * sizeof(ifx_Complex_t), MUFFT_REQUIRED_ALIGNMENT);
+    IFX_ERR_BRF_MEMALLOC(h->tmp_buffer);
 
-    h->plan_r2c = mufft_create_plan_1d_r2c(fft_size, flags);
-    IFX_ERR_BRF_MEMALLOC(h->plan_r2c);
+    h->plan = acquire_plan(fft_type, fft_size);
+    IFX_ERR_BRF_MEMALLOC(h->plan);
 
     return h;
 
@@ -179,8 +227,9 @@ void ifx_fft_destroy(ifx_FFT_t* handle)
     ifx_mem_aligned_free(handle->fft_output_c);
     ifx_mem_aligned_free(handle->zero_pad_fft_input_c);
 
-    mufft_free_plan_1d(handle->plan_c2c);
-    mufft_free_plan_1d(handle->plan_r2c);
+    ifx_mem_aligned_free(handle->tmp_buffer);
+
+    ifx_cache_release(handle->plan);
 
     ifx_mem_free(handle);
 }
@@ -201,7 +250,13 @@ void ifx_fft_raw_c(ifx_FFT_t* handle, const ifx_Complex_t* in, ifx_Complex_t* ou
 
 void ifx_fft_raw_rc(ifx_FFT_t* handle, const ifx_Float_t* in, ifx_Complex_t* out)
 {
-    mufft_execute_plan_1d(handle->plan_r2c, out, in);
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(in);
+    IFX_ERR_BRK_NULL(out);
+    // the handle only holds the plan of its own type
+    IFX_ERR_BRK_COND(handle->fft_type != IFX_FFT_TYPE_R2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_REAL);
+
+    mufft_execute_plan_1d_with_buffer(handle->plan, out, in, handle->tmp_buffer);
 }
 
 //----------------------------------------------------------------------------
@@ -214,6 +269,8 @@ void ifx_fft_run_rc(ifx_FFT_t* handle, const ifx_Vector_R_t* input, ifx_Vector_C
     IFX_VEC_BRK_MINSIZE(output, handle->fft_size / 2);  // Half spectrum output supported
     IFX_ERR_BRK_COND(handle->fft_type != IFX_FFT_TYPE_R2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_REAL);
 
+    const uint64_t metrics_start = ifx_metrics_begin();
+
     // FFT size
     const uint32_t N = handle->fft_size;
 
@@ -242,7 +299,7 @@ void ifx_fft_run_rc(ifx_FFT_t* handle, const ifx_Vector_R_t* input, ifx_Vector_C
                              : vDat(output);
 
     // compute FFT
-    mufft_execute_plan_1d(handle->plan_r2c, out, in);
+    mufft_execute_plan_1d_with_buffer(handle->plan, out, in, handle->tmp_buffer);
 
     // fill negative half if required
     fill_negative_half(out, vLen(output), N);
@@ -262,6 +319,8 @@ void ifx_fft_run_rc(ifx_FFT_t* handle, const ifx_Vector_R_t* input, ifx_Vector_C
         for (uint32_t i = 0; i < len; i++)
             vAt(output, i) = out[i];
     }
+
+    ifx_metrics_end(IFX_METRICS_STAGE_FFT, metrics_start);
 }
 
 //----------------------------------------------------------------------------
@@ -274,6 +333,8 @@ void ifx_fft_run_c(ifx_FFT_t* handle, const ifx_Vector_C_t* input, ifx_Vector_C_
     IFX_VEC_BRK_MINSIZE(output, handle->fft_size);
     IFX_ERR_BRK_COND(handle->fft_type != IFX_FFT_TYPE_C2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_REAL);
 
+    const uint64_t metrics_start = ifx_metrics_begin();
+
     // FFT size
     const uint32_t N = handle->fft_size;
 
@@ -302,14 +363,16 @@ void ifx_fft_run_c(ifx_FFT_t* handle, const ifx_Vector_C_t* input, ifx_Vector_C_
 
     if (copy_output)
     {
-        mufft_execute_plan_1d(handle->plan_c2c, handle->fft_output_c, in);
+        mufft_execute_plan_1d_with_buffer(handle->plan, handle->fft_output_c, in, handle->tmp_buffer);
 
         // Do not use memcpy here because of a potential stride != 1
         for (uint32_t i = 0; i < N; i++)
             vAt(output, i) = handle->fft_output_c[i];
     }
     else
-        mufft_execute_plan_1d(handle->plan_c2c, vDat(output), in);
+        mufft_execute_plan_1d_with_buffer(handle->plan, vDat(output), in, handle->tmp_buffer);
+
+    ifx_metrics_end(IFX_METRICS_STAGE_FFT, metrics_start);
 }
 
 //----------------------------------------------------------------------------
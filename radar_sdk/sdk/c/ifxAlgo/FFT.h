@@ -140,6 +140,10 @@ typedef enum
  *
  * fft_size must be a power of 2, and 4 <= fft_size <= 65536.
  *
+ * FFT objects with the same type and size share their twiddle tables, which
+ * are only computed for the first object. Each object has its own buffers,
+ * so different objects can be used concurrently from different threads.
+ *
  * @param [in]     fft_type  FFT type, see \ref ifx_FFT_Type_t.
  * @param [in]     fft_size  FFT size \f$N\f$
  *
@@ -269,6 +273,8 @@ ifx_FFT_Type_t ifx_fft_get_fft_type(const ifx_FFT_t* handle);
  * @param [in]     handle    A handle to the FFT object
  * @param [in]     in        Pointer to array of floats, size must be the configured FFT size.
  * @param [out]    out       Pointer to output array of complex floats, size is half the configured FFT size.
+ *
+ * The FFT handle must be of type \ref IFX_FFT_TYPE_R2C.
  */
 IFX_DLL_PUBLIC
 void ifx_fft_raw_rc(ifx_FFT_t* handle, const ifx_Float_t* in, ifx_Complex_t* out);
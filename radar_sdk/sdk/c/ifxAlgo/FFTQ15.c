@@ -0,0 +1,358 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "ifxAlgo/FFTQ15.h"
+
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/internal/SimdFixed.h"
+#include "ifxBase/Math.h"
+#include "ifxBase/Mem.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// Maximum supported FFT size
+#define FFT_Q15_MAX_SIZE (65536U)
+
+// Largest value before a radix-2 stage that cannot overflow: a butterfly
+// grows each real and imaginary part by at most a factor of 1 + sqrt(2).
+#define FFT_Q15_HEADROOM_LIMIT (13500)
+
+// Twiddle factors are computed in double precision
+#define FFT_Q15_PI (3.14159265358979323846)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+struct ifx_FFT_Q15_s
+{
+    ifx_FFT_Type_t fft_type; /**< FFT type defined by \ref ifx_FFT_Type_t.*/
+    uint32_t fft_size;       /**< FFT size N.*/
+    uint32_t size;           /**< Size of the complex transform (N/2 for IFX_FFT_TYPE_R2C).*/
+    uint32_t* bitrev;        /**< Bit reversed index for each of the size input samples.*/
+    int16_t* twiddles;       /**< Twiddle factors of all stages, the stage with butterfly distance h
+                                  starts at 4 * (h - 1), see \ref ifx_Simd_Fixed_Kernels_t::bfly_q15.*/
+    int16_t* split;          /**< (re, im) of exp(-2 pi i k / N) for the real FFT post-processing.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static int16_t to_q15(double x);
+
+static int32_t abs_q15(int16_t x);
+
+static uint32_t stage_shift(int32_t max);
+
+static int32_t transform(ifx_FFT_Q15_t* handle, const int16_t* input, uint32_t count, int16_t* output, int32_t* max);
+
+static void split_bin(const int16_t* a, const int16_t* b, const int16_t* w, uint32_t shift, int16_t* x);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static int16_t to_q15(double x)
+{
+    const long q = lround(x * 32768);
+    // +1 is not representable; -32768 is avoided so that negating stays exact
+    return (int16_t)((q > INT16_MAX) ? INT16_MAX : ((q < -INT16_MAX) ? -INT16_MAX : q));
+}
+
+//----------------------------------------------------------------------------
+
+static int32_t abs_q15(int16_t x)
+{
+    return (x >= 0) ? x : -(int32_t)x;
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t stage_shift(int32_t max)
+{
+    uint32_t shift = 0;
+    while (((max + (1 << shift) / 2) >> shift) > FFT_Q15_HEADROOM_LIMIT)
+        shift++;
+    return shift;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Complex block floating point FFT of size handle->size
+ *
+ * The count input values are read as interleaved complex samples, an odd
+ * count leaves the imaginary part of the last sample zero. Small inputs are
+ * scaled up so that the largest value is in (LIMIT/2, LIMIT] while they are
+ * written in bit reversed order to output. Larger inputs are scaled down by
+ * the first radix-2 stage.
+ *
+ * @param [out]    max       Largest absolute value of the output
+ * @return block exponent of the output
+ */
+static int32_t transform(ifx_FFT_Q15_t* handle, const int16_t* input, uint32_t count, int16_t* output, int32_t* max)
+{
+    const uint32_t n = handle->size;
+    const ifx_Simd_Fixed_Kernels_t* kernels = ifx_simd_fixed_kernels();
+
+    memset(output, 0, 2 * n * sizeof(int16_t));
+
+    int32_t m = 0;
+    for (uint32_t i = 0; i < count; i++)
+        m = MAX(m, abs_q15(input[i]));
+
+    *max = 0;
+    if (m == 0)
+        return 0;
+
+    int32_t exponent = 0;
+    while (2 * m <= FFT_Q15_HEADROOM_LIMIT)
+    {
+        m *= 2;
+        exponent--;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+        output[2 * handle->bitrev[i >> 1] + (i & 1)] = (int16_t)(input[i] * (1 << -exponent));
+
+    for (uint32_t h = 1; h < n; h *= 2)
+    {
+        const uint32_t shift = stage_shift(m);
+        const int16_t* w = &handle->twiddles[4 * (h - 1)];
+
+        exponent += shift;
+        m = kernels->bfly_q15(output, w, shift, h, n);
+    }
+
+    *max = m;
+    return exponent;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Computes one bin of the real FFT from the half size complex FFT
+ *
+ * With A = a and B = conj(b) (a = Z[k], b = Z[n-k])
+ * x = ((A + B) - i * w * (A - B)) / 2^(1 + shift).
+ */
+static void split_bin(const int16_t* a, const int16_t* b, const int16_t* w, uint32_t shift, int16_t* x)
+{
+    const int64_t a_re = a[0];
+    const int64_t a_im = a[1];
+    const int64_t b_re = b[0];
+    const int64_t b_im = -b[1];
+
+    const int64_t s_re = a_re + b_re;
+    const int64_t s_im = a_im + b_im;
+    const int64_t d_re = a_re - b_re;
+    const int64_t d_im = a_im - b_im;
+
+    // Q15 twiddle, division by 2 and block scaling
+    const uint32_t bits = 16 + shift;
+    const int64_t round = (int64_t)1 << (bits - 1);
+    x[0] = (int16_t)((s_re * 32768 + w[0] * d_im + w[1] * d_re + round) >> bits);
+    x[1] = (int16_t)((s_im * 32768 + w[1] * d_im - w[0] * d_re + round) >> bits);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_FFT_Q15_t* ifx_fft_q15_create(ifx_FFT_Type_t fft_type, uint32_t fft_size)
+{
+    IFX_ERR_BRN_ARGUMENT((fft_type != IFX_FFT_TYPE_R2C) && (fft_type != IFX_FFT_TYPE_C2C));
+
+    int fft_size_error = !ifx_math_ispower_of_2(fft_size);
+    IFX_ERR_BRN_ARGUMENT(fft_size_error || (fft_size < 4) || (fft_size > FFT_Q15_MAX_SIZE));
+
+    ifx_FFT_Q15_t* h = ifx_mem_calloc(1, sizeof(struct ifx_FFT_Q15_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->fft_type = fft_type;
+    h->fft_size = fft_size;
+    h->size = (fft_type == IFX_FFT_TYPE_R2C) ? fft_size / 2 : fft_size;
+
+    const uint32_t n = h->size;
+
+    h->bitrev = ifx_mem_calloc(n, sizeof(uint32_t));
+    IFX_ERR_BRF_MEMALLOC(h->bitrev);
+
+    uint32_t bits = 0;
+    while ((1U << bits) < n)
+        bits++;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t r = 0;
+        for (uint32_t b = 0; b < bits; b++)
+            r |= ((i >> b) & 1U) << (bits - 1 - b);
+        h->bitrev[i] = r;
+    }
+
+    // stage with butterfly distance d: exp(-2 pi i k / (2 d)) for k < d
+    h->twiddles = ifx_mem_calloc(4 * (size_t)n, sizeof(int16_t));
+    IFX_ERR_BRF_MEMALLOC(h->twiddles);
+
+    for (uint32_t d = 1; d < n; d *= 2)
+    {
+        int16_t* w = &h->twiddles[4 * (d - 1)];
+        for (uint32_t k = 0; k < d; k++)
+        {
+            const double phi = -FFT_Q15_PI * k / d;
+            const int16_t re = to_q15(cos(phi));
+            const int16_t im = to_q15(sin(phi));
+            w[4 * k] = re;
+            w[4 * k + 1] = (int16_t)-im;
+            w[4 * k + 2] = im;
+            w[4 * k + 3] = re;
+        }
+    }
+
+    if (fft_type == IFX_FFT_TYPE_R2C)
+    {
+        h->split = ifx_mem_calloc(2 * (size_t)n, sizeof(int16_t));
+        IFX_ERR_BRF_MEMALLOC(h->split);
+
+        for (uint32_t k = 0; k < n; k++)
+        {
+            const double phi = -2 * FFT_Q15_PI * k / fft_size;
+            h->split[2 * k] = to_q15(cos(phi));
+            h->split[2 * k + 1] = to_q15(sin(phi));
+        }
+    }
+
+    return h;
+
+fail:
+    ifx_fft_q15_destroy(h);
+    return NULL;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_q15_destroy(ifx_FFT_Q15_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_mem_free(handle->bitrev);
+    ifx_mem_free(handle->twiddles);
+    ifx_mem_free(handle->split);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+int32_t ifx_fft_q15_run_rc(ifx_FFT_Q15_t* handle, const int16_t* input, uint32_t len, int16_t* output)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+    IFX_ERR_BRV_NULL(input, 0);
+    IFX_ERR_BRV_NULL(output, 0);
+    IFX_ERR_BRV_ARGUMENT(handle->fft_type != IFX_FFT_TYPE_R2C, 0);
+    IFX_ERR_BRV_ARGUMENT(len > handle->fft_size, 0);
+
+    const uint32_t n = handle->size;
+
+    int32_t max;
+    int32_t exponent = transform(handle, input, len, output, &max);
+
+    // the post-processing grows the values like one radix-2 stage
+    const uint32_t shift = stage_shift(max);
+    exponent += shift;
+
+    int16_t x[2];
+    split_bin(&output[0], &output[0], &handle->split[0], shift, x);
+    output[0] = x[0];
+    output[1] = x[1];
+
+    for (uint32_t k = 1; k <= n / 2; k++)
+    {
+        int16_t y[2];
+        split_bin(&output[2 * k], &output[2 * (n - k)], &handle->split[2 * k], shift, x);
+        split_bin(&output[2 * (n - k)], &output[2 * k], &handle->split[2 * (n - k)], shift, y);
+        output[2 * k] = x[0];
+        output[2 * k + 1] = x[1];
+        output[2 * (n - k)] = y[0];
+        output[2 * (n - k) + 1] = y[1];
+    }
+
+    return exponent;
+}
+
+//----------------------------------------------------------------------------
+
+int32_t ifx_fft_q15_run_c(ifx_FFT_Q15_t* handle, const int16_t* input, uint32_t len, int16_t* output)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+    IFX_ERR_BRV_NULL(input, 0);
+    IFX_ERR_BRV_NULL(output, 0);
+    IFX_ERR_BRV_ARGUMENT(handle->fft_type != IFX_FFT_TYPE_C2C, 0);
+    IFX_ERR_BRV_ARGUMENT(len > handle->fft_size, 0);
+
+    int32_t max;
+    return transform(handle, input, 2 * len, output, &max);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_fft_q15_get_fft_size(const ifx_FFT_Q15_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+
+    return handle->fft_size;
+}
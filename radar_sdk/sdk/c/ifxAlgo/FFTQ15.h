@@ -0,0 +1,186 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file FFTQ15.h
+ *
+ * \brief \copybrief gr_fft_q15
+ *
+ * For details refer to \ref gr_fft_q15
+ */
+
+#ifndef IFX_ALGO_FFT_Q15_H
+#define IFX_ALGO_FFT_Q15_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Types.h"
+
+#include "ifxAlgo/FFT.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief A handle for an instance of the fixed-point FFT module, see FFTQ15.h.
+ */
+typedef struct ifx_FFT_Q15_s ifx_FFT_Q15_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Algorithms
+ * @{
+ */
+
+/** @defgroup gr_fft_q15 Fixed-point FFT
+ * @brief API for a block floating point FFT on 16-bit data
+ *
+ * Computes the same unnormalized DFT as \ref gr_fft on Q15 data, i.e.
+ * signed 16-bit integers where the value \f$q\f$ represents \f$q/2^{15}\f$.
+ * Complex values are stored interleaved as (real, imaginary) pairs.
+ *
+ * The transform uses block floating point arithmetic: all values of one
+ * transform share a common exponent \f$e\f$. The input is normalized to
+ * leave enough headroom for one radix-2 stage, and before each stage the
+ * block is scaled down by 1, 2 or 4 depending on the largest value of the
+ * previous stage. The exponent returned by the run functions accounts for
+ * all scalings, so the DFT in units of the input is
+ * \f$\hat{a}_k = q_k \cdot 2^{e}\f$.
+ *
+ * This keeps close to 16 bits of precision relative to the largest output
+ * value regardless of the signal level, while all butterflies run on 16-bit
+ * SIMD lanes. Values much smaller than the largest one of a block lose
+ * precision, which limits the dynamic range of a single transform to about
+ * 90dB.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a fixed-point FFT object
+ *
+ * fft_size must be a power of 2, and 4 <= fft_size <= 65536.
+ *
+ * @param [in]     fft_type  FFT type, see \ref ifx_FFT_Type_t.
+ * @param [in]     fft_size  FFT size \f$N\f$
+ *
+ * @return Handle to the FFT object or NULL in case of failure
+ */
+IFX_DLL_PUBLIC
+ifx_FFT_Q15_t* ifx_fft_q15_create(ifx_FFT_Type_t fft_type, uint32_t fft_size);
+
+/**
+ * @brief Destroys a fixed-point FFT object
+ *
+ * @param [in]     handle    FFT object
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_q15_destroy(ifx_FFT_Q15_t* handle);
+
+/**
+ * @brief Performs the FFT of a real Q15 input
+ *
+ * The input of length len is zero padded to the FFT size \f$N\f$. The
+ * \f$N/2\f$ complex frequency samples \f$\hat{a}_0 \dots \hat{a}_{N/2-1}\f$
+ * are written interleaved to output. The FFT object must have been created
+ * with \ref IFX_FFT_TYPE_R2C.
+ *
+ * @param [in]     handle    FFT object
+ * @param [in]     input     Real input samples
+ * @param [in]     len       Number of input samples, at most \f$N\f$
+ * @param [out]    output    \f$N\f$ values, must not overlap with input
+ *
+ * @return Block exponent \f$e\f$ of output
+ */
+IFX_DLL_PUBLIC
+int32_t ifx_fft_q15_run_rc(ifx_FFT_Q15_t* handle, const int16_t* input, uint32_t len, int16_t* output);
+
+/**
+ * @brief Performs the FFT of a complex Q15 input
+ *
+ * The input of len complex samples is zero padded to the FFT size \f$N\f$.
+ * The FFT object must have been created with \ref IFX_FFT_TYPE_C2C.
+ *
+ * @param [in]     handle    FFT object
+ * @param [in]     input     Interleaved complex input samples
+ * @param [in]     len       Number of complex input samples, at most \f$N\f$
+ * @param [out]    output    \f$2N\f$ values, must not overlap with input
+ *
+ * @return Block exponent \f$e\f$ of output
+ */
+IFX_DLL_PUBLIC
+int32_t ifx_fft_q15_run_c(ifx_FFT_Q15_t* handle, const int16_t* input, uint32_t len, int16_t* output);
+
+/**
+ * @brief Returns the FFT size of the FFT object
+ *
+ * @param [in]     handle    FFT object
+ *
+ * @return FFT size \f$N\f$
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_fft_q15_get_fft_size(const ifx_FFT_Q15_t* handle);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_ALGO_FFT_Q15_H */
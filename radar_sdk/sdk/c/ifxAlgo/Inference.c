@@ -0,0 +1,1087 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ifxAlgo/Inference.h"
+
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Simd.h"
+#include "ifxBase/internal/SimdFixed.h"
+#include "ifxBase/Mem.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define MODEL_HEADER_SIZE 32
+#define LAYER_HEADER_SIZE 36
+#define NUM_PARAMS        6
+
+// Alignment of the weights and activation buffers
+#define BUFFER_ALIGNMENT 64
+
+// Upper bound for the number of elements of a tensor and for each
+// dimension, keeps all offsets well within 32 bits
+#define MAX_TENSOR_SIZE (1u << 26)
+#define MAX_DIMENSION   (1u << 16)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+typedef struct
+{
+    ifx_Inference_Layer_Type_t type;
+    ifx_Inference_Activation_t activation;
+    ifx_Inference_Shape_t in;  /**< Shape of the input tensor.*/
+    ifx_Inference_Shape_t out; /**< Shape of the output tensor.*/
+
+    uint32_t kernel_h; /**< Kernel (or pool) height.*/
+    uint32_t kernel_w; /**< Kernel (or pool) width.*/
+    uint32_t stride_h; /**< Vertical stride.*/
+    uint32_t stride_w; /**< Horizontal stride.*/
+    uint32_t pad_top;  /**< Padding rows above the input.*/
+    uint32_t pad_left; /**< Padding columns left of the input.*/
+
+    const float* weights;   /**< Float weights, for affine layers the scales.*/
+    const float* bias;      /**< Float bias, for affine layers the shifts.*/
+    const int8_t* weights_q; /**< Quantized weights.*/
+    const int32_t* bias_q;  /**< Quantized bias.*/
+
+    float in_scale;   /**< Scale of the input tensor (int8 models).*/
+    float out_scale;  /**< Scale of the output tensor (int8 models).*/
+    float* requant;   /**< Per output channel requantization factors (int8 models),
+                           affine layers store factor and offset.*/
+} Layer_t;
+
+/**
+ * @brief Defines the structure for the inference module.
+ *        Use type ifx_Inference_t for this struct.
+ */
+struct ifx_Inference_s
+{
+    ifx_Inference_Data_Type_t data_type; /**< Data type of weights and activations.*/
+    ifx_Inference_Shape_t input_shape;   /**< Shape of the input tensor.*/
+    uint32_t output_size;                /**< Number of output values.*/
+    float input_scale;                   /**< Scale used to quantize the input (int8 models).*/
+    uint32_t num_layers;                 /**< Number of layers.*/
+    Layer_t* layers;                     /**< Layers in order of execution.*/
+    void* model;                         /**< Aligned copy of the model, weights point into it.*/
+    void* arena[2];                      /**< Activation buffers used in turn as input and output of a layer.*/
+    void* scratch;                       /**< Accumulators for one pixel of depthwise and pooling layers.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static uint32_t read_u32(const uint8_t* p);
+static uint16_t read_u16(const uint8_t* p);
+static float read_f32(const uint8_t* p);
+
+static uint32_t shape_size(const ifx_Inference_Shape_t* shape);
+static bool window_init(Layer_t* layer, const uint32_t* params);
+static size_t payload_size(const Layer_t* layer, ifx_Inference_Data_Type_t data_type);
+static bool layer_init(ifx_Inference_t* handle, Layer_t* layer, const uint8_t* header, const uint8_t* payload, size_t size);
+
+static int8_t quantize(float value, float lower);
+static void quantize_input(const ifx_Inference_t* handle, const float* input, int8_t* output);
+static void dequantize(const int8_t* x, float scale, float* y, size_t len);
+static void softmax(float* x, size_t len);
+
+static void conv2d_f32(const Layer_t* layer, const float* in, float* out);
+static void conv2d_s8(const Layer_t* layer, const int8_t* in, int8_t* out);
+static void depthwise_f32(const Layer_t* layer, const float* in, float* out, float* scratch);
+static void depthwise_s8(const Layer_t* layer, const int8_t* in, int8_t* out, int32_t* scratch);
+static void pool_f32(const Layer_t* layer, const float* in, float* out);
+static void pool_s8(const Layer_t* layer, const int8_t* in, int8_t* out, int32_t* scratch);
+static void dense_f32(const Layer_t* layer, const float* in, float* out);
+static void dense_s8(const Layer_t* layer, const int8_t* in, int8_t* out);
+static void affine_f32(const Layer_t* layer, const float* in, float* out);
+static void affine_s8(const Layer_t* layer, const int8_t* in, int8_t* out);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+// The model format is little endian like all supported platforms, memcpy
+// avoids unaligned accesses.
+static uint32_t read_u32(const uint8_t* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+//----------------------------------------------------------------------------
+
+static uint16_t read_u16(const uint8_t* p)
+{
+    uint16_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+//----------------------------------------------------------------------------
+
+static float read_f32(const uint8_t* p)
+{
+    float value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t shape_size(const ifx_Inference_Shape_t* shape)
+{
+    return shape->height * shape->width * shape->channels;
+}
+
+//----------------------------------------------------------------------------
+
+/*
+ * Computes output size and padding of a convolution or pooling layer from
+ * kernel height, kernel width, stride height, stride width and padding mode
+ * given in params. Returns false for invalid parameters.
+ */
+static bool window_init(Layer_t* layer, const uint32_t* params)
+{
+    layer->kernel_h = params[0];
+    layer->kernel_w = params[1];
+    layer->stride_h = params[2];
+    layer->stride_w = params[3];
+
+    if (layer->kernel_h == 0 || layer->kernel_w == 0 || layer->stride_h == 0 || layer->stride_w == 0)
+        return false;
+    if (layer->kernel_h > MAX_DIMENSION || layer->kernel_w > MAX_DIMENSION)
+        return false;
+
+    const uint32_t in_sizes[2] = {layer->in.height, layer->in.width};
+    const uint32_t kernels[2] = {layer->kernel_h, layer->kernel_w};
+    const uint32_t strides[2] = {layer->stride_h, layer->stride_w};
+    uint32_t out_sizes[2];
+    uint32_t pads[2];
+
+    for (int i = 0; i < 2; i++)
+    {
+        if (params[4] == IFX_INFERENCE_PADDING_SAME)
+        {
+            out_sizes[i] = (in_sizes[i] + strides[i] - 1) / strides[i];
+            const uint32_t needed = (out_sizes[i] - 1) * strides[i] + kernels[i];
+            pads[i] = (needed > in_sizes[i]) ? (needed - in_sizes[i]) / 2 : 0;
+        }
+        else if (params[4] == IFX_INFERENCE_PADDING_VALID)
+        {
+            if (in_sizes[i] < kernels[i])
+                return false;
+            out_sizes[i] = (in_sizes[i] - kernels[i]) / strides[i] + 1;
+            pads[i] = 0;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    layer->out.height = out_sizes[0];
+    layer->out.width = out_sizes[1];
+    layer->pad_top = pads[0];
+    layer->pad_left = pads[1];
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+static size_t payload_size(const Layer_t* layer, ifx_Inference_Data_Type_t data_type)
+{
+    size_t num_weights;
+    size_t num_outputs = layer->out.channels;
+
+    switch (layer->type)
+    {
+        case IFX_INFERENCE_LAYER_CONV2D:
+            num_weights = (size_t)layer->out.channels * layer->kernel_h * layer->kernel_w * layer->in.channels;
+            break;
+        case IFX_INFERENCE_LAYER_DEPTHWISE_CONV2D:
+            num_weights = (size_t)layer->kernel_h * layer->kernel_w * layer->in.channels;
+            break;
+        case IFX_INFERENCE_LAYER_DENSE:
+            num_weights = (size_t)layer->out.channels * shape_size(&layer->in);
+            break;
+        case IFX_INFERENCE_LAYER_AFFINE:
+            return 2 * num_outputs * sizeof(float);
+        default:
+            return 0;
+    }
+
+    if (data_type == IFX_INFERENCE_FLOAT32)
+        return (num_weights + num_outputs) * sizeof(float);
+
+    const size_t padded = (num_weights + 3) & ~(size_t)3;
+    return padded + num_outputs * (sizeof(int32_t) + sizeof(float));
+}
+
+//----------------------------------------------------------------------------
+
+/*
+ * Initializes a layer from its header and payload of size bytes. The input
+ * shape and input scale of the layer must be set. Returns false if the layer
+ * is invalid; an error is only set if memory allocation failed.
+ */
+static bool layer_init(ifx_Inference_t* handle, Layer_t* layer, const uint8_t* header, const uint8_t* payload, size_t size)
+{
+    uint32_t params[NUM_PARAMS];
+    for (int i = 0; i < NUM_PARAMS; i++)
+        params[i] = read_u32(header + 4 + 4 * i);
+
+    layer->type = (ifx_Inference_Layer_Type_t)read_u16(header);
+    layer->activation = (ifx_Inference_Activation_t)read_u16(header + 2);
+    layer->out = layer->in;
+    layer->out_scale = layer->in_scale;
+
+    if (layer->activation != IFX_INFERENCE_ACTIVATION_NONE && layer->activation != IFX_INFERENCE_ACTIVATION_RELU)
+        return false;
+
+    bool has_weights = false;
+
+    switch (layer->type)
+    {
+        case IFX_INFERENCE_LAYER_CONV2D:
+            if (params[0] == 0 || params[0] > MAX_DIMENSION || !window_init(layer, &params[1]))
+                return false;
+            layer->out.channels = params[0];
+            has_weights = true;
+            break;
+        case IFX_INFERENCE_LAYER_DEPTHWISE_CONV2D:
+            if (!window_init(layer, params))
+                return false;
+            has_weights = true;
+            break;
+        case IFX_INFERENCE_LAYER_MAXPOOL2D:
+        case IFX_INFERENCE_LAYER_AVGPOOL2D:
+            if (!window_init(layer, params))
+                return false;
+            break;
+        case IFX_INFERENCE_LAYER_GLOBAL_AVGPOOL:
+            // average pooling with a window covering the whole input
+            layer->kernel_h = layer->in.height;
+            layer->kernel_w = layer->in.width;
+            layer->stride_h = 1;
+            layer->stride_w = 1;
+            layer->out.height = 1;
+            layer->out.width = 1;
+            break;
+        case IFX_INFERENCE_LAYER_DENSE:
+            // like in Keras a dense layer on a 3D input would be applied per
+            // pixel, the converter inserts a flatten layer instead
+            if (layer->in.height != 1 || layer->in.width != 1)
+                return false;
+            if (params[0] == 0 || params[0] > MAX_TENSOR_SIZE)
+                return false;
+            layer->out.height = 1;
+            layer->out.width = 1;
+            layer->out.channels = params[0];
+            has_weights = true;
+            break;
+        case IFX_INFERENCE_LAYER_AFFINE:
+            has_weights = true;
+            break;
+        case IFX_INFERENCE_LAYER_FLATTEN:
+            layer->out.height = 1;
+            layer->out.width = 1;
+            layer->out.channels = shape_size(&layer->in);
+            break;
+        case IFX_INFERENCE_LAYER_SOFTMAX:
+            break;
+        default:
+            return false;
+    }
+
+    if ((uint64_t)layer->out.height * layer->out.width * layer->out.channels > MAX_TENSOR_SIZE)
+        return false;
+
+    if (size != payload_size(layer, handle->data_type))
+        return false;
+
+    if (!has_weights)
+        return true;
+
+    const uint32_t channels = layer->out.channels;
+
+    if (handle->data_type == IFX_INFERENCE_FLOAT32 || layer->type == IFX_INFERENCE_LAYER_AFFINE)
+    {
+        const size_t num_weights = payload_size(layer, IFX_INFERENCE_FLOAT32) / sizeof(float) - channels;
+        layer->weights = (const float*)payload;
+        layer->bias = layer->weights + num_weights;
+    }
+    else
+    {
+        const size_t padded = payload_size(layer, IFX_INFERENCE_INT8) - channels * (sizeof(int32_t) + sizeof(float));
+        layer->weights_q = (const int8_t*)payload;
+        layer->bias_q = (const int32_t*)(payload + padded);
+    }
+
+    if (handle->data_type == IFX_INFERENCE_FLOAT32)
+        return true;
+
+    layer->out_scale = read_f32(header + 4 + 4 * NUM_PARAMS);
+    if (!(layer->out_scale > 0 && layer->out_scale < FLT_MAX))
+        return false;
+
+    const uint32_t num_requant = (layer->type == IFX_INFERENCE_LAYER_AFFINE) ? 2 * channels : channels;
+    layer->requant = ifx_mem_alloc(num_requant * sizeof(float));
+    if (layer->requant == NULL)
+    {
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return false;
+    }
+
+    if (layer->type == IFX_INFERENCE_LAYER_AFFINE)
+    {
+        // y_q = x_q * in_scale * scale / out_scale + shift / out_scale
+        for (uint32_t c = 0; c < channels; c++)
+        {
+            layer->requant[c] = layer->in_scale * layer->weights[c] / layer->out_scale;
+            layer->requant[channels + c] = layer->bias[c] / layer->out_scale;
+        }
+    }
+    else
+    {
+        // y_q = (sum(x_q * w_q) + b_q) * in_scale * w_scale / out_scale
+        const float* weight_scales = (const float*)(layer->bias_q + channels);
+        for (uint32_t c = 0; c < channels; c++)
+        {
+            if (!(weight_scales[c] >= 0 && weight_scales[c] < FLT_MAX))
+                return false;
+            layer->requant[c] = layer->in_scale * weight_scales[c] / layer->out_scale;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+/*
+ * Rounds to the nearest integer (halves away from zero) and saturates to
+ * [lower, 127]. Infinities saturate, NaN maps to 0 (converting it to an
+ * integer would be undefined behavior).
+ */
+static int8_t quantize(float value, float lower)
+{
+    if (isnan(value))
+        return 0;
+    if (value >= 127.f)
+        return 127;
+    if (value <= lower)
+        return (int8_t)lower;
+    return (int8_t)((value >= 0) ? (int32_t)(value + 0.5f) : -(int32_t)(0.5f - value));
+}
+
+//----------------------------------------------------------------------------
+
+/*
+ * Quantizes the float input of an int8 model. If the first layer is an
+ * affine layer, it is applied before quantization.
+ */
+static void quantize_input(const ifx_Inference_t* handle, const float* input, int8_t* output)
+{
+    const Layer_t* first = &handle->layers[0];
+    const uint32_t channels = handle->input_shape.channels;
+    const uint32_t pixels = handle->input_shape.height * handle->input_shape.width;
+
+    if (first->type == IFX_INFERENCE_LAYER_AFFINE)
+    {
+        const float lower = (first->activation == IFX_INFERENCE_ACTIVATION_RELU) ? 0.f : -127.f;
+        for (uint32_t p = 0; p < pixels; p++)
+        {
+            for (uint32_t c = 0; c < channels; c++)
+                *output++ = quantize(*input++ * first->requant[c] + first->requant[channels + c], lower);
+        }
+        return;
+    }
+
+    const float scale = 1.f / handle->input_scale;
+    for (uint32_t i = 0; i < pixels * channels; i++)
+        output[i] = quantize(input[i] * scale, -127.f);
+}
+
+//----------------------------------------------------------------------------
+
+static void dequantize(const int8_t* x, float scale, float* y, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        y[i] = x[i] * scale;
+}
+
+//----------------------------------------------------------------------------
+
+static void softmax(float* x, size_t len)
+{
+    float max_value = x[0];
+    for (size_t i = 1; i < len; i++)
+        max_value = MAX(max_value, x[i]);
+
+    float sum = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        x[i] = expf(x[i] - max_value);
+        sum += x[i];
+    }
+
+    ifx_simd_kernels()->scale_r(x, 1.f / sum, x, len);
+}
+
+//----------------------------------------------------------------------------
+
+/*
+ * Convolutions process one output pixel at a time. For every kernel row the
+ * part of the input row inside the image is contiguous in NHWC layout and
+ * matches a contiguous part of the filter, so each row is a single dot
+ * product of (clipped) kernel width * input channels elements. Padding is
+ * never materialized.
+ */
+static void conv2d_f32(const Layer_t* layer, const float* in, float* out)
+{
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+    const uint32_t cin = layer->in.channels;
+    const uint32_t filters = layer->out.channels;
+    const size_t filter_size = (size_t)layer->kernel_h * layer->kernel_w * cin;
+
+    for (uint32_t oh = 0; oh < layer->out.height; oh++)
+    {
+        const int32_t ih0 = (int32_t)(oh * layer->stride_h) - (int32_t)layer->pad_top;
+        const uint32_t kh_begin = (ih0 < 0) ? (uint32_t)-ih0 : 0;
+        const uint32_t kh_end = MIN(layer->kernel_h, (uint32_t)((int32_t)layer->in.height - ih0));
+
+        for (uint32_t ow = 0; ow < layer->out.width; ow++)
+        {
+            const int32_t iw0 = (int32_t)(ow * layer->stride_w) - (int32_t)layer->pad_left;
+            const uint32_t kw_begin = (iw0 < 0) ? (uint32_t)-iw0 : 0;
+            const uint32_t kw_end = MIN(layer->kernel_w, (uint32_t)((int32_t)layer->in.width - iw0));
+            const size_t len = (size_t)(kw_end - kw_begin) * cin;
+
+            for (uint32_t f = 0; f < filters; f++)
+            {
+                const float* w = layer->weights + f * filter_size;
+                float acc = layer->bias[f];
+
+                for (uint32_t kh = kh_begin; kh < kh_end; kh++)
+                {
+                    const float* x = in + ((size_t)(ih0 + (int32_t)kh) * layer->in.width + (size_t)(iw0 + (int32_t)kw_begin)) * cin;
+                    acc += kernels->dot_r(x, w + ((size_t)kh * layer->kernel_w + kw_begin) * cin, len);
+                }
+
+                if (layer->activation == IFX_INFERENCE_ACTIVATION_RELU && acc < 0)
+                    acc = 0;
+                *out++ = acc;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void conv2d_s8(const Layer_t* layer, const int8_t* in, int8_t* out)
+{
+    const ifx_Simd_Fixed_Kernels_t* kernels = ifx_simd_fixed_kernels();
+    const uint32_t cin = layer->in.channels;
+    const uint32_t filters = layer->out.channels;
+    const size_t filter_size = (size_t)layer->kernel_h * layer->kernel_w * cin;
+    const float lower = (layer->activation == IFX_INFERENCE_ACTIVATION_RELU) ? 0.f : -127.f;
+
+    for (uint32_t oh = 0; oh < layer->out.height; oh++)
+    {
+        const int32_t ih0 = (int32_t)(oh * layer->stride_h) - (int32_t)layer->pad_top;
+        const uint32_t kh_begin = (ih0 < 0) ? (uint32_t)-ih0 : 0;
+        const uint32_t kh_end = MIN(layer->kernel_h, (uint32_t)((int32_t)layer->in.height - ih0));
+
+        for (uint32_t ow = 0; ow < layer->out.width; ow++)
+        {
+            const int32_t iw0 = (int32_t)(ow * layer->stride_w) - (int32_t)layer->pad_left;
+            const uint32_t kw_begin = (iw0 < 0) ? (uint32_t)-iw0 : 0;
+            const uint32_t kw_end = MIN(layer->kernel_w, (uint32_t)((int32_t)layer->in.width - iw0));
+            const size_t len = (size_t)(kw_end - kw_begin) * cin;
+
+            for (uint32_t f = 0; f < filters; f++)
+            {
+                const int8_t* w = layer->weights_q + f * filter_size;
+                int32_t acc = layer->bias_q[f];
+
+                for (uint32_t kh = kh_begin; kh < kh_end; kh++)
+                {
+                    const int8_t* x = in + ((size_t)(ih0 + (int32_t)kh) * layer->in.width + (size_t)(iw0 + (int32_t)kw_begin)) * cin;
+                    acc += kernels->dot_s8(x, w + ((size_t)kh * layer->kernel_w + kw_begin) * cin, len);
+                }
+
+                *out++ = quantize((float)acc * layer->requant[f], lower);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/*
+ * Depthwise convolutions and pooling accumulate whole pixels (all channels)
+ * at once, which vectorizes over the channels.
+ */
+static void depthwise_f32(const Layer_t* layer, const float* in, float* out, float* scratch)
+{
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+    const uint32_t channels = layer->in.channels;
+
+    for (uint32_t oh = 0; oh < layer->out.height; oh++)
+    {
+        const int32_t ih0 = (int32_t)(oh * layer->stride_h) - (int32_t)layer->pad_top;
+        const uint32_t kh_begin = (ih0 < 0) ? (uint32_t)-ih0 : 0;
+        const uint32_t kh_end = MIN(layer->kernel_h, (uint32_t)((int32_t)layer->in.height - ih0));
+
+        for (uint32_t ow = 0; ow < layer->out.width; ow++)
+        {
+            const int32_t iw0 = (int32_t)(ow * layer->stride_w) - (int32_t)layer->pad_left;
+            const uint32_t kw_begin = (iw0 < 0) ? (uint32_t)-iw0 : 0;
+            const uint32_t kw_end = MIN(layer->kernel_w, (uint32_t)((int32_t)layer->in.width - iw0));
+
+            memcpy(out, layer->bias, channels * sizeof(float));
+
+            for (uint32_t kh = kh_begin; kh < kh_end; kh++)
+            {
+                for (uint32_t kw = kw_begin; kw < kw_end; kw++)
+                {
+                    const float* x = in + ((size_t)(ih0 + (int32_t)kh) * layer->in.width + (size_t)(iw0 + (int32_t)kw)) * channels;
+                    kernels->mul_r(x, layer->weights + ((size_t)kh * layer->kernel_w + kw) * channels, scratch, channels);
+                    kernels->add_r(out, scratch, out, channels);
+                }
+            }
+
+            if (layer->activation == IFX_INFERENCE_ACTIVATION_RELU)
+                kernels->clip_r(out, 0, FLT_MAX, out, channels);
+            out += channels;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void depthwise_s8(const Layer_t* layer, const int8_t* in, int8_t* out, int32_t* scratch)
+{
+    const uint32_t channels = layer->in.channels;
+    const float lower = (layer->activation == IFX_INFERENCE_ACTIVATION_RELU) ? 0.f : -127.f;
+
+    for (uint32_t oh = 0; oh < layer->out.height; oh++)
+    {
+        const int32_t ih0 = (int32_t)(oh * layer->stride_h) - (int32_t)layer->pad_top;
+        const uint32_t kh_begin = (ih0 < 0) ? (uint32_t)-ih0 : 0;
+        const uint32_t kh_end = MIN(layer->kernel_h, (uint32_t)((int32_t)layer->in.height - ih0));
+
+        for (uint32_t ow = 0; ow < layer->out.width; ow++)
+        {
+            const int32_t iw0 = (int32_t)(ow * layer->stride_w) - (int32_t)layer->pad_left;
+            const uint32_t kw_begin = (iw0 < 0) ? (uint32_t)-iw0 : 0;
+            const uint32_t kw_end = MIN(layer->kernel_w, (uint32_t)((int32_t)layer->in.width - iw0));
+
+            memcpy(scratch, layer->bias_q, channels * sizeof(int32_t));
+
+            for (uint32_t kh = kh_begin; kh < kh_end; kh++)
+            {
+                for (uint32_t kw = kw_begin; kw < kw_end; kw++)
+                {
+                    const int8_t* x = in + ((size_t)(ih0 + (int32_t)kh) * layer->in.width + (size_t)(iw0 + (int32_t)kw)) * channels;
+                    const int8_t* w = layer->weights_q + ((size_t)kh * layer->kernel_w + kw) * channels;
+                    for (uint32_t c = 0; c < channels; c++)
+                        scratch[c] += (int32_t)x[c] * w[c];
+                }
+            }
+
+            for (uint32_t c = 0; c < channels; c++)
+                *out++ = quantize((float)scratch[c] * layer->requant[c], lower);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void pool_f32(const Layer_t* layer, const float* in, float* out)
+{
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+    const uint32_t channels = layer->in.channels;
+    const bool is_max = (layer->type == IFX_INFERENCE_LAYER_MAXPOOL2D);
+
+    for (uint32_t oh = 0; oh < layer->out.height; oh++)
+    {
+        const int32_t ih0 = (int32_t)(oh * layer->stride_h) - (int32_t)layer->pad_top;
+        const uint32_t kh_begin = (ih0 < 0) ? (uint32_t)-ih0 : 0;
+        const uint32_t kh_end = MIN(layer->kernel_h, (uint32_t)((int32_t)layer->in.height - ih0));
+
+        for (uint32_t ow = 0; ow < layer->out.width; ow++)
+        {
+            const int32_t iw0 = (int32_t)(ow * layer->stride_w) - (int32_t)layer->pad_left;
+            const uint32_t kw_begin = (iw0 < 0) ? (uint32_t)-iw0 : 0;
+            const uint32_t kw_end = MIN(layer->kernel_w, (uint32_t)((int32_t)layer->in.width - iw0));
+            bool first = true;
+
+            for (uint32_t kh = kh_begin; kh < kh_end; kh++)
+            {
+                for (uint32_t kw = kw_begin; kw < kw_end; kw++)
+                {
+                    const float* x = in + ((size_t)(ih0 + (int32_t)kh) * layer->in.width + (size_t)(iw0 + (int32_t)kw)) * channels;
+                    if (first)
+                        memcpy(out, x, channels * sizeof(float));
+                    else if (is_max)
+                        kernels->max_r(out, x, out, channels);
+                    else
+                        kernels->add_r(out, x, out, channels);
+                    first = false;
+                }
+            }
+
+            if (!is_max)
+                kernels->scale_r(out, 1.f / (float)((kh_end - kh_begin) * (kw_end - kw_begin)), out, channels);
+            if (layer->activation == IFX_INFERENCE_ACTIVATION_RELU)
+                kernels->clip_r(out, 0, FLT_MAX, out, channels);
+            out += channels;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void pool_s8(const Layer_t* layer, const int8_t* in, int8_t* out, int32_t* scratch)
+{
+    const uint32_t channels = layer->in.channels;
+    const bool is_max = (layer->type == IFX_INFERENCE_LAYER_MAXPOOL2D);
+    const float lower = (layer->activation == IFX_INFERENCE_ACTIVATION_RELU) ? 0.f : -127.f;
+
+    for (uint32_t oh = 0; oh < layer->out.height; oh++)
+    {
+        const int32_t ih0 = (int32_t)(oh * layer->stride_h) - (int32_t)layer->pad_top;
+        const uint32_t kh_begin = (ih0 < 0) ? (uint32_t)-ih0 : 0;
+        const uint32_t kh_end = MIN(layer->kernel_h, (uint32_t)((int32_t)layer->in.height - ih0));
+
+        for (uint32_t ow = 0; ow < layer->out.width; ow++)
+        {
+            const int32_t iw0 = (int32_t)(ow * layer->stride_w) - (int32_t)layer->pad_left;
+            const uint32_t kw_begin = (iw0 < 0) ? (uint32_t)-iw0 : 0;
+            const uint32_t kw_end = MIN(layer->kernel_w, (uint32_t)((int32_t)layer->in.width - iw0));
+
+            for (uint32_t c = 0; c < channels; c++)
+                scratch[c] = is_max ? INT32_MIN : 0;
+
+            for (uint32_t kh = kh_begin; kh < kh_end; kh++)
+            {
+                for (uint32_t kw = kw_begin; kw < kw_end; kw++)
+                {
+                    const int8_t* x = in + ((size_t)(ih0 + (int32_t)kh) * layer->in.width + (size_t)(iw0 + (int32_t)kw)) * channels;
+                    if (is_max)
+                    {
+                        for (uint32_t c = 0; c < channels; c++)
+                            scratch[c] = MAX(scratch[c], (int32_t)x[c]);
+                    }
+                    else
+                    {
+                        for (uint32_t c = 0; c < channels; c++)
+                            scratch[c] += x[c];
+                    }
+                }
+            }
+
+            const float scale = is_max ? 1.f : 1.f / (float)((kh_end - kh_begin) * (kw_end - kw_begin));
+            for (uint32_t c = 0; c < channels; c++)
+                *out++ = quantize((float)scratch[c] * scale, lower);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void dense_f32(const Layer_t* layer, const float* in, float* out)
+{
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+    const uint32_t inputs = shape_size(&layer->in);
+
+    for (uint32_t u = 0; u < layer->out.channels; u++)
+    {
+        float acc = layer->bias[u] + kernels->dot_r(in, layer->weights + (size_t)u * inputs, inputs);
+        if (layer->activation == IFX_INFERENCE_ACTIVATION_RELU && acc < 0)
+            acc = 0;
+        out[u] = acc;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void dense_s8(const Layer_t* layer, const int8_t* in, int8_t* out)
+{
+    const ifx_Simd_Fixed_Kernels_t* kernels = ifx_simd_fixed_kernels();
+    const uint32_t inputs = shape_size(&layer->in);
+    const float lower = (layer->activation == IFX_INFERENCE_ACTIVATION_RELU) ? 0.f : -127.f;
+
+    for (uint32_t u = 0; u < layer->out.channels; u++)
+    {
+        const int32_t acc = layer->bias_q[u] + kernels->dot_s8(in, layer->weights_q + (size_t)u * inputs, inputs);
+        out[u] = quantize((float)acc * layer->requant[u], lower);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void affine_f32(const Layer_t* layer, const float* in, float* out)
+{
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+    const uint32_t channels = layer->in.channels;
+    const uint32_t pixels = layer->in.height * layer->in.width;
+
+    for (uint32_t p = 0; p < pixels; p++)
+    {
+        kernels->mul_r(in, layer->weights, out, channels);
+        kernels->add_r(out, layer->bias, out, channels);
+        if (layer->activation == IFX_INFERENCE_ACTIVATION_RELU)
+            kernels->clip_r(out, 0, FLT_MAX, out, channels);
+        in += channels;
+        out += channels;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void affine_s8(const Layer_t* layer, const int8_t* in, int8_t* out)
+{
+    const uint32_t channels = layer->in.channels;
+    const uint32_t pixels = layer->in.height * layer->in.width;
+    const float lower = (layer->activation == IFX_INFERENCE_ACTIVATION_RELU) ? 0.f : -127.f;
+
+    for (uint32_t p = 0; p < pixels; p++)
+    {
+        for (uint32_t c = 0; c < channels; c++)
+            *out++ = quantize((float)*in++ * layer->requant[c] + layer->requant[channels + c], lower);
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Inference_t* ifx_inference_create(const void* model,
+                                      size_t size)
+{
+    IFX_ERR_BRN_NULL(model);
+    IFX_ERR_BRN_ARGUMENT(size < MODEL_HEADER_SIZE);
+
+    const uint8_t* header = model;
+    IFX_ERR_BRN_ARGUMENT(read_u32(header) != IFX_INFERENCE_MAGIC);
+    IFX_ERR_BRN_COND(read_u16(header + 4) != IFX_INFERENCE_VERSION, IFX_ERROR_NOT_SUPPORTED);
+
+    ifx_Inference_t* h = ifx_mem_calloc(1, sizeof(struct ifx_Inference_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->data_type = (ifx_Inference_Data_Type_t)read_u16(header + 6);
+    h->num_layers = read_u32(header + 8);
+    h->input_shape.height = read_u32(header + 12);
+    h->input_shape.width = read_u32(header + 16);
+    h->input_shape.channels = read_u32(header + 20);
+    h->input_scale = read_f32(header + 24);
+
+    const ifx_Inference_Shape_t* in = &h->input_shape;
+    IFX_ERR_BRF_COND(h->data_type != IFX_INFERENCE_FLOAT32 && h->data_type != IFX_INFERENCE_INT8, IFX_ERROR_NOT_SUPPORTED);
+    IFX_ERR_BRF_COND(h->num_layers == 0 || h->num_layers > (size - MODEL_HEADER_SIZE) / LAYER_HEADER_SIZE, IFX_ERROR_ARGUMENT_INVALID);
+    IFX_ERR_BRF_COND(in->height == 0 || in->width == 0 || in->channels == 0, IFX_ERROR_ARGUMENT_INVALID);
+    IFX_ERR_BRF_COND(in->height > MAX_DIMENSION || in->width > MAX_DIMENSION || in->channels > MAX_TENSOR_SIZE, IFX_ERROR_ARGUMENT_INVALID);
+    IFX_ERR_BRF_COND((uint64_t)in->height * in->width * in->channels > MAX_TENSOR_SIZE, IFX_ERROR_ARGUMENT_INVALID);
+    IFX_ERR_BRF_COND(h->data_type == IFX_INFERENCE_INT8 && !(h->input_scale > 0 && h->input_scale < FLT_MAX), IFX_ERROR_ARGUMENT_INVALID);
+
+    // weights are used in place, so the copy must be aligned for float and SIMD loads
+    h->model = ifx_mem_aligned_alloc(size, BUFFER_ALIGNMENT);
+    IFX_ERR_BRF_MEMALLOC(h->model);
+    memcpy(h->model, model, size);
+
+    h->layers = ifx_mem_calloc(h->num_layers, sizeof(Layer_t));
+    IFX_ERR_BRF_MEMALLOC(h->layers);
+
+    const uint8_t* data = h->model;
+    size_t offset = MODEL_HEADER_SIZE;
+    ifx_Inference_Shape_t shape = h->input_shape;
+    float scale = h->input_scale;
+    uint32_t max_size = shape_size(&shape);
+    uint32_t max_channels = shape.channels;
+
+    for (uint32_t i = 0; i < h->num_layers; i++)
+    {
+        Layer_t* layer = &h->layers[i];
+        IFX_ERR_BRF_COND(size - offset < LAYER_HEADER_SIZE, IFX_ERROR_ARGUMENT_INVALID);
+
+        const uint8_t* layer_header = data + offset;
+        const size_t payload = read_u32(layer_header + LAYER_HEADER_SIZE - 4);
+        offset += LAYER_HEADER_SIZE;
+        IFX_ERR_BRF_COND(payload > size - offset, IFX_ERROR_ARGUMENT_INVALID);
+
+        // an affine first layer of an int8 model is applied to the float input
+        const bool float_input = (i == 0 && read_u16(layer_header) == IFX_INFERENCE_LAYER_AFFINE);
+        layer->in = shape;
+        layer->in_scale = float_input ? 1.f : scale;
+
+        if (!layer_init(h, layer, layer_header, data + offset, payload))
+        {
+            if (ifx_error_get() == IFX_OK)
+                ifx_error_set(IFX_ERROR_ARGUMENT_INVALID);
+            goto fail;
+        }
+
+        IFX_ERR_BRF_COND(layer->type == IFX_INFERENCE_LAYER_SOFTMAX && i + 1 != h->num_layers, IFX_ERROR_ARGUMENT_INVALID);
+        offset += payload;
+
+        shape = layer->out;
+        scale = layer->out_scale;
+        max_size = MAX(max_size, shape_size(&shape));
+        max_channels = MAX(max_channels, shape.channels);
+    }
+
+    IFX_ERR_BRF_COND(offset != size, IFX_ERROR_ARGUMENT_INVALID);
+    h->output_size = shape_size(&shape);
+
+    {
+        // both arenas can hold the largest tensor of the network, the
+        // scratch buffer one pixel of float or int32 accumulators
+        const size_t element_size = (h->data_type == IFX_INFERENCE_INT8) ? sizeof(int8_t) : sizeof(float);
+        for (int i = 0; i < 2; i++)
+        {
+            h->arena[i] = ifx_mem_aligned_alloc((size_t)max_size * element_size, BUFFER_ALIGNMENT);
+            IFX_ERR_BRF_MEMALLOC(h->arena[i]);
+        }
+
+        h->scratch = ifx_mem_aligned_alloc((size_t)max_channels * sizeof(float), BUFFER_ALIGNMENT);
+        IFX_ERR_BRF_MEMALLOC(h->scratch);
+    }
+
+    return h;
+
+fail:
+    ifx_inference_destroy(h);
+    return NULL;
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Inference_t* ifx_inference_create_from_file(const char* filename)
+{
+    IFX_ERR_BRN_NULL(filename);
+
+    FILE* file = fopen(filename, "rb");
+    IFX_ERR_BRN_ARGUMENT(file == NULL);
+
+    ifx_Inference_t* h = NULL;
+    void* model = NULL;
+    long size = -1;
+
+    if (fseek(file, 0, SEEK_END) == 0)
+        size = ftell(file);
+
+    if (size <= 0 || fseek(file, 0, SEEK_SET) != 0)
+    {
+        ifx_error_set(IFX_ERROR_ARGUMENT_INVALID);
+    }
+    else if ((model = ifx_mem_alloc((size_t)size)) == NULL)
+    {
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+    }
+    else if (fread(model, 1, (size_t)size, file) != (size_t)size)
+    {
+        ifx_error_set(IFX_ERROR_ARGUMENT_INVALID);
+    }
+    else
+    {
+        h = ifx_inference_create(model, (size_t)size);
+    }
+
+    ifx_mem_free(model);
+    fclose(file);
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_inference_destroy(ifx_Inference_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    if (handle->layers)
+    {
+        for (uint32_t i = 0; i < handle->num_layers; i++)
+            ifx_mem_free(handle->layers[i].requant);
+
+        ifx_mem_free(handle->layers);
+    }
+
+    ifx_mem_aligned_free(handle->model);
+    ifx_mem_aligned_free(handle->arena[0]);
+    ifx_mem_aligned_free(handle->arena[1]);
+    ifx_mem_aligned_free(handle->scratch);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Inference_Data_Type_t ifx_inference_get_data_type(const ifx_Inference_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, IFX_INFERENCE_FLOAT32);
+
+    return handle->data_type;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_inference_get_input_shape(const ifx_Inference_t* handle,
+                                   ifx_Inference_Shape_t* shape)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(shape);
+
+    *shape = handle->input_shape;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_inference_get_output_size(const ifx_Inference_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+
+    return handle->output_size;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_inference_run(ifx_Inference_t* handle,
+                       const ifx_Float_t* input,
+                       ifx_Float_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(input);
+    IFX_ERR_BRK_NULL(output);
+
+    const bool is_int8 = (handle->data_type == IFX_INFERENCE_INT8);
+    const Layer_t* last = &handle->layers[handle->num_layers - 1];
+    uint32_t first = 0;
+    const void* src = input;
+
+    if (is_int8)
+    {
+        quantize_input(handle, input, handle->arena[0]);
+        src = handle->arena[0];
+        if (handle->layers[0].type == IFX_INFERENCE_LAYER_AFFINE)
+            first = 1;
+    }
+
+    for (uint32_t i = first; i < handle->num_layers; i++)
+    {
+        const Layer_t* layer = &handle->layers[i];
+        void* dst = (src == handle->arena[0]) ? handle->arena[1] : handle->arena[0];
+
+        // flatten only changes the shape, softmax is applied to the output
+        if (layer->type == IFX_INFERENCE_LAYER_FLATTEN || layer->type == IFX_INFERENCE_LAYER_SOFTMAX)
+            continue;
+
+        switch (layer->type)
+        {
+            case IFX_INFERENCE_LAYER_CONV2D:
+                if (is_int8)
+                    conv2d_s8(layer, src, dst);
+                else
+                    conv2d_f32(layer, src, dst);
+                break;
+            case IFX_INFERENCE_LAYER_DEPTHWISE_CONV2D:
+                if (is_int8)
+                    depthwise_s8(layer, src, dst, handle->scratch);
+                else
+                    depthwise_f32(layer, src, dst, handle->scratch);
+                break;
+            case IFX_INFERENCE_LAYER_MAXPOOL2D:
+            case IFX_INFERENCE_LAYER_AVGPOOL2D:
+            case IFX_INFERENCE_LAYER_GLOBAL_AVGPOOL:
+                if (is_int8)
+                    pool_s8(layer, src, dst, handle->scratch);
+                else
+                    pool_f32(layer, src, dst);
+                break;
+            case IFX_INFERENCE_LAYER_DENSE:
+                if (is_int8)
+                    dense_s8(layer, src, dst);
+                else
+                    dense_f32(layer, src, dst);
+                break;
+            case IFX_INFERENCE_LAYER_AFFINE:
+                if (is_int8)
+                    affine_s8(layer, src, dst);
+                else
+                    affine_f32(layer, src, dst);
+                break;
+            default:
+                break;
+        }
+
+        src = dst;
+    }
+
+    if (is_int8)
+        dequantize(src, last->out_scale, output, handle->output_size);
+    else if (src != output)
+        memcpy(output, src, handle->output_size * sizeof(float));
+
+    if (last->type == IFX_INFERENCE_LAYER_SOFTMAX)
+        softmax(output, handle->output_size);
+}
@@ -0,0 +1,291 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Inference.h
+ *
+ * \brief \copybrief gr_inference
+ *
+ * For details refer to \ref gr_inference
+ */
+
+#ifndef IFX_ALGO_INFERENCE_H
+#define IFX_ALGO_INFERENCE_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/** Magic number at the beginning of a model file (the characters "IFXN") */
+#define IFX_INFERENCE_MAGIC 0x4E584649u
+
+/** Version of the model format supported by this library */
+#define IFX_INFERENCE_VERSION 1
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief A handle for an instance of the inference module, see Inference.h.
+ */
+typedef struct ifx_Inference_s ifx_Inference_t;
+
+/**
+ * @brief Data type of weights and activations of a model.
+ */
+typedef enum
+{
+    IFX_INFERENCE_FLOAT32 = 0, /**< 32-bit floating point weights and activations.*/
+    IFX_INFERENCE_INT8 = 1     /**< Symmetric 8-bit quantized weights (per output channel) and activations (per tensor).*/
+} ifx_Inference_Data_Type_t;
+
+/**
+ * @brief Layer types of a model.
+ */
+typedef enum
+{
+    IFX_INFERENCE_LAYER_CONV2D = 1,           /**< 2D convolution, params: filters, kernel height, kernel width,
+                                                   stride height, stride width, padding.*/
+    IFX_INFERENCE_LAYER_DEPTHWISE_CONV2D = 2, /**< Depthwise 2D convolution with depth multiplier 1, params: kernel height,
+                                                   kernel width, stride height, stride width, padding.*/
+    IFX_INFERENCE_LAYER_MAXPOOL2D = 3,        /**< Max pooling, params: pool height, pool width, stride height,
+                                                   stride width, padding.*/
+    IFX_INFERENCE_LAYER_AVGPOOL2D = 4,        /**< Average pooling (padding excluded), params as for max pooling.*/
+    IFX_INFERENCE_LAYER_GLOBAL_AVGPOOL = 5,   /**< Average over height and width, no params.*/
+    IFX_INFERENCE_LAYER_DENSE = 6,            /**< Fully connected layer, params: units.*/
+    IFX_INFERENCE_LAYER_AFFINE = 7,           /**< Per channel y = scale * x + shift (normalization or batch
+                                                   normalization that could not be folded), no params.*/
+    IFX_INFERENCE_LAYER_SOFTMAX = 8,          /**< Softmax, only allowed as last layer, no params.*/
+    IFX_INFERENCE_LAYER_FLATTEN = 9           /**< Reshape to 1 x 1 x (height * width * channels), no params.*/
+} ifx_Inference_Layer_Type_t;
+
+/**
+ * @brief Activation function applied to the output of a layer.
+ */
+typedef enum
+{
+    IFX_INFERENCE_ACTIVATION_NONE = 0, /**< Linear output.*/
+    IFX_INFERENCE_ACTIVATION_RELU = 1  /**< max(x, 0).*/
+} ifx_Inference_Activation_t;
+
+/**
+ * @brief Padding mode of convolution and pooling layers.
+ */
+typedef enum
+{
+    IFX_INFERENCE_PADDING_VALID = 0, /**< No padding.*/
+    IFX_INFERENCE_PADDING_SAME = 1   /**< Output size is ceil(input size / stride), padding is split like in
+                                          TensorFlow (the smaller half before the data).*/
+} ifx_Inference_Padding_t;
+
+/**
+ * @brief Shape of a tensor in height x width x channels (NHWC) layout.
+ */
+typedef struct
+{
+    uint32_t height;   /**< Number of rows.*/
+    uint32_t width;    /**< Number of columns.*/
+    uint32_t channels; /**< Number of channels, the fastest changing dimension in memory.*/
+} ifx_Inference_Shape_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Algorithms
+ * @{
+ */
+
+/** @defgroup gr_inference Inference
+ * @brief API for inference of small convolutional neural networks
+ *
+ * The module evaluates feed forward networks as used for the classification
+ * of spectrograms (e.g. micro-Doppler images) without any machine learning
+ * framework. Supported are 2D and depthwise convolutions, max and average
+ * pooling, dense layers, per channel affine layers, ReLU and softmax. 1D
+ * layers map to 2D layers with a height of 1. Batch normalization is folded
+ * into the preceding convolution or dense layer by the model converter.
+ *
+ * Models are converted offline (see src/export_native_model.py for Keras
+ * models) into a binary file that is loaded with
+ * \ref ifx_inference_create_from_file or \ref ifx_inference_create. All
+ * memory (a copy of the weights and two activation buffers large enough for
+ * the biggest tensor of the network) is allocated when the model is
+ * loaded, \ref ifx_inference_run does not allocate.
+ *
+ * Tensors are stored in height x width x channels (NHWC) order. A row-major
+ * image with R rows and C columns passed to a model with an input shape of
+ * 1 x R x C corresponds to a Keras input of shape (R, C) for Conv1D layers.
+ *
+ * Int8 models use symmetric quantization with a zero point of 0. Weights
+ * have one scale per output channel, activations one scale per tensor.
+ * Accumulation is done in 32-bit integers, requantization in floating
+ * point. Values are rounded to the nearest integer and saturated to the
+ * int8 range (infinities included); NaN is quantized to 0. If the first
+ * layer of an int8 model is an affine layer, it is applied to the floating
+ * point input before quantization, so a normalization layer does not lose
+ * precision. Softmax is always computed in floating point.
+ *
+ * Model format (version 1, all values little endian):
+ * - Header (32 bytes): uint32 magic (\ref IFX_INFERENCE_MAGIC), uint16
+ *   version, uint16 data type (\ref ifx_Inference_Data_Type_t), uint32
+ *   number of layers, uint32 input height, width and channels, float32
+ *   input scale (int8 models), uint32 reserved.
+ * - Per layer a header (36 bytes): uint16 type
+ *   (\ref ifx_Inference_Layer_Type_t), uint16 activation
+ *   (\ref ifx_Inference_Activation_t), uint32 params[6], float32 output
+ *   scale (int8 models), uint32 payload size in bytes; followed by the
+ *   payload.
+ * - Float32 payload: convolution weights [filters][kernel height][kernel
+ *   width][input channels], depthwise weights [kernel height][kernel
+ *   width][channels], dense weights [units][inputs], each followed by one
+ *   bias per output channel. Affine layers store scale[channels] followed
+ *   by shift[channels].
+ * - Int8 payload: int8 weights in the same order, padded with zeros to a
+ *   multiple of 4 bytes, int32 bias (in units of input scale * weight
+ *   scale), float32 weight scale per output channel. Affine layers are
+ *   stored as for float32 models.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates an inference instance from a model in memory.
+ *
+ * The model is copied, so the memory can be released after the call.
+ *
+ * @param [in]     model     Model in the format described in \ref gr_inference.
+ * @param [in]     size      Size of the model in bytes.
+ *
+ * @return  Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Inference_t* ifx_inference_create(const void* model,
+                                      size_t size);
+
+/**
+ * @brief Creates an inference instance from a model file.
+ *
+ * @param [in]     filename  Path of the model file.
+ *
+ * @return  Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Inference_t* ifx_inference_create_from_file(const char* filename);
+
+/**
+ * @brief Releases all resources held by the given handle.
+ *
+ * @param [in,out] handle    A handle to the inference object.
+ */
+IFX_DLL_PUBLIC
+void ifx_inference_destroy(ifx_Inference_t* handle);
+
+/**
+ * @brief Returns the data type of the model.
+ *
+ * @param [in]     handle    A handle to the inference object.
+ *
+ * @return  Data type of weights and activations.
+ */
+IFX_DLL_PUBLIC
+ifx_Inference_Data_Type_t ifx_inference_get_data_type(const ifx_Inference_t* handle);
+
+/**
+ * @brief Returns the shape of the input tensor.
+ *
+ * @param [in]     handle    A handle to the inference object.
+ * @param [out]    shape     Shape of the input.
+ */
+IFX_DLL_PUBLIC
+void ifx_inference_get_input_shape(const ifx_Inference_t* handle,
+                                   ifx_Inference_Shape_t* shape);
+
+/**
+ * @brief Returns the number of output values.
+ *
+ * @param [in]     handle    A handle to the inference object.
+ *
+ * @return  Number of output values (e.g. number of classes).
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_inference_get_output_size(const ifx_Inference_t* handle);
+
+/**
+ * @brief Evaluates the network for one input.
+ *
+ * The function does not allocate memory. A handle must not be used by
+ * several threads concurrently.
+ *
+ * @param [in]     handle    A handle to the inference object.
+ * @param [in]     input     Input tensor in NHWC order with height * width * channels
+ *                           values, see \ref ifx_inference_get_input_shape.
+ * @param [out]    output    Output of the last layer, must have space for
+ *                           \ref ifx_inference_get_output_size values.
+ */
+IFX_DLL_PUBLIC
+void ifx_inference_run(ifx_Inference_t* handle,
+                       const ifx_Float_t* input,
+                       ifx_Float_t* output);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_ALGO_INFERENCE_H */
@@ -38,15 +38,21 @@
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Simd.h"
+#include "ifxBase/internal/SimdMti.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
 
+#include <string.h>
+
 /*
 ==============================================================================
    2. LOCAL DEFINITIONS
 ==============================================================================
 */
 
+#define VEC_CONTIGUOUS(v) (vStride(v) == 1 && sizeof(ifx_Float_t) == sizeof(float))
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -63,6 +69,11 @@ struct ifx_MTI_s
     ifx_Vector_R_t* spectrum_history; /**< A real vector container that stores the historical
                                            range spectrum data to be subtracted from the next
                                            incoming range spectrum data.*/
+    ifx_MTI_Type_t type;              /**< Clutter removal filter.*/
+    ifx_Vector_R_t* history2;         /**< Second last input for \ref IFX_MTI_TYPE_THREE_PULSE, NULL otherwise.*/
+    ifx_Vector_R_t* alpha_per_bin;    /**< Filter coefficient per bin, NULL if the scalar alpha is used.*/
+    uint32_t decimation;              /**< The history is updated every decimation-th run.*/
+    uint32_t run_count;               /**< Number of runs modulo decimation.*/
 };
 
 /*
@@ -77,12 +88,52 @@ struct ifx_MTI_s
 ==============================================================================
 */
 
+static void filter_scalar(ifx_MTI_t* mti,
+                          bool update,
+                          const ifx_Vector_R_t* input,
+                          ifx_Vector_R_t* output);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
 ==============================================================================
 */
 
+static void filter_scalar(ifx_MTI_t* mti,
+                          bool update,
+                          const ifx_Vector_R_t* input,
+                          ifx_Vector_R_t* output)
+{
+    // for shorter names
+    ifx_Vector_R_t* history = mti->spectrum_history;
+
+    for (uint32_t j = 0; j < vLen(input); j++)
+    {
+        const ifx_Float_t input_j = vAt(input, j);
+        const ifx_Float_t history_j = vAt(history, j);
+
+        if (mti->type == IFX_MTI_TYPE_THREE_PULSE)
+        {
+            vAt(output, j) = input_j - 2 * history_j + vAt(mti->history2, j);
+            if (update)
+                vAt(mti->history2, j) = input_j;
+            continue;
+        }
+
+        vAt(output, j) = input_j - history_j;
+        if (!update)
+            continue;
+
+        // history_n := (1-alpha)*history_{n-1} + alpha*input_n
+        if (mti->type == IFX_MTI_TYPE_TWO_PULSE)
+            vAt(history, j) = input_j;
+        else if (mti->alpha_per_bin)
+            vAt(history, j) += vAt(mti->alpha_per_bin, j) * vAt(output, j);
+        else
+            vAt(history, j) += mti->alpha * vAt(output, j);
+    }
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -100,6 +151,11 @@ ifx_MTI_t* ifx_mti_create(ifx_Float_t alpha_mti_filter,
 
     h->alpha = alpha_mti_filter;
     h->spectrum_history = ifx_vec_create_r(spectrum_length);
+    h->type = IFX_MTI_TYPE_EXPONENTIAL;
+    h->history2 = NULL;
+    h->alpha_per_bin = NULL;
+    h->decimation = 1;
+    h->run_count = 0;
 
     if (h->spectrum_history == NULL)
     {
@@ -120,6 +176,8 @@ void ifx_mti_destroy(ifx_MTI_t* mti)
     }
 
     ifx_vec_destroy_r(mti->spectrum_history);
+    ifx_vec_destroy_r(mti->history2);
+    ifx_vec_destroy_r(mti->alpha_per_bin);
     ifx_mem_free(mti);
 }
 
@@ -135,18 +193,120 @@ void ifx_mti_run(ifx_MTI_t* mti,
     IFX_VEC_BRK_DIM(mti->spectrum_history, input);
     IFX_VEC_BRK_DIM(input, output);
 
-    // for shorter names
-    const ifx_Float_t alpha = mti->alpha;
-    ifx_Vector_R_t* history = mti->spectrum_history;
+    const bool update = (mti->run_count == 0);
+    mti->run_count = (mti->run_count + 1 < mti->decimation) ? mti->run_count + 1 : 0;
 
-    // output_n := input_n - history_n
-    // history_n := (1-alpha)*history_{n-1} + alpha*input_n
-    for (uint32_t j = 0; j < vLen(input); j++)
+    if (!VEC_CONTIGUOUS(input) || !VEC_CONTIGUOUS(output))
     {
-        const ifx_Float_t input_j = vAt(input, j);
-        const ifx_Float_t history_j = vAt(history, j);
-        vAt(output, j) = input_j - history_j;
-        // vAt(history, j) = (1 - alpha) * history_j + alpha*input_j;
-        vAt(history, j) += alpha * vAt(output, j);
+        filter_scalar(mti, update, input, output);
+    }
+    else
+    {
+        const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+        const ifx_Simd_Mti_Kernels_t* mti_kernels = ifx_simd_mti_kernels();
+        const float* x = vDat(input);
+        float* y = vDat(output);
+        float* history = vDat(mti->spectrum_history);
+        const size_t len = vLen(input);
+
+        // output_n := input_n - history_n
+        // history_n := history_{n-1} + alpha*output_n
+        if (mti->type == IFX_MTI_TYPE_THREE_PULSE)
+        {
+            if (update)
+            {
+                mti_kernels->cancel3_r(x, history, vDat(mti->history2), y, len);
+            }
+            else
+            {
+                kernels->mac_r(x, history, -2, y, len);
+                kernels->add_r(y, vDat(mti->history2), y, len);
+            }
+        }
+        else if (!update)
+            kernels->sub_r(x, history, y, len);
+        else if (mti->type == IFX_MTI_TYPE_TWO_PULSE)
+            mti_kernels->mti_r(x, history, 1, y, len);
+        else if (mti->alpha_per_bin)
+            mti_kernels->mti_vr(x, history, vDat(mti->alpha_per_bin), y, len);
+        else
+            mti_kernels->mti_r(x, history, mti->alpha, y, len);
+    }
+
+    // the second last input is now in history2: swap so spectrum_history holds the last one
+    if (update && mti->type == IFX_MTI_TYPE_THREE_PULSE)
+    {
+        ifx_Vector_R_t* tmp = mti->spectrum_history;
+        mti->spectrum_history = mti->history2;
+        mti->history2 = tmp;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mti_set_type(ifx_MTI_t* mti,
+                      ifx_MTI_Type_t type)
+{
+    IFX_ERR_BRK_NULL(mti);
+    IFX_ERR_BRK_ARGUMENT(type > IFX_MTI_TYPE_THREE_PULSE);
+
+    if (type == IFX_MTI_TYPE_THREE_PULSE && mti->history2 == NULL)
+    {
+        mti->history2 = ifx_vec_create_r(vLen(mti->spectrum_history));
+        IFX_ERR_BRK_MEMALLOC(mti->history2);
+    }
+
+    mti->type = type;
+    mti->run_count = 0;
+    ifx_vec_setall_r(mti->spectrum_history, 0);
+    if (mti->history2)
+        ifx_vec_setall_r(mti->history2, 0);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_MTI_Type_t ifx_mti_get_type(const ifx_MTI_t* mti)
+{
+    IFX_ERR_BRV_NULL(mti, IFX_MTI_TYPE_EXPONENTIAL);
+    return mti->type;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mti_set_alpha_per_bin(ifx_MTI_t* mti,
+                               const ifx_Vector_R_t* alpha)
+{
+    IFX_ERR_BRK_NULL(mti);
+
+    if (alpha == NULL)
+    {
+        ifx_vec_destroy_r(mti->alpha_per_bin);
+        mti->alpha_per_bin = NULL;
+        return;
     }
+
+    IFX_VEC_BRK_VALID(alpha);
+    IFX_VEC_BRK_DIM(mti->spectrum_history, alpha);
+    for (uint32_t j = 0; j < vLen(alpha); j++)
+    {
+        IFX_ERR_BRK_ARGUMENT(vAt(alpha, j) < 0 || vAt(alpha, j) > 1);
+    }
+
+    if (mti->alpha_per_bin == NULL)
+    {
+        mti->alpha_per_bin = ifx_vec_create_r(vLen(alpha));
+        IFX_ERR_BRK_MEMALLOC(mti->alpha_per_bin);
+    }
+    ifx_vec_copy_r(alpha, mti->alpha_per_bin);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mti_set_decimation(ifx_MTI_t* mti,
+                            uint32_t decimation)
+{
+    IFX_ERR_BRK_NULL(mti);
+
+    mti->decimation = (decimation == 0) ? 1 : decimation;
+    mti->run_count = 0;
 }
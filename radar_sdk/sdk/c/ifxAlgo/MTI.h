@@ -71,6 +71,22 @@ extern "C"
  */
 typedef struct ifx_MTI_s ifx_MTI_t;
 
+/**
+ * @brief Clutter removal filters supported by MTI and 2D MTI.
+ */
+typedef enum
+{
+    /** First order exponential average (default):
+     *  \f$ y_n = x_n - h_{n-1}, \quad h_n = h_{n-1} + \alpha y_n \f$ */
+    IFX_MTI_TYPE_EXPONENTIAL = 0U,
+
+    /** Two-pulse canceller, subtracts the previous input: \f$ y_n = x_n - x_{n-1} \f$ */
+    IFX_MTI_TYPE_TWO_PULSE = 1U,
+
+    /** Three-pulse canceller, second order difference: \f$ y_n = x_n - 2 x_{n-1} + x_{n-2} \f$ */
+    IFX_MTI_TYPE_THREE_PULSE = 2U
+} ifx_MTI_Type_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -129,6 +145,58 @@ void ifx_mti_run(ifx_MTI_t* mti,
                  const ifx_Vector_R_t* input,
                  ifx_Vector_R_t* output);
 
+/**
+ * @brief Selects the clutter removal filter and clears the history.
+ *
+ * @param [in,out] mti       Pointer to MTI structure.
+ * @param [in]     type      Filter type, see \ref ifx_MTI_Type_t
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_mti_set_type(ifx_MTI_t* mti,
+                      ifx_MTI_Type_t type);
+
+/**
+ * @brief Returns the clutter removal filter type.
+ *
+ * @param [in]     mti       Pointer to MTI structure.
+ *
+ * @return Filter type, see \ref ifx_MTI_Type_t
+ *
+ */
+IFX_DLL_PUBLIC
+ifx_MTI_Type_t ifx_mti_get_type(const ifx_MTI_t* mti);
+
+/**
+ * @brief Sets an individual filter coefficient for every bin of the spectrum.
+ *
+ * Only used by \ref IFX_MTI_TYPE_EXPONENTIAL. This allows e.g. a faster adaption
+ * of the history for close range bins. Passing NULL reverts to the scalar
+ * coefficient given in \ref ifx_mti_create.
+ *
+ * @param [in,out] mti       Pointer to MTI structure.
+ * @param [in]     alpha     Filter coefficients (spectrum_length values between 0.0 and 1.0) or NULL
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_mti_set_alpha_per_bin(ifx_MTI_t* mti,
+                               const ifx_Vector_R_t* alpha);
+
+/**
+ * @brief Updates the history only every decimation-th call of \ref ifx_mti_run.
+ *
+ * For slowly varying clutter the history does not need to be updated for
+ * every spectrum. In between the output is computed from the unchanged
+ * history. A value of 0 or 1 updates the history on every call (default).
+ *
+ * @param [in,out] mti          Pointer to MTI structure.
+ * @param [in]     decimation   History update interval in calls of \ref ifx_mti_run
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_mti_set_decimation(ifx_MTI_t* mti,
+                            uint32_t decimation);
+
 /**
  * @}
  */
@@ -42,6 +42,7 @@
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Metrics.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
@@ -169,6 +170,8 @@ void ifx_oscfar_run(const ifx_OSCFAR_t* handle,
     IFX_MAT_BRK_VALID(feature2D);
     IFX_MAT_BRK_VALID(detector_output);
 
+    const uint64_t metrics_start = ifx_metrics_begin();
+
     ifx_mat_clear_r(detector_output);
 
     ifx_Float_t input_mean = ifx_mat_mean_r(feature2D);
@@ -208,6 +211,8 @@ void ifx_oscfar_run(const ifx_OSCFAR_t* handle,
             }
         }
     }
+
+    ifx_metrics_end(IFX_METRICS_STAGE_CFAR, metrics_start);
 }
 
 //----------------------------------------------------------------------------
@@ -64,7 +64,7 @@
 struct ifx_PPFFT_s
 {
     bool mean_removal_enabled;         /**< If false, mean removal step is ignored during range spectrum calculation.*/
-    ifx_Vector_R_t* fft_window;        /**< Vector specifying the window function to be used before FFT in range spectrum calculation.*/
+    const ifx_Vector_R_t* fft_window;  /**< Shared window coefficients (see \ref ifx_window_acquire) used before FFT in range spectrum calculation.*/
     ifx_Window_Config_t window_config; /**< Window type, length and attenuation used for range FFT.*/
     ifx_FFT_t* fft_handle;             /**< Handle to an ifx_FFT_t object.*/
     ifx_Vector_R_t* pp_result_r;       /**< Container to store real pre-processing result in case fft_type is \ref IFX_FFT_TYPE_R2C. Otherwise ignored.*/
@@ -116,28 +116,14 @@ ifx_PPFFT_t* ifx_ppfft_create(const ifx_PPFFT_Config_t* config)
     IFX_ERR_HANDLE_N(h->fft_handle = ifx_fft_create(config->fft_type, config->fft_size),
                      ifx_ppfft_destroy(h));
 
-    IFX_ERR_HANDLE_N(h->fft_window = ifx_vec_create_r(config->window_config.size),
+    // The window is normalized first and scaled afterwards, otherwise the
+    // scaling would be cancelled by the normalization.
+    IFX_ERR_HANDLE_N(h->fft_window = ifx_window_acquire(&config->window_config, config->is_normalized_window),
                      ifx_ppfft_destroy(h));
 
-    ifx_window_init(&config->window_config, h->fft_window);
-
     h->window_config = config->window_config;
     h->mean_removal_enabled = config->mean_removal_enabled;
 
-    if (config->is_normalized_window)
-    {
-        const ifx_Float_t sum = ifx_vec_sum_r(h->fft_window);
-
-        ifx_vec_scale_r(h->fft_window, 1.0f / sum, h->fft_window);
-    }
-
-    // Moved out of window_init() as scaling got cancelled if window normalization is performed afterwards.
-
-    if (config->window_config.scale != 0 && config->window_config.scale != 1)
-    {
-        ifx_vec_scale_r(h->fft_window, config->window_config.scale, h->fft_window);
-    }
-
     return h;
 }
 
@@ -152,7 +138,7 @@ void ifx_ppfft_destroy(ifx_PPFFT_t* handle)
 
     ifx_fft_destroy(handle->fft_handle);
 
-    ifx_vec_destroy_r(handle->fft_window);
+    ifx_window_release(handle->fft_window);
     ifx_vec_destroy_r(handle->pp_result_r);
     ifx_vec_destroy_c(handle->pp_result_c);
 
@@ -272,23 +258,26 @@ void ifx_ppfft_set_window(ifx_PPFFT_t* handle, const ifx_Window_Config_t* config
     IFX_ERR_BRK_NULL(handle);
     IFX_ERR_BRK_NULL(config);
 
-    if (config->size != handle->window_config.size)
-    {
-        ifx_vec_destroy_r(handle->fft_window);
-        handle->fft_window = ifx_vec_create_r(config->size);
-    }
+    // plain window coefficients without normalization and scaling
+    ifx_Window_Config_t window_config = *config;
+    window_config.scale = 1;
+
+    const ifx_Vector_R_t* fft_window = ifx_window_acquire(&window_config, false);
+    IFX_ERR_BRK_MEMALLOC(fft_window);
 
-    ifx_window_init(config, handle->fft_window);
+    ifx_window_release(handle->fft_window);
+    handle->fft_window = fft_window;
 
     handle->window_config = *config;
 }
 
 //----------------------------------------------------------------------------
 
-ifx_Vector_R_t* ifx_ppfft_get_window(ifx_PPFFT_t* handle)
+const ifx_Vector_R_t* ifx_ppfft_get_window(ifx_PPFFT_t* handle)
 {
     IFX_ERR_BRV_NULL(handle, NULL);
 
+    // The window is shared with other modules and must not be modified.
     return handle->fft_window;
 }
 
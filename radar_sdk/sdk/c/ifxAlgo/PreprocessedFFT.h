@@ -222,13 +222,17 @@ void ifx_ppfft_set_window(ifx_PPFFT_t* handle,
 /**
  * @brief Returns pointer to the window used in preprocessed FFT.
  *
+ * The window coefficients are shared with other modules using the same
+ * window configuration (see \ref ifx_window_acquire) and must not be
+ * modified.
+ *
  * @param [in]     handle    A handle to the 1D pre-processed FFT object
  *
- * @return Pointer to the real vector containing window values
+ * @return Read-only pointer to the real vector containing window values
  *
  */
 IFX_DLL_PUBLIC
-ifx_Vector_R_t* ifx_ppfft_get_window(ifx_PPFFT_t* handle);
+const ifx_Vector_R_t* ifx_ppfft_get_window(ifx_PPFFT_t* handle);
 
 /**
  * @brief Returns type of window used in preprocessed FFT.
@@ -36,7 +36,10 @@
 #include "ifxAlgo/Window.h"
 
 #include "ifxBase/Defines.h"
+#include <string.h>
+
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/Cache.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Vector.h"
 
@@ -52,6 +55,20 @@
 ==============================================================================
 */
 
+/**
+ * @brief Key of a window in the cache.
+ *
+ * The key is compared bytewise, so it must be zeroed before it is filled.
+ */
+typedef struct
+{
+    ifx_Window_Type_t type; /**< Type of window function */
+    uint32_t size;          /**< Number of elements */
+    ifx_Float_t at_dB;      /**< Attenuation for Chebyshev window, otherwise 0 */
+    ifx_Float_t scale;      /**< Scale factor, 1 if no scaling is applied */
+    bool normalize;         /**< Normalize window to a sum of 1 */
+} Window_Key_t;
+
 /*
 ==============================================================================
    4. LOCAL DATA
@@ -187,6 +204,19 @@ static ifx_Float_t coshm1(ifx_Float_t x);
 static ifx_Float_t chebyxp1(int n,
                             ifx_Float_t x);
 
+/**
+ * @brief Creates the window coefficients for a cache entry.
+ *
+ * @param [in]     key       Pointer to \ref Window_Key_t.
+ * @return Window coefficients or NULL in case of an error.
+ */
+static void* create_window(const void* key);
+
+/**
+ * @brief Destroys window coefficients of a cache entry.
+ */
+static void destroy_window(void* win);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -400,6 +430,33 @@ static void init_chebyshev(ifx_Vector_R_t* win,
     ifx_vec_scale_r(win, 1 / max_val, win);
 }
 
+static void* create_window(const void* key)
+{
+    const Window_Key_t* k = key;
+
+    ifx_Vector_R_t* win = ifx_vec_create_r(k->size);
+    if (win == NULL)
+        return NULL;
+
+    const ifx_Window_Config_t config = {k->type, k->size, k->at_dB, k->scale};
+    ifx_window_init(&config, win);
+
+    if (k->normalize)
+        ifx_vec_scale_r(win, 1.0f / ifx_vec_sum_r(win), win);
+
+    if (k->scale != 1)
+        ifx_vec_scale_r(win, k->scale, win);
+
+    return win;
+}
+
+//----------------------------------------------------------------------------
+
+static void destroy_window(void* win)
+{
+    ifx_vec_destroy_r(win);
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -439,3 +496,33 @@ void ifx_window_init(const ifx_Window_Config_t* config,
             break;
     }
 }
+
+//----------------------------------------------------------------------------
+
+const ifx_Vector_R_t* ifx_window_acquire(const ifx_Window_Config_t* config,
+                                         bool normalize)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->size == 0);
+    IFX_ERR_BRN_ARGUMENT(config->type > IFX_WINDOW_BLACKMAN);
+
+    Window_Key_t key;
+    memset(&key, 0, sizeof(key));
+    key.type = config->type;
+    key.size = config->size;
+    key.at_dB = (config->type == IFX_WINDOW_CHEBYSHEV) ? config->at_dB : 0;
+    key.scale = (config->scale != 0) ? config->scale : 1;
+    key.normalize = normalize;
+
+    const ifx_Vector_R_t* win = ifx_cache_acquire(&key, sizeof(key), create_window, destroy_window);
+    IFX_ERR_BRN_MEMALLOC(win);
+
+    return win;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_window_release(const ifx_Vector_R_t* win)
+{
+    ifx_cache_release(win);
+}
@@ -131,6 +131,38 @@ IFX_DLL_PUBLIC
 void ifx_window_init(const ifx_Window_Config_t* config,
                      ifx_Vector_R_t* win);
 
+/**
+ * @brief Returns shared, read-only window coefficients.
+ *
+ * The coefficients are computed by \ref ifx_window_init, optionally
+ * normalized such that their sum is 1, and then multiplied by the scale
+ * factor of the configuration unless the scale factor is 0 or 1.
+ *
+ * Windows are kept in a process-wide cache keyed by type, size, attenuation
+ * (Chebyshev only), scale and normalization. Modules requesting the same
+ * window share one vector, so the coefficients are computed only once.
+ * The function is thread-safe.
+ *
+ * The returned vector must not be modified and must be returned with
+ * \ref ifx_window_release.
+ *
+ * @param [in]     config    \ref ifx_Window_Config_t "Window configuration structure".
+ * @param [in]     normalize If true, the coefficients are normalized to a sum of 1
+ *                           before scaling.
+ * @return Pointer to the window coefficients or NULL in case of an error.
+ */
+IFX_DLL_PUBLIC
+const ifx_Vector_R_t* ifx_window_acquire(const ifx_Window_Config_t* config,
+                                         bool normalize);
+
+/**
+ * @brief Releases window coefficients returned by \ref ifx_window_acquire.
+ *
+ * @param [in]     win       Window coefficients. If NULL, nothing happens.
+ */
+IFX_DLL_PUBLIC
+void ifx_window_release(const ifx_Vector_R_t* win);
+
 /**
  * @}
  */
@@ -28,6 +28,48 @@
 */
 
 #include "Metrics.h"
+#include "ifxBase/FunctionWrapper.hpp"
+#include "ifxBase/Math.h"
+#include "ifxFmcw/avian/DeviceFmcwAvian.hpp"
+#include "ifxRadarDeviceCommon/internal/RadarDeviceCommon.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+using Infineon::Avian::TimingModel::PowerMode;
+using Infineon::Avian::TimingModel::SequenceTiming;
+using Infineon::Avian::TimingModel::Ticks;
+
+/*
+ * This function applies a delay the same way DeviceFmcwAvian does it when
+ * setting an acquisition sequence: If the delay is long enough to wake up
+ * from IDLE or even DEEP SLEEP, the power saving mode is used and the wake up
+ * time is subtracted from the delay.
+ */
+template <typename Setter>
+void set_power_saving_delay(const SequenceTiming& timing, Ticks delay, Setter setter)
+{
+    const auto time_after_idle = timing.getWakeUpTime(PowerMode::Idle);
+    const auto time_after_deep_sleep = timing.getWakeUpTime(PowerMode::Deep_Sleep_Continue) - time_after_idle;
+
+    auto power_mode = PowerMode::Interchirp;
+    if (delay >= time_after_idle)
+    {
+        power_mode = PowerMode::Idle;
+        delay -= time_after_idle;
+    }
+    if (delay >= time_after_deep_sleep)
+    {
+        power_mode = PowerMode::Deep_Sleep_Continue;
+        delay -= time_after_deep_sleep;
+    }
+    setter(delay, power_mode);
+}
+
+}  // namespace
+
 
 
 void ifx_avian_metrics_from_config(const ifx_Avian_Device_t* avian, const ifx_Avian_Config_t* config, ifx_Avian_Metrics_t* metrics)
@@ -93,3 +135,219 @@ void ifx_avian_metrics_to_config(const ifx_Avian_Device_t* avian, const ifx_Avia
     config->chirp_repetition_time_s = chirp_loop.repetition_time_s;
     config->num_chirps_per_frame = chirp_loop.num_repetitions;
 }
+
+bool ifx_avian_metrics_solve(const ifx_Avian_Device_Traits_t* device_traits, const ifx_Avian_Metrics_Target_t* target, bool round_to_power_of_2,
+                             ifx_Avian_Config_t* config, ifx_Avian_Metrics_Solution_t* solution)
+{
+    IFX_ERR_BRV_NULL(device_traits, false);
+    IFX_ERR_BRV_NULL(target, false);
+    IFX_ERR_BRV_NULL(config, false);
+
+    const auto& metrics = target->metrics;
+    IFX_ERR_BRV_ARGUMENT((metrics.range_resolution_m <= 0) || (metrics.max_range_m <= 0), false);
+    IFX_ERR_BRV_ARGUMENT((metrics.speed_resolution_m_s <= 0) || (metrics.speed_resolution_m_s >= metrics.max_speed_m_s), false);
+    IFX_ERR_BRV_ARGUMENT(target->frame_rate_Hz <= 0, false);
+    IFX_ERR_BRV_ARGUMENT(!rdk::RadarDeviceCommon::sensor_is_avian(device_traits->sensor_type)
+                             || (device_traits->sensor_type == IFX_AVIAN_UNKNOWN),
+                         false);
+
+    /*
+     * The timing only depends on the sensor type and the reference clock, so
+     * the evaluation is done on a dummy device. This keeps the solver
+     * independent of a connected board.
+     */
+    const float reference_clock_Hz = (device_traits->reference_clock_Hz != 0) ? device_traits->reference_clock_Hz : 80e6f;
+    const auto device = rdk::call_func([device_traits, reference_clock_Hz]() {
+        return std::make_unique<DeviceFmcwAvian>(device_traits->sensor_type, reference_clock_Hz);
+    });
+    if (!device)
+        return false;
+
+    const auto* sensor_info = device->get_sensor_info();
+
+    /*
+     * RF range, number of samples and number of chirps are derived exactly
+     * as in ifx_avian_metrics_to_config. The chirp repetition time computed
+     * there is the longest one meeting the maximum speed, the shortest one
+     * meets the speed resolution exactly. Every time in between meets both.
+     */
+    ifx_Avian_Metrics_t rf_metrics = metrics;
+    if (rf_metrics.center_frequency_Hz == 0)
+        rf_metrics.center_frequency_Hz = (sensor_info->min_rf_frequency_Hz + sensor_info->max_rf_frequency_Hz) / 2.0;
+
+    ifx_Fmcw_Sequence_Element_t chirp_element;
+    chirp_element.type = IFX_SEQ_CHIRP;
+    chirp_element.next_element = nullptr;
+
+    ifx_Fmcw_Sequence_Element_t chirp_loop_element;
+    chirp_loop_element.type = IFX_SEQ_LOOP;
+    chirp_loop_element.next_element = nullptr;
+    chirp_loop_element.loop.sub_sequence = &chirp_element;
+
+    ifx_fmcw_sequence_from_metrics(&rf_metrics, round_to_power_of_2, &chirp_loop_element);
+
+    const auto start_frequency_Hz = static_cast<double>(static_cast<uint64_t>(chirp_element.chirp.start_frequency_Hz));
+    const auto end_frequency_Hz = static_cast<double>(static_cast<uint64_t>(chirp_element.chirp.end_frequency_Hz));
+    IFX_ERR_BRV_COND((start_frequency_Hz < sensor_info->min_rf_frequency_Hz)
+                         || (end_frequency_Hz > sensor_info->max_rf_frequency_Hz),
+                     IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, false);
+
+    const uint32_t num_samples = chirp_element.chirp.num_samples;
+    IFX_ERR_BRV_COND(num_samples > sensor_info->max_num_samples_per_chirp, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, false);
+
+    const uint32_t num_chirps = chirp_loop_element.loop.num_repetitions;
+    const double observation_time_s = IFX_LIGHT_SPEED_MPS / (2.0 * rf_metrics.center_frequency_Hz * metrics.speed_resolution_m_s);
+    const double max_chirp_repetition_time_s = chirp_loop_element.loop.repetition_time_s;
+    const double min_chirp_repetition_time_s = observation_time_s / num_chirps;
+    const double frame_repetition_time_s = 1.0 / target->frame_rate_Hz;
+
+    float max_sample_rate_Hz = sensor_info->max_adc_sampling_rate;
+    if ((target->max_sample_rate_Hz != 0) && (target->max_sample_rate_Hz < max_sample_rate_Hz))
+        max_sample_rate_Hz = static_cast<float>(target->max_sample_rate_Hz);
+
+    /*
+     * The timing model is set up once through the regular sequence
+     * translation, so it reflects antenna settings and MIMO mode. The chirps
+     * are configured as fast as possible, the candidates are then derived by
+     * modifying the timing parameters in the model.
+     */
+    ifx_Fmcw_Simple_Sequence_Config_t sequence_config;
+    sequence_config.frame_repetition_time_s = static_cast<float>(frame_repetition_time_s);
+    sequence_config.chirp_repetition_time_s = 0;
+    sequence_config.num_chirps = num_chirps;
+    sequence_config.tdm_mimo = config->mimo_mode == IFX_MIMO_TDM;
+    sequence_config.chirp.sample_rate_Hz = max_sample_rate_Hz;
+    sequence_config.chirp.rx_mask = config->rx_mask;
+    sequence_config.chirp.tx_mask = config->tx_mask;
+    sequence_config.chirp.tx_power_level = config->tx_power_level;
+    sequence_config.chirp.if_gain_dB = config->if_gain_dB;
+    sequence_config.chirp.start_frequency_Hz = start_frequency_Hz;
+    sequence_config.chirp.end_frequency_Hz = end_frequency_Hz;
+    sequence_config.chirp.num_samples = num_samples;
+    sequence_config.chirp.hp_cutoff_Hz = config->hp_cutoff_Hz;
+    sequence_config.chirp.lp_cutoff_Hz = config->aaf_cutoff_Hz;
+
+    auto* sequence = ifx_fmcw_create_simple_sequence(&sequence_config);
+    IFX_ERR_BRV_NULL(sequence, false);
+    auto timing = rdk::call_func([&device, sequence]() {
+        return device->create_sequence_timing(sequence);
+    });
+    ifx_fmcw_destroy_sequence(sequence);
+    if (!timing)
+        return false;
+
+    unsigned num_shapes = 1;
+    while ((num_shapes < 4) && (timing->getNumRepetitions(num_shapes) > 0))
+        ++num_shapes;
+    const unsigned last_shape = num_shapes - 1;
+    IFX_ERR_BRV_COND(num_chirps * num_shapes > std::numeric_limits<uint16_t>::max(),
+                     IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, false);
+    timing->setNumShapeGroupsPerFrame(static_cast<uint16_t>(num_chirps * num_shapes));
+
+    const double osc_frequency_Hz = timing->getOscFrequency();
+    const Ticks min_chirp_repetition_ticks = min_chirp_repetition_time_s * osc_frequency_Hz;
+    const Ticks max_chirp_repetition_ticks = max_chirp_repetition_time_s * osc_frequency_Hz;
+    const Ticks frame_repetition_ticks = frame_repetition_time_s * osc_frequency_Hz;
+
+    const auto min_divider = timing->getAdcDivider();
+    const auto max_divider = static_cast<unsigned>(osc_frequency_Hz / sensor_info->min_adc_sampling_rate);
+
+    bool found = false;
+    unsigned best_divider = 0;
+    Ticks best_chirp_repetition_ticks = 0;
+    double best_power = 0;
+    double best_acquisition_time = 0;
+
+    /*
+     * The search space spans the ADC divider and the chirp repetition time.
+     * Between chirps the deepest power mode the delay allows is used, so a
+     * longer chirp repetition time may enable IDLE or DEEP SLEEP and save
+     * power. Within the range of one power mode a longer time does not help,
+     * so only the shortest time and the shortest time for each power mode are
+     * candidates.
+     */
+    for (unsigned divider = min_divider; divider <= max_divider; ++divider)
+    {
+        timing->setAdcDivider(static_cast<uint16_t>(divider));
+
+        /*
+         * The chirp repetition time is stretched by the shape end delay of the
+         * last shape. Longer sampling only makes chirps longer, so once the
+         * shortest possible repetition time is too long, no other candidate
+         * can succeed.
+         */
+        timing->setShapeEndDelay(last_shape, 1, PowerMode::Interchirp);
+        const Ticks min_set_ticks = timing->getSetToSetTime();
+        if (min_set_ticks > max_chirp_repetition_ticks)
+            break;
+
+        /*
+         * One clock cycle of margin on the power mode thresholds makes sure
+         * rounding in the conversion to seconds does not fall back to the
+         * lighter mode.
+         */
+        const Ticks chirp_repetition_candidates[] = {
+            std::max(min_chirp_repetition_ticks, min_set_ticks),
+            std::ceil(min_set_ticks + timing->getWakeUpTime(PowerMode::Idle)),
+            std::ceil(min_set_ticks + timing->getWakeUpTime(PowerMode::Deep_Sleep_Continue))};
+
+        for (const auto chirp_repetition_ticks : chirp_repetition_candidates)
+        {
+            if ((chirp_repetition_ticks < min_chirp_repetition_ticks) || (chirp_repetition_ticks > max_chirp_repetition_ticks))
+                continue;
+
+            set_power_saving_delay(*timing, chirp_repetition_ticks - min_set_ticks + 1,
+                                   [&timing, last_shape](Ticks delay, PowerMode mode) {
+                                       timing->setShapeEndDelay(last_shape, delay, mode);
+                                   });
+
+            // The frame end delay fills the remaining frame time.
+            timing->setFrameEndDelay(1, PowerMode::Interchirp);
+            const Ticks min_frame_ticks = timing->getFrameDuration() - 1;
+            if (min_frame_ticks > frame_repetition_ticks)
+                continue;
+
+            set_power_saving_delay(*timing, frame_repetition_ticks - min_frame_ticks,
+                                   [&timing](Ticks delay, PowerMode mode) {
+                                       timing->setFrameEndDelay(delay, mode);
+                                   });
+
+            const double power = timing->getFrameAveragePowerConsumption();
+            const double acquisition_time = timing->toSeconds(timing->getAcquisitionDuration());
+            if ((target->max_power_W > 0) && (power > target->max_power_W))
+                continue;
+
+            const bool better = (target->goal == IFX_AVIAN_SOLVER_MIN_ACQUISITION_TIME)
+                                    ? ((acquisition_time < best_acquisition_time)
+                                       || ((acquisition_time == best_acquisition_time) && (power < best_power)))
+                                    : ((power < best_power)
+                                       || ((power == best_power) && (acquisition_time < best_acquisition_time)));
+            if (!found || better)
+            {
+                found = true;
+                best_divider = divider;
+                best_chirp_repetition_ticks = chirp_repetition_ticks;
+                best_power = power;
+                best_acquisition_time = acquisition_time;
+            }
+        }
+    }
+
+    IFX_ERR_BRV_COND(!found, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, false);
+
+    config->sample_rate_Hz = static_cast<uint32_t>(std::round(osc_frequency_Hz / best_divider));
+    config->start_frequency_Hz = static_cast<uint64_t>(start_frequency_Hz);
+    config->end_frequency_Hz = static_cast<uint64_t>(end_frequency_Hz);
+    config->num_samples_per_chirp = num_samples;
+    config->num_chirps_per_frame = num_chirps;
+    config->chirp_repetition_time_s = static_cast<float>(best_chirp_repetition_ticks / osc_frequency_Hz);
+    config->frame_repetition_time_s = static_cast<float>(frame_repetition_time_s);
+
+    if (solution)
+    {
+        solution->average_power_W = static_cast<float>(best_power);
+        solution->acquisition_time_s = static_cast<float>(best_acquisition_time);
+    }
+
+    return true;
+}
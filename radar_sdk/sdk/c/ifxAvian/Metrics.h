@@ -65,6 +65,53 @@ extern "C"
 
 typedef ifx_Fmcw_Metrics_t ifx_Avian_Metrics_t;
 
+/**
+ * @brief Optimization goal of \ref ifx_avian_metrics_solve
+ */
+typedef enum
+{
+    IFX_AVIAN_SOLVER_MIN_POWER = 0,            /**< Minimize the average power consumption. */
+    IFX_AVIAN_SOLVER_MIN_ACQUISITION_TIME = 1  /**< Minimize the time from the start of a frame
+                                                    until the end of its last chirp. */
+} ifx_Avian_Solver_Goal_t;
+
+/**
+ * @brief Device properties passed to \ref ifx_avian_metrics_solve
+ */
+typedef struct
+{
+    ifx_Radar_Sensor_t sensor_type; /**< The Avian sensor, see \ref ifx_avian_get_sensor_type. */
+    float reference_clock_Hz;       /**< The reference clock of the board (38.4MHz, 40MHz, 76.8MHz
+                                         or 80MHz), 0 means 80MHz. */
+} ifx_Avian_Device_Traits_t;
+
+/**
+ * @brief Requirements passed to \ref ifx_avian_metrics_solve
+ */
+typedef struct
+{
+    ifx_Avian_Metrics_t metrics; /**< Range resolution and speed resolution are upper limits,
+                                      maximum range and maximum speed are lower limits. If
+                                      center_frequency_Hz is 0, the center of the RF band is
+                                      used. */
+    float frame_rate_Hz;         /**< The frame rate to configure. */
+    float max_power_W;           /**< Upper limit of the average power consumption, 0 means
+                                      unlimited. */
+    uint32_t max_sample_rate_Hz; /**< Upper limit of the ADC sampling rate, 0 means the limit
+                                      of the ADC. */
+    ifx_Avian_Solver_Goal_t goal; /**< The figure to optimize. */
+} ifx_Avian_Metrics_Target_t;
+
+/**
+ * @brief Figures of the configuration found by \ref ifx_avian_metrics_solve
+ */
+typedef struct
+{
+    float average_power_W;    /**< The estimated average power consumption. */
+    float acquisition_time_s; /**< The time from the start of a frame until the end of its
+                                   last chirp. */
+} ifx_Avian_Metrics_Solution_t;
+
 /**
  * @brief Determines metrics parameters from Avian device configuration
  *
@@ -114,6 +161,43 @@ IFX_DLL_PUBLIC
 void ifx_avian_metrics_to_config(const ifx_Avian_Device_t* avian, const ifx_Avian_Metrics_t* metrics, bool round_to_power_of_2,
                                  ifx_Avian_Config_t* config);
 
+/**
+ * @brief Finds the best Avian device configuration for the given requirements
+ *
+ * In contrast to \ref ifx_avian_metrics_to_config this function takes the
+ * timing of the Avian state machine into account. All ADC sampling rates
+ * supported by the device are tried, each with the chirp repetition times
+ * between the one meeting the speed resolution exactly and the one meeting
+ * the maximum speed exactly that allow a deeper power saving mode between
+ * chirps. Each candidate configuration is evaluated with the timing model of
+ * the device, including the power saving modes chosen between chirps and
+ * frames. Candidates that violate the timing or the power limit are dropped,
+ * and the best remaining candidate with respect to the goal specified in
+ * target is returned. The other figure is used as tie breaker.
+ *
+ * No device needs to be connected, the timing only depends on the sensor
+ * type and the reference clock given in device_traits.
+ *
+ * The fields tx_mask, rx_mask, tx_power_level, if_gain_dB, lp_cutoff_Hz,
+ * hp_cutoff_Hz and mimo_mode of config are taken as input, because they
+ * affect the timing. All other fields are computed by this function. Please
+ * note that power consumption figures are estimates of the timing model.
+ *
+ * @param [in]     device_traits        Sensor type and reference clock
+ * @param [in]     target               Requirements
+ * @param [in]     round_to_power_of_2  If true num_samples_per_chirp and
+ *                                      num_chirps_per_frame are rounded to
+ *                                      the next power of 2.
+ * @param [in,out] config               Avian device configuration structure
+ * @param [out]    solution             Figures of the found configuration,
+ *                                      may be NULL
+ * @retval true    if a configuration meeting all requirements was found
+ * @retval false   otherwise, config is not modified in this case
+ */
+IFX_DLL_PUBLIC
+bool ifx_avian_metrics_solve(const ifx_Avian_Device_Traits_t* device_traits, const ifx_Avian_Metrics_Target_t* target, bool round_to_power_of_2,
+                             ifx_Avian_Config_t* config, ifx_Avian_Metrics_Solution_t* solution);
+
 /**
  * @}
  */
@@ -56,6 +56,9 @@
 #include <ifxBase/Math.h>
 #include <ifxBase/Matrix.h>
 #include <ifxBase/Mem.h>
+#include <ifxBase/Metrics.h>
+#include <ifxBase/Stream.h>
+#include <ifxBase/ThreadPolicy.h>
 #include <ifxBase/Types.h>
 #include <ifxBase/Uuid.h>
 #include <ifxBase/Vector.h>
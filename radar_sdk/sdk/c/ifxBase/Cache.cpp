@@ -0,0 +1,160 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "internal/Cache.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+namespace {
+
+// objects are identified by their create function and the bytes of the key
+using Key = std::pair<ifx_Cache_Create_t, std::string>;
+
+struct Entry
+{
+    void* object;
+    ifx_Cache_Destroy_t destroy;
+    size_t references;
+};
+
+struct Cache
+{
+    std::mutex lock;                               // protects entries and objects
+    std::map<Key, Entry> entries;                  // all objects by key
+    std::unordered_map<const void*, Key> objects;  // key of each object
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+Cache& get_cache()
+{
+    // intentionally leaked so that objects released by static destructors of
+    // other modules do not access a destroyed cache
+    static Cache* cache = new Cache;
+    return *cache;
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void* ifx_cache_acquire(const void* key, size_t key_size, ifx_Cache_Create_t create, ifx_Cache_Destroy_t destroy)
+{
+    Cache& cache = get_cache();
+    Key cache_key(create, std::string(static_cast<const char*>(key), key_size));
+
+    // Objects are created while holding the lock. This serializes the
+    // creation of different objects, but guarantees that an object is
+    // never created twice.
+    std::lock_guard<std::mutex> guard(cache.lock);
+
+    auto it = cache.entries.find(cache_key);
+    if (it != cache.entries.end())
+    {
+        it->second.references++;
+        return it->second.object;
+    }
+
+    void* object = create(key);
+    if (!object)
+        return nullptr;
+
+    cache.objects.emplace(object, cache_key);
+    cache.entries.emplace(std::move(cache_key), Entry {object, destroy, 1});
+    return object;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_cache_release(const void* object)
+{
+    if (!object)
+        return;
+
+    Cache& cache = get_cache();
+    std::lock_guard<std::mutex> guard(cache.lock);
+
+    auto obj = cache.objects.find(object);
+    if (obj == cache.objects.end())
+        return;
+
+    auto it = cache.entries.find(obj->second);
+    if (--it->second.references > 0)
+        return;
+
+    it->second.destroy(it->second.object);
+    cache.entries.erase(it);
+    cache.objects.erase(obj);
+}
+
+//----------------------------------------------------------------------------
+
+size_t ifx_cache_size(void)
+{
+    Cache& cache = get_cache();
+    std::lock_guard<std::mutex> guard(cache.lock);
+
+    return cache.entries.size();
+}
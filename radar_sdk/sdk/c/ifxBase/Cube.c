@@ -41,6 +41,7 @@
 #include "Cube.h"
 #include "Error.h"
 #include "internal/Macros.h"
+#include "internal/Simd.h"
 #include "Matrix.h"
 #include "Mem.h"
 
@@ -182,6 +183,16 @@ void ifx_cube_col_abs_r(const ifx_Cube_C_t* cube,
     IFX_MAT_BRK_VALID(matrix);
     IFX_ERR_BRK_ARGUMENT(column_index >= cCols(cube));
 
+    // the slices of a row of the cube and the columns of a row of the
+    // matrix can be passed to the kernels if they are contiguous
+    if (IFX_CUBE_STRIDE(cube, 2) == 1 && mStride(matrix, 1) == 1 && sizeof(ifx_Float_t) == sizeof(float))
+    {
+        const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+        for (uint32_t r = 0; r < cRows(cube); r++)
+            kernels->abs_c((const float*)&cAt(cube, r, column_index, 0), (float*)&mAt(matrix, r, 0), cSlices(cube));
+        return;
+    }
+
     for (uint32_t r = 0; r < cRows(cube); r++)
     {
         for (uint32_t c = 0; c < cSlices(cube); c++)
@@ -33,7 +33,10 @@
 ==============================================================================
 */
 
-#include <stdarg.h>
+#include <atomic>
+#include <cstdarg>
+
+#include <common/AsyncLogger.hpp>
 
 #include "Log.h"
 
@@ -60,13 +63,18 @@
 ==============================================================================
 */
 
+// if set, messages are handed to the asynchronous logger of strata
+static std::atomic<bool> g_async {false};
+
 /*
 ==============================================================================
    5. LOCAL FUNCTION PROTOTYPES
 ==============================================================================
 */
 
-static char* get_severity_tag(ifx_Log_Severity_t severity);
+static const char* get_severity_tag(ifx_Log_Severity_t severity);
+
+static Logger::LogLevel get_log_level(ifx_Log_Severity_t severity);
 
 /*
 ==============================================================================
@@ -74,7 +82,7 @@ static char* get_severity_tag(ifx_Log_Severity_t severity);
 ==============================================================================
 */
 
-static char* get_severity_tag(ifx_Log_Severity_t severity)
+static const char* get_severity_tag(ifx_Log_Severity_t severity)
 {
     switch (severity)
     {
@@ -95,6 +103,25 @@ static char* get_severity_tag(ifx_Log_Severity_t severity)
     }
 }
 
+static Logger::LogLevel get_log_level(ifx_Log_Severity_t severity)
+{
+    switch (severity)
+    {
+        case IFX_LOG_WARNING:
+            return Logger::LOG_WARN;
+
+        case IFX_LOG_DEBUG:
+            return Logger::LOG_DEBUG;
+
+        case IFX_LOG_INFO:
+            return Logger::LOG_INFO;
+
+        case IFX_LOG_ERROR:
+        default:
+            return Logger::LOG_ERROR;
+    }
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -104,9 +131,51 @@ static char* get_severity_tag(ifx_Log_Severity_t severity)
 void ifx_log(FILE* f, ifx_Log_Severity_t severity, const char* msg, ...)
 {
     va_list argl;
+
+    // messages to other streams than the default one are written synchronously
+    if (f == IFX_STDOUT && g_async.load(std::memory_order_relaxed))
+    {
+        va_start(argl, msg);
+        AsyncLogger::instance().logv(get_log_level(severity), msg, argl);
+        va_end(argl);
+        return;
+    }
+
     fprintf(f, "%s: ", get_severity_tag(severity));
     va_start(argl, msg);
     vfprintf(f, msg, argl);
     va_end(argl);
     fprintf(f, "\n");
 }
+
+//----------------------------------------------------------------------------
+
+void ifx_log_set_async(bool enable)
+{
+    if (!enable && g_async.load())
+    {
+        AsyncLogger::instance().flush();
+    }
+    g_async = enable;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_log_flush(void)
+{
+    AsyncLogger::instance().flush();
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_log_set_binary_file(const char* filename)
+{
+    AsyncLogger::instance().setBinaryFile(filename);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_log_set_rate_limit(uint32_t messages_per_second)
+{
+    AsyncLogger::instance().setRateLimit(messages_per_second);
+}
@@ -129,6 +129,55 @@ typedef enum
 IFX_DLL_PUBLIC
 void ifx_log(FILE* f, ifx_Log_Severity_t s, const char* msg, ...);
 
+/**
+ * @brief Enables or disables asynchronous logging.
+ *
+ * In asynchronous mode \ref ifx_log only copies the format string pointer
+ * and the arguments into a per-thread ring buffer; formatting and output
+ * are done by a background thread. This keeps logging out of the
+ * acquisition and processing threads. Messages for the default stream
+ * IFX_STDOUT are written to the log of the strata library (console and log
+ * file); messages for any other stream are still written synchronously to
+ * that stream. The format string must be a string literal.
+ *
+ * If a ring buffer is full, messages are dropped. Messages of a single call
+ * site are rate limited, see \ref ifx_log_set_rate_limit.
+ *
+ * Disabling asynchronous mode writes all pending messages.
+ *
+ * @param [in]     enable    true to enable asynchronous logging
+ */
+IFX_DLL_PUBLIC
+void ifx_log_set_async(bool enable);
+
+/**
+ * @brief Blocks until all pending asynchronous messages are written.
+ */
+IFX_DLL_PUBLIC
+void ifx_log_flush(void);
+
+/**
+ * @brief Additionally writes asynchronous messages in binary form to a file.
+ *
+ * Binary logs are much smaller and cheaper to write than text logs. They
+ * can be converted to text with the log-decoder tool.
+ *
+ * @param [in]     filename  name of the binary log file, NULL to close the file
+ */
+IFX_DLL_PUBLIC
+void ifx_log_set_binary_file(const char* filename);
+
+/**
+ * @brief Limits the number of asynchronous messages per call site and second.
+ *
+ * Suppressed messages are counted and reported with the next message of
+ * the same call site. The default limit is 1000 messages per second.
+ *
+ * @param [in]     messages_per_second    maximum rate, 0 to disable the limit
+ */
+IFX_DLL_PUBLIC
+void ifx_log_set_rate_limit(uint32_t messages_per_second);
+
 /**
  * @}
  */
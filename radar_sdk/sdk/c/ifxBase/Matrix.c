@@ -38,6 +38,7 @@
 #include "Defines.h"
 #include "Error.h"
 #include "internal/Macros.h"
+#include "internal/Simd.h"
 #include "internal/Util.h"
 #include "Mda.h"
 #include "Mem.h"
@@ -107,6 +108,62 @@
         }                                                               \
     } while (0)
 
+/* true if the elements within each row are contiguous in memory, i.e., if the
+ * rows can be passed to the kernels in internal/Simd.h */
+#define MAT_ROWS_CONTIGUOUS(m) (mStride(m, 1) == 1 && sizeof(ifx_Float_t) == sizeof(float))
+
+/* pointer to the first element of row r as float* */
+#define MAT_ROW_PTR(m, r) ((float*)&mAt(m, r, 0))
+
+/* like MAT_APPLY_UNOP, but call row_kernel(in, out, len) for each row if
+ * the rows of mat and result are contiguous */
+#define MAT_APPLY_UNOP_SIMD(mat, op, row_kernel, result)                            \
+    do                                                                              \
+    {                                                                               \
+        IFX_MAT_BRK_VALID(mat);                                                     \
+        IFX_MAT_BRK_VALID(result);                                                  \
+        IFX_MAT_BRK_DIM(mat, result);                                               \
+        if (MAT_ROWS_CONTIGUOUS(mat) && MAT_ROWS_CONTIGUOUS(result))                \
+        {                                                                           \
+            for (uint32_t r = 0; r < mRows(mat); r++)                               \
+                row_kernel(MAT_ROW_PTR(mat, r), MAT_ROW_PTR(result, r), mCols(mat)); \
+            break;                                                                  \
+        }                                                                           \
+        for (uint32_t r = 0; r < mRows(mat); r++)                                   \
+        {                                                                           \
+            for (uint32_t c = 0; c < mCols(mat); c++)                               \
+            {                                                                       \
+                mAt(result, r, c) = op(mAt(mat, r, c));                             \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
+/* like MAT_APPLY_BINOP, but call row_kernel(lhs, rhs, out, len) for each
+ * row if the rows of lhs, rhs, and result are contiguous */
+#define MAT_APPLY_BINOP_SIMD(lhs, op, row_kernel, rhs, result)                                   \
+    do                                                                                           \
+    {                                                                                            \
+        IFX_MAT_BRK_VALID(lhs);                                                                  \
+        IFX_MAT_BRK_VALID(rhs);                                                                  \
+        IFX_MAT_BRK_VALID(result);                                                               \
+        IFX_MAT_BRK_DIM(lhs, result);                                                            \
+        IFX_MAT_BRK_DIM(lhs, rhs);                                                               \
+        if (MAT_ROWS_CONTIGUOUS(lhs) && MAT_ROWS_CONTIGUOUS(rhs) && MAT_ROWS_CONTIGUOUS(result)) \
+        {                                                                                        \
+            for (uint32_t r = 0; r < mRows(lhs); r++)                                            \
+                row_kernel(MAT_ROW_PTR(lhs, r), MAT_ROW_PTR(rhs, r), MAT_ROW_PTR(result, r),     \
+                           mCols(lhs));                                                          \
+            break;                                                                               \
+        }                                                                                        \
+        for (uint32_t r = 0; r < mRows(lhs); r++)                                                \
+        {                                                                                        \
+            for (uint32_t c = 0; c < mCols(lhs); c++)                                            \
+            {                                                                                    \
+                mAt(result, r, c) = op(mAt(lhs, r, c), mAt(rhs, r, c));                          \
+            }                                                                                    \
+        }                                                                                        \
+    } while (0)
+
 
 /*
 ==============================================================================
@@ -445,7 +502,9 @@ void ifx_mat_add_r(const ifx_Matrix_R_t* matrix_l,
                    ifx_Matrix_R_t* result)
 {
 #define OP(a, b) ((a) + (b))
-    MAT_APPLY_BINOP(matrix_l, OP, matrix_r, result);
+#define KERNEL(x, y, z, len) ifx_simd_kernels()->add_r(x, y, z, len)
+    MAT_APPLY_BINOP_SIMD(matrix_l, OP, KERNEL, matrix_r, result);
+#undef KERNEL
 #undef OP
 }
 
@@ -489,7 +548,9 @@ void ifx_mat_sub_r(const ifx_Matrix_R_t* matrix_l,
                    ifx_Matrix_R_t* result)
 {
 #define OP(a, b) ((a) - (b))
-    MAT_APPLY_BINOP(matrix_l, OP, matrix_r, result);
+#define KERNEL(x, y, z, len) ifx_simd_kernels()->sub_r(x, y, z, len)
+    MAT_APPLY_BINOP_SIMD(matrix_l, OP, KERNEL, matrix_r, result);
+#undef KERNEL
 #undef OP
 }
 
@@ -533,7 +594,9 @@ void ifx_mat_scale_r(const ifx_Matrix_R_t* input,
                      ifx_Matrix_R_t* output)
 {
 #define OP(elem) elem* scale
-    MAT_APPLY_UNOP(input, OP, output);
+#define KERNEL(x, y, len) ifx_simd_kernels()->scale_r(x, scale, y, len)
+    MAT_APPLY_UNOP_SIMD(input, OP, KERNEL, output);
+#undef KERNEL
 #undef OP
 }
 
@@ -575,7 +638,9 @@ void ifx_mat_scale_cr(const ifx_Matrix_C_t* input,
                       ifx_Matrix_C_t* output)
 {
 #define OP(elem) ifx_complex_mul_real(elem, scale)
-    MAT_APPLY_UNOP(input, OP, output);
+#define KERNEL(x, y, len) ifx_simd_kernels()->scale_r(x, scale, y, 2 * (len))
+    MAT_APPLY_UNOP_SIMD(input, OP, KERNEL, output);
+#undef KERNEL
 #undef OP
 }
 
@@ -587,7 +652,9 @@ void ifx_mat_mac_r(const ifx_Matrix_R_t* m1,
                    ifx_Matrix_R_t* result)
 {
 #define OP(m1, m2) ((m1) + (scale * (m2)))
-    MAT_APPLY_BINOP(m1, OP, m2, result);
+#define KERNEL(x, y, z, len) ifx_simd_kernels()->mac_r(x, y, scale, z, len)
+    MAT_APPLY_BINOP_SIMD(m1, OP, KERNEL, m2, result);
+#undef KERNEL
 #undef OP
 }
 
@@ -618,8 +685,10 @@ void ifx_mat_abs_r(const ifx_Matrix_R_t* input,
 void ifx_mat_abs_c(const ifx_Matrix_C_t* input,
                    ifx_Matrix_R_t* output)
 {
-#define OP(elem) ifx_complex_abs(elem);
-    MAT_APPLY_UNOP(input, OP, output);
+#define OP(elem) ifx_complex_abs(elem)
+#define KERNEL(x, y, len) ifx_simd_kernels()->abs_c(x, y, len)
+    MAT_APPLY_UNOP_SIMD(input, OP, KERNEL, output);
+#undef KERNEL
 #undef OP
 }
 
@@ -675,6 +744,14 @@ ifx_Float_t ifx_mat_sqsum_r(const ifx_Matrix_R_t* matrix)
 
     ifx_Float_t result = 0;
 
+    if (MAT_ROWS_CONTIGUOUS(matrix))
+    {
+        const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+        for (uint32_t r = 0; r < mRows(matrix); r++)
+            result += kernels->sqsum_r(MAT_ROW_PTR(matrix, r), mCols(matrix));
+        return result;
+    }
+
     for (uint32_t r = 0; r < mRows(matrix); r++)
     {
         for (uint32_t c = 0; c < mCols(matrix); c++)
@@ -695,6 +772,14 @@ ifx_Float_t ifx_mat_sqsum_c(const ifx_Matrix_C_t* matrix)
 
     ifx_Float_t result = 0;
 
+    if (MAT_ROWS_CONTIGUOUS(matrix))
+    {
+        const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+        for (uint32_t r = 0; r < mRows(matrix); r++)
+            result += kernels->sqsum_r(MAT_ROW_PTR(matrix, r), 2 * mCols(matrix));
+        return result;
+    }
+
     for (uint32_t r = 0; r < mRows(matrix); r++)
     {
         for (uint32_t c = 0; c < mCols(matrix); c++)
@@ -33,6 +33,7 @@
 #include "Complex.h"
 #include "Error.h"
 #include "internal/Mda.hpp"
+#include "internal/Simd.h"
 #include "Mda.h"
 #include "Mem.h"
 
@@ -433,3 +434,184 @@ void ifx_mda_clear_c(ifx_Mda_C_t* mda)
     const ifx_Complex_t zero = IFX_COMPLEX_DEF(0, 0);
     mda_clear(mda, zero);
 }
+
+/**
+ * @brief Calls f(offsets, len) for runs of elements of arrays with the same shape
+ *
+ * offsets[k] is the offset of the first element of the run within the k-th
+ * array. If all arrays are contiguous there is a single run covering all
+ * elements. Otherwise, a run is a row (last dimension) if the last stride of
+ * all arrays is 1, or a single element.
+ */
+template <size_t N, class F>
+static void iterate_runs(const uint32_t dimensions, const uint32_t* shape, const size_t* const (&stride)[N], bool contiguous, F f)
+{
+    size_t offsets[N] = {0};
+
+    if (dimensions == 0)
+        return;
+    for (uint32_t dim = 0; dim < dimensions; dim++)
+        if (shape[dim] == 0)
+            return;
+
+    if (contiguous)
+    {
+        size_t elements = 1;
+        for (uint32_t dim = 0; dim < dimensions; dim++)
+            elements *= shape[dim];
+        f(offsets, elements);
+        return;
+    }
+
+    const uint32_t last = dimensions - 1;
+    bool rows = true;
+    for (size_t k = 0; k < N; k++)
+        rows = rows && stride[k][last] == 1;
+    const uint32_t run = rows ? shape[last] : 1;
+
+    uint32_t indices[IFX_MDA_MAX_DIM] = {0};
+    for (;;)
+    {
+        for (size_t k = 0; k < N; k++)
+            offsets[k] = ifx_mda_offset(dimensions, stride[k], indices);
+        f(offsets, run);
+
+        uint32_t dim = last;
+        indices[dim] += run;
+        while (indices[dim] == shape[dim])
+        {
+            if (dim == 0)
+                return;
+            indices[dim] = 0;
+            indices[--dim]++;
+        }
+    }
+}
+
+// elementwise z = op(x, y) for real arrays using a kernel of internal/Simd.h
+template <class Kernel>
+static inline void mda_binop_r(const ifx_Mda_R_t* x, const ifx_Mda_R_t* y, ifx_Mda_R_t* z, Kernel kernel)
+{
+    IFX_ERR_BRK_NULL(x);
+    IFX_ERR_BRK_NULL(y);
+    IFX_ERR_BRK_NULL(z);
+    IFX_ERR_BRK_COND(!IFX_MDA_SAME_SHAPE(x, y) || !IFX_MDA_SAME_SHAPE(x, z), IFX_ERROR_DIMENSION_MISMATCH);
+
+    const size_t* const stride[3] = {IFX_MDA_STRIDE(x), IFX_MDA_STRIDE(y), IFX_MDA_STRIDE(z)};
+    const bool contiguous = mda_is_contiguous(x) && mda_is_contiguous(y) && mda_is_contiguous(z);
+
+    iterate_runs(IFX_MDA_DIMENSIONS(x), IFX_MDA_SHAPE(x), stride, contiguous, [&](const size_t* offsets, size_t len) {
+        kernel(&IFX_MDA_DATA(x)[offsets[0]], &IFX_MDA_DATA(y)[offsets[1]], &IFX_MDA_DATA(z)[offsets[2]], len);
+    });
+}
+
+// elementwise y = op(x) for arrays using a kernel of internal/Simd.h
+template <class MDA_IN, class MDA_OUT, class Kernel>
+static inline void mda_unop(const MDA_IN* x, MDA_OUT* y, Kernel kernel)
+{
+    IFX_ERR_BRK_NULL(x);
+    IFX_ERR_BRK_NULL(y);
+    IFX_ERR_BRK_COND(!IFX_MDA_SAME_SHAPE(x, y), IFX_ERROR_DIMENSION_MISMATCH);
+
+    const size_t* const stride[2] = {IFX_MDA_STRIDE(x), IFX_MDA_STRIDE(y)};
+    const bool contiguous = mda_is_contiguous(x) && mda_is_contiguous(y);
+
+    iterate_runs(IFX_MDA_DIMENSIONS(x), IFX_MDA_SHAPE(x), stride, contiguous, [&](const size_t* offsets, size_t len) {
+        kernel(&IFX_MDA_DATA(x)[offsets[0]], &IFX_MDA_DATA(y)[offsets[1]], len);
+    });
+}
+
+// The kernels operate on float; for double builds the loops below are used.
+static constexpr bool use_kernels = sizeof(ifx_Float_t) == sizeof(float);
+
+static inline float* as_float(ifx_Float_t* x)
+{
+    return reinterpret_cast<float*>(x);
+}
+
+static inline float* as_float(ifx_Complex_t* x)
+{
+    return reinterpret_cast<float*>(x);
+}
+
+static inline const float* as_float(const ifx_Float_t* x)
+{
+    return reinterpret_cast<const float*>(x);
+}
+
+static inline const float* as_float(const ifx_Complex_t* x)
+{
+    return reinterpret_cast<const float*>(x);
+}
+
+void ifx_mda_add_r(const ifx_Mda_R_t* x, const ifx_Mda_R_t* y, ifx_Mda_R_t* z)
+{
+    const auto* kernels = ifx_simd_kernels();
+    mda_binop_r(x, y, z, [kernels](const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* c, size_t len) {
+        if (use_kernels)
+            kernels->add_r(as_float(a), as_float(b), as_float(c), len);
+        else
+            for (size_t i = 0; i < len; i++)
+                c[i] = a[i] + b[i];
+    });
+}
+
+void ifx_mda_sub_r(const ifx_Mda_R_t* x, const ifx_Mda_R_t* y, ifx_Mda_R_t* z)
+{
+    const auto* kernels = ifx_simd_kernels();
+    mda_binop_r(x, y, z, [kernels](const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* c, size_t len) {
+        if (use_kernels)
+            kernels->sub_r(as_float(a), as_float(b), as_float(c), len);
+        else
+            for (size_t i = 0; i < len; i++)
+                c[i] = a[i] - b[i];
+    });
+}
+
+void ifx_mda_mul_r(const ifx_Mda_R_t* x, const ifx_Mda_R_t* y, ifx_Mda_R_t* z)
+{
+    const auto* kernels = ifx_simd_kernels();
+    mda_binop_r(x, y, z, [kernels](const ifx_Float_t* a, const ifx_Float_t* b, ifx_Float_t* c, size_t len) {
+        if (use_kernels)
+            kernels->mul_r(as_float(a), as_float(b), as_float(c), len);
+        else
+            for (size_t i = 0; i < len; i++)
+                c[i] = a[i] * b[i];
+    });
+}
+
+void ifx_mda_scale_r(const ifx_Mda_R_t* x, ifx_Float_t scale, ifx_Mda_R_t* y)
+{
+    const auto* kernels = ifx_simd_kernels();
+    mda_unop(x, y, [kernels, scale](const ifx_Float_t* a, ifx_Float_t* b, size_t len) {
+        if (use_kernels)
+            kernels->scale_r(as_float(a), static_cast<float>(scale), as_float(b), len);
+        else
+            for (size_t i = 0; i < len; i++)
+                b[i] = a[i] * scale;
+    });
+}
+
+void ifx_mda_scale_c(const ifx_Mda_C_t* x, ifx_Float_t scale, ifx_Mda_C_t* y)
+{
+    const auto* kernels = ifx_simd_kernels();
+    mda_unop(x, y, [kernels, scale](const ifx_Complex_t* a, ifx_Complex_t* b, size_t len) {
+        if (use_kernels)
+            kernels->scale_r(as_float(a), static_cast<float>(scale), as_float(b), 2 * len);
+        else
+            for (size_t i = 0; i < len; i++)
+                b[i] = ifx_complex_mul_real(a[i], scale);
+    });
+}
+
+void ifx_mda_abs_c(const ifx_Mda_C_t* x, ifx_Mda_R_t* y)
+{
+    const auto* kernels = ifx_simd_kernels();
+    mda_unop(x, y, [kernels](const ifx_Complex_t* a, ifx_Float_t* b, size_t len) {
+        if (use_kernels)
+            kernels->abs_c(as_float(a), as_float(b), len);
+        else
+            for (size_t i = 0; i < len; i++)
+                b[i] = ifx_complex_abs(a[i]);
+    });
+}
@@ -632,6 +632,71 @@ IFX_DLL_PUBLIC void ifx_mda_clear_r(ifx_Mda_R_t* mda);
  */
 IFX_DLL_PUBLIC void ifx_mda_clear_c(ifx_Mda_C_t* mda);
 
+/**
+ * @brief Elementwise sum z = x + y of real arrays.
+ *
+ * x, y, and z must have the same shapes. z may be identical to x or y.
+ *
+ * @param [in]  x   first summand
+ * @param [in]  y   second summand
+ * @param [out] z   result
+ */
+IFX_DLL_PUBLIC void ifx_mda_add_r(const ifx_Mda_R_t* x, const ifx_Mda_R_t* y, ifx_Mda_R_t* z);
+
+/**
+ * @brief Elementwise difference z = x - y of real arrays.
+ *
+ * x, y, and z must have the same shapes. z may be identical to x or y.
+ *
+ * @param [in]  x   minuend
+ * @param [in]  y   subtrahend
+ * @param [out] z   result
+ */
+IFX_DLL_PUBLIC void ifx_mda_sub_r(const ifx_Mda_R_t* x, const ifx_Mda_R_t* y, ifx_Mda_R_t* z);
+
+/**
+ * @brief Elementwise product z = x * y of real arrays.
+ *
+ * x, y, and z must have the same shapes. z may be identical to x or y.
+ *
+ * @param [in]  x   first factor
+ * @param [in]  y   second factor (e.g. a window)
+ * @param [out] z   result
+ */
+IFX_DLL_PUBLIC void ifx_mda_mul_r(const ifx_Mda_R_t* x, const ifx_Mda_R_t* y, ifx_Mda_R_t* z);
+
+/**
+ * @brief Scales a real array: y = scale * x.
+ *
+ * x and y must have the same shapes. y may be identical to x.
+ *
+ * @param [in]  x       input array
+ * @param [in]  scale   scaling factor
+ * @param [out] y       result
+ */
+IFX_DLL_PUBLIC void ifx_mda_scale_r(const ifx_Mda_R_t* x, ifx_Float_t scale, ifx_Mda_R_t* y);
+
+/**
+ * @brief Scales a complex array by a real factor: y = scale * x.
+ *
+ * x and y must have the same shapes. y may be identical to x.
+ *
+ * @param [in]  x       input array
+ * @param [in]  scale   scaling factor
+ * @param [out] y       result
+ */
+IFX_DLL_PUBLIC void ifx_mda_scale_c(const ifx_Mda_C_t* x, ifx_Float_t scale, ifx_Mda_C_t* y);
+
+/**
+ * @brief Elementwise absolute value y = |x| of a complex array.
+ *
+ * x and y must have the same shapes.
+ *
+ * @param [in]  x   complex input array
+ * @param [out] y   real result
+ */
+IFX_DLL_PUBLIC void ifx_mda_abs_c(const ifx_Mda_C_t* x, ifx_Mda_R_t* y);
+
 /**
  * @}
  */
@@ -0,0 +1,700 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Error.h"
+#include "Mem.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// Every block handed out by this module is preceded by a header that records
+// where the block came from. This makes ifx_mem_free independent of the
+// backend (and of the thread) that served the allocation.
+#define MEM_HEADER_ALIGNMENT 16U
+
+// minimum alignment of all blocks (alignment of the header)
+#define MEM_MIN_ALIGNMENT MEM_HEADER_ALIGNMENT
+
+// alignment of pool blocks
+#define MEM_POOL_ALIGNMENT 64U
+
+// maximum number of pools registered at the same time
+#define MEM_MAX_POOLS 16
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+namespace {
+
+enum class Origin : uint32_t
+{
+    Heap = 0x48656170,   // "Heap"
+    Arena = 0x4172656e,  // "Aren"
+    Pool = 0x506f6f6c    // "Pool"
+};
+
+struct alignas(MEM_HEADER_ALIGNMENT) Header
+{
+    void* owner;      // pool for Origin::Pool, base pointer for Origin::Heap
+    size_t size;      // requested size in bytes
+    Origin origin;
+};
+
+static_assert(sizeof(Header) % MEM_HEADER_ALIGNMENT == 0, "header size must be a multiple of its alignment");
+
+struct Stats
+{
+    std::atomic<size_t> bytes_in_use {0};
+    std::atomic<size_t> bytes_high_water {0};
+    std::atomic<uint64_t> num_allocations {0};
+    std::atomic<uint64_t> num_frees {0};
+    std::atomic<uint64_t> heap_allocations {0};
+    std::atomic<uint64_t> pool_allocations {0};
+    std::atomic<uint64_t> pool_misses {0};
+    std::atomic<uint64_t> arena_allocations {0};
+    std::atomic<uint64_t> arena_overflows {0};
+    std::atomic<size_t> arena_bytes_in_use {0};
+    std::atomic<size_t> arena_bytes_high_water {0};
+    std::atomic<uint64_t> frame_start {0};
+    std::atomic<uint64_t> last_frame_allocations {0};
+    std::atomic<uint64_t> max_frame_allocations {0};
+};
+
+}  // namespace
+
+struct ifx_Mem_Arena_s
+{
+    uint8_t* buffer;    // start of the arena (aligned to MEM_POOL_ALIGNMENT)
+    void* raw;          // pointer returned by malloc
+    size_t capacity;    // size of buffer in bytes
+    size_t used;        // current fill level
+    size_t high_water;  // maximum fill level
+};
+
+struct ifx_Mem_Pool_s
+{
+    size_t block_size;         // usable size of a block
+    size_t stride;             // distance between two blocks including header
+    uint32_t num_blocks;       // total number of blocks
+    void* raw;                 // pointer returned by malloc
+    std::mutex lock;           // protects free_list
+    std::vector<void*> free_list;
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+static Stats g_stats;
+
+// registered pools; a slot is nullptr if unused
+static std::atomic<ifx_Mem_Pool_t*> g_pools[MEM_MAX_POOLS];
+
+// number of registered pools; allocations skip the pool lookup if zero
+static std::atomic<uint32_t> g_num_pools {0};
+
+// Number of threads currently looking up or allocating from a pool. A
+// thread counts itself in g_pool_users[g_pool_epoch & 1]. To free a pool,
+// ifx_mem_pool_destroy unregisters it, then switches the epoch twice and
+// each time waits for the counter of the previous epoch to drop to 0. New
+// allocations use the other counter, so the wait ends even under load.
+static std::atomic<uint32_t> g_pool_epoch {0};
+static std::atomic<uint32_t> g_pool_users[2];
+
+// serializes ifx_mem_pool_destroy
+static std::mutex g_pool_destroy_lock;
+
+// arena bound to the calling thread
+static thread_local ifx_Mem_Arena_t* t_arena = nullptr;
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static inline uintptr_t align_up(uintptr_t x, size_t alignment)
+{
+    return (x + (alignment - 1)) & ~static_cast<uintptr_t>(alignment - 1);
+}
+
+static inline Header* header_of(void* mem)
+{
+    return static_cast<Header*>(mem) - 1;
+}
+
+static inline void* init_header(uintptr_t user, void* owner, size_t size, Origin origin)
+{
+    auto* header = reinterpret_cast<Header*>(user) - 1;
+    header->owner = owner;
+    header->size = size;
+    header->origin = origin;
+    return reinterpret_cast<void*>(user);
+}
+
+//----------------------------------------------------------------------------
+
+static void stats_on_alloc(std::atomic<uint64_t>& backend_counter)
+{
+    g_stats.num_allocations.fetch_add(1, std::memory_order_relaxed);
+    backend_counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void add_bytes(std::atomic<size_t>& in_use_counter, std::atomic<size_t>& high_water_counter, size_t size)
+{
+    const size_t in_use = in_use_counter.fetch_add(size, std::memory_order_relaxed) + size;
+
+    size_t high_water = high_water_counter.load(std::memory_order_relaxed);
+    while (in_use > high_water && !high_water_counter.compare_exchange_weak(high_water, in_use, std::memory_order_relaxed))
+    {
+    }
+}
+
+static void stats_add_bytes(size_t size)
+{
+    add_bytes(g_stats.bytes_in_use, g_stats.bytes_high_water, size);
+}
+
+//----------------------------------------------------------------------------
+
+static void* heap_alloc(size_t size, size_t alignment)
+{
+    // enough room for the header and for aligning the user pointer
+    const size_t extra = sizeof(Header) + alignment;
+    if (size > SIZE_MAX - extra)
+        return nullptr;
+
+    void* raw = std::malloc(size + extra);
+    if (!raw)
+        return nullptr;
+
+    const uintptr_t user = align_up(reinterpret_cast<uintptr_t>(raw) + sizeof(Header), alignment);
+
+    stats_on_alloc(g_stats.heap_allocations);
+    stats_add_bytes(size);
+    return init_header(user, raw, size, Origin::Heap);
+}
+
+//----------------------------------------------------------------------------
+
+static void* arena_alloc(ifx_Mem_Arena_t* arena, size_t size, size_t alignment)
+{
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(arena->buffer);
+    const uintptr_t user = align_up(begin + arena->used + sizeof(Header), alignment);
+    const size_t offset = user - begin;
+    if (offset > arena->capacity || size > arena->capacity - offset)
+    {
+        g_stats.arena_overflows.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    add_bytes(g_stats.arena_bytes_in_use, g_stats.arena_bytes_high_water, offset + size - arena->used);
+    arena->used = offset + size;
+    arena->high_water = std::max(arena->high_water, arena->used);
+
+    stats_on_alloc(g_stats.arena_allocations);
+    return init_header(user, arena, size, Origin::Arena);
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Mem_Pool_t* find_pool(size_t size, size_t alignment)
+{
+    if (alignment > MEM_POOL_ALIGNMENT)
+        return nullptr;
+
+    ifx_Mem_Pool_t* best = nullptr;
+    for (auto& slot : g_pools)
+    {
+        ifx_Mem_Pool_t* pool = slot.load(std::memory_order_seq_cst);
+        if (!pool || size > pool->block_size || size <= pool->block_size / 2)
+            continue;
+
+        if (!best || pool->block_size < best->block_size)
+            best = pool;
+    }
+
+    return best;
+}
+
+static void* pool_alloc(ifx_Mem_Pool_t* pool, size_t size)
+{
+    void* mem = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(pool->lock);
+        if (!pool->free_list.empty())
+        {
+            mem = pool->free_list.back();
+            pool->free_list.pop_back();
+        }
+    }
+
+    if (!mem)
+    {
+        g_stats.pool_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    stats_on_alloc(g_stats.pool_allocations);
+    stats_add_bytes(size);
+    return init_header(reinterpret_cast<uintptr_t>(mem), pool, size, Origin::Pool);
+}
+
+static bool register_pool(ifx_Mem_Pool_t* pool)
+{
+    for (auto& slot : g_pools)
+    {
+        ifx_Mem_Pool_t* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, pool, std::memory_order_seq_cst))
+        {
+            g_num_pools.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool unregister_pool(ifx_Mem_Pool_t* pool)
+{
+    for (auto& slot : g_pools)
+    {
+        ifx_Mem_Pool_t* expected = pool;
+        if (slot.compare_exchange_strong(expected, nullptr, std::memory_order_seq_cst))
+        {
+            g_num_pools.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------
+
+static void wait_for_pool_users()
+{
+    for (int i = 0; i < 2; i++)
+    {
+        const uint32_t previous = g_pool_epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+        while (g_pool_users[previous].load(std::memory_order_seq_cst) != 0)
+            std::this_thread::yield();
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void* mem_pool_alloc(size_t size, size_t alignment)
+{
+    if (g_num_pools.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    // announce the lookup before reading the registry such that
+    // ifx_mem_pool_destroy waits for it
+    auto& users = g_pool_users[g_pool_epoch.load(std::memory_order_seq_cst) & 1];
+    users.fetch_add(1, std::memory_order_seq_cst);
+
+    void* mem = nullptr;
+    ifx_Mem_Pool_t* pool = find_pool(size, alignment);
+    if (pool)
+        mem = pool_alloc(pool, size);
+
+    users.fetch_sub(1, std::memory_order_release);
+    return mem;
+}
+
+//----------------------------------------------------------------------------
+
+static void* mem_alloc(size_t size, size_t alignment)
+{
+    alignment = std::max<size_t>(alignment, MEM_MIN_ALIGNMENT);
+
+    void* mem = mem_pool_alloc(size, alignment);
+    if (mem)
+        return mem;
+
+    return heap_alloc(size, alignment);
+}
+
+//----------------------------------------------------------------------------
+
+static void* mem_arena_alloc(ifx_Mem_Arena_t* arena, size_t size, size_t alignment)
+{
+    alignment = std::max<size_t>(alignment, MEM_MIN_ALIGNMENT);
+
+    if (arena)
+    {
+        void* mem = arena_alloc(arena, size, alignment);
+        if (mem)
+            return mem;
+    }
+
+    return heap_alloc(size, alignment);
+}
+
+//----------------------------------------------------------------------------
+
+static void mem_free(void* mem)
+{
+    if (!mem)
+        return;
+
+    Header* header = header_of(mem);
+    g_stats.num_frees.fetch_add(1, std::memory_order_relaxed);
+
+    switch (header->origin)
+    {
+        case Origin::Heap:
+            g_stats.bytes_in_use.fetch_sub(header->size, std::memory_order_relaxed);
+            std::free(header->owner);
+            break;
+
+        case Origin::Pool: {
+            auto* pool = static_cast<ifx_Mem_Pool_t*>(header->owner);
+            g_stats.bytes_in_use.fetch_sub(header->size, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> guard(pool->lock);
+            pool->free_list.push_back(mem);
+            break;
+        }
+
+        case Origin::Arena:
+            // released by ifx_mem_arena_reset
+            break;
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void* ifx_mem_alloc(size_t size)
+{
+    return mem_alloc(size, MEM_MIN_ALIGNMENT);
+}
+
+//----------------------------------------------------------------------------
+
+void* ifx_mem_calloc(size_t count,
+                     size_t element_size)
+{
+    if (element_size && count > SIZE_MAX / element_size)
+        return nullptr;
+
+    const size_t size = count * element_size;
+    void* mem = mem_alloc(size, MEM_MIN_ALIGNMENT);
+    if (mem)
+        std::memset(mem, 0, size);
+    return mem;
+}
+
+//----------------------------------------------------------------------------
+
+void* ifx_mem_aligned_alloc(size_t size,
+                            size_t alignment)
+{
+    // alignment must be a power of two
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        return nullptr;
+
+    return mem_alloc(size, alignment);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_free(void* mem)
+{
+    mem_free(mem);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_aligned_free(void* mem)
+{
+    mem_free(mem);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Mem_Arena_t* ifx_mem_arena_create(size_t capacity)
+{
+    IFX_ERR_BRV_COND(capacity > SIZE_MAX - MEM_POOL_ALIGNMENT, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, nullptr);
+
+    // The arena descriptor and buffer always come from the heap, even if
+    // another arena is bound to this thread.
+    auto* arena = static_cast<ifx_Mem_Arena_t*>(std::calloc(1, sizeof(ifx_Mem_Arena_t)));
+    IFX_ERR_BRV_MEMALLOC(arena, nullptr);
+
+    arena->raw = std::malloc(capacity + MEM_POOL_ALIGNMENT);
+    if (!arena->raw)
+    {
+        std::free(arena);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return nullptr;
+    }
+
+    arena->buffer = reinterpret_cast<uint8_t*>(align_up(reinterpret_cast<uintptr_t>(arena->raw), MEM_POOL_ALIGNMENT));
+    arena->capacity = capacity;
+    return arena;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_arena_destroy(ifx_Mem_Arena_t* arena)
+{
+    if (!arena)
+        return;
+
+    if (t_arena == arena)
+        t_arena = nullptr;
+
+    g_stats.arena_bytes_in_use.fetch_sub(arena->used, std::memory_order_relaxed);
+    std::free(arena->raw);
+    std::free(arena);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Mem_Arena_t* ifx_mem_arena_bind(ifx_Mem_Arena_t* arena)
+{
+    ifx_Mem_Arena_t* previous = t_arena;
+    t_arena = arena;
+    return previous;
+}
+
+//----------------------------------------------------------------------------
+
+void* ifx_mem_arena_alloc(ifx_Mem_Arena_t* arena, size_t size, size_t alignment)
+{
+    // alignment must be a power of two
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        return nullptr;
+
+    return mem_arena_alloc(arena, size, alignment);
+}
+
+//----------------------------------------------------------------------------
+
+void* ifx_mem_scratch_alloc(size_t size)
+{
+    return mem_arena_alloc(t_arena, size, MEM_MIN_ALIGNMENT);
+}
+
+//----------------------------------------------------------------------------
+
+size_t ifx_mem_arena_mark(const ifx_Mem_Arena_t* arena)
+{
+    IFX_ERR_BRV_NULL(arena, 0);
+    return arena->used;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_arena_reset(ifx_Mem_Arena_t* arena, size_t mark)
+{
+    IFX_ERR_BRK_NULL(arena);
+    IFX_ERR_BRK_COND(mark > arena->used, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    g_stats.arena_bytes_in_use.fetch_sub(arena->used - mark, std::memory_order_relaxed);
+    arena->used = mark;
+}
+
+//----------------------------------------------------------------------------
+
+size_t ifx_mem_arena_high_water(const ifx_Mem_Arena_t* arena)
+{
+    IFX_ERR_BRV_NULL(arena, 0);
+    return arena->high_water;
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Mem_Pool_t* ifx_mem_pool_create(size_t block_size, uint32_t num_blocks)
+{
+    IFX_ERR_BRV_COND(block_size == 0 || num_blocks == 0, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, nullptr);
+
+    // header in front of each block, block start aligned to MEM_POOL_ALIGNMENT
+    const size_t header_size = align_up(sizeof(Header), MEM_POOL_ALIGNMENT);
+    IFX_ERR_BRV_COND(block_size > SIZE_MAX / 2, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, nullptr);
+    const size_t stride = align_up(header_size + block_size, MEM_POOL_ALIGNMENT);
+    IFX_ERR_BRV_COND(stride > (SIZE_MAX - MEM_POOL_ALIGNMENT) / num_blocks, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, nullptr);
+
+    ifx_Mem_Pool_t* pool = nullptr;
+    try
+    {
+        pool = new ifx_Mem_Pool_t;
+        pool->free_list.reserve(num_blocks);
+    }
+    catch (...)
+    {
+        delete pool;
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return nullptr;
+    }
+
+    pool->block_size = block_size;
+    pool->stride = stride;
+    pool->num_blocks = num_blocks;
+    pool->raw = std::malloc(stride * num_blocks + MEM_POOL_ALIGNMENT);
+    if (!pool->raw)
+    {
+        delete pool;
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return nullptr;
+    }
+
+    // push the blocks in reverse order such that the first block is handed out first
+    const uintptr_t first = align_up(reinterpret_cast<uintptr_t>(pool->raw), MEM_POOL_ALIGNMENT) + header_size;
+    for (uint32_t i = num_blocks; i > 0; i--)
+        pool->free_list.push_back(reinterpret_cast<void*>(first + (i - 1) * stride));
+
+    if (register_pool(pool))
+        return pool;
+
+    // no free slot
+    std::free(pool->raw);
+    delete pool;
+    ifx_error_set(IFX_ERROR_NOT_POSSIBLE);
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_pool_destroy(ifx_Mem_Pool_t* pool)
+{
+    if (!pool)
+        return;
+
+    IFX_ERR_BRK_COND(ifx_mem_pool_blocks_in_use(pool) != 0, IFX_ERROR_NOT_POSSIBLE);
+
+    // Unregister the pool first so that no new allocation can find it, then
+    // wait until all allocations that might have found it before are done.
+    // Blocks handed out in the meantime keep the pool alive.
+    std::lock_guard<std::mutex> guard(g_pool_destroy_lock);
+    const bool registered = unregister_pool(pool);
+    wait_for_pool_users();
+
+    if (ifx_mem_pool_blocks_in_use(pool) != 0)
+    {
+        if (registered)
+            register_pool(pool);
+        ifx_error_set(IFX_ERROR_NOT_POSSIBLE);
+        return;
+    }
+
+    std::free(pool->raw);
+    delete pool;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_mem_pool_blocks_in_use(const ifx_Mem_Pool_t* pool)
+{
+    IFX_ERR_BRV_NULL(pool, 0);
+
+    auto* p = const_cast<ifx_Mem_Pool_t*>(pool);
+    std::lock_guard<std::mutex> guard(p->lock);
+    return p->num_blocks - static_cast<uint32_t>(p->free_list.size());
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_get_stats(ifx_Mem_Stats_t* stats)
+{
+    IFX_ERR_BRK_NULL(stats);
+
+    stats->bytes_in_use = g_stats.bytes_in_use.load(std::memory_order_relaxed);
+    stats->bytes_high_water = g_stats.bytes_high_water.load(std::memory_order_relaxed);
+    stats->num_allocations = g_stats.num_allocations.load(std::memory_order_relaxed);
+    stats->num_frees = g_stats.num_frees.load(std::memory_order_relaxed);
+    stats->heap_allocations = g_stats.heap_allocations.load(std::memory_order_relaxed);
+    stats->pool_allocations = g_stats.pool_allocations.load(std::memory_order_relaxed);
+    stats->pool_misses = g_stats.pool_misses.load(std::memory_order_relaxed);
+    stats->arena_allocations = g_stats.arena_allocations.load(std::memory_order_relaxed);
+    stats->arena_overflows = g_stats.arena_overflows.load(std::memory_order_relaxed);
+    stats->arena_bytes_in_use = g_stats.arena_bytes_in_use.load(std::memory_order_relaxed);
+    stats->arena_bytes_high_water = g_stats.arena_bytes_high_water.load(std::memory_order_relaxed);
+    stats->last_frame_allocations = g_stats.last_frame_allocations.load(std::memory_order_relaxed);
+    stats->max_frame_allocations = g_stats.max_frame_allocations.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_reset_stats(void)
+{
+    g_stats.bytes_high_water.store(g_stats.bytes_in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    g_stats.num_allocations.store(0, std::memory_order_relaxed);
+    g_stats.num_frees.store(0, std::memory_order_relaxed);
+    g_stats.heap_allocations.store(0, std::memory_order_relaxed);
+    g_stats.pool_allocations.store(0, std::memory_order_relaxed);
+    g_stats.pool_misses.store(0, std::memory_order_relaxed);
+    g_stats.arena_allocations.store(0, std::memory_order_relaxed);
+    g_stats.arena_overflows.store(0, std::memory_order_relaxed);
+    g_stats.arena_bytes_high_water.store(g_stats.arena_bytes_in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    g_stats.frame_start.store(0, std::memory_order_relaxed);
+    g_stats.last_frame_allocations.store(0, std::memory_order_relaxed);
+    g_stats.max_frame_allocations.store(0, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_stats_next_frame(void)
+{
+    const uint64_t now = g_stats.num_allocations.load(std::memory_order_relaxed);
+    const uint64_t frame_allocations = now - g_stats.frame_start.exchange(now, std::memory_order_relaxed);
+
+    g_stats.last_frame_allocations.store(frame_allocations, std::memory_order_relaxed);
+
+    uint64_t max = g_stats.max_frame_allocations.load(std::memory_order_relaxed);
+    while (frame_allocations > max && !g_stats.max_frame_allocations.compare_exchange_weak(max, frame_allocations, std::memory_order_relaxed))
+    {
+    }
+}
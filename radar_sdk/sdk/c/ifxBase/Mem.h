@@ -74,6 +74,42 @@ extern "C"
 ==============================================================================
 */
 
+/**
+ * @brief Forward declaration of an arena (bump allocator).
+ */
+typedef struct ifx_Mem_Arena_s ifx_Mem_Arena_t;
+
+/**
+ * @brief Forward declaration of a pool of fixed-size blocks.
+ */
+typedef struct ifx_Mem_Pool_s ifx_Mem_Pool_t;
+
+/**
+ * @brief Allocation statistics.
+ *
+ * All counters refer to allocations made by the functions of this module
+ * since the last call to \ref ifx_mem_reset_stats (or since the library was
+ * loaded). Memory taken from arenas is counted separately from
+ * bytes_in_use because it is released by \ref ifx_mem_arena_reset and not
+ * by \ref ifx_mem_free.
+ */
+typedef struct
+{
+    size_t bytes_in_use;              /**< Bytes currently allocated from the heap and from pools. */
+    size_t bytes_high_water;          /**< Maximum of bytes_in_use. */
+    uint64_t num_allocations;         /**< Total number of allocations. */
+    uint64_t num_frees;               /**< Total number of deallocations. */
+    uint64_t heap_allocations;        /**< Allocations served by the heap. */
+    uint64_t pool_allocations;        /**< Allocations served by a pool. */
+    uint64_t pool_misses;             /**< Allocations matching a pool that was exhausted. */
+    uint64_t arena_allocations;       /**< Allocations served by an arena. */
+    uint64_t arena_overflows;         /**< Allocations not fitting into the arena. */
+    size_t arena_bytes_in_use;        /**< Bytes currently taken from all arenas (including headers and padding). */
+    size_t arena_bytes_high_water;    /**< Maximum of arena_bytes_in_use. */
+    uint64_t last_frame_allocations;  /**< Allocations in the last completed frame (see \ref ifx_mem_stats_next_frame). */
+    uint64_t max_frame_allocations;   /**< Maximum allocations in one frame. */
+} ifx_Mem_Stats_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -90,6 +126,39 @@ extern "C"
  * Supports memory allocation and deallocation
  * as well as aligned allocation and aligned deallocation.
  *
+ * All memory of the SDK (vectors, matrices, cubes, handles) is obtained
+ * through this module. Besides the heap two backends are available that
+ * avoid heap traffic during processing:
+ *
+ * - Arenas: An arena is a preallocated buffer from which memory is taken
+ *   by incrementing an offset. Freeing memory of an arena has no effect;
+ *   the memory is reclaimed by \ref ifx_mem_arena_reset. An arena only
+ *   serves requests that explicitly ask for it: \ref ifx_mem_arena_alloc
+ *   takes memory from the given arena and \ref ifx_mem_scratch_alloc from
+ *   the arena bound to the calling thread with \ref ifx_mem_arena_bind.
+ *   \ref ifx_mem_alloc and the other functions never use an arena, so
+ *   handles, vectors, and buffers an algorithm allocates lazily during
+ *   processing are not released by a reset. A typical use is to take the
+ *   temporaries of one frame from an arena and to reset it afterwards:
+ *   \code
+ *   ifx_mem_arena_bind(arena);
+ *   const size_t mark = ifx_mem_arena_mark(arena);
+ *   float* tmp = ifx_mem_scratch_alloc(num_samples * sizeof(float));
+ *   // ... process the frame using tmp ...
+ *   ifx_mem_arena_reset(arena, mark);  // releases tmp
+ *   ifx_mem_arena_bind(NULL);
+ *   \endcode
+ *
+ * - Pools: A pool holds a fixed number of blocks of the same size. Once
+ *   created, a pool serves all allocations whose size is larger than half
+ *   of the block size and not larger than the block size. This is meant for
+ *   frame-sized buffers that are allocated and released repeatedly. If
+ *   several pools match, the one with the smallest blocks is used. If a
+ *   pool is exhausted the heap is used.
+ *
+ * Memory from all backends is released with \ref ifx_mem_free or
+ * \ref ifx_mem_aligned_free.
+ *
  * @{
  */
 
@@ -152,6 +221,173 @@ void ifx_mem_free(void* mem);
 IFX_DLL_PUBLIC
 void ifx_mem_aligned_free(void* mem);
 
+/**
+ * @brief Creates an arena.
+ *
+ * @param [in]     capacity  Size of the arena in bytes.
+ *
+ * @return Pointer to the arena if successful otherwise it returns NULL.
+ */
+IFX_DLL_PUBLIC
+ifx_Mem_Arena_t* ifx_mem_arena_create(size_t capacity);
+
+/**
+ * @brief Destroys an arena.
+ *
+ * If the arena is bound to the calling thread it is unbound. The arena
+ * must not be bound to any other thread.
+ *
+ * @param [in]     arena     Arena to destroy.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_arena_destroy(ifx_Mem_Arena_t* arena);
+
+/**
+ * @brief Binds an arena to the calling thread.
+ *
+ * Until another arena is bound, \ref ifx_mem_scratch_alloc of the calling
+ * thread is served by the arena. All other allocation functions are not
+ * affected. Pass NULL to unbind the arena. An arena must be bound to at
+ * most one thread at a time.
+ *
+ * @param [in]     arena     Arena to bind or NULL.
+ * @return Previously bound arena or NULL.
+ */
+IFX_DLL_PUBLIC
+ifx_Mem_Arena_t* ifx_mem_arena_bind(ifx_Mem_Arena_t* arena);
+
+/**
+ * @brief Allocates memory from an arena.
+ *
+ * If arena is NULL or exhausted the memory is taken from the heap. The
+ * memory must be released with \ref ifx_mem_free; for memory of the arena
+ * this has no effect and the memory is reclaimed by
+ * \ref ifx_mem_arena_reset. The arena must not be used by another thread
+ * at the same time.
+ *
+ * @param [in]     arena     Arena or NULL.
+ * @param [in]     size      Number of bytes to be allocated.
+ * @param [in]     alignment Alignment (power of two).
+ *
+ * @return Pointer to the allocated memory if successful
+ *         otherwise it returns NULL.
+ */
+IFX_DLL_PUBLIC
+void* ifx_mem_arena_alloc(ifx_Mem_Arena_t* arena, size_t size, size_t alignment);
+
+/**
+ * @brief Allocates temporary memory from the arena bound to the calling thread.
+ *
+ * Same as \ref ifx_mem_arena_alloc with the arena bound by
+ * \ref ifx_mem_arena_bind (the heap if none is bound) and an alignment of
+ * 16 bytes. Use this only for memory that is not needed after the next
+ * reset of the arena.
+ *
+ * @param [in]     size      Number of bytes to be allocated.
+ *
+ * @return Pointer to the allocated memory if successful
+ *         otherwise it returns NULL.
+ */
+IFX_DLL_PUBLIC
+void* ifx_mem_scratch_alloc(size_t size);
+
+/**
+ * @brief Returns the current fill level of the arena.
+ *
+ * The returned value can be passed to \ref ifx_mem_arena_reset to release
+ * all memory allocated after this call.
+ *
+ * @param [in]     arena     Arena.
+ * @return Mark of the current fill level.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_mem_arena_mark(const ifx_Mem_Arena_t* arena);
+
+/**
+ * @brief Releases all memory allocated from the arena after mark was taken.
+ *
+ * @param [in]     arena     Arena.
+ * @param [in]     mark      Mark obtained by \ref ifx_mem_arena_mark; use 0
+ *                           to release all memory.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_arena_reset(ifx_Mem_Arena_t* arena, size_t mark);
+
+/**
+ * @brief Returns the maximum fill level of the arena in bytes.
+ *
+ * Use this to size the arena such that no allocation falls back to the
+ * heap.
+ *
+ * @param [in]     arena     Arena.
+ * @return Maximum number of bytes used since the arena was created.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_mem_arena_high_water(const ifx_Mem_Arena_t* arena);
+
+/**
+ * @brief Creates a pool of fixed-size blocks.
+ *
+ * The pool is registered and serves allocations from then on. The blocks
+ * are aligned to 64 bytes.
+ *
+ * @param [in]     block_size    Size of a block in bytes.
+ * @param [in]     num_blocks    Number of blocks.
+ *
+ * @return Pointer to the pool if successful otherwise it returns NULL.
+ */
+IFX_DLL_PUBLIC
+ifx_Mem_Pool_t* ifx_mem_pool_create(size_t block_size, uint32_t num_blocks);
+
+/**
+ * @brief Destroys a pool.
+ *
+ * The pool can only be destroyed if all blocks have been released,
+ * otherwise the error IFX_ERROR_NOT_POSSIBLE is set and the pool is not
+ * destroyed. Other threads may allocate memory at the same time: the pool
+ * is removed from the registry first and freed only after all allocations
+ * that might use it have completed. If one of them took a block, the pool
+ * is registered again and IFX_ERROR_NOT_POSSIBLE is set.
+ *
+ * @param [in]     pool      Pool to destroy.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_pool_destroy(ifx_Mem_Pool_t* pool);
+
+/**
+ * @brief Returns the number of blocks currently in use.
+ *
+ * @param [in]     pool      Pool.
+ * @return Number of blocks in use.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_mem_pool_blocks_in_use(const ifx_Mem_Pool_t* pool);
+
+/**
+ * @brief Copies the allocation statistics to stats.
+ *
+ * @param [out]    stats     Statistics.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_get_stats(ifx_Mem_Stats_t* stats);
+
+/**
+ * @brief Resets the counters of the allocation statistics.
+ *
+ * bytes_in_use is not changed, bytes_high_water is set to bytes_in_use.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_reset_stats(void);
+
+/**
+ * @brief Marks a frame boundary for the allocation statistics.
+ *
+ * The number of allocations since the previous call is stored in
+ * last_frame_allocations and max_frame_allocations is updated.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_stats_next_frame(void);
+
 /**
  * @}
  */
@@ -0,0 +1,259 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <atomic>
+#include <string>
+
+#include <common/Metrics.hpp>
+
+#include "Error.h"
+#include "Metrics.h"
+#include "internal/Metrics.h"
+#include "internal/Util.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+namespace {
+
+// names of ifx_Metrics_Stage_t
+const char* const stage_names[IFX_METRICS_STAGE_COUNT] = {
+    "fmcw_get_next_frame",
+    "fmcw_frame_conversion",
+    "fmcw_reconnect",
+    "fft",
+    "rdm",
+    "cfar",
+    "dbf",
+};
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+LatencyHistogram& get_stage(ifx_Metrics_Stage_t stage)
+{
+    // registered on first use, the histograms live until the end of the process
+    static std::atomic<LatencyHistogram*> stages[IFX_METRICS_STAGE_COUNT];
+
+    LatencyHistogram* histogram = stages[stage].load(std::memory_order_acquire);
+    if (!histogram)
+    {
+        histogram = &Metrics::instance().latency(stage_names[stage]);
+        stages[stage].store(histogram, std::memory_order_release);
+    }
+
+    return *histogram;
+}
+
+void to_latency(const LatencyHistogram& histogram, ifx_Metrics_Latency_t* latency)
+{
+    const uint64_t count = histogram.getCount();
+
+    latency->name = histogram.getName().c_str();
+    latency->count = count;
+    latency->mean_us = count ? static_cast<double>(histogram.getSum()) / count * 1e-3 : 0;
+    latency->min_us = histogram.getMin() * 1e-3;
+    latency->max_us = histogram.getMax() * 1e-3;
+    latency->p50_us = histogram.getPercentile(0.5) * 1e-3;
+    latency->p90_us = histogram.getPercentile(0.9) * 1e-3;
+    latency->p99_us = histogram.getPercentile(0.99) * 1e-3;
+    latency->p999_us = histogram.getPercentile(0.999) * 1e-3;
+}
+
+char* to_c_string(const std::string& str)
+{
+    char* result = ifx_util_strdup(str.c_str());
+    if (!result)
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+    return result;
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void ifx_metrics_set_enabled(bool enabled)
+{
+    Metrics::setEnabled(enabled);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_metrics_is_enabled(void)
+{
+    return Metrics::isEnabled();
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_metrics_reset(void)
+{
+    Metrics::instance().reset();
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_metrics_get_latency_count(void)
+{
+    return static_cast<uint32_t>(Metrics::instance().getLatencies().size());
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_metrics_get_latency(uint32_t index, ifx_Metrics_Latency_t* latency)
+{
+    IFX_ERR_BRV_NULL(latency, false);
+
+    const auto latencies = Metrics::instance().getLatencies();
+    IFX_ERR_BRV_COND(index >= latencies.size(), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, false);
+
+    to_latency(*latencies[index], latency);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_metrics_find_latency(const char* name, ifx_Metrics_Latency_t* latency)
+{
+    IFX_ERR_BRV_NULL(name, false);
+    IFX_ERR_BRV_NULL(latency, false);
+
+    for (const auto* histogram : Metrics::instance().getLatencies())
+    {
+        if (histogram->getName() == name)
+        {
+            to_latency(*histogram, latency);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_metrics_get_counter_count(void)
+{
+    return static_cast<uint32_t>(Metrics::instance().getCounters().size());
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_metrics_get_counter(uint32_t index, ifx_Metrics_Counter_t* counter)
+{
+    IFX_ERR_BRV_NULL(counter, false);
+
+    const auto counters = Metrics::instance().getCounters();
+    IFX_ERR_BRV_COND(index >= counters.size(), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, false);
+
+    counter->name = counters[index]->getName().c_str();
+    counter->value = counters[index]->get();
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_metrics_get_gauge_count(void)
+{
+    return static_cast<uint32_t>(Metrics::instance().getGauges().size());
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_metrics_get_gauge(uint32_t index, ifx_Metrics_Gauge_t* gauge)
+{
+    IFX_ERR_BRV_NULL(gauge, false);
+
+    const auto gauges = Metrics::instance().getGauges();
+    IFX_ERR_BRV_COND(index >= gauges.size(), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, false);
+
+    gauge->name = gauges[index]->getName().c_str();
+    gauge->value = gauges[index]->get();
+    gauge->max = gauges[index]->getMax();
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+char* ifx_metrics_to_json(void)
+{
+    return to_c_string(Metrics::instance().toJson());
+}
+
+//----------------------------------------------------------------------------
+
+char* ifx_metrics_to_prometheus(void)
+{
+    return to_c_string(Metrics::instance().toPrometheus());
+}
+
+//----------------------------------------------------------------------------
+
+uint64_t ifx_metrics_begin(void)
+{
+    return Metrics::isEnabled() ? Metrics::now() : 0;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_metrics_end(ifx_Metrics_Stage_t stage, uint64_t start)
+{
+    if (start == 0 || stage >= IFX_METRICS_STAGE_COUNT)
+        return;
+
+    get_stage(stage).record(Metrics::now() - start);
+}
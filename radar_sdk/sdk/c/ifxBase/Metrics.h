@@ -0,0 +1,251 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Metrics.h
+ *
+ * \brief \copybrief gr_metrics
+ *
+ * For details refer to \ref gr_metrics
+ */
+
+#ifndef IFX_BASE_METRICS_H
+#define IFX_BASE_METRICS_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Latency statistics of one pipeline stage.
+ *
+ * Percentiles are taken from a histogram with logarithmic buckets, their
+ * relative error is at most 6.25%. All times are in microseconds.
+ */
+typedef struct
+{
+    const char* name;  /**< Name of the stage, valid until the library is unloaded. */
+    uint64_t count;    /**< Number of measurements. */
+    double mean_us;    /**< Mean latency. */
+    double min_us;     /**< Minimum latency. */
+    double max_us;     /**< Maximum latency. */
+    double p50_us;     /**< Median latency. */
+    double p90_us;     /**< 90th percentile. */
+    double p99_us;     /**< 99th percentile. */
+    double p999_us;    /**< 99.9th percentile. */
+} ifx_Metrics_Latency_t;
+
+/**
+ * @brief Value of an event counter (drops, reallocations, ...).
+ */
+typedef struct
+{
+    const char* name;  /**< Name of the counter, valid until the library is unloaded. */
+    uint64_t value;    /**< Number of events. */
+} ifx_Metrics_Counter_t;
+
+/**
+ * @brief Value of a level (e.g. queue depth).
+ */
+typedef struct
+{
+    const char* name;  /**< Name of the gauge, valid until the library is unloaded. */
+    int64_t value;     /**< Current value. */
+    int64_t max;       /**< Maximum value since the last reset. */
+} ifx_Metrics_Gauge_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+ * @{
+ */
+
+/** @defgroup gr_metrics Metrics
+ * @brief API for pipeline latency and throughput metrics
+ *
+ * The acquisition pipeline and the signal processing modules measure
+ * themselves continuously with a monotonic clock:
+ *
+ * - Latencies: bridge_receive (waiting for, reading and handling a packet),
+ *   frame_assembly (first packet until the frame is queued),
+ *   fmcw_get_next_frame, fmcw_frame_conversion, fmcw_reconnect, fft,
+ *   rdm, cfar, dbf.
+ * - Counters: e.g. bridge_packets_lost, frame_pool_depleted,
+ *   frame_pool_reallocations, frame_queue_trimmed.
+ * - Gauges: e.g. frame_queue_depth, frame_pool_available.
+ *
+ * A metric shows up once it has been used for the first time. The
+ * overhead is two clock reads and a few atomic increments per measured
+ * call; collection can be switched off with \ref ifx_metrics_set_enabled.
+ *
+ * The values can be read one by one or exported as JSON or in the
+ * Prometheus text format, e.g. to be served by a monitoring endpoint.
+ * @{
+ */
+
+/**
+ * @brief Enables or disables the collection of latencies.
+ *
+ * Collection is enabled by default. Counters and gauges are always updated.
+ *
+ * @param [in]     enabled   true to collect latencies
+ */
+IFX_DLL_PUBLIC
+void ifx_metrics_set_enabled(bool enabled);
+
+/**
+ * @brief Returns true if latencies are collected.
+ */
+IFX_DLL_PUBLIC
+bool ifx_metrics_is_enabled(void);
+
+/**
+ * @brief Clears all latencies and counters and the maxima of the gauges.
+ */
+IFX_DLL_PUBLIC
+void ifx_metrics_reset(void);
+
+/**
+ * @brief Returns the number of stages with latency statistics.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_metrics_get_latency_count(void);
+
+/**
+ * @brief Reads the latency statistics of a stage.
+ *
+ * @param [in]     index     index of the stage (0 ... \ref ifx_metrics_get_latency_count - 1)
+ * @param [out]    latency   latency statistics
+ * @return true on success, false if index is out of range
+ */
+IFX_DLL_PUBLIC
+bool ifx_metrics_get_latency(uint32_t index, ifx_Metrics_Latency_t* latency);
+
+/**
+ * @brief Reads the latency statistics of a stage given by name.
+ *
+ * @param [in]     name      name of the stage
+ * @param [out]    latency   latency statistics
+ * @return true on success, false if the stage has not been measured yet
+ */
+IFX_DLL_PUBLIC
+bool ifx_metrics_find_latency(const char* name, ifx_Metrics_Latency_t* latency);
+
+/**
+ * @brief Returns the number of counters.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_metrics_get_counter_count(void);
+
+/**
+ * @brief Reads a counter.
+ *
+ * @param [in]     index     index of the counter (0 ... \ref ifx_metrics_get_counter_count - 1)
+ * @param [out]    counter   value of the counter
+ * @return true on success, false if index is out of range
+ */
+IFX_DLL_PUBLIC
+bool ifx_metrics_get_counter(uint32_t index, ifx_Metrics_Counter_t* counter);
+
+/**
+ * @brief Returns the number of gauges.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_metrics_get_gauge_count(void);
+
+/**
+ * @brief Reads a gauge.
+ *
+ * @param [in]     index     index of the gauge (0 ... \ref ifx_metrics_get_gauge_count - 1)
+ * @param [out]    gauge     value of the gauge
+ * @return true on success, false if index is out of range
+ */
+IFX_DLL_PUBLIC
+bool ifx_metrics_get_gauge(uint32_t index, ifx_Metrics_Gauge_t* gauge);
+
+/**
+ * @brief Exports all metrics as JSON object.
+ *
+ * The string must be freed with \ref ifx_mem_free.
+ *
+ * @return JSON string, NULL on error
+ */
+IFX_DLL_PUBLIC
+char* ifx_metrics_to_json(void);
+
+/**
+ * @brief Exports all metrics in the Prometheus text exposition format.
+ *
+ * The string must be freed with \ref ifx_mem_free.
+ *
+ * @return Prometheus text, NULL on error
+ */
+IFX_DLL_PUBLIC
+char* ifx_metrics_to_prometheus(void);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_BASE_METRICS_H */
@@ -0,0 +1,924 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "internal/Simd.h"
+
+#ifdef IFX_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef IFX_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(IFX_HAVE_AVX2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define LOG10_2 0.30102999566398119521f  // log10(2)
+#define LOG10_E 0.43429448190325182765f  // log10(e)
+#define SQRT_2  1.41421356237309504880f  // sqrt(2)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+#ifdef IFX_HAVE_AVX2
+// defined in SimdAvx2.c which is compiled with AVX2 and FMA enabled
+extern const ifx_Simd_Kernels_t ifx_simd_avx2_kernels;
+#endif
+
+// kernel table returned by ifx_simd_kernels; NULL until the first call
+static const ifx_Simd_Kernels_t* volatile selected_kernels = NULL;
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static bool cpu_has_avx2(void);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/* ---------------------------------------------------------------------------
+ * Scalar reference kernels
+ * ------------------------------------------------------------------------ */
+
+static float sum_scalar(const float* x, size_t len)
+{
+    // Kahan summation, see ifx_vec_sum_r
+    float sum = 0;
+    float c = 0;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        const float y = x[i] - c;
+        const float t = sum + y;
+        c = (t - sum) - y;
+        sum = t;
+    }
+
+    return sum;
+}
+
+static float sqsum_scalar(const float* x, size_t len)
+{
+    float result = 0;
+    for (size_t i = 0; i < len; i++)
+        result += x[i] * x[i];
+    return result;
+}
+
+static float dot_scalar(const float* x, const float* y, size_t len)
+{
+    float result = 0;
+    for (size_t i = 0; i < len; i++)
+        result += x[i] * y[i];
+    return result;
+}
+
+static void add_scalar(const float* x, const float* y, float* z, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        z[i] = x[i] + y[i];
+}
+
+static void sub_scalar(const float* x, const float* y, float* z, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        z[i] = x[i] - y[i];
+}
+
+static void mul_scalar(const float* x, const float* y, float* z, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        z[i] = x[i] * y[i];
+}
+
+static void scale_scalar(const float* x, float scale, float* y, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        y[i] = x[i] * scale;
+}
+
+static void mac_scalar(const float* x, const float* y, float scale, float* z, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        z[i] = x[i] + scale * y[i];
+}
+
+static void clip_scalar(const float* x, float min_value, float max_value, float* y, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        const float v = x[i] < min_value ? min_value : x[i];
+        y[i] = v > max_value ? max_value : v;
+    }
+}
+
+static void max_scalar(const float* x, const float* y, float* z, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        z[i] = (x[i] > y[i]) ? x[i] : y[i];
+}
+
+static void mul_c_scalar(const float* x, const float* y, float* z, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        const float xr = x[2 * i], xi = x[2 * i + 1];
+        const float yr = y[2 * i], yi = y[2 * i + 1];
+        z[2 * i] = xr * yr - xi * yi;
+        z[2 * i + 1] = xr * yi + xi * yr;
+    }
+}
+
+static void mul_cr_scalar(const float* x, const float* w, float* z, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        z[2 * i] = x[2 * i] * w[i];
+        z[2 * i + 1] = x[2 * i + 1] * w[i];
+    }
+}
+
+static void abs_c_scalar(const float* x, float* y, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        y[i] = sqrtf(x[2 * i] * x[2 * i] + x[2 * i + 1] * x[2 * i + 1]);
+}
+
+static void sqnorm_c_scalar(const float* x, float* y, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        y[i] = x[2 * i] * x[2 * i] + x[2 * i + 1] * x[2 * i + 1];
+}
+
+static void pow2db_scalar(float* x, float scale, float threshold2, float clip_value, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        x[i] = (x[i] < threshold2) ? clip_value : scale * log10f(x[i]);
+}
+
+static size_t local_max_scalar(const float* x, size_t begin, size_t end, float threshold, uint32_t* index)
+{
+    size_t count = 0;
+    for (size_t i = begin; i < end; i++)
+    {
+        const float v = x[i];
+        if (v >= threshold && v >= x[i - 2] && v >= x[i - 1] && v > x[i + 1] && v > x[i + 2])
+            index[count++] = (uint32_t)i;
+    }
+    return count;
+}
+
+static const ifx_Simd_Kernels_t scalar_kernels = {
+    IFX_SIMD_ISA_SCALAR,
+    "scalar",
+    sum_scalar,
+    sqsum_scalar,
+    dot_scalar,
+    add_scalar,
+    sub_scalar,
+    mul_scalar,
+    scale_scalar,
+    mac_scalar,
+    clip_scalar,
+    max_scalar,
+    mul_c_scalar,
+    mul_cr_scalar,
+    abs_c_scalar,
+    sqnorm_c_scalar,
+    pow2db_scalar,
+    local_max_scalar,
+};
+
+#ifdef IFX_SSE2
+/* ---------------------------------------------------------------------------
+ * SSE2 kernels
+ *
+ * SSE2 is part of x86-64, so these kernels are always available on x86-64.
+ * The tails (len not divisible by 4) are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+/**
+ * @brief Computes log10(x) for 4 positive floats
+ *
+ * The argument is split into exponent e and mantissa m in [sqrt(1/2), sqrt(2)).
+ * ln(m) is evaluated with the series 2*atanh(t) with t=(m-1)/(m+1), |t|<0.172,
+ * truncated after the t^9 term. The relative error is below 1e-7 which is at
+ * the level of the float precision. Arguments smaller than FLT_MIN (including
+ * zero and denormals) are treated as FLT_MIN.
+ */
+static __m128 log10_sse2(__m128 x)
+{
+    x = _mm_max_ps(x, _mm_set1_ps(FLT_MIN));
+
+    const __m128i bits = _mm_castps_si128(x);
+    __m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+
+    // move m from [1,2) to [sqrt(1/2), sqrt(2))
+    const __m128 big = _mm_cmpgt_ps(m, _mm_set1_ps(SQRT_2));
+    m = _mm_or_ps(_mm_and_ps(big, _mm_mul_ps(m, _mm_set1_ps(0.5f))), _mm_andnot_ps(big, m));
+    e = _mm_sub_epi32(e, _mm_castps_si128(big));  // big is -1 (all bits set) where true
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 t = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+    const __m128 t2 = _mm_mul_ps(t, t);
+
+    __m128 p = _mm_set1_ps(1.0f / 9);
+    p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f / 7));
+    p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f / 5));
+    p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f / 3));
+    p = _mm_add_ps(_mm_mul_ps(p, t2), one);
+    const __m128 ln_m = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), t), p);
+
+    return _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(e), _mm_set1_ps(LOG10_2)),
+                      _mm_mul_ps(ln_m, _mm_set1_ps(LOG10_E)));
+}
+
+static float hsum_sse2(__m128 v)
+{
+    float r = vf32x4_extract1(v, 0);
+    r += vf32x4_extract1(v, 1);
+    r += vf32x4_extract1(v, 2);
+    r += vf32x4_extract1(v, 3);
+    return r;
+}
+
+static float sum_sse2(const float* x, size_t len)
+{
+    // Kahan summation in each lane
+    const size_t n4 = len & ~(size_t)3;
+    __m128 sum = _mm_setzero_ps();
+    __m128 c = _mm_setzero_ps();
+
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m128 y = _mm_sub_ps(_mm_loadu_ps(&x[i]), c);
+        const __m128 t = _mm_add_ps(sum, y);
+        c = _mm_sub_ps(_mm_sub_ps(t, sum), y);
+        sum = t;
+    }
+
+    float lanes[8];
+    _mm_storeu_ps(&lanes[0], sum);
+    _mm_storeu_ps(&lanes[4], _mm_sub_ps(_mm_setzero_ps(), c));
+    return sum_scalar(lanes, 8) + sum_scalar(&x[n4], len - n4);
+}
+
+static float sqsum_sse2(const float* x, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m128 x0 = _mm_loadu_ps(&x[i]);
+        const __m128 x1 = _mm_loadu_ps(&x[i + 4]);
+        acc0 = vf32x4_mla(acc0, x0, x0);
+        acc1 = vf32x4_mla(acc1, x1, x1);
+    }
+
+    return hsum_sse2(_mm_add_ps(acc0, acc1)) + sqsum_scalar(&x[n8], len - n8);
+}
+
+static float dot_sse2(const float* x, const float* y, size_t len)
+{
+    // len rounded down to the next integer divisable by 16
+    const size_t n16 = len & ~(size_t)15;
+
+    // Use four SSE2 vectors with 4 elements each to utilize the CPU pipeline
+    // as much as possible.
+    __m128 vv0 = _mm_setzero_ps();
+    __m128 vv1 = _mm_setzero_ps();
+    __m128 vv2 = _mm_setzero_ps();
+    __m128 vv3 = _mm_setzero_ps();
+
+    for (size_t i = 0; i < n16; i += 16)
+    {
+        vv0 = vf32x4_mla(vv0, _mm_loadu_ps(&x[i + 0]), _mm_loadu_ps(&y[i + 0]));
+        vv1 = vf32x4_mla(vv1, _mm_loadu_ps(&x[i + 4]), _mm_loadu_ps(&y[i + 4]));
+        vv2 = vf32x4_mla(vv2, _mm_loadu_ps(&x[i + 8]), _mm_loadu_ps(&y[i + 8]));
+        vv3 = vf32x4_mla(vv3, _mm_loadu_ps(&x[i + 12]), _mm_loadu_ps(&y[i + 12]));
+    }
+
+    const __m128 vv = _mm_add_ps(_mm_add_ps(vv0, vv1), _mm_add_ps(vv2, vv3));
+    return hsum_sse2(vv) + dot_scalar(&x[n16], &y[n16], len - n16);
+}
+
+static void add_sse2(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        _mm_storeu_ps(&z[i], _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&y[i])));
+    add_scalar(&x[n4], &y[n4], &z[n4], len - n4);
+}
+
+static void sub_sse2(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        _mm_storeu_ps(&z[i], _mm_sub_ps(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&y[i])));
+    sub_scalar(&x[n4], &y[n4], &z[n4], len - n4);
+}
+
+static void mul_sse2(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        _mm_storeu_ps(&z[i], _mm_mul_ps(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&y[i])));
+    mul_scalar(&x[n4], &y[n4], &z[n4], len - n4);
+}
+
+static void scale_sse2(const float* x, float scale, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const __m128 s = _mm_set1_ps(scale);
+    for (size_t i = 0; i < n4; i += 4)
+        _mm_storeu_ps(&y[i], _mm_mul_ps(_mm_loadu_ps(&x[i]), s));
+    scale_scalar(&x[n4], scale, &y[n4], len - n4);
+}
+
+static void mac_sse2(const float* x, const float* y, float scale, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const __m128 s = _mm_set1_ps(scale);
+    for (size_t i = 0; i < n4; i += 4)
+        _mm_storeu_ps(&z[i], vf32x4_mla(_mm_loadu_ps(&x[i]), s, _mm_loadu_ps(&y[i])));
+    mac_scalar(&x[n4], &y[n4], scale, &z[n4], len - n4);
+}
+
+static void clip_sse2(const float* x, float min_value, float max_value, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const __m128 lo = _mm_set1_ps(min_value);
+    const __m128 hi = _mm_set1_ps(max_value);
+    for (size_t i = 0; i < n4; i += 4)
+        _mm_storeu_ps(&y[i], _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&x[i]), lo), hi));
+    clip_scalar(&x[n4], min_value, max_value, &y[n4], len - n4);
+}
+
+static void max_sse2(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        _mm_storeu_ps(&z[i], _mm_max_ps(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&y[i])));
+    max_scalar(&x[n4], &y[n4], &z[n4], len - n4);
+}
+
+static void mul_c_sse2(const float* x, const float* y, float* z, size_t len)
+{
+    // two complex numbers per register: (r0, i0, r1, i1)
+    const size_t n2 = len & ~(size_t)1;
+    const __m128 sign = _mm_set_ps(1.0f, -1.0f, 1.0f, -1.0f);
+    for (size_t i = 0; i < n2; i += 2)
+    {
+        const __m128 a = _mm_loadu_ps(&x[2 * i]);
+        const __m128 b = _mm_loadu_ps(&y[2 * i]);
+        const __m128 a_re = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 a_im = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 1, 1));
+        const __m128 b_swap = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+        // (ar*br - ai*bi, ar*bi + ai*br)
+        const __m128 r = _mm_add_ps(_mm_mul_ps(a_re, b), _mm_mul_ps(_mm_mul_ps(a_im, b_swap), sign));
+        _mm_storeu_ps(&z[2 * i], r);
+    }
+    mul_c_scalar(&x[2 * n2], &y[2 * n2], &z[2 * n2], len - n2);
+}
+
+static void mul_cr_sse2(const float* x, const float* w, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m128 wv = _mm_loadu_ps(&w[i]);
+        const __m128 w_lo = _mm_unpacklo_ps(wv, wv);  // (w0, w0, w1, w1)
+        const __m128 w_hi = _mm_unpackhi_ps(wv, wv);  // (w2, w2, w3, w3)
+        _mm_storeu_ps(&z[2 * i], _mm_mul_ps(_mm_loadu_ps(&x[2 * i]), w_lo));
+        _mm_storeu_ps(&z[2 * i + 4], _mm_mul_ps(_mm_loadu_ps(&x[2 * i + 4]), w_hi));
+    }
+    mul_cr_scalar(&x[2 * n4], &w[n4], &z[2 * n4], len - n4);
+}
+
+static __m128 sqnorm4_sse2(const float* x)
+{
+    const __m128 a = _mm_loadu_ps(&x[0]);  // (r0, i0, r1, i1)
+    const __m128 b = _mm_loadu_ps(&x[4]);  // (r2, i2, r3, i3)
+    const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    return _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+}
+
+static void abs_c_sse2(const float* x, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        _mm_storeu_ps(&y[i], _mm_sqrt_ps(sqnorm4_sse2(&x[2 * i])));
+    abs_c_scalar(&x[2 * n4], &y[n4], len - n4);
+}
+
+static void sqnorm_c_sse2(const float* x, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        _mm_storeu_ps(&y[i], sqnorm4_sse2(&x[2 * i]));
+    sqnorm_c_scalar(&x[2 * n4], &y[n4], len - n4);
+}
+
+static void pow2db_sse2(float* x, float scale, float threshold2, float clip_value, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 th = _mm_set1_ps(threshold2);
+    const __m128 cv = _mm_set1_ps(clip_value);
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m128 v = _mm_loadu_ps(&x[i]);
+        const __m128 clipped = _mm_cmplt_ps(v, th);
+        const __m128 db = _mm_mul_ps(s, log10_sse2(v));
+        _mm_storeu_ps(&x[i], _mm_or_ps(_mm_and_ps(clipped, cv), _mm_andnot_ps(clipped, db)));
+    }
+    pow2db_scalar(&x[n4], scale, threshold2, clip_value, len - n4);
+}
+
+static size_t local_max_sse2(const float* x, size_t begin, size_t end, float threshold, uint32_t* index)
+{
+    const __m128 th = _mm_set1_ps(threshold);
+    size_t count = 0;
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        const __m128 v = _mm_loadu_ps(&x[i]);
+        __m128 m = _mm_cmpge_ps(v, th);
+        m = _mm_and_ps(m, _mm_cmpge_ps(v, _mm_loadu_ps(&x[i - 2])));
+        m = _mm_and_ps(m, _mm_cmpge_ps(v, _mm_loadu_ps(&x[i - 1])));
+        m = _mm_and_ps(m, _mm_cmpgt_ps(v, _mm_loadu_ps(&x[i + 1])));
+        m = _mm_and_ps(m, _mm_cmpgt_ps(v, _mm_loadu_ps(&x[i + 2])));
+
+        // peaks are sparse, so most iterations end here
+        const int bits = _mm_movemask_ps(m);
+        if (bits == 0)
+            continue;
+        for (int b = 0; b < 4; b++)
+        {
+            if (bits & (1 << b))
+                index[count++] = (uint32_t)(i + b);
+        }
+    }
+    return count + local_max_scalar(x, i, end, threshold, &index[count]);
+}
+
+static const ifx_Simd_Kernels_t sse2_kernels = {
+    IFX_SIMD_ISA_SSE2,
+    "sse2",
+    sum_sse2,
+    sqsum_sse2,
+    dot_sse2,
+    add_sse2,
+    sub_sse2,
+    mul_sse2,
+    scale_sse2,
+    mac_sse2,
+    clip_sse2,
+    max_sse2,
+    mul_c_sse2,
+    mul_cr_sse2,
+    abs_c_sse2,
+    sqnorm_c_sse2,
+    pow2db_sse2,
+    local_max_sse2,
+};
+#endif /* IFX_SSE2 */
+
+#ifdef IFX_NEON
+/* ---------------------------------------------------------------------------
+ * NEON kernels
+ *
+ * The tails (len not divisible by 4) are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+/**
+ * @brief Computes log10(x) for 4 positive floats
+ *
+ * Same algorithm as log10_sse2.
+ */
+static float32x4_t log10_neon(float32x4_t x)
+{
+    x = vmaxq_f32(x, vdupq_n_f32(FLT_MIN));
+
+    const uint32x4_t bits = vreinterpretq_u32_f32(x);
+    int32x4_t e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127));
+    float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007fffff)), vdupq_n_u32(0x3f800000)));
+
+    const uint32x4_t big = vcgtq_f32(m, vdupq_n_f32(SQRT_2));
+    m = vbslq_f32(big, vmulq_n_f32(m, 0.5f), m);
+    e = vsubq_s32(e, vreinterpretq_s32_u32(big));
+
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t num = vsubq_f32(m, one);
+    const float32x4_t den = vaddq_f32(m, one);
+    // reciprocal estimate refined by two Newton-Raphson steps
+    float32x4_t rec = vrecpeq_f32(den);
+    rec = vmulq_f32(vrecpsq_f32(den, rec), rec);
+    rec = vmulq_f32(vrecpsq_f32(den, rec), rec);
+    const float32x4_t t = vmulq_f32(num, rec);
+    const float32x4_t t2 = vmulq_f32(t, t);
+
+    float32x4_t p = vdupq_n_f32(1.0f / 9);
+    p = vmlaq_f32(vdupq_n_f32(1.0f / 7), p, t2);
+    p = vmlaq_f32(vdupq_n_f32(1.0f / 5), p, t2);
+    p = vmlaq_f32(vdupq_n_f32(1.0f / 3), p, t2);
+    p = vmlaq_f32(one, p, t2);
+    const float32x4_t ln_m = vmulq_f32(vmulq_n_f32(t, 2.0f), p);
+
+    return vmlaq_n_f32(vmulq_n_f32(vcvtq_f32_s32(e), LOG10_2), ln_m, LOG10_E);
+}
+
+static float hsum_neon(float32x4_t v)
+{
+    float32x2_t r = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(r, r), 0);
+}
+
+static float sum_neon(const float* x, size_t len)
+{
+    // Kahan summation in each lane
+    const size_t n4 = len & ~(size_t)3;
+    float32x4_t sum = vdupq_n_f32(0);
+    float32x4_t c = vdupq_n_f32(0);
+
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const float32x4_t y = vsubq_f32(vld1q_f32(&x[i]), c);
+        const float32x4_t t = vaddq_f32(sum, y);
+        c = vsubq_f32(vsubq_f32(t, sum), y);
+        sum = t;
+    }
+
+    float lanes[8];
+    vst1q_f32(&lanes[0], sum);
+    vst1q_f32(&lanes[4], vnegq_f32(c));
+    return sum_scalar(lanes, 8) + sum_scalar(&x[n4], len - n4);
+}
+
+static float sqsum_neon(const float* x, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const float32x4_t x0 = vld1q_f32(&x[i]);
+        const float32x4_t x1 = vld1q_f32(&x[i + 4]);
+        acc0 = vmlaq_f32(acc0, x0, x0);
+        acc1 = vmlaq_f32(acc1, x1, x1);
+    }
+
+    return hsum_neon(vaddq_f32(acc0, acc1)) + sqsum_scalar(&x[n8], len - n8);
+}
+
+static float dot_neon(const float* x, const float* y, size_t len)
+{
+    const size_t n16 = len & ~(size_t)15;
+    float32x4_t vv0 = vdupq_n_f32(0);
+    float32x4_t vv1 = vdupq_n_f32(0);
+    float32x4_t vv2 = vdupq_n_f32(0);
+    float32x4_t vv3 = vdupq_n_f32(0);
+
+    for (size_t i = 0; i < n16; i += 16)
+    {
+        vv0 = vmlaq_f32(vv0, vld1q_f32(&x[i + 0]), vld1q_f32(&y[i + 0]));
+        vv1 = vmlaq_f32(vv1, vld1q_f32(&x[i + 4]), vld1q_f32(&y[i + 4]));
+        vv2 = vmlaq_f32(vv2, vld1q_f32(&x[i + 8]), vld1q_f32(&y[i + 8]));
+        vv3 = vmlaq_f32(vv3, vld1q_f32(&x[i + 12]), vld1q_f32(&y[i + 12]));
+    }
+
+    const float32x4_t vv = vaddq_f32(vaddq_f32(vv0, vv1), vaddq_f32(vv2, vv3));
+    return hsum_neon(vv) + dot_scalar(&x[n16], &y[n16], len - n16);
+}
+
+static void add_neon(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        vst1q_f32(&z[i], vaddq_f32(vld1q_f32(&x[i]), vld1q_f32(&y[i])));
+    add_scalar(&x[n4], &y[n4], &z[n4], len - n4);
+}
+
+static void sub_neon(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        vst1q_f32(&z[i], vsubq_f32(vld1q_f32(&x[i]), vld1q_f32(&y[i])));
+    sub_scalar(&x[n4], &y[n4], &z[n4], len - n4);
+}
+
+static void mul_neon(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        vst1q_f32(&z[i], vmulq_f32(vld1q_f32(&x[i]), vld1q_f32(&y[i])));
+    mul_scalar(&x[n4], &y[n4], &z[n4], len - n4);
+}
+
+static void scale_neon(const float* x, float scale, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        vst1q_f32(&y[i], vmulq_n_f32(vld1q_f32(&x[i]), scale));
+    scale_scalar(&x[n4], scale, &y[n4], len - n4);
+}
+
+static void mac_neon(const float* x, const float* y, float scale, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        vst1q_f32(&z[i], vmlaq_n_f32(vld1q_f32(&x[i]), vld1q_f32(&y[i]), scale));
+    mac_scalar(&x[n4], &y[n4], scale, &z[n4], len - n4);
+}
+
+static void clip_neon(const float* x, float min_value, float max_value, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const float32x4_t lo = vdupq_n_f32(min_value);
+    const float32x4_t hi = vdupq_n_f32(max_value);
+    for (size_t i = 0; i < n4; i += 4)
+        vst1q_f32(&y[i], vminq_f32(vmaxq_f32(vld1q_f32(&x[i]), lo), hi));
+    clip_scalar(&x[n4], min_value, max_value, &y[n4], len - n4);
+}
+
+static void max_neon(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        vst1q_f32(&z[i], vmaxq_f32(vld1q_f32(&x[i]), vld1q_f32(&y[i])));
+    max_scalar(&x[n4], &y[n4], &z[n4], len - n4);
+}
+
+static void mul_c_neon(const float* x, const float* y, float* z, size_t len)
+{
+    // de-interleaving loads: val[0] = real parts, val[1] = imaginary parts
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const float32x4x2_t a = vld2q_f32(&x[2 * i]);
+        const float32x4x2_t b = vld2q_f32(&y[2 * i]);
+        float32x4x2_t r;
+        r.val[0] = vmlsq_f32(vmulq_f32(a.val[0], b.val[0]), a.val[1], b.val[1]);
+        r.val[1] = vmlaq_f32(vmulq_f32(a.val[0], b.val[1]), a.val[1], b.val[0]);
+        vst2q_f32(&z[2 * i], r);
+    }
+    mul_c_scalar(&x[2 * n4], &y[2 * n4], &z[2 * n4], len - n4);
+}
+
+static void mul_cr_neon(const float* x, const float* w, float* z, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const float32x4_t wv = vld1q_f32(&w[i]);
+        float32x4x2_t a = vld2q_f32(&x[2 * i]);
+        a.val[0] = vmulq_f32(a.val[0], wv);
+        a.val[1] = vmulq_f32(a.val[1], wv);
+        vst2q_f32(&z[2 * i], a);
+    }
+    mul_cr_scalar(&x[2 * n4], &w[n4], &z[2 * n4], len - n4);
+}
+
+static float32x4_t sqnorm4_neon(const float* x)
+{
+    const float32x4x2_t a = vld2q_f32(x);
+    return vmlaq_f32(vmulq_f32(a.val[0], a.val[0]), a.val[1], a.val[1]);
+}
+
+static void abs_c_neon(const float* x, float* y, size_t len)
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        vst1q_f32(&y[i], vsqrtq_f32(sqnorm4_neon(&x[2 * i])));
+    abs_c_scalar(&x[2 * n4], &y[n4], len - n4);
+#else
+    // ARMv7 NEON has no exact square root
+    abs_c_scalar(x, y, len);
+#endif
+}
+
+static void sqnorm_c_neon(const float* x, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+        vst1q_f32(&y[i], sqnorm4_neon(&x[2 * i]));
+    sqnorm_c_scalar(&x[2 * n4], &y[n4], len - n4);
+}
+
+static void pow2db_neon(float* x, float scale, float threshold2, float clip_value, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const float32x4_t th = vdupq_n_f32(threshold2);
+    const float32x4_t cv = vdupq_n_f32(clip_value);
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const float32x4_t v = vld1q_f32(&x[i]);
+        const uint32x4_t clipped = vcltq_f32(v, th);
+        vst1q_f32(&x[i], vbslq_f32(clipped, cv, vmulq_n_f32(log10_neon(v), scale)));
+    }
+    pow2db_scalar(&x[n4], scale, threshold2, clip_value, len - n4);
+}
+
+static size_t local_max_neon(const float* x, size_t begin, size_t end, float threshold, uint32_t* index)
+{
+    const float32x4_t th = vdupq_n_f32(threshold);
+    size_t count = 0;
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        const float32x4_t v = vld1q_f32(&x[i]);
+        uint32x4_t m = vcgeq_f32(v, th);
+        m = vandq_u32(m, vcgeq_f32(v, vld1q_f32(&x[i - 2])));
+        m = vandq_u32(m, vcgeq_f32(v, vld1q_f32(&x[i - 1])));
+        m = vandq_u32(m, vcgtq_f32(v, vld1q_f32(&x[i + 1])));
+        m = vandq_u32(m, vcgtq_f32(v, vld1q_f32(&x[i + 2])));
+
+        // peaks are sparse, so most iterations end here
+        const uint32x2_t any = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+        if ((vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) == 0)
+            continue;
+
+        uint32_t lanes[4];
+        vst1q_u32(lanes, m);
+        for (int b = 0; b < 4; b++)
+        {
+            if (lanes[b])
+                index[count++] = (uint32_t)(i + b);
+        }
+    }
+    return count + local_max_scalar(x, i, end, threshold, &index[count]);
+}
+
+static const ifx_Simd_Kernels_t neon_kernels = {
+    IFX_SIMD_ISA_NEON,
+    "neon",
+    sum_neon,
+    sqsum_neon,
+    dot_neon,
+    add_neon,
+    sub_neon,
+    mul_neon,
+    scale_neon,
+    mac_neon,
+    clip_neon,
+    max_neon,
+    mul_c_neon,
+    mul_cr_neon,
+    abs_c_neon,
+    sqnorm_c_neon,
+    pow2db_neon,
+    local_max_neon,
+};
+#endif /* IFX_NEON */
+
+//----------------------------------------------------------------------------
+
+static bool cpu_has_avx2(void)
+{
+#if defined(IFX_HAVE_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(IFX_HAVE_AVX2) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!fma || !osxsave)
+        return false;
+    // check that the OS saves the YMM registers
+    if ((_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Kernels_t* ifx_simd_kernels_for_isa(ifx_Simd_Isa_t isa)
+{
+    switch (isa)
+    {
+        case IFX_SIMD_ISA_SCALAR:
+            return &scalar_kernels;
+#ifdef IFX_SSE2
+        case IFX_SIMD_ISA_SSE2:
+            return &sse2_kernels;
+#endif
+#ifdef IFX_HAVE_AVX2
+        case IFX_SIMD_ISA_AVX2:
+            return cpu_has_avx2() ? &ifx_simd_avx2_kernels : NULL;
+#endif
+#ifdef IFX_NEON
+        case IFX_SIMD_ISA_NEON:
+            return &neon_kernels;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Simd_Kernels_t* ifx_simd_kernels(void)
+{
+    const ifx_Simd_Kernels_t* kernels = selected_kernels;
+    if (kernels)
+        return kernels;
+
+    // Concurrent first calls all compute the same table, so the race is benign.
+    const ifx_Simd_Isa_t preference[] = {IFX_SIMD_ISA_AVX2, IFX_SIMD_ISA_NEON, IFX_SIMD_ISA_SSE2, IFX_SIMD_ISA_SCALAR};
+    for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); i++)
+    {
+        kernels = ifx_simd_kernels_for_isa(preference[i]);
+        if (kernels)
+            break;
+    }
+
+    selected_kernels = kernels;
+    return kernels;
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_simd_select_isa(ifx_Simd_Isa_t isa)
+{
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels_for_isa(isa);
+    if (!kernels)
+        return false;
+
+    selected_kernels = kernels;
+    return true;
+}
@@ -0,0 +1,300 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SimdAdc.c
+ *
+ * Scalar, SSE2 and NEON implementations of the kernels in
+ * internal/SimdAdc.h. The AVX2 implementations are in SimdAdcAvx2.c.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdint.h>
+
+#include "internal/SimdAdc.h"
+
+#ifdef IFX_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef IFX_NEON
+#include <arm_neon.h>
+#endif
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+#ifdef IFX_HAVE_AVX2
+// defined in SimdAdcAvx2.c which is compiled with AVX2 and FMA enabled
+extern const ifx_Simd_Adc_Kernels_t ifx_simd_adc_avx2_kernels;
+#endif
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/* ---------------------------------------------------------------------------
+ * Scalar reference kernels
+ * ------------------------------------------------------------------------ */
+
+static void adc8_c_scalar(const uint16_t* x, size_t stride, float* y, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        y[2 * i] = (float)((x[i * stride] >> 2) & 0xFF) / 255;
+        y[2 * i + 1] = (float)((x[i * stride + 1] >> 2) & 0xFF) / 255;
+    }
+}
+
+static void adc12_c_scalar(const uint16_t* x, float* y, size_t len)
+{
+    for (size_t i = 0; i < 2 * len; i++)
+        y[i] = (float)(x[i] & 0xFFF) / 4095;
+}
+
+static const ifx_Simd_Adc_Kernels_t scalar_kernels = {
+    adc8_c_scalar,
+    adc12_c_scalar,
+};
+
+#ifdef IFX_SSE2
+/* ---------------------------------------------------------------------------
+ * SSE2 kernels
+ *
+ * The tails are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+static void adc8_c_sse2(const uint16_t* x, size_t stride, float* y, size_t len)
+{
+    // only the readout layout of BGT60LTR11 (I, Q and two status words per
+    // sample) is vectorized
+    if (stride != 4)
+    {
+        adc8_c_scalar(x, stride, y, len);
+        return;
+    }
+
+    const size_t n4 = len & ~(size_t)3;
+    const __m128i mask = _mm_set1_epi16(0xFF);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 full_scale = _mm_set1_ps(255.0f);
+
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        // move (I, Q) of both samples of each load to the lower half and merge
+        const __m128i a = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&x[4 * i]), _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i b = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&x[4 * i + 8]), _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i iq = _mm_and_si128(_mm_srli_epi16(_mm_unpacklo_epi64(a, b), 2), mask);
+
+        // the division is exact like in the scalar version
+        _mm_storeu_ps(&y[2 * i], _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(iq, zero)), full_scale));
+        _mm_storeu_ps(&y[2 * i + 4], _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(iq, zero)), full_scale));
+    }
+    adc8_c_scalar(&x[4 * n4], stride, &y[2 * n4], len - n4);
+}
+
+static void adc12_c_sse2(const uint16_t* x, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const __m128i mask = _mm_set1_epi16(0xFFF);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 full_scale = _mm_set1_ps(4095.0f);
+
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m128i iq = _mm_and_si128(_mm_loadu_si128((const __m128i*)&x[2 * i]), mask);
+
+        // the division is exact like in the scalar version
+        _mm_storeu_ps(&y[2 * i], _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(iq, zero)), full_scale));
+        _mm_storeu_ps(&y[2 * i + 4], _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(iq, zero)), full_scale));
+    }
+    adc12_c_scalar(&x[2 * n4], &y[2 * n4], len - n4);
+}
+
+static const ifx_Simd_Adc_Kernels_t sse2_kernels = {
+    adc8_c_sse2,
+    adc12_c_sse2,
+};
+#endif /* IFX_SSE2 */
+
+#ifdef IFX_NEON
+/* ---------------------------------------------------------------------------
+ * NEON kernels
+ *
+ * The tails are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+static void adc8_c_neon(const uint16_t* x, size_t stride, float* y, size_t len)
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+    // only the readout layout of BGT60LTR11 (I, Q and two status words per
+    // sample) is vectorized
+    if (stride != 4)
+    {
+        adc8_c_scalar(x, stride, y, len);
+        return;
+    }
+
+    const size_t n8 = len & ~(size_t)7;
+    const uint16x8_t mask = vdupq_n_u16(0xFF);
+    const float32x4_t full_scale = vdupq_n_f32(255.0f);
+
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const uint16x8x4_t a = vld4q_u16(&x[4 * i]);
+        const uint16x8_t re = vandq_u16(vshrq_n_u16(a.val[0], 2), mask);
+        const uint16x8_t im = vandq_u16(vshrq_n_u16(a.val[1], 2), mask);
+
+        // the division is exact like in the scalar version
+        float32x4x2_t lo, hi;
+        lo.val[0] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(re))), full_scale);
+        lo.val[1] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(im))), full_scale);
+        hi.val[0] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(re))), full_scale);
+        hi.val[1] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(im))), full_scale);
+        vst2q_f32(&y[2 * i], lo);
+        vst2q_f32(&y[2 * i + 8], hi);
+    }
+    adc8_c_scalar(&x[4 * n8], stride, &y[2 * n8], len - n8);
+#else
+    // ARMv7 NEON has no exact division
+    adc8_c_scalar(x, stride, y, len);
+#endif
+}
+
+static void adc12_c_neon(const uint16_t* x, float* y, size_t len)
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+    const size_t n4 = len & ~(size_t)3;
+    const uint16x8_t mask = vdupq_n_u16(0xFFF);
+    const float32x4_t full_scale = vdupq_n_f32(4095.0f);
+
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const uint16x8_t iq = vandq_u16(vld1q_u16(&x[2 * i]), mask);
+
+        // the division is exact like in the scalar version
+        vst1q_f32(&y[2 * i], vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(iq))), full_scale));
+        vst1q_f32(&y[2 * i + 4], vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(iq))), full_scale));
+    }
+    adc12_c_scalar(&x[2 * n4], &y[2 * n4], len - n4);
+#else
+    // ARMv7 NEON has no exact division
+    adc12_c_scalar(x, y, len);
+#endif
+}
+
+static const ifx_Simd_Adc_Kernels_t neon_kernels = {
+    adc8_c_neon,
+    adc12_c_neon,
+};
+#endif /* IFX_NEON */
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Adc_Kernels_t* ifx_simd_adc_kernels_for_isa(ifx_Simd_Isa_t isa)
+{
+    // the generic table tells whether the instruction set is compiled in and
+    // supported by the CPU
+    if (!ifx_simd_kernels_for_isa(isa))
+        return NULL;
+
+    switch (isa)
+    {
+#ifdef IFX_SSE2
+        case IFX_SIMD_ISA_SSE2:
+            return &sse2_kernels;
+#endif
+#ifdef IFX_HAVE_AVX2
+        case IFX_SIMD_ISA_AVX2:
+            return &ifx_simd_adc_avx2_kernels;
+#endif
+#ifdef IFX_NEON
+        case IFX_SIMD_ISA_NEON:
+            return &neon_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Simd_Adc_Kernels_t* ifx_simd_adc_kernels(void)
+{
+    // the selected instruction set has been checked by ifx_simd_kernels
+    switch (ifx_simd_kernels()->isa)
+    {
+#ifdef IFX_SSE2
+        case IFX_SIMD_ISA_SSE2:
+            return &sse2_kernels;
+#endif
+#ifdef IFX_HAVE_AVX2
+        case IFX_SIMD_ISA_AVX2:
+            return &ifx_simd_adc_avx2_kernels;
+#endif
+#ifdef IFX_NEON
+        case IFX_SIMD_ISA_NEON:
+            return &neon_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
@@ -0,0 +1,137 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SimdAdcAvx2.c
+ *
+ * AVX2/FMA kernels for the table in internal/SimdAdc.h, see SimdAvx2.c.
+ * The table is the only exported symbol.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#include "internal/SimdAdc.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static void adc8_c_avx2(const uint16_t* x, size_t stride, float* y, size_t len)
+{
+    const size_t n8 = (stride == 4) ? (len & ~(size_t)7) : 0;
+    const __m256i mask = _mm256_set1_epi16(0xFF);
+    const __m256 full_scale = _mm256_set1_ps(255.0f);
+
+    // only the readout layout of BGT60LTR11 (I, Q and two status words per
+    // sample) is vectorized
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        // (I, Q) of each pair of samples to the lower 64 bits of each lane
+        const __m256i a = _mm256_shuffle_epi32(_mm256_loadu_si256((const __m256i*)&x[4 * i]), _MM_SHUFFLE(3, 1, 2, 0));
+        const __m256i b = _mm256_shuffle_epi32(_mm256_loadu_si256((const __m256i*)&x[4 * i + 16]), _MM_SHUFFLE(3, 1, 2, 0));
+        // merge and restore the sample order across lanes
+        const __m256i ab = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+        const __m256i iq = _mm256_and_si256(_mm256_srli_epi16(ab, 2), mask);
+
+        // the division is exact like in the scalar version
+        const __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(iq));
+        const __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(iq, 1));
+        _mm256_storeu_ps(&y[2 * i], _mm256_div_ps(_mm256_cvtepi32_ps(lo), full_scale));
+        _mm256_storeu_ps(&y[2 * i + 8], _mm256_div_ps(_mm256_cvtepi32_ps(hi), full_scale));
+    }
+    for (size_t i = n8; i < len; i++)
+    {
+        y[2 * i] = (float)((x[i * stride] >> 2) & 0xFF) / 255;
+        y[2 * i + 1] = (float)((x[i * stride + 1] >> 2) & 0xFF) / 255;
+    }
+}
+
+static void adc12_c_avx2(const uint16_t* x, float* y, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m256i mask = _mm256_set1_epi16(0xFFF);
+    const __m256 full_scale = _mm256_set1_ps(4095.0f);
+
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m256i iq = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)&x[2 * i]), mask);
+
+        // the division is exact like in the scalar version
+        const __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(iq));
+        const __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(iq, 1));
+        _mm256_storeu_ps(&y[2 * i], _mm256_div_ps(_mm256_cvtepi32_ps(lo), full_scale));
+        _mm256_storeu_ps(&y[2 * i + 8], _mm256_div_ps(_mm256_cvtepi32_ps(hi), full_scale));
+    }
+    for (size_t i = 2 * n8; i < 2 * len; i++)
+        y[i] = (float)(x[i] & 0xFFF) / 4095;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Adc_Kernels_t ifx_simd_adc_avx2_kernels = {
+    adc8_c_avx2,
+    adc12_c_avx2,
+};
@@ -0,0 +1,416 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SimdAvx2.c
+ *
+ * AVX2/FMA kernels for the table in internal/Simd.h. This file is compiled
+ * with AVX2 and FMA code generation enabled. None of its functions may be
+ * called before ifx_simd_kernels_for_isa has verified the CPU support, so
+ * the table is the only exported symbol.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <float.h>
+#include <immintrin.h>
+#include <math.h>
+
+#include "internal/Simd.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define LOG10_2 0.30102999566398119521f  // log10(2)
+#define LOG10_E 0.43429448190325182765f  // log10(e)
+#define SQRT_2  1.41421356237309504880f  // sqrt(2)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/**
+ * @brief Computes log10(x) for 8 positive floats
+ *
+ * See log10_sse2 in Simd.c for a description of the algorithm.
+ */
+static __m256 log10_avx2(__m256 x)
+{
+    x = _mm256_max_ps(x, _mm256_set1_ps(FLT_MIN));
+
+    const __m256i bits = _mm256_castps_si256(x);
+    __m256i e = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000)));
+
+    const __m256 big = _mm256_cmp_ps(m, _mm256_set1_ps(SQRT_2), _CMP_GT_OQ);
+    m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), big);
+    e = _mm256_sub_epi32(e, _mm256_castps_si256(big));
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+    const __m256 t2 = _mm256_mul_ps(t, t);
+
+    __m256 p = _mm256_set1_ps(1.0f / 9);
+    p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(1.0f / 7));
+    p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(1.0f / 5));
+    p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(1.0f / 3));
+    p = _mm256_fmadd_ps(p, t2, one);
+    const __m256 ln_m = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), t), p);
+
+    return _mm256_fmadd_ps(_mm256_cvtepi32_ps(e), _mm256_set1_ps(LOG10_2),
+                           _mm256_mul_ps(ln_m, _mm256_set1_ps(LOG10_E)));
+}
+
+static float hsum_avx2(__m256 v)
+{
+    __m128 r = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    r = _mm_add_ps(r, _mm_movehl_ps(r, r));
+    r = _mm_add_ss(r, _mm_shuffle_ps(r, r, 1));
+    return _mm_cvtss_f32(r);
+}
+
+static float sum_avx2(const float* x, size_t len)
+{
+    // Kahan summation in each lane
+    const size_t n8 = len & ~(size_t)7;
+    __m256 sum = _mm256_setzero_ps();
+    __m256 c = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m256 y = _mm256_sub_ps(_mm256_loadu_ps(&x[i]), c);
+        const __m256 t = _mm256_add_ps(sum, y);
+        c = _mm256_sub_ps(_mm256_sub_ps(t, sum), y);
+        sum = t;
+    }
+
+    float lanes[16];
+    _mm256_storeu_ps(&lanes[0], sum);
+    _mm256_storeu_ps(&lanes[8], _mm256_sub_ps(_mm256_setzero_ps(), c));
+    for (size_t i = n8; i < len; i++)
+        lanes[i - n8 + 8] += x[i];  // tail has at most 7 elements
+
+    // compensated sum of the lanes
+    float s = 0, k = 0;
+    for (size_t i = 0; i < 16; i++)
+    {
+        const float y = lanes[i] - k;
+        const float t = s + y;
+        k = (t - s) - y;
+        s = t;
+    }
+    return s;
+}
+
+static float sqsum_avx2(const float* x, size_t len)
+{
+    const size_t n16 = len & ~(size_t)15;
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < n16; i += 16)
+    {
+        const __m256 x0 = _mm256_loadu_ps(&x[i]);
+        const __m256 x1 = _mm256_loadu_ps(&x[i + 8]);
+        acc0 = _mm256_fmadd_ps(x0, x0, acc0);
+        acc1 = _mm256_fmadd_ps(x1, x1, acc1);
+    }
+
+    float result = hsum_avx2(_mm256_add_ps(acc0, acc1));
+    for (size_t i = n16; i < len; i++)
+        result += x[i] * x[i];
+    return result;
+}
+
+static float dot_avx2(const float* x, const float* y, size_t len)
+{
+    const size_t n32 = len & ~(size_t)31;
+    __m256 vv0 = _mm256_setzero_ps();
+    __m256 vv1 = _mm256_setzero_ps();
+    __m256 vv2 = _mm256_setzero_ps();
+    __m256 vv3 = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < n32; i += 32)
+    {
+        vv0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i + 0]), _mm256_loadu_ps(&y[i + 0]), vv0);
+        vv1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i + 8]), _mm256_loadu_ps(&y[i + 8]), vv1);
+        vv2 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i + 16]), _mm256_loadu_ps(&y[i + 16]), vv2);
+        vv3 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i + 24]), _mm256_loadu_ps(&y[i + 24]), vv3);
+    }
+
+    float result = hsum_avx2(_mm256_add_ps(_mm256_add_ps(vv0, vv1), _mm256_add_ps(vv2, vv3)));
+    for (size_t i = n32; i < len; i++)
+        result += x[i] * y[i];
+    return result;
+}
+
+static void add_avx2(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&z[i], _mm256_add_ps(_mm256_loadu_ps(&x[i]), _mm256_loadu_ps(&y[i])));
+    for (size_t i = n8; i < len; i++)
+        z[i] = x[i] + y[i];
+}
+
+static void sub_avx2(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&z[i], _mm256_sub_ps(_mm256_loadu_ps(&x[i]), _mm256_loadu_ps(&y[i])));
+    for (size_t i = n8; i < len; i++)
+        z[i] = x[i] - y[i];
+}
+
+static void mul_avx2(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&z[i], _mm256_mul_ps(_mm256_loadu_ps(&x[i]), _mm256_loadu_ps(&y[i])));
+    for (size_t i = n8; i < len; i++)
+        z[i] = x[i] * y[i];
+}
+
+static void scale_avx2(const float* x, float scale, float* y, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m256 s = _mm256_set1_ps(scale);
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&y[i], _mm256_mul_ps(_mm256_loadu_ps(&x[i]), s));
+    for (size_t i = n8; i < len; i++)
+        y[i] = x[i] * scale;
+}
+
+static void mac_avx2(const float* x, const float* y, float scale, float* z, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m256 s = _mm256_set1_ps(scale);
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&z[i], _mm256_fmadd_ps(s, _mm256_loadu_ps(&y[i]), _mm256_loadu_ps(&x[i])));
+    for (size_t i = n8; i < len; i++)
+        z[i] = x[i] + scale * y[i];
+}
+
+static void clip_avx2(const float* x, float min_value, float max_value, float* y, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m256 lo = _mm256_set1_ps(min_value);
+    const __m256 hi = _mm256_set1_ps(max_value);
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&y[i], _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&x[i]), lo), hi));
+    for (size_t i = n8; i < len; i++)
+    {
+        const float v = x[i] < min_value ? min_value : x[i];
+        y[i] = v > max_value ? max_value : v;
+    }
+}
+
+static void max_avx2(const float* x, const float* y, float* z, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&z[i], _mm256_max_ps(_mm256_loadu_ps(&x[i]), _mm256_loadu_ps(&y[i])));
+    for (size_t i = n8; i < len; i++)
+        z[i] = (x[i] > y[i]) ? x[i] : y[i];
+}
+
+static void mul_c_avx2(const float* x, const float* y, float* z, size_t len)
+{
+    // four complex numbers per register: (r0, i0, r1, i1, ...)
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m256 a = _mm256_loadu_ps(&x[2 * i]);
+        const __m256 b = _mm256_loadu_ps(&y[2 * i]);
+        const __m256 a_re = _mm256_moveldup_ps(a);
+        const __m256 a_im = _mm256_movehdup_ps(a);
+        const __m256 b_swap = _mm256_permute_ps(b, _MM_SHUFFLE(2, 3, 0, 1));
+        // even lanes: ar*br - ai*bi, odd lanes: ar*bi + ai*br
+        _mm256_storeu_ps(&z[2 * i], _mm256_fmaddsub_ps(a_re, b, _mm256_mul_ps(a_im, b_swap)));
+    }
+    for (size_t i = n4; i < len; i++)
+    {
+        const float xr = x[2 * i], xi = x[2 * i + 1];
+        const float yr = y[2 * i], yi = y[2 * i + 1];
+        z[2 * i] = xr * yr - xi * yi;
+        z[2 * i + 1] = xr * yi + xi * yr;
+    }
+}
+
+static void mul_cr_avx2(const float* x, const float* w, float* z, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m256i lo_idx = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i hi_idx = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m256 wv = _mm256_loadu_ps(&w[i]);
+        _mm256_storeu_ps(&z[2 * i], _mm256_mul_ps(_mm256_loadu_ps(&x[2 * i]), _mm256_permutevar8x32_ps(wv, lo_idx)));
+        _mm256_storeu_ps(&z[2 * i + 8], _mm256_mul_ps(_mm256_loadu_ps(&x[2 * i + 8]), _mm256_permutevar8x32_ps(wv, hi_idx)));
+    }
+    for (size_t i = n8; i < len; i++)
+    {
+        z[2 * i] = x[2 * i] * w[i];
+        z[2 * i + 1] = x[2 * i + 1] * w[i];
+    }
+}
+
+static __m256 sqnorm8_avx2(const float* x)
+{
+    const __m256 a = _mm256_loadu_ps(&x[0]);  // c0 c1 | c2 c3
+    const __m256 b = _mm256_loadu_ps(&x[8]);  // c4 c5 | c6 c7
+    const __m256 a2 = _mm256_mul_ps(a, a);
+    const __m256 b2 = _mm256_mul_ps(b, b);
+    // per 128-bit lane: (|c0|^2, |c1|^2, |c4|^2, |c5|^2 | |c2|^2, |c3|^2, |c6|^2, |c7|^2)
+    const __m256 h = _mm256_hadd_ps(a2, b2);
+    // restore order c0..c7
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(h), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+static void abs_c_avx2(const float* x, float* y, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&y[i], _mm256_sqrt_ps(sqnorm8_avx2(&x[2 * i])));
+    for (size_t i = n8; i < len; i++)
+        y[i] = sqrtf(x[2 * i] * x[2 * i] + x[2 * i + 1] * x[2 * i + 1]);
+}
+
+static void sqnorm_c_avx2(const float* x, float* y, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&y[i], sqnorm8_avx2(&x[2 * i]));
+    for (size_t i = n8; i < len; i++)
+        y[i] = x[2 * i] * x[2 * i] + x[2 * i + 1] * x[2 * i + 1];
+}
+
+static void pow2db_avx2(float* x, float scale, float threshold2, float clip_value, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m256 s = _mm256_set1_ps(scale);
+    const __m256 th = _mm256_set1_ps(threshold2);
+    const __m256 cv = _mm256_set1_ps(clip_value);
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(&x[i]);
+        const __m256 clipped = _mm256_cmp_ps(v, th, _CMP_LT_OQ);
+        const __m256 db = _mm256_mul_ps(s, log10_avx2(v));
+        _mm256_storeu_ps(&x[i], _mm256_blendv_ps(db, cv, clipped));
+    }
+    for (size_t i = n8; i < len; i++)
+        x[i] = (x[i] < threshold2) ? clip_value : scale * log10f(x[i]);
+}
+
+static size_t local_max_avx2(const float* x, size_t begin, size_t end, float threshold, uint32_t* index)
+{
+    const __m256 th = _mm256_set1_ps(threshold);
+    size_t count = 0;
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(&x[i]);
+        __m256 m = _mm256_cmp_ps(v, th, _CMP_GE_OQ);
+        m = _mm256_and_ps(m, _mm256_cmp_ps(v, _mm256_loadu_ps(&x[i - 2]), _CMP_GE_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(v, _mm256_loadu_ps(&x[i - 1]), _CMP_GE_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(v, _mm256_loadu_ps(&x[i + 1]), _CMP_GT_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(v, _mm256_loadu_ps(&x[i + 2]), _CMP_GT_OQ));
+
+        // peaks are sparse, so most iterations end here
+        const int bits = _mm256_movemask_ps(m);
+        if (bits == 0)
+            continue;
+        for (int b = 0; b < 8; b++)
+        {
+            if (bits & (1 << b))
+                index[count++] = (uint32_t)(i + b);
+        }
+    }
+    for (; i < end; i++)
+    {
+        const float v = x[i];
+        if (v >= threshold && v >= x[i - 2] && v >= x[i - 1] && v > x[i + 1] && v > x[i + 2])
+            index[count++] = (uint32_t)i;
+    }
+    return count;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Kernels_t ifx_simd_avx2_kernels = {
+    IFX_SIMD_ISA_AVX2,
+    "avx2",
+    sum_avx2,
+    sqsum_avx2,
+    dot_avx2,
+    add_avx2,
+    sub_avx2,
+    mul_avx2,
+    scale_avx2,
+    mac_avx2,
+    clip_avx2,
+    max_avx2,
+    mul_c_avx2,
+    mul_cr_avx2,
+    abs_c_avx2,
+    sqnorm_c_avx2,
+    pow2db_avx2,
+    local_max_avx2,
+};
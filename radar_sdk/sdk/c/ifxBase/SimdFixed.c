@@ -0,0 +1,412 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SimdFixed.c
+ *
+ * Scalar, SSE2 and NEON implementations of the kernels in
+ * internal/SimdFixed.h. The AVX2 implementations are in SimdFixedAvx2.c.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdint.h>
+
+#include "internal/SimdFixed.h"
+
+#ifdef IFX_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef IFX_NEON
+#include <arm_neon.h>
+#endif
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+#ifdef IFX_HAVE_AVX2
+// defined in SimdFixedAvx2.c which is compiled with AVX2 and FMA enabled
+extern const ifx_Simd_Fixed_Kernels_t ifx_simd_fixed_avx2_kernels;
+#endif
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/* ---------------------------------------------------------------------------
+ * Scalar reference kernels
+ * ------------------------------------------------------------------------ */
+
+static int32_t dot_s8_scalar(const int8_t* x, const int8_t* y, size_t len)
+{
+    int32_t result = 0;
+    for (size_t i = 0; i < len; i++)
+        result += (int32_t)x[i] * y[i];
+    return result;
+}
+
+static int16_t saturate_q15(int32_t x)
+{
+    return (x > INT16_MAX) ? INT16_MAX : ((x < INT16_MIN) ? INT16_MIN : (int16_t)x);
+}
+
+static int32_t abs_q15(int16_t x)
+{
+    // like the saturating negation of the SIMD kernels
+    return (x >= 0) ? x : ((x == INT16_MIN) ? INT16_MAX : -x);
+}
+
+static void mul_q15_scalar(const int16_t* x, const int16_t* y, int16_t* z, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        z[i] = saturate_q15(((int32_t)x[i] * y[i] + 0x4000) >> 15);
+}
+
+static int32_t bfly_q15_group_scalar(int16_t* a, int16_t* b, const int16_t* w, uint32_t shift, size_t len)
+{
+    int32_t max = 0;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        // a * 2^15 and w * b scaled down by 2^shift before rounding to Q15
+        const int32_t a_re = a[2 * i] * (1 << (15 - shift));
+        const int32_t a_im = a[2 * i + 1] * (1 << (15 - shift));
+        const int32_t t_re = (b[2 * i] * w[4 * i] + b[2 * i + 1] * w[4 * i + 1]) >> shift;
+        const int32_t t_im = (b[2 * i] * w[4 * i + 2] + b[2 * i + 1] * w[4 * i + 3]) >> shift;
+
+        a[2 * i] = saturate_q15((a_re + t_re + 0x4000) >> 15);
+        a[2 * i + 1] = saturate_q15((a_im + t_im + 0x4000) >> 15);
+        b[2 * i] = saturate_q15((a_re - t_re + 0x4000) >> 15);
+        b[2 * i + 1] = saturate_q15((a_im - t_im + 0x4000) >> 15);
+
+        const int32_t m[4] = {abs_q15(a[2 * i]), abs_q15(a[2 * i + 1]), abs_q15(b[2 * i]), abs_q15(b[2 * i + 1])};
+        for (int k = 0; k < 4; k++)
+            max = (m[k] > max) ? m[k] : max;
+    }
+    return max;
+}
+
+static int32_t bfly_q15_scalar(int16_t* x, const int16_t* w, uint32_t shift, size_t half, size_t len)
+{
+    int32_t max = 0;
+
+    for (size_t g = 0; g < len; g += 2 * half)
+    {
+        const int32_t group_max = bfly_q15_group_scalar(&x[2 * g], &x[2 * (g + half)], w, shift, half);
+        max = (group_max > max) ? group_max : max;
+    }
+    return max;
+}
+
+static const ifx_Simd_Fixed_Kernels_t scalar_kernels = {
+    dot_s8_scalar,
+    mul_q15_scalar,
+    bfly_q15_scalar,
+};
+
+#ifdef IFX_SSE2
+/* ---------------------------------------------------------------------------
+ * SSE2 kernels
+ *
+ * The tails are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+static int32_t dot_s8_sse2(const int8_t* x, const int8_t* y, size_t len)
+{
+    const size_t n16 = len & ~(size_t)15;
+    __m128i acc = _mm_setzero_si128();
+
+    for (size_t i = 0; i < n16; i += 16)
+    {
+        const __m128i xv = _mm_loadu_si128((const __m128i*)&x[i]);
+        const __m128i yv = _mm_loadu_si128((const __m128i*)&y[i]);
+
+        // sign extend to 16 bits by unpacking into the upper byte and
+        // shifting back; madd sums two products, which cannot overflow
+        const __m128i x_lo = _mm_srai_epi16(_mm_unpacklo_epi8(xv, xv), 8);
+        const __m128i x_hi = _mm_srai_epi16(_mm_unpackhi_epi8(xv, xv), 8);
+        const __m128i y_lo = _mm_srai_epi16(_mm_unpacklo_epi8(yv, yv), 8);
+        const __m128i y_hi = _mm_srai_epi16(_mm_unpackhi_epi8(yv, yv), 8);
+        acc = _mm_add_epi32(acc, _mm_add_epi32(_mm_madd_epi16(x_lo, y_lo), _mm_madd_epi16(x_hi, y_hi)));
+    }
+
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(acc) + dot_s8_scalar(&x[n16], &y[n16], len - n16);
+}
+
+static void mul_q15_sse2(const int16_t* x, const int16_t* y, int16_t* z, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m128i round = _mm_set1_epi32(0x4000);
+
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)&x[i]);
+        const __m128i b = _mm_loadu_si128((const __m128i*)&y[i]);
+        // full 32 bit products from the lower and upper halves
+        const __m128i lo = _mm_mullo_epi16(a, b);
+        const __m128i hi = _mm_mulhi_epi16(a, b);
+        const __m128i p0 = _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(lo, hi), round), 15);
+        const __m128i p1 = _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(lo, hi), round), 15);
+        _mm_storeu_si128((__m128i*)&z[i], _mm_packs_epi32(p0, p1));
+    }
+    mul_q15_scalar(&x[n8], &y[n8], &z[n8], len - n8);
+}
+
+// butterflies of four complex values: sum = x + t, diff = x - t with t = w * y
+static void bfly_q15_core_sse2(__m128i x, __m128i y, __m128i w0, __m128i w1, __m128i count, __m128i* sum, __m128i* diff)
+{
+    const __m128i count_a = _mm_add_epi32(count, _mm_cvtsi32_si128(1));
+    const __m128i round = _mm_set1_epi32(0x4000);
+    const __m128i zero = _mm_setzero_si128();
+
+    // t = w * y: duplicate each (re, im) pair and multiply-add with (wr, -wi, wi, wr)
+    const __m128i t0 = _mm_sra_epi32(_mm_madd_epi16(_mm_unpacklo_epi32(y, y), w0), count);
+    const __m128i t1 = _mm_sra_epi32(_mm_madd_epi16(_mm_unpackhi_epi32(y, y), w1), count);
+
+    // x * 2^(15 - shift) plus rounding offset
+    const __m128i x0 = _mm_add_epi32(_mm_sra_epi32(_mm_unpacklo_epi16(zero, x), count_a), round);
+    const __m128i x1 = _mm_add_epi32(_mm_sra_epi32(_mm_unpackhi_epi16(zero, x), count_a), round);
+
+    *sum = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(x0, t0), 15), _mm_srai_epi32(_mm_add_epi32(x1, t1), 15));
+    *diff = _mm_packs_epi32(_mm_srai_epi32(_mm_sub_epi32(x0, t0), 15), _mm_srai_epi32(_mm_sub_epi32(x1, t1), 15));
+}
+
+static __m128i abs_max_q15_sse2(__m128i vmax, __m128i sum, __m128i diff)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    vmax = _mm_max_epi16(vmax, _mm_max_epi16(sum, _mm_subs_epi16(zero, sum)));
+    return _mm_max_epi16(vmax, _mm_max_epi16(diff, _mm_subs_epi16(zero, diff)));
+}
+
+static int32_t hmax_q15_sse2(__m128i vmax)
+{
+    vmax = _mm_max_epi16(vmax, _mm_shuffle_epi32(vmax, _MM_SHUFFLE(1, 0, 3, 2)));
+    vmax = _mm_max_epi16(vmax, _mm_shuffle_epi32(vmax, _MM_SHUFFLE(2, 3, 0, 1)));
+    vmax = _mm_max_epi16(vmax, _mm_shufflelo_epi16(vmax, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (int16_t)_mm_cvtsi128_si32(vmax);
+}
+
+static int32_t bfly_q15_group_sse2(int16_t* a, int16_t* b, const int16_t* w, uint32_t shift, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const __m128i count = _mm_cvtsi32_si128((int)shift);
+    __m128i vmax = _mm_setzero_si128();
+
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)&a[2 * i]);
+        const __m128i y = _mm_loadu_si128((const __m128i*)&b[2 * i]);
+        const __m128i w0 = _mm_loadu_si128((const __m128i*)&w[4 * i]);
+        const __m128i w1 = _mm_loadu_si128((const __m128i*)&w[4 * i + 8]);
+        __m128i sum, diff;
+
+        bfly_q15_core_sse2(x, y, w0, w1, count, &sum, &diff);
+        _mm_storeu_si128((__m128i*)&a[2 * i], sum);
+        _mm_storeu_si128((__m128i*)&b[2 * i], diff);
+        vmax = abs_max_q15_sse2(vmax, sum, diff);
+    }
+
+    const int32_t max = hmax_q15_sse2(vmax);
+    const int32_t tail = bfly_q15_group_scalar(&a[2 * n4], &b[2 * n4], &w[4 * n4], shift, len - n4);
+    return (tail > max) ? tail : max;
+}
+
+static int32_t bfly_q15_sse2(int16_t* x, const int16_t* w, uint32_t shift, size_t half, size_t len)
+{
+    int32_t max = 0;
+
+    if (half > 2 || (len % 8) != 0)
+    {
+        for (size_t g = 0; g < len; g += 2 * half)
+        {
+            const int32_t group_max = bfly_q15_group_sse2(&x[2 * g], &x[2 * (g + half)], w, shift, half);
+            max = (group_max > max) ? group_max : max;
+        }
+        return max;
+    }
+
+    // the first two stages gather a and b of several groups into one register
+    const __m128i count = _mm_cvtsi32_si128((int)shift);
+    const __m128i tw = (half == 1) ? _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)w), _mm_loadl_epi64((const __m128i*)w))
+                                   : _mm_loadu_si128((const __m128i*)w);
+    __m128i vmax = _mm_setzero_si128();
+
+    for (size_t i = 0; i < len; i += 8)
+    {
+        const __m128i v0 = _mm_loadu_si128((const __m128i*)&x[2 * i]);
+        const __m128i v1 = _mm_loadu_si128((const __m128i*)&x[2 * i + 8]);
+        __m128i sum, diff;
+
+        if (half == 1)
+        {
+            const __m128i a = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(v0), _mm_castsi128_ps(v1), _MM_SHUFFLE(2, 0, 2, 0)));
+            const __m128i b = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(v0), _mm_castsi128_ps(v1), _MM_SHUFFLE(3, 1, 3, 1)));
+            bfly_q15_core_sse2(a, b, tw, tw, count, &sum, &diff);
+            _mm_storeu_si128((__m128i*)&x[2 * i], _mm_unpacklo_epi32(sum, diff));
+            _mm_storeu_si128((__m128i*)&x[2 * i + 8], _mm_unpackhi_epi32(sum, diff));
+        }
+        else
+        {
+            bfly_q15_core_sse2(_mm_unpacklo_epi64(v0, v1), _mm_unpackhi_epi64(v0, v1), tw, tw, count, &sum, &diff);
+            _mm_storeu_si128((__m128i*)&x[2 * i], _mm_unpacklo_epi64(sum, diff));
+            _mm_storeu_si128((__m128i*)&x[2 * i + 8], _mm_unpackhi_epi64(sum, diff));
+        }
+        vmax = abs_max_q15_sse2(vmax, sum, diff);
+    }
+    return hmax_q15_sse2(vmax);
+}
+
+static const ifx_Simd_Fixed_Kernels_t sse2_kernels = {
+    dot_s8_sse2,
+    mul_q15_sse2,
+    bfly_q15_sse2,
+};
+#endif /* IFX_SSE2 */
+
+#ifdef IFX_NEON
+/* ---------------------------------------------------------------------------
+ * NEON kernels
+ *
+ * The tails are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+static int32_t dot_s8_neon(const int8_t* x, const int8_t* y, size_t len)
+{
+    const size_t n16 = len & ~(size_t)15;
+    int32x4_t acc = vdupq_n_s32(0);
+
+    for (size_t i = 0; i < n16; i += 16)
+    {
+        const int8x16_t xv = vld1q_s8(&x[i]);
+        const int8x16_t yv = vld1q_s8(&y[i]);
+
+        // a product of two 8-bit integers always fits into 16 bits
+        acc = vpadalq_s16(acc, vmull_s8(vget_low_s8(xv), vget_low_s8(yv)));
+        acc = vpadalq_s16(acc, vmull_s8(vget_high_s8(xv), vget_high_s8(yv)));
+    }
+
+    const int32x2_t sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+    return vget_lane_s32(vpadd_s32(sum, sum), 0) + dot_s8_scalar(&x[n16], &y[n16], len - n16);
+}
+
+// the Q15 kernels have no NEON implementation yet, NEON builds use the
+// scalar ones
+static const ifx_Simd_Fixed_Kernels_t neon_kernels = {
+    dot_s8_neon,
+    mul_q15_scalar,
+    bfly_q15_scalar,
+};
+#endif /* IFX_NEON */
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Fixed_Kernels_t* ifx_simd_fixed_kernels_for_isa(ifx_Simd_Isa_t isa)
+{
+    // the generic table tells whether the instruction set is compiled in and
+    // supported by the CPU
+    if (!ifx_simd_kernels_for_isa(isa))
+        return NULL;
+
+    switch (isa)
+    {
+#ifdef IFX_SSE2
+        case IFX_SIMD_ISA_SSE2:
+            return &sse2_kernels;
+#endif
+#ifdef IFX_HAVE_AVX2
+        case IFX_SIMD_ISA_AVX2:
+            return &ifx_simd_fixed_avx2_kernels;
+#endif
+#ifdef IFX_NEON
+        case IFX_SIMD_ISA_NEON:
+            return &neon_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Simd_Fixed_Kernels_t* ifx_simd_fixed_kernels(void)
+{
+    // the selected instruction set has been checked by ifx_simd_kernels
+    switch (ifx_simd_kernels()->isa)
+    {
+#ifdef IFX_SSE2
+        case IFX_SIMD_ISA_SSE2:
+            return &sse2_kernels;
+#endif
+#ifdef IFX_HAVE_AVX2
+        case IFX_SIMD_ISA_AVX2:
+            return &ifx_simd_fixed_avx2_kernels;
+#endif
+#ifdef IFX_NEON
+        case IFX_SIMD_ISA_NEON:
+            return &neon_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
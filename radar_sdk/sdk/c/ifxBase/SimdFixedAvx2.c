@@ -0,0 +1,285 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SimdFixedAvx2.c
+ *
+ * AVX2/FMA kernels for the table in internal/SimdFixed.h, see SimdAvx2.c.
+ * The table is the only exported symbol.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#include "internal/SimdFixed.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static int32_t dot_s8_avx2(const int8_t* x, const int8_t* y, size_t len)
+{
+    const size_t n32 = len & ~(size_t)31;
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+
+    for (size_t i = 0; i < n32; i += 32)
+    {
+        // sign extend 16 values to 16 bits each; madd sums two products,
+        // which cannot overflow
+        const __m256i x0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)&x[i]));
+        const __m256i y0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)&y[i]));
+        const __m256i x1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)&x[i + 16]));
+        const __m256i y1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)&y[i + 16]));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(x0, y0));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(x1, y1));
+    }
+
+    const __m256i acc = _mm256_add_epi32(acc0, acc1);
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    int32_t result = _mm_cvtsi128_si32(sum);
+    for (size_t i = n32; i < len; i++)
+        result += (int32_t)x[i] * y[i];
+    return result;
+}
+
+static void mul_q15_avx2(const int16_t* x, const int16_t* y, int16_t* z, size_t len)
+{
+    const size_t n16 = len & ~(size_t)15;
+
+    // vpmulhrsw computes (x * y + 2^14) >> 15
+    for (size_t i = 0; i < n16; i += 16)
+    {
+        const __m256i a = _mm256_loadu_si256((const __m256i*)&x[i]);
+        const __m256i b = _mm256_loadu_si256((const __m256i*)&y[i]);
+        _mm256_storeu_si256((__m256i*)&z[i], _mm256_mulhrs_epi16(a, b));
+    }
+    for (size_t i = n16; i < len; i++)
+    {
+        const int32_t p = ((int32_t)x[i] * y[i] + 0x4000) >> 15;
+        z[i] = (int16_t)((p > INT16_MAX) ? INT16_MAX : p);
+    }
+}
+
+static int16_t round_q15(int32_t x)
+{
+    x = (x + 0x4000) >> 15;
+    return (int16_t)((x > INT16_MAX) ? INT16_MAX : ((x < INT16_MIN) ? INT16_MIN : x));
+}
+
+// butterflies of eight complex values: sum = x + t, diff = x - t with t = w * y
+static void bfly_q15_core_avx2(__m256i x, __m256i y, __m256i w0, __m256i w1, __m128i count, __m256i* sum, __m256i* diff)
+{
+    const __m128i count_a = _mm_add_epi32(count, _mm_cvtsi32_si128(1));
+    const __m256i round = _mm256_set1_epi32(0x4000);
+    const __m256i zero = _mm256_setzero_si256();
+
+    // duplicate each (re, im) pair of y, samples 0..3 and 4..7
+    const __m256i y_lo = _mm256_unpacklo_epi32(y, y);
+    const __m256i y_hi = _mm256_unpackhi_epi32(y, y);
+    const __m256i y0 = _mm256_permute2x128_si256(y_lo, y_hi, 0x20);
+    const __m256i y1 = _mm256_permute2x128_si256(y_lo, y_hi, 0x31);
+    const __m256i t0 = _mm256_sra_epi32(_mm256_madd_epi16(y0, w0), count);
+    const __m256i t1 = _mm256_sra_epi32(_mm256_madd_epi16(y1, w1), count);
+
+    // x * 2^(15 - shift) plus rounding offset, samples 0..3 and 4..7
+    const __m256i x_lo = _mm256_sra_epi32(_mm256_unpacklo_epi16(zero, x), count_a);
+    const __m256i x_hi = _mm256_sra_epi32(_mm256_unpackhi_epi16(zero, x), count_a);
+    const __m256i x0 = _mm256_add_epi32(_mm256_permute2x128_si256(x_lo, x_hi, 0x20), round);
+    const __m256i x1 = _mm256_add_epi32(_mm256_permute2x128_si256(x_lo, x_hi, 0x31), round);
+
+    // packing works per lane, restore the sample order afterwards
+    const __m256i s = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_add_epi32(x0, t0), 15), _mm256_srai_epi32(_mm256_add_epi32(x1, t1), 15));
+    const __m256i d = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_sub_epi32(x0, t0), 15), _mm256_srai_epi32(_mm256_sub_epi32(x1, t1), 15));
+    *sum = _mm256_permute4x64_epi64(s, _MM_SHUFFLE(3, 1, 2, 0));
+    *diff = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+static __m256i abs_max_q15_avx2(__m256i vmax, __m256i sum, __m256i diff)
+{
+    const __m256i zero = _mm256_setzero_si256();
+
+    vmax = _mm256_max_epi16(vmax, _mm256_max_epi16(sum, _mm256_subs_epi16(zero, sum)));
+    return _mm256_max_epi16(vmax, _mm256_max_epi16(diff, _mm256_subs_epi16(zero, diff)));
+}
+
+static int32_t hmax_q15_avx2(__m256i vmax)
+{
+    __m128i m = _mm_max_epi16(_mm256_castsi256_si128(vmax), _mm256_extracti128_si256(vmax, 1));
+    m = _mm_max_epi16(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_max_epi16(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    m = _mm_max_epi16(m, _mm_shufflelo_epi16(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (int16_t)_mm_cvtsi128_si32(m);
+}
+
+static int32_t bfly_q15_group_avx2(int16_t* a, int16_t* b, const int16_t* w, uint32_t shift, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m128i count = _mm_cvtsi32_si128((int)shift);
+    __m256i vmax = _mm256_setzero_si256();
+
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)&a[2 * i]);
+        const __m256i y = _mm256_loadu_si256((const __m256i*)&b[2 * i]);
+        const __m256i w0 = _mm256_loadu_si256((const __m256i*)&w[4 * i]);
+        const __m256i w1 = _mm256_loadu_si256((const __m256i*)&w[4 * i + 16]);
+        __m256i sum, diff;
+
+        bfly_q15_core_avx2(x, y, w0, w1, count, &sum, &diff);
+        _mm256_storeu_si256((__m256i*)&a[2 * i], sum);
+        _mm256_storeu_si256((__m256i*)&b[2 * i], diff);
+        vmax = abs_max_q15_avx2(vmax, sum, diff);
+    }
+
+    int32_t max = hmax_q15_avx2(vmax);
+
+    for (size_t i = n8; i < len; i++)
+    {
+        const int32_t x_re = a[2 * i] * (1 << (15 - shift));
+        const int32_t x_im = a[2 * i + 1] * (1 << (15 - shift));
+        const int32_t t_re = (b[2 * i] * w[4 * i] + b[2 * i + 1] * w[4 * i + 1]) >> shift;
+        const int32_t t_im = (b[2 * i] * w[4 * i + 2] + b[2 * i + 1] * w[4 * i + 3]) >> shift;
+
+        const int16_t r[4] = {round_q15(x_re + t_re), round_q15(x_im + t_im), round_q15(x_re - t_re), round_q15(x_im - t_im)};
+        a[2 * i] = r[0];
+        a[2 * i + 1] = r[1];
+        b[2 * i] = r[2];
+        b[2 * i + 1] = r[3];
+        for (int k = 0; k < 4; k++)
+        {
+            const int32_t v = (r[k] >= 0) ? r[k] : ((r[k] == INT16_MIN) ? INT16_MAX : -r[k]);
+            max = (v > max) ? v : max;
+        }
+    }
+    return max;
+}
+
+static int32_t bfly_q15_avx2(int16_t* x, const int16_t* w, uint32_t shift, size_t half, size_t len)
+{
+    int32_t max = 0;
+
+    if (half > 4 || (len % 16) != 0)
+    {
+        for (size_t g = 0; g < len; g += 2 * half)
+        {
+            const int32_t group_max = bfly_q15_group_avx2(&x[2 * g], &x[2 * (g + half)], w, shift, half);
+            max = (group_max > max) ? group_max : max;
+        }
+        return max;
+    }
+
+    // the first three stages gather a and b of several groups into one register
+    const __m128i count = _mm_cvtsi32_si128((int)shift);
+    __m256i tw;
+    if (half == 1)
+        tw = _mm256_broadcastq_epi64(_mm_loadl_epi64((const __m128i*)w));
+    else if (half == 2)
+        tw = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)w));
+    else
+        tw = _mm256_loadu_si256((const __m256i*)w);
+    __m256i vmax = _mm256_setzero_si256();
+
+    for (size_t i = 0; i < len; i += 16)
+    {
+        const __m256i v0 = _mm256_loadu_si256((const __m256i*)&x[2 * i]);
+        const __m256i v1 = _mm256_loadu_si256((const __m256i*)&x[2 * i + 16]);
+        __m256i sum, diff;
+
+        if (half == 1)
+        {
+            const __m256i a = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), _MM_SHUFFLE(2, 0, 2, 0)));
+            const __m256i b = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), _MM_SHUFFLE(3, 1, 3, 1)));
+            bfly_q15_core_avx2(a, b, tw, tw, count, &sum, &diff);
+            _mm256_storeu_si256((__m256i*)&x[2 * i], _mm256_unpacklo_epi32(sum, diff));
+            _mm256_storeu_si256((__m256i*)&x[2 * i + 16], _mm256_unpackhi_epi32(sum, diff));
+        }
+        else if (half == 2)
+        {
+            bfly_q15_core_avx2(_mm256_unpacklo_epi64(v0, v1), _mm256_unpackhi_epi64(v0, v1), tw, tw, count, &sum, &diff);
+            _mm256_storeu_si256((__m256i*)&x[2 * i], _mm256_unpacklo_epi64(sum, diff));
+            _mm256_storeu_si256((__m256i*)&x[2 * i + 16], _mm256_unpackhi_epi64(sum, diff));
+        }
+        else
+        {
+            bfly_q15_core_avx2(_mm256_permute2x128_si256(v0, v1, 0x20), _mm256_permute2x128_si256(v0, v1, 0x31), tw, tw, count, &sum, &diff);
+            _mm256_storeu_si256((__m256i*)&x[2 * i], _mm256_permute2x128_si256(sum, diff, 0x20));
+            _mm256_storeu_si256((__m256i*)&x[2 * i + 16], _mm256_permute2x128_si256(sum, diff, 0x31));
+        }
+        vmax = abs_max_q15_avx2(vmax, sum, diff);
+    }
+    return hmax_q15_avx2(vmax);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Fixed_Kernels_t ifx_simd_fixed_avx2_kernels = {
+    dot_s8_avx2,
+    mul_q15_avx2,
+    bfly_q15_avx2,
+};
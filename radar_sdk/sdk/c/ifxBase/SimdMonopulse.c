@@ -0,0 +1,454 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SimdMonopulse.c
+ *
+ * Scalar, SSE2 and NEON implementations of the kernels in
+ * internal/SimdMonopulse.h. The AVX2 implementations are in SimdMonopulseAvx2.c.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "internal/SimdMonopulse.h"
+
+#ifdef IFX_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef IFX_NEON
+#include <arm_neon.h>
+#endif
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define PI_F     3.14159265358979323846f  // pi
+#define TAN_PI_8 0.41421356237309504880f  // tan(pi/8)
+#define RAD2DEG  57.2957795130823208768f  // 180/pi
+
+// atan(t) = t + t*z*(P0 + P1*z + P2*z^2 + P3*z^3), z = t^2, |t| <= tan(pi/8) (Cephes atanf)
+#define ATAN_P0 -3.33329491539e-1f
+#define ATAN_P1 1.99777106478e-1f
+#define ATAN_P2 -1.38776856032e-1f
+#define ATAN_P3 8.05374449538e-2f
+
+// asin(a) = pi/2 - sqrt(1-a)*(P0 + P1*a + ... + P7*a^7), 0 <= a <= 1 (Abramowitz-Stegun 4.4.46)
+#define ASIN_P0 1.5707963050f
+#define ASIN_P1 -0.2145988016f
+#define ASIN_P2 0.0889789874f
+#define ASIN_P3 -0.0501743046f
+#define ASIN_P4 0.0308918810f
+#define ASIN_P5 -0.0170881256f
+#define ASIN_P6 0.0066700901f
+#define ASIN_P7 -0.0012624911f
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+#ifdef IFX_HAVE_AVX2
+// defined in SimdMonopulseAvx2.c which is compiled with AVX2 and FMA enabled
+extern const ifx_Simd_Monopulse_Kernels_t ifx_simd_monopulse_avx2_kernels;
+#endif
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/* ---------------------------------------------------------------------------
+ * Scalar reference kernels
+ * ------------------------------------------------------------------------ */
+
+/**
+ * @brief Computes atan2(y, x) with an absolute error of about 1e-7 rad
+ *
+ * The ratio t = min(|x|,|y|) / max(|x|,|y|) in [0, 1] is reduced to
+ * |t| <= tan(pi/8) using atan(t) = pi/4 + atan((t-1)/(t+1)), so a single
+ * division and a short polynomial are sufficient. The octant is restored
+ * from the order of |x| and |y| and the signs of x and y. The result is in
+ * (-pi, pi] like a wrapped phase difference. The SIMD versions
+ * implement the same steps without branches.
+ */
+static float atan2_scalar(float y, float x)
+{
+    const float ax = fabsf(x);
+    const float ay = fabsf(y);
+    const float hi = (ax > ay) ? ax : ay;
+    const float lo = (ax > ay) ? ay : ax;
+    const int big = lo > TAN_PI_8 * hi;
+    const float den = big ? lo + hi : hi;
+    const float t = (big ? lo - hi : lo) / ((den > FLT_MIN) ? den : FLT_MIN);
+    const float z = t * t;
+
+    float r = t + t * z * (((ATAN_P3 * z + ATAN_P2) * z + ATAN_P1) * z + ATAN_P0);
+    if (big)
+        r += PI_F / 4;
+    if (ay > ax)
+        r = PI_F / 2 - r;
+    if (x < 0)
+        r = PI_F - r;
+    // -0 is treated as +0, so the result is in (-pi, pi]
+    return (y < 0) ? -r : r;
+}
+
+/**
+ * @brief Computes asin(s) for |s| <= 1 with an absolute error below 1e-6 rad
+ */
+static float asin_scalar(float s)
+{
+    const float a = fabsf(s);
+    float p = ASIN_P7;
+    p = p * a + ASIN_P6;
+    p = p * a + ASIN_P5;
+    p = p * a + ASIN_P4;
+    p = p * a + ASIN_P3;
+    p = p * a + ASIN_P2;
+    p = p * a + ASIN_P1;
+    p = p * a + ASIN_P0;
+    return copysignf(PI_F / 2 - sqrtf(1 - a) * p, s);
+}
+
+static void monopulse_scalar(const float* x1, const float* x2, const float* c, float scale, float* y, size_t len)
+{
+    const float c_re = c ? c[0] : 1;
+    const float c_im = c ? c[1] : 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        // p = x1 * conj(x2) * c
+        const float a_re = x1[2 * i], a_im = x1[2 * i + 1];
+        const float b_re = x2[2 * i], b_im = x2[2 * i + 1];
+        const float d_re = a_re * b_re + a_im * b_im;
+        const float d_im = a_im * b_re - a_re * b_im;
+        const float p_re = d_re * c_re - d_im * c_im;
+        const float p_im = d_re * c_im + d_im * c_re;
+
+        float s = scale * atan2_scalar(p_im, p_re);
+        s = (s < -1) ? -1 : ((s > 1) ? 1 : s);
+        y[i] = RAD2DEG * asin_scalar(s);
+    }
+}
+
+static const ifx_Simd_Monopulse_Kernels_t scalar_kernels = {
+    monopulse_scalar,
+};
+
+#ifdef IFX_SSE2
+/* ---------------------------------------------------------------------------
+ * SSE2 kernels
+ *
+ * The tails are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+static __m128 select_sse2(__m128 mask, __m128 a, __m128 b)
+{
+    // mask ? a : b
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/**
+ * @brief Computes atan2(y, x) for 4 floats, see atan2_scalar
+ */
+static __m128 atan2_sse2(__m128 y, __m128 x)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 ax = _mm_andnot_ps(sign, x);
+    const __m128 ay = _mm_andnot_ps(sign, y);
+    const __m128 hi = _mm_max_ps(ax, ay);
+    const __m128 lo = _mm_min_ps(ax, ay);
+    const __m128 big = _mm_cmpgt_ps(lo, _mm_mul_ps(_mm_set1_ps(TAN_PI_8), hi));
+
+    // big ? (lo - hi) / (lo + hi) : lo / hi
+    const __m128 num = _mm_sub_ps(lo, _mm_and_ps(big, hi));
+    const __m128 den = _mm_max_ps(_mm_add_ps(hi, _mm_and_ps(big, lo)), _mm_set1_ps(FLT_MIN));
+    const __m128 t = _mm_div_ps(num, den);
+    const __m128 z = _mm_mul_ps(t, t);
+
+    __m128 p = _mm_set1_ps(ATAN_P3);
+    p = vf32x4_mla(_mm_set1_ps(ATAN_P2), p, z);
+    p = vf32x4_mla(_mm_set1_ps(ATAN_P1), p, z);
+    p = vf32x4_mla(_mm_set1_ps(ATAN_P0), p, z);
+    __m128 r = vf32x4_mla(t, _mm_mul_ps(t, z), p);
+
+    r = _mm_add_ps(r, _mm_and_ps(big, _mm_set1_ps(PI_F / 4)));
+    r = select_sse2(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(PI_F / 2), r), r);
+    r = select_sse2(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(PI_F), r), r);
+    return _mm_or_ps(r, _mm_and_ps(sign, _mm_cmplt_ps(y, _mm_setzero_ps())));
+}
+
+/**
+ * @brief Computes asin(s) for 4 floats with |s| <= 1, see asin_scalar
+ */
+static __m128 asin_sse2(__m128 s)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 a = _mm_andnot_ps(sign, s);
+
+    __m128 p = _mm_set1_ps(ASIN_P7);
+    p = vf32x4_mla(_mm_set1_ps(ASIN_P6), p, a);
+    p = vf32x4_mla(_mm_set1_ps(ASIN_P5), p, a);
+    p = vf32x4_mla(_mm_set1_ps(ASIN_P4), p, a);
+    p = vf32x4_mla(_mm_set1_ps(ASIN_P3), p, a);
+    p = vf32x4_mla(_mm_set1_ps(ASIN_P2), p, a);
+    p = vf32x4_mla(_mm_set1_ps(ASIN_P1), p, a);
+    p = vf32x4_mla(_mm_set1_ps(ASIN_P0), p, a);
+
+    const __m128 root = _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), a));
+    const __m128 r = _mm_sub_ps(_mm_set1_ps(PI_F / 2), _mm_mul_ps(root, p));
+    return _mm_or_ps(r, _mm_and_ps(sign, s));
+}
+
+static void monopulse_sse2(const float* x1, const float* x2, const float* c, float scale, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const __m128 c_re = _mm_set1_ps(c ? c[0] : 1.0f);
+    const __m128 c_im = _mm_set1_ps(c ? c[1] : 0.0f);
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    const __m128 rad2deg = _mm_set1_ps(RAD2DEG);
+
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m128 a0 = _mm_loadu_ps(&x1[2 * i]);
+        const __m128 a1 = _mm_loadu_ps(&x1[2 * i + 4]);
+        const __m128 b0 = _mm_loadu_ps(&x2[2 * i]);
+        const __m128 b1 = _mm_loadu_ps(&x2[2 * i + 4]);
+        const __m128 a_re = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 a_im = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m128 b_re = _mm_shuffle_ps(b0, b1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 b_im = _mm_shuffle_ps(b0, b1, _MM_SHUFFLE(3, 1, 3, 1));
+
+        // p = x1 * conj(x2) * c
+        const __m128 d_re = vf32x4_mla(_mm_mul_ps(a_re, b_re), a_im, b_im);
+        const __m128 d_im = _mm_sub_ps(_mm_mul_ps(a_im, b_re), _mm_mul_ps(a_re, b_im));
+        const __m128 p_re = _mm_sub_ps(_mm_mul_ps(d_re, c_re), _mm_mul_ps(d_im, c_im));
+        const __m128 p_im = vf32x4_mla(_mm_mul_ps(d_re, c_im), d_im, c_re);
+
+        const __m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(s, atan2_sse2(p_im, p_re)), minus_one), one);
+        _mm_storeu_ps(&y[i], _mm_mul_ps(rad2deg, asin_sse2(v)));
+    }
+    monopulse_scalar(&x1[2 * n4], &x2[2 * n4], c, scale, &y[n4], len - n4);
+}
+
+static const ifx_Simd_Monopulse_Kernels_t sse2_kernels = {
+    monopulse_sse2,
+};
+#endif /* IFX_SSE2 */
+
+#ifdef IFX_NEON
+/* ---------------------------------------------------------------------------
+ * NEON kernels
+ *
+ * The tails are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+/**
+ * @brief Computes num / den for 4 floats
+ *
+ * Reciprocal estimate refined by two Newton-Raphson steps as ARMv7 NEON
+ * has no division.
+ */
+static float32x4_t div_neon(float32x4_t num, float32x4_t den)
+{
+    float32x4_t rec = vrecpeq_f32(den);
+    rec = vmulq_f32(vrecpsq_f32(den, rec), rec);
+    rec = vmulq_f32(vrecpsq_f32(den, rec), rec);
+    return vmulq_f32(num, rec);
+}
+
+/**
+ * @brief Computes atan2(y, x) for 4 floats, see atan2_scalar
+ */
+static float32x4_t atan2_neon(float32x4_t y, float32x4_t x)
+{
+    const float32x4_t ax = vabsq_f32(x);
+    const float32x4_t ay = vabsq_f32(y);
+    const float32x4_t hi = vmaxq_f32(ax, ay);
+    const float32x4_t lo = vminq_f32(ax, ay);
+    const uint32x4_t big = vcgtq_f32(lo, vmulq_n_f32(hi, TAN_PI_8));
+
+    // big ? (lo - hi) / (lo + hi) : lo / hi
+    const float32x4_t num = vbslq_f32(big, vsubq_f32(lo, hi), lo);
+    const float32x4_t den = vmaxq_f32(vbslq_f32(big, vaddq_f32(lo, hi), hi), vdupq_n_f32(FLT_MIN));
+    const float32x4_t t = div_neon(num, den);
+    const float32x4_t z = vmulq_f32(t, t);
+
+    float32x4_t p = vdupq_n_f32(ATAN_P3);
+    p = vmlaq_f32(vdupq_n_f32(ATAN_P2), p, z);
+    p = vmlaq_f32(vdupq_n_f32(ATAN_P1), p, z);
+    p = vmlaq_f32(vdupq_n_f32(ATAN_P0), p, z);
+    float32x4_t r = vmlaq_f32(t, vmulq_f32(t, z), p);
+
+    r = vbslq_f32(big, vaddq_f32(r, vdupq_n_f32(PI_F / 4)), r);
+    r = vbslq_f32(vcgtq_f32(ay, ax), vsubq_f32(vdupq_n_f32(PI_F / 2), r), r);
+    r = vbslq_f32(vcltq_f32(x, vdupq_n_f32(0)), vsubq_f32(vdupq_n_f32(PI_F), r), r);
+
+    const uint32x4_t sign = vdupq_n_u32(0x80000000);
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(r), vandq_u32(vcltq_f32(y, vdupq_n_f32(0)), sign)));
+}
+
+/**
+ * @brief Computes asin(s) for 4 floats with |s| <= 1, see asin_scalar
+ */
+static float32x4_t asin_neon(float32x4_t s)
+{
+    const float32x4_t a = vabsq_f32(s);
+
+    float32x4_t p = vdupq_n_f32(ASIN_P7);
+    p = vmlaq_f32(vdupq_n_f32(ASIN_P6), p, a);
+    p = vmlaq_f32(vdupq_n_f32(ASIN_P5), p, a);
+    p = vmlaq_f32(vdupq_n_f32(ASIN_P4), p, a);
+    p = vmlaq_f32(vdupq_n_f32(ASIN_P3), p, a);
+    p = vmlaq_f32(vdupq_n_f32(ASIN_P2), p, a);
+    p = vmlaq_f32(vdupq_n_f32(ASIN_P1), p, a);
+    p = vmlaq_f32(vdupq_n_f32(ASIN_P0), p, a);
+
+    // sqrt(v) = v / sqrt(v) using the reciprocal square root estimate
+    const float32x4_t v = vmaxq_f32(vsubq_f32(vdupq_n_f32(1.0f), a), vdupq_n_f32(FLT_MIN));
+    float32x4_t rsqrt = vrsqrteq_f32(v);
+    rsqrt = vmulq_f32(vrsqrtsq_f32(vmulq_f32(v, rsqrt), rsqrt), rsqrt);
+    rsqrt = vmulq_f32(vrsqrtsq_f32(vmulq_f32(v, rsqrt), rsqrt), rsqrt);
+    const float32x4_t r = vmlsq_f32(vdupq_n_f32(PI_F / 2), vmulq_f32(v, rsqrt), p);
+
+    const uint32x4_t sign = vdupq_n_u32(0x80000000);
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(r), vandq_u32(vreinterpretq_u32_f32(s), sign)));
+}
+
+static void monopulse_neon(const float* x1, const float* x2, const float* c, float scale, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const float c_re = c ? c[0] : 1.0f;
+    const float c_im = c ? c[1] : 0.0f;
+
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const float32x4x2_t a = vld2q_f32(&x1[2 * i]);
+        const float32x4x2_t b = vld2q_f32(&x2[2 * i]);
+
+        // p = x1 * conj(x2) * c
+        const float32x4_t d_re = vmlaq_f32(vmulq_f32(a.val[0], b.val[0]), a.val[1], b.val[1]);
+        const float32x4_t d_im = vmlsq_f32(vmulq_f32(a.val[1], b.val[0]), a.val[0], b.val[1]);
+        const float32x4_t p_re = vmlsq_n_f32(vmulq_n_f32(d_re, c_re), d_im, c_im);
+        const float32x4_t p_im = vmlaq_n_f32(vmulq_n_f32(d_re, c_im), d_im, c_re);
+
+        float32x4_t v = vmulq_n_f32(atan2_neon(p_im, p_re), scale);
+        v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+        vst1q_f32(&y[i], vmulq_n_f32(asin_neon(v), RAD2DEG));
+    }
+    monopulse_scalar(&x1[2 * n4], &x2[2 * n4], c, scale, &y[n4], len - n4);
+}
+
+static const ifx_Simd_Monopulse_Kernels_t neon_kernels = {
+    monopulse_neon,
+};
+#endif /* IFX_NEON */
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Monopulse_Kernels_t* ifx_simd_monopulse_kernels_for_isa(ifx_Simd_Isa_t isa)
+{
+    // the generic table tells whether the instruction set is compiled in and
+    // supported by the CPU
+    if (!ifx_simd_kernels_for_isa(isa))
+        return NULL;
+
+    switch (isa)
+    {
+#ifdef IFX_SSE2
+        case IFX_SIMD_ISA_SSE2:
+            return &sse2_kernels;
+#endif
+#ifdef IFX_HAVE_AVX2
+        case IFX_SIMD_ISA_AVX2:
+            return &ifx_simd_monopulse_avx2_kernels;
+#endif
+#ifdef IFX_NEON
+        case IFX_SIMD_ISA_NEON:
+            return &neon_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Simd_Monopulse_Kernels_t* ifx_simd_monopulse_kernels(void)
+{
+    // the selected instruction set has been checked by ifx_simd_kernels
+    switch (ifx_simd_kernels()->isa)
+    {
+#ifdef IFX_SSE2
+        case IFX_SIMD_ISA_SSE2:
+            return &sse2_kernels;
+#endif
+#ifdef IFX_HAVE_AVX2
+        case IFX_SIMD_ISA_AVX2:
+            return &ifx_simd_monopulse_avx2_kernels;
+#endif
+#ifdef IFX_NEON
+        case IFX_SIMD_ISA_NEON:
+            return &neon_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
@@ -0,0 +1,218 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SimdMonopulseAvx2.c
+ *
+ * AVX2/FMA kernels for the table in internal/SimdMonopulse.h, see SimdAvx2.c.
+ * The table is the only exported symbol.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <float.h>
+#include <immintrin.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "internal/SimdMonopulse.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define PI_F     3.14159265358979323846f  // pi
+#define TAN_PI_8 0.41421356237309504880f  // tan(pi/8)
+#define RAD2DEG  57.2957795130823208768f  // 180/pi
+
+// polynomial coefficients, see SimdMonopulse.c
+#define ATAN_P0 -3.33329491539e-1f
+#define ATAN_P1 1.99777106478e-1f
+#define ATAN_P2 -1.38776856032e-1f
+#define ATAN_P3 8.05374449538e-2f
+
+#define ASIN_P0 1.5707963050f
+#define ASIN_P1 -0.2145988016f
+#define ASIN_P2 0.0889789874f
+#define ASIN_P3 -0.0501743046f
+#define ASIN_P4 0.0308918810f
+#define ASIN_P5 -0.0170881256f
+#define ASIN_P6 0.0066700901f
+#define ASIN_P7 -0.0012624911f
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/**
+ * @brief Computes atan2(y, x) for 8 floats
+ *
+ * See atan2_scalar in Simd.c for a description of the algorithm.
+ */
+static __m256 atan2_avx2(__m256 y, __m256 x)
+{
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 ax = _mm256_andnot_ps(sign, x);
+    const __m256 ay = _mm256_andnot_ps(sign, y);
+    const __m256 hi = _mm256_max_ps(ax, ay);
+    const __m256 lo = _mm256_min_ps(ax, ay);
+    const __m256 big = _mm256_cmp_ps(lo, _mm256_mul_ps(_mm256_set1_ps(TAN_PI_8), hi), _CMP_GT_OQ);
+
+    // big ? (lo - hi) / (lo + hi) : lo / hi
+    const __m256 num = _mm256_sub_ps(lo, _mm256_and_ps(big, hi));
+    const __m256 den = _mm256_max_ps(_mm256_add_ps(hi, _mm256_and_ps(big, lo)), _mm256_set1_ps(FLT_MIN));
+    const __m256 t = _mm256_div_ps(num, den);
+    const __m256 z = _mm256_mul_ps(t, t);
+
+    __m256 p = _mm256_set1_ps(ATAN_P3);
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(ATAN_P2));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(ATAN_P1));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(ATAN_P0));
+    __m256 r = _mm256_fmadd_ps(_mm256_mul_ps(t, z), p, t);
+
+    r = _mm256_add_ps(r, _mm256_and_ps(big, _mm256_set1_ps(PI_F / 4)));
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(PI_F / 2), r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(PI_F), r), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+    return _mm256_or_ps(r, _mm256_and_ps(sign, _mm256_cmp_ps(y, _mm256_setzero_ps(), _CMP_LT_OQ)));
+}
+
+/**
+ * @brief Computes asin(s) for 8 floats with |s| <= 1
+ *
+ * See asin_scalar in Simd.c.
+ */
+static __m256 asin_avx2(__m256 s)
+{
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 a = _mm256_andnot_ps(sign, s);
+
+    __m256 p = _mm256_set1_ps(ASIN_P7);
+    p = _mm256_fmadd_ps(p, a, _mm256_set1_ps(ASIN_P6));
+    p = _mm256_fmadd_ps(p, a, _mm256_set1_ps(ASIN_P5));
+    p = _mm256_fmadd_ps(p, a, _mm256_set1_ps(ASIN_P4));
+    p = _mm256_fmadd_ps(p, a, _mm256_set1_ps(ASIN_P3));
+    p = _mm256_fmadd_ps(p, a, _mm256_set1_ps(ASIN_P2));
+    p = _mm256_fmadd_ps(p, a, _mm256_set1_ps(ASIN_P1));
+    p = _mm256_fmadd_ps(p, a, _mm256_set1_ps(ASIN_P0));
+
+    const __m256 root = _mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), a));
+    const __m256 r = _mm256_fnmadd_ps(root, p, _mm256_set1_ps(PI_F / 2));
+    return _mm256_or_ps(r, _mm256_and_ps(sign, s));
+}
+
+static __m256 monopulse8_avx2(const float* x1, const float* x2, __m256 c_re, __m256 c_im, __m256 scale)
+{
+    // deinterleave 8 complex numbers, the order of the lanes is restored at the end
+    const __m256 a0 = _mm256_loadu_ps(&x1[0]);
+    const __m256 a1 = _mm256_loadu_ps(&x1[8]);
+    const __m256 b0 = _mm256_loadu_ps(&x2[0]);
+    const __m256 b1 = _mm256_loadu_ps(&x2[8]);
+    const __m256 a_re = _mm256_shuffle_ps(a0, a1, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 a_im = _mm256_shuffle_ps(a0, a1, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m256 b_re = _mm256_shuffle_ps(b0, b1, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 b_im = _mm256_shuffle_ps(b0, b1, _MM_SHUFFLE(3, 1, 3, 1));
+
+    // p = x1 * conj(x2) * c
+    const __m256 d_re = _mm256_fmadd_ps(a_im, b_im, _mm256_mul_ps(a_re, b_re));
+    const __m256 d_im = _mm256_fmsub_ps(a_im, b_re, _mm256_mul_ps(a_re, b_im));
+    const __m256 p_re = _mm256_fmsub_ps(d_re, c_re, _mm256_mul_ps(d_im, c_im));
+    const __m256 p_im = _mm256_fmadd_ps(d_im, c_re, _mm256_mul_ps(d_re, c_im));
+
+    __m256 v = _mm256_mul_ps(scale, atan2_avx2(p_im, p_re));
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    const __m256 r = _mm256_mul_ps(_mm256_set1_ps(RAD2DEG), asin_avx2(v));
+
+    // lanes are (0, 1, 4, 5 | 2, 3, 6, 7)
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(r), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+static void monopulse_avx2(const float* x1, const float* x2, const float* c, float scale, float* y, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m256 c_re = _mm256_set1_ps(c ? c[0] : 1.0f);
+    const __m256 c_im = _mm256_set1_ps(c ? c[1] : 0.0f);
+    const __m256 s = _mm256_set1_ps(scale);
+
+    for (size_t i = 0; i < n8; i += 8)
+        _mm256_storeu_ps(&y[i], monopulse8_avx2(&x1[2 * i], &x2[2 * i], c_re, c_im, s));
+
+    if (n8 < len)
+    {
+        // the tail is zero padded and computed with the same code
+        float a[16] = {0};
+        float b[16] = {0};
+        float r[8];
+        for (size_t i = n8; i < len; i++)
+        {
+            a[2 * (i - n8)] = x1[2 * i];
+            a[2 * (i - n8) + 1] = x1[2 * i + 1];
+            b[2 * (i - n8)] = x2[2 * i];
+            b[2 * (i - n8) + 1] = x2[2 * i + 1];
+        }
+        _mm256_storeu_ps(r, monopulse8_avx2(a, b, c_re, c_im, s));
+        for (size_t i = n8; i < len; i++)
+            y[i] = r[i - n8];
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Monopulse_Kernels_t ifx_simd_monopulse_avx2_kernels = {
+    monopulse_avx2,
+};
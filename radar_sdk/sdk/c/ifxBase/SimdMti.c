@@ -0,0 +1,293 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SimdMti.c
+ *
+ * Scalar, SSE2 and NEON implementations of the kernels in
+ * internal/SimdMti.h. The AVX2 implementations are in SimdMtiAvx2.c.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdint.h>
+
+#include "internal/SimdMti.h"
+
+#ifdef IFX_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef IFX_NEON
+#include <arm_neon.h>
+#endif
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+#ifdef IFX_HAVE_AVX2
+// defined in SimdMtiAvx2.c which is compiled with AVX2 and FMA enabled
+extern const ifx_Simd_Mti_Kernels_t ifx_simd_mti_avx2_kernels;
+#endif
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/* ---------------------------------------------------------------------------
+ * Scalar reference kernels
+ * ------------------------------------------------------------------------ */
+
+static void mti_scalar(const float* x, float* h, float alpha, float* y, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        const float d = x[i] - h[i];
+        h[i] += alpha * d;
+        y[i] = d;
+    }
+}
+
+static void mti_v_scalar(const float* x, float* h, const float* alpha, float* y, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        const float d = x[i] - h[i];
+        h[i] += alpha[i] * d;
+        y[i] = d;
+    }
+}
+
+static void cancel3_scalar(const float* x, const float* h1, float* h2, float* y, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        const float v = x[i];
+        y[i] = v - 2 * h1[i] + h2[i];
+        h2[i] = v;
+    }
+}
+
+static const ifx_Simd_Mti_Kernels_t scalar_kernels = {
+    mti_scalar,
+    mti_v_scalar,
+    cancel3_scalar,
+};
+
+#ifdef IFX_SSE2
+/* ---------------------------------------------------------------------------
+ * SSE2 kernels
+ *
+ * The tails are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+static void mti_sse2(const float* x, float* h, float alpha, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    const __m128 a = _mm_set1_ps(alpha);
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m128 hv = _mm_loadu_ps(&h[i]);
+        const __m128 d = _mm_sub_ps(_mm_loadu_ps(&x[i]), hv);
+        _mm_storeu_ps(&h[i], vf32x4_mla(hv, a, d));
+        _mm_storeu_ps(&y[i], d);
+    }
+    mti_scalar(&x[n4], &h[n4], alpha, &y[n4], len - n4);
+}
+
+static void mti_v_sse2(const float* x, float* h, const float* alpha, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m128 hv = _mm_loadu_ps(&h[i]);
+        const __m128 d = _mm_sub_ps(_mm_loadu_ps(&x[i]), hv);
+        _mm_storeu_ps(&h[i], vf32x4_mla(hv, _mm_loadu_ps(&alpha[i]), d));
+        _mm_storeu_ps(&y[i], d);
+    }
+    mti_v_scalar(&x[n4], &h[n4], &alpha[n4], &y[n4], len - n4);
+}
+
+static void cancel3_sse2(const float* x, const float* h1, float* h2, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const __m128 v = _mm_loadu_ps(&x[i]);
+        const __m128 h1v = _mm_loadu_ps(&h1[i]);
+        const __m128 r = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(v, h1v), h1v), _mm_loadu_ps(&h2[i]));
+        _mm_storeu_ps(&h2[i], v);
+        _mm_storeu_ps(&y[i], r);
+    }
+    cancel3_scalar(&x[n4], &h1[n4], &h2[n4], &y[n4], len - n4);
+}
+
+static const ifx_Simd_Mti_Kernels_t sse2_kernels = {
+    mti_sse2,
+    mti_v_sse2,
+    cancel3_sse2,
+};
+#endif /* IFX_SSE2 */
+
+#ifdef IFX_NEON
+/* ---------------------------------------------------------------------------
+ * NEON kernels
+ *
+ * The tails are handled by the scalar kernels.
+ * ------------------------------------------------------------------------ */
+
+static void mti_neon(const float* x, float* h, float alpha, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const float32x4_t hv = vld1q_f32(&h[i]);
+        const float32x4_t d = vsubq_f32(vld1q_f32(&x[i]), hv);
+        vst1q_f32(&h[i], vmlaq_n_f32(hv, d, alpha));
+        vst1q_f32(&y[i], d);
+    }
+    mti_scalar(&x[n4], &h[n4], alpha, &y[n4], len - n4);
+}
+
+static void mti_v_neon(const float* x, float* h, const float* alpha, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const float32x4_t hv = vld1q_f32(&h[i]);
+        const float32x4_t d = vsubq_f32(vld1q_f32(&x[i]), hv);
+        vst1q_f32(&h[i], vmlaq_f32(hv, d, vld1q_f32(&alpha[i])));
+        vst1q_f32(&y[i], d);
+    }
+    mti_v_scalar(&x[n4], &h[n4], &alpha[n4], &y[n4], len - n4);
+}
+
+static void cancel3_neon(const float* x, const float* h1, float* h2, float* y, size_t len)
+{
+    const size_t n4 = len & ~(size_t)3;
+    for (size_t i = 0; i < n4; i += 4)
+    {
+        const float32x4_t v = vld1q_f32(&x[i]);
+        const float32x4_t h1v = vld1q_f32(&h1[i]);
+        const float32x4_t r = vaddq_f32(vsubq_f32(vsubq_f32(v, h1v), h1v), vld1q_f32(&h2[i]));
+        vst1q_f32(&h2[i], v);
+        vst1q_f32(&y[i], r);
+    }
+    cancel3_scalar(&x[n4], &h1[n4], &h2[n4], &y[n4], len - n4);
+}
+
+static const ifx_Simd_Mti_Kernels_t neon_kernels = {
+    mti_neon,
+    mti_v_neon,
+    cancel3_neon,
+};
+#endif /* IFX_NEON */
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Mti_Kernels_t* ifx_simd_mti_kernels_for_isa(ifx_Simd_Isa_t isa)
+{
+    // the generic table tells whether the instruction set is compiled in and
+    // supported by the CPU
+    if (!ifx_simd_kernels_for_isa(isa))
+        return NULL;
+
+    switch (isa)
+    {
+#ifdef IFX_SSE2
+        case IFX_SIMD_ISA_SSE2:
+            return &sse2_kernels;
+#endif
+#ifdef IFX_HAVE_AVX2
+        case IFX_SIMD_ISA_AVX2:
+            return &ifx_simd_mti_avx2_kernels;
+#endif
+#ifdef IFX_NEON
+        case IFX_SIMD_ISA_NEON:
+            return &neon_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Simd_Mti_Kernels_t* ifx_simd_mti_kernels(void)
+{
+    // the selected instruction set has been checked by ifx_simd_kernels
+    switch (ifx_simd_kernels()->isa)
+    {
+#ifdef IFX_SSE2
+        case IFX_SIMD_ISA_SSE2:
+            return &sse2_kernels;
+#endif
+#ifdef IFX_HAVE_AVX2
+        case IFX_SIMD_ISA_AVX2:
+            return &ifx_simd_mti_avx2_kernels;
+#endif
+#ifdef IFX_NEON
+        case IFX_SIMD_ISA_NEON:
+            return &neon_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
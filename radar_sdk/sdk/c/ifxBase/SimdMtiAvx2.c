@@ -0,0 +1,144 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SimdMtiAvx2.c
+ *
+ * AVX2/FMA kernels for the table in internal/SimdMti.h, see SimdAvx2.c.
+ * The table is the only exported symbol.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#include "internal/SimdMti.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static void mti_avx2(const float* x, float* h, float alpha, float* y, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    const __m256 a = _mm256_set1_ps(alpha);
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m256 hv = _mm256_loadu_ps(&h[i]);
+        const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(&x[i]), hv);
+        _mm256_storeu_ps(&h[i], _mm256_fmadd_ps(a, d, hv));
+        _mm256_storeu_ps(&y[i], d);
+    }
+    for (size_t i = n8; i < len; i++)
+    {
+        const float d = x[i] - h[i];
+        h[i] += alpha * d;
+        y[i] = d;
+    }
+}
+
+static void mti_v_avx2(const float* x, float* h, const float* alpha, float* y, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m256 hv = _mm256_loadu_ps(&h[i]);
+        const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(&x[i]), hv);
+        _mm256_storeu_ps(&h[i], _mm256_fmadd_ps(_mm256_loadu_ps(&alpha[i]), d, hv));
+        _mm256_storeu_ps(&y[i], d);
+    }
+    for (size_t i = n8; i < len; i++)
+    {
+        const float d = x[i] - h[i];
+        h[i] += alpha[i] * d;
+        y[i] = d;
+    }
+}
+
+static void cancel3_avx2(const float* x, const float* h1, float* h2, float* y, size_t len)
+{
+    const size_t n8 = len & ~(size_t)7;
+    for (size_t i = 0; i < n8; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(&x[i]);
+        const __m256 h1v = _mm256_loadu_ps(&h1[i]);
+        const __m256 r = _mm256_add_ps(_mm256_sub_ps(_mm256_sub_ps(v, h1v), h1v), _mm256_loadu_ps(&h2[i]));
+        _mm256_storeu_ps(&h2[i], v);
+        _mm256_storeu_ps(&y[i], r);
+    }
+    for (size_t i = n8; i < len; i++)
+    {
+        const float v = x[i];
+        y[i] = v - 2 * h1[i] + h2[i];
+        h2[i] = v;
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Simd_Mti_Kernels_t ifx_simd_mti_avx2_kernels = {
+    mti_avx2,
+    mti_v_avx2,
+    cancel3_avx2,
+};
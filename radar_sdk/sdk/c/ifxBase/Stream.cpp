@@ -0,0 +1,332 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <common/Metrics.hpp>
+#include <common/ThreadPolicy.hpp>
+
+#include "Error.h"
+#include "Stream.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+struct ifx_Stream_s
+{
+    ifx_Stream_Fetch_t fetch = nullptr;
+    void* context = nullptr;
+    size_t frame_size = 0;
+    uint32_t decimation = 1;
+
+    // The ring buffer has one slot more than num_frames. The acquisition
+    // thread fetches into the slot behind the newest frame without holding
+    // the mutex; this slot is never part of the frames seen by readers.
+    std::vector<float> ring;
+    uint32_t num_slots = 0;
+    uint32_t num_frames = 0;
+    uint32_t head = 0;   // slot of the oldest frame
+    uint32_t queued = 0; // number of frames in the ring buffer
+
+    FILE* record_file = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable frame_available;
+    std::atomic<bool> stop {false};
+    bool running = true;
+    ifx_Error_t error = IFX_OK;
+
+    uint32_t waiting = 0;     // number of readers blocked in ifx_stream_read
+    uint64_t notify_time = 0; // time of the last notification of a waiting reader
+
+    uint64_t frames_fetched = 0;
+    uint64_t frames_recorded = 0;
+    uint64_t frames_dropped = 0;
+    uint64_t frames_read = 0;
+
+    std::thread thread;
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static void stream_worker(ifx_Stream_t* stream);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static void stream_worker(ifx_Stream_t* stream)
+{
+    ifx_Error_t error = IFX_OK;
+    uint64_t index = 0;
+
+    ThreadPolicies::instance().apply(ThreadRole::DspWorker);
+
+    while (!stream->stop.load(std::memory_order_relaxed))
+    {
+        uint32_t tail;
+        {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            tail = (stream->head + stream->queued) % stream->num_slots;
+        }
+        float* slot = stream->ring.data() + size_t(tail) * stream->frame_size;
+
+        if (!stream->fetch(stream->context, slot))
+        {
+            error = ifx_error_get_and_clear();
+            if (error == IFX_OK || error == IFX_ERROR_TIMEOUT)
+            {
+                error = IFX_OK;
+                continue;
+            }
+            break;
+        }
+
+        // Recording happens outside of the mutex; a slow disk only delays
+        // the next fetch, but never blocks readers. If writing fails the
+        // recording stops while the acquisition continues.
+        bool recorded = false;
+        if (stream->record_file)
+        {
+            recorded = std::fwrite(slot, sizeof(float), stream->frame_size, stream->record_file) == stream->frame_size;
+            if (!recorded)
+            {
+                std::fclose(stream->record_file);
+                stream->record_file = nullptr;
+            }
+        }
+
+        const bool enqueue = (index++ % stream->decimation) == 0;
+
+        {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            stream->frames_fetched++;
+            if (recorded)
+                stream->frames_recorded++;
+            if (enqueue)
+            {
+                if (stream->queued == stream->num_frames)
+                {
+                    stream->head = (stream->head + 1) % stream->num_slots;
+                    stream->queued--;
+                    stream->frames_dropped++;
+                }
+                stream->queued++;
+                if (stream->waiting && Metrics::isEnabled())
+                    stream->notify_time = Metrics::now();
+            }
+        }
+
+        if (enqueue)
+            stream->frame_available.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        stream->running = false;
+        stream->error = error;
+    }
+    stream->frame_available.notify_all();
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Stream_t* ifx_stream_create(const ifx_Stream_Config_t* config, ifx_Stream_Fetch_t fetch, void* context)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_NULL(fetch);
+    IFX_ERR_BRN_COND(config->frame_size == 0, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    IFX_ERR_BRN_COND(config->num_frames == 0 || config->num_frames == UINT32_MAX, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    IFX_ERR_BRN_COND(config->frame_size > SIZE_MAX / sizeof(float) / (size_t(config->num_frames) + 1), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ifx_Stream_t* stream = nullptr;
+    try
+    {
+        stream = new ifx_Stream_t;
+        stream->fetch = fetch;
+        stream->context = context;
+        stream->frame_size = config->frame_size;
+        stream->decimation = config->decimation ? config->decimation : 1;
+        stream->num_frames = config->num_frames;
+        stream->num_slots = config->num_frames + 1;
+        stream->ring.resize(size_t(stream->num_slots) * stream->frame_size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        delete stream;
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return nullptr;
+    }
+
+    if (config->record_filename)
+    {
+        stream->record_file = std::fopen(config->record_filename, "wb");
+        if (!stream->record_file)
+        {
+            delete stream;
+            ifx_error_set(IFX_ERROR_ARGUMENT_INVALID);
+            return nullptr;
+        }
+    }
+
+    try
+    {
+        stream->thread = std::thread(stream_worker, stream);
+    }
+    catch (const std::system_error&)
+    {
+        if (stream->record_file)
+            std::fclose(stream->record_file);
+        delete stream;
+        ifx_error_set(IFX_ERROR_INTERNAL);
+        return nullptr;
+    }
+
+    return stream;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_stream_destroy(ifx_Stream_t* stream)
+{
+    if (!stream)
+        return;
+
+    stream->stop.store(true, std::memory_order_relaxed);
+    if (stream->thread.joinable())
+        stream->thread.join();
+
+    if (stream->record_file)
+        std::fclose(stream->record_file);
+
+    delete stream;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_stream_read(ifx_Stream_t* stream, float* frames, uint32_t max_frames, uint16_t timeout_ms)
+{
+    IFX_ERR_BRV_NULL(stream, 0);
+    IFX_ERR_BRV_NULL(frames, 0);
+    IFX_ERR_BRV_COND(max_frames == 0, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, 0);
+
+    std::unique_lock<std::mutex> lock(stream->mutex);
+    const bool waiting = stream->queued == 0 && stream->running;
+    if (waiting)
+    {
+        stream->waiting++;
+        stream->notify_time = 0;
+        stream->frame_available.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                         [stream] { return stream->queued > 0 || !stream->running; });
+        stream->waiting--;
+    }
+
+    if (stream->queued == 0)
+    {
+        ifx_error_set(stream->running ? IFX_ERROR_TIMEOUT : stream->error);
+        return 0;
+    }
+
+    // wake-up latency of reader threads that applied a thread policy role
+    if (waiting && stream->notify_time)
+    {
+        ThreadPolicies::recordWakeup(Metrics::now() - stream->notify_time);
+        stream->notify_time = 0;
+    }
+
+    // Copy the oldest frames in at most two contiguous chunks (the ring
+    // buffer may wrap around).
+    const uint32_t count = std::min(max_frames, stream->queued);
+    const uint32_t first = std::min(count, stream->num_slots - stream->head);
+    const float* ring = stream->ring.data();
+    std::memcpy(frames, ring + size_t(stream->head) * stream->frame_size, size_t(first) * stream->frame_size * sizeof(float));
+    std::memcpy(frames + size_t(first) * stream->frame_size, ring, size_t(count - first) * stream->frame_size * sizeof(float));
+
+    stream->head = (stream->head + count) % stream->num_slots;
+    stream->queued -= count;
+    stream->frames_read += count;
+    return count;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_stream_get_stats(ifx_Stream_t* stream, ifx_Stream_Stats_t* stats)
+{
+    IFX_ERR_BRK_NULL(stream);
+    IFX_ERR_BRK_NULL(stats);
+
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stats->frames_fetched = stream->frames_fetched;
+    stats->frames_recorded = stream->frames_recorded;
+    stats->frames_dropped = stream->frames_dropped;
+    stats->frames_read = stream->frames_read;
+    stats->frames_queued = stream->queued;
+    stats->running = stream->running;
+}
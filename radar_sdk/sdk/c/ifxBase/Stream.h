@@ -0,0 +1,211 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Stream.h
+ *
+ * \brief \copybrief gr_stream
+ *
+ * For details refer to \ref gr_stream
+ */
+
+#ifndef IFX_BASE_STREAM_H
+#define IFX_BASE_STREAM_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Forward declaration of a stream handle.
+ */
+typedef struct ifx_Stream_s ifx_Stream_t;
+
+/**
+ * @brief Callback fetching one frame.
+ *
+ * The callback is called from the acquisition thread of the stream. It must
+ * write exactly frame_size values (see \ref ifx_Stream_Config_t) to frame and
+ * return true. If no frame could be fetched the callback returns false and
+ * leaves the reason in the SDK error state of the calling thread (see
+ * \ref ifx_error_get). IFX_OK and \ref IFX_ERROR_TIMEOUT let the stream try
+ * again, any other error stops the acquisition thread.
+ *
+ * @param [in]     context   Context pointer passed to \ref ifx_stream_create.
+ * @param [out]    frame     Destination of the frame.
+ *
+ * @return true if a frame was written to frame, false otherwise.
+ */
+typedef bool (*ifx_Stream_Fetch_t)(void* context, float* frame);
+
+/**
+ * @brief Configuration of a stream.
+ */
+typedef struct
+{
+    size_t frame_size;           /**< Number of float values per frame. */
+    uint32_t num_frames;         /**< Number of frames the ring buffer can hold. */
+    uint32_t decimation;         /**< Only every decimation-th frame is put into the ring buffer
+                                      (0 and 1 put every frame into the ring buffer). */
+    const char* record_filename; /**< If not NULL, every fetched frame is appended as raw float32
+                                      values to this file, independent of decimation. */
+} ifx_Stream_Config_t;
+
+/**
+ * @brief Counters of a stream.
+ */
+typedef struct
+{
+    uint64_t frames_fetched;  /**< Frames returned by the fetch callback. */
+    uint64_t frames_recorded; /**< Frames written to the record file. */
+    uint64_t frames_dropped;  /**< Frames overwritten in the ring buffer before they were read. */
+    uint64_t frames_read;     /**< Frames returned by \ref ifx_stream_read. */
+    uint32_t frames_queued;   /**< Frames currently held in the ring buffer. */
+    bool running;             /**< true while the acquisition thread is running. */
+} ifx_Stream_Stats_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+ * @{
+ */
+
+/** @defgroup gr_stream Stream
+ * @brief API for continuous acquisition into a ring buffer
+ *
+ * A stream runs a background thread that repeatedly calls a fetch callback
+ * (typically a wrapper around a get_next_frame function of a device) and
+ * stores the frames in a preallocated ring buffer. The consumer collects
+ * all frames acquired since its last call with a single call to
+ * \ref ifx_stream_read, which copies them into one contiguous array. This
+ * decouples the acquisition from a slow consumer, e.g., an interpreter
+ * that polls for data only from time to time.
+ *
+ * If the ring buffer is full, the oldest frame is overwritten and counted
+ * as dropped. Optionally, every frame is appended to a binary file by the
+ * acquisition thread, while only every n-th frame is put into the ring
+ * buffer as a preview (see \ref ifx_Stream_Config_t).
+ *
+ * No memory is allocated after \ref ifx_stream_create.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a stream and starts its acquisition thread.
+ *
+ * @param [in]     config    Stream configuration.
+ * @param [in]     fetch     Callback fetching one frame.
+ * @param [in]     context   Context pointer passed to fetch.
+ *
+ * @return Handle to the stream or NULL in case of an error.
+ */
+IFX_DLL_PUBLIC
+ifx_Stream_t* ifx_stream_create(const ifx_Stream_Config_t* config, ifx_Stream_Fetch_t fetch, void* context);
+
+/**
+ * @brief Stops the acquisition thread and destroys the stream.
+ *
+ * The function waits until the fetch callback returned, so the context passed
+ * to \ref ifx_stream_create can be released afterwards.
+ *
+ * @param [in]     stream    Stream handle.
+ */
+IFX_DLL_PUBLIC
+void ifx_stream_destroy(ifx_Stream_t* stream);
+
+/**
+ * @brief Reads frames from the ring buffer.
+ *
+ * Waits until at least one frame is available and copies up to max_frames
+ * frames, oldest first, to frames. The frames are stored contiguously, i.e.,
+ * frame i starts at frames + i * frame_size.
+ *
+ * If no frame arrived within timeout_ms, \ref IFX_ERROR_TIMEOUT is set. If the
+ * acquisition thread stopped due to an error and the ring buffer is empty,
+ * that error is set.
+ *
+ * @param [in]     stream      Stream handle.
+ * @param [out]    frames      Destination with space for max_frames frames.
+ * @param [in]     max_frames  Maximum number of frames to read.
+ * @param [in]     timeout_ms  Maximum time to wait for a frame in milliseconds.
+ *
+ * @return Number of frames copied to frames.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_stream_read(ifx_Stream_t* stream, float* frames, uint32_t max_frames, uint16_t timeout_ms);
+
+/**
+ * @brief Returns the counters of a stream.
+ *
+ * @param [in]     stream    Stream handle.
+ * @param [out]    stats     Counters.
+ */
+IFX_DLL_PUBLIC
+void ifx_stream_get_stats(ifx_Stream_t* stream, ifx_Stream_Stats_t* stats);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_BASE_STREAM_H */
@@ -0,0 +1,156 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <common/ThreadPolicy.hpp>
+
+#include "Error.h"
+#include "ThreadPolicy.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+namespace {
+
+const ThreadRole roles[] = {
+    ThreadRole::BridgeReader,
+    ThreadRole::Forwarder,
+    ThreadRole::Converter,
+    ThreadRole::DspWorker,
+};
+
+}  // namespace
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static bool is_valid_role(ifx_Thread_Role_t role);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static bool is_valid_role(ifx_Thread_Role_t role)
+{
+    return static_cast<unsigned>(role) < sizeof(roles) / sizeof(roles[0]);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void ifx_thread_policy_set(ifx_Thread_Role_t role, const ifx_Thread_Policy_t* policy)
+{
+    IFX_ERR_BRK_NULL(policy);
+    IFX_ERR_BRK_COND(!is_valid_role(role), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    IFX_ERR_BRK_COND(policy->scheduling > IFX_THREAD_SCHED_RR, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    IFX_ERR_BRK_COND(policy->scheduling != IFX_THREAD_SCHED_DEFAULT && (policy->priority < 1 || policy->priority > 99),
+                     IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ThreadPolicy strata_policy;
+    strata_policy.scheduling = static_cast<ThreadPolicy::Scheduling>(policy->scheduling);
+    strata_policy.priority = policy->priority;
+    strata_policy.cpuMask = policy->cpu_mask;
+    ThreadPolicies::instance().set(roles[role], strata_policy);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_thread_policy_get(ifx_Thread_Role_t role, ifx_Thread_Policy_t* policy)
+{
+    IFX_ERR_BRK_NULL(policy);
+    IFX_ERR_BRK_COND(!is_valid_role(role), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    const ThreadPolicy strata_policy = ThreadPolicies::instance().get(roles[role]);
+    policy->scheduling = static_cast<ifx_Thread_Scheduling_t>(strata_policy.scheduling);
+    policy->priority = strata_policy.priority;
+    policy->cpu_mask = strata_policy.cpuMask;
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_thread_policy_apply(ifx_Thread_Role_t role)
+{
+    IFX_ERR_BRV_COND(!is_valid_role(role), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, false);
+
+    return ThreadPolicies::instance().apply(roles[role]);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_thread_lock_memory(bool enable)
+{
+    return ThreadPolicies::instance().lockMemory(enable);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_thread_set_prefault(bool enable)
+{
+    ThreadPolicies::instance().setPrefault(enable);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_thread_get_wakeup_latency(ifx_Thread_Role_t role, ifx_Metrics_Latency_t* latency)
+{
+    IFX_ERR_BRV_NULL(latency, false);
+    IFX_ERR_BRV_COND(!is_valid_role(role), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, false);
+
+    // the histograms are registered when the policies are first used
+    ThreadPolicies::instance();
+    return ifx_metrics_find_latency(ThreadPolicies::getWakeupName(roles[role]), latency);
+}
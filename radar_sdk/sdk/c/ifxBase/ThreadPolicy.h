@@ -0,0 +1,211 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file ThreadPolicy.h
+ *
+ * \brief \copybrief gr_thread_policy
+ *
+ * For details refer to \ref gr_thread_policy
+ */
+
+#ifndef IFX_BASE_THREAD_POLICY_H
+#define IFX_BASE_THREAD_POLICY_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "Metrics.h"
+#include "Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Roles of the threads in the acquisition pipeline.
+ */
+typedef enum
+{
+    IFX_THREAD_ROLE_READER = 0,    /**< Threads receiving data from the board (USB, Ethernet, serial). */
+    IFX_THREAD_ROLE_FORWARDER = 1, /**< Thread passing received frames to the device layer. */
+    IFX_THREAD_ROLE_CONVERTER = 2, /**< Threads unpacking raw frames (the forwarder thread of Avian devices, the CW streaming thread). */
+    IFX_THREAD_ROLE_DSP_WORKER = 3 /**< Threads processing frames, e.g. the worker of \ref gr_stream. */
+} ifx_Thread_Role_t;
+
+/**
+ * @brief Scheduling class of a thread.
+ */
+typedef enum
+{
+    IFX_THREAD_SCHED_DEFAULT = 0, /**< Keep the scheduling class and priority. */
+    IFX_THREAD_SCHED_FIFO = 1,    /**< SCHED_FIFO (Windows: time critical priority). */
+    IFX_THREAD_SCHED_RR = 2       /**< SCHED_RR (Windows: highest priority). */
+} ifx_Thread_Scheduling_t;
+
+/**
+ * @brief Scheduling policy of a thread role.
+ */
+typedef struct
+{
+    ifx_Thread_Scheduling_t scheduling; /**< Scheduling class. */
+    int32_t priority;                   /**< Real-time priority (1 ... 99) for FIFO and RR, ignored otherwise. */
+    uint64_t cpu_mask;                  /**< Bit n allows CPU n, 0 means no restriction. */
+} ifx_Thread_Policy_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+ * @{
+ */
+
+/** @defgroup gr_thread_policy Thread Policy
+ * @brief API for real-time scheduling and CPU affinity of acquisition threads
+ *
+ * Each thread of the acquisition pipeline applies the policy of its role
+ * when it starts: it gets a name (e.g. strata-reader), is restricted to
+ * the CPUs of cpu_mask and switched to the requested scheduling class.
+ * Policies must therefore be set before the device is connected or the
+ * acquisition is started. Own processing threads can take a policy with
+ * \ref ifx_thread_policy_apply. A thread has only one role: the first
+ * role applied to a thread is kept for its lifetime.
+ *
+ * Real-time scheduling and memory locking require privileges
+ * (CAP_SYS_NICE and CAP_IPC_LOCK on Linux). Without them the threads keep
+ * running with the default settings; a warning is logged once and the
+ * counter thread_policy_denied of \ref gr_metrics is incremented. This is
+ * not treated as an error.
+ *
+ * Threads waiting for frames record their wake-up latency, the time from
+ * the notification until they run again, in the latency statistics
+ * thread_wakeup_forwarder, thread_wakeup_converter and thread_wakeup_dsp.
+ * The reader threads wake up inside the USB or socket driver, so there is
+ * no wake-up statistic for them.
+ * @{
+ */
+
+/**
+ * @brief Sets the scheduling policy of a thread role.
+ *
+ * @param [in]     role      thread role
+ * @param [in]     policy    scheduling policy
+ */
+IFX_DLL_PUBLIC
+void ifx_thread_policy_set(ifx_Thread_Role_t role, const ifx_Thread_Policy_t* policy);
+
+/**
+ * @brief Reads the scheduling policy of a thread role.
+ *
+ * @param [in]     role      thread role
+ * @param [out]    policy    scheduling policy
+ */
+IFX_DLL_PUBLIC
+void ifx_thread_policy_get(ifx_Thread_Role_t role, ifx_Thread_Policy_t* policy);
+
+/**
+ * @brief Applies the policy of a role to the calling thread.
+ *
+ * If the calling thread already has a role, nothing is changed.
+ *
+ * @param [in]     role      thread role
+ * @return true if the policy was applied completely or the thread already
+ *         has this role, false if parts of it were denied by the operating
+ *         system or the thread already has another role
+ */
+IFX_DLL_PUBLIC
+bool ifx_thread_policy_apply(ifx_Thread_Role_t role);
+
+/**
+ * @brief Locks all current and future memory pages of the process (mlockall).
+ *
+ * Not supported on Windows.
+ *
+ * @param [in]     enable    true to lock, false to unlock
+ * @return true on success, false if denied or not supported
+ */
+IFX_DLL_PUBLIC
+bool ifx_thread_lock_memory(bool enable);
+
+/**
+ * @brief Enables prefaulting of frame buffers.
+ *
+ * If enabled, the frame buffers of the acquisition are touched when they
+ * are allocated, so no page faults occur while frames are received.
+ * Disabled by default.
+ *
+ * @param [in]     enable    true to prefault frame buffers
+ */
+IFX_DLL_PUBLIC
+void ifx_thread_set_prefault(bool enable);
+
+/**
+ * @brief Reads the wake-up latency statistics of a thread role.
+ *
+ * @param [in]     role      thread role
+ * @param [out]    latency   wake-up latency statistics
+ * @return true on success, false if role is invalid
+ */
+IFX_DLL_PUBLIC
+bool ifx_thread_get_wakeup_latency(ifx_Thread_Role_t role, ifx_Metrics_Latency_t* latency);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_BASE_THREAD_POLICY_H */
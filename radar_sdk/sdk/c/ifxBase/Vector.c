@@ -54,6 +54,13 @@
 
 const ifx_Float_t clipping_value_for_db = 1e-6f;
 
+// true if the elements of the vector are contiguous in memory, i.e., if the
+// vector can be passed to the kernels in internal/Simd.h
+#define VEC_CONTIGUOUS(v) (vStride(v) == 1 && sizeof(ifx_Float_t) == sizeof(float))
+
+// pointer to the first element of a real or complex vector as float*
+#define VEC_PTR(v) ((float*)IFX_MDA_DATA(v))
+
 /*
 ==============================================================================
    5. LOCAL FUNCTION PROTOTYPES
@@ -99,95 +106,6 @@ static int median_rank(
 ==============================================================================
 */
 
-#ifdef IFX_SSE2
-/**
- * @brief Compute dot product between x and y
- *
- * Compute the dot product between the vectors x and y of length len. Use SSE2
- * to speed up the computation as much as possible.
- *
- * @param [in]  x       array of len elements
- * @param [in]  y       array of len elements
- * @param [in]  len     length of arrays x and y
- * @retval dot product between x and y
- */
-static float dot_sse2(const float* x, const float* y, size_t len)
-{
-    vf32x4 vv;
-
-    // len rounded down to the next integer divisable by 4
-    const size_t len_truncated4 = len & ~3;
-
-    // len rounded down to the next integer divisable by 16
-    const size_t len_truncated16 = len & ~15;
-
-    // Compute the dot product of the first len_truncated16 elements
-    {
-        vf32x4 vv0 = vf32x4_setzero();  // vv0 = 0
-        vf32x4 vv1 = vf32x4_setzero();  // vv1 = 0
-        vf32x4 vv2 = vf32x4_setzero();  // vv2 = 0
-        vf32x4 vv3 = vf32x4_setzero();  // vv3 = 0
-
-        // Compute the dot product using SSE2 instructions. Use four SSE2
-        // vectors with 4 elements each to utilize the CPU pipeline as much as
-        // possible.
-        for (size_t i = 0; i < len_truncated16; i += 16)
-        {
-            vf32x4 x0 = vf32x4_loadu(&x[i + 0]);
-            vf32x4 y0 = vf32x4_loadu(&y[i + 0]);
-
-            vf32x4 x1 = vf32x4_loadu(&x[i + 4]);
-            vf32x4 y1 = vf32x4_loadu(&y[i + 4]);
-
-            vf32x4 x2 = vf32x4_loadu(&x[i + 8]);
-            vf32x4 y2 = vf32x4_loadu(&y[i + 8]);
-
-            vf32x4 x3 = vf32x4_loadu(&x[i + 12]);
-            vf32x4 y3 = vf32x4_loadu(&y[i + 12]);
-
-            vf32x4 m0 = vf32x4_mul(x0, y0);  // x0*y0
-            vf32x4 m1 = vf32x4_mul(x1, y1);  // x1*y1
-            vf32x4 m2 = vf32x4_mul(x2, y2);  // x2*y2
-            vf32x4 m3 = vf32x4_mul(x3, y3);  // x3*y3
-
-            vv0 = vf32x4_add(vv0, m0);       // vv0 += x0*y0
-            vv1 = vf32x4_add(vv1, m1);       // vv1 += x1*y1
-            vv2 = vf32x4_add(vv2, m2);       // vv2 += x2*y2
-            vv3 = vf32x4_add(vv3, m3);       // vv3 += x3*y3
-        }
-
-        vf32x4 vv01 = vf32x4_add(vv0, vv1);  // vv01 = vv0 + vv1
-        vf32x4 vv23 = vf32x4_add(vv2, vv3);  // vv23 = vv2 + vv3
-
-        vv = vf32x4_add(vv01, vv23);         // vv = vv01 + vv23
-    }
-
-    for (size_t i = len_truncated16; i < len_truncated4; i += 4)
-    {
-        vf32x4 x0 = vf32x4_loadu(&x[i]);
-        vf32x4 y0 = vf32x4_loadu(&y[i]);
-
-        vv = vf32x4_mla(vv, x0, y0);  // vv += x0 + y0
-    }
-
-    // compute the sum of the vector vv
-    float v = vf32x4_extract1(vv, 0);
-    v += vf32x4_extract1(vv, 1);
-    v += vf32x4_extract1(vv, 2);
-    v += vf32x4_extract1(vv, 3);
-
-    // compute the dot element for the remaining elements
-    for (size_t i = len_truncated4; i < len; i++)
-    {
-        v += x[i] * y[i];
-    }
-
-    return v;
-}
-#endif
-
-//----------------------------------------------------------------------------
-
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -615,6 +533,9 @@ ifx_Float_t ifx_vec_sum_r(const ifx_Vector_R_t* vector)
      * The algorithm is taken from Wikipedia, see
      * https://en.wikipedia.org/wiki/Kahan_summation_algorithm.
      */
+    if (VEC_CONTIGUOUS(vector))
+        return ifx_simd_kernels()->sum_r(VEC_PTR(vector), vLen(vector));
+
     ifx_Float_t sum = 0;
     ifx_Float_t c = 0; /* running compensation for lost low-order bits */
 
@@ -654,6 +575,9 @@ ifx_Float_t ifx_vec_sqsum_r(const ifx_Vector_R_t* vector)
 {
     IFX_VEC_BRV_VALID(vector, 0);
 
+    if (VEC_CONTIGUOUS(vector))
+        return ifx_simd_kernels()->sqsum_r(VEC_PTR(vector), vLen(vector));
+
     ifx_Float_t result = 0.f;
     const uint32_t length = vLen(vector);
 
@@ -672,6 +596,11 @@ ifx_Float_t ifx_vec_sqsum_c(const ifx_Vector_C_t* vector)
 {
     IFX_VEC_BRV_VALID(vector, 0);
 
+    // the squared sum of a complex vector is the squared sum of the
+    // interleaved real and imaginary parts
+    if (VEC_CONTIGUOUS(vector))
+        return ifx_simd_kernels()->sqsum_r(VEC_PTR(vector), 2 * vLen(vector));
+
     ifx_Float_t result = 0.f;
     const uint32_t length = vLen(vector);
 
@@ -833,6 +762,12 @@ void ifx_vec_add_r(const ifx_Vector_R_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2) && VEC_CONTIGUOUS(result))
+    {
+        ifx_simd_kernels()->add_r(VEC_PTR(v1), VEC_PTR(v2), VEC_PTR(result), vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = vAt(v1, i) + vAt(v2, i);
@@ -869,6 +804,12 @@ void ifx_vec_sub_r(const ifx_Vector_R_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2) && VEC_CONTIGUOUS(result))
+    {
+        ifx_simd_kernels()->sub_r(VEC_PTR(v1), VEC_PTR(v2), VEC_PTR(result), vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = vAt(v1, i) - vAt(v2, i);
@@ -905,6 +846,12 @@ void ifx_vec_mul_r(const ifx_Vector_R_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2) && VEC_CONTIGUOUS(result))
+    {
+        ifx_simd_kernels()->mul_r(VEC_PTR(v1), VEC_PTR(v2), VEC_PTR(result), vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = vAt(v1, i) * vAt(v2, i);
@@ -923,6 +870,12 @@ void ifx_vec_mul_c(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2) && VEC_CONTIGUOUS(result))
+    {
+        ifx_simd_kernels()->mul_c(VEC_PTR(v1), VEC_PTR(v2), VEC_PTR(result), vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = ifx_complex_mul(vAt(v1, i), vAt(v2, i));
@@ -941,6 +894,12 @@ void ifx_vec_mul_cr(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2) && VEC_CONTIGUOUS(result))
+    {
+        ifx_simd_kernels()->mul_cr(VEC_PTR(v1), VEC_PTR(v2), VEC_PTR(result), vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = ifx_complex_mul_real(vAt(v1, i), vAt(v2, i));
@@ -971,6 +930,12 @@ void ifx_vec_abs_c(const ifx_Vector_C_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
+    if (VEC_CONTIGUOUS(input) && VEC_CONTIGUOUS(output))
+    {
+        ifx_simd_kernels()->abs_c(VEC_PTR(input), VEC_PTR(output), vLen(input));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(input); ++i)
     {
         vAt(output, i) = ifx_complex_abs(vAt(input, i));
@@ -1034,6 +999,12 @@ void ifx_vec_scale_r(const ifx_Vector_R_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
+    if (VEC_CONTIGUOUS(input) && VEC_CONTIGUOUS(output))
+    {
+        ifx_simd_kernels()->scale_r(VEC_PTR(input), scale, VEC_PTR(output), vLen(input));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(input); ++i)
     {
         vAt(output, i) = vAt(input, i) * scale;
@@ -1082,6 +1053,12 @@ void ifx_vec_scale_cr(const ifx_Vector_C_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
+    if (VEC_CONTIGUOUS(input) && VEC_CONTIGUOUS(output))
+    {
+        ifx_simd_kernels()->scale_r(VEC_PTR(input), scale, VEC_PTR(output), 2 * vLen(input));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(input); ++i)
     {
         vAt(output, i) = ifx_complex_mul_real(vAt(input, i), scale);
@@ -1123,6 +1100,12 @@ void ifx_vec_mac_r(const ifx_Vector_R_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2) && VEC_CONTIGUOUS(result))
+    {
+        ifx_simd_kernels()->mac_r(VEC_PTR(v1), VEC_PTR(v2), scale, VEC_PTR(result), vLen(v1));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(v1); ++i)
     {
         vAt(result, i) = vAt(v1, i) + (scale * vAt(v2, i));
@@ -1385,19 +1368,16 @@ ifx_Float_t ifx_vec_dot2_r(const ifx_Vector_R_t* v1, const ifx_Vector_R_t* v2, u
     IFX_ERR_BRV_COND(offset_v1 + len > vLen(v1), IFX_ERROR_DIMENSION_MISMATCH, IFX_NAN);
     IFX_ERR_BRV_COND(offset_v2 + len > vLen(v2), IFX_ERROR_DIMENSION_MISMATCH, IFX_NAN);
 
-#ifdef IFX_SSE2
-    // We can use the SSE2 version of the dot product if:
-    //  - SSE2 is available
+    // We can use the SIMD version of the dot product if:
     //  - the strides of v1 and v2 are 1
     //  - ifx_Float_t corresponds to float (and not double)
-    if (vStride(v1) == 1 && vStride(v2) == 1 && sizeof(ifx_Float_t) == sizeof(float))
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2))
     {
-        const ifx_Float_t* x_ptr = IFX_MDA_DATA(v1) + offset_v1;
-        const ifx_Float_t* y_ptr = IFX_MDA_DATA(v2) + offset_v2;
+        const float* x_ptr = VEC_PTR(v1) + offset_v1;
+        const float* y_ptr = VEC_PTR(v2) + offset_v2;
 
-        return dot_sse2(x_ptr, y_ptr, len);
+        return ifx_simd_kernels()->dot_r(x_ptr, y_ptr, len);
     }
-#endif
 
     // naive implementation
     ifx_Float_t s = 0;
@@ -1533,6 +1513,12 @@ void ifx_vec_squared_norm_c(const ifx_Vector_C_t* input, ifx_Vector_R_t* output)
 {
     IFX_VEC_BRK_DIM(input, output);
 
+    if (VEC_CONTIGUOUS(input) && VEC_CONTIGUOUS(output))
+    {
+        ifx_simd_kernels()->sqnorm_c(VEC_PTR(input), VEC_PTR(output), vLen(input));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(input); i++)
     {
         const ifx_Complex_t z = vAt(input, i);
@@ -1560,6 +1546,12 @@ void ifx_vec_spectrum2_to_db(ifx_Vector_R_t* vec, ifx_Float_t scale, ifx_Float_t
     const ifx_Float_t threshold2 = threshold * threshold;
     const ifx_Float_t clip_value = ifx_math_linear_to_db(clipping_value_for_db, scale);
 
+    if (VEC_CONTIGUOUS(vec))
+    {
+        ifx_simd_kernels()->pow2db_r(VEC_PTR(vec), scale / 2, threshold2, clip_value, vLen(vec));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(vec); i++)
     {
         if (vAt(vec, i) < threshold2)
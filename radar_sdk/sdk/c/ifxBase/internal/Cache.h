@@ -0,0 +1,127 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_BASE_CACHE_INTERNAL_H
+#define IFX_BASE_CACHE_INTERNAL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stddef.h>
+
+#include "../Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/*
+ * @brief Creates the object for a key
+ *
+ * @param [in]  key     key passed to ifx_cache_acquire
+ * @retval      object  newly created object
+ * @retval      NULL    on error
+ */
+typedef void* (*ifx_Cache_Create_t)(const void* key);
+
+/*
+ * @brief Destroys an object created by the matching ifx_Cache_Create_t
+ */
+typedef void (*ifx_Cache_Destroy_t)(void* object);
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+ * @brief Returns a shared object for a key
+ *
+ * The cache is process-wide and thread-safe. Objects are identified by the
+ * create function and the bytes of the key, so different kinds of objects
+ * do not collide even if their keys are equal. Padding bytes of the key must
+ * be initialized (e.g. by memset) because they take part in the comparison.
+ *
+ * If the object is not in the cache it is created by calling create with key.
+ * Otherwise its reference count is incremented. The object must be treated
+ * as read-only by all users and must be returned using ifx_cache_release.
+ *
+ * @param [in]  key         key of the object
+ * @param [in]  key_size    size of key in bytes
+ * @param [in]  create      function to create the object
+ * @param [in]  destroy     function to destroy the object once it is no
+ *                          longer referenced
+ * @retval      object      shared object
+ * @retval      NULL        if create failed
+ */
+IFX_DLL_PUBLIC
+void* ifx_cache_acquire(const void* key, size_t key_size, ifx_Cache_Create_t create, ifx_Cache_Destroy_t destroy);
+
+/*
+ * @brief Releases an object returned by ifx_cache_acquire
+ *
+ * Decrements the reference count and destroys the object if it is no longer
+ * referenced. Does nothing if object is NULL.
+ *
+ * @param [in]  object      object returned by ifx_cache_acquire
+ */
+IFX_DLL_PUBLIC
+void ifx_cache_release(const void* object);
+
+/*
+ * @brief Returns the number of objects currently in the cache
+ */
+IFX_DLL_PUBLIC
+size_t ifx_cache_size(void);
+
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_BASE_CACHE_INTERNAL_H */
@@ -27,99 +27,83 @@
 ** ===========================================================================
 */
 
-/*
-==============================================================================
-   1. INCLUDE FILES
-==============================================================================
-*/
-
+#ifndef IFX_BASE_METRICS_INTERNAL_H
+#define IFX_BASE_METRICS_INTERNAL_H
 
 /*
 ==============================================================================
-   2. LOCAL DEFINITIONS
+   1. INCLUDE FILES
 ==============================================================================
 */
 
-#if (_MSC_VER && !__INTEL_COMPILER) || ((_WIN32 || _WIN64) && __GNUC__)
-#include <malloc.h>
-#define ALIGNED_MALLOC(size, align, mem) mem = _aligned_malloc((size), (alignment))
-#define ALIGNED_FREE(mem)   \
-    do                      \
-    {                       \
-        _aligned_free(mem); \
-        (mem) = NULL;       \
-    } while (0)
-#else
-// posix_memalign requires _POSIX_C_SOURCE >= 200112L. See manpage of posix_memalign for more information.
-// This define needs to be set before including stdlib.h.
-#ifndef _POSIX_C_SOURCE
-// NOLINTNEXTLINE(bugprone-reserved-identifier)
-#define _POSIX_C_SOURCE 200809L
-#endif
+#include "../Types.h"
 
-#include <stdlib.h>
 
-#define ALIGNED_MALLOC(size, align, mem)                      \
-    do                                                        \
-    {                                                         \
-        if (posix_memalign(&(mem), (alignment), (size)) != 0) \
-        {                                                     \
-            (mem) = NULL;                                     \
-        }                                                     \
-    } while (0)
-#define ALIGNED_FREE(mem) \
-    do                    \
-    {                     \
-        free(mem);        \
-        (mem) = NULL;     \
-    } while (0)
+#ifdef __cplusplus
+extern "C"
+{
 #endif
 
-// include only here to avoid warning about posix_memalign
-#include "Mem.h"
 
 /*
 ==============================================================================
-   7. EXPORTED FUNCTIONS
+   2. DEFINITIONS
 ==============================================================================
 */
 
-void* ifx_mem_alloc(size_t size)
-{
-    void* mem = malloc(size);
-    return mem;
-}
-
-//----------------------------------------------------------------------------
-
-void* ifx_mem_calloc(size_t count,
-                     size_t element_size)
-{
-    void* mem = calloc(count, element_size);
-    return mem;
-}
-
-//----------------------------------------------------------------------------
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
 
-void* ifx_mem_aligned_alloc(size_t size,
-                            size_t alignment)
+/*
+ * @brief Pipeline stages of the SDK that are measured
+ *
+ * The names of the stages are listed in Metrics.cpp.
+ */
+typedef enum
 {
+    IFX_METRICS_STAGE_FMCW_GET_NEXT_FRAME,
+    IFX_METRICS_STAGE_FMCW_FRAME_CONVERSION,
+    IFX_METRICS_STAGE_FMCW_RECONNECT,
+    IFX_METRICS_STAGE_FFT,
+    IFX_METRICS_STAGE_RDM,
+    IFX_METRICS_STAGE_CFAR,
+    IFX_METRICS_STAGE_DBF,
+    IFX_METRICS_STAGE_COUNT
+} ifx_Metrics_Stage_t;
 
-    void* mem = 0;
-    ALIGNED_MALLOC(size, alignment, mem);
-    return mem;
-}
-
-//----------------------------------------------------------------------------
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
 
-void ifx_mem_free(void* mem)
-{
-    free(mem);
-}
+/*
+ * @brief Start of a measurement
+ *
+ * @retval  timestamp   monotonic time in nanoseconds
+ * @retval  0           if metrics are disabled
+ */
+IFX_DLL_PUBLIC
+uint64_t ifx_metrics_begin(void);
 
-//----------------------------------------------------------------------------
+/*
+ * @brief End of a measurement
+ *
+ * Records the time since start in the latency histogram of the stage. Does
+ * nothing if start is 0.
+ *
+ * @param [in]  stage   measured stage
+ * @param [in]  start   value returned by ifx_metrics_begin
+ */
+IFX_DLL_PUBLIC
+void ifx_metrics_end(ifx_Metrics_Stage_t stage, uint64_t start);
+
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
 
-void ifx_mem_aligned_free(void* mem)
-{
-    ALIGNED_FREE(mem);
-}
+#endif /* IFX_BASE_METRICS_INTERNAL_H */
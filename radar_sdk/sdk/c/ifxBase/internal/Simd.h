@@ -57,4 +57,137 @@
 
 #endif
 
+// NEON is part of the base instruction set on AArch64 and is detected at
+// compile time on 32-bit ARM.
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define IFX_NEON
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../Types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Instruction set of a kernel table
+ */
+typedef enum
+{
+    IFX_SIMD_ISA_SCALAR = 0, /**< Portable C reference implementation */
+    IFX_SIMD_ISA_SSE2 = 1,   /**< x86 SSE2 */
+    IFX_SIMD_ISA_AVX2 = 2,   /**< x86 AVX2 and FMA3 */
+    IFX_SIMD_ISA_NEON = 3    /**< ARM NEON */
+} ifx_Simd_Isa_t;
+
+/**
+ * @brief Table of elementwise and reduction kernels
+ *
+ * All kernels operate on contiguous arrays of float. Complex arrays are
+ * interleaved (real, imaginary) such that a pointer to ifx_Complex_t can be
+ * passed after a cast; len is then the number of complex elements. Unless
+ * stated otherwise input and output arrays may be identical (in-place
+ * operation) but must not partially overlap.
+ *
+ * The SIMD kernels may change the order of floating point operations
+ * compared to the scalar reference, so results can differ in the last bits.
+ *
+ * Kernels that serve a single algorithm or device are kept in tables of
+ * their own which follow the instruction set selected here, see
+ * internal/SimdMti.h, internal/SimdMonopulse.h, internal/SimdAdc.h and
+ * internal/SimdFixed.h.
+ */
+typedef struct
+{
+    ifx_Simd_Isa_t isa; /**< Instruction set of this table */
+    const char* name;   /**< Name of the instruction set */
+
+    /** Returns sum of x using compensated (Kahan) summation */
+    float (*sum_r)(const float* x, size_t len);
+    /** Returns sum of squares of x */
+    float (*sqsum_r)(const float* x, size_t len);
+    /** Returns dot product of x and y */
+    float (*dot_r)(const float* x, const float* y, size_t len);
+
+    /** z = x + y */
+    void (*add_r)(const float* x, const float* y, float* z, size_t len);
+    /** z = x - y */
+    void (*sub_r)(const float* x, const float* y, float* z, size_t len);
+    /** z = x * y (also used for windowing) */
+    void (*mul_r)(const float* x, const float* y, float* z, size_t len);
+    /** y = x * scale */
+    void (*scale_r)(const float* x, float scale, float* y, size_t len);
+    /** z = x + scale * y */
+    void (*mac_r)(const float* x, const float* y, float scale, float* z, size_t len);
+    /** y = min(max(x, min_value), max_value) */
+    void (*clip_r)(const float* x, float min_value, float max_value, float* y, size_t len);
+    /** z = max(x, y) */
+    void (*max_r)(const float* x, const float* y, float* z, size_t len);
+
+    /** z = x * y for complex x, y, and z */
+    void (*mul_c)(const float* x, const float* y, float* z, size_t len);
+    /** z = x * w for complex x and z and real w (windowing of complex data) */
+    void (*mul_cr)(const float* x, const float* w, float* z, size_t len);
+    /** y = |x| for complex x and real y */
+    void (*abs_c)(const float* x, float* y, size_t len);
+    /** y = |x|^2 for complex x and real y */
+    void (*sqnorm_c)(const float* x, float* y, size_t len);
+
+    /**
+     * In-place conversion of squared magnitudes to dB:
+     * x = (x < threshold2) ? clip_value : scale * log10(x)
+     */
+    void (*pow2db_r)(float* x, float scale, float threshold2, float clip_value, size_t len);
+
+    /**
+     * Local maxima search: writes all indices i in [begin, end) with
+     * x[i] >= threshold, x[i] >= x[i-2], x[i] >= x[i-1], x[i] > x[i+1] and
+     * x[i] > x[i+2] in ascending order to index and returns their number.
+     * The neighbours x[begin-2] ... x[end+1] must be valid; index must have
+     * space for end - begin entries.
+     */
+    size_t (*local_max_r)(const float* x, size_t begin, size_t end, float threshold, uint32_t* index);
+} ifx_Simd_Kernels_t;
+
+/**
+ * @brief Returns the kernel table for the best instruction set of the CPU
+ *
+ * The CPU is queried on the first call. The result is cached. If an
+ * instruction set was forced using \ref ifx_simd_select_isa that table is
+ * returned instead.
+ */
+IFX_DLL_PUBLIC
+const ifx_Simd_Kernels_t* ifx_simd_kernels(void);
+
+/**
+ * @brief Returns the kernel table of the given instruction set
+ *
+ * @retval kernel table if the instruction set is compiled in and supported by the CPU
+ * @retval NULL otherwise
+ */
+IFX_DLL_PUBLIC
+const ifx_Simd_Kernels_t* ifx_simd_kernels_for_isa(ifx_Simd_Isa_t isa);
+
+/**
+ * @brief Forces the instruction set returned by \ref ifx_simd_kernels
+ *
+ * This is meant for comparing the SIMD kernels against the scalar reference
+ * and for benchmarking. The function is not thread-safe with respect to
+ * concurrent processing.
+ *
+ * @retval true if the instruction set is available and was selected
+ * @retval false otherwise
+ */
+IFX_DLL_PUBLIC
+bool ifx_simd_select_isa(ifx_Simd_Isa_t isa);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
 #endif  // IFX_SIMD_H
@@ -0,0 +1,84 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_SIMD_ADC_H
+#define IFX_SIMD_ADC_H
+
+#include "Simd.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief ADC sample unpacking kernels used by the BGT60LTR11 and BGT24ATR22 device implementations
+ *
+ * The conventions of \ref ifx_Simd_Kernels_t apply. There is one table per
+ * instruction set; \ref ifx_simd_adc_kernels returns the table matching the
+ * instruction set selected for \ref ifx_simd_kernels.
+ */
+typedef struct
+{
+    /**
+     * Unpacks complex 8-bit ADC samples stored in bits 9..2 of 16-bit words
+     * (as read out from BGT60LTR11) into normalized floats:
+     * y[2i] = ((x[i * stride] >> 2) & 0xFF) / 255 and
+     * y[2i+1] = ((x[i * stride + 1] >> 2) & 0xFF) / 255.
+     * stride is the number of words per sample and must be at least 2.
+     */
+    void (*adc8_c)(const uint16_t* x, size_t stride, float* y, size_t len);
+    /**
+     * Unpacks complex 12-bit ADC samples stored in the lower bits of
+     * interleaved 16-bit (I, Q) words (as read out from BGT24ATR22) into
+     * normalized floats: y[i] = (x[i] & 0xFFF) / 4095 for i < 2 * len.
+     */
+    void (*adc12_c)(const uint16_t* x, float* y, size_t len);
+} ifx_Simd_Adc_Kernels_t;
+
+/**
+ * @brief Returns the table for the instruction set of \ref ifx_simd_kernels
+ */
+IFX_DLL_PUBLIC
+const ifx_Simd_Adc_Kernels_t* ifx_simd_adc_kernels(void);
+
+/**
+ * @brief Returns the table of the given instruction set
+ *
+ * @retval kernel table if the instruction set is compiled in and supported by the CPU
+ * @retval NULL otherwise
+ */
+IFX_DLL_PUBLIC
+const ifx_Simd_Adc_Kernels_t* ifx_simd_adc_kernels_for_isa(ifx_Simd_Isa_t isa);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // IFX_SIMD_ADC_H
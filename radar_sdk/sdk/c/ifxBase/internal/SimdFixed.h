@@ -0,0 +1,88 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_SIMD_FIXED_H
+#define IFX_SIMD_FIXED_H
+
+#include "Simd.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Fixed-point kernels used by Inference.c and FFTQ15.c in ifxAlgo and the Q15 path of RangeDopplerMap.c
+ *
+ * The conventions of \ref ifx_Simd_Kernels_t apply. There is one table per
+ * instruction set; \ref ifx_simd_fixed_kernels returns the table matching the
+ * instruction set selected for \ref ifx_simd_kernels.
+ */
+typedef struct
+{
+    /** Returns dot product of the 8-bit integers x and y accumulated in 32 bits */
+    int32_t (*dot_s8)(const int8_t* x, const int8_t* y, size_t len);
+    /**
+     * Q15 multiplication with rounding: z = (x * y + 2^14) >> 15.
+     * x and z may be identical. x[i] and y[i] must not both be -32768.
+     */
+    void (*mul_q15)(const int16_t* x, const int16_t* y, int16_t* z, size_t len);
+    /**
+     * One radix-2 decimation in time stage on len complex Q15 values with
+     * butterfly distance half and a block scaling of 2^-shift: for each
+     * group of 2 * half values a = (a + w * b) >> shift and
+     * b = (a - w * b) >> shift with a = x[k] and b = x[k + half], rounded
+     * once from 32-bit intermediates. The half twiddle factors are stored as
+     * four values (re, -im, im, re) per butterfly. shift is at most 2.
+     * Returns the largest absolute value of all real and imaginary parts
+     * written, which is used to select the shift of the next stage.
+     */
+    int32_t (*bfly_q15)(int16_t* x, const int16_t* w, uint32_t shift, size_t half, size_t len);
+} ifx_Simd_Fixed_Kernels_t;
+
+/**
+ * @brief Returns the table for the instruction set of \ref ifx_simd_kernels
+ */
+IFX_DLL_PUBLIC
+const ifx_Simd_Fixed_Kernels_t* ifx_simd_fixed_kernels(void);
+
+/**
+ * @brief Returns the table of the given instruction set
+ *
+ * @retval kernel table if the instruction set is compiled in and supported by the CPU
+ * @retval NULL otherwise
+ */
+IFX_DLL_PUBLIC
+const ifx_Simd_Fixed_Kernels_t* ifx_simd_fixed_kernels_for_isa(ifx_Simd_Isa_t isa);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // IFX_SIMD_FIXED_H
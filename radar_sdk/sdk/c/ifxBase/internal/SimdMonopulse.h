@@ -0,0 +1,77 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_SIMD_MONOPULSE_H
+#define IFX_SIMD_MONOPULSE_H
+
+#include "Simd.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Phase monopulse kernels used by AngleMonopulse.c in ifxRadar
+ *
+ * The conventions of \ref ifx_Simd_Kernels_t apply. There is one table per
+ * instruction set; \ref ifx_simd_monopulse_kernels returns the table matching the
+ * instruction set selected for \ref ifx_simd_kernels.
+ */
+typedef struct
+{
+    /**
+     * Phase monopulse angle in degrees for complex x1 and x2:
+     * y = asin(clamp(scale * arg(x1 * conj(x2) * c), -1, 1)) * 180 / pi
+     * with a single complex calibration factor c (NULL for c = 1). arg and
+     * asin are polynomial approximations with an absolute error below 1e-6 rad.
+     */
+    void (*monopulse_c)(const float* x1, const float* x2, const float* c, float scale, float* y, size_t len);
+} ifx_Simd_Monopulse_Kernels_t;
+
+/**
+ * @brief Returns the table for the instruction set of \ref ifx_simd_kernels
+ */
+IFX_DLL_PUBLIC
+const ifx_Simd_Monopulse_Kernels_t* ifx_simd_monopulse_kernels(void);
+
+/**
+ * @brief Returns the table of the given instruction set
+ *
+ * @retval kernel table if the instruction set is compiled in and supported by the CPU
+ * @retval NULL otherwise
+ */
+IFX_DLL_PUBLIC
+const ifx_Simd_Monopulse_Kernels_t* ifx_simd_monopulse_kernels_for_isa(ifx_Simd_Isa_t isa);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // IFX_SIMD_MONOPULSE_H
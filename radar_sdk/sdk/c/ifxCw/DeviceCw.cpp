@@ -228,6 +228,31 @@ ifx_Matrix_R_t* ifx_cw_capture_frame(ifx_Device_Cw_t* handle, ifx_Matrix_R_t* fr
     return rdk::call_func(handle, &ifx_Device_Cw_t::capture_frame, frame);
 }
 
+void ifx_cw_start_streaming(ifx_Device_Cw_t* handle, uint32_t num_buffers, ifx_Cw_Stream_Callback_t callback, void* context)
+{
+    rdk::call_func(handle, &ifx_Device_Cw_t::start_streaming, num_buffers, callback, context);
+}
+
+void ifx_cw_stop_streaming(ifx_Device_Cw_t* handle)
+{
+    rdk::call_func(handle, &ifx_Device_Cw_t::stop_streaming);
+}
+
+bool ifx_cw_is_streaming(ifx_Device_Cw_t* handle)
+{
+    return rdk::call_func(handle, &ifx_Device_Cw_t::is_streaming);
+}
+
+ifx_Matrix_R_t* ifx_cw_get_next_frame(ifx_Device_Cw_t* handle, ifx_Matrix_R_t* frame, uint16_t timeout_ms)
+{
+    return rdk::call_func(handle, &ifx_Device_Cw_t::get_next_frame, frame, timeout_ms);
+}
+
+void ifx_cw_get_stream_statistics(ifx_Device_Cw_t* handle, ifx_Cw_Stream_Statistics_t* statistics)
+{
+    rdk::call_func(handle, &ifx_Device_Cw_t::get_stream_statistics, statistics);
+}
+
 ifx_Radar_Sensor_t ifx_cw_get_sensor_type(const ifx_Device_Cw_t* handle)
 {
     return rdk::call_func(handle, &ifx_Device_Cw_t::get_sensor_type);
@@ -68,6 +68,26 @@ extern "C"
 
 typedef struct DeviceCw ifx_Device_Cw_t;
 
+/**
+ * @brief Callback receiving frames while CW streaming is active.
+ *
+ * The frame is owned by the stream and is only valid during the callback.
+ * The same matrix is overwritten with the next frame after the callback has
+ * returned, so the data must be copied if it is needed later. The callback
+ * is invoked from the delivery thread of the stream, one frame at a time.
+ *
+ * If the device stops responding, the callback is invoked a last time with
+ * *frame* set to NULL and *error* set to @ref IFX_ERROR_COMMUNICATION_ERROR,
+ * and the stream ends. For all other frames *error* is @ref IFX_OK.
+ *
+ * @param [in]     frame         Captured frame with dimensions
+ *                               num_rx_antennas (rows) x num_samples (columns),
+ *                               or NULL if the stream has failed.
+ * @param [in]     error         @ref IFX_OK or the reason the stream has ended.
+ * @param [in]     context       Context pointer passed to \ref ifx_cw_start_streaming.
+ */
+typedef void (*ifx_Cw_Stream_Callback_t)(const ifx_Matrix_R_t* frame, ifx_Error_t error, void* context);
+
 /*
 ==============================================================================
 4. FUNCTION PROTOTYPES
@@ -391,6 +411,94 @@ float ifx_cw_measure_tx_power(ifx_Device_Cw_t* handle, uint32_t antenna);
 IFX_DLL_PUBLIC
 ifx_Matrix_R_t* ifx_cw_capture_frame(ifx_Device_Cw_t* handle, ifx_Matrix_R_t* frame);
 
+/**
+ * @brief Starts continuous capturing of frames.
+ *
+ * In contrast to \ref ifx_cw_capture_frame the data acquisition is set up
+ * only once and frames are captured back to back in a background thread.
+ * Each frame is converted directly into one of *num_buffers* preallocated
+ * matrices with dimensions num_rx_antennas (rows) x num_samples (columns).
+ *
+ * If *callback* is NULL, the frames are queued in the ring of matrices and
+ * are fetched with \ref ifx_cw_get_next_frame. If the ring is full, the oldest
+ * frame is discarded and counted as overflow.
+ * If *callback* is not NULL, every frame is passed to the callback and
+ * \ref ifx_cw_get_next_frame must not be used. Captures continue while the
+ * callback runs; up to *num_buffers* captures are buffered. Only if the
+ * callback falls behind by more than that, the capture of the next frame is
+ * delayed.
+ *
+ * The continuous wave signal must be active (see \ref ifx_cw_start_signal).
+ * While streaming is active, \ref ifx_cw_capture_frame and the measurement
+ * functions are not available. Changing any configuration or stopping the
+ * signal stops streaming.
+ *
+ * @param [in]     handle        A handle to the CW device
+ * @param [in]     num_buffers   Number of preallocated frames in the ring and of
+ *                               raw capture buffers (at least 2).
+ * @param [in]     callback      Callback receiving the frames or NULL.
+ * @param [in]     context       Context pointer passed to the callback.
+ */
+IFX_DLL_PUBLIC
+void ifx_cw_start_streaming(ifx_Device_Cw_t* handle, uint32_t num_buffers, ifx_Cw_Stream_Callback_t callback, void* context);
+
+/**
+ * @brief Stops continuous capturing of frames.
+ *
+ * The frame currently being captured is completed before this function
+ * returns. Frames still queued are dropped.
+ *
+ * @param [in]     handle        A handle to the CW device
+ */
+IFX_DLL_PUBLIC
+void ifx_cw_stop_streaming(ifx_Device_Cw_t* handle);
+
+/**
+ * @brief Checks if streaming is active.
+ *
+ * Streaming ends without calling \ref ifx_cw_stop_streaming if the device
+ * stops responding.
+ *
+ * @param [in]     handle        A handle to the CW device
+ *
+ * @return true if streaming is active, false otherwise
+ */
+IFX_DLL_PUBLIC
+bool ifx_cw_is_streaming(ifx_Device_Cw_t* handle);
+
+/**
+ * @brief Fetches the next frame from the stream.
+ *
+ * The oldest queued frame is copied to *frame*. If no frame is queued, the
+ * function blocks until a frame arrives or *timeout_ms* has passed.
+ *
+ * If frame is NULL, memory for the matrix will be allocated and returned.
+ * Otherwise the memory of frame will be used.
+ *
+ * @ref IFX_ERROR_TIMEOUT is set if no frame arrived within *timeout_ms*.
+ * @ref IFX_ERROR_COMMUNICATION_ERROR is set if streaming ended because
+ * the device stopped responding and all remaining frames have been fetched.
+ *
+ * @param [in]     handle        A handle to the CW device
+ * @param [in]     frame         Pointer to the \ref ifx_Matrix_R_t *frame* where raw data is stored.
+ *                               If this is NULL, then a new frame is created. the caller is responsible to
+ *                               deallocate the memory.
+ * @param [in]     timeout_ms    Maximum time to wait for a frame in milliseconds.
+ *
+ * @return	pointer to the \ref ifx_Matrix_R_t *frame* containing the received samples.
+ */
+IFX_DLL_PUBLIC
+ifx_Matrix_R_t* ifx_cw_get_next_frame(ifx_Device_Cw_t* handle, ifx_Matrix_R_t* frame, uint16_t timeout_ms);
+
+/**
+ * @brief Returns the statistics of the current or last stream.
+ *
+ * @param [in]     handle        A handle to the CW device
+ * @param [out]    statistics    Frame, gap and overflow counters.
+ */
+IFX_DLL_PUBLIC
+void ifx_cw_get_stream_statistics(ifx_Device_Cw_t* handle, ifx_Cw_Stream_Statistics_t* statistics);
+
 /**
  * @brief Get information about the sensor on the connected device.
  *
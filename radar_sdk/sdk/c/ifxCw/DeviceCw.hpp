@@ -36,6 +36,7 @@
 
 #pragma once
 
+#include "DeviceCw.h"
 #include "DeviceCwTypes.h"
 #include "ifxBase/Matrix.h"
 #include <map>
@@ -73,6 +74,12 @@ struct DeviceCw
 
     virtual ifx_Matrix_R_t* capture_frame(ifx_Matrix_R_t* frame) = 0;
 
+    virtual void start_streaming(uint32_t num_buffers, ifx_Cw_Stream_Callback_t callback, void* context) = 0;
+    virtual void stop_streaming() = 0;
+    virtual bool is_streaming() = 0;
+    virtual ifx_Matrix_R_t* get_next_frame(ifx_Matrix_R_t* frame, uint16_t timeout_ms) = 0;
+    virtual void get_stream_statistics(ifx_Cw_Stream_Statistics_t* statistics) = 0;
+
     virtual std::map<uint16_t, uint32_t>& get_register_list() = 0;
     virtual void apply_register_list(const std::map<uint16_t, uint32_t>& register_list) = 0;
 
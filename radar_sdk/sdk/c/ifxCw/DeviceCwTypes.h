@@ -136,6 +136,22 @@ typedef struct
     float frequency_Hz;
 } ifx_Cw_Test_Signal_Generator_Config_t;
 
+/**
+ * @brief Defines the structure for the statistics of a CW data stream.
+ *
+ * The counters are reset whenever streaming is started.
+ */
+typedef struct
+{
+    uint64_t num_frames;    /**< Number of frames captured by the device. */
+    uint64_t num_gaps;      /**< Number of captures lost due to a data timeout.
+                                 Each lost capture is a discontinuity in the
+                                 data stream. */
+    uint64_t num_overflows; /**< Number of frames discarded because the
+                                 application did not fetch them before the
+                                 ring buffer was full. */
+} ifx_Cw_Stream_Statistics_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
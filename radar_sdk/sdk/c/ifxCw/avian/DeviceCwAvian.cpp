@@ -35,6 +35,7 @@
 #include "DeviceCwAvian.hpp"
 
 // Strata
+#include <common/ThreadPolicy.hpp>
 #include <platform/NamedMemory.hpp>
 
 // libAvian
@@ -337,11 +338,13 @@ bool DeviceCwAvian::is_signal_active()
 
 void DeviceCwAvian::start_signal()
 {
+    stop_streaming();
     m_cw_controller->enable_continuous_wave(true);
 }
 
 void DeviceCwAvian::stop_signal()
 {
+    stop_streaming();
     m_cw_controller->enable_continuous_wave(false);
 }
 
@@ -368,6 +371,8 @@ void DeviceCwAvian::set_baseband_config(const ifx_Cw_Baseband_Config_t* config)
     const auto vga_gain = (div.rem >= 3)
                               ? static_cast<Vga_Gain>(div.quot + 1)  // round up (hp_gain+vga_gain > if_gain_dB)
                               : static_cast<Vga_Gain>(div.quot);     // round down (hp_gain+vga_gain <= if_gain_dB)
+    stop_streaming();
+
     bool was_enabled = is_signal_active();
     if (was_enabled)
     {
@@ -435,6 +440,8 @@ const ifx_Cw_Baseband_Config_t* DeviceCwAvian::get_baseband_config()
 void DeviceCwAvian::set_adc_config(const ifx_Cw_Adc_Config_t* config)
 {
     using namespace Infineon::Avian;
+    stop_streaming();
+
     auto sampling_time = ns_to_adc_sampling_time(config->sample_and_hold_time_ns);
     m_cw_controller->set_adc_sample_time(sampling_time);
 
@@ -471,6 +478,8 @@ const ifx_Cw_Adc_Config_t* DeviceCwAvian::get_adc_config()
 void DeviceCwAvian::set_test_signal_generator_config(const ifx_Cw_Test_Signal_Generator_Config_t* config)
 {
     using namespace Infineon::Avian;
+    stop_streaming();
+
     m_cw_controller->set_test_signal_frequency(config->frequency_Hz);
     m_cw_controller->set_test_signal_generator_mode(static_cast<Continuous_Wave_Controller::Test_Signal_Generator_Mode>(config->mode));
 
@@ -520,6 +529,204 @@ ifx_Matrix_R_t* DeviceCwAvian::capture_frame(ifx_Matrix_R_t* frame)
     return frame;
 }
 
+void DeviceCwAvian::start_streaming(uint32_t num_buffers, ifx_Cw_Stream_Callback_t callback, void* context)
+{
+    if (num_buffers < 2)
+    {
+        throw rdk::exception::argument_out_of_bounds();
+    }
+
+    stop_streaming();
+
+    // The ring is only reallocated if the frame size has changed.
+    const auto num_rows = get_rx_antenna_enabled_count();
+    const auto num_cols = m_cw_controller->get_number_of_samples();
+    if (!m_stream_buffers.empty()
+        && (IFX_MAT_ROWS(m_stream_buffers.front().get()) != num_rows
+            || IFX_MAT_COLS(m_stream_buffers.front().get()) != num_cols))
+    {
+        m_stream_buffers.clear();
+    }
+    m_stream_buffers.resize(num_buffers);
+    for (auto& buffer : m_stream_buffers)
+    {
+        if (!buffer)
+        {
+            buffer.reset(ifx_mat_create_r(num_rows, num_cols));
+            if (!buffer)
+            {
+                m_stream_buffers.clear();
+                throw rdk::exception::memory_allocation_failed();
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_stream_lock);
+        m_stream_read_index = 0;
+        m_stream_write_index = 0;
+        m_stream_num_queued = 0;
+        m_stream_active = true;
+        m_stream_failed = false;
+        m_stream_callback = callback;
+        m_stream_context = context;
+        m_stream_statistics = {};
+    }
+
+    try
+    {
+        // the delivery thread of the stream unpacks the raw data in on_stream_data
+        m_cw_controller->start_streaming(
+            [this](const uint16_t* raw_data, unsigned num_lost_captures) {
+                on_stream_data(raw_data, num_lost_captures);
+            },
+            []() { ThreadPolicies::instance().apply(ThreadRole::Converter); },
+            num_buffers);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(m_stream_lock);
+        m_stream_active = false;
+        throw;
+    }
+}
+
+void DeviceCwAvian::stop_streaming()
+{
+    m_cw_controller->stop_streaming();
+
+    {
+        std::lock_guard<std::mutex> lock(m_stream_lock);
+        m_stream_active = false;
+        m_stream_num_queued = 0;
+    }
+    m_stream_notifier.notify_all();
+}
+
+bool DeviceCwAvian::is_streaming()
+{
+    return m_cw_controller->is_streaming();
+}
+
+ifx_Matrix_R_t* DeviceCwAvian::get_next_frame(ifx_Matrix_R_t* frame, uint16_t timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(m_stream_lock);
+    if (!m_stream_active || m_stream_callback)
+    {
+        throw rdk::exception::not_possible();
+    }
+
+    const auto* first_buffer = m_stream_buffers.front().get();
+    if (frame && (IFX_MAT_ROWS(frame) != IFX_MAT_ROWS(first_buffer) || IFX_MAT_COLS(frame) != IFX_MAT_COLS(first_buffer)))
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+
+    m_stream_notifier.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]() {
+        return m_stream_num_queued || m_stream_failed || !m_stream_active;
+    });
+
+    if (!m_stream_num_queued)
+    {
+        if (m_stream_failed)
+        {
+            throw rdk::exception::communication_error();
+        }
+        if (!m_stream_active)
+        {
+            throw rdk::exception::not_possible();
+        }
+        throw rdk::exception::timeout();
+    }
+
+    if (frame == nullptr)
+    {
+        frame = ifx_mat_create_r(IFX_MAT_ROWS(first_buffer), IFX_MAT_COLS(first_buffer));
+        if (frame == nullptr)
+        {
+            throw rdk::exception::memory_allocation_failed();
+        }
+    }
+
+    ifx_mat_copy_r(m_stream_buffers[m_stream_read_index].get(), frame);
+    m_stream_read_index = (m_stream_read_index + 1) % m_stream_buffers.size();
+    m_stream_num_queued--;
+
+    return frame;
+}
+
+void DeviceCwAvian::get_stream_statistics(ifx_Cw_Stream_Statistics_t* statistics)
+{
+    if (statistics == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    std::lock_guard<std::mutex> lock(m_stream_lock);
+    *statistics = m_stream_statistics;
+}
+
+void DeviceCwAvian::on_stream_data(const uint16_t* raw_data, unsigned num_lost_captures)
+{
+    std::unique_lock<std::mutex> lock(m_stream_lock);
+    m_stream_statistics.num_gaps += num_lost_captures;
+    if (raw_data == nullptr)
+    {
+        // The device stopped responding, the stream has ended.
+        m_stream_failed = true;
+        const auto callback = m_stream_callback;
+        const auto context = m_stream_context;
+        lock.unlock();
+        m_stream_notifier.notify_all();
+        if (callback)
+        {
+            callback(nullptr, IFX_ERROR_COMMUNICATION_ERROR, context);
+        }
+        return;
+    }
+    m_stream_statistics.num_frames++;
+
+    /*
+     * In queue mode a full ring drops its oldest frame, so the application
+     * always receives the most recent data. The slot being written is never
+     * part of the queue, so conversion can happen without holding the lock.
+     */
+    const auto num_buffers = m_stream_buffers.size();
+    if (!m_stream_callback && (m_stream_num_queued == num_buffers))
+    {
+        m_stream_read_index = (m_stream_read_index + 1) % num_buffers;
+        m_stream_num_queued--;
+        m_stream_statistics.num_overflows++;
+    }
+    auto* frame = m_stream_buffers[m_stream_write_index].get();
+    const auto callback = m_stream_callback;
+    const auto context = m_stream_context;
+    lock.unlock();
+
+    // de-interleave the samples and scale the 12 bit ADC range to -1...1
+    const auto num_rx = IFX_MAT_ROWS(frame);
+    const auto num_samples = IFX_MAT_COLS(frame);
+    for (uint32_t sample = 0; sample < num_samples; sample++)
+    {
+        for (uint32_t rx = 0; rx < num_rx; rx++)
+        {
+            IFX_MAT_AT(frame, rx, sample) = *raw_data++ * (2.f / 4095.f) - 1.f;
+        }
+    }
+
+    if (callback)
+    {
+        callback(frame, IFX_OK, context);
+        return;
+    }
+
+    lock.lock();
+    m_stream_write_index = (m_stream_write_index + 1) % num_buffers;
+    m_stream_num_queued++;
+    lock.unlock();
+    m_stream_notifier.notify_one();
+}
+
 ifx_Radar_Sensor_t DeviceCwAvian::get_sensor_type() const
 {
     return static_cast<ifx_Radar_Sensor_t>(m_cw_controller->get_device_type());
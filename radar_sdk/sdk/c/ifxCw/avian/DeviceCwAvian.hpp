@@ -56,7 +56,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 /*
 ==============================================================================
@@ -80,6 +82,16 @@
  * @brief A handle for an instance of DeviceControl module, see DeviceControl.h.
  */
 
+struct ifx_Matrix_R_t_Deleter
+{
+    void operator()(ifx_Matrix_R_t* matrix)
+    {
+        ifx_mat_destroy_r(matrix);
+    }
+};
+
+using SmartMatrixR = std::unique_ptr<ifx_Matrix_R_t, ifx_Matrix_R_t_Deleter>;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -119,6 +131,12 @@ public:
 
     ifx_Matrix_R_t* capture_frame(ifx_Matrix_R_t* frame) override;
 
+    void start_streaming(uint32_t num_buffers, ifx_Cw_Stream_Callback_t callback, void* context) override;
+    void stop_streaming() override;
+    bool is_streaming() override;
+    ifx_Matrix_R_t* get_next_frame(ifx_Matrix_R_t* frame, uint16_t timeout_ms) override;
+    void get_stream_statistics(ifx_Cw_Stream_Statistics_t* statistics) override;
+
     ifx_Radar_Sensor_t get_sensor_type() const override;
 
     std::map<uint16_t, uint32_t>& get_register_list() override;
@@ -148,5 +166,24 @@ private:
 
     void generate_register_list();
 
+    void on_stream_data(const uint16_t* raw_data, unsigned num_lost_captures);
+
     std::map<uint16_t, uint32_t> m_register_map;
+
+    /*
+     * Streaming state: m_stream_buffers is a ring of preallocated frames, the
+     * queued frames start at m_stream_read_index. All members except the
+     * buffers themselves are protected by m_stream_lock.
+     */
+    std::vector<SmartMatrixR> m_stream_buffers;
+    size_t m_stream_read_index = 0;
+    size_t m_stream_write_index = 0;
+    size_t m_stream_num_queued = 0;
+    bool m_stream_active = false;
+    bool m_stream_failed = false;
+    ifx_Cw_Stream_Callback_t m_stream_callback = nullptr;
+    void* m_stream_context = nullptr;
+    ifx_Cw_Stream_Statistics_t m_stream_statistics = {};
+    std::mutex m_stream_lock;
+    std::condition_variable m_stream_notifier;
 };
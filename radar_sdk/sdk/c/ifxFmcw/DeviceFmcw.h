@@ -398,6 +398,45 @@ void ifx_fmcw_start_acquisition(ifx_Device_Fmcw_t* handle);
 IFX_DLL_PUBLIC
 void ifx_fmcw_stop_acquisition(ifx_Device_Fmcw_t* handle);
 
+/**
+ * @brief Reconnects to the board after the connection was lost.
+ *
+ * This function closes the lost connection and waits until the board with
+ * the same UUID is available again, e.g. after it was unplugged and plugged
+ * in again or after a reset. The device configuration is restored, and if
+ * the acquisition was running it is started again. Frames of the lost
+ * connection that were not fetched yet are discarded.
+ *
+ * If the board is not found within timeout_ms milliseconds, the error
+ * @ref IFX_ERROR_NO_DEVICE is set and the handle keeps the lost connection.
+ * The function can be called again in that case.
+ *
+ * Please note that this function is not thread-safe and must not be called
+ * while another thread uses the handle.
+ *
+ * @param[in] handle      A handle to the radar device object.
+ * @param[in] timeout_ms  Maximum time to wait for the board in milliseconds.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_reconnect(ifx_Device_Fmcw_t* handle, uint32_t timeout_ms);
+
+/**
+ * @brief Enables automatic reconnects when fetching frames.
+ *
+ * If enabled, @ref ifx_fmcw_get_next_frame, @ref ifx_fmcw_get_next_raw_frame
+ * and their timeout variants call @ref ifx_fmcw_reconnect once when the
+ * connection to the board is lost and then continue to wait for the frame.
+ * Only if the reconnect fails, the error is returned to the caller.
+ *
+ * By default automatic reconnects are disabled.
+ *
+ * @param[in] handle      A handle to the radar device object.
+ * @param[in] timeout_ms  Maximum time to wait for the board in milliseconds,
+ *                        0 disables automatic reconnects.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_set_auto_reconnect(ifx_Device_Fmcw_t* handle, uint32_t timeout_ms);
+
 /**
  * @brief Retrieves the next frame of time domain data from a radar device.
  * (non-blocking).
@@ -813,6 +852,24 @@ double ifx_fmcw_get_chirp_sampling_center_frequency(ifx_Device_Fmcw_t* handle, c
 IFX_DLL_PUBLIC
 void ifx_fmcw_convert_raw_data_to_float_array(ifx_Device_Fmcw_t* handle, uint32_t num_samples, const uint16_t* raw_data, ifx_Float_t* converted_frame);
 
+/**
+ * @brief Convert raw frame to an array of Q15 fixed-point values.
+ *
+ * This is the fixed-point counterpart of \ref ifx_fmcw_convert_raw_data_to_float_array:
+ * the value q of each converted sample represents q / 32768 in the [-1,1]
+ * range. Together with \ref ifx_fmcw_get_next_raw_frame and
+ * \ref ifx_fmcw_deinterleave_raw_frame this feeds the fixed-point
+ * range-Doppler map (\ref gr_rdm_q15) without converting the time domain
+ * data to floats.
+ *
+ * @param[in] handle A handle to the radar device object.
+ * @param[in] num_samples The number of samples to convert.
+ * @param[in] raw_data The time domain data.
+ * @param[out] converted_frame The array where the converted data is copied to.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_convert_raw_data_to_q15_array(ifx_Device_Fmcw_t* handle, uint32_t num_samples, const uint16_t* raw_data, int16_t* converted_frame);
+
 /**
  * @brief Returns a view of the deinterleaved frame given a pointer to the converted deinterleaved frame.
  *
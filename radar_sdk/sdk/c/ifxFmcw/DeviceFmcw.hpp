@@ -55,6 +55,7 @@ struct DeviceFmcw
     virtual ifx_Fmcw_Frame_t* allocate_frame() = 0;
     virtual ifx_Fmcw_Raw_Frame_t* allocate_raw_frame() = 0;
     virtual void convert_raw_data_to_float_array(uint32_t num_samples, const uint16_t* raw_data, ifx_Float_t* converted_frame) = 0;
+    virtual void convert_raw_data_to_q15_array(uint32_t num_samples, const uint16_t* raw_data, int16_t* converted_frame) = 0;
     virtual void deinterleave_raw_frame(const ifx_Fmcw_Raw_Frame_t* raw_frame, ifx_Fmcw_Raw_Frame_t* deinterleaved_frame) = 0;
     virtual void view_deinterleaved_frame(ifx_Float_t* converted_frame, ifx_Fmcw_Frame_t* deinterleaved_frame_view) = 0;
     virtual float get_element_duration(const ifx_Fmcw_Sequence_Element_t* element) const = 0;
@@ -71,6 +72,9 @@ struct DeviceFmcw
     virtual void stop_acquisition() = 0;
     virtual void start_acquisition() = 0;
 
+    virtual void reconnect(uint32_t timeout_ms) = 0;
+    virtual void set_auto_reconnect(uint32_t timeout_ms) = 0;
+
     virtual void set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) = 0;
     virtual ifx_Fmcw_Sequence_Element_t* get_acquisition_sequence() const = 0;
 
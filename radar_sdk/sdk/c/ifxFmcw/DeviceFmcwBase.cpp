@@ -34,15 +34,20 @@
 */
 
 #include "DeviceFmcwBase.hpp"
+#include "ifxBase/internal/Metrics.h"
 #include "ifxBase/internal/Util.h"  // for ifx_util_popcount
 
 // Universal
 #include <universal/error_definitions.h>
 #include <universal/types/DataSettingsBgtRadar.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <common/Buffer.hpp>
+#include <platform/exception/EConnection.hpp>
 #include <stack>
+#include <thread>
 
 
 /*
@@ -58,6 +63,9 @@ constexpr float slice_rate_threshold = 20.0f;  // 20 slices per second
 
 constexpr float seconds_to_buffer = 10.0f;
 
+// While waiting for a board to come back, enumerate at most every 100ms
+constexpr auto reopen_poll_interval = std::chrono::milliseconds(100);
+
 }  // namespace
 
 /*
@@ -87,6 +95,61 @@ DeviceFmcwBase::DeviceFmcwBase(ifx_Float_t max_adc_value, std::unique_ptr<BoardI
     m_data_index = 0;
     m_data = m_board->getIBridge()->getIBridgeControl()->getIData();
     m_bridge_data = m_board->getIBridge()->getIBridgeData();
+
+    // keep the UUID, it cannot be read any more once the connection is lost
+    m_uuid = m_board->getUuidString();
+}
+
+std::unique_ptr<BoardInstance> DeviceFmcwBase::reopen_board(uint32_t timeout_ms)
+{
+    // check if dummy device
+    if (!m_board)
+    {
+        throw rdk::exception::not_supported();
+    }
+
+    // release the port, otherwise the board might not be found again
+    m_slice.reset();
+    try
+    {
+        m_board->getIBridge()->closeConnection();
+    }
+    catch (const EException&)
+    {
+    }
+
+    const auto expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (true)
+    {
+        auto board = rdk::RadarDeviceCommon::open_by_uuid(m_uuid.c_str());
+        if (board)
+        {
+            return board;
+        }
+
+        const auto remaining = expiry - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration::zero())
+        {
+            throw rdk::exception::no_device();
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(remaining, reopen_poll_interval));
+    }
+}
+
+void DeviceFmcwBase::replace_board(std::unique_ptr<BoardInstance>&& board)
+{
+    m_slice.reset();
+    m_board = std::move(board);
+
+    rdk::RadarDeviceCommon::get_firmware_info(m_board.get(), &m_firmware_info);
+
+    m_data = m_board->getIBridge()->getIBridgeControl()->getIData();
+    m_bridge_data = m_board->getIBridge()->getIBridgeData();
+}
+
+void DeviceFmcwBase::set_auto_reconnect(uint32_t timeout_ms)
+{
+    m_auto_reconnect_timeout_ms = timeout_ms;
 }
 
 uint16_t DeviceFmcwBase::calculate_slice_size(uint32_t fifo_size) const
@@ -276,11 +339,15 @@ void DeviceFmcwBase::get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms
         throw rdk::exception::dimension_mismatch();
     }
 
-    start_acquisition();
+    // failed calls (e.g. timeouts) throw and are not recorded
+    const uint64_t metrics_start = ifx_metrics_begin();
 
+    // get_next_raw_frame starts the acquisition, and reconnects if enabled
     SmartFmcwRawFrame raw_frame(allocate_raw_frame());
     get_next_raw_frame(raw_frame.get(), timeout_ms);
 
+    const uint64_t metrics_conversion_start = ifx_metrics_begin();
+
     const auto* raw_data = raw_frame->samples;
     auto** cubes = frame->cubes;
     const auto cube_offset = frame->num_cubes - 1;
@@ -328,6 +395,9 @@ void DeviceFmcwBase::get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms
             raw_data = cube_data;
         }
     }
+
+    ifx_metrics_end(IFX_METRICS_STAGE_FMCW_FRAME_CONVERSION, metrics_conversion_start);
+    ifx_metrics_end(IFX_METRICS_STAGE_FMCW_GET_NEXT_FRAME, metrics_start);
 }
 
 void DeviceFmcwBase::get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms)
@@ -342,6 +412,37 @@ void DeviceFmcwBase::get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t ti
         throw rdk::exception::dimension_mismatch();
     }
 
+    bool reconnected = false;
+    while (true)
+    {
+        try
+        {
+            read_next_raw_frame(frame, timeout_ms);
+            return;
+        }
+        catch (const rdk::exception::communication_error&)
+        {
+            if (!m_auto_reconnect_timeout_ms || reconnected)
+            {
+                throw;
+            }
+        }
+        catch (const EConnection&)
+        {
+            if (!m_auto_reconnect_timeout_ms || reconnected)
+            {
+                throw;
+            }
+        }
+
+        // only one attempt per call, so that a flapping connection cannot block the caller forever
+        reconnect(m_auto_reconnect_timeout_ms);
+        reconnected = true;
+    }
+}
+
+void DeviceFmcwBase::read_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms)
+{
     start_acquisition();
 
     uint16_t* frame_ptr = frame->samples;
@@ -383,6 +484,10 @@ void DeviceFmcwBase::get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t ti
                 case E_OVERFLOW:
                     throw rdk::exception::fifo_overflow();
                     break;
+                case DataError_LowLevelError:
+                    // the bridge lost the connection to the board
+                    throw rdk::exception::communication_error();
+                    break;
                 default:
                     throw rdk::exception::error();
                     break;
@@ -448,6 +553,22 @@ void DeviceFmcwBase::convert_raw_data_to_float_array(uint32_t num_samples, const
     }
 }
 
+void DeviceFmcwBase::convert_raw_data_to_q15_array(uint32_t num_samples, const uint16_t* raw_data, int16_t* converted_frame)
+{
+    // Same mapping as convert_raw_data_to_float_array scaled by 2^15:
+    // (2 * raw - max) * 2^15 / max with 1/max as fixed-point factor with 27
+    // fractional bits, which keeps the product within 32 bits for ADCs of up
+    // to 16 bits.
+    const auto max_adc_value = static_cast<int32_t>(m_max_adc_value);
+    const auto factor = static_cast<int32_t>(std::lround(double(1 << 27) / m_max_adc_value));
+
+    for (size_t i = 0; i < num_samples; i++)
+    {
+        const int32_t q = ((2 * raw_data[i] - max_adc_value) * factor + (1 << 11)) >> 12;
+        converted_frame[i] = static_cast<int16_t>(std::min(q, int32_t(INT16_MAX)));
+    }
+}
+
 void DeviceFmcwBase::deinterleave_raw_frame(const ifx_Fmcw_Raw_Frame_t* raw_frame, ifx_Fmcw_Raw_Frame_t* deinterleaved_frame)
 {
     if (!raw_frame)
@@ -55,8 +55,10 @@ struct DeviceFmcwBase : public DeviceFmcw
     ifx_Fmcw_Raw_Frame_t* allocate_raw_frame() override;
     void get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms) override;
     void get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms) override;
+    void set_auto_reconnect(uint32_t timeout_ms) override;
 
     void convert_raw_data_to_float_array(uint32_t num_samples, const uint16_t* raw_data, ifx_Float_t* converted_frame) override;
+    void convert_raw_data_to_q15_array(uint32_t num_samples, const uint16_t* raw_data, int16_t* converted_frame) override;
     void deinterleave_raw_frame(const ifx_Fmcw_Raw_Frame_t* raw_frame, ifx_Fmcw_Raw_Frame_t* deinterleaved_frame) override;
     void view_deinterleaved_frame(ifx_Float_t* converted_frame, ifx_Fmcw_Frame_t* deinterleaved_frame_view) override;
     float get_sequence_duration(const ifx_Fmcw_Sequence_Element_t* sequence) const override;
@@ -80,6 +82,13 @@ protected:
     uint32_t get_buffer_length(uint32_t num_samples) const;
     uint32_t copy_slice_data(uint8_t data_format, const uint8_t* buffer, uint32_t buffer_length, uint16_t* output);
 
+    /* Closes the lost connection and waits until the board with the same
+     * UUID can be opened again. Throws no_device if it does not show up
+     * within timeout_ms.
+     */
+    std::unique_ptr<BoardInstance> reopen_board(uint32_t timeout_ms);
+    void replace_board(std::unique_ptr<BoardInstance>&& board);
+
     double get_chirp_sampling_bandwidth(const ifx_Fmcw_Sequence_Chirp_t* chirp) const override;
 
     ifx_Float_t m_max_adc_value;
@@ -95,6 +104,10 @@ protected:
     uint32_t m_num_samples = 0;
 
 private:
+    void read_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms);
+
+    std::string m_uuid;
+    uint32_t m_auto_reconnect_timeout_ms = 0;
     float m_frame_repetition_time_s;
     std::vector<std::array<uint32_t, 3>> m_frame_dimensions;
 
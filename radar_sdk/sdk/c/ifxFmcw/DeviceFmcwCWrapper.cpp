@@ -251,6 +251,20 @@ void ifx_fmcw_start_acquisition(ifx_Device_Fmcw_t* handle)
 
 //----------------------------------------------------------------------------
 
+void ifx_fmcw_reconnect(ifx_Device_Fmcw_t* handle, uint32_t timeout_ms)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::reconnect, timeout_ms);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_set_auto_reconnect(ifx_Device_Fmcw_t* handle, uint32_t timeout_ms)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::set_auto_reconnect, timeout_ms);
+}
+
+//----------------------------------------------------------------------------
+
 ifx_Fmcw_Frame_t* ifx_fmcw_allocate_frame(ifx_Device_Fmcw_t* handle)
 {
     return (rdk::call_func(handle, &ifx_Device_Fmcw_t::allocate_frame));
@@ -363,6 +377,13 @@ void ifx_fmcw_convert_raw_data_to_float_array(ifx_Device_Fmcw_t* handle, uint32_
 
 //----------------------------------------------------------------------------
 
+void ifx_fmcw_convert_raw_data_to_q15_array(ifx_Device_Fmcw_t* handle, uint32_t num_samples, const uint16_t* raw_data, int16_t* converted_frame)
+{
+    return rdk::call_func(handle, &ifx_Device_Fmcw_t::convert_raw_data_to_q15_array, num_samples, raw_data, converted_frame);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_fmcw_view_deinterleaved_frame(ifx_Device_Fmcw_t* handle, ifx_Float_t* converted_frame, ifx_Fmcw_Frame_t* deinterleaved_frame_view)
 {
     return rdk::call_func(handle, &ifx_Device_Fmcw_t::view_deinterleaved_frame, converted_frame, deinterleaved_frame_view);
@@ -35,6 +35,7 @@
 
 #include "DeviceFmcwAvian.hpp"
 #include "ifxBase/Exception.hpp"
+#include "ifxBase/internal/Metrics.h"
 
 
 // libAvian
@@ -492,7 +493,36 @@ void DeviceFmcwAvian::start_acquisition()
     m_data_started = true;
 }
 
-void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence)
+void DeviceFmcwAvian::reconnect(uint32_t timeout_ms)
+{
+    const uint64_t metrics_start = ifx_metrics_begin();
+
+    // the flag is cleared only once the new connection is in place, so that a
+    // failed attempt leaves the device in its previous state for another attempt
+    const bool restart = m_data_started.load();
+
+    auto board = reopen_board(timeout_ms);
+
+    // the driver holds the complete configuration, so a copy bound to the new
+    // port restores the sensor settings with the next start of the acquisition
+    auto port = std::make_unique<StrataControlPort>(board.get());
+    auto driver = std::make_unique<Driver>(*port, *m_driver);
+
+    replace_board(std::move(board));
+    m_port = std::move(port);
+    m_driver = std::move(driver);
+
+    // the lost connection cannot be stopped any more, the new one starts idle
+    m_data_started = false;
+    if (restart)
+    {
+        start_acquisition();
+    }
+
+    ifx_metrics_end(IFX_METRICS_STAGE_FMCW_RECONNECT, metrics_start);
+}
+
+std::unique_ptr<Driver> DeviceFmcwAvian::create_driver(const ifx_Fmcw_Sequence_Element_t* sequence) const
 {
     using namespace Avian;
 
@@ -932,7 +962,7 @@ void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t
              */
             auto rc = local_driver->set_frame_definition(&frame_definition);
             check_libavian_return(rc);
-            TimingModel::StateSequence timing_model(*local_driver);
+            TimingModel::SequenceTiming timing_model(*local_driver);
             auto num_cycles = timing_model.getChirpToChirpTime(next_shape_index);
             auto prelim_rep_time = timing_model.toSeconds(num_cycles);
 
@@ -1000,7 +1030,7 @@ void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t
     {
         auto rc = local_driver->set_frame_definition(&frame_definition);
         check_libavian_return(rc);
-        TimingModel::StateSequence timing_model(*local_driver);
+        TimingModel::SequenceTiming timing_model(*local_driver);
         auto num_cycles = timing_model.getSetToSetTime() - 1;
         auto prelim_rep_time = timing_model.toSeconds(num_cycles);
 
@@ -1029,7 +1059,7 @@ void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t
      */
     auto rc = local_driver->set_frame_definition(&frame_definition);
     check_libavian_return(rc);
-    TimingModel::StateSequence timing_model(*local_driver);
+    TimingModel::SequenceTiming timing_model(*local_driver);
     auto num_cycles = timing_model.getFrameDuration() - 1;
     auto prelim_rep_time = timing_model.toSeconds(num_cycles);
 
@@ -1047,6 +1077,13 @@ void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t
     rc = local_driver->set_frame_definition(&frame_definition);
     check_libavian_return(rc);
 
+    return local_driver;
+}
+
+void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence)
+{
+    auto local_driver = create_driver(sequence);
+
     /*
      * Finally the parameters of the new acquisition sequence are applied.
      * Before the configuration of the local driver is made active, any ongoing
@@ -1070,7 +1107,7 @@ ifx_Fmcw_Sequence_Element_t* DeviceFmcwAvian::get_acquisition_sequence() const
      * so a temporary instance is created, to provide the repetition times for
      * the created loop elements.
      */
-    auto timing_model = create_timing_model();
+    auto timing_model = create_sequence_timing();
 
     /*
      * At some points the acquisition sequence may contain optional delays. At
@@ -1610,6 +1647,36 @@ std::unique_ptr<TimingModel::StateSequence> DeviceFmcwAvian::create_timing_model
     return std::make_unique<StateSequence>(avian_registers, device_type);
 }
 
+// ---------------------------------------------------------------------------
+std::unique_ptr<TimingModel::SequenceTiming> DeviceFmcwAvian::create_sequence_timing() const
+{
+    using SequenceTiming = TimingModel::SequenceTiming;
+    using RegisterSet = HW::RegisterSet;
+
+    const auto device_type = m_driver->get_device_type();
+    if (device_type == Device_Type::Unknown)
+    {
+        return nullptr;
+    }
+
+    RegisterSet avian_registers;
+    for (const auto& entry : m_register_map)
+        avian_registers.set(static_cast<uint8_t>(entry.first), entry.second);
+
+    return std::make_unique<SequenceTiming>(avian_registers, device_type);
+}
+
+// ---------------------------------------------------------------------------
+std::unique_ptr<TimingModel::SequenceTiming> DeviceFmcwAvian::create_sequence_timing(const ifx_Fmcw_Sequence_Element_t* sequence) const
+{
+    /*
+     * The sequence is translated into a driver configuration the same way
+     * set_acquisition_sequence does it, but the device is not touched.
+     */
+    auto local_driver = create_driver(sequence);
+    return std::make_unique<TimingModel::SequenceTiming>(*local_driver);
+}
+
 float DeviceFmcwAvian::get_chirp_duration(const ifx_Fmcw_Sequence_Chirp_t& chirp) const
 {
     /*
@@ -1741,7 +1808,7 @@ float DeviceFmcwAvian::get_minimum_chirp_repetition_time(uint32_t num_samples, f
      * Now, with all settings made, the timing model can tell the chirp
      * repetition time.
      */
-    Avian::TimingModel::StateSequence timing_model(local_driver);
+    Avian::TimingModel::SequenceTiming timing_model(local_driver);
     return float(timing_model.toSeconds(timing_model.getChirpToChirpTime(0)));
 }
 
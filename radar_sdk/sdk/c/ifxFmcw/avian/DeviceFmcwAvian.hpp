@@ -108,6 +108,8 @@ struct DeviceFmcwAvian : public DeviceFmcwBase
     void stop_acquisition() override;
     void start_acquisition() override;
 
+    void reconnect(uint32_t timeout_ms) override;
+
     IFX_DLL_TEST void set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) override;
     IFX_DLL_TEST ifx_Fmcw_Sequence_Element_t* get_acquisition_sequence() const override;
 
@@ -126,11 +128,15 @@ struct DeviceFmcwAvian : public DeviceFmcwBase
     IFX_DLL_PUBLIC uint32_t export_register_list_legacy(bool set_trigger_bit, uint32_t* register_list);
 
     IFX_DLL_PUBLIC std::unique_ptr<Infineon::Avian::TimingModel::StateSequence> create_timing_model() const;
+    IFX_DLL_PUBLIC std::unique_ptr<Infineon::Avian::TimingModel::SequenceTiming> create_sequence_timing() const;
+    IFX_DLL_PUBLIC std::unique_ptr<Infineon::Avian::TimingModel::SequenceTiming> create_sequence_timing(const ifx_Fmcw_Sequence_Element_t* sequence) const;
 
 protected:
     float get_chirp_duration(const ifx_Fmcw_Sequence_Chirp_t& chirp) const override;
 
 private:
+    std::unique_ptr<Infineon::Avian::Driver> create_driver(const ifx_Fmcw_Sequence_Element_t* sequence) const;
+
     void set_reference_clock(float reference_clock);
     void detect_reference_clock();
 
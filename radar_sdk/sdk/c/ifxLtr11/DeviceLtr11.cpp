@@ -118,6 +118,21 @@ ifx_Vector_C_t* ifx_ltr11_get_next_frame_timeout(ifx_Ltr11_Device_t* handle, ifx
     return rdk::call_func(handle, &ifx_Ltr11_Device_t::getNextFrame, nullptr, frame_data, metadata, timeout_ms);
 }
 
+void ifx_ltr11_get_next_frames(ifx_Ltr11_Device_t* handle, ifx_Matrix_C_t* frames, ifx_Ltr11_Metadata_t* metadata, uint16_t timeout_ms)
+{
+    rdk::call_func(handle, &ifx_Ltr11_Device_t::getNextFrames, frames, metadata, timeout_ms);
+}
+
+void ifx_ltr11_set_frames_per_packet(ifx_Ltr11_Device_t* handle, uint16_t frames_per_packet)
+{
+    rdk::call_func(handle, &ifx_Ltr11_Device_t::setFramesPerPacket, frames_per_packet);
+}
+
+uint16_t ifx_ltr11_get_frames_per_packet(ifx_Ltr11_Device_t* handle)
+{
+    return rdk::call_func(handle, &ifx_Ltr11_Device_t::getFramesPerPacket);
+}
+
 void ifx_ltr11_register_dump_to_file(ifx_Ltr11_Device_t* handle, const char* filename)
 {
     rdk::call_func(handle, &ifx_Ltr11_Device_t::dumpRegisters, filename);
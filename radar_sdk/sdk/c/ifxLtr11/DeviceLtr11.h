@@ -49,6 +49,7 @@
 #include "DeviceLtr11Types.h"
 #include "ifxBase/Error.h"
 #include "ifxBase/List.h"
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Types.h"
 #include "ifxBase/Vector.h"
 
@@ -380,6 +381,61 @@ ifx_Vector_C_t* ifx_ltr11_get_next_frame(ifx_Ltr11_Device_t* handle, ifx_Vector_
 IFX_DLL_PUBLIC
 ifx_Vector_C_t* ifx_ltr11_get_next_frame_timeout(ifx_Ltr11_Device_t* handle, ifx_Vector_C_t* frame_data, ifx_Ltr11_Metadata_t* metadata, uint16_t timeout_ms);
 
+/**
+ * \brief Retrieves several consecutive frames of time domain data from the LTR11 device.
+ *
+ * This function fills each row of *frames* with one frame of time domain data, so
+ * *frames* must have num_samples columns (see \ref ifx_Ltr11_Config_t) and one row
+ * per frame to be read. The metadata of the frame in row i is written to metadata[i],
+ * so *metadata* must point to an array with at least as many elements as *frames* has rows.
+ *
+ * Compared to calling \ref ifx_ltr11_get_next_frame_timeout once per frame, the frames
+ * are converted with a vectorized kernel and the API is entered only once. Together with
+ * \ref ifx_ltr11_set_frames_per_packet this reduces the per frame overhead at high frame rates.
+ *
+ * The timeout applies to each packet received from the device. The possible error codes
+ * are the same as for \ref ifx_ltr11_get_next_frame_timeout. If an error occurs, the
+ * acquisition is stopped and the content of *frames* is undefined.
+ *
+ * \param [in]   handle         Device handle for BGT60LTR11 device.
+ * \param [out]  frames         Matrix with one frame per row.
+ * \param [out]  metadata       Array of metadata structures, one per row of *frames*.
+ * \param [in]   timeout_ms     Timeout in milliseconds for each packet.
+ */
+IFX_DLL_PUBLIC
+void ifx_ltr11_get_next_frames(ifx_Ltr11_Device_t* handle, ifx_Matrix_C_t* frames, ifx_Ltr11_Metadata_t* metadata, uint16_t timeout_ms);
+
+/**
+ * \brief Set the number of frames transferred per packet.
+ *
+ * By default every frame is transferred from the device in a separate packet. Setting
+ * frames_per_packet to a value larger than 1 makes the board aggregate that many frames
+ * into one packet, which reduces the transport overhead at high frame rates at the cost
+ * of latency. Frames are still returned one by one from \ref ifx_ltr11_get_next_frame
+ * and \ref ifx_ltr11_get_next_frames.
+ *
+ * As only packets are timestamped, the active flag of the metadata is derived from the
+ * packet interval and is the same for all frames of a packet.
+ *
+ * The value must be between 1 and \ref IFX_LTR11_MAX_FRAMES_PER_PACKET, and
+ * frames_per_packet * num_samples must not exceed 65535. The function must not be called
+ * while the acquisition is running.
+ *
+ * \param [in]   handle             Device handle for BGT60LTR11 device.
+ * \param [in]   frames_per_packet  Number of frames per packet.
+ */
+IFX_DLL_PUBLIC
+void ifx_ltr11_set_frames_per_packet(ifx_Ltr11_Device_t* handle, uint16_t frames_per_packet);
+
+/**
+ * \brief Get the number of frames transferred per packet.
+ *
+ * \param [in]   handle   Device handle for BGT60LTR11 device.
+ * \return Number of frames per packet.
+ */
+IFX_DLL_PUBLIC
+uint16_t ifx_ltr11_get_frames_per_packet(ifx_Ltr11_Device_t* handle);
+
 /**
  * \brief Return the limiting values for the LTR11 configuration.
  *
@@ -158,6 +158,21 @@ void DeviceLtr11Base::getLimits(ifx_Ltr11_Config_Limits_t* limits)
     };
 }
 
+void DeviceLtr11Base::setFramesPerPacket(uint16_t framesPerPacket)
+{
+    if ((framesPerPacket == 0) || (framesPerPacket > IFX_LTR11_MAX_FRAMES_PER_PACKET))
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    m_framesPerPacket = framesPerPacket;
+}
+
+uint16_t DeviceLtr11Base::getFramesPerPacket() const
+{
+    return m_framesPerPacket;
+}
+
 bool DeviceLtr11Base::checkConfig(const ifx_Ltr11_Config_t* config)
 {
     ifx_Ltr11_Config_Limits_t limits;
@@ -40,6 +40,7 @@
 
 #include "DeviceLtr11Types.h"
 #include "ifxBase/internal/NonCopyable.hpp"
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Vector.h"
 #include "ifxRadarDeviceCommon/RadarDeviceCommon.h"
 
@@ -60,6 +61,10 @@ public:
     virtual void stopAcquisition() = 0;
 
     virtual ifx_Vector_C_t* getNextFrame(ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs) = 0;
+    virtual void getNextFrames(ifx_Matrix_C_t* frames, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs) = 0;
+
+    virtual void setFramesPerPacket(uint16_t framesPerPacket);
+    uint16_t getFramesPerPacket() const;
 
     const ifx_Radar_Sensor_Info_t* get_sensor_info();
     const ifx_Firmware_Info_t* get_firmware_info() const;
@@ -75,6 +80,7 @@ protected:
     uint64_t m_timestampThreshold = 0;
     bool m_bandJapan = false;
     bool m_frameConfigValid = false;
+    uint16_t m_framesPerPacket = 1;
 
     uint16_t prtIndexToUs(ifx_Ltr11_PRT_t prtIndex);
     uint8_t aprtFactorValue(ifx_Ltr11_APRT_Factor_t aprtFactorIndex);
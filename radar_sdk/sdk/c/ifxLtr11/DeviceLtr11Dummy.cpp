@@ -42,6 +42,10 @@ ifx_Vector_C_t* DeviceLtr11Dummy::getNextFrame(ifx_Vector_C_t* frame, ifx_Ltr11_
     return nullptr;
 }
 
+void DeviceLtr11Dummy::getNextFrames(ifx_Matrix_C_t* frames, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs)
+{
+}
+
 void DeviceLtr11Dummy::dumpRegisters(const char* filename)
 {
 }
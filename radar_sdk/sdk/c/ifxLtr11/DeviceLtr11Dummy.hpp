@@ -52,4 +52,5 @@ public:
     void dumpRegisters(const char* filename) override;
 
     ifx_Vector_C_t* getNextFrame(ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs) override;
+    void getNextFrames(ifx_Matrix_C_t* frames, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs) override;
 };
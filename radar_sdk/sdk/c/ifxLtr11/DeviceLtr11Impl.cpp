@@ -34,12 +34,17 @@
 #include <components/interfaces/IRadarLtr11.hpp>
 #include <platform/interfaces/IBridgeControl.hpp>
 #include <platform/interfaces/IBridgeData.hpp>
+#include <platform/interfaces/IFrame.hpp>
 
 #include "ifxBase/Complex.h"
 #include "ifxBase/Exception.hpp"
+#include "ifxBase/internal/SimdAdc.h"
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Vector.h"
 #include "ifxRadarDeviceCommon/internal/RadarDeviceCommon.hpp"
 
+#include <limits>
+
 
 namespace {
 constexpr uint16_t DEFAULT_QUEUE_SIZE = 4096;
@@ -97,6 +102,9 @@ DeviceLtr11::DeviceLtr11(std::unique_ptr<BoardInstance>&& board) :
     m_registers {nullptr},
     m_dataIndex {0},
     m_frameSize {::getFrameSize()},
+    m_packet {nullptr},
+    m_packetFrameIndex {0},
+    m_packetActive {false},
     m_acquisitionStarted {false},
     m_frameCounter {0},
     m_averagePower {0}
@@ -214,6 +222,7 @@ void DeviceLtr11::stopAcquisition()
         return;
     }
 
+    releasePacket();
     stopDataStreaming();
     m_acquisitionStarted = false;
 }
@@ -257,7 +266,7 @@ ifx_Vector_C_t* DeviceLtr11::getNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_M
 
     try
     {
-        readNextFrame(frameData, metadata, timeoutMs);
+        readNextFrame(&IFX_VEC_AT(frameData, 0), IFX_VEC_STRIDE(frameData), metadata, timeoutMs);
     }
     catch (const rdk::exception::exception& e)
     {
@@ -270,6 +279,66 @@ ifx_Vector_C_t* DeviceLtr11::getNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_M
     return frameData;
 }
 
+void DeviceLtr11::getNextFrames(ifx_Matrix_C_t* frames, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs)
+{
+    if (!m_frameConfigValid)
+    {
+        throw ::rdk::exception::error();
+    }
+    if (!frames || !metadata)
+    {
+        throw ::rdk::exception::argument_null();
+    }
+    if (!timeoutMs)
+    {
+        throw ::rdk::exception::argument_invalid();
+    }
+    if (IFX_MAT_ROWS(frames) == 0 || IFX_MAT_COLS(frames) != getNumberOfSamples())
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+
+    if (!m_acquisitionStarted)
+    {
+        startAcquisition();
+    }
+
+    try
+    {
+        for (uint32_t row = 0; row < IFX_MAT_ROWS(frames); ++row)
+        {
+            readNextFrame(&IFX_MAT_AT(frames, row, 0), IFX_MAT_STRIDE(frames, 1), &metadata[row], timeoutMs);
+        }
+    }
+    catch (const rdk::exception::exception& e)
+    {
+        stopAcquisition();
+        throw e;
+    }
+}
+
+void DeviceLtr11::setFramesPerPacket(uint16_t framesPerPacket)
+{
+    if (m_acquisitionStarted)
+    {
+        throw rdk::exception::not_supported();
+    }
+
+    if (m_frameConfigValid)
+    {
+        // throws if the packet would exceed the readout aggregation limit
+        determineSamplesPerPacket(framesPerPacket);
+    }
+
+    DeviceLtr11Base::setFramesPerPacket(framesPerPacket);
+
+    if (m_frameConfigValid)
+    {
+        setupFrameData();
+        setupBridgeData();
+    }
+}
+
 void DeviceLtr11::softReset()
 {
     m_radarLtr11->getIPinsLtr11()->reset();
@@ -282,19 +351,31 @@ uint32_t DeviceLtr11::determineBufferSize() const
         throw rdk::exception::not_supported();
     }
 
-    return (m_frameSize * getNumberOfSamples());
+    return (m_frameSize * determineSamplesPerPacket(m_framesPerPacket));
+}
+
+uint16_t DeviceLtr11::determineSamplesPerPacket(uint16_t framesPerPacket) const
+{
+    // the number of readouts aggregated into one packet is limited to 16 bits
+    const uint32_t samplesPerPacket = uint32_t(getNumberOfSamples()) * framesPerPacket;
+    if (samplesPerPacket > std::numeric_limits<uint16_t>::max())
+    {
+        throw rdk::exception::not_supported();
+    }
+
+    return static_cast<uint16_t>(samplesPerPacket);
 }
 
 void DeviceLtr11::setupFrameData()
 {
     DataSettingsBgtRadar_t settings;
-    settings.initialize(frameReadoutConfiguration, getNumberOfSamples());
+    settings.initialize(frameReadoutConfiguration, determineSamplesPerPacket(m_framesPerPacket));
     m_data->configure(m_dataIndex, &properties, &settings);
 }
 
 void DeviceLtr11::setupBridgeData()
 {
-    m_bridgeData->setFrameBufferSize(m_frameSize * getNumberOfSamples());
+    m_bridgeData->setFrameBufferSize(determineBufferSize());
     m_bridgeData->setFrameQueueSize(DEFAULT_QUEUE_SIZE);
 }
 
@@ -320,7 +401,7 @@ uint16_t DeviceLtr11::getNumberOfSamples() const
     return m_config.num_samples;
 }
 
-void DeviceLtr11::readNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs)
+void DeviceLtr11::fetchPacket(uint16_t timeoutMs)
 {
     const auto frameBufferSize = determineBufferSize();
 
@@ -333,7 +414,8 @@ void DeviceLtr11::readNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t*
 
     auto cleanup = stdext::finally(
         [&deviceFrame]() {
-            deviceFrame->release();
+            if (deviceFrame)
+                deviceFrame->release();
         });
 
     const auto statusCode = deviceFrame->getStatusCode();
@@ -356,21 +438,71 @@ void DeviceLtr11::readNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t*
         throw rdk::exception::dimension_mismatch();
     }
 
+    /* With several frames per packet only the packet is timestamped, so the
+     * power mode is derived from the packet interval and applies to all frames
+     * of the packet. */
     auto frameTimestamp = deviceFrame->getTimestamp();
     if (m_timestampPrev)
     {
-        metadata->active = (frameTimestamp - *m_timestampPrev) < m_timestampThreshold;
+        m_packetActive = (frameTimestamp - *m_timestampPrev) < m_timestampThreshold * m_framesPerPacket;
     }
     else
     {
         /* There is no previous timestamp for the first frame, and the chip should be by
          * default in active mode. Hence, for the first frame, active should be initialized
          * to true (similarly the average power should be the active mode power). */
-        metadata->active = true;
+        m_packetActive = true;
         m_averagePower = m_activePower;
     }
     m_timestampPrev = frameTimestamp;
 
+    // the packet is released once all its frames have been read
+    m_packet = deviceFrame;
+    m_packetFrameIndex = 0;
+    deviceFrame = nullptr;
+}
+
+void DeviceLtr11::releasePacket()
+{
+    if (m_packet)
+    {
+        m_packet->release();
+        m_packet = nullptr;
+    }
+}
+
+void DeviceLtr11::convertSamples(const uint16_t* data, size_t frameStepping, ifx_Complex_t* samples, size_t stride, uint32_t numSamples)
+{
+    // the SIMD kernel writes interleaved float pairs, so it only applies to
+    // contiguous samples in single precision builds
+    if (stride == 1 && sizeof(ifx_Float_t) == sizeof(float))
+    {
+        ifx_simd_adc_kernels()->adc8_c(data, frameStepping, reinterpret_cast<float*>(samples), numSamples);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < numSamples; ++i)
+        {
+            const auto ifiIdx = (i * frameStepping);
+            // ifqIdx  = ifiIdx + 1
+
+            const ifx_Float_t I = ::normalize(data[ifiIdx]);
+            const ifx_Float_t Q = ::normalize(data[ifiIdx + 1]);
+
+            samples[i * stride] = IFX_COMPLEX_DEF(I, Q);
+        }
+    }
+}
+
+void DeviceLtr11::readNextFrame(ifx_Complex_t* samples, size_t stride, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs)
+{
+    if (!m_packet)
+    {
+        fetchPacket(timeoutMs);
+    }
+
+    metadata->active = m_packetActive;
+
     float currentPower;
     if (metadata->active)
     {
@@ -385,24 +517,19 @@ void DeviceLtr11::readNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t*
     const auto frameStepping = (m_frameSize / sizeof(uint16_t));
     const auto detectorOutputIndex = 3;  // detector output index in data readout
 
-    const auto* dataAsUint = reinterpret_cast<const uint16_t*>(deviceFrame->getData());
-
     const auto numberOfSamples = getNumberOfSamples();
-    for (uint32_t i = 0; i < numberOfSamples; ++i)
-    {
-
-        const auto ifiIdx = (i * frameStepping);
-        // ifqIdx  = ifiIdx + 1
+    const auto* dataAsUint = reinterpret_cast<const uint16_t*>(m_packet->getData()) + size_t(m_packetFrameIndex) * numberOfSamples * frameStepping;
 
-        const ifx_Float_t I = ::normalize(dataAsUint[ifiIdx]);
-        const ifx_Float_t Q = ::normalize(dataAsUint[ifiIdx + 1]);
-
-        IFX_VEC_AT(frameData, i) = IFX_COMPLEX_DEF(I, Q);
-    }
+    convertSamples(dataAsUint, frameStepping, samples, stride, numberOfSamples);
 
     metadata->motion = (dataAsUint[(numberOfSamples - 1) * frameStepping + detectorOutputIndex] & IFX_LTR11_DETECTOR_OUTPUT_MOTION_MASK) == IFX_LTR11_DETECTOR_OUTPUT_MOTION_MASK;
     metadata->direction = (dataAsUint[(numberOfSamples - 1) * frameStepping + detectorOutputIndex] & IFX_LTR11_DETECTOR_OUTPUT_DIRECTION_MASK) == IFX_LTR11_DETECTOR_OUTPUT_DIRECTION_MASK;
     metadata->avg_power = m_averagePower;
+
+    if (++m_packetFrameIndex == m_framesPerPacket)
+    {
+        releasePacket();
+    }
 }
 
 void DeviceLtr11::dumpRegisters(const char* filename)
@@ -51,6 +51,7 @@
 #include <optional>
 
 // forward declarations
+class IFrame;
 class IRadarLtr11;
 class IProtocolLtr11;
 
@@ -71,11 +72,21 @@ public:
     void dumpRegisters(const char* filename) override;
 
     ifx_Vector_C_t* getNextFrame(ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs) override;
+    void getNextFrames(ifx_Matrix_C_t* frames, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs) override;
+
+    void setFramesPerPacket(uint16_t framesPerPacket) override;
+
+    /**
+     * Converts numSamples raw I/Q readouts, frameStepping words apart, into
+     * normalized complex samples written stride elements apart.
+     */
+    static void convertSamples(const uint16_t* data, size_t frameStepping, ifx_Complex_t* samples, size_t stride, uint32_t numSamples);
 
 private:
     void softReset();
 
     uint32_t determineBufferSize() const;
+    uint16_t determineSamplesPerPacket(uint16_t framesPerPacket) const;
 
     void setupFrameData();
     void setupBridgeData();
@@ -87,7 +98,9 @@ private:
 
     uint16_t getNumberOfSamples() const;
 
-    void readNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs);
+    void fetchPacket(uint16_t timeoutMs);
+    void releasePacket();
+    void readNextFrame(ifx_Complex_t* samples, size_t stride, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs);
 
     std::unique_ptr<BoardInstance> m_board;
 
@@ -106,6 +119,10 @@ private:
 
     std::optional<uint64_t> m_timestampPrev;
 
+    IFrame* m_packet;             // packet being unpacked, holds m_framesPerPacket frames
+    uint16_t m_packetFrameIndex;  // index of the next frame within m_packet
+    bool m_packetActive;          // power mode derived from the timestamp of m_packet
+
     std::atomic<bool> m_acquisitionStarted;
 
     float m_frameCounter;
@@ -45,6 +45,7 @@
 ==============================================================================
 */
 #define IFX_LTR11_MAX_ALLOWED_NUM_SAMPLES 1024
+#define IFX_LTR11_MAX_FRAMES_PER_PACKET   64
 
 /*
 ==============================================================================
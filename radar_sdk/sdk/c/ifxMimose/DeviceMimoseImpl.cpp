@@ -34,14 +34,17 @@
 
 #include "ifxBase/Cube.h"
 #include "ifxBase/Exception.hpp"
+#include "ifxBase/internal/SimdAdc.h"
 #include "ifxRadarDeviceCommon/internal/RadarDeviceCommon.hpp"
 
 // strata
 #include <common/exception/EException.hpp>
+#include <common/Finally.hpp>
 #include <components/interfaces/IRadarAtr22.hpp>
 #include <platform/interfaces/IBridgeControl.hpp>
 #include <platform/interfaces/IBridgeData.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstring>
@@ -69,9 +72,6 @@ void checkFrameDimensions(const ifx_Cube_C_t* frame, const ifx_Mimose_Frame_Conf
     }
 }
 
-using MemoryRegion = std::pair<const uint16_t*, const uint16_t*>;
-using MemoryRegions = std::vector<MemoryRegion>;
-
 inline float toFloat(uint16_t fvalue)
 {
     auto value = (fvalue & 0x0FFF);
@@ -154,33 +154,6 @@ void fillMetaData(ifx_Mimose_Metadata_t* metadata,
     }
 }
 
-enum RawDataSubType
-{
-    FirstHalf,
-    SecondHalf
-};
-
-void fillBuffer(std::vector<uint16_t>& toFill, const uint16_t* rawData, const size_t numSamples, const size_t numPulses, RawDataSubType rawDataSubType)
-{
-    const auto* begin = rawData;
-    const auto* end = begin;
-
-    for (size_t i = 0; i < numPulses; ++i)
-    {
-
-        begin = end;
-        end += numSamples;
-
-        // the destination buffer offset is the offset at which position the half pulse need to be stored
-        size_t destBuffOffset = (rawDataSubType == RawDataSubType::FirstHalf) ? 0 : numSamples;
-        destBuffOffset += (i * (numSamples * 2));
-
-        auto* dest = (toFill.data() + destBuffOffset);
-
-        std::copy(begin, end, dest);
-    }
-}
-
 uint32_t getNextPowerOf2(uint32_t num)
 {
     uint32_t pnum = 1;
@@ -231,7 +204,9 @@ DeviceMimose::DeviceMimose(std::unique_ptr<BoardInstance>&& board) :
     m_currentAfc(0),
     m_switchingConf(false),
     m_samplingMode(SamplingMode::FramePausedSampling),
-    m_equidistantSamplingTraits {}
+    m_equidistantSamplingTraits {},
+    m_frameLayout {},
+    m_assemblyState(AssemblyState::WaitingForFirstHalf)
 {
     if (!m_board)
     {
@@ -403,6 +378,8 @@ void DeviceMimose::setConfig(const ifx_Mimose_Config_t* config)
         m_frameBufferSize = getFrameBufferSize(m_frameSpecificReadoutConfiguration);
     }
 
+    compileFrameLayout();
+
     // setup trigger configuration
     //
     if (m_samplingMode == SamplingMode::FramePausedSampling)
@@ -477,11 +454,7 @@ void DeviceMimose::startAcquisition()
     // reset the stored afc
     m_currentAfc = 0;
 
-    if (m_samplingMode == SamplingMode::EquidistantSampling)
-    {
-        const auto rawDataBufferSize = (m_frameBufferSize / IQ_SAMPLE_SIZE);
-        m_equidistantSamplingTraits.m_rawDataBuffer.resize(rawDataBufferSize);  // frame buffer size is expressed in bytes while the raw buffer in uint16's
-    }
+    m_assemblyState = AssemblyState::WaitingForFirstHalf;
     m_acquisitionStarted = true;
 }
 
@@ -924,184 +897,195 @@ uint32_t DeviceMimose::getFrameBufferSize(const ReadoutDataConfiguration& readou
     return (bufferSize * sizeof(uint16_t));
 }
 
-// NOLINTNEXTLINE(misc-no-recursion)
-void DeviceMimose::readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, uint16_t timeoutMillis)
+void DeviceMimose::compileFrameLayout()
 {
-    IFrame* deviceFrame = m_board->getFrame(timeoutMillis);
-    if (!deviceFrame)
+    const auto equidistantSampling = (m_samplingMode == SamplingMode::EquidistantSampling);
+
+    // the metadata readouts (frame counter, VCO, AOC, AGC) are the last entries of the
+    // readout configuration of the packet which completes a frame
+    const auto& readouts = equidistantSampling ? m_fragmentSpecificReadoutConfigurations[1] : m_frameSpecificReadoutConfiguration;
+    constexpr size_t METADATA_READOUT_COUNT = 4;
+    if (readouts.size() < METADATA_READOUT_COUNT)
     {
-        throw rdk::exception::timeout();
+        throw rdk::exception::internal();
     }
 
-    const auto statusCode = deviceFrame->getStatusCode();
-    if (statusCode != 0)
+    std::array<uint32_t, METADATA_READOUT_COUNT> offsets;
+    uint32_t offset = 0;
+    for (size_t i = 0; i < readouts.size(); ++i)
     {
-        deviceFrame->release();
-        switch (statusCode)
+        const auto firstMetadataReadout = readouts.size() - METADATA_READOUT_COUNT;
+        if (i >= firstMetadataReadout)
         {
-            case DataError_FramePoolDepleted:
-                throw rdk::exception::insufficient_memory_allocated();
-                break;
-            case DataError_FrameDropped:
-                throw rdk::exception::communication_error();
-                break;
-            case DataError_LowLevelError:
-                throw rdk::exception::frame_acquisition_failed();
-                break;
-            default:
-                throw rdk::exception::error();
-                break;
+            offsets[i - firstMetadataReadout] = offset;
         }
+        offset += readouts[i].count;
     }
 
-    const auto equidistantSampling = (m_samplingMode == SamplingMode::EquidistantSampling);
-    const auto frameChannel = deviceFrame->getVirtualChannel();
+    const auto lastPacketSize = equidistantSampling ? m_equidistantSamplingTraits.m_frameBufferSecondHalfSize : m_frameBufferSize;
+    if (offset * sizeof(uint16_t) != lastPacketSize)
     {
-        uint32_t expectedFrameSize;
-        if (equidistantSampling)
-        {
-            if (frameChannel == m_dataIndex)
-            {
-                expectedFrameSize = m_equidistantSamplingTraits.m_frameBufferFirstHalfSize;
-            }
-            else if (frameChannel == m_dataIndex2)
-            {
-                expectedFrameSize = m_equidistantSamplingTraits.m_frameBufferSecondHalfSize;
-            }
-            else
-            {
-                expectedFrameSize = m_statusBufferSize;
-            }
-        }
-        else
-        {
-            expectedFrameSize = (frameChannel == m_dataIndex) ? m_frameBufferSize : m_statusBufferSize;
-        }
-        if (deviceFrame->getDataSize() != expectedFrameSize)
-        {
-            deviceFrame->release();
-            throw rdk::exception::frame_size_not_supported();
-        }
+        throw rdk::exception::internal();
     }
 
-    const uint16_t pulsesToRead = DeviceMimoseBase::getNumActivePulseConfigurations(
-        m_config.frame_config[m_activeFrameIndex].selected_pulse_configs);
-    const auto* samples = reinterpret_cast<const uint16_t*>(deviceFrame->getData());
-
     if (equidistantSampling)
     {
-        if (frameChannel == m_dataIndex)
-        {
-            ::fillBuffer(m_equidistantSamplingTraits.m_rawDataBuffer, samples, m_numSamplesForNextPulseInMem, pulsesToRead, RawDataSubType::FirstHalf);
-            deviceFrame->release();
-            return readRawFrame(frame, metadata, timeoutMillis);
-        }
-        else if (frameChannel == m_dataIndex2)
-        {
-            ::fillBuffer(m_equidistantSamplingTraits.m_rawDataBuffer, samples, m_numSamplesForNextPulseInMem, pulsesToRead, RawDataSubType::SecondHalf);
-
-            const auto rem = (deviceFrame->getDataSize() / sizeof(uint16_t)) - (static_cast<size_t>(m_numSamplesForNextPulseInMem) * pulsesToRead);
-            if (rem > 0)
-            {
-                const auto fromOffset = (m_numSamplesForNextPulseInMem * pulsesToRead);
-                const auto toOffset = (fromOffset + rem);
-                std::copy((samples + fromOffset), (samples + toOffset), (m_equidistantSamplingTraits.m_rawDataBuffer.data() + (static_cast<size_t>(m_numSamplesForNextPulseInMem) * pulsesToRead * IQ_SAMPLE_SIZE)));
-            }
-        }
+        m_frameLayout.m_pulseStride = m_numSamplesForNextPulseInMem;
+        m_frameLayout.m_firstPacketSamples = m_numSamplesForNextPulseInMem / 2;
     }
+    else
+    {
+        m_frameLayout.m_pulseStride = m_numSamplesForNextPulseInMem * IQ_SAMPLE_SIZE;
+        m_frameLayout.m_firstPacketSamples = m_numSamplesForNextPulseInMem;
+    }
+    m_frameLayout.m_vcoOffset = offsets[1];
+    m_frameLayout.m_aocOffset = offsets[2];
+    m_frameLayout.m_agcOffset = offsets[3];
+}
 
-    const auto totalSampleCount = (m_frameBufferSize / sizeof(uint16_t));
-
-    if (equidistantSampling)
+void DeviceMimose::convertPulse(const uint16_t* pulseMemory, ifx_Complex_t* samples, size_t stride, uint16_t numSamples)
+{
+    // the SIMD kernel writes interleaved float pairs, so it only applies to
+    // contiguous samples in single precision builds
+    if (stride == 1 && sizeof(ifx_Float_t) == sizeof(float))
     {
-        samples = m_equidistantSamplingTraits.m_rawDataBuffer.data();
-        if (totalSampleCount != m_equidistantSamplingTraits.m_rawDataBuffer.size())
+        ifx_simd_adc_kernels()->adc12_c(pulseMemory, reinterpret_cast<float*>(samples), numSamples);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < numSamples; ++i)
         {
-            deviceFrame->release();
-            throw rdk::exception::internal();
+            const ifx_Float_t I = ::toFloat(pulseMemory[i * IQ_SAMPLE_SIZE]);
+            const ifx_Float_t Q = ::toFloat(pulseMemory[i * IQ_SAMPLE_SIZE + 1]);
+
+            samples[i * stride] = ifx_Complex_t {I, Q};
         }
     }
+}
 
-    const auto iqNumSamplesPerPulseMemSize = (m_numSamplesForNextPulseInMem * IQ_SAMPLE_SIZE);  // expressed in uint16_t's as pairs of IQ's (x2)
-
-    constexpr auto RAW_MEM_REGION_INDEX = 0;
-    // constexpr auto FRAME_COUNTER_REGION_INDEX = 1;
-    constexpr auto VCO_REGION_INDEX = 2;
-    constexpr auto AOC_REGION_INDEX = 3;
-    constexpr auto AGC_REGION_INDEX = 4;
-
-    // create MemoryRegions
-    MemoryRegions dataMemoryRegions;
-    try
+void DeviceMimose::decodePulses(const uint16_t* packet, uint16_t firstSample, uint16_t numSamples, ifx_Cube_C_t* frame) const
+{
+    if (numSamples == 0)
     {
-        dataMemoryRegions.reserve(m_frameSpecificReadoutConfiguration.size());
-
-        const uint16_t* memBegin = samples;
-        const uint16_t* memEnd = memBegin;
-
-        uint32_t mapped = 0;
+        return;
+    }
 
-        for (const auto& readoutConf : m_frameSpecificReadoutConfiguration)
-        {
-            memEnd += readoutConf.count;
-            mapped += readoutConf.count;
+    const uint16_t pulsesToRead = DeviceMimoseBase::getNumActivePulseConfigurations(
+        m_config.frame_config[m_activeFrameIndex].selected_pulse_configs);
 
-            if (totalSampleCount >= mapped)
-            {
-                dataMemoryRegions.emplace_back(std::make_pair(memBegin, memEnd));
-            }
-            else
-            {
-                deviceFrame->release();
-                throw rdk::exception::insufficient_memory_allocated();
-            }
-            memBegin = memEnd;
-        }
-    }
-    catch (const std::out_of_range&)
+    for (uint16_t pulseIdx = 0; pulseIdx < pulsesToRead; ++pulseIdx)
     {
-        deviceFrame->release();
-        throw rdk::exception::internal();
+        const auto* pulseMemory = packet + static_cast<size_t>(pulseIdx) * m_frameLayout.m_pulseStride;
+
+        convertPulse(pulseMemory, &IFX_CUBE_AT(frame, 0, pulseIdx, firstSample), IFX_CUBE_STRIDE(frame, 2), numSamples);
     }
+}
 
+void DeviceMimose::decodeMetadata(const uint16_t* packet, ifx_Mimose_Metadata_t* metadata)
+{
     // determine the current AFC
     {
-        const auto& vcoMemory = dataMemoryRegions[VCO_REGION_INDEX];
+        const auto* vcoMemory = packet + m_frameLayout.m_vcoOffset;
 
-        const auto afcValue = vcoMemory.first[2];
-        const auto afcCounterLow = vcoMemory.first[3];
-        const auto afcCounterHigh = vcoMemory.first[4];
+        const auto afcValue = vcoMemory[2];
+        const auto afcCounterLow = vcoMemory[3];
+        const auto afcCounterHigh = vcoMemory[4];
 
         m_currentAfc = ::packAfc(afcValue, afcCounterLow, afcCounterHigh, true);
     }
 
-    const auto& aocMemory = dataMemoryRegions[AOC_REGION_INDEX];
-    const auto& agcMemory = dataMemoryRegions[AGC_REGION_INDEX];
-    ::fillMetaData(metadata, aocMemory.first, agcMemory.first, pulsesToRead);
+    const uint16_t pulsesToRead = DeviceMimoseBase::getNumActivePulseConfigurations(
+        m_config.frame_config[m_activeFrameIndex].selected_pulse_configs);
+    ::fillMetaData(metadata, packet + m_frameLayout.m_aocOffset, packet + m_frameLayout.m_agcOffset, pulsesToRead);
+}
 
-    const auto* pulseMemory = dataMemoryRegions[RAW_MEM_REGION_INDEX].first;
+void DeviceMimose::readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, uint16_t timeoutMillis)
+{
+    const auto equidistantSampling = (m_samplingMode == SamplingMode::EquidistantSampling);
 
-    // perform n reads according to the number of expected pulses
-    for (uint16_t pulseIdx = 0; pulseIdx < pulsesToRead; ++pulseIdx)
+    const auto numSamplesFirstPacket = std::min(m_numSamplesReturned, m_frameLayout.m_firstPacketSamples);
+    const auto numSamplesSecondPacket = static_cast<uint16_t>(m_numSamplesReturned - numSamplesFirstPacket);
+
+    // Packets are consumed until a frame is complete. In equidistant sampling mode the
+    // first half is decoded into the frame as soon as it arrives, so only the second half
+    // remains to be decoded once it is received.
+    for (;;)
     {
-        for (uint32_t i = 0; i < m_numSamplesReturned; ++i)
+        IFrame* deviceFrame = m_board->getFrame(timeoutMillis);
+        if (!deviceFrame)
+        {
+            throw rdk::exception::timeout();
+        }
+
+        auto cleanup = stdext::finally(
+            [deviceFrame]() {
+                deviceFrame->release();
+            });
+
+        const auto statusCode = deviceFrame->getStatusCode();
+        switch (statusCode)
         {
+            case DataError_NoError:
+                break;
+            case DataError_FramePoolDepleted:
+                throw rdk::exception::insufficient_memory_allocated();
+                break;
+            case DataError_FrameDropped:
+                throw rdk::exception::communication_error();
+                break;
+            case DataError_LowLevelError:
+                throw rdk::exception::frame_acquisition_failed();
+                break;
+            default:
+                throw rdk::exception::error();
+                break;
+        }
 
-            const auto ifiIdx = (i * 2);
-            // ifqIdx  = ifiIdx + 1
+        const auto frameChannel = deviceFrame->getVirtualChannel();
+        uint32_t expectedFrameSize;
+        if (frameChannel == m_dataIndex)
+        {
+            expectedFrameSize = equidistantSampling ? m_equidistantSamplingTraits.m_frameBufferFirstHalfSize : m_frameBufferSize;
+        }
+        else if (equidistantSampling && (frameChannel == m_dataIndex2))
+        {
+            expectedFrameSize = m_equidistantSamplingTraits.m_frameBufferSecondHalfSize;
+        }
+        else
+        {
+            expectedFrameSize = m_statusBufferSize;
+        }
+        if (deviceFrame->getDataSize() != expectedFrameSize)
+        {
+            throw rdk::exception::frame_size_not_supported();
+        }
 
-            const ifx_Float_t I = ::toFloat(pulseMemory[ifiIdx]);
-            const ifx_Float_t Q = ::toFloat(pulseMemory[ifiIdx + 1]);
+        const auto* packet = reinterpret_cast<const uint16_t*>(deviceFrame->getData());
 
-            IFX_CUBE_AT(frame, 0, pulseIdx, i) = ifx_Complex_t {I, Q};
+        if (frameChannel == m_dataIndex)
+        {
+            decodePulses(packet, 0, numSamplesFirstPacket, frame);
+            if (!equidistantSampling)
+            {
+                decodeMetadata(packet, metadata);
+                return;
+            }
+            m_assemblyState = AssemblyState::WaitingForSecondHalf;
         }
-        pulseMemory += iqNumSamplesPerPulseMemSize;
-    }
-    deviceFrame->release();
+        else if (equidistantSampling && (frameChannel == m_dataIndex2))
+        {
+            if (m_assemblyState == AssemblyState::WaitingForFirstHalf)
+            {
+                // the first half of this frame was not received, so wait for the next frame
+                continue;
+            }
 
-    if (pulseMemory != dataMemoryRegions[RAW_MEM_REGION_INDEX].second)
-    {
-        throw rdk::exception::internal();
+            decodePulses(packet, m_frameLayout.m_firstPacketSamples, numSamplesSecondPacket, frame);
+            decodeMetadata(packet, metadata);
+            m_assemblyState = AssemblyState::WaitingForFirstHalf;
+            return;
+        }
+        // status packets carry no frame data
     }
 }
 
@@ -62,7 +62,22 @@ struct EquidistantSamplingTraits
     uint16_t m_triggerCount;
     uint32_t m_frameBufferFirstHalfSize;
     uint32_t m_frameBufferSecondHalfSize;
-    std::vector<uint16_t> m_rawDataBuffer;
+};
+
+/*
+ * @brief The structure describes where samples and metadata are located within the received packets.
+ *
+ * The layout is compiled once when the configuration is applied, so frames are decoded without
+ * searching the readout configuration or allocating memory. In equidistant sampling mode the first
+ * packet holds the first half of each pulse and the second packet the second half and the metadata.
+ */
+struct FrameLayout
+{
+    uint32_t m_pulseStride;         // distance of consecutive pulses within a packet in uint16_t's
+    uint16_t m_firstPacketSamples;  // number of samples per pulse held by the first packet
+    uint32_t m_vcoOffset;           // offsets of the metadata readouts in the last packet in uint16_t's
+    uint32_t m_aocOffset;
+    uint32_t m_agcOffset;
 };
 
 
@@ -89,6 +104,12 @@ struct DeviceMimose : public DeviceMimoseBase
     void update_rc_lut() override;
     void setAOCModeAndUpdateConfig(const ifx_Mimose_AOC_Mode_t aocMode[4]) override;
 
+    /**
+     * Converts numSamples raw I/Q word pairs of one pulse into normalized
+     * complex samples written stride elements apart.
+     */
+    static void convertPulse(const uint16_t* pulseMemory, ifx_Complex_t* samples, size_t stride, uint16_t numSamples);
+
 private:
     using ReadoutDataConfiguration = std::vector<ReadoutEntry_t>;
 
@@ -98,6 +119,12 @@ private:
         EquidistantSampling
     };
 
+    enum class AssemblyState
+    {
+        WaitingForFirstHalf,
+        WaitingForSecondHalf
+    };
+
     std::unique_ptr<BoardInstance> m_board;
 
     IRadarAtr22* m_atr22;
@@ -129,6 +156,8 @@ private:
 
     SamplingMode m_samplingMode;
     EquidistantSamplingTraits m_equidistantSamplingTraits;
+    FrameLayout m_frameLayout;
+    AssemblyState m_assemblyState;
 
     ifx_Radar_Sensor_t getShieldType() const;
 
@@ -172,5 +201,9 @@ private:
     IFrame* getFrame(uint16_t timeoutMillis);
     static uint32_t getFrameBufferSize(const ReadoutDataConfiguration& readoutConfiguration);
 
+    void compileFrameLayout();
+    void decodePulses(const uint16_t* packet, uint16_t firstSample, uint16_t numSamples, ifx_Cube_C_t* frame) const;
+    void decodeMetadata(const uint16_t* packet, ifx_Mimose_Metadata_t* metadata);
+
     void readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, uint16_t timeoutMillis);
 };
@@ -27,6 +27,7 @@
 ** ===========================================================================
 */
 
+
 /*
 ==============================================================================
    1. INCLUDE FILES
@@ -35,6 +36,7 @@
 
 #include <float.h>
 #include <math.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -43,7 +45,6 @@
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
 #include "ifxBase/internal/Macros.h"
-#include "ifxBase/LA.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
@@ -56,6 +57,18 @@
 ==============================================================================
 */
 
+/**
+ * Default relative diagonal loading added to the covariance matrix before the
+ * Cholesky decomposition, see \ref ifx_anglecapon_set_diagonal_loading.
+ */
+#define CAPON_DIAGONAL_LOADING ((ifx_Float_t)1e-6)
+
+/**
+ * Upper bound for the number of antennas and beams (both are uint8_t in
+ * \ref ifx_AngleCapon_Config_t). Used for small scratch arrays on the stack.
+ */
+#define CAPON_MAX_DIM 256
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -65,22 +78,31 @@
 /**
  * @brief Defines the structure for Angle Capon module.
  *        Use type ifx_AngleCapon_t for this struct.
+ *
+ * All small matrices are stored as contiguous row-major arrays of
+ * ifx_Complex_t such that the fixed-size kernels below do not need to go
+ * through the generic matrix accessors.
  */
 struct ifx_AngleCapon_s
 {
-    uint8_t num_virtual_antennas;           /**< Virtual number of antennas.*/
-    uint8_t num_beams;                      /**< Number of beams.*/
-    uint8_t selected_rx;                    /**< Select the best Rx channel for choosing proper Doppler index.*/
-    ifx_Float_t phase_offset_degrees;       /**< Phase offset compensation between used Rx antennas.*/
-    uint16_t neighbouring_bins;             /**< Neighbouring bins.*/
-    uint16_t num_chirps;                    /**< Number of chirps per frame.*/
-    ifx_Matrix_C_t* weights;                /**< Weights */
-    ifx_Matrix_C_t* range_pulse_matrix;     /**< Range pulse matrix.*/
-    ifx_Vector_C_t* range_pulse_scalar;     /**< Range pulse scalar matrix.*/
-    ifx_Matrix_C_t* range_pulse_covariance; /**< Range pulse covariance matrix.*/
-    ifx_Vector_R_t* angle_vector;           /**< Angle vector covering the radar FoV.*/
-    ifx_Matrix_C_t* inverse;                /**< ... */
-    ifx_Vector_C_t* tmp_vec;                /**< ... */
+    uint8_t num_virtual_antennas;     /**< Virtual number of antennas.*/
+    uint8_t num_beams;                /**< Number of beams.*/
+    uint8_t selected_rx;              /**< Select the best Rx channel for choosing proper Doppler index.*/
+    ifx_Float_t phase_offset_degrees; /**< Phase offset compensation between used Rx antennas.*/
+    uint16_t neighbouring_bins;       /**< Neighbouring bins.*/
+    uint16_t num_snapshots;           /**< Number of snapshots per covariance estimate (range window size).*/
+    uint16_t num_chirps;              /**< Number of chirps per frame.*/
+    ifx_Float_t covariance_alpha;     /**< Forgetting factor of the recursive covariance update.*/
+    ifx_Float_t diagonal_loading;     /**< Diagonal loading relative to the mean of the covariance diagonal.*/
+    ifx_Vector_R_t* angle_vector;     /**< Angle vector covering the radar FoV.*/
+    ifx_Complex_t* steering;          /**< Steering vectors (num_beams x num_virtual_antennas).*/
+    ifx_Complex_t* phase_compensation; /**< Phase compensation per antenna (num_virtual_antennas).*/
+    ifx_Complex_t* snapshots;         /**< Snapshot matrix (num_virtual_antennas x num_snapshots).*/
+    ifx_Complex_t* covariance;        /**< Covariance matrix and Cholesky factor (num_virtual_antennas x num_virtual_antennas).*/
+    ifx_Float_t* inv_diagonal;        /**< Reciprocal of the diagonal of the Cholesky factor.*/
+    ifx_Complex_t* history;           /**< Recursive covariance matrices per range bin.*/
+    uint8_t* history_valid;           /**< Flag per range bin whether history holds a valid covariance.*/
+    uint32_t history_rows;            /**< Number of range bins in history.*/
 };
 
 /*
@@ -99,22 +121,46 @@ static void init_angle_vector(const ifx_AngleCapon_Config_t* config,
                               ifx_Vector_R_t* angle_vector);
 
 
-static void init_range_pulse_scalar(const ifx_AngleCapon_Config_t* config,
-                                    ifx_Vector_C_t* range_pulse_scalar);
+static void init_phase_compensation(const ifx_AngleCapon_Config_t* config,
+                                    ifx_Complex_t* phase_compensation);
 
-/**
- * We need think about how to: 1. make use of this weight matrix or vector for
- * both AngleCapon and DBF module; 2. make use of "for iAngle = 1:numBeams" from the Matlab
- * code and only use one vector to simplify the calculation if possible.
- * For the moment, this straightforward implementation is copied from DBF module. @endinternal */
-static void init_weights(ifx_Matrix_C_t* weights,
-                         const ifx_AngleCapon_Config_t* config);
+static void init_steering(ifx_Complex_t* steering,
+                          const ifx_AngleCapon_Config_t* config);
 
 static uint32_t find_doppler_idx(const ifx_Matrix_C_t* rx_channel,
                                  uint16_t range_idx,
                                  uint16_t num_chirps,
                                  uint16_t neighboring_bins);
 
+static void gather_snapshots(const ifx_AngleCapon_t* handle,
+                             uint32_t range_bin,
+                             const ifx_Cube_C_t* rx_spectrum);
+
+static void covariance_rank_k(ifx_Complex_t* R,
+                              const ifx_Complex_t* X,
+                              uint32_t n,
+                              uint32_t k,
+                              ifx_Float_t alpha,
+                              bool recursive);
+
+static void load_diagonal(ifx_Complex_t* R,
+                          uint32_t n,
+                          ifx_Float_t relative_loading);
+
+static bool cholesky(ifx_Complex_t* A,
+                     ifx_Float_t* inv_diagonal,
+                     uint32_t n);
+
+static void mvdr_denominators(const ifx_Complex_t* L,
+                              const ifx_Float_t* inv_diagonal,
+                              const ifx_Complex_t* steering,
+                              uint32_t num_beams,
+                              uint32_t n,
+                              ifx_Float_t* result);
+
+static bool factorize_and_scan(const ifx_AngleCapon_t* handle,
+                               ifx_Float_t* angle);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -134,26 +180,24 @@ static void init_angle_vector(const ifx_AngleCapon_Config_t* config,
 
 //----------------------------------------------------------------------------
 
-static void init_range_pulse_scalar(const ifx_AngleCapon_Config_t* config,
-                                    ifx_Vector_C_t* range_pulse_scalar)
+static void init_phase_compensation(const ifx_AngleCapon_Config_t* config,
+                                    ifx_Complex_t* phase_compensation)
 {
     ifx_Float_t exp_arg = -2 * IFX_PI * config->d_by_lambda * SIND(config->phase_offset_degrees);
     ifx_Float_t scalar_r = 0.0;
     ifx_Float_t scalar_i = 0.0;
-    ifx_Complex_t scalar;
 
-    for (uint32_t idx = 0; idx < vLen(range_pulse_scalar); ++idx)
+    for (uint32_t idx = 0; idx < config->num_virtual_antennas; ++idx)
     {
         SINCOS(exp_arg * idx, &scalar_i, &scalar_r);
-        IFX_COMPLEX_SET(scalar, scalar_r, scalar_i);
-        ifx_vec_setat_c(range_pulse_scalar, idx, scalar);
+        IFX_COMPLEX_SET(phase_compensation[idx], scalar_r, scalar_i);
     }
 }
 
 //----------------------------------------------------------------------------
 
-static void init_weights(ifx_Matrix_C_t* weights,
-                         const ifx_AngleCapon_Config_t* config)
+static void init_steering(ifx_Complex_t* steering,
+                          const ifx_AngleCapon_Config_t* config)
 {
     // weights(1,:) = (1/sqrt(numAntennas));
     // for iAngle = 1:numBeams
@@ -161,24 +205,25 @@ static void init_weights(ifx_Matrix_C_t* weights,
     //         weights(iAntenna,iAngle) = (exp(1j*2*pi*(iAntenna-1)*d_by_lambda*sind(angleVector(iAngle)))/sqrt(numAntennas));
     //     end
     // end
+    //
+    // The steering vector of each beam is stored contiguously (beam-major).
 
     ifx_Float_t exp_arg;
     ifx_Float_t weight_r;
     ifx_Float_t weight_i;
-    ifx_Complex_t weight;
 
+    const uint32_t num_antennas = config->num_virtual_antennas;
     const ifx_Float_t exp_arg_const = (2 * IFX_PI * config->d_by_lambda);
-    const ifx_Float_t weight_scale = 1.0f / SQRT((ifx_Float_t)config->num_virtual_antennas);
+    const ifx_Float_t weight_scale = 1.0f / SQRT((ifx_Float_t)num_antennas);
     ifx_Float_t angle_step = (config->max_angle_degrees - config->min_angle_degrees) / (config->num_beams - 1);
-    for (int beam = 0; beam < config->num_beams; beam++)
+    for (uint32_t beam = 0; beam < config->num_beams; beam++)
     {
         exp_arg = SIND(config->min_angle_degrees + angle_step * beam) * exp_arg_const;
 
-        for (int ant = 0; ant < config->num_virtual_antennas; ant++)
+        for (uint32_t ant = 0; ant < num_antennas; ant++)
         {
             SINCOS(exp_arg * ant, &weight_i, &weight_r);
-            IFX_COMPLEX_SET(weight, (weight_r * weight_scale), (weight_i * weight_scale));
-            mAt(weights, ant, beam) = weight;
+            IFX_COMPLEX_SET(steering[beam * num_antennas + ant], (weight_r * weight_scale), (weight_i * weight_scale));
         }
     }
 }
@@ -195,7 +240,8 @@ static uint32_t find_doppler_idx(const ifx_Matrix_C_t* rx_channel,
 
     for (uint32_t col = 0; col < mCols(rx_channel); ++col)
     {
-        ifx_Float_t abs_value = ifx_complex_abs(IFX_MAT_AT(rx_channel, range_idx, col));
+        // comparing squared magnitudes gives the same index without sqrt
+        ifx_Float_t abs_value = ifx_complex_sqnorm(IFX_MAT_AT(rx_channel, range_idx, col));
 
         if (abs_value > maximum)
         {
@@ -212,6 +258,303 @@ static uint32_t find_doppler_idx(const ifx_Matrix_C_t* rx_channel,
     return doppler_idx;
 }
 
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Copies the phase compensated range gate of all antennas to the snapshot matrix
+ *
+ * The Doppler index is determined from the selected Rx channel, then the
+ * range_win_size samples around this Doppler index are copied from each
+ * antenna to the rows of handle->snapshots.
+ */
+static void gather_snapshots(const ifx_AngleCapon_t* handle,
+                             uint32_t range_bin,
+                             const ifx_Cube_C_t* rx_spectrum)
+{
+    const uint32_t n = handle->num_virtual_antennas;
+    const uint32_t k = handle->num_snapshots;
+
+    ifx_Matrix_C_t rx_channel;
+    ifx_cube_get_slice_c(rx_spectrum, handle->selected_rx, &rx_channel);
+    const uint32_t doppler_idx = find_doppler_idx(&rx_channel,
+                                                  range_bin,
+                                                  handle->num_chirps,
+                                                  handle->neighbouring_bins);
+    const uint32_t first = doppler_idx - handle->neighbouring_bins;
+
+    for (uint32_t ant = 0; ant < n; ++ant)
+    {
+        ifx_Matrix_C_t slice;
+        ifx_cube_get_slice_c(rx_spectrum, ant, &slice);
+
+        const ifx_Complex_t* src = &mAt(&slice, range_bin, first);
+        const size_t stride = mStride(&slice, 1);
+        const ifx_Complex_t c = handle->phase_compensation[ant];
+        ifx_Complex_t* dst = &handle->snapshots[ant * k];
+
+        for (uint32_t s = 0; s < k; ++s)
+        {
+            dst[s] = ifx_complex_mul(src[s * stride], c);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Rank-k update of a Hermitian covariance matrix
+ *
+ * Computes the lower triangular part (including the diagonal) of
+ * \f[
+ *      R = X X^H
+ * \f]
+ * or, if recursive is true,
+ * \f[
+ *      R = \alpha R + (1-\alpha) X X^H
+ * \f]
+ * where X is a row-major n x k matrix. The upper triangular part of R is not
+ * touched.
+ */
+static void covariance_rank_k(ifx_Complex_t* R,
+                              const ifx_Complex_t* X,
+                              uint32_t n,
+                              uint32_t k,
+                              ifx_Float_t alpha,
+                              bool recursive)
+{
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const ifx_Complex_t* xi = &X[i * k];
+
+        for (uint32_t j = 0; j <= i; ++j)
+        {
+            const ifx_Complex_t* xj = &X[j * k];
+            ifx_Float_t re = 0;
+            ifx_Float_t im = 0;
+
+            // sum += xi[s] * conj(xj[s])
+            for (uint32_t s = 0; s < k; ++s)
+            {
+                re += IFX_COMPLEX_REAL(xi[s]) * IFX_COMPLEX_REAL(xj[s]) + IFX_COMPLEX_IMAG(xi[s]) * IFX_COMPLEX_IMAG(xj[s]);
+                im += IFX_COMPLEX_IMAG(xi[s]) * IFX_COMPLEX_REAL(xj[s]) - IFX_COMPLEX_REAL(xi[s]) * IFX_COMPLEX_IMAG(xj[s]);
+            }
+
+            ifx_Complex_t* r = &R[i * n + j];
+            if (recursive)
+            {
+                const ifx_Float_t beta = 1 - alpha;
+                IFX_COMPLEX_SET(*r, alpha * IFX_COMPLEX_REAL(*r) + beta * re, alpha * IFX_COMPLEX_IMAG(*r) + beta * im);
+            }
+            else
+            {
+                IFX_COMPLEX_SET(*r, re, im);
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void load_diagonal(ifx_Complex_t* R,
+                          uint32_t n,
+                          ifx_Float_t relative_loading)
+{
+    if (relative_loading == 0)
+        return;
+
+    ifx_Float_t trace = 0;
+    for (uint32_t i = 0; i < n; ++i)
+        trace += IFX_COMPLEX_REAL(R[i * n + i]);
+
+    const ifx_Float_t loading = relative_loading * trace / n;
+    for (uint32_t i = 0; i < n; ++i)
+        IFX_COMPLEX_REAL(R[i * n + i]) += loading;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Inplace Cholesky decomposition of a small Hermitian matrix
+ *
+ * Computes the lower triangular factor L of \f$A = L L^H\f$. Only the lower
+ * triangular part of A is read and overwritten. The reciprocals of the
+ * (real) diagonal elements of L are stored in inv_diagonal such that the
+ * triangular solves do not need any division.
+ *
+ * The function is always inlined with a constant n by \ref cholesky which
+ * lets the compiler fully unroll the loops for the common antenna counts.
+ *
+ * @return false if A is not positive definite, true otherwise.
+ */
+static inline bool cholesky_n(ifx_Complex_t* A,
+                              ifx_Float_t* inv_diagonal,
+                              const uint32_t n)
+{
+    for (uint32_t j = 0; j < n; ++j)
+    {
+        ifx_Float_t d = IFX_COMPLEX_REAL(A[j * n + j]);
+        for (uint32_t k = 0; k < j; ++k)
+            d -= ifx_complex_sqnorm(A[j * n + k]);
+
+        if (!(d > 0))
+            return false;
+
+        d = SQRT(d);
+        IFX_COMPLEX_SET(A[j * n + j], d, 0);
+        inv_diagonal[j] = 1 / d;
+
+        for (uint32_t i = j + 1; i < n; ++i)
+        {
+            // s = A(i,j) - sum_k L(i,k) * conj(L(j,k))
+            ifx_Float_t re = IFX_COMPLEX_REAL(A[i * n + j]);
+            ifx_Float_t im = IFX_COMPLEX_IMAG(A[i * n + j]);
+            for (uint32_t k = 0; k < j; ++k)
+            {
+                const ifx_Complex_t lik = A[i * n + k];
+                const ifx_Complex_t ljk = A[j * n + k];
+                re -= IFX_COMPLEX_REAL(lik) * IFX_COMPLEX_REAL(ljk) + IFX_COMPLEX_IMAG(lik) * IFX_COMPLEX_IMAG(ljk);
+                im -= IFX_COMPLEX_IMAG(lik) * IFX_COMPLEX_REAL(ljk) - IFX_COMPLEX_REAL(lik) * IFX_COMPLEX_IMAG(ljk);
+            }
+            IFX_COMPLEX_SET(A[i * n + j], re * inv_diagonal[j], im * inv_diagonal[j]);
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+static bool cholesky(ifx_Complex_t* A,
+                     ifx_Float_t* inv_diagonal,
+                     uint32_t n)
+{
+    // dispatch to instances with compile time constant size
+    switch (n)
+    {
+        case 2:
+            return cholesky_n(A, inv_diagonal, 2);
+        case 3:
+            return cholesky_n(A, inv_diagonal, 3);
+        case 4:
+            return cholesky_n(A, inv_diagonal, 4);
+        case 8:
+            return cholesky_n(A, inv_diagonal, 8);
+        default:
+            return cholesky_n(A, inv_diagonal, n);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Computes \f$w^H R^{-1} w\f$ for all steering vectors w
+ *
+ * With \f$R = L L^H\f$ the quadratic form is \f$\|y\|^2\f$ where y solves
+ * \f$L y = w\f$. The forward substitution is done for each beam; the
+ * squared norm of y is accumulated on the fly.
+ */
+static inline void mvdr_denominators_n(const ifx_Complex_t* L,
+                                       const ifx_Float_t* inv_diagonal,
+                                       const ifx_Complex_t* steering,
+                                       uint32_t num_beams,
+                                       const uint32_t n,
+                                       ifx_Float_t* result)
+{
+    ifx_Float_t y_re[CAPON_MAX_DIM];
+    ifx_Float_t y_im[CAPON_MAX_DIM];
+
+    for (uint32_t beam = 0; beam < num_beams; ++beam)
+    {
+        const ifx_Complex_t* w = &steering[beam * n];
+        ifx_Float_t norm = 0;
+
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            ifx_Float_t re = IFX_COMPLEX_REAL(w[i]);
+            ifx_Float_t im = IFX_COMPLEX_IMAG(w[i]);
+            for (uint32_t k = 0; k < i; ++k)
+            {
+                const ifx_Complex_t lik = L[i * n + k];
+                re -= IFX_COMPLEX_REAL(lik) * y_re[k] - IFX_COMPLEX_IMAG(lik) * y_im[k];
+                im -= IFX_COMPLEX_REAL(lik) * y_im[k] + IFX_COMPLEX_IMAG(lik) * y_re[k];
+            }
+            y_re[i] = re * inv_diagonal[i];
+            y_im[i] = im * inv_diagonal[i];
+            norm += y_re[i] * y_re[i] + y_im[i] * y_im[i];
+        }
+
+        result[beam] = norm;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void mvdr_denominators(const ifx_Complex_t* L,
+                              const ifx_Float_t* inv_diagonal,
+                              const ifx_Complex_t* steering,
+                              uint32_t num_beams,
+                              uint32_t n,
+                              ifx_Float_t* result)
+{
+    // dispatch to instances with compile time constant size
+    switch (n)
+    {
+        case 2:
+            mvdr_denominators_n(L, inv_diagonal, steering, num_beams, 2, result);
+            break;
+        case 3:
+            mvdr_denominators_n(L, inv_diagonal, steering, num_beams, 3, result);
+            break;
+        case 4:
+            mvdr_denominators_n(L, inv_diagonal, steering, num_beams, 4, result);
+            break;
+        case 8:
+            mvdr_denominators_n(L, inv_diagonal, steering, num_beams, 8, result);
+            break;
+        default:
+            mvdr_denominators_n(L, inv_diagonal, steering, num_beams, n, result);
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Factorizes handle->covariance and returns the angle of the spectrum maximum
+ *
+ * The maximum of the Capon spectrum corresponds to the minimum of
+ * \f$w^H R^{-1} w\f$.
+ *
+ * @return false if the covariance matrix is not positive definite.
+ */
+static bool factorize_and_scan(const ifx_AngleCapon_t* handle,
+                               ifx_Float_t* angle)
+{
+    const uint32_t n = handle->num_virtual_antennas;
+    ifx_Float_t denominators[CAPON_MAX_DIM];
+
+    load_diagonal(handle->covariance, n, handle->diagonal_loading);
+    if (!cholesky(handle->covariance, handle->inv_diagonal, n))
+        return false;
+
+    mvdr_denominators(handle->covariance, handle->inv_diagonal, handle->steering,
+                      handle->num_beams, n, denominators);
+
+    ifx_Float_t min_value = FLT_MAX;  // all denominators are not negative
+    uint32_t min_idx = 0;
+    for (uint32_t idx = 0; idx < handle->num_beams; ++idx)
+    {
+        if (min_value > denominators[idx])
+        {
+            min_idx = idx;
+            min_value = denominators[idx];
+        }
+    }
+
+    *angle = vAt(handle->angle_vector, min_idx);
+    return true;
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -221,39 +564,44 @@ static uint32_t find_doppler_idx(const ifx_Matrix_C_t* rx_channel,
 ifx_AngleCapon_t* ifx_anglecapon_create(const ifx_AngleCapon_Config_t* config)
 {
     IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->num_virtual_antennas == 0);
+    IFX_ERR_BRN_ARGUMENT(config->num_beams < 2);
+    IFX_ERR_BRN_ARGUMENT(config->range_win_size == 0);
+    IFX_ERR_BRN_ARGUMENT(config->range_win_size > config->chirps_per_frame);
 
-    ifx_AngleCapon_t* h = ifx_mem_alloc(sizeof(struct ifx_AngleCapon_s));
+    ifx_AngleCapon_t* h = ifx_mem_calloc(1, sizeof(struct ifx_AngleCapon_s));
     IFX_ERR_BRN_MEMALLOC(h);
 
+    const uint32_t n = config->num_virtual_antennas;
+
     h->num_virtual_antennas = config->num_virtual_antennas;
     h->num_beams = config->num_beams;
     h->selected_rx = config->selected_rx;
     h->phase_offset_degrees = config->phase_offset_degrees;
     h->neighbouring_bins = (config->range_win_size - 1) / 2;
+    h->num_snapshots = h->neighbouring_bins * 2 + 1;
     h->num_chirps = config->chirps_per_frame;
+    h->diagonal_loading = CAPON_DIAGONAL_LOADING;
 
-    IFX_ERR_HANDLE_N(h->weights = ifx_mat_create_c(config->num_virtual_antennas, config->num_beams),
-                     ifx_anglecapon_destroy(h));
-    init_weights(h->weights, config);
-
-    IFX_ERR_HANDLE_N(h->range_pulse_matrix = ifx_mat_create_c(config->num_virtual_antennas, config->range_win_size),
+    IFX_ERR_HANDLE_N(h->angle_vector = ifx_vec_create_r(config->num_beams),
                      ifx_anglecapon_destroy(h));
+    init_angle_vector(config, h->angle_vector);
 
-    IFX_ERR_HANDLE_N(h->range_pulse_scalar = ifx_vec_create_c(config->num_virtual_antennas),
+    IFX_ERR_HANDLE_N(h->steering = ifx_mem_alloc(sizeof(ifx_Complex_t) * n * config->num_beams),
                      ifx_anglecapon_destroy(h));
-    init_range_pulse_scalar(config, h->range_pulse_scalar);
+    init_steering(h->steering, config);
 
-    IFX_ERR_HANDLE_N(h->angle_vector = ifx_vec_create_r(config->num_beams),
+    IFX_ERR_HANDLE_N(h->phase_compensation = ifx_mem_alloc(sizeof(ifx_Complex_t) * n),
                      ifx_anglecapon_destroy(h));
-    init_angle_vector(config, h->angle_vector);
+    init_phase_compensation(config, h->phase_compensation);
 
-    IFX_ERR_HANDLE_N(h->range_pulse_covariance = ifx_mat_create_c(config->num_virtual_antennas, config->num_virtual_antennas),
+    IFX_ERR_HANDLE_N(h->snapshots = ifx_mem_alloc(sizeof(ifx_Complex_t) * n * h->num_snapshots),
                      ifx_anglecapon_destroy(h));
 
-    IFX_ERR_HANDLE_N(h->inverse = ifx_mat_create_c(config->num_virtual_antennas, config->num_virtual_antennas),
+    IFX_ERR_HANDLE_N(h->covariance = ifx_mem_calloc(n * n, sizeof(ifx_Complex_t)),
                      ifx_anglecapon_destroy(h));
 
-    IFX_ERR_HANDLE_N(h->tmp_vec = ifx_vec_create_c(config->num_virtual_antennas),
+    IFX_ERR_HANDLE_N(h->inv_diagonal = ifx_mem_alloc(sizeof(ifx_Float_t) * n),
                      ifx_anglecapon_destroy(h));
 
     return h;
@@ -268,53 +616,175 @@ ifx_Float_t ifx_anglecapon_run(const ifx_AngleCapon_t* handle,
     IFX_ERR_BRV_NULL(handle, IFX_NAN);
     IFX_CUBE_BRV_VALID(rx_spectrum, IFX_NAN);
 
-    ifx_Matrix_C_t rx_channel;
-    ifx_cube_get_slice_c(rx_spectrum, handle->selected_rx, &rx_channel);
-    uint32_t doppler_idx = find_doppler_idx(&rx_channel,
-                                            range_bin,
-                                            handle->num_chirps,
-                                            handle->neighbouring_bins);
+    gather_snapshots(handle, range_bin, rx_spectrum);
+
+    // Calculate covariance_matrix = range_pulse_matrix*(range_pulse_matrix Hermitian)
+    covariance_rank_k(handle->covariance, handle->snapshots,
+                      handle->num_virtual_antennas, handle->num_snapshots, 0, false);
 
-    for (uint8_t ant_idx = 0; ant_idx < handle->num_virtual_antennas; ++ant_idx)
+    ifx_Float_t angle = vAt(handle->angle_vector, 0);
+    if (!factorize_and_scan(handle, &angle))
     {
-        ifx_Matrix_C_t tmp_matrix;
-        ifx_Matrix_C_t lens;
-        ifx_Matrix_C_t range_pulse_row;
-        ifx_cube_get_slice_c(rx_spectrum, ant_idx, &tmp_matrix);
-        ifx_mat_view_c(&lens, &tmp_matrix, range_bin, doppler_idx - handle->neighbouring_bins, 1, handle->neighbouring_bins * 2 + 1);
-        ifx_mat_view_c(&range_pulse_row, handle->range_pulse_matrix, ant_idx, 0, 1, mCols(handle->range_pulse_matrix));
-        ifx_mat_scale_c(&lens, IFX_VEC_AT(handle->range_pulse_scalar, ant_idx), &range_pulse_row);
+        ifx_error_set(IFX_ERROR_MATRIX_SINGULAR);
     }
 
-    // Calculate covariance_matrix = range_pulse_matrix*(range_pulse_matrix Transpose)
-    ifx_mat_abct_c(handle->range_pulse_matrix, handle->range_pulse_matrix, handle->range_pulse_covariance);
+    return angle;
+}
+
+//----------------------------------------------------------------------------
 
-    // Find out the maximum value inside vector capon_result and its index
-    ifx_Float_t min_value = FLT_MAX;  // all elements from capon_result are not negative
-    ifx_Float_t angle = vAt(handle->angle_vector, 0);
-    for (uint32_t idx = 0; idx < handle->num_beams; ++idx)
+void ifx_anglecapon_run_batch(ifx_AngleCapon_t* handle,
+                              const uint32_t* range_bins,
+                              uint32_t num_range_bins,
+                              const ifx_Cube_C_t* rx_spectrum,
+                              ifx_Float_t* angles)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(range_bins);
+    IFX_ERR_BRK_NULL(angles);
+    IFX_CUBE_BRK_VALID(rx_spectrum);
+
+    const uint32_t n = handle->num_virtual_antennas;
+    const uint32_t nn = n * n;
+    const uint32_t num_rows = cRows(rx_spectrum);
+    const bool recursive = handle->covariance_alpha > 0;
+
+    for (uint32_t i = 0; i < num_range_bins; ++i)
+    {
+        IFX_ERR_BRK_COND(range_bins[i] >= num_rows, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    }
+
+    IFX_ERR_BRK_COND(recursive && handle->history_rows != num_rows, IFX_ERROR_DIMENSION_MISMATCH);
+
+    bool singular = false;
+    for (uint32_t i = 0; i < num_range_bins; ++i)
     {
-        ifx_la_invert_c(handle->range_pulse_covariance, handle->inverse);
-        ifx_Vector_C_t vec_weight;
-        ifx_mat_get_colview_c(handle->weights, idx, &vec_weight);
-        ifx_mat_mul_cv(handle->inverse, &vec_weight, handle->tmp_vec);
+        const uint32_t range_bin = range_bins[i];
+
+        gather_snapshots(handle, range_bin, rx_spectrum);
 
-        ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-        for (uint32_t idxvec = 0; idxvec < vLen(handle->tmp_vec); ++idxvec)
+        if (recursive)
         {
-            ifx_Complex_t local_weight = IFX_COMPLEX_DEF(IFX_COMPLEX_REAL(vAt(&vec_weight, idxvec)), -IFX_COMPLEX_IMAG(vAt(&vec_weight, idxvec)));
-            sum = ifx_complex_add(sum, ifx_complex_mul(local_weight, vAt(handle->tmp_vec, idxvec)));
+            ifx_Complex_t* R = &handle->history[range_bin * nn];
+            covariance_rank_k(R, handle->snapshots, n, handle->num_snapshots,
+                              handle->covariance_alpha, handle->history_valid[range_bin] != 0);
+            handle->history_valid[range_bin] = 1;
+            memcpy(handle->covariance, R, sizeof(ifx_Complex_t) * nn);
+        }
+        else
+        {
+            covariance_rank_k(handle->covariance, handle->snapshots, n, handle->num_snapshots, 0, false);
         }
 
-        ifx_Float_t value = ifx_complex_abs(sum);
-        if (min_value > value)
+        if (!factorize_and_scan(handle, &angles[i]))
         {
-            angle = vAt(handle->angle_vector, idx);
-            min_value = value;
+            angles[i] = IFX_NAN;
+            singular = true;
         }
     }
 
-    return angle;
+    if (singular)
+    {
+        ifx_error_set(IFX_ERROR_MATRIX_SINGULAR);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_anglecapon_get_spectrum(const ifx_AngleCapon_t* handle,
+                                 uint32_t range_bin,
+                                 const ifx_Cube_C_t* rx_spectrum,
+                                 ifx_Vector_R_t* spectrum)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(rx_spectrum);
+    IFX_VEC_BRK_VALID(spectrum);
+    IFX_ERR_BRK_COND(vLen(spectrum) != handle->num_beams, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(range_bin >= cRows(rx_spectrum), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    const uint32_t n = handle->num_virtual_antennas;
+    ifx_Float_t denominators[CAPON_MAX_DIM];
+
+    gather_snapshots(handle, range_bin, rx_spectrum);
+    covariance_rank_k(handle->covariance, handle->snapshots, n, handle->num_snapshots, 0, false);
+    load_diagonal(handle->covariance, n, handle->diagonal_loading);
+
+    if (!cholesky(handle->covariance, handle->inv_diagonal, n))
+    {
+        ifx_error_set(IFX_ERROR_MATRIX_SINGULAR);
+        return;
+    }
+
+    mvdr_denominators(handle->covariance, handle->inv_diagonal, handle->steering,
+                      handle->num_beams, n, denominators);
+
+    for (uint32_t idx = 0; idx < handle->num_beams; ++idx)
+    {
+        vAt(spectrum, idx) = 1 / denominators[idx];
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_anglecapon_set_covariance_history(ifx_AngleCapon_t* handle,
+                                           ifx_Float_t alpha,
+                                           uint32_t num_range_bins)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_ARGUMENT(!(alpha >= 0 && alpha < 1));
+    IFX_ERR_BRK_ARGUMENT(alpha > 0 && num_range_bins == 0);
+
+    const uint32_t nn = handle->num_virtual_antennas * handle->num_virtual_antennas;
+
+    ifx_mem_free(handle->history);
+    ifx_mem_free(handle->history_valid);
+    handle->history = NULL;
+    handle->history_valid = NULL;
+    handle->history_rows = 0;
+    handle->covariance_alpha = 0;
+
+    if (alpha == 0)
+    {
+        return;
+    }
+
+    handle->history = ifx_mem_alloc(sizeof(ifx_Complex_t) * nn * num_range_bins);
+    handle->history_valid = ifx_mem_calloc(num_range_bins, sizeof(uint8_t));
+    if (!handle->history || !handle->history_valid)
+    {
+        ifx_mem_free(handle->history);
+        ifx_mem_free(handle->history_valid);
+        handle->history = NULL;
+        handle->history_valid = NULL;
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return;
+    }
+
+    handle->history_rows = num_range_bins;
+    handle->covariance_alpha = alpha;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_anglecapon_set_diagonal_loading(ifx_AngleCapon_t* handle,
+                                         ifx_Float_t loading)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_ARGUMENT(!(loading >= 0));
+
+    handle->diagonal_loading = loading;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_anglecapon_reset(ifx_AngleCapon_t* handle)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    if (handle->history_valid)
+    {
+        memset(handle->history_valid, 0, handle->history_rows);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -326,13 +796,14 @@ void ifx_anglecapon_destroy(ifx_AngleCapon_t* handle)
         return;
     }
 
-    ifx_mat_destroy_c(handle->weights);
-    ifx_mat_destroy_c(handle->range_pulse_matrix);
-    ifx_vec_destroy_c(handle->range_pulse_scalar);
     ifx_vec_destroy_r(handle->angle_vector);
-    ifx_mat_destroy_c(handle->range_pulse_covariance);
-    ifx_mat_destroy_c(handle->inverse);
-    ifx_vec_destroy_c(handle->tmp_vec);
+    ifx_mem_free(handle->steering);
+    ifx_mem_free(handle->phase_compensation);
+    ifx_mem_free(handle->snapshots);
+    ifx_mem_free(handle->covariance);
+    ifx_mem_free(handle->inv_diagonal);
+    ifx_mem_free(handle->history);
+    ifx_mem_free(handle->history_valid);
     ifx_mem_free(handle);
 
     handle = NULL;
@@ -46,6 +46,7 @@
 
 #include "ifxBase/Cube.h"
 #include "ifxBase/Types.h"
+#include "ifxBase/Vector.h"
 
 
 #ifdef __cplusplus
@@ -165,6 +166,131 @@ ifx_Float_t ifx_anglecapon_run(const ifx_AngleCapon_t* handle,
                                uint32_t range_bin,
                                const ifx_Cube_C_t* rx_spectrum);
 
+/**
+ * @brief Runs angle capon algorithm for a list of range bins.
+ *
+ * The function computes the angle of arrival for each of the num_range_bins
+ * range bins given in range_bins and writes the result (in degrees) to angles.
+ * The range bins are processed one after another: for each range bin the
+ * covariance matrix is estimated using a rank-k update, factorized using a
+ * Cholesky decomposition and the MVDR spectrum is evaluated for all beams
+ * using triangular solves. No explicit matrix inverse is computed. If the
+ * covariance matrix of a range bin is not positive definite, the
+ * corresponding angle is set to NAN.
+ *
+ * If a recursive covariance update was enabled using
+ * \ref ifx_anglecapon_set_covariance_history, the covariance matrix of each
+ * range bin is averaged across consecutive calls. In this case the number of
+ * rows of rx_spectrum must match the number of range bins passed to
+ * \ref ifx_anglecapon_set_covariance_history, otherwise the error
+ * IFX_ERROR_DIMENSION_MISMATCH is set.
+ *
+ * For a single range bin and without recursive covariance update the result
+ * is the same as for \ref ifx_anglecapon_run.
+ *
+ * @param [in]     handle              A handle to the AngleCapon object
+ * @param [in]     range_bins          Array of range bins (see \ref ifx_anglecapon_run)
+ * @param [in]     num_range_bins      Number of elements in range_bins and angles
+ * @param [in]     rx_spectrum         Range spectrum returned by \ref ifx_rai_get_rx_spectrum
+ * @param [out]    angles              Array of angles in degrees; one element per range bin
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_anglecapon_run_batch(ifx_AngleCapon_t* handle,
+                              const uint32_t* range_bins,
+                              uint32_t num_range_bins,
+                              const ifx_Cube_C_t* rx_spectrum,
+                              ifx_Float_t* angles);
+
+/**
+ * @brief Computes the MVDR (Capon) spectrum for a single range bin.
+ *
+ * The spectrum is evaluated for all num_beams angles between
+ * min_angle_degrees and max_angle_degrees as
+ * \f[
+ * P(\theta) = \frac{1}{w(\theta)^H R^{-1} w(\theta)}
+ * \f]
+ * where \f$w(\theta)\f$ is the steering vector and \f$R\f$ the covariance
+ * matrix at the given range bin. The angle returned by \ref ifx_anglecapon_run
+ * corresponds to the maximum of this spectrum.
+ *
+ * @param [in]     handle              A handle to the AngleCapon object
+ * @param [in]     range_bin           Range bin (see \ref ifx_anglecapon_run)
+ * @param [in]     rx_spectrum         Range spectrum returned by \ref ifx_rai_get_rx_spectrum
+ * @param [out]    spectrum            Capon spectrum; length must be num_beams
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_anglecapon_get_spectrum(const ifx_AngleCapon_t* handle,
+                                 uint32_t range_bin,
+                                 const ifx_Cube_C_t* rx_spectrum,
+                                 ifx_Vector_R_t* spectrum);
+
+/**
+ * @brief Enables or disables the recursive covariance update of \ref ifx_anglecapon_run_batch.
+ *
+ * With a non-zero forgetting factor alpha the covariance matrix of each range
+ * bin is updated across frames as
+ * \f[
+ * R_n = \alpha R_{n-1} + (1-\alpha) X X^H .
+ * \f]
+ * The memory for the covariance history of num_range_bins range bins is
+ * allocated by this function and the history is cleared. Passing alpha equal
+ * to `0` disables the recursion and releases the history such that each frame
+ * is processed independently (this is the default after
+ * \ref ifx_anglecapon_create).
+ *
+ * @param [in]     handle              A handle to the AngleCapon object
+ * @param [in]     alpha               Forgetting factor; valid range is [0,1)
+ * @param [in]     num_range_bins      Number of range bins (rows) of the rx_spectrum
+ *                                     passed to \ref ifx_anglecapon_run_batch
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_anglecapon_set_covariance_history(ifx_AngleCapon_t* handle,
+                                           ifx_Float_t alpha,
+                                           uint32_t num_range_bins);
+
+/**
+ * @brief Sets the diagonal loading of the covariance matrix.
+ *
+ * Before the covariance matrix \f$R\f$ of \f$N\f$ antennas is factorized,
+ * it is replaced by
+ * \f[
+ * R + \epsilon \frac{\mathrm{tr}(R)}{N} I
+ * \f]
+ * where \f$\epsilon\f$ is the relative loading. The loading keeps the
+ * Cholesky decomposition stable for nearly rank-deficient covariance
+ * matrices (e.g. a range window smaller than the number of antennas, or a
+ * single dominant target without noise) at the cost of a slightly less sharp
+ * spectrum. The relative change of the spectrum is at most about
+ * \f$\epsilon\,\mathrm{tr}(R)/(N \lambda_{min})\f$, where
+ * \f$\lambda_{min}\f$ is the smallest eigenvalue of \f$R\f$. The default
+ * after \ref ifx_anglecapon_create is `1e-6`, i.e. below `1%` for covariance
+ * matrices with a condition number up to `1e4`. Passing `0` disables the loading; the spectrum is
+ * then the plain MVDR spectrum and covariance matrices which are not
+ * positive definite result in IFX_ERROR_MATRIX_SINGULAR.
+ *
+ * @param [in]     handle              A handle to the AngleCapon object
+ * @param [in]     loading             Relative diagonal loading \f$\epsilon\f$; must not be negative
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_anglecapon_set_diagonal_loading(ifx_AngleCapon_t* handle,
+                                         ifx_Float_t loading);
+
+/**
+ * @brief Clears the recursive covariance history.
+ *
+ * After calling this function the next call to \ref ifx_anglecapon_run_batch
+ * initializes the covariance matrices from the current frame only.
+ *
+ * @param [in]     handle              A handle to the AngleCapon object
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_anglecapon_reset(ifx_AngleCapon_t* handle);
+
 /**
  * @brief Destroys AngleCapon handle (object) to clear internal states and memories.
  *
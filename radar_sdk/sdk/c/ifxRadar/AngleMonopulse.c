@@ -40,6 +40,7 @@
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/SimdMonopulse.h"
 #include "ifxBase/Math.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
@@ -52,6 +53,9 @@
 ==============================================================================
 */
 
+/* number of cells gathered from the cube and processed at once */
+#define BLOCK_SIZE 64
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -66,8 +70,102 @@ struct ifx_AngleMonopulse_s
 {
     ifx_Float_t wavelength;      /**< Wavelength (in units of meters), computed from center frequency and speed of light.*/
     ifx_Float_t antenna_spacing; /**< Physical spacing (in units of meters), between antennas on BGT radar chip.*/
+    ifx_Float_t* phase_offset;   /**< Phase offset in radians per antenna, NULL if not calibrated.*/
+    uint32_t num_phase_offsets;  /**< Number of elements of phase_offset.*/
 };
 
+/**
+ * @brief Cells gathered from the range Doppler cube, interleaved real and imaginary parts.
+ */
+typedef struct
+{
+    float reference[2 * BLOCK_SIZE];
+    float azimuth[2 * BLOCK_SIZE];
+    float elevation[2 * BLOCK_SIZE];
+    float angle[BLOCK_SIZE];
+} Block_t;
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static bool check_antenna(const ifx_AngleMonopulse_t* handle,
+                          const ifx_Cube_C_t* rdm_cube,
+                          uint32_t rx);
+
+static const float* get_calibration(const ifx_AngleMonopulse_t* handle,
+                                    uint32_t rx1,
+                                    uint32_t rx2,
+                                    float factor[2]);
+
+static void gather(const ifx_Cube_C_t* rdm_cube,
+                   uint32_t rx,
+                   const uint32_t* range_bins,
+                   const uint32_t* doppler_bins,
+                   uint32_t num_cells,
+                   float* buffer);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static bool check_antenna(const ifx_AngleMonopulse_t* handle,
+                          const ifx_Cube_C_t* rdm_cube,
+                          uint32_t rx)
+{
+    if (rx >= cSlices(rdm_cube))
+        return false;
+    return handle->phase_offset == NULL || rx < handle->num_phase_offsets;
+}
+
+//----------------------------------------------------------------------------
+
+static const float* get_calibration(const ifx_AngleMonopulse_t* handle,
+                                    uint32_t rx1,
+                                    uint32_t rx2,
+                                    float factor[2])
+{
+    if (handle->phase_offset == NULL)
+        return NULL;
+
+    // phase(rx1) - offset(rx1) - (phase(rx2) - offset(rx2)): rotate by offset(rx2) - offset(rx1)
+    const ifx_Float_t phi = handle->phase_offset[rx2] - handle->phase_offset[rx1];
+    factor[0] = (float)COS(phi);
+    factor[1] = (float)SIN(phi);
+    return factor;
+}
+
+//----------------------------------------------------------------------------
+
+static void gather(const ifx_Cube_C_t* rdm_cube,
+                   uint32_t rx,
+                   const uint32_t* range_bins,
+                   const uint32_t* doppler_bins,
+                   uint32_t num_cells,
+                   float* buffer)
+{
+    const ifx_Complex_t* data = &cAt(rdm_cube, 0, 0, rx);
+    const size_t row_stride = cStride(rdm_cube, 0);
+    const size_t col_stride = cStride(rdm_cube, 1);
+
+    for (uint32_t i = 0; i < num_cells; i++)
+    {
+        const ifx_Complex_t value = data[range_bins[i] * row_stride + doppler_bins[i] * col_stride];
+        buffer[2 * i] = (float)IFX_COMPLEX_REAL(value);
+        buffer[2 * i + 1] = (float)IFX_COMPLEX_IMAG(value);
+    }
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -87,6 +185,9 @@ ifx_AngleMonopulse_t* ifx_anglemonopulse_create(ifx_Float_t wavelength,
 
     h->antenna_spacing = antenna_spacing;
 
+    h->phase_offset = NULL;
+    h->num_phase_offsets = 0;
+
     return h;
 }
 
@@ -99,6 +200,7 @@ void ifx_anglemonopulse_destroy(ifx_AngleMonopulse_t* handle)
         return;
     }
 
+    ifx_mem_free(handle->phase_offset);
     ifx_mem_free(handle);
 }
 
@@ -160,6 +262,169 @@ void ifx_anglemonopulse_vector_run(const ifx_AngleMonopulse_t* handle,
 
 //----------------------------------------------------------------------------
 
+void ifx_anglemonopulse_cells_run(const ifx_AngleMonopulse_t* handle,
+                                  const ifx_Cube_C_t* rdm_cube,
+                                  const ifx_AngleMonopulse_Antennas_t* antennas,
+                                  const uint32_t* range_bins,
+                                  const uint32_t* doppler_bins,
+                                  uint32_t num_cells,
+                                  ifx_Vector_R_t* azimuth_deg,
+                                  ifx_Vector_R_t* elevation_deg)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(rdm_cube);
+    IFX_ERR_BRK_NULL(antennas);
+    IFX_ERR_BRK_ARGUMENT(num_cells > 0 && (range_bins == NULL || doppler_bins == NULL));
+    IFX_ERR_BRK_ARGUMENT(!check_antenna(handle, rdm_cube, antennas->rx_reference));
+    if (azimuth_deg)
+    {
+        IFX_VEC_BRK_VALID(azimuth_deg);
+        IFX_ERR_BRK_COND(vLen(azimuth_deg) < num_cells, IFX_ERROR_DIMENSION_MISMATCH);
+        IFX_ERR_BRK_ARGUMENT(!check_antenna(handle, rdm_cube, antennas->rx_azimuth));
+    }
+    if (elevation_deg)
+    {
+        IFX_VEC_BRK_VALID(elevation_deg);
+        IFX_ERR_BRK_COND(vLen(elevation_deg) < num_cells, IFX_ERROR_DIMENSION_MISMATCH);
+        IFX_ERR_BRK_ARGUMENT(!check_antenna(handle, rdm_cube, antennas->rx_elevation));
+    }
+    for (uint32_t i = 0; i < num_cells; i++)
+    {
+        IFX_ERR_BRK_COND(range_bins[i] >= cRows(rdm_cube) || doppler_bins[i] >= cCols(rdm_cube),
+                         IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    }
+
+    const ifx_Simd_Monopulse_Kernels_t* kernels = ifx_simd_monopulse_kernels();
+    const float scale = (float)(handle->wavelength / (2 * IFX_PI * handle->antenna_spacing));
+    float azimuth_factor[2], elevation_factor[2];
+    const float* azimuth_calibration = get_calibration(handle, antennas->rx_azimuth, antennas->rx_reference, azimuth_factor);
+    const float* elevation_calibration = get_calibration(handle, antennas->rx_elevation, antennas->rx_reference, elevation_factor);
+
+    Block_t block;
+    for (uint32_t first = 0; first < num_cells; first += BLOCK_SIZE)
+    {
+        const uint32_t count = MIN(num_cells - first, BLOCK_SIZE);
+
+        gather(rdm_cube, antennas->rx_reference, &range_bins[first], &doppler_bins[first], count, block.reference);
+
+        if (azimuth_deg)
+        {
+            gather(rdm_cube, antennas->rx_azimuth, &range_bins[first], &doppler_bins[first], count, block.azimuth);
+            kernels->monopulse_c(block.azimuth, block.reference, azimuth_calibration, scale, block.angle, count);
+            for (uint32_t i = 0; i < count; i++)
+                vAt(azimuth_deg, first + i) = block.angle[i];
+        }
+
+        if (elevation_deg)
+        {
+            gather(rdm_cube, antennas->rx_elevation, &range_bins[first], &doppler_bins[first], count, block.elevation);
+            kernels->monopulse_c(block.elevation, block.reference, elevation_calibration, scale, block.angle, count);
+            for (uint32_t i = 0; i < count; i++)
+                vAt(elevation_deg, first + i) = block.angle[i];
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_anglemonopulse_map_run(const ifx_AngleMonopulse_t* handle,
+                                const ifx_Cube_C_t* rdm_cube,
+                                const ifx_AngleMonopulse_Antennas_t* antennas,
+                                ifx_Matrix_R_t* azimuth_deg,
+                                ifx_Matrix_R_t* elevation_deg)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(rdm_cube);
+    IFX_ERR_BRK_NULL(antennas);
+    IFX_ERR_BRK_ARGUMENT(!check_antenna(handle, rdm_cube, antennas->rx_reference));
+    if (azimuth_deg)
+    {
+        IFX_MAT_BRK_VALID(azimuth_deg);
+        IFX_ERR_BRK_COND(mRows(azimuth_deg) != cRows(rdm_cube) || mCols(azimuth_deg) != cCols(rdm_cube),
+                         IFX_ERROR_DIMENSION_MISMATCH);
+        IFX_ERR_BRK_ARGUMENT(!check_antenna(handle, rdm_cube, antennas->rx_azimuth));
+    }
+    if (elevation_deg)
+    {
+        IFX_MAT_BRK_VALID(elevation_deg);
+        IFX_ERR_BRK_COND(mRows(elevation_deg) != cRows(rdm_cube) || mCols(elevation_deg) != cCols(rdm_cube),
+                         IFX_ERROR_DIMENSION_MISMATCH);
+        IFX_ERR_BRK_ARGUMENT(!check_antenna(handle, rdm_cube, antennas->rx_elevation));
+    }
+
+    const ifx_Simd_Monopulse_Kernels_t* kernels = ifx_simd_monopulse_kernels();
+    const float scale = (float)(handle->wavelength / (2 * IFX_PI * handle->antenna_spacing));
+    float azimuth_factor[2], elevation_factor[2];
+    const float* azimuth_calibration = get_calibration(handle, antennas->rx_azimuth, antennas->rx_reference, azimuth_factor);
+    const float* elevation_calibration = get_calibration(handle, antennas->rx_elevation, antennas->rx_reference, elevation_factor);
+
+    // the map is processed in blocks of one row, so the column indices are the same for all blocks
+    uint32_t doppler_bins[BLOCK_SIZE];
+    uint32_t range_bins[BLOCK_SIZE];
+
+    Block_t block;
+    for (uint32_t r = 0; r < cRows(rdm_cube); r++)
+    {
+        for (uint32_t first = 0; first < cCols(rdm_cube); first += BLOCK_SIZE)
+        {
+            const uint32_t count = MIN(cCols(rdm_cube) - first, BLOCK_SIZE);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                range_bins[i] = r;
+                doppler_bins[i] = first + i;
+            }
+
+            gather(rdm_cube, antennas->rx_reference, range_bins, doppler_bins, count, block.reference);
+
+            if (azimuth_deg)
+            {
+                gather(rdm_cube, antennas->rx_azimuth, range_bins, doppler_bins, count, block.azimuth);
+                kernels->monopulse_c(block.azimuth, block.reference, azimuth_calibration, scale, block.angle, count);
+                for (uint32_t i = 0; i < count; i++)
+                    mAt(azimuth_deg, r, first + i) = block.angle[i];
+            }
+
+            if (elevation_deg)
+            {
+                gather(rdm_cube, antennas->rx_elevation, range_bins, doppler_bins, count, block.elevation);
+                kernels->monopulse_c(block.elevation, block.reference, elevation_calibration, scale, block.angle, count);
+                for (uint32_t i = 0; i < count; i++)
+                    mAt(elevation_deg, r, first + i) = block.angle[i];
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_anglemonopulse_set_phase_calibration(ifx_AngleMonopulse_t* handle,
+                                              const ifx_Vector_R_t* phase_offset_rad)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    if (phase_offset_rad == NULL)
+    {
+        ifx_mem_free(handle->phase_offset);
+        handle->phase_offset = NULL;
+        handle->num_phase_offsets = 0;
+        return;
+    }
+
+    IFX_VEC_BRK_VALID(phase_offset_rad);
+
+    ifx_Float_t* phase_offset = ifx_mem_alloc(sizeof(ifx_Float_t) * vLen(phase_offset_rad));
+    IFX_ERR_BRK_MEMALLOC(phase_offset);
+
+    for (uint32_t i = 0; i < vLen(phase_offset_rad); i++)
+        phase_offset[i] = vAt(phase_offset_rad, i);
+
+    ifx_mem_free(handle->phase_offset);
+    handle->phase_offset = phase_offset;
+    handle->num_phase_offsets = vLen(phase_offset_rad);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_anglemonopulse_set_wavelength(ifx_AngleMonopulse_t* handle,
                                        ifx_Float_t wavelength)
 {
@@ -45,6 +45,8 @@
 */
 
 #include "ifxBase/Complex.h"
+#include "ifxBase/Cube.h"
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Types.h"
 #include "ifxBase/Vector.h"
 
@@ -72,6 +74,25 @@ extern "C"
  */
 typedef struct ifx_AngleMonopulse_s ifx_AngleMonopulse_t;
 
+/**
+ * @brief Antennas of an L-shaped array used for azimuth and elevation estimation.
+ *
+ * The antennas are given as slice indices of the range Doppler cube. The
+ * azimuth is computed from rx_azimuth and rx_reference, the elevation from
+ * rx_elevation and rx_reference, in the same way as
+ * \ref ifx_anglemonopulse_scalar_run with rx1 = rx_azimuth (or rx_elevation)
+ * and rx2 = rx_reference.
+ *
+ * For BGT60TR13C with RX1, RX2 and RX3 in the slices 0, 1 and 2 use
+ * rx_reference = 2, rx_azimuth = 0 and rx_elevation = 1.
+ */
+typedef struct
+{
+    uint32_t rx_reference; /**< Antenna in the corner of the L.*/
+    uint32_t rx_azimuth;   /**< Antenna next to rx_reference in horizontal direction.*/
+    uint32_t rx_elevation; /**< Antenna next to rx_reference in vertical direction.*/
+} ifx_AngleMonopulse_Antennas_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -97,6 +118,16 @@ typedef struct ifx_AngleMonopulse_s ifx_AngleMonopulse_t;
  * Interface provides as output:
  * - vector of angles in degrees for each row (target) the two input vectors
  *
+ * For many targets or whole range Doppler maps use \ref ifx_anglemonopulse_cells_run
+ * and \ref ifx_anglemonopulse_map_run. They read the cells directly from the
+ * range Doppler cube, compute azimuth and elevation for L-shaped antenna arrays
+ * in one call and apply the phase calibration set by
+ * \ref ifx_anglemonopulse_set_phase_calibration. Instead of the math library
+ * they use vectorized polynomial approximations of atan2 and asin. The phase
+ * difference has an absolute error of about 1e-7 rad, the angle an error
+ * below 1e-3 degrees. Phase differences that do not correspond to a physical
+ * angle are clipped to +/-90 degrees.
+ *
  * @{
  */
 
@@ -155,6 +186,70 @@ void ifx_anglemonopulse_vector_run(const ifx_AngleMonopulse_t* handle,
                                    const ifx_Vector_C_t* rx2,
                                    ifx_Vector_R_t* target_angle_deg);
 
+/**
+ * @brief Computes azimuth and elevation for a list of cells of a range Doppler cube.
+ *
+ * The cube has the dimensions range bins x Doppler bins x antennas (see
+ * \ref ifx_rai_get_rx_spectrum). Cell i is (range_bins[i], doppler_bins[i]).
+ *
+ * @param [in]     handle              A handle to the angle monopulse object
+ * @param [in]     rdm_cube            Range Doppler cube
+ * @param [in]     antennas            Antennas used for azimuth and elevation
+ * @param [in]     range_bins          Range bin (row) of each cell
+ * @param [in]     doppler_bins        Doppler bin (column) of each cell
+ * @param [in]     num_cells           Number of cells
+ * @param [out]    azimuth_deg         Azimuth in degrees per cell, may be NULL
+ * @param [out]    elevation_deg       Elevation in degrees per cell, may be NULL
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_anglemonopulse_cells_run(const ifx_AngleMonopulse_t* handle,
+                                  const ifx_Cube_C_t* rdm_cube,
+                                  const ifx_AngleMonopulse_Antennas_t* antennas,
+                                  const uint32_t* range_bins,
+                                  const uint32_t* doppler_bins,
+                                  uint32_t num_cells,
+                                  ifx_Vector_R_t* azimuth_deg,
+                                  ifx_Vector_R_t* elevation_deg);
+
+/**
+ * @brief Computes azimuth and elevation for every cell of a range Doppler cube.
+ *
+ * The cube has the dimensions range bins x Doppler bins x antennas (see
+ * \ref ifx_rai_get_rx_spectrum). The outputs have one row per range bin and
+ * one column per Doppler bin.
+ *
+ * @param [in]     handle              A handle to the angle monopulse object
+ * @param [in]     rdm_cube            Range Doppler cube
+ * @param [in]     antennas            Antennas used for azimuth and elevation
+ * @param [out]    azimuth_deg         Azimuth map in degrees, may be NULL
+ * @param [out]    elevation_deg       Elevation map in degrees, may be NULL
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_anglemonopulse_map_run(const ifx_AngleMonopulse_t* handle,
+                                const ifx_Cube_C_t* rdm_cube,
+                                const ifx_AngleMonopulse_Antennas_t* antennas,
+                                ifx_Matrix_R_t* azimuth_deg,
+                                ifx_Matrix_R_t* elevation_deg);
+
+/**
+ * @brief Sets the phase offset of each antenna for \ref ifx_anglemonopulse_cells_run
+ *        and \ref ifx_anglemonopulse_map_run.
+ *
+ * The phase offset of an antenna is subtracted from the phase of its signal
+ * before the phase difference is computed. Element i of phase_offset_rad
+ * belongs to slice i of the range Doppler cube. Pass NULL to disable the
+ * calibration.
+ *
+ * @param [in]     handle              A handle to the angle monopulse object
+ * @param [in]     phase_offset_rad    Phase offset per antenna in radians, or NULL
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_anglemonopulse_set_phase_calibration(ifx_AngleMonopulse_t* handle,
+                                              const ifx_Vector_R_t* phase_offset_rad);
+
 /**
  * @brief Sets the new value of wavelength used in angle calculation
  *
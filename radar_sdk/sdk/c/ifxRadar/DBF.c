@@ -37,6 +37,7 @@
 #include "ifxBase/Cube.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/Metrics.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
@@ -156,6 +157,8 @@ void ifx_dbf_run_c(ifx_DBF_t* handle,
     IFX_ERR_BRK_ARGUMENT(IFX_CUBE_COLS(rng_dopp_spectrum) != IFX_CUBE_COLS(rng_dopp_image_beam));
     IFX_ERR_BRK_ARGUMENT(IFX_MAT_COLS(handle->weights) != IFX_CUBE_SLICES(rng_dopp_image_beam));
 
+    const uint64_t metrics_start = ifx_metrics_begin();
+
     ifx_Matrix_C_t rd_spec_view;
     ifx_Matrix_C_t rdi_beam_view;
 
@@ -177,6 +180,8 @@ void ifx_dbf_run_c(ifx_DBF_t* handle,
             ifx_mat_mac_c(&rdi_beam_view, &rd_spec_view, IFX_MAT_AT(handle->weights, (size_t)ant - 1, beam), &rdi_beam_view);
         }
     }
+
+    ifx_metrics_end(IFX_METRICS_STAGE_DBF, metrics_start);
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,478 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "ifxAlgo/FFT.h"
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Simd.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/Vector.h"
+
+#include "MicroDoppler.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// Lower bound of the clipping level to keep the logarithm finite for
+// segments without any signal.
+#define MICRODOPPLER_MIN_AMPLITUDE (1e-12f)
+
+/* true if the segment can be passed to the SIMD kernels */
+#define USE_SIMD_KERNELS (sizeof(ifx_Float_t) == sizeof(float))
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Source position of an output pixel along one axis for bilinear interpolation.
+ */
+typedef struct
+{
+    uint32_t index0;    /**< Index of the left (upper) neighbour.*/
+    uint32_t index1;    /**< Index of the right (lower) neighbour.*/
+    ifx_Float_t weight; /**< Weight of index1, the weight of index0 is 1 - weight.*/
+} Resize_Tap_t;
+
+/**
+ * @brief Segment history of a single radar.
+ */
+typedef struct
+{
+    ifx_Float_t* history;         /**< Ring buffer of segment_length slices of num_doppler_bins values.*/
+    uint32_t next;                /**< Index of the slice written next, which is also the oldest slice.*/
+    uint32_t frames_until_output; /**< Number of frames until the next segment is due.*/
+} Radar_State_t;
+
+/**
+ * @brief Defines the structure for micro-Doppler module processing.
+ *        Use type ifx_MicroDoppler_t for this struct.
+ */
+struct ifx_MicroDoppler_s
+{
+    uint32_t num_radars;               /**< Number of radars.*/
+    uint32_t num_doppler_bins;         /**< Number of values per slice (Doppler FFT size).*/
+    uint32_t range_bin_start;          /**< First range bin of the range gate.*/
+    uint32_t range_bin_end;            /**< Range bin after the last range bin of the range gate.*/
+    uint32_t segment_length;           /**< Number of frames in a segment.*/
+    uint32_t hop_size;                 /**< Number of frames between two consecutive segments.*/
+    ifx_Float_t clip_min_factor;       /**< Lower clipping level relative to maximum of segment.*/
+    ifx_Float_t clip_max_factor;       /**< Upper clipping level relative to maximum of segment.*/
+    ifx_Float_t log_scale;             /**< Scale factor of log10.*/
+    uint32_t output_rows;              /**< Number of rows of the output image (Doppler axis).*/
+    uint32_t output_columns;           /**< Number of columns of the output image (time axis).*/
+
+    ifx_PPFFT_t* range_ppfft_handle;   /**< Preprocessed FFT handle for range FFT.*/
+    ifx_PPFFT_t* doppler_ppfft_handle; /**< Preprocessed FFT handle for Doppler FFT.*/
+    ifx_Matrix_R_t* frame_sum;         /**< Sum of the frame over all antennas (chirps x samples).*/
+    ifx_Vector_C_t* range_spectrum;    /**< Positive half of the range spectrum of a chirp.*/
+    ifx_Vector_C_t* gated_spectrum;    /**< Sum over range gate for each chirp (slow time signal).*/
+    ifx_Vector_C_t* doppler_spectrum;  /**< Result of Doppler FFT.*/
+    ifx_Float_t* segment;              /**< Segment in time order (segment_length x num_doppler_bins).*/
+    ifx_Float_t* resized_rows;         /**< Segment resized along Doppler axis (output_rows x segment_length).*/
+    Resize_Tap_t* row_taps;            /**< Interpolation taps along Doppler axis (output_rows).*/
+    Resize_Tap_t* column_taps;         /**< Interpolation taps along time axis (output_columns).*/
+    Radar_State_t* radars;             /**< Segment history of each radar (num_radars).*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @brief Computes interpolation taps for resizing an axis from in_size to out_size.
+ *
+ * Pixel centers are aligned, i.e. output pixel i maps to the input position
+ * (i + 0.5) * in_size / out_size - 0.5. Positions outside of the input are
+ * clamped to the first and last input pixel.
+ */
+static void init_taps(uint32_t in_size, uint32_t out_size, Resize_Tap_t* taps);
+
+/**
+ * @brief Adds a frame to the history of a radar.
+ */
+static void add_slice(ifx_MicroDoppler_t* handle, Radar_State_t* state, const ifx_Cube_R_t* frame);
+
+/**
+ * @brief Converts the history of a radar into the output image.
+ */
+static void build_image(ifx_MicroDoppler_t* handle, const Radar_State_t* state, ifx_Float_t* output);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static void init_taps(uint32_t in_size, uint32_t out_size, Resize_Tap_t* taps)
+{
+    const double ratio = (double)in_size / out_size;
+
+    for (uint32_t i = 0; i < out_size; i++)
+    {
+        double pos = (i + 0.5) * ratio - 0.5;
+        if (pos < 0)
+            pos = 0;
+
+        uint32_t index0 = (uint32_t)pos;
+        if (index0 >= in_size - 1)
+        {
+            taps[i].index0 = taps[i].index1 = in_size - 1;
+            taps[i].weight = 0;
+        }
+        else
+        {
+            taps[i].index0 = index0;
+            taps[i].index1 = index0 + 1;
+            taps[i].weight = (ifx_Float_t)(pos - index0);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void add_slice(ifx_MicroDoppler_t* handle, Radar_State_t* state, const ifx_Cube_R_t* frame)
+{
+    // sum over all antennas
+    ifx_Matrix_R_t antenna;
+    ifx_cube_get_row_r(frame, 0, &antenna);
+    ifx_mat_copy_r(&antenna, handle->frame_sum);
+
+    for (uint32_t rx = 1; rx < cRows(frame); rx++)
+    {
+        ifx_cube_get_row_r(frame, rx, &antenna);
+        ifx_mat_add_r(handle->frame_sum, &antenna, handle->frame_sum);
+    }
+
+    // range FFT for all chirps and sum over the range gate
+    ifx_Vector_C_t gate;
+    ifx_vec_rawview_c(&gate, vDat(handle->range_spectrum) + handle->range_bin_start,
+                      handle->range_bin_end - handle->range_bin_start, 1);
+
+    for (uint32_t chirp = 0; chirp < mRows(handle->frame_sum); chirp++)
+    {
+        ifx_Vector_R_t chirp_data;
+        ifx_mat_get_rowview_r(handle->frame_sum, chirp, &chirp_data);
+
+        ifx_ppfft_run_rc(handle->range_ppfft_handle, &chirp_data, handle->range_spectrum);
+
+        vAt(handle->gated_spectrum, chirp) = ifx_vec_sum_c(&gate);
+    }
+
+    // Doppler FFT, the magnitude of the shifted spectrum is the new slice
+    ifx_ppfft_run_c(handle->doppler_ppfft_handle, handle->gated_spectrum, handle->doppler_spectrum);
+
+    ifx_fft_shift_c(handle->doppler_spectrum, handle->doppler_spectrum);
+
+    ifx_Vector_R_t slice;
+    ifx_vec_rawview_r(&slice, state->history + (size_t)state->next * handle->num_doppler_bins,
+                      handle->num_doppler_bins, 1);
+    ifx_vec_abs_c(handle->doppler_spectrum, &slice);
+
+    state->next = (state->next + 1) % handle->segment_length;
+}
+
+//----------------------------------------------------------------------------
+
+static void build_image(ifx_MicroDoppler_t* handle, const Radar_State_t* state, ifx_Float_t* output)
+{
+    const uint32_t bins = handle->num_doppler_bins;
+    const uint32_t length = handle->segment_length;
+    const size_t size = (size_t)length * bins;
+
+    // copy the history in time order, the oldest slice is the next one to be overwritten
+    const size_t head = (size_t)state->next * bins;
+    memcpy(handle->segment, state->history + head, (size - head) * sizeof(ifx_Float_t));
+    memcpy(handle->segment + (size - head), state->history, head * sizeof(ifx_Float_t));
+
+    // clip relative to the maximum of the segment and convert to logarithmic scale
+    ifx_Float_t max_value = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (handle->segment[i] > max_value)
+            max_value = handle->segment[i];
+    }
+
+    ifx_Float_t min_clip = MAX(max_value * handle->clip_min_factor, MICRODOPPLER_MIN_AMPLITUDE);
+    ifx_Float_t max_clip = MAX(max_value * handle->clip_max_factor, min_clip);
+
+    if (USE_SIMD_KERNELS)
+    {
+        const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+        float* segment = (float*)handle->segment;
+
+        kernels->clip_r(segment, min_clip, max_clip, segment, size);
+        kernels->pow2db_r(segment, handle->log_scale, min_clip, handle->log_scale * log10f(min_clip), size);
+    }
+    else
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            const ifx_Float_t value = MIN(MAX(handle->segment[i], min_clip), max_clip);
+            handle->segment[i] = handle->log_scale * log10f(value);
+        }
+    }
+
+    // bilinear resize, first along the Doppler axis (transposing time to the
+    // columns), then along the time axis
+    for (uint32_t t = 0; t < length; t++)
+    {
+        const ifx_Float_t* slice = handle->segment + (size_t)t * bins;
+
+        for (uint32_t r = 0; r < handle->output_rows; r++)
+        {
+            const Resize_Tap_t* tap = &handle->row_taps[r];
+            const ifx_Float_t v0 = slice[tap->index0];
+            const ifx_Float_t v1 = slice[tap->index1];
+
+            handle->resized_rows[(size_t)r * length + t] = v0 + tap->weight * (v1 - v0);
+        }
+    }
+
+    for (uint32_t r = 0; r < handle->output_rows; r++)
+    {
+        const ifx_Float_t* row = handle->resized_rows + (size_t)r * length;
+        ifx_Float_t* out = output + (size_t)r * handle->output_columns;
+
+        for (uint32_t c = 0; c < handle->output_columns; c++)
+        {
+            const Resize_Tap_t* tap = &handle->column_taps[c];
+            const ifx_Float_t v0 = row[tap->index0];
+            const ifx_Float_t v1 = row[tap->index1];
+
+            out[c] = v0 + tap->weight * (v1 - v0);
+        }
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_MicroDoppler_t* ifx_microdoppler_create(const ifx_MicroDoppler_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->num_radars == 0);
+    IFX_ERR_BRN_ARGUMENT(config->range_fft_config.fft_type != IFX_FFT_TYPE_R2C);
+    IFX_ERR_BRN_ARGUMENT(config->doppler_fft_config.fft_type != IFX_FFT_TYPE_C2C);
+    IFX_ERR_BRN_ARGUMENT(config->range_fft_config.window_config.size == 0);
+    IFX_ERR_BRN_ARGUMENT(config->doppler_fft_config.window_config.size == 0);
+    IFX_ERR_BRN_ARGUMENT(config->segment_length == 0);
+    IFX_ERR_BRN_ARGUMENT(config->hop_size == 0 || config->hop_size > config->segment_length);
+    IFX_ERR_BRN_ARGUMENT(config->output_rows == 0 || config->output_columns == 0);
+    IFX_ERR_BRN_ARGUMENT(config->log_scale == 0);
+    IFX_ERR_BRN_COND(config->clip_min_factor < 0 || config->clip_max_factor < config->clip_min_factor,
+                     IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    const uint32_t range_bins = config->range_fft_config.fft_size / 2;
+    const uint32_t range_bin_end = config->range_bin_end ? config->range_bin_end : range_bins;
+    IFX_ERR_BRN_COND(range_bin_end > range_bins || config->range_bin_start >= range_bin_end,
+                     IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ifx_MicroDoppler_t* h = ifx_mem_calloc(1, sizeof(struct ifx_MicroDoppler_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->num_radars = config->num_radars;
+    h->num_doppler_bins = config->doppler_fft_config.fft_size;
+    h->range_bin_start = config->range_bin_start;
+    h->range_bin_end = range_bin_end;
+    h->segment_length = config->segment_length;
+    h->hop_size = config->hop_size;
+    h->clip_min_factor = config->clip_min_factor;
+    h->clip_max_factor = config->clip_max_factor;
+    h->log_scale = config->log_scale;
+    h->output_rows = config->output_rows;
+    h->output_columns = config->output_columns;
+
+    IFX_ERR_HANDLE_N(h->range_ppfft_handle = ifx_ppfft_create(&config->range_fft_config),
+                     ifx_microdoppler_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->doppler_ppfft_handle = ifx_ppfft_create(&config->doppler_fft_config),
+                     ifx_microdoppler_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->frame_sum = ifx_mat_create_r(config->doppler_fft_config.window_config.size,
+                                                     config->range_fft_config.window_config.size),
+                     ifx_microdoppler_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->range_spectrum = ifx_vec_create_c(range_bins),
+                     ifx_microdoppler_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->gated_spectrum = ifx_vec_create_c(config->doppler_fft_config.window_config.size),
+                     ifx_microdoppler_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->doppler_spectrum = ifx_vec_create_c(h->num_doppler_bins),
+                     ifx_microdoppler_destroy(h));
+
+    const size_t segment_size = (size_t)h->segment_length * h->num_doppler_bins;
+
+    h->segment = ifx_mem_alloc(segment_size * sizeof(ifx_Float_t));
+    IFX_ERR_BRF_MEMALLOC(h->segment);
+
+    h->resized_rows = ifx_mem_alloc((size_t)h->output_rows * h->segment_length * sizeof(ifx_Float_t));
+    IFX_ERR_BRF_MEMALLOC(h->resized_rows);
+
+    h->row_taps = ifx_mem_alloc(h->output_rows * sizeof(Resize_Tap_t));
+    IFX_ERR_BRF_MEMALLOC(h->row_taps);
+
+    h->column_taps = ifx_mem_alloc(h->output_columns * sizeof(Resize_Tap_t));
+    IFX_ERR_BRF_MEMALLOC(h->column_taps);
+
+    init_taps(h->num_doppler_bins, h->output_rows, h->row_taps);
+    init_taps(h->segment_length, h->output_columns, h->column_taps);
+
+    h->radars = ifx_mem_calloc(h->num_radars, sizeof(Radar_State_t));
+    IFX_ERR_BRF_MEMALLOC(h->radars);
+
+    for (uint32_t i = 0; i < h->num_radars; i++)
+    {
+        h->radars[i].history = ifx_mem_alloc(segment_size * sizeof(ifx_Float_t));
+        IFX_ERR_BRF_MEMALLOC(h->radars[i].history);
+
+        ifx_microdoppler_reset(h, i);
+    }
+
+    return h;
+
+fail:
+    ifx_microdoppler_destroy(h);
+    return NULL;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_microdoppler_destroy(ifx_MicroDoppler_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_ppfft_destroy(handle->range_ppfft_handle);
+    ifx_ppfft_destroy(handle->doppler_ppfft_handle);
+
+    ifx_mat_destroy_r(handle->frame_sum);
+    ifx_vec_destroy_c(handle->range_spectrum);
+    ifx_vec_destroy_c(handle->gated_spectrum);
+    ifx_vec_destroy_c(handle->doppler_spectrum);
+
+    ifx_mem_free(handle->segment);
+    ifx_mem_free(handle->resized_rows);
+    ifx_mem_free(handle->row_taps);
+    ifx_mem_free(handle->column_taps);
+
+    if (handle->radars)
+    {
+        for (uint32_t i = 0; i < handle->num_radars; i++)
+            ifx_mem_free(handle->radars[i].history);
+
+        ifx_mem_free(handle->radars);
+    }
+
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_microdoppler_run_r(ifx_MicroDoppler_t* handle,
+                            uint32_t radar,
+                            const ifx_Cube_R_t* frame,
+                            ifx_Float_t* output)
+{
+    IFX_ERR_BRV_NULL(handle, false);
+    IFX_CUBE_BRV_VALID(frame, false);
+    IFX_ERR_BRV_COND(radar >= handle->num_radars, IFX_ERROR_INDEX_OUT_OF_BOUNDS, false);
+    IFX_ERR_BRV_COND(cRows(frame) == 0
+                         || cCols(frame) != mRows(handle->frame_sum)
+                         || cSlices(frame) != mCols(handle->frame_sum),
+                     IFX_ERROR_DIMENSION_MISMATCH, false);
+
+    Radar_State_t* state = &handle->radars[radar];
+
+    add_slice(handle, state, frame);
+
+    if (--state->frames_until_output > 0)
+        return false;
+
+    state->frames_until_output = handle->hop_size;
+
+    if (output == NULL)
+        return false;
+
+    build_image(handle, state, output);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_microdoppler_reset(ifx_MicroDoppler_t* handle, uint32_t radar)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_COND(radar >= handle->num_radars, IFX_ERROR_INDEX_OUT_OF_BOUNDS);
+
+    Radar_State_t* state = &handle->radars[radar];
+
+    memset(state->history, 0, (size_t)handle->segment_length * handle->num_doppler_bins * sizeof(ifx_Float_t));
+    state->next = 0;
+    state->frames_until_output = handle->segment_length;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_microdoppler_get_num_doppler_bins(const ifx_MicroDoppler_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+
+    return handle->num_doppler_bins;
+}
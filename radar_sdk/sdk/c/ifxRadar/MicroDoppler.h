@@ -0,0 +1,221 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file MicroDoppler.h
+ *
+ * \brief \copybrief gr_microdoppler
+ *
+ * For details refer to \ref gr_microdoppler
+ */
+
+#ifndef IFX_RADAR_MICRODOPPLER_H
+#define IFX_RADAR_MICRODOPPLER_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxAlgo/PreprocessedFFT.h"
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief A handle for an instance of the micro-Doppler module, see MicroDoppler.h.
+ */
+typedef struct ifx_MicroDoppler_s ifx_MicroDoppler_t;
+
+/**
+ * @brief Defines the structure for micro-Doppler module related settings.
+ */
+typedef struct
+{
+    uint32_t num_radars;                   /**< Number of radars, each radar has its own segment history.*/
+    ifx_PPFFT_Config_t range_fft_config;   /**< Preprocessed FFT settings for range FFT. The window size is the
+                                                number of samples per chirp, the FFT type must be \ref IFX_FFT_TYPE_R2C.*/
+    ifx_PPFFT_Config_t doppler_fft_config; /**< Preprocessed FFT settings for Doppler FFT. The window size is the
+                                                number of chirps per frame, the FFT type must be \ref IFX_FFT_TYPE_C2C.*/
+    uint32_t range_bin_start;              /**< First range bin of the range gate.*/
+    uint32_t range_bin_end;                /**< Range bin after the last range bin of the range gate. If 0, the range
+                                                gate ends at the last bin of the positive half of the range spectrum.*/
+    uint32_t segment_length;               /**< Number of frames in a segment (e.g. 128).*/
+    uint32_t hop_size;                     /**< Number of frames between two consecutive segments. Must not exceed
+                                                segment_length. A value of segment_length / 2 gives segments
+                                                overlapping by 50%.*/
+    ifx_Float_t clip_min_factor;           /**< Lower clipping level relative to the maximum of the segment, e.g. 1e-4.*/
+    ifx_Float_t clip_max_factor;           /**< Upper clipping level relative to the maximum of the segment, e.g. 1.*/
+    ifx_Float_t log_scale;                 /**< Output is log_scale * log10(amplitude): 1 gives log10, 20 gives dB.*/
+    uint32_t output_rows;                  /**< Number of rows (Doppler axis) of the output image, e.g. 128.*/
+    uint32_t output_columns;               /**< Number of columns (time axis) of the output image, e.g. 128.*/
+} ifx_MicroDoppler_Config_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Radar
+ * @{
+ */
+
+/** @defgroup gr_microdoppler Micro-Doppler
+ * @brief API for range-gated micro-Doppler segments
+ *
+ * The module computes one micro-Doppler slice per frame and collects the
+ * slices of the last segment_length frames into a segment. Every hop_size
+ * frames (once the first segment is complete) the segment is converted into
+ * an image ready for inference, e.g. by a CNN for fall detection.
+ *
+ * Block level signal processing per frame looks like following;
+ *
+ * Raw Data Cube => Sum over antennas => Range FFT for all chirps => Sum over range gate => Doppler FFT => FFT Shift => Absolute
+ *
+ * Block level signal processing per segment looks like following;
+ *
+ * Segment => Clipping relative to maximum => Logarithm => Bilinear resize
+ *
+ * Summing the complex range spectrum over the range gate before the Doppler
+ * FFT is equivalent to summing the complex Doppler spectra of all range bins
+ * of the gate, but requires only a single Doppler FFT per frame.
+ *
+ * Output format:
+ * - The output is a row-major float image of output_rows x output_columns.
+ * - Rows are the Doppler axis with the most negative velocity in the first
+ *   row (FFT shifted spectrum).
+ * - Columns are the time axis with the oldest frame in the first column.
+ * - The resize uses bilinear interpolation with pixel centers aligned
+ *   (like e.g. skimage.transform.resize) and clamped edges.
+ *
+ * Several radars can share one handle. Each radar has its own segment
+ * history, while FFT plans, windows and scratch buffers are shared. Frames
+ * of different radars must therefore not be processed concurrently on the
+ * same handle.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a micro-Doppler handle (object) based on the input parameters.
+ *
+ * @param [in]     config    Contains configuration of the module, see \ref ifx_MicroDoppler_Config_t.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_MicroDoppler_t* ifx_microdoppler_create(const ifx_MicroDoppler_Config_t* config);
+
+/**
+ * @brief Performs destruction of micro-Doppler handle (object) to clear internal states and memories.
+ *
+ * @param [in]     handle    A handle to the micro-Doppler object
+ */
+IFX_DLL_PUBLIC
+void ifx_microdoppler_destroy(ifx_MicroDoppler_t* handle);
+
+/**
+ * @brief Processes one frame of a radar and writes a segment if one is due.
+ *
+ * The frame is added to the segment history of the radar. If the history
+ * contains a complete segment and hop_size frames were added since the last
+ * segment (or the segment is the first one), the segment is converted into
+ * an image and written to output.
+ *
+ * @param [in]     handle    A handle to the micro-Doppler object.
+ * @param [in]     radar     Index of the radar (0 <= radar < num_radars).
+ * @param [in]     frame     Real time domain data with rows as antennas,
+ *                           columns as chirps and slices as samples per chirp
+ *                           (as returned by ifx_avian_get_next_frame).
+ * @param [out]    output    Float buffer of output_rows * output_columns
+ *                           elements. Only written if a segment is returned.
+ *                           May be NULL to only update the history.
+ *
+ * @retval true    if a segment was written to output
+ * @retval false   otherwise
+ */
+IFX_DLL_PUBLIC
+bool ifx_microdoppler_run_r(ifx_MicroDoppler_t* handle,
+                            uint32_t radar,
+                            const ifx_Cube_R_t* frame,
+                            ifx_Float_t* output);
+
+/**
+ * @brief Clears the segment history of a radar.
+ *
+ * @param [in]     handle    A handle to the micro-Doppler object.
+ * @param [in]     radar     Index of the radar (0 <= radar < num_radars).
+ */
+IFX_DLL_PUBLIC
+void ifx_microdoppler_reset(ifx_MicroDoppler_t* handle, uint32_t radar);
+
+/**
+ * @brief Returns the number of Doppler bins of a slice (the Doppler FFT size).
+ *
+ * @param [in]     handle    A handle to the micro-Doppler object.
+ *
+ * @return Number of Doppler bins.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_microdoppler_get_num_doppler_bins(const ifx_MicroDoppler_t* handle);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_RADAR_MICRODOPPLER_H */
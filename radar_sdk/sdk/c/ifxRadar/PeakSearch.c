@@ -33,11 +33,13 @@
 ==============================================================================
 */
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "ifxBase/Error.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Simd.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
 
@@ -49,6 +51,9 @@
 ==============================================================================
 */
 
+/* true if the elements of the vector can be passed to the SIMD kernels */
+#define VEC_CONTIGUOUS(v) (vStride(v) == 1 && sizeof(ifx_Float_t) == sizeof(float))
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -90,6 +95,18 @@ struct ifx_Peak_Search_s
                                         The size of this vector is equal to peak_count.*/
     ifx_Float_t* peak_val;         /**< This gives the values of the peaks identified in the input data set as a vector.
                                         The size of this vector is equal to peak_count.*/
+    ifx_Peak_Interpolation_t interpolation;   /**< Sub-bin interpolation of the row search.*/
+    ifx_Peak_Threshold_Mode_t threshold_mode; /**< Statistic the threshold is computed from.*/
+
+    uint32_t scratch_len;    /**< Capacity of candidates, data_copy and median_scratch (max_data_len).*/
+    uint32_t* candidates;    /**< Indices of all local maxima above the threshold.*/
+    float* data_copy;        /**< Copy of a strided data set.*/
+    float* median_scratch;   /**< Copy of the data set reordered by the median selection.*/
+
+    uint32_t rows_capacity;  /**< Number of rows the row results are allocated for (max_num_rows).*/
+    uint32_t* row_count;     /**< Peak count per row.*/
+    ifx_Peak_t* row_peaks;   /**< Peaks per row (max_num_peaks per row).*/
+    ifx_Float_t* row_threshold; /**< Threshold per row.*/
 };
 
 /*
@@ -105,17 +122,84 @@ struct ifx_Peak_Search_s
 */
 
 /**
- * @brief Returns the threshold object
+ * @brief Returns the threshold for a data set
  *
- * @param [in]     data_set  ...
- * @param [in]     factor    ...
- * @param [in]     offset    ...
+ * @param [in]     handle    A handle to the peak search object
+ * @param [in]     data      Contiguous data set
+ * @param [in]     len       Length of the data set
  *
  * @return Threshold value
  */
-static ifx_Float_t get_threshold(const ifx_Vector_R_t* data_set,
-                                 ifx_Float_t factor,
-                                 ifx_Float_t offset);
+static ifx_Float_t get_threshold(ifx_Peak_Search_t* handle,
+                                 const float* data,
+                                 uint32_t len);
+
+/**
+ * @brief Returns the median of the array, the array is reordered
+ *
+ * @param [in,out] x         Array
+ * @param [in]     len       Length of the array (> 0)
+ *
+ * @return Median value
+ */
+static float select_median(float* x, uint32_t len);
+
+/**
+ * @brief Computes the range [begin, end) of bins within the search zone
+ *
+ * @param [in]     handle    A handle to the peak search object
+ * @param [in]     len       Length of the data set (>= 5)
+ * @param [out]    begin     First bin of the search zone
+ * @param [out]    end       One past the last bin of the search zone
+ */
+static void get_search_bins(const ifx_Peak_Search_t* handle,
+                            uint32_t len,
+                            uint32_t* begin,
+                            uint32_t* end);
+
+/**
+ * @brief Returns the data of a vector as contiguous array
+ *
+ * If the vector is strided it is copied to the scratch buffer.
+ *
+ * @param [in,out] handle    A handle to the peak search object
+ * @param [in]     vector    The data set
+ *
+ * @return Pointer to the contiguous data
+ */
+static const float* get_contiguous(ifx_Peak_Search_t* handle,
+                                   const ifx_Vector_R_t* vector);
+
+/**
+ * @brief Inserts a peak into a bounded min-heap of the strongest peaks
+ *
+ * @param [in,out] heap      Heap of peaks, the weakest peak is heap[0]
+ * @param [in,out] count     Number of peaks in the heap
+ * @param [in]     capacity  Maximum number of peaks in the heap
+ * @param [in]     index     Bin index of the peak
+ * @param [in]     value     Bin value of the peak
+ */
+static void heap_push(ifx_Peak_t* heap, uint32_t* count, uint32_t capacity,
+                      uint32_t index, float value);
+
+/**
+ * @brief Sorts a heap built with heap_push by decreasing value
+ *
+ * @param [in,out] heap      Heap of peaks
+ * @param [in]     count     Number of peaks in the heap
+ */
+static void heap_sort(ifx_Peak_t* heap, uint32_t count);
+
+/**
+ * @brief Refines position and value of a peak by interpolation
+ *
+ * @param [in]     data      Contiguous data set
+ * @param [in]     method    Interpolation method
+ * @param [in,out] peak      Peak, index and value must be set
+ */
+static void interpolate_peak(const float* data,
+                             ifx_Peak_Interpolation_t method,
+                             ifx_Peak_t* peak);
 
 /**
  * @brief Resets the peak search handle
@@ -130,20 +214,241 @@ static void reset_handle(ifx_Peak_Search_t* handle);
 ==============================================================================
 */
 
-static ifx_Float_t get_threshold(const ifx_Vector_R_t* data_set,
-                                 ifx_Float_t factor,
-                                 ifx_Float_t offset)
+static ifx_Float_t get_threshold(ifx_Peak_Search_t* handle,
+                                 const float* data,
+                                 uint32_t len)
 {
-    ifx_Float_t threshold = ifx_vec_sum_r(data_set);
+    ifx_Float_t threshold;
 
-    threshold *= factor / (ifx_Float_t)vLen(data_set);
-    threshold += offset;
+    if (handle->threshold_mode == IFX_PEAK_THRESHOLD_NOISE_FLOOR)
+    {
+        // select_median reorders, so work on a copy; data may be data_copy, which is still searched
+        float* copy = handle->median_scratch;
+        memcpy(copy, data, sizeof(float) * len);
+        threshold = select_median(copy, len) * handle->threshold_factor;
+    }
+    else
+    {
+        threshold = ifx_simd_kernels()->sum_r(data, len);
+        threshold *= handle->threshold_factor / (ifx_Float_t)len;
+    }
+    threshold += handle->threshold_offset;
 
     return threshold;
 }
 
 //----------------------------------------------------------------------------
 
+static float select_median(float* x, uint32_t len)
+{
+    // quickselect (Hoare partition) for the element of rank len/2
+    const uint32_t k = len / 2;
+    uint32_t lo = 0;
+    uint32_t hi = len - 1;
+
+    while (lo < hi)
+    {
+        const float pivot = x[lo + (hi - lo) / 2];
+        uint32_t i = lo;
+        uint32_t j = hi;
+        while (i <= j)
+        {
+            while (x[i] < pivot)
+                i++;
+            while (x[j] > pivot)
+                j--;
+            if (i <= j)
+            {
+                const float t = x[i];
+                x[i] = x[j];
+                x[j] = t;
+                i++;
+                if (j == 0)
+                    break;
+                j--;
+            }
+        }
+        if (k <= j)
+            hi = j;
+        else if (k >= i)
+            lo = i;
+        else
+            break;
+    }
+
+    float median = x[k];
+    if ((len & 1) == 0)
+    {
+        // the lower middle element is the maximum of the elements below k
+        float lower = x[0];
+        for (uint32_t i = 1; i < k; i++)
+        {
+            if (x[i] > lower)
+                lower = x[i];
+        }
+        median = (median + lower) / 2;
+    }
+    return median;
+}
+
+//----------------------------------------------------------------------------
+
+static void get_search_bins(const ifx_Peak_Search_t* handle,
+                            uint32_t len,
+                            uint32_t* begin,
+                            uint32_t* end)
+{
+    // bins n with search_zone_start <= n * value_per_bin <= search_zone_end,
+    // evaluated with the same float expression as the sample-by-sample search
+    const ifx_Float_t step = handle->value_per_bin;
+    const ifx_Float_t first_bin = handle->search_zone_start / step;
+    const ifx_Float_t last_bin = handle->search_zone_end / step;
+
+    uint32_t first = (first_bin >= (ifx_Float_t)len) ? len : (uint32_t)first_bin;
+    while (first > 0 && (first - 1) * step >= handle->search_zone_start)
+        first--;
+    while (first < len && first * step < handle->search_zone_start)
+        first++;
+
+    uint32_t stop = (last_bin >= (ifx_Float_t)len) ? len : (uint32_t)last_bin + 1;
+    while (stop < len && stop * step <= handle->search_zone_end)
+        stop++;
+    while (stop > 0 && (stop - 1) * step > handle->search_zone_end)
+        stop--;
+
+    // -2/+2 neighbor checking
+    *begin = (first < 2) ? 2 : first;
+    *end = (stop > len - 2) ? len - 2 : stop;
+    if (*end < *begin)
+        *end = *begin;
+}
+
+//----------------------------------------------------------------------------
+
+static const float* get_contiguous(ifx_Peak_Search_t* handle,
+                                   const ifx_Vector_R_t* vector)
+{
+    if (VEC_CONTIGUOUS(vector))
+        return (const float*)vDat(vector);
+
+    for (uint32_t i = 0; i < vLen(vector); i++)
+        handle->data_copy[i] = (float)vAt(vector, i);
+    return handle->data_copy;
+}
+
+//----------------------------------------------------------------------------
+
+/* a is weaker than b: lower value, or equal value and higher index */
+#define PEAK_WEAKER(a, b) ((a).value < (b).value || ((a).value == (b).value && (a).index > (b).index))
+
+static void heap_push(ifx_Peak_t* heap, uint32_t* count, uint32_t capacity,
+                      uint32_t index, float value)
+{
+    const ifx_Peak_t peak = {index, (ifx_Float_t)index, value};
+    uint32_t n = *count;
+
+    if (n < capacity)
+    {
+        // sift up
+        while (n > 0)
+        {
+            const uint32_t parent = (n - 1) / 2;
+            if (!PEAK_WEAKER(peak, heap[parent]))
+                break;
+            heap[n] = heap[parent];
+            n = parent;
+        }
+        heap[n] = peak;
+        (*count)++;
+        return;
+    }
+
+    if (!PEAK_WEAKER(heap[0], peak))
+        return;
+
+    // replace the weakest peak and sift down
+    n = 0;
+    for (;;)
+    {
+        uint32_t child = 2 * n + 1;
+        if (child >= capacity)
+            break;
+        if (child + 1 < capacity && PEAK_WEAKER(heap[child + 1], heap[child]))
+            child++;
+        if (!PEAK_WEAKER(heap[child], peak))
+            break;
+        heap[n] = heap[child];
+        n = child;
+    }
+    heap[n] = peak;
+}
+
+//----------------------------------------------------------------------------
+
+static void heap_sort(ifx_Peak_t* heap, uint32_t count)
+{
+    // repeatedly move the weakest peak to the end
+    while (count > 1)
+    {
+        count--;
+        const ifx_Peak_t last = heap[count];
+        heap[count] = heap[0];
+
+        uint32_t n = 0;
+        for (;;)
+        {
+            uint32_t child = 2 * n + 1;
+            if (child >= count)
+                break;
+            if (child + 1 < count && PEAK_WEAKER(heap[child + 1], heap[child]))
+                child++;
+            if (!PEAK_WEAKER(heap[child], last))
+                break;
+            heap[n] = heap[child];
+            n = child;
+        }
+        heap[n] = last;
+    }
+}
+
+#undef PEAK_WEAKER
+
+//----------------------------------------------------------------------------
+
+static void interpolate_peak(const float* data,
+                             ifx_Peak_Interpolation_t method,
+                             ifx_Peak_t* peak)
+{
+    if (method == IFX_PEAK_INTERPOLATION_NONE)
+        return;
+
+    ifx_Float_t a = data[peak->index - 1];
+    ifx_Float_t b = data[peak->index];
+    ifx_Float_t c = data[peak->index + 1];
+
+    const bool gaussian = (method == IFX_PEAK_INTERPOLATION_GAUSSIAN) && a > 0 && b > 0 && c > 0;
+    if (gaussian)
+    {
+        a = logf(a);
+        b = logf(b);
+        c = logf(c);
+    }
+
+    // vertex of the parabola through (-1, a), (0, b), (1, c); as b >= a and
+    // b > c the offset is within [-0.5, 0.5]
+    const ifx_Float_t denominator = a - 2 * b + c;
+    if (denominator == 0)
+        return;
+
+    const ifx_Float_t offset = (ifx_Float_t)0.5 * (a - c) / denominator;
+    const ifx_Float_t vertex = b - (ifx_Float_t)0.25 * (a - c) * offset;
+
+    peak->position = (ifx_Float_t)peak->index + offset;
+    peak->value = gaussian ? expf(vertex) : vertex;
+}
+
+//----------------------------------------------------------------------------
+
 static void reset_handle(ifx_Peak_Search_t* handle)
 {
     handle->peak_count = 0;
@@ -163,6 +468,12 @@ ifx_Peak_Search_t* ifx_peak_search_create(const ifx_Peak_Search_Config_t* config
     IFX_ERR_BRN_ARGUMENT(config->search_zone_start <= 0);
     IFX_ERR_BRN_ARGUMENT(config->search_zone_end <= 0 || config->search_zone_end < config->search_zone_start);
     IFX_ERR_BRN_ARGUMENT(config->max_num_peaks == 0);
+    IFX_ERR_BRN_ARGUMENT(config->max_data_len == 0);
+    IFX_ERR_BRN_ARGUMENT(config->interpolation != IFX_PEAK_INTERPOLATION_NONE
+                         && config->interpolation != IFX_PEAK_INTERPOLATION_PARABOLIC
+                         && config->interpolation != IFX_PEAK_INTERPOLATION_GAUSSIAN);
+    IFX_ERR_BRN_ARGUMENT(config->threshold_mode != IFX_PEAK_THRESHOLD_MEAN
+                         && config->threshold_mode != IFX_PEAK_THRESHOLD_NOISE_FLOOR);
 
     ifx_Peak_Search_t* h = ifx_mem_alloc(sizeof(struct ifx_Peak_Search_s));
     IFX_ERR_BRN_MEMALLOC(h);
@@ -173,9 +484,35 @@ ifx_Peak_Search_t* ifx_peak_search_create(const ifx_Peak_Search_Config_t* config
     h->threshold_factor = config->threshold_factor;
     h->threshold_offset = config->threshold_offset;
     h->max_num_peaks = config->max_num_peaks;
+    h->interpolation = config->interpolation;
+    h->threshold_mode = config->threshold_mode;
 
+    h->scratch_len = config->max_data_len;
+    h->rows_capacity = config->max_num_rows;
+    h->row_count = NULL;
+    h->row_peaks = NULL;
+    h->row_threshold = NULL;
+
+    // everything the run functions need is allocated here, so they never allocate
     h->peak_idx = ifx_mem_alloc(sizeof(uint32_t) * config->max_num_peaks);
     h->peak_val = ifx_mem_alloc(sizeof(ifx_Float_t) * config->max_num_peaks);
+    h->candidates = ifx_mem_alloc(sizeof(uint32_t) * config->max_data_len);
+    h->data_copy = ifx_mem_alloc(sizeof(float) * config->max_data_len);
+    h->median_scratch = ifx_mem_alloc(sizeof(float) * config->max_data_len);
+    bool rows_allocated = true;
+    if (config->max_num_rows)
+    {
+        h->row_count = ifx_mem_alloc(sizeof(uint32_t) * config->max_num_rows);
+        h->row_peaks = ifx_mem_alloc(sizeof(ifx_Peak_t) * config->max_num_rows * config->max_num_peaks);
+        h->row_threshold = ifx_mem_alloc(sizeof(ifx_Float_t) * config->max_num_rows);
+        rows_allocated = h->row_count && h->row_peaks && h->row_threshold;
+    }
+    if (!h->peak_idx || !h->peak_val || !h->candidates || !h->data_copy || !h->median_scratch || !rows_allocated)
+    {
+        ifx_peak_search_destroy(h);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
 
     reset_handle(h);
     return h;
@@ -192,6 +529,12 @@ void ifx_peak_search_destroy(ifx_Peak_Search_t* handle)
 
     ifx_mem_free(handle->peak_idx);
     ifx_mem_free(handle->peak_val);
+    ifx_mem_free(handle->candidates);
+    ifx_mem_free(handle->data_copy);
+    ifx_mem_free(handle->median_scratch);
+    ifx_mem_free(handle->row_count);
+    ifx_mem_free(handle->row_peaks);
+    ifx_mem_free(handle->row_threshold);
     ifx_mem_free(handle);
 }
 
@@ -205,6 +548,8 @@ void ifx_peak_search_run(ifx_Peak_Search_t* handle,
     IFX_VEC_BRK_VALID(data_set);
     IFX_ERR_BRK_NULL(result);
 
+    IFX_ERR_BRK_BIGGER(vLen(data_set), handle->scratch_len);
+
     // data_set length must be minimum 5 because -2/+2 neighbor checking
     if (vLen(data_set) < 5)
     {
@@ -213,37 +558,89 @@ void ifx_peak_search_run(ifx_Peak_Search_t* handle,
 
     reset_handle(handle);
 
-    ifx_Float_t threshold = get_threshold(data_set,
-                                          handle->threshold_factor,
-                                          handle->threshold_offset);
+    const float* data = get_contiguous(handle, data_set);
+    const ifx_Float_t threshold = get_threshold(handle, data, vLen(data_set));
+
+    uint32_t begin, end;
+    get_search_bins(handle, vLen(data_set), &begin, &end);
 
-    for (uint32_t n = 2; n < vLen(data_set) - 2; n++)
+    // the peaks are reported in scan order, so the first max_num_peaks candidates are taken
+    uint32_t count = (uint32_t)ifx_simd_kernels()->local_max_r(data, begin, end, threshold, handle->candidates);
+    if (count > handle->max_num_peaks)
+        count = handle->max_num_peaks;
+
+    for (uint32_t i = 0; i < count; i++)
     {
-        const ifx_Float_t fp = vAt(data_set, n);
-        const ifx_Float_t fl = vAt(data_set, n - 1);
-        const ifx_Float_t fl2 = vAt(data_set, n - 2);
-        const ifx_Float_t fr = vAt(data_set, n + 1);
-        const ifx_Float_t fr2 = vAt(data_set, n + 2);
+        handle->peak_idx[i] = handle->candidates[i];
+        handle->peak_val[i] = data[handle->candidates[i]];
+    }
+    handle->peak_count = count;
 
-        if (fp >= threshold && fp >= fl2 && fp >= fl && fp > fr && fp > fr2)
+    result->peak_count = handle->peak_count;
+    result->index = handle->peak_idx;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_peak_search_run_rows(ifx_Peak_Search_t* handle,
+                              const ifx_Matrix_R_t* spectra,
+                              ifx_Peak_Search_Rows_Result_t* result)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_MAT_BRK_VALID(spectra);
+    IFX_ERR_BRK_NULL(result);
+
+    const uint32_t rows = mRows(spectra);
+    const uint32_t cols = mCols(spectra);
+    const uint32_t max_num_peaks = handle->max_num_peaks;
+
+    IFX_ERR_BRK_BIGGER(rows, handle->rows_capacity);
+    IFX_ERR_BRK_BIGGER(cols, handle->scratch_len);
+
+    result->num_rows = rows;
+    result->max_num_peaks = max_num_peaks;
+    result->peak_count = handle->row_count;
+    result->peaks = handle->row_peaks;
+    result->threshold = handle->row_threshold;
+
+    uint32_t begin = 0, end = 0;
+    if (cols >= 5)
+        get_search_bins(handle, cols, &begin, &end);
+
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+    for (uint32_t r = 0; r < rows; r++)
+    {
+        ifx_Peak_t* peaks = &handle->row_peaks[(size_t)r * max_num_peaks];
+        uint32_t count = 0;
+
+        // data_set length must be minimum 5 because -2/+2 neighbor checking
+        if (cols < 5)
         {
-            ifx_Float_t cur_value = n * handle->value_per_bin;
+            handle->row_count[r] = 0;
+            handle->row_threshold[r] = 0;
+            continue;
+        }
 
-            if (cur_value >= handle->search_zone_start
-                && cur_value <= handle->search_zone_end)
-            {
-                handle->peak_idx[handle->peak_count] = n;
-                handle->peak_val[handle->peak_count] = fp;
-                ++handle->peak_count;
+        ifx_Vector_R_t row;
+        ifx_mat_get_rowview_r(spectra, r, &row);
+        const float* data = get_contiguous(handle, &row);
+        const ifx_Float_t threshold = get_threshold(handle, data, cols);
 
-                if (handle->peak_count >= handle->max_num_peaks)
-                {
-                    break;
-                }
-            }
+        const size_t candidates = kernels->local_max_r(data, begin, end, threshold, handle->candidates);
+        for (size_t i = 0; i < candidates; i++)
+        {
+            const uint32_t index = handle->candidates[i];
+            // once the heap is full most candidates are weaker than all kept peaks
+            if (count == max_num_peaks && data[index] < peaks[0].value)
+                continue;
+            heap_push(peaks, &count, max_num_peaks, index, data[index]);
         }
-    }
+        heap_sort(peaks, count);
 
-    result->peak_count = handle->peak_count;
-    result->index = handle->peak_idx;
+        for (uint32_t i = 0; i < count; i++)
+            interpolate_peak(data, handle->interpolation, &peaks[i]);
+
+        handle->row_count[r] = count;
+        handle->row_threshold[r] = threshold;
+    }
 }
@@ -44,6 +44,7 @@
 ==============================================================================
 */
 
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Types.h"
 #include "ifxBase/Vector.h"
 
@@ -66,6 +67,30 @@ extern "C"
 ==============================================================================
 */
 
+/**
+ * @brief Sub-bin interpolation of the peak position and value.
+ */
+typedef enum
+{
+    IFX_PEAK_INTERPOLATION_NONE = 0,      /**< Position is the bin index, value is the bin value.*/
+    IFX_PEAK_INTERPOLATION_PARABOLIC = 1, /**< Parabola through the peak bin and its two direct neighbours.*/
+    IFX_PEAK_INTERPOLATION_GAUSSIAN = 2   /**< Parabola through the logarithm of the three values. This is exact for
+                                               Gaussian shaped peaks (e.g. a Gaussian window in a magnitude
+                                               spectrum). Falls back to parabolic interpolation if a value is not
+                                               positive.*/
+} ifx_Peak_Interpolation_t;
+
+/**
+ * @brief Defines how the threshold of the peak search is computed from the data.
+ */
+typedef enum
+{
+    IFX_PEAK_THRESHOLD_MEAN = 0,       /**< threshold_factor * mean of the data + threshold_offset*/
+    IFX_PEAK_THRESHOLD_NOISE_FLOOR = 1 /**< threshold_factor * noise floor + threshold_offset. The noise floor is
+                                            estimated as median of the data, which in contrast to the mean is not
+                                            raised by strong targets.*/
+} ifx_Peak_Threshold_Mode_t;
+
 /**
  * @brief Defines the structure for Peak Search module related settings.
  *
@@ -91,6 +116,12 @@ typedef struct
     ifx_Float_t threshold_offset;  /**< This value is added to the value obtained by multiplying the threshold_factor with
                                         the mean of the data set to get the final 'y' threshold.*/
     uint32_t max_num_peaks;        /**< This decides the max number of peaks to be identified in the search zone.*/
+    ifx_Peak_Interpolation_t interpolation;   /**< Sub-bin interpolation used by \ref ifx_peak_search_run_rows.*/
+    ifx_Peak_Threshold_Mode_t threshold_mode; /**< Statistic of the data the threshold is computed from.*/
+    uint32_t max_data_len;         /**< Maximum length of the data sets (and rows) passed to the run functions.
+                                        All buffers are allocated by \ref ifx_peak_search_create.*/
+    uint32_t max_num_rows;         /**< Maximum number of rows passed to \ref ifx_peak_search_run_rows,
+                                        0 if only \ref ifx_peak_search_run is used.*/
 } ifx_Peak_Search_Config_t;
 
 /**
@@ -102,6 +133,33 @@ typedef struct
     uint32_t* index;     /**< Array of indices of found peaks.*/
 } ifx_Peak_Search_Result_t;
 
+/**
+ * @brief A single peak found by \ref ifx_peak_search_run_rows.
+ */
+typedef struct
+{
+    uint32_t index;       /**< Bin index of the peak.*/
+    ifx_Float_t position; /**< Interpolated peak position in bins. Multiply with
+                               \ref ifx_Peak_Search_Config_t.value_per_bin to get the value quantity 'x'.*/
+    ifx_Float_t value;    /**< Interpolated peak value.*/
+} ifx_Peak_t;
+
+/**
+ * @brief Result of \ref ifx_peak_search_run_rows.
+ *
+ * All arrays are owned by the peak search handle and remain valid until the
+ * next call of a run function or until the handle is destroyed.
+ */
+typedef struct
+{
+    uint32_t num_rows;      /**< Number of searched rows.*/
+    uint32_t max_num_peaks; /**< Maximum number of peaks per row, this is the row stride of peaks.*/
+    uint32_t* peak_count;   /**< Number of peaks found in each row (num_rows entries).*/
+    ifx_Peak_t* peaks;      /**< Peaks of row r start at peaks[r * max_num_peaks]; each row is sorted by
+                                 decreasing peak value.*/
+    ifx_Float_t* threshold; /**< Threshold applied to each row (num_rows entries).*/
+} ifx_Peak_Search_Rows_Result_t;
+
 /**
  * @brief A handle for an instance of Peak Search module, see Peak_Search.h.
  */
@@ -154,12 +212,16 @@ void ifx_peak_search_destroy(ifx_Peak_Search_t* handle);
  * @brief Uses a valid peak search handle to search peaks from input data_set.
  *        The run function looks for peaks in the data_set vector between \ref ifx_Peak_Search_Config_t.search_zone_start
  *        and \ref ifx_Peak_Search_Config_t.search_zone_end, as long as the peak values are higher than a threshold
- *        obtained by multiplying the mean value of the data_set with \ref ifx_Peak_Search_Config_t.threshold_factor and
+ *        obtained by multiplying the mean value (or the noise floor, see \ref ifx_Peak_Search_Config_t.threshold_mode)
+ *        of the data_set with \ref ifx_Peak_Search_Config_t.threshold_factor and
  *        adding \ref ifx_Peak_Search_Config_t.threshold_offset to it. The peaks are computed by comparing with
  *        2 neighbouring values on either side of every sample value within the search zone.
  *        The peak search stops once the entire search zone has been parsed for peaks OR once
  *        \ref ifx_Peak_Search_Config_t.max_num_peaks are encountered, whichever is earlier.
  *
+ * The length of data_set must not exceed \ref ifx_Peak_Search_Config_t.max_data_len,
+ * otherwise @ref IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS is set. No memory is allocated.
+ *
  * @param [in,out] handle    A handle to the peak search object
  * @param [in]     data_set  The target data set to search for peaks
  * @param [out]    result    Result of the peak search
@@ -170,6 +232,35 @@ void ifx_peak_search_run(ifx_Peak_Search_t* handle,
                          const ifx_Vector_R_t* data_set,
                          ifx_Peak_Search_Result_t* result);
 
+/**
+ * @brief Searches the strongest peaks in every row of a matrix.
+ *
+ * Each row of spectra (e.g. the range spectra of all antennas, the rows of a
+ * range-Doppler map, or a slice of a cube obtained with \ref ifx_cube_get_slice_r)
+ * is searched like in \ref ifx_peak_search_run, with a threshold computed
+ * per row. In contrast to \ref ifx_peak_search_run, the whole search zone is
+ * searched and the \ref ifx_Peak_Search_Config_t.max_num_peaks strongest peaks
+ * are returned, sorted by decreasing value. Peaks of equal value are ordered
+ * by their index. The peak position and value are refined according to
+ * \ref ifx_Peak_Search_Config_t.interpolation.
+ *
+ * The neighbour comparisons use the SIMD kernels if the rows are contiguous
+ * in memory.
+ *
+ * The number of rows and columns must not exceed \ref ifx_Peak_Search_Config_t.max_num_rows
+ * and \ref ifx_Peak_Search_Config_t.max_data_len, otherwise
+ * @ref IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS is set. No memory is allocated.
+ *
+ * @param [in,out] handle    A handle to the peak search object
+ * @param [in]     spectra   Matrix with one data set per row
+ * @param [out]    result    Result of the peak search
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_peak_search_run_rows(ifx_Peak_Search_t* handle,
+                              const ifx_Matrix_R_t* spectra,
+                              ifx_Peak_Search_Rows_Result_t* result);
+
 /**
  * @}
  */
@@ -49,11 +49,13 @@
 #include <ifxRadar/AngleCapon.h>
 #include <ifxRadar/AngleMonopulse.h>
 #include <ifxRadar/DBF.h>
+#include <ifxRadar/MicroDoppler.h>
 #include <ifxRadar/PeakSearch.h>
 #include <ifxRadar/RangeAngleImage.h>
 #include <ifxRadar/RangeDopplerMap.h>
 #include <ifxRadar/RangeSpectrum.h>
 #include <ifxRadar/SpectrumAxis.h>
+#include <ifxRadar/Tracker.h>
 
 #ifdef __cplusplus
 extern "C"
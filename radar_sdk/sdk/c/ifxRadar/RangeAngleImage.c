@@ -74,7 +74,7 @@
 struct ifx_RAI_s
 {
     ifx_RDM_t* rdm_handle;            /**< Range doppler map handle for all rx antennas.*/
-    ifx_2DMTI_C_t** mti_handle_array; /**< 2D MTI filter coefficient.*/
+    ifx_2DMTI_C_t* mti_handle;        /**< 2D MTI filter over all rx antennas.*/
     ifx_DBF_t* dbf_handle;            /**< Digital beamforming module handle.*/
     uint32_t num_of_images;           /**< Number of images (responses) for Range Angle Image.*/
     uint32_t num_antenna_array;       /**< Number of virtual antennas.*/
@@ -280,15 +280,9 @@ ifx_RAI_t* ifx_rai_create(ifx_RAI_Config_t* config)
                      ifx_rai_destroy(h));
 
     //----------------------- 2D MTI Handle ----------------------------------
-    h->mti_handle_array = ifx_mem_alloc(sizeof(ifx_2DMTI_C_t*) * config->num_antenna_array);
-    IFX_ERR_BRN_MEMALLOC(h);
-
-    for (uint32_t i = 0; i < config->num_antenna_array; ++i)
-    {
-        IFX_ERR_HANDLE_N(h->mti_handle_array[i] = ifx_2dmti_create_c(config->alpha_mti_filter,
-                                                                     range_fft_size, doppler_fft_size),
-                         ifx_rai_destroy(h));
-    }
+    IFX_ERR_HANDLE_N(h->mti_handle = ifx_2dmti_create_cube_c(config->alpha_mti_filter, range_fft_size,
+                                                             doppler_fft_size, config->num_antenna_array),
+                     ifx_rai_destroy(h));
 
     //----------------------- DBF Handle -------------------------------------
     IFX_ERR_HANDLE_N(h->dbf_handle = ifx_dbf_create(&config->dbf_config),
@@ -333,12 +327,7 @@ void ifx_rai_destroy(ifx_RAI_t* handle)
     ifx_dbf_destroy(handle->dbf_handle);
     ifx_rdm_destroy(handle->rdm_handle);
 
-    for (uint32_t i = 0; i < handle->num_antenna_array; ++i)
-    {
-        ifx_2dmti_destroy_c(handle->mti_handle_array[i]);
-    }
-
-    ifx_mem_free(handle->mti_handle_array);
+    ifx_2dmti_destroy_c(handle->mti_handle);
 
     ifx_mem_free(handle);
 }
@@ -361,20 +350,16 @@ void ifx_rai_run_r(ifx_RAI_t* handle,
         // rawdata_view: num_chirps_per_frame x num_samples_per_frame
         ifx_Matrix_R_t rawdata_view = {0};
 
-        // rx_spectrum_view: range_fft_size x doppler_fft_size
-        ifx_Matrix_C_t rx_spectrum_view = {0};
-
         ifx_cube_get_row_r(input, rx, &rawdata_view);           // set view to the rx antenna for raw data matrix
 
         ifx_cube_get_slice_c(handle->rdm_cube, rx, &rdm_view);  // set view to the rx antenna for range doppler map
 
-        ifx_cube_get_slice_c(handle->rx_spectrum_cube, rx, &rx_spectrum_view);
-
         ifx_rdm_run_rc(handle->rdm_handle, &rawdata_view, &rdm_view);
-
-        ifx_2dmti_run_c(handle->mti_handle_array[rx], &rdm_view, &rx_spectrum_view);
     }
 
+    // filter all rx antennas in one pass over the contiguous range doppler cube
+    ifx_2dmti_run_cube_c(handle->mti_handle, handle->rdm_cube, handle->rx_spectrum_cube);
+
     ifx_dbf_run_c(handle->dbf_handle, handle->rx_spectrum_cube, handle->dbf_cube);
 
     calculate_snr(handle);
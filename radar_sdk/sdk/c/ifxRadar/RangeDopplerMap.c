@@ -33,16 +33,20 @@
 ==============================================================================
 */
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "ifxAlgo/FFT.h"
+#include "ifxAlgo/FFTQ15.h"
 #include "ifxAlgo/Window.h"
 
 #include "ifxBase/Complex.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Metrics.h"
+#include "ifxBase/internal/SimdFixed.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
@@ -81,6 +85,38 @@ struct ifx_RDM_s
     ifx_Matrix_C_t* rdm_matrix;              /**< Container to store the result of range and doppler FFT.*/
 };
 
+/**
+ * @brief Defines the structure for the fixed-point Range Doppler map module.
+ *        Use type ifx_RDM_Q15_t for this struct.
+ *
+ * All complex buffers hold interleaved (real, imaginary) Q15 values.
+ */
+struct ifx_RDM_Q15_s
+{
+    ifx_Math_Scale_Type_t output_scale_type; /**< Linear or dB scale for the output.*/
+    ifx_Float_t spect_threshold;             /**< Threshold in linear scale, see \ref ifx_RDM_s.*/
+    ifx_FFT_Type_t range_fft_type;           /**< Type of the range FFT (real or complex input).*/
+    bool range_mean_removal;                 /**< Mean removal before the range FFT.*/
+    bool doppler_mean_removal;               /**< Mean removal before the Doppler FFT.*/
+    uint32_t samples_per_chirp;              /**< Length of the range window.*/
+    uint32_t num_of_chirps;                  /**< Number of chirps processed, at most the Doppler FFT size.*/
+    uint32_t range_bins;                     /**< Number of rows of the map.*/
+    uint32_t doppler_bins;                   /**< Number of columns of the map.*/
+    ifx_FFT_Q15_t* range_fft;                /**< Range FFT.*/
+    ifx_FFT_Q15_t* doppler_fft;              /**< Doppler FFT.*/
+    int16_t* range_window;                   /**< Range window, repeated for real and imaginary part for complex input.*/
+    int32_t range_window_exponent;           /**< Exponent of the range window coefficients.*/
+    int16_t* doppler_window;                 /**< Doppler window, repeated for real and imaginary part.*/
+    int32_t doppler_window_exponent;         /**< Exponent of the Doppler window coefficients.*/
+    int16_t* chirp_buffer;                   /**< Preprocessed samples of one chirp.*/
+    int16_t* range_spectrum;                 /**< Range FFT result of each chirp (chirps x range_bins).*/
+    int32_t* chirp_exponents;                /**< Exponent of each range FFT result.*/
+    int16_t* doppler_buffer;                 /**< Preprocessed range bin over all chirps.*/
+    int16_t* doppler_result;                 /**< Doppler FFT result before the FFT shift.*/
+    int16_t* spectrum;                       /**< Range Doppler map (range_bins x doppler_bins).*/
+    int32_t* exponents;                      /**< Exponent of each row of the map.*/
+};
+
 /*
 ==============================================================================
    4. LOCAL DATA
@@ -185,6 +221,223 @@ static void spectrum2_to_linear(ifx_Vector_R_t* vec, ifx_Float_t threshold)
     }
 }
 
+/**
+ * @brief Converts window coefficients to Q15
+ *
+ * The coefficients are scaled by a power of two so that the largest one
+ * uses the full Q15 range, which keeps the precision for normalized windows.
+ * Each coefficient is written repeat times (2 for complex data).
+ *
+ * @param [in]     config        window configuration
+ * @param [in]     normalized    normalize the window like \ref ifx_ppfft_create
+ * @param [in]     repeat        number of copies of each coefficient
+ * @param [out]    exponent      exponent of the coefficients
+ * @return Q15 coefficients or NULL in case of failure
+ */
+static int16_t* window_to_q15(const ifx_Window_Config_t* config, bool normalized, uint32_t repeat, int32_t* exponent)
+{
+    const ifx_Vector_R_t* window = ifx_window_acquire(config, normalized);
+    if (!window)
+        return NULL;
+
+    int16_t* coefficients = ifx_mem_calloc((size_t)repeat * vLen(window), sizeof(int16_t));
+    if (!coefficients)
+    {
+        ifx_window_release(window);
+        return NULL;
+    }
+
+    ifx_Float_t max = 0;
+    for (uint32_t i = 0; i < vLen(window); i++)
+        max = MAX(max, FABS(vAt(window, i)));
+
+    int32_t e = 0;
+    double scale = 32768;
+    if (max > 0)
+    {
+        while (max * scale * 2 <= INT16_MAX)
+        {
+            scale *= 2;
+            e--;
+        }
+        while (max * scale > INT16_MAX)
+        {
+            scale /= 2;
+            e++;
+        }
+    }
+
+    for (uint32_t i = 0; i < vLen(window); i++)
+    {
+        const int16_t q = (int16_t)lround(vAt(window, i) * scale);
+        for (uint32_t k = 0; k < repeat; k++)
+            coefficients[repeat * i + k] = q;
+    }
+
+    ifx_window_release(window);
+    *exponent = e;
+    return coefficients;
+}
+
+/**
+ * @brief Subtracts the mean of each component from Q15 data
+ *
+ * @param [in]     x             input samples
+ * @param [in]     len           number of samples
+ * @param [in]     components    1 for real, 2 for interleaved complex samples
+ * @param [out]    y             output samples, may be identical to x
+ */
+static void remove_mean_q15(const int16_t* x, uint32_t len, uint32_t components, int16_t* y)
+{
+    for (uint32_t k = 0; k < components; k++)
+    {
+        int64_t sum = 0;
+        for (uint32_t i = 0; i < len; i++)
+            sum += x[components * i + k];
+
+        const int64_t half = len / 2;
+        const int32_t mean = (int32_t)((sum >= 0 ? sum + half : sum - half) / (int64_t)len);
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+            const int32_t v = x[components * i + k] - mean;
+            y[components * i + k] = (int16_t)((v > INT16_MAX) ? INT16_MAX : ((v < INT16_MIN) ? INT16_MIN : v));
+        }
+    }
+}
+
+/**
+ * @brief Computes the fixed-point range Doppler map
+ *
+ * @param [in]     handle        fixed-point range Doppler map object
+ * @param [in]     input         chirps x samples per chirp real or complex samples
+ * @param [in]     components    1 for real, 2 for interleaved complex input
+ */
+static void rdm_q15_run(ifx_RDM_Q15_t* handle, const int16_t* input, uint32_t components)
+{
+    const ifx_Simd_Fixed_Kernels_t* kernels = ifx_simd_fixed_kernels();
+    const uint32_t samples = handle->samples_per_chirp;
+    const uint32_t fft_len = MIN(samples, ifx_fft_q15_get_fft_size(handle->range_fft));
+    const uint32_t range_bins = handle->range_bins;
+    const uint32_t doppler_bins = handle->doppler_bins;
+    const uint32_t num_of_chirps = handle->num_of_chirps;
+
+    //------------------------------ range FFT -------------------------------
+
+    int32_t block_exponent = INT32_MIN;
+    for (uint32_t c = 0; c < num_of_chirps; c++)
+    {
+        const int16_t* chirp = &input[(size_t)c * components * samples];
+        int16_t* result = &handle->range_spectrum[(size_t)c * 2 * range_bins];
+
+        if (handle->range_mean_removal)
+        {
+            remove_mean_q15(chirp, samples, components, handle->chirp_buffer);
+            chirp = handle->chirp_buffer;
+        }
+        kernels->mul_q15(chirp, handle->range_window, handle->chirp_buffer, (size_t)components * samples);
+
+        int32_t e;
+        if (components == 1)
+            e = ifx_fft_q15_run_rc(handle->range_fft, handle->chirp_buffer, fft_len, result);
+        else
+            e = ifx_fft_q15_run_c(handle->range_fft, handle->chirp_buffer, fft_len, result);
+
+        handle->chirp_exponents[c] = e + handle->range_window_exponent;
+        block_exponent = MAX(block_exponent, handle->chirp_exponents[c]);
+    }
+
+    //----------------------------- Doppler FFT ------------------------------
+
+    for (uint32_t r = 0; r < range_bins; r++)
+    {
+        int16_t* x = handle->doppler_buffer;
+
+        // align all chirps to the largest exponent
+        for (uint32_t c = 0; c < num_of_chirps; c++)
+        {
+            const int16_t* bin = &handle->range_spectrum[((size_t)c * range_bins + r) * 2];
+            const int32_t shift = block_exponent - handle->chirp_exponents[c];
+
+            if (shift == 0)
+            {
+                x[2 * c] = bin[0];
+                x[2 * c + 1] = bin[1];
+            }
+            else if (shift < 16)
+            {
+                const int32_t round = 1 << (shift - 1);
+                x[2 * c] = (int16_t)((bin[0] + round) >> shift);
+                x[2 * c + 1] = (int16_t)((bin[1] + round) >> shift);
+            }
+            else
+            {
+                x[2 * c] = 0;
+                x[2 * c + 1] = 0;
+            }
+        }
+
+        if (handle->doppler_mean_removal)
+            remove_mean_q15(x, num_of_chirps, 2, x);
+        kernels->mul_q15(x, handle->doppler_window, x, 2 * (size_t)num_of_chirps);
+
+        const int32_t e = ifx_fft_q15_run_c(handle->doppler_fft, x, num_of_chirps, handle->doppler_result);
+        handle->exponents[r] = block_exponent + e + handle->doppler_window_exponent;
+
+        // same FFT shift as ifx_rdm_run_rc and ifx_rdm_run_c
+        const int16_t* result = handle->doppler_result;
+        int16_t* row = &handle->spectrum[(size_t)r * 2 * doppler_bins];
+        const uint32_t half = doppler_bins / 2;
+        if (components == 1)
+        {
+            for (uint32_t j = 0; j < half; ++j)
+            {
+                memcpy(&row[2 * j], &result[2 * (half - 1 - j)], 2 * sizeof(int16_t));
+                memcpy(&row[2 * (half + j)], &result[2 * (doppler_bins - 1 - j)], 2 * sizeof(int16_t));
+            }
+        }
+        else
+        {
+            memcpy(row, &result[2 * half], 2 * half * sizeof(int16_t));
+            memcpy(&row[2 * half], result, 2 * half * sizeof(int16_t));
+        }
+    }
+}
+
+/**
+ * @brief Computes the amplitude spectrum from the fixed-point map
+ *
+ * @param [in]     handle    fixed-point range Doppler map object
+ * @param [out]    output    amplitude spectrum in linear or dB scale
+ */
+static void rdm_q15_magnitude(const ifx_RDM_Q15_t* handle, ifx_Matrix_R_t* output)
+{
+    const ifx_Math_Scale_Type_t scale = handle->output_scale_type;
+
+    for (uint32_t r = 0; r < mRows(output); ++r)
+    {
+        const int16_t* row = &handle->spectrum[(size_t)r * 2 * handle->doppler_bins];
+        const ifx_Float_t factor = ldexpf(1, 2 * (handle->exponents[r] - 15));
+
+        ifx_Vector_R_t output_vec;
+        ifx_mat_get_rowview_r(output, r, &output_vec);
+
+        /* compute squared norm of spectrum */
+        for (uint32_t j = 0; j < vLen(&output_vec); j++)
+        {
+            const ifx_Float_t re = row[2 * j];
+            const ifx_Float_t im = row[2 * j + 1];
+            vAt(&output_vec, j) = (re * re + im * im) * factor;
+        }
+
+        /* convert to linear or to dB */
+        if (scale == IFX_SCALE_TYPE_LINEAR)
+            spectrum2_to_linear(&output_vec, handle->spect_threshold);
+        else
+            spectrum2_to_db(&output_vec, (ifx_Float_t)scale, handle->spect_threshold);
+    }
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -266,6 +519,8 @@ void ifx_rdm_run_rc(ifx_RDM_t* handle,
     IFX_ERR_BRK_COND(mRows(input) != num_of_chirps, IFX_ERROR_DIMENSION_MISMATCH);
     IFX_MAT_BRK_DIM((handle->rdm_matrix), output);
 
+    const uint64_t metrics_start = ifx_metrics_begin();
+
     uint32_t rng_fft_out_size = mRows(handle->rdm_matrix);
     uint32_t dopp_fft_out_size = mCols(handle->rdm_matrix);
 
@@ -308,6 +563,8 @@ void ifx_rdm_run_rc(ifx_RDM_t* handle,
             vAt(&output_vec, output_len / 2 + j) = vAt(handle->doppler_fft_result, output_len - 1 - j);
         }
     }
+
+    ifx_metrics_end(IFX_METRICS_STAGE_RDM, metrics_start);
 }
 
 //-----------------------------------------------------------------------------
@@ -367,6 +624,8 @@ void ifx_rdm_run_c(ifx_RDM_t* handle,
     IFX_ERR_BRK_COND(mRows(input) != num_of_chirps, IFX_ERROR_DIMENSION_MISMATCH);
     IFX_MAT_BRK_DIM((handle->rdm_matrix), output);
 
+    const uint64_t metrics_start = ifx_metrics_begin();
+
     uint32_t rng_fft_out_size = mRows(handle->rdm_matrix);
     uint32_t dopp_fft_out_size = mCols(handle->rdm_matrix);
 
@@ -404,6 +663,8 @@ void ifx_rdm_run_c(ifx_RDM_t* handle,
         // in this case approaching target falls on positive side.
         ifx_fft_shift_c(handle->doppler_fft_result, &output_vec);
     }
+
+    ifx_metrics_end(IFX_METRICS_STAGE_RDM, metrics_start);
 }
 
 //-----------------------------------------------------------------------------
@@ -502,3 +763,163 @@ void ifx_rdm_set_doppler_window(const ifx_Window_Config_t* config,
     IFX_ERR_BRK_NULL(handle)
     ifx_ppfft_set_window(handle->doppler_ppfft_handle, config);
 }
+
+//-----------------------------------------------------------------------------
+
+ifx_RDM_Q15_t* ifx_rdm_q15_create(const ifx_RDM_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+
+    const ifx_PPFFT_Config_t* range = &config->range_fft_config;
+    const ifx_PPFFT_Config_t* doppler = &config->doppler_fft_config;
+
+    IFX_ERR_BRN_ARGUMENT((range->fft_type != IFX_FFT_TYPE_R2C) && (range->fft_type != IFX_FFT_TYPE_C2C));
+    IFX_ERR_BRN_ARGUMENT(doppler->fft_type != IFX_FFT_TYPE_C2C);
+    IFX_ERR_BRN_ARGUMENT((range->window_config.size == 0) || (doppler->window_config.size == 0));
+    IFX_ERR_BRN_COND(config->spect_threshold < 0, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ifx_RDM_Q15_t* h = ifx_mem_calloc(1, sizeof(struct ifx_RDM_Q15_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    const uint32_t components = (range->fft_type == IFX_FFT_TYPE_R2C) ? 1 : 2;
+
+    h->output_scale_type = config->output_scale_type;
+    h->spect_threshold = config->spect_threshold;
+    h->range_fft_type = range->fft_type;
+    h->range_mean_removal = range->mean_removal_enabled;
+    h->doppler_mean_removal = doppler->mean_removal_enabled;
+    h->samples_per_chirp = range->window_config.size;
+    h->num_of_chirps = MIN(doppler->window_config.size, doppler->fft_size);
+    h->range_bins = (components == 1) ? range->fft_size / 2 : range->fft_size;
+    h->doppler_bins = doppler->fft_size;
+
+    // the FFT objects set the error themselves
+    h->range_fft = ifx_fft_q15_create(range->fft_type, range->fft_size);
+    if (!h->range_fft)
+        goto fail;
+
+    h->doppler_fft = ifx_fft_q15_create(IFX_FFT_TYPE_C2C, doppler->fft_size);
+    if (!h->doppler_fft)
+        goto fail;
+
+    h->range_window = window_to_q15(&range->window_config, range->is_normalized_window, components, &h->range_window_exponent);
+    IFX_ERR_BRF_MEMALLOC(h->range_window);
+
+    h->doppler_window = window_to_q15(&doppler->window_config, doppler->is_normalized_window, 2, &h->doppler_window_exponent);
+    IFX_ERR_BRF_MEMALLOC(h->doppler_window);
+
+    h->chirp_buffer = ifx_mem_calloc((size_t)components * h->samples_per_chirp, sizeof(int16_t));
+    IFX_ERR_BRF_MEMALLOC(h->chirp_buffer);
+
+    h->range_spectrum = ifx_mem_calloc((size_t)2 * h->num_of_chirps * h->range_bins, sizeof(int16_t));
+    IFX_ERR_BRF_MEMALLOC(h->range_spectrum);
+
+    h->chirp_exponents = ifx_mem_calloc(h->num_of_chirps, sizeof(int32_t));
+    IFX_ERR_BRF_MEMALLOC(h->chirp_exponents);
+
+    h->doppler_buffer = ifx_mem_calloc((size_t)2 * h->num_of_chirps, sizeof(int16_t));
+    IFX_ERR_BRF_MEMALLOC(h->doppler_buffer);
+
+    h->doppler_result = ifx_mem_calloc((size_t)2 * h->doppler_bins, sizeof(int16_t));
+    IFX_ERR_BRF_MEMALLOC(h->doppler_result);
+
+    h->spectrum = ifx_mem_calloc((size_t)2 * h->range_bins * h->doppler_bins, sizeof(int16_t));
+    IFX_ERR_BRF_MEMALLOC(h->spectrum);
+
+    h->exponents = ifx_mem_calloc(h->range_bins, sizeof(int32_t));
+    IFX_ERR_BRF_MEMALLOC(h->exponents);
+
+    return h;
+
+fail:
+    ifx_rdm_q15_destroy(h);
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_q15_destroy(ifx_RDM_Q15_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_fft_q15_destroy(handle->range_fft);
+    ifx_fft_q15_destroy(handle->doppler_fft);
+    ifx_mem_free(handle->range_window);
+    ifx_mem_free(handle->doppler_window);
+    ifx_mem_free(handle->chirp_buffer);
+    ifx_mem_free(handle->range_spectrum);
+    ifx_mem_free(handle->chirp_exponents);
+    ifx_mem_free(handle->doppler_buffer);
+    ifx_mem_free(handle->doppler_result);
+    ifx_mem_free(handle->spectrum);
+    ifx_mem_free(handle->exponents);
+    ifx_mem_free(handle);
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_q15_run_r(ifx_RDM_Q15_t* handle,
+                       const int16_t* input,
+                       ifx_Matrix_R_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(input);
+    IFX_ERR_BRK_ARGUMENT(handle->range_fft_type != IFX_FFT_TYPE_R2C);
+    if (output)
+    {
+        IFX_ERR_BRK_COND(mRows(output) != handle->range_bins, IFX_ERROR_DIMENSION_MISMATCH);
+        IFX_ERR_BRK_COND(mCols(output) != handle->doppler_bins, IFX_ERROR_DIMENSION_MISMATCH);
+    }
+
+    const uint64_t metrics_start = ifx_metrics_begin();
+
+    rdm_q15_run(handle, input, 1);
+    if (output)
+        rdm_q15_magnitude(handle, output);
+
+    ifx_metrics_end(IFX_METRICS_STAGE_RDM, metrics_start);
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_q15_run_c(ifx_RDM_Q15_t* handle,
+                       const int16_t* input,
+                       ifx_Matrix_R_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(input);
+    IFX_ERR_BRK_ARGUMENT(handle->range_fft_type != IFX_FFT_TYPE_C2C);
+    if (output)
+    {
+        IFX_ERR_BRK_COND(mRows(output) != handle->range_bins, IFX_ERROR_DIMENSION_MISMATCH);
+        IFX_ERR_BRK_COND(mCols(output) != handle->doppler_bins, IFX_ERROR_DIMENSION_MISMATCH);
+    }
+
+    const uint64_t metrics_start = ifx_metrics_begin();
+
+    rdm_q15_run(handle, input, 2);
+    if (output)
+        rdm_q15_magnitude(handle, output);
+
+    ifx_metrics_end(IFX_METRICS_STAGE_RDM, metrics_start);
+}
+
+//-----------------------------------------------------------------------------
+
+const int16_t* ifx_rdm_q15_get_spectrum(const ifx_RDM_Q15_t* handle,
+                                        const int32_t** exponents,
+                                        uint32_t* rows,
+                                        uint32_t* columns)
+{
+    IFX_ERR_BRN_NULL(handle);
+
+    if (exponents)
+        *exponents = handle->exponents;
+    if (rows)
+        *rows = handle->range_bins;
+    if (columns)
+        *columns = handle->doppler_bins;
+
+    return handle->spectrum;
+}
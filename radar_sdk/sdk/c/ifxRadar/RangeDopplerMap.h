@@ -85,6 +85,11 @@ typedef struct
     ifx_PPFFT_Config_t doppler_fft_config;   /**< Preprocessed FFT settings for Doppler FFT e.g. mean removal, FFT settings.*/
 } ifx_RDM_Config_t;
 
+/**
+ * @brief A handle for an instance of the fixed-point Range Doppler Map module, see RangeDopplerMap.h.
+ */
+typedef struct ifx_RDM_Q15_s ifx_RDM_Q15_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -315,6 +320,117 @@ void ifx_rdm_set_doppler_window(const ifx_Window_Config_t* config,
  * @}
  */
 
+/** @defgroup gr_rdm_q15 Fixed-point Range Doppler Map
+ * @brief API for a Range Doppler Map computed with 16-bit fixed-point arithmetic
+ *
+ * Computes the same range Doppler map as \ref gr_rdm from Q15 time domain
+ * data, e.g. as returned by \ref ifx_fmcw_convert_raw_data_to_q15_array for
+ * one antenna of a deinterleaved raw frame. Mean removal, windowing and both
+ * FFTs (\ref gr_fft_q15) are computed on 16-bit integers, which halves the
+ * memory traffic compared to the float path and processes twice as many
+ * samples per SIMD instruction.
+ *
+ * Each range FFT produces a block exponent. Before the Doppler FFTs the
+ * chirps are aligned to their largest exponent; each Doppler FFT then
+ * produces the exponent of one row (range bin) of the map. The spectrum is
+ * converted to float only when computing the magnitude, so the output of
+ * \ref ifx_rdm_q15_run_r and \ref ifx_rdm_q15_run_c matches the output
+ * of \ref ifx_rdm_run_r and \ref ifx_rdm_run_cr.
+ *
+ * The precision of the map is about 16 bits relative to the strongest
+ * value of each range bin, which is sufficient for the 12-bit ADCs of the
+ * supported sensors. Weak Doppler bins next to strong targets in the same
+ * range bin have a reduced dynamic range compared to the float path.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a fixed-point range Doppler map handle
+ *
+ * The configuration is the same as for \ref ifx_rdm_create. The Doppler FFT
+ * must be of type \ref IFX_FFT_TYPE_C2C. The window coefficients are
+ * converted to Q15 with their own exponent, so normalized windows keep
+ * their precision.
+ *
+ * @param [in]     config    Contains configuration for range/Doppler FFT, e.g. mean removal,
+ *                           window settings, FFT type and size.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_RDM_Q15_t* ifx_rdm_q15_create(const ifx_RDM_Config_t* config);
+
+/**
+ * @brief Destroys a fixed-point range Doppler map handle
+ *
+ * @param [in]     handle    A handle to the fixed-point range Doppler processing object
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_q15_destroy(ifx_RDM_Q15_t* handle);
+
+/**
+ * @brief Computes the range Doppler map of real Q15 input data
+ *
+ * The range FFT must be of type \ref IFX_FFT_TYPE_R2C.
+ *
+ * @param [in]     handle    A handle to the fixed-point range Doppler processing object.
+ * @param [in]     input     Real time domain data with one row of samples per chirp
+ *                           (chirps x samples per chirp values).
+ * @param [out]    output    Real matrix receiving the amplitude spectrum in linear or dB scale
+ *                           like \ref ifx_rdm_run_r. If NULL, only the fixed-point spectrum
+ *                           (see \ref ifx_rdm_q15_get_spectrum) is computed.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_q15_run_r(ifx_RDM_Q15_t* handle,
+                       const int16_t* input,
+                       ifx_Matrix_R_t* output);
+
+/**
+ * @brief Computes the range Doppler map of complex Q15 input data
+ *
+ * The range FFT must be of type \ref IFX_FFT_TYPE_C2C.
+ *
+ * @param [in]     handle    A handle to the fixed-point range Doppler processing object.
+ * @param [in]     input     Complex time domain data stored as interleaved (I, Q) pairs with
+ *                           one row of samples per chirp (2 x chirps x samples per chirp values).
+ * @param [out]    output    Real matrix receiving the amplitude spectrum in linear or dB scale
+ *                           like \ref ifx_rdm_run_cr. If NULL, only the fixed-point spectrum
+ *                           (see \ref ifx_rdm_q15_get_spectrum) is computed.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_q15_run_c(ifx_RDM_Q15_t* handle,
+                       const int16_t* input,
+                       ifx_Matrix_R_t* output);
+
+/**
+ * @brief Returns the fixed-point spectrum of the last run
+ *
+ * The spectrum has one row per range bin and one column per Doppler bin
+ * in the same (FFT shifted) layout as the output of \ref ifx_rdm_run_rc
+ * and \ref ifx_rdm_run_c respectively.
+ * Values are stored as interleaved (real, imaginary) Q15 pairs. Row r
+ * has the exponent exponents[r], i.e. the complex value q represents
+ * \f$q \cdot 2^{\mathrm{exponents}[r]-15}\f$ in the units of the float
+ * spectrum.
+ *
+ * @param [in]     handle    A handle to the fixed-point range Doppler processing object.
+ * @param [out]    exponents Receives a pointer to the exponents, one per row.
+ * @param [out]    rows      Receives the number of rows (range bins).
+ * @param [out]    columns   Receives the number of columns (Doppler bins).
+ *
+ * @return Pointer to the spectrum owned by the handle
+ */
+IFX_DLL_PUBLIC
+const int16_t* ifx_rdm_q15_get_spectrum(const ifx_RDM_Q15_t* handle,
+                                        const int32_t** exponents,
+                                        uint32_t* rows,
+                                        uint32_t* columns);
+
+/**
+ * @}
+ */
+
 /**
  * @}
  */
@@ -33,6 +33,7 @@
 ==============================================================================
 */
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -42,6 +43,7 @@
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/internal/Simd.h"
 #include "ifxBase/Math.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
@@ -60,6 +62,9 @@
 #define CLIPPING_VALUE (1e-6f)  // Corresponds to -120dB
 #define MAX_RX         (4U)     // Maximum Rx antenna are 4 for BGTATR24C
 
+/* true if the vector data can be passed to the SIMD kernels */
+#define USE_SIMD_KERNELS (sizeof(ifx_Float_t) == sizeof(float))
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -88,6 +93,18 @@ struct ifx_RS_s
     ifx_Math_Scale_Type_t output_scale_type; /**< Linear or dB scale for the output of range spectrum module.*/
     ifx_PPFFT_t* ppfft_handle;               /**< Handle to an ifx_PPFFT_t object.*/
     ifx_MTI_t* mti_handle[MAX_RX];           /**< Only used in range spectrogram function to remove static targets*/
+
+    bool fft_matrix_enabled;                 /**< If false, the FFT of each chirp is only written to fft_row.*/
+    uint32_t first_chirp;                    /**< First chirp used by the integrating modes.*/
+    uint32_t chirp_count;                    /**< Maximum number of chirps used by the integrating modes, 0 for all.*/
+    uint32_t chirp_step;                     /**< Distance between two chirps used by the integrating modes.*/
+    ifx_Vector_C_t* fft_row;                 /**< FFT output of a single chirp if the FFT matrix is disabled.
+                                                  One element longer than a spectrum for real input as muFFT
+                                                  writes the Nyquist bin, this avoids a copy in the FFT.*/
+    ifx_Vector_C_t* integ_result;            /**< Accumulator of the integrating modes.*/
+    ifx_Vector_R_t* power;                   /**< Power of the current chirp (or antenna).*/
+    ifx_Vector_R_t* power_acc;               /**< Accumulated power (non-coherent) or maximum power (max bin) per bin.*/
+    ifx_Vector_R_t* antenna_power;           /**< Accumulated power over antennas in \ref ifx_rs_run_antennas_r.*/
 };
 
 /*
@@ -102,9 +119,30 @@ struct ifx_RS_s
 ==============================================================================
 */
 
-static uint32_t get_index_of_highest_energy_r(const ifx_Matrix_R_t* input);
+static uint32_t get_chirp_count(const ifx_RS_t* handle,
+                                uint32_t num_rows);
+
+static uint32_t get_index_of_highest_energy_r(const ifx_RS_t* handle,
+                                              const ifx_Matrix_R_t* input);
+
+static uint32_t get_index_of_highest_energy_c(const ifx_RS_t* handle,
+                                              const ifx_Matrix_C_t* input);
+
+static ifx_Vector_C_t* get_fft_destination(ifx_RS_t* handle,
+                                           uint32_t chirp,
+                                           ifx_Vector_C_t* matrix_row);
 
-static uint32_t get_index_of_highest_energy_c(const ifx_Matrix_C_t* input);
+static void integ_add_chirp(ifx_RS_t* handle,
+                            const ifx_Vector_C_t* spectrum,
+                            bool first);
+
+static void integ_add_chirp_scalar(ifx_RS_t* handle,
+                                   const ifx_Vector_C_t* spectrum,
+                                   bool first);
+
+static void integ_finish(ifx_RS_t* handle,
+                         uint32_t count,
+                         ifx_Vector_C_t* output);
 
 static void coh_integ_run_rc(ifx_RS_t* handle,
                              const ifx_Matrix_R_t* input,
@@ -120,13 +158,33 @@ static void coh_integ_run_c(ifx_RS_t* handle,
 ==============================================================================
 */
 
-static uint32_t get_index_of_highest_energy_r(const ifx_Matrix_R_t* input)
+static uint32_t get_chirp_count(const ifx_RS_t* handle,
+                                uint32_t num_rows)
+{
+    if (handle->first_chirp >= num_rows)
+        return 0;
+
+    const uint32_t count = (num_rows - handle->first_chirp + handle->chirp_step - 1) / handle->chirp_step;
+
+    if (handle->chirp_count != 0 && handle->chirp_count < count)
+        return handle->chirp_count;
+
+    return count;
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t get_index_of_highest_energy_r(const ifx_RS_t* handle,
+                                              const ifx_Matrix_R_t* input)
 {
     ifx_Float_t max = 0;
-    uint32_t max_index = 0;
+    uint32_t max_index = handle->first_chirp;
+    const uint32_t count = get_chirp_count(handle, mRows(input));
 
-    for (uint32_t i = 0; i < mRows(input); i++)
+    for (uint32_t n = 0; n < count; n++)
     {
+        const uint32_t i = handle->first_chirp + n * handle->chirp_step;
+
         ifx_Vector_R_t view;
         ifx_mat_get_rowview_r(input, i, &view);
 
@@ -144,13 +202,17 @@ static uint32_t get_index_of_highest_energy_r(const ifx_Matrix_R_t* input)
 
 //----------------------------------------------------------------------------
 
-static uint32_t get_index_of_highest_energy_c(const ifx_Matrix_C_t* input)
+static uint32_t get_index_of_highest_energy_c(const ifx_RS_t* handle,
+                                              const ifx_Matrix_C_t* input)
 {
     ifx_Float_t max = 0;
-    uint32_t max_index = 0;
+    uint32_t max_index = handle->first_chirp;
+    const uint32_t count = get_chirp_count(handle, mRows(input));
 
-    for (uint32_t i = 0; i < mRows(input); i++)
+    for (uint32_t n = 0; n < count; n++)
     {
+        const uint32_t i = handle->first_chirp + n * handle->chirp_step;
+
         ifx_Vector_C_t view;
         ifx_mat_get_rowview_c(input, i, &view);
 
@@ -168,112 +230,207 @@ static uint32_t get_index_of_highest_energy_c(const ifx_Matrix_C_t* input)
 
 //----------------------------------------------------------------------------
 
-static void coh_integ_run_rc(ifx_RS_t* handle,
-                             const ifx_Matrix_R_t* input,
-                             ifx_Vector_C_t* output)
+static ifx_Vector_C_t* get_fft_destination(ifx_RS_t* handle,
+                                           uint32_t chirp,
+                                           ifx_Vector_C_t* matrix_row)
 {
-    IFX_ERR_BRK_COND(mRows(input) > mRows(handle->fft_spectrum_matrix), IFX_ERROR_DIMENSION_MISMATCH);
-
-    ifx_Vector_C_t fft_result;
-    ifx_Vector_R_t input_view;
-
-    if (handle->mode == IFX_RS_MODE_COHERENT_INTEGRATION)
+    if (handle->fft_matrix_enabled)
     {
-        ifx_Complex_t zero;
+        ifx_mat_get_rowview_c(handle->fft_spectrum_matrix, chirp, matrix_row);
+        return matrix_row;
+    }
+
+    // the same row is reused for every chirp and stays in the cache
+    return handle->fft_row;
+}
 
-        IFX_COMPLEX_SET(zero, 0, 0);
+//----------------------------------------------------------------------------
 
-        ifx_vec_setall_c(output, zero);
+static void integ_add_chirp(ifx_RS_t* handle,
+                            const ifx_Vector_C_t* spectrum,
+                            bool first)
+{
+    if (!USE_SIMD_KERNELS)
+    {
+        integ_add_chirp_scalar(handle, spectrum, first);
+        return;
     }
 
-    for (uint32_t i = 0; i < mRows(input); i++)
+    // The FFT output of one chirp is reduced into the accumulators right after
+    // it was computed, while it is still in the cache. Both spectrum and the
+    // accumulators are contiguous.
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+    const uint32_t bins = vLen(handle->integ_result);
+    const float* x = (const float*)vDat(spectrum);
+    float* acc = (float*)vDat(handle->integ_result);
+    float* power = (float*)vDat(handle->power);
+    float* power_acc = (float*)vDat(handle->power_acc);
+
+    switch (handle->mode)
     {
-        ifx_mat_get_rowview_r(input, i, &input_view);
+        case IFX_RS_MODE_MAX_BIN:
+            kernels->sqnorm_c(x, power, bins);
+            if (first)
+            {
+                memcpy(acc, x, sizeof(ifx_Complex_t) * bins);
+                memcpy(power_acc, power, sizeof(ifx_Float_t) * bins);
+                break;
+            }
+            for (uint32_t k = 0; k < bins; k++)
+            {
+                // strictly greater: the first chirp wins on equal power
+                if (power[k] > power_acc[k])
+                {
+                    power_acc[k] = power[k];
+                    acc[2 * k] = x[2 * k];
+                    acc[2 * k + 1] = x[2 * k + 1];
+                }
+            }
+            break;
+
+        case IFX_RS_MODE_NONCOHERENT_INTEGRATION:
+            if (first)
+            {
+                kernels->sqnorm_c(x, power_acc, bins);
+                break;
+            }
+            kernels->sqnorm_c(x, power, bins);
+            kernels->add_r(power_acc, power, power_acc, bins);
+            break;
+
+        default:  // IFX_RS_MODE_COHERENT_INTEGRATION
+            if (first)
+                memcpy(acc, x, sizeof(ifx_Complex_t) * bins);
+            else
+                kernels->add_r(acc, x, acc, 2 * (size_t)bins);
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------
 
-        ifx_mat_get_rowview_c(handle->fft_spectrum_matrix, i, &fft_result);
+static void integ_add_chirp_scalar(ifx_RS_t* handle,
+                                   const ifx_Vector_C_t* spectrum,
+                                   bool first)
+{
+    const uint32_t bins = vLen(handle->integ_result);
 
-        ifx_ppfft_run_rc(handle->ppfft_handle, &input_view, &fft_result);
+    for (uint32_t k = 0; k < bins; k++)
+    {
+        const ifx_Complex_t x = vAt(spectrum, k);
+        ifx_Complex_t* acc = &vAt(handle->integ_result, k);
+        const ifx_Float_t power = IFX_COMPLEX_REAL(x) * IFX_COMPLEX_REAL(x) + IFX_COMPLEX_IMAG(x) * IFX_COMPLEX_IMAG(x);
 
-        if (handle->mode == IFX_RS_MODE_COHERENT_INTEGRATION)
+        switch (handle->mode)
         {
-            ifx_vec_add_c(&fft_result, output, output);
+            case IFX_RS_MODE_MAX_BIN:
+                // strictly greater: the first chirp wins on equal power
+                if (first || power > vAt(handle->power_acc, k))
+                {
+                    vAt(handle->power_acc, k) = power;
+                    *acc = x;
+                }
+                break;
+
+            case IFX_RS_MODE_NONCOHERENT_INTEGRATION:
+                vAt(handle->power_acc, k) = first ? power : vAt(handle->power_acc, k) + power;
+                break;
+
+            default:  // IFX_RS_MODE_COHERENT_INTEGRATION
+                if (first)
+                    *acc = x;
+                else
+                    IFX_COMPLEX_SET(*acc, IFX_COMPLEX_REAL(*acc) + IFX_COMPLEX_REAL(x), IFX_COMPLEX_IMAG(*acc) + IFX_COMPLEX_IMAG(x));
+                break;
         }
     }
+}
+
+//----------------------------------------------------------------------------
+
+static void integ_finish(ifx_RS_t* handle,
+                         uint32_t count,
+                         ifx_Vector_C_t* output)
+{
+    const ifx_Float_t avg_scale = 1.0f / (ifx_Float_t)count;
 
     if (handle->mode == IFX_RS_MODE_MAX_BIN)
     {
-        for (uint32_t c = 0; c < mCols(handle->fft_spectrum_matrix); c++)
+        ifx_vec_copy_c(handle->integ_result, output);
+    }
+    else if (handle->mode == IFX_RS_MODE_NONCOHERENT_INTEGRATION)
+    {
+        for (uint32_t k = 0; k < vLen(output); k++)
         {
-            ifx_Vector_C_t view;
-
-            ifx_mat_get_colview_c(handle->fft_spectrum_matrix, c, &view);
-
-            uint32_t idx = ifx_vec_max_idx_c(&view);
-
-            vAt(output, c) = vAt(&view, idx);
+            IFX_COMPLEX_SET(vAt(output, k), sqrtf(vAt(handle->power_acc, k) * avg_scale), 0);
         }
     }
     else  // IFX_RS_MODE_COHERENT_INTEGRATION
     {
-        ifx_Float_t avg_scale = 1.0f / (ifx_Float_t)(mRows(input));
-
-        ifx_vec_scale_cr(output, avg_scale, output);
+        ifx_vec_scale_cr(handle->integ_result, avg_scale, output);
     }
 }
 
 //----------------------------------------------------------------------------
 
-static void coh_integ_run_c(ifx_RS_t* handle,
-                            const ifx_Matrix_C_t* input,
-                            ifx_Vector_C_t* output)
+static void coh_integ_run_rc(ifx_RS_t* handle,
+                             const ifx_Matrix_R_t* input,
+                             ifx_Vector_C_t* output)
 {
     IFX_ERR_BRK_COND(mRows(input) > mRows(handle->fft_spectrum_matrix), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_VEC_BRK_DIM(output, handle->integ_result);
 
-    ifx_Vector_C_t fft_result;
-    ifx_Vector_C_t input_view;
+    const uint32_t count = get_chirp_count(handle, mRows(input));
+    IFX_ERR_BRK_COND(count == 0, IFX_ERROR_DIMENSION_MISMATCH);
 
-    if (handle->mode == IFX_RS_MODE_COHERENT_INTEGRATION)
+    ifx_Vector_R_t input_view;
+    ifx_Vector_C_t matrix_row;
+
+    for (uint32_t n = 0; n < count; n++)
     {
-        ifx_Complex_t zero;
+        const uint32_t i = handle->first_chirp + n * handle->chirp_step;
 
-        IFX_COMPLEX_SET(zero, 0, 0);
+        ifx_mat_get_rowview_r(input, i, &input_view);
 
-        ifx_vec_setall_c(output, zero);
+        ifx_Vector_C_t* fft_result = get_fft_destination(handle, i, &matrix_row);
+
+        ifx_ppfft_run_rc(handle->ppfft_handle, &input_view, fft_result);
+
+        integ_add_chirp(handle, fft_result, n == 0);
     }
 
-    for (uint32_t i = 0; i < mRows(input); i++)
-    {
-        ifx_mat_get_rowview_c(input, i, &input_view);
+    integ_finish(handle, count, output);
+}
 
-        ifx_mat_get_rowview_c(handle->fft_spectrum_matrix, i, &fft_result);
+//----------------------------------------------------------------------------
 
-        ifx_ppfft_run_c(handle->ppfft_handle, &input_view, &fft_result);
+static void coh_integ_run_c(ifx_RS_t* handle,
+                            const ifx_Matrix_C_t* input,
+                            ifx_Vector_C_t* output)
+{
+    IFX_ERR_BRK_COND(mRows(input) > mRows(handle->fft_spectrum_matrix), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_VEC_BRK_DIM(output, handle->integ_result);
 
-        if (handle->mode == IFX_RS_MODE_COHERENT_INTEGRATION)
-        {
-            ifx_vec_add_c(&fft_result, output, output);
-        }
-    }
+    const uint32_t count = get_chirp_count(handle, mRows(input));
+    IFX_ERR_BRK_COND(count == 0, IFX_ERROR_DIMENSION_MISMATCH);
 
-    if (handle->mode == IFX_RS_MODE_MAX_BIN)
+    ifx_Vector_C_t input_view;
+    ifx_Vector_C_t matrix_row;
+
+    for (uint32_t n = 0; n < count; n++)
     {
-        for (uint32_t c = 0; c < mCols(handle->fft_spectrum_matrix); c++)
-        {
-            ifx_Vector_C_t view;
+        const uint32_t i = handle->first_chirp + n * handle->chirp_step;
 
-            ifx_mat_get_colview_c(handle->fft_spectrum_matrix, c, &view);
+        ifx_mat_get_rowview_c(input, i, &input_view);
 
-            uint32_t idx = ifx_vec_max_idx_c(&view);
+        ifx_Vector_C_t* fft_result = get_fft_destination(handle, i, &matrix_row);
 
-            vAt(output, c) = vAt(&view, idx);
-        }
-    }
-    else  // IFX_RS_MODE_COHERENT_INTEGRATION
-    {
-        ifx_Float_t avg_scale = 1.0f / (ifx_Float_t)(mRows(input));
+        ifx_ppfft_run_c(handle->ppfft_handle, &input_view, fft_result);
 
-        ifx_vec_scale_cr(output, avg_scale, output);
+        integ_add_chirp(handle, fft_result, n == 0);
     }
+
+    integ_finish(handle, count, output);
 }
 
 /*
@@ -303,6 +460,24 @@ ifx_RS_t* ifx_rs_create(const ifx_RS_Config_t* config)
 
     h->fft_mean_result = ifx_vec_create_c(fft_out_size);
 
+    // the real FFT writes fft_size/2 + 1 bins
+    const uint32_t fft_row_size = (config->fft_config.fft_type == IFX_FFT_TYPE_R2C) ? fft_out_size + 1 : fft_out_size;
+
+    IFX_ERR_HANDLE_N(h->fft_row = ifx_vec_create_c(fft_row_size),
+                     ifx_rs_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->integ_result = ifx_vec_create_c(fft_out_size),
+                     ifx_rs_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->power = ifx_vec_create_r(fft_out_size),
+                     ifx_rs_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->power_acc = ifx_vec_create_r(fft_out_size),
+                     ifx_rs_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->antenna_power = ifx_vec_create_r(fft_out_size),
+                     ifx_rs_destroy(h));
+
     IFX_ERR_HANDLE_N(h->fft_spectrum_matrix = ifx_mat_create_c(config->num_of_chirps_per_frame, fft_out_size),
                      ifx_rs_destroy(h));
 
@@ -323,6 +498,11 @@ ifx_RS_t* ifx_rs_create(const ifx_RS_Config_t* config)
     h->single_chirp_mode_index = 0;
     h->num_of_chirps = config->num_of_chirps_per_frame;
 
+    h->fft_matrix_enabled = true;
+    h->first_chirp = 0;
+    h->chirp_count = 0;
+    h->chirp_step = 1;
+
     h->output_scale_type = config->output_scale_type;
     h->spect_threshold = (config->spect_threshold <= CLIPPING_VALUE) ? CLIPPING_VALUE : config->spect_threshold;
 
@@ -341,6 +521,11 @@ void ifx_rs_destroy(ifx_RS_t* handle)
     ifx_ppfft_destroy(handle->ppfft_handle);
     ifx_mat_destroy_c(handle->fft_spectrum_matrix);
     ifx_vec_destroy_c(handle->fft_mean_result);
+    ifx_vec_destroy_c(handle->fft_row);
+    ifx_vec_destroy_c(handle->integ_result);
+    ifx_vec_destroy_r(handle->power);
+    ifx_vec_destroy_r(handle->power_acc);
+    ifx_vec_destroy_r(handle->antenna_power);
 
     for (uint32_t i = 0; i < MAX_RX; ++i)
     {
@@ -387,7 +572,7 @@ void ifx_rs_run_rc(ifx_RS_t* handle,
 
     if (handle->mode == IFX_RS_MODE_MAX_ENERGY)
     {
-        const uint32_t i = get_index_of_highest_energy_r(input);
+        const uint32_t i = get_index_of_highest_energy_r(handle, input);
 
         ifx_mat_get_rowview_r((ifx_Matrix_R_t*)input, i, &view_in);
 
@@ -420,7 +605,7 @@ void ifx_rs_run_c(ifx_RS_t* handle,
 
     if (handle->mode == IFX_RS_MODE_MAX_ENERGY)
     {
-        const uint32_t i = get_index_of_highest_energy_c(input);
+        const uint32_t i = get_index_of_highest_energy_c(handle, input);
 
         ifx_mat_get_rowview_c((ifx_Matrix_C_t*)input, i, &view_in);
 
@@ -463,11 +648,70 @@ void ifx_rs_run_cr(ifx_RS_t* handle,
 
 //----------------------------------------------------------------------------
 
+void ifx_rs_run_antennas_r(ifx_RS_t* handle,
+                           const ifx_Cube_R_t* frame,
+                           ifx_Vector_R_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(frame);
+    IFX_VEC_BRK_VALID(output);
+    IFX_VEC_BRK_DIM(output, handle->fft_mean_result);
+    IFX_ERR_BRK_COND(cRows(frame) == 0, IFX_ERROR_DIMENSION_MISMATCH);
+
+    const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels();
+    const uint32_t bins = vLen(handle->fft_mean_result);
+    const float* spectrum = (const float*)vDat(handle->fft_mean_result);
+    float* antenna_power = (float*)vDat(handle->antenna_power);
+    float* power = (float*)vDat(handle->power);
+
+    for (uint32_t a = 0; a < cRows(frame); a++)
+    {
+        ifx_Matrix_R_t antenna_data;
+        ifx_cube_get_row_r(frame, a, &antenna_data);
+
+        ifx_rs_run_rc(handle, &antenna_data, handle->fft_mean_result);
+
+        if (!USE_SIMD_KERNELS)
+        {
+            for (uint32_t k = 0; k < bins; k++)
+            {
+                const ifx_Complex_t x = vAt(handle->fft_mean_result, k);
+                const ifx_Float_t p = IFX_COMPLEX_REAL(x) * IFX_COMPLEX_REAL(x) + IFX_COMPLEX_IMAG(x) * IFX_COMPLEX_IMAG(x);
+                vAt(handle->antenna_power, k) = (a == 0) ? p : vAt(handle->antenna_power, k) + p;
+            }
+        }
+        else if (a == 0)
+        {
+            kernels->sqnorm_c(spectrum, antenna_power, bins);
+        }
+        else
+        {
+            kernels->sqnorm_c(spectrum, power, bins);
+            kernels->add_r(antenna_power, power, antenna_power, bins);
+        }
+    }
+
+    const ifx_Float_t avg_scale = 1.0f / (ifx_Float_t)cRows(frame);
+    for (uint32_t k = 0; k < bins; k++)
+    {
+        vAt(output, k) = sqrtf(vAt(handle->antenna_power, k) * avg_scale);
+    }
+
+    ifx_math_vec_clip_lt_threshold_r(output, handle->spect_threshold, CLIPPING_VALUE, output);
+
+    if (handle->output_scale_type != IFX_SCALE_TYPE_LINEAR)
+    {
+        ifx_vec_linear_to_dB(output, handle->output_scale_type, output);
+    }
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_rs_set_mode(ifx_RS_t* handle,
                      const ifx_RS_Mode_t mode)
 {
     IFX_ERR_BRK_NULL(handle);
-    IFX_ERR_BRK_ARGUMENT(mode > 3);
+    IFX_ERR_BRK_ARGUMENT(mode > IFX_RS_MODE_NONCOHERENT_INTEGRATION);
 
     handle->mode = mode;
 }
@@ -501,6 +745,39 @@ uint32_t ifx_rs_get_single_chirp_mode_index(const ifx_RS_t* handle)
 
 //----------------------------------------------------------------------------
 
+void ifx_rs_set_chirp_subset(ifx_RS_t* handle,
+                             uint32_t first,
+                             uint32_t count,
+                             uint32_t step)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_ARGUMENT(step == 0);
+    IFX_ERR_BRK_COND(first >= handle->num_of_chirps, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    handle->first_chirp = first;
+    handle->chirp_count = count;
+    handle->chirp_step = step;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rs_set_fft_matrix_enabled(ifx_RS_t* handle,
+                                   bool enabled)
+{
+    IFX_ERR_BRK_NULL(handle);
+    handle->fft_matrix_enabled = enabled;
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_rs_get_fft_matrix_enabled(const ifx_RS_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, false);
+    return handle->fft_matrix_enabled;
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_rs_set_output_scale_type(ifx_RS_t* handle,
                                   const ifx_Math_Scale_Type_t output_scale_type)
 {
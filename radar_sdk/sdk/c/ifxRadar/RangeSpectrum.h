@@ -47,6 +47,7 @@
 #include "ifxAlgo/PreprocessedFFT.h"
 #include "ifxAlgo/Window.h"
 
+#include "ifxBase/Cube.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Types.h"
 #include "ifxBase/Vector.h"
@@ -93,7 +94,12 @@ typedef enum
     IFX_RS_MODE_MAX_ENERGY = 2U,
 
     /** The range spectrum will be calculated for every chirp, the maximum bin per column is considered. */
-    IFX_RS_MODE_MAX_BIN = 3U
+    IFX_RS_MODE_MAX_BIN = 3U,
+
+    /** The range spectrum is calculated as a non-coherent integration of all chirps in a frame, i.e. the
+     *  mean power of each bin over all chirps. The complex output holds the root of the mean power
+     *  as real part and zero as imaginary part. */
+    IFX_RS_MODE_NONCOHERENT_INTEGRATION = 4U
 } ifx_RS_Mode_t;
 
 /**
@@ -271,6 +277,25 @@ void ifx_rs_run_cr(ifx_RS_t* handle,
                    const ifx_Matrix_C_t* input,
                    ifx_Vector_R_t* output);
 
+/**
+ * @brief Performs range spectrum processing on a real frame with several antennas and integrates the
+ *        antennas non-coherently.
+ *
+ * For each antenna (row of the frame cube) the complex range spectrum is computed in the current mode as in
+ * \ref ifx_rs_run_rc. The powers of the antenna spectra are averaged and the root of the mean power is
+ * thresholded and scaled as in \ref ifx_rs_run_r. After this call the FFT matrix of the handle
+ * (see \ref ifx_rs_copy_fft_matrix) holds the spectra of the last antenna.
+ *
+ * @param [in]     handle    A handle to the range spectrum processing object
+ * @param [in]     frame     Real frame cube with antennas as rows, chirps as columns and samples as slices
+ * @param [out]    output    Real vector of absolute magnitude spectrum of FFT size
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_rs_run_antennas_r(ifx_RS_t* handle,
+                           const ifx_Cube_R_t* frame,
+                           ifx_Vector_R_t* output);
+
 /**
  * @brief Configures at runtime, the range spectrum mode in the handle. This helps
  *        not to create a new handle for new mode.
@@ -318,6 +343,53 @@ void ifx_rs_set_single_chirp_mode_index(ifx_RS_t* handle,
 IFX_DLL_PUBLIC
 uint32_t ifx_rs_get_single_chirp_mode_index(const ifx_RS_t* handle);
 
+/**
+ * @brief Selects the chirps used by the integrating modes (\ref IFX_RS_MODE_COHERENT_INTEGRATION,
+ *        \ref IFX_RS_MODE_MAX_BIN, \ref IFX_RS_MODE_NONCOHERENT_INTEGRATION) and by the search in
+ *        \ref IFX_RS_MODE_MAX_ENERGY.
+ *
+ * The chirps first, first + step, first + 2*step, ... are used, at most count chirps. By default all chirps
+ * of the frame are used (first = 0, count = 0, step = 1).
+ *
+ * @param [in]     handle    A handle to the range spectrum processing object
+ * @param [in]     first     Index of the first chirp
+ * @param [in]     count     Maximum number of chirps, 0 to use all chirps up to the end of the frame
+ * @param [in]     step      Distance between two used chirps, must be non-zero
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_rs_set_chirp_subset(ifx_RS_t* handle,
+                             uint32_t first,
+                             uint32_t count,
+                             uint32_t step);
+
+/**
+ * @brief Enables or disables storing the FFT of every chirp in the FFT matrix of the handle.
+ *
+ * The integrating modes reduce the FFT output of each chirp directly into the result. The full
+ * FFT matrix (chirps x bins) is only stored if enabled, which is required to read it with
+ * \ref ifx_rs_copy_fft_matrix. Disabling it avoids writing and reading back the matrix for
+ * every frame. By default the FFT matrix is enabled.
+ *
+ * @param [in]     handle    A handle to the range spectrum processing object
+ * @param [in]     enabled   If true the FFT matrix is stored
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_rs_set_fft_matrix_enabled(ifx_RS_t* handle,
+                                   bool enabled);
+
+/**
+ * @brief Returns true if the FFT matrix is stored, see \ref ifx_rs_set_fft_matrix_enabled.
+ *
+ * @param [in]     handle    A handle to the range spectrum processing object
+ *
+ * @return True if the FFT matrix is stored.
+ *
+ */
+IFX_DLL_PUBLIC
+bool ifx_rs_get_fft_matrix_enabled(const ifx_RS_t* handle);
+
 /**
  * @brief Configure at runtime, the range spectrum output to linear or dB scale in the handle.
  *
@@ -359,7 +431,9 @@ void ifx_rs_set_window(ifx_RS_t* handle,
  * @brief Copies the range spectrum matrix from range spectrum handle to the specified output container.
  *        Output matrix contains;
  *        1. Only single row containing FFT transform at the selected index in IFX_RS_MODE_SINGLE_CHIRP
- *        2. Fully populated matrix with FFT transforms in IFX_RS_MODE_COHERENT_INTEGRATION
+ *        2. Fully populated matrix with FFT transforms in IFX_RS_MODE_COHERENT_INTEGRATION,
+ *           IFX_RS_MODE_MAX_BIN and IFX_RS_MODE_NONCOHERENT_INTEGRATION (only the rows of the
+ *           selected chirps, and only if enabled, see \ref ifx_rs_set_fft_matrix_enabled)
  *        3. Only single row containing FFT transform at the Maximum Energy index in IFX_RS_MODE_MAX_ENERGY
  *
  * @param [in]     handle    A handle to the range spectrum processing object
@@ -0,0 +1,812 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+
+#include "ifxRadar/Tracker.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/* maximum state dimension per axis (position, rate, acceleration) */
+#define MAX_DIM 3
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/* Kalman filter of one axis */
+typedef struct
+{
+    ifx_Float_t x[MAX_DIM];          /**< State (position, rate, acceleration).*/
+    ifx_Float_t P[MAX_DIM][MAX_DIM]; /**< State covariance.*/
+} Axis_t;
+
+typedef struct
+{
+    Axis_t range; /**< Range axis, measured by range and radial speed.*/
+    Axis_t angle; /**< Angle axis, measured by angle.*/
+
+    ifx_Float_t s_inv_range[2][2]; /**< Inverse innovation covariance of the range axis after prediction.*/
+    ifx_Float_t s_angle;           /**< Innovation variance of the angle axis after prediction.*/
+    ifx_Float_t log_det_s;         /**< Logarithm of the determinant of the full innovation covariance.*/
+
+    uint32_t id;
+    ifx_Track_State_t state;
+    uint32_t events;
+    int32_t detection;
+    uint32_t age;
+    uint32_t hits;
+    uint32_t misses;
+} Track_t;
+
+/**
+ * @brief Defines the structure for the tracker module.
+ *        Use type ifx_Tracker_t for this struct.
+ */
+struct ifx_Tracker_s
+{
+    ifx_Tracker_Config_t config;
+    uint32_t dim; /**< State dimension per axis (2 or 3).*/
+
+    ifx_Float_t F[MAX_DIM][MAX_DIM];       /**< State transition for one frame period.*/
+    ifx_Float_t Q_range[MAX_DIM][MAX_DIM]; /**< Process noise of the range axis.*/
+    ifx_Float_t Q_angle[MAX_DIM][MAX_DIM]; /**< Process noise of the angle axis.*/
+
+    Track_t* tracks;      /**< Live tracks in order of birth (and therefore id), max_tracks entries.*/
+    uint32_t num_tracks;  /**< Number of live tracks.*/
+    uint32_t next_id;     /**< Id of the next track born.*/
+
+    ifx_Tracker_Track_t* output; /**< Result array, 2 * max_tracks entries.*/
+
+    /* association, all preallocated for max_tracks and max_detections */
+    ifx_Float_t* distance;    /**< Squared Mahalanobis distances, num_tracks x num_detections.*/
+    int32_t* track_to_det;    /**< Associated detection of each track, -1 if none.*/
+    uint8_t* det_assigned;    /**< Non-zero if a detection was associated to a track.*/
+    uint8_t* track_visited;   /**< Tracks already assigned to a cluster.*/
+    uint8_t* det_visited;     /**< Detections already assigned to a cluster.*/
+    uint32_t* queue;          /**< Search queue for clusters, max_tracks + max_detections entries.*/
+    uint32_t* rows;           /**< Tracks of the current cluster.*/
+    uint32_t* cols;           /**< Detections of the current cluster.*/
+    ifx_Float_t* cost;        /**< Cost matrix of the assignment problem.*/
+    ifx_Float_t* u;           /**< Row potentials of the Hungarian algorithm.*/
+    ifx_Float_t* v;           /**< Column potentials of the Hungarian algorithm.*/
+    ifx_Float_t* minv;        /**< Minimum reduced cost per column.*/
+    uint32_t* p;              /**< Row assigned to each column.*/
+    uint32_t* way;            /**< Previous column on the augmenting path.*/
+    uint8_t* used;            /**< Columns visited in the current augmentation.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static void init_axis(Axis_t* axis, uint32_t dim, ifx_Float_t position, ifx_Float_t rate,
+                      const ifx_Float_t variance[MAX_DIM]);
+
+static void predict_axis(const ifx_Tracker_t* h, Axis_t* axis, ifx_Float_t Q[MAX_DIM][MAX_DIM]);
+
+static void update_range(const ifx_Tracker_t* h, Track_t* track, const ifx_Tracker_Detection_t* detection);
+
+static void update_angle(const ifx_Tracker_t* h, Track_t* track, const ifx_Tracker_Detection_t* detection);
+
+static void predict_track(ifx_Tracker_t* h, Track_t* track);
+
+static ifx_Float_t mahalanobis(const Track_t* track, const ifx_Tracker_Detection_t* detection);
+
+static void solve_assignment(ifx_Tracker_t* h, uint32_t n);
+
+static void solve_cluster(ifx_Tracker_t* h, uint32_t num_rows, uint32_t num_cols, uint32_t num_detections);
+
+static void associate(ifx_Tracker_t* h, const ifx_Tracker_Detection_t* detections, uint32_t num_detections);
+
+static void birth(ifx_Tracker_t* h, const ifx_Tracker_Detection_t* detection, int32_t index);
+
+static void to_output(const ifx_Tracker_t* h, const Track_t* track, ifx_Tracker_Track_t* out);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static void init_axis(Axis_t* axis, uint32_t dim, ifx_Float_t position, ifx_Float_t rate,
+                      const ifx_Float_t variance[MAX_DIM])
+{
+    memset(axis, 0, sizeof(*axis));
+    axis->x[0] = position;
+    axis->x[1] = rate;
+    for (uint32_t i = 0; i < dim; i++)
+        axis->P[i][i] = variance[i];
+}
+
+//----------------------------------------------------------------------------
+
+static void predict_axis(const ifx_Tracker_t* h, Axis_t* axis, ifx_Float_t Q[MAX_DIM][MAX_DIM])
+{
+    const uint32_t n = h->dim;
+    ifx_Float_t x[MAX_DIM] = {0};
+    ifx_Float_t FP[MAX_DIM][MAX_DIM] = {{0}};
+
+    // x = F * x, F is upper triangular
+    for (uint32_t i = 0; i < n; i++)
+        for (uint32_t k = i; k < n; k++)
+            x[i] += h->F[i][k] * axis->x[k];
+
+    // P = F * P * F' + Q
+    for (uint32_t i = 0; i < n; i++)
+        for (uint32_t j = 0; j < n; j++)
+            for (uint32_t k = i; k < n; k++)
+                FP[i][j] += h->F[i][k] * axis->P[k][j];
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        axis->x[i] = x[i];
+        for (uint32_t j = i; j < n; j++)
+        {
+            ifx_Float_t sum = Q[i][j];
+            for (uint32_t k = j; k < n; k++)
+                sum += FP[i][k] * h->F[j][k];
+            axis->P[i][j] = sum;
+            axis->P[j][i] = sum;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void update_range(const ifx_Tracker_t* h, Track_t* track, const ifx_Tracker_Detection_t* detection)
+{
+    Axis_t* axis = &track->range;
+    const uint32_t n = (h->dim < MAX_DIM) ? h->dim : MAX_DIM; // dim is 2 or 3, the bound silences gcc -Wmaybe-uninitialized
+    const ifx_Float_t y0 = detection->range_m - axis->x[0];
+    const ifx_Float_t y1 = detection->speed_m_s - axis->x[1];
+    ifx_Float_t K[MAX_DIM][2];
+    ifx_Float_t HP[2][MAX_DIM];
+
+    // K = P * H' * inv(S), H selects range and speed
+    for (uint32_t i = 0; i < n; i++)
+    {
+        K[i][0] = axis->P[i][0] * track->s_inv_range[0][0] + axis->P[i][1] * track->s_inv_range[1][0];
+        K[i][1] = axis->P[i][0] * track->s_inv_range[0][1] + axis->P[i][1] * track->s_inv_range[1][1];
+        HP[0][i] = axis->P[0][i];
+        HP[1][i] = axis->P[1][i];
+    }
+
+    // x = x + K * y, P = P - K * H * P
+    for (uint32_t i = 0; i < n; i++)
+    {
+        axis->x[i] += K[i][0] * y0 + K[i][1] * y1;
+        for (uint32_t j = i; j < n; j++)
+        {
+            const ifx_Float_t value = axis->P[i][j] - (K[i][0] * HP[0][j] + K[i][1] * HP[1][j]);
+            axis->P[i][j] = value;
+            axis->P[j][i] = value;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void update_angle(const ifx_Tracker_t* h, Track_t* track, const ifx_Tracker_Detection_t* detection)
+{
+    Axis_t* axis = &track->angle;
+    const uint32_t n = h->dim;
+    const ifx_Float_t y = detection->angle_deg - axis->x[0];
+    ifx_Float_t K[MAX_DIM];
+    ifx_Float_t HP[MAX_DIM];
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        K[i] = axis->P[i][0] / track->s_angle;
+        HP[i] = axis->P[0][i];
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        axis->x[i] += K[i] * y;
+        for (uint32_t j = i; j < n; j++)
+        {
+            const ifx_Float_t value = axis->P[i][j] - K[i] * HP[j];
+            axis->P[i][j] = value;
+            axis->P[j][i] = value;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void predict_track(ifx_Tracker_t* h, Track_t* track)
+{
+    const ifx_Tracker_Config_t* c = &h->config;
+
+    predict_axis(h, &track->range, h->Q_range);
+    predict_axis(h, &track->angle, h->Q_angle);
+
+    // innovation covariances used for gating and the update
+    const ifx_Float_t s00 = track->range.P[0][0] + c->range_std_m * c->range_std_m;
+    const ifx_Float_t s01 = track->range.P[0][1];
+    const ifx_Float_t s11 = track->range.P[1][1] + c->speed_std_m_s * c->speed_std_m_s;
+    const ifx_Float_t det = s00 * s11 - s01 * s01;
+
+    track->s_inv_range[0][0] = s11 / det;
+    track->s_inv_range[0][1] = -s01 / det;
+    track->s_inv_range[1][0] = -s01 / det;
+    track->s_inv_range[1][1] = s00 / det;
+    track->s_angle = track->angle.P[0][0] + c->angle_std_deg * c->angle_std_deg;
+    track->log_det_s = logf(det * track->s_angle);
+
+    track->age++;
+    track->events = 0;
+    track->detection = -1;
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Float_t mahalanobis(const Track_t* track, const ifx_Tracker_Detection_t* detection)
+{
+    const ifx_Float_t y0 = detection->range_m - track->range.x[0];
+    const ifx_Float_t y1 = detection->speed_m_s - track->range.x[1];
+    const ifx_Float_t ya = detection->angle_deg - track->angle.x[0];
+
+    return y0 * (track->s_inv_range[0][0] * y0 + 2 * track->s_inv_range[0][1] * y1)
+           + y1 * track->s_inv_range[1][1] * y1
+           + ya * ya / track->s_angle;
+}
+
+//----------------------------------------------------------------------------
+
+/*
+ * Hungarian algorithm (shortest augmenting paths with potentials) for the
+ * square n x n matrix h->cost. Afterwards h->p[j] (1-based) is the row
+ * assigned to column j.
+ */
+static void solve_assignment(ifx_Tracker_t* h, uint32_t n)
+{
+    ifx_Float_t* u = h->u;
+    ifx_Float_t* v = h->v;
+    ifx_Float_t* minv = h->minv;
+    uint32_t* p = h->p;
+    uint32_t* way = h->way;
+    uint8_t* used = h->used;
+
+    for (uint32_t j = 0; j <= n; j++)
+    {
+        u[j] = 0;
+        v[j] = 0;
+        p[j] = 0;
+        way[j] = 0;
+    }
+
+    for (uint32_t i = 1; i <= n; i++)
+    {
+        uint32_t j0 = 0;
+        p[0] = i;
+        for (uint32_t j = 0; j <= n; j++)
+        {
+            minv[j] = INFINITY;
+            used[j] = 0;
+        }
+
+        do
+        {
+            const uint32_t i0 = p[j0];
+            const ifx_Float_t* row = &h->cost[(i0 - 1) * n];
+            ifx_Float_t delta = INFINITY;
+            uint32_t j1 = 0;
+
+            used[j0] = 1;
+            for (uint32_t j = 1; j <= n; j++)
+            {
+                if (used[j])
+                    continue;
+
+                const ifx_Float_t reduced = row[j - 1] - u[i0] - v[j];
+                if (reduced < minv[j])
+                {
+                    minv[j] = reduced;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta)
+                {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+
+            for (uint32_t j = 0; j <= n; j++)
+            {
+                if (used[j])
+                {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                }
+                else
+                {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+
+        do
+        {
+            const uint32_t j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/*
+ * Solves the assignment problem of one cluster of tracks (h->rows) and
+ * detections (h->cols) connected by gated pairs.
+ *
+ * The cost of a pair is the generalized distance d^2 + ln|S|. Without the
+ * determinant a young track with a large covariance would win detections
+ * from an established track nearby. Missing is never cheaper than taking
+ * a detection inside the gate, so the assignment contains as many pairs
+ * as possible and among those the one with minimum total cost is chosen.
+ */
+static void solve_cluster(ifx_Tracker_t* h, uint32_t num_rows, uint32_t num_cols, uint32_t num_detections)
+{
+    const ifx_Float_t gate = h->config.gate_threshold;
+
+    if (num_rows == 1 && num_cols == 1)
+    {
+        h->track_to_det[h->rows[0]] = (int32_t)h->cols[0];
+        h->det_assigned[h->cols[0]] = 1;
+        return;
+    }
+
+    // shift the determinant terms, so all pair costs are within [0, max_pair]
+    ifx_Float_t log_det_min = h->tracks[h->rows[0]].log_det_s;
+    ifx_Float_t log_det_max = log_det_min;
+    for (uint32_t r = 1; r < num_rows; r++)
+    {
+        const ifx_Float_t log_det = h->tracks[h->rows[r]].log_det_s;
+        log_det_min = (log_det < log_det_min) ? log_det : log_det_min;
+        log_det_max = (log_det > log_det_max) ? log_det : log_det_max;
+    }
+
+    // Square problem with one dummy column per track (track misses) and one
+    // dummy row per detection (detection starts a new track). Forbidden
+    // entries cost more than the solution without any association.
+    const uint32_t n = num_rows + num_cols;
+    const ifx_Float_t max_pair = gate + (log_det_max - log_det_min);
+    const ifx_Float_t miss = max_pair / 2;
+    const ifx_Float_t forbidden = max_pair * (ifx_Float_t)(n + 1);
+
+    for (uint32_t r = 0; r < n; r++)
+    {
+        ifx_Float_t* row = &h->cost[r * n];
+        for (uint32_t c = 0; c < n; c++)
+        {
+            ifx_Float_t value;
+            if (r < num_rows && c < num_cols)
+            {
+                const Track_t* track = &h->tracks[h->rows[r]];
+                value = h->distance[h->rows[r] * num_detections + h->cols[c]];
+                value = (value < gate) ? value + (track->log_det_s - log_det_min) : forbidden;
+            }
+            else if (r < num_rows)
+                value = (c - num_cols == r) ? miss : forbidden;
+            else if (c < num_cols)
+                value = (r - num_rows == c) ? miss : forbidden;
+            else
+                value = 0;
+            row[c] = value;
+        }
+    }
+
+    solve_assignment(h, n);
+
+    for (uint32_t c = 1; c <= num_cols; c++)
+    {
+        const uint32_t r = h->p[c];
+        if (r == 0 || r > num_rows)
+            continue;
+
+        const uint32_t track = h->rows[r - 1];
+        const uint32_t detection = h->cols[c - 1];
+        if (h->distance[track * num_detections + detection] < gate)
+        {
+            h->track_to_det[track] = (int32_t)detection;
+            h->det_assigned[detection] = 1;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/*
+ * Global nearest neighbour association. Each track can take one detection
+ * inside its gate or miss, each detection can be taken by one track or
+ * start a new one.
+ *
+ * Tracks and detections are split into clusters connected by pairs inside
+ * the gate; the clusters are independent and solved one by one, which
+ * keeps the cubic assignment cost small for well separated targets.
+ */
+static void associate(ifx_Tracker_t* h, const ifx_Tracker_Detection_t* detections, uint32_t num_detections)
+{
+    const ifx_Float_t gate = h->config.gate_threshold;
+    const uint32_t num_tracks = h->num_tracks;
+    const uint32_t max_tracks = h->config.max_tracks;
+
+    memset(h->det_assigned, 0, num_detections * sizeof(uint8_t));
+    memset(h->track_visited, 0, num_tracks * sizeof(uint8_t));
+    memset(h->det_visited, 0, num_detections * sizeof(uint8_t));
+
+    for (uint32_t i = 0; i < num_tracks; i++)
+    {
+        ifx_Float_t* distance = &h->distance[i * num_detections];
+
+        h->track_to_det[i] = -1;
+        for (uint32_t j = 0; j < num_detections; j++)
+            distance[j] = mahalanobis(&h->tracks[i], &detections[j]);
+    }
+
+    // breadth first search over the gated pairs; tracks are queued with
+    // their index, detections with max_tracks + their index
+    for (uint32_t i = 0; i < num_tracks; i++)
+    {
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        uint32_t num_rows = 0;
+        uint32_t num_cols = 0;
+
+        if (h->track_visited[i])
+            continue;
+
+        h->track_visited[i] = 1;
+        h->queue[tail++] = i;
+        while (head < tail)
+        {
+            const uint32_t node = h->queue[head++];
+            if (node < max_tracks)
+            {
+                const ifx_Float_t* distance = &h->distance[node * num_detections];
+                h->rows[num_rows++] = node;
+                for (uint32_t j = 0; j < num_detections; j++)
+                {
+                    if (!h->det_visited[j] && distance[j] < gate)
+                    {
+                        h->det_visited[j] = 1;
+                        h->queue[tail++] = max_tracks + j;
+                    }
+                }
+            }
+            else
+            {
+                const uint32_t j = node - max_tracks;
+                h->cols[num_cols++] = j;
+                for (uint32_t t = 0; t < num_tracks; t++)
+                {
+                    if (!h->track_visited[t] && h->distance[t * num_detections + j] < gate)
+                    {
+                        h->track_visited[t] = 1;
+                        h->queue[tail++] = t;
+                    }
+                }
+            }
+        }
+
+        if (num_cols > 0)
+            solve_cluster(h, num_rows, num_cols, num_detections);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void birth(ifx_Tracker_t* h, const ifx_Tracker_Detection_t* detection, int32_t index)
+{
+    const ifx_Tracker_Config_t* c = &h->config;
+    Track_t* track = &h->tracks[h->num_tracks++];
+    const ifx_Float_t range_variance[MAX_DIM] = {
+        c->range_std_m * c->range_std_m,
+        c->speed_std_m_s * c->speed_std_m_s,
+        c->accel_init_std * c->accel_init_std};
+    const ifx_Float_t angle_variance[MAX_DIM] = {
+        c->angle_std_deg * c->angle_std_deg,
+        c->angle_rate_init_std * c->angle_rate_init_std,
+        c->angle_accel_init_std * c->angle_accel_init_std};
+
+    memset(track, 0, sizeof(*track));
+    init_axis(&track->range, h->dim, detection->range_m, detection->speed_m_s, range_variance);
+    init_axis(&track->angle, h->dim, detection->angle_deg, 0, angle_variance);
+
+    track->id = h->next_id++;
+    track->state = IFX_TRACK_TENTATIVE;
+    track->detection = index;
+    track->hits = 1;
+
+    if (track->hits >= c->confirm_hits)
+    {
+        track->state = IFX_TRACK_CONFIRMED;
+        track->events = IFX_TRACK_EVENT_CONFIRMED;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void to_output(const ifx_Tracker_t* h, const Track_t* track, ifx_Tracker_Track_t* out)
+{
+    out->id = track->id;
+    out->state = track->state;
+    out->events = track->events;
+    out->detection = track->detection;
+    out->range_m = track->range.x[0];
+    out->speed_m_s = track->range.x[1];
+    out->accel_m_s2 = (h->dim > 2) ? track->range.x[2] : 0;
+    out->angle_deg = track->angle.x[0];
+    out->angle_rate_deg_s = track->angle.x[1];
+    out->range_std_m = sqrtf(track->range.P[0][0]);
+    out->angle_std_deg = sqrtf(track->angle.P[0][0]);
+    out->age = track->age;
+    out->hits = track->hits;
+    out->misses = track->misses;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Tracker_t* ifx_tracker_create(const ifx_Tracker_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->model != IFX_TRACKER_MODEL_CONSTANT_VELOCITY
+                         && config->model != IFX_TRACKER_MODEL_CONSTANT_ACCELERATION);
+    IFX_ERR_BRN_ARGUMENT(!(config->frame_period_s > 0));
+    IFX_ERR_BRN_ARGUMENT(config->max_tracks == 0 || config->max_tracks > UINT16_MAX);
+    IFX_ERR_BRN_ARGUMENT(config->max_detections == 0 || config->max_detections > UINT16_MAX);
+    IFX_ERR_BRN_ARGUMENT(!(config->range_std_m > 0) || !(config->speed_std_m_s > 0) || !(config->angle_std_deg > 0));
+    IFX_ERR_BRN_ARGUMENT(!(config->range_process_std >= 0) || !(config->angle_process_std >= 0));
+    IFX_ERR_BRN_ARGUMENT(!(config->angle_rate_init_std >= 0) || !(config->accel_init_std >= 0)
+                         || !(config->angle_accel_init_std >= 0));
+    IFX_ERR_BRN_ARGUMENT(!(config->gate_threshold > 0));
+    IFX_ERR_BRN_ARGUMENT(config->confirm_hits == 0 || config->max_misses == 0);
+
+    ifx_Tracker_t* h = ifx_mem_calloc(1, sizeof(struct ifx_Tracker_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->config = *config;
+    h->dim = (config->model == IFX_TRACKER_MODEL_CONSTANT_ACCELERATION) ? 3 : 2;
+    h->next_id = 1;
+
+    // F(i, j) = dt^(j-i) / (j-i)!; the process noise enters through the
+    // highest derivative: Q = q^2 * g * g' with g = [dt^n/n!, ..., dt]
+    const ifx_Float_t dt = config->frame_period_s;
+    const ifx_Float_t powers[MAX_DIM + 1] = {1, dt, dt * dt / 2, dt * dt * dt / 6};
+    const uint32_t n = h->dim;
+    ifx_Float_t g[MAX_DIM];
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        for (uint32_t j = i; j < n; j++)
+            h->F[i][j] = powers[j - i];
+        g[i] = powers[n - i];
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        for (uint32_t j = 0; j < n; j++)
+        {
+            h->Q_range[i][j] = config->range_process_std * config->range_process_std * g[i] * g[j];
+            h->Q_angle[i][j] = config->angle_process_std * config->angle_process_std * g[i] * g[j];
+        }
+    }
+
+    const size_t max_tracks = config->max_tracks;
+    const size_t max_detections = config->max_detections;
+    const size_t max_n = max_tracks + max_detections;
+
+    h->tracks = ifx_mem_calloc(max_tracks, sizeof(Track_t));
+    h->output = ifx_mem_calloc(2 * max_tracks, sizeof(ifx_Tracker_Track_t));
+    h->distance = ifx_mem_calloc(max_tracks * max_detections, sizeof(ifx_Float_t));
+    h->track_to_det = ifx_mem_calloc(max_tracks, sizeof(int32_t));
+    h->det_assigned = ifx_mem_calloc(max_detections, sizeof(uint8_t));
+    h->track_visited = ifx_mem_calloc(max_tracks, sizeof(uint8_t));
+    h->det_visited = ifx_mem_calloc(max_detections, sizeof(uint8_t));
+    h->queue = ifx_mem_calloc(max_n, sizeof(uint32_t));
+    h->rows = ifx_mem_calloc(max_tracks, sizeof(uint32_t));
+    h->cols = ifx_mem_calloc(max_detections, sizeof(uint32_t));
+    h->cost = ifx_mem_calloc(max_n * max_n, sizeof(ifx_Float_t));
+    h->u = ifx_mem_calloc(max_n + 1, sizeof(ifx_Float_t));
+    h->v = ifx_mem_calloc(max_n + 1, sizeof(ifx_Float_t));
+    h->minv = ifx_mem_calloc(max_n + 1, sizeof(ifx_Float_t));
+    h->p = ifx_mem_calloc(max_n + 1, sizeof(uint32_t));
+    h->way = ifx_mem_calloc(max_n + 1, sizeof(uint32_t));
+    h->used = ifx_mem_calloc(max_n + 1, sizeof(uint8_t));
+
+    if (h->tracks == NULL
+        || h->output == NULL
+        || h->distance == NULL
+        || h->track_to_det == NULL
+        || h->det_assigned == NULL
+        || h->track_visited == NULL
+        || h->det_visited == NULL
+        || h->queue == NULL
+        || h->rows == NULL
+        || h->cols == NULL
+        || h->cost == NULL
+        || h->u == NULL
+        || h->v == NULL
+        || h->minv == NULL
+        || h->p == NULL
+        || h->way == NULL
+        || h->used == NULL)
+    {
+        ifx_tracker_destroy(h);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_tracker_destroy(ifx_Tracker_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_mem_free(handle->tracks);
+    ifx_mem_free(handle->output);
+    ifx_mem_free(handle->distance);
+    ifx_mem_free(handle->track_to_det);
+    ifx_mem_free(handle->det_assigned);
+    ifx_mem_free(handle->track_visited);
+    ifx_mem_free(handle->det_visited);
+    ifx_mem_free(handle->queue);
+    ifx_mem_free(handle->rows);
+    ifx_mem_free(handle->cols);
+    ifx_mem_free(handle->cost);
+    ifx_mem_free(handle->u);
+    ifx_mem_free(handle->v);
+    ifx_mem_free(handle->minv);
+    ifx_mem_free(handle->p);
+    ifx_mem_free(handle->way);
+    ifx_mem_free(handle->used);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_tracker_run(ifx_Tracker_t* handle,
+                     const ifx_Tracker_Detection_t* detections,
+                     uint32_t num_detections,
+                     ifx_Tracker_Result_t* result)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(result);
+    IFX_ERR_BRK_COND(num_detections > handle->config.max_detections, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    IFX_ERR_BRK_COND(num_detections > 0 && detections == NULL, IFX_ERROR_ARGUMENT_NULL);
+
+    const ifx_Tracker_Config_t* c = &handle->config;
+    const uint32_t max_tracks = c->max_tracks;
+    uint32_t num_deleted = 0;
+    uint32_t num_live = 0;
+
+    for (uint32_t i = 0; i < handle->num_tracks; i++)
+        predict_track(handle, &handle->tracks[i]);
+
+    associate(handle, detections, num_detections);
+
+    // update, confirm and delete; the live tracks are compacted in place so
+    // they stay ordered by id
+    for (uint32_t i = 0; i < handle->num_tracks; i++)
+    {
+        Track_t* track = &handle->tracks[i];
+        const int32_t detection = handle->track_to_det[i];
+
+        if (detection >= 0)
+        {
+            update_range(handle, track, &detections[detection]);
+            update_angle(handle, track, &detections[detection]);
+            track->detection = detection;
+            track->hits++;
+            track->misses = 0;
+            if (track->state == IFX_TRACK_TENTATIVE && track->hits >= c->confirm_hits)
+            {
+                track->state = IFX_TRACK_CONFIRMED;
+                track->events |= IFX_TRACK_EVENT_CONFIRMED;
+            }
+        }
+        else
+        {
+            track->misses++;
+            if (track->state == IFX_TRACK_TENTATIVE || track->misses >= c->max_misses)
+            {
+                track->state = IFX_TRACK_DELETED;
+                track->events |= IFX_TRACK_EVENT_DELETED;
+                to_output(handle, track, &handle->output[max_tracks + num_deleted++]);
+                continue;
+            }
+        }
+
+        if (num_live != i)
+            handle->tracks[num_live] = *track;
+        num_live++;
+    }
+    handle->num_tracks = num_live;
+
+    // unassociated detections start new tracks while there is space
+    for (uint32_t j = 0; j < num_detections && handle->num_tracks < max_tracks; j++)
+    {
+        if (!handle->det_assigned[j])
+            birth(handle, &detections[j], (int32_t)j);
+    }
+
+    for (uint32_t i = 0; i < handle->num_tracks; i++)
+        to_output(handle, &handle->tracks[i], &handle->output[i]);
+
+    if (num_deleted > 0 && handle->num_tracks < max_tracks)
+        memmove(&handle->output[handle->num_tracks], &handle->output[max_tracks], num_deleted * sizeof(ifx_Tracker_Track_t));
+
+    result->num_tracks = handle->num_tracks + num_deleted;
+    result->tracks = handle->output;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_tracker_reset(ifx_Tracker_t* handle)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    handle->num_tracks = 0;
+    handle->next_id = 1;
+}
@@ -0,0 +1,271 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Tracker.h
+ *
+ * \brief \copybrief gr_tracker
+ *
+ * For details refer to \ref gr_tracker
+ */
+
+#ifndef IFX_RADAR_TRACKER_H
+#define IFX_RADAR_TRACKER_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/** The track was confirmed in this frame. */
+#define IFX_TRACK_EVENT_CONFIRMED (1u << 0)
+/** The track was deleted in this frame. It is reported once more with state \ref IFX_TRACK_DELETED. */
+#define IFX_TRACK_EVENT_DELETED (1u << 1)
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Motion model of the Kalman filters.
+ */
+typedef enum
+{
+    IFX_TRACKER_MODEL_CONSTANT_VELOCITY = 0,    /**< State per axis: position and rate. The process noise is
+                                                     white acceleration.*/
+    IFX_TRACKER_MODEL_CONSTANT_ACCELERATION = 1 /**< State per axis: position, rate and acceleration. The
+                                                     process noise is white jerk.*/
+} ifx_Tracker_Model_t;
+
+/**
+ * @brief Life cycle state of a track.
+ */
+typedef enum
+{
+    IFX_TRACK_TENTATIVE = 0, /**< Track was born but has not been confirmed yet.*/
+    IFX_TRACK_CONFIRMED = 1, /**< Track has been associated often enough to be reported as target.*/
+    IFX_TRACK_DELETED = 2    /**< Track has been deleted in this frame.*/
+} ifx_Track_State_t;
+
+/**
+ * @brief Defines the structure for tracker module related settings.
+ *
+ * The standard deviations describe the measurement accuracy of the detector
+ * and the expected maneuverability of the targets. For a constant velocity
+ * model the process noise is given as acceleration (m/s^2 and deg/s^2), for
+ * a constant acceleration model as jerk (m/s^3 and deg/s^3).
+ */
+typedef struct
+{
+    ifx_Tracker_Model_t model;         /**< Motion model.*/
+    ifx_Float_t frame_period_s;        /**< Time between two calls of \ref ifx_tracker_run in seconds.*/
+    uint32_t max_tracks;               /**< Capacity of the track table. No new tracks are born if it is full.*/
+    uint32_t max_detections;           /**< Maximum number of detections per frame.*/
+    ifx_Float_t range_std_m;           /**< Standard deviation of the measured range.*/
+    ifx_Float_t speed_std_m_s;         /**< Standard deviation of the measured radial speed.*/
+    ifx_Float_t angle_std_deg;         /**< Standard deviation of the measured angle.*/
+    ifx_Float_t range_process_std;     /**< Process noise of the range axis.*/
+    ifx_Float_t angle_process_std;     /**< Process noise of the angle axis.*/
+    ifx_Float_t angle_rate_init_std;   /**< Uncertainty of the angular rate of a new track in deg/s.*/
+    ifx_Float_t accel_init_std;        /**< Uncertainty of the range acceleration of a new track in m/s^2
+                                            (constant acceleration model only).*/
+    ifx_Float_t angle_accel_init_std;  /**< Uncertainty of the angular acceleration of a new track in deg/s^2
+                                            (constant acceleration model only).*/
+    ifx_Float_t gate_threshold;        /**< Maximum squared Mahalanobis distance between a predicted track and a
+                                            detection (three degrees of freedom, e.g. 11.34 for a 99% gate).*/
+    uint32_t confirm_hits;             /**< Number of associated detections after which a track is confirmed.*/
+    uint32_t max_misses;               /**< Number of consecutive frames without detection after which a confirmed
+                                            track is deleted. Tentative tracks are deleted on the first miss.*/
+} ifx_Tracker_Config_t;
+
+/**
+ * @brief A single detection passed to \ref ifx_tracker_run.
+ *
+ * The speed is the radial speed measured by Doppler processing, positive
+ * for targets moving away from the radar (i.e. the rate of change of the
+ * range).
+ */
+typedef struct
+{
+    ifx_Float_t range_m;   /**< Range of the detection.*/
+    ifx_Float_t speed_m_s; /**< Radial speed of the detection.*/
+    ifx_Float_t angle_deg; /**< Azimuth angle of the detection.*/
+} ifx_Tracker_Detection_t;
+
+/**
+ * @brief Filtered state of a track.
+ */
+typedef struct
+{
+    uint32_t id;                   /**< Unique identifier of the track (not reused until \ref ifx_tracker_reset).*/
+    ifx_Track_State_t state;       /**< Life cycle state.*/
+    uint32_t events;               /**< Events in this frame (IFX_TRACK_EVENT_* flags).*/
+    int32_t detection;             /**< Index of the detection associated in this frame, -1 if none.*/
+    ifx_Float_t range_m;           /**< Filtered range.*/
+    ifx_Float_t speed_m_s;         /**< Filtered radial speed.*/
+    ifx_Float_t accel_m_s2;        /**< Filtered range acceleration (0 for the constant velocity model).*/
+    ifx_Float_t angle_deg;         /**< Filtered angle.*/
+    ifx_Float_t angle_rate_deg_s;  /**< Filtered angular rate.*/
+    ifx_Float_t range_std_m;       /**< Standard deviation of the filtered range.*/
+    ifx_Float_t angle_std_deg;     /**< Standard deviation of the filtered angle.*/
+    uint32_t age;                  /**< Number of frames since the birth of the track.*/
+    uint32_t hits;                 /**< Number of associated detections.*/
+    uint32_t misses;               /**< Number of consecutive frames without associated detection.*/
+} ifx_Tracker_Track_t;
+
+/**
+ * @brief Result of \ref ifx_tracker_run.
+ *
+ * The array is owned by the tracker handle and remains valid until the
+ * next call of \ref ifx_tracker_run or \ref ifx_tracker_reset or until the
+ * handle is destroyed.
+ */
+typedef struct
+{
+    uint32_t num_tracks;         /**< Number of entries in tracks.*/
+    ifx_Tracker_Track_t* tracks; /**< Live tracks ordered by id, followed by the tracks deleted in this frame.*/
+} ifx_Tracker_Result_t;
+
+/**
+ * @brief A handle for an instance of the tracker module, see Tracker.h.
+ */
+typedef struct ifx_Tracker_s ifx_Tracker_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Radar
+ * @{
+ */
+
+/** @defgroup gr_tracker Tracker
+ * @brief API for multi-target tracking of detections
+ *
+ * The tracker turns the per-frame detections of e.g. \ref gr_peaksearch,
+ * OS-CFAR or DBSCAN clusters into tracks with a persistent identity.
+ *
+ * Each track holds two Kalman filters in polar coordinates: one for
+ * range, updated with the measured range and radial speed, and one for
+ * the angle. As the measurement and process noise of both axes are
+ * uncorrelated, this is identical to a single filter over the full state.
+ *
+ * Every frame the tracks are predicted and detections inside the gate of
+ * a track are assigned with global nearest neighbour association: the
+ * assignment with minimum total generalized distance (squared Mahalanobis
+ * distance plus logarithm of the innovation covariance determinant) is
+ * computed with the Hungarian algorithm, separately for each cluster of
+ * tracks and detections sharing gates. Detections without track start
+ * tentative tracks; tracks are confirmed after confirm_hits associations
+ * and deleted after max_misses consecutive misses. Confirmation and deletion are reported
+ * as events, so costly processing such as classification can be triggered
+ * per track instead of per frame.
+ *
+ * All memory is allocated by \ref ifx_tracker_create; running the tracker
+ * does not allocate and the results are deterministic.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a tracker handle.
+ *
+ * @param [in]     config    Tracker settings.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Tracker_t* ifx_tracker_create(const ifx_Tracker_Config_t* config);
+
+/**
+ * @brief Destroys the tracker handle.
+ *
+ * @param [in]     handle    A handle to the tracker object.
+ */
+IFX_DLL_PUBLIC
+void ifx_tracker_destroy(ifx_Tracker_t* handle);
+
+/**
+ * @brief Processes the detections of one frame.
+ *
+ * @param [in]     handle            A handle to the tracker object.
+ * @param [in]     detections        Detections of the frame (may be NULL if num_detections is 0).
+ * @param [in]     num_detections    Number of detections (at most max_detections).
+ * @param [out]    result            Tracks after processing the frame.
+ */
+IFX_DLL_PUBLIC
+void ifx_tracker_run(ifx_Tracker_t* handle,
+                     const ifx_Tracker_Detection_t* detections,
+                     uint32_t num_detections,
+                     ifx_Tracker_Result_t* result);
+
+/**
+ * @brief Deletes all tracks without reporting them.
+ *
+ * The tracker starts over as if it was just created: the first track born
+ * after a reset gets id 1 again.
+ *
+ * @param [in]     handle    A handle to the tracker object.
+ */
+IFX_DLL_PUBLIC
+void ifx_tracker_reset(ifx_Tracker_t* handle);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_RADAR_TRACKER_H */
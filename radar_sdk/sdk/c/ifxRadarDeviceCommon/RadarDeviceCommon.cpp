@@ -64,6 +64,18 @@ constexpr bool use_uvc = false;
 constexpr bool use_wiggler = false;
 constexpr bool use_libusb = false;
 
+/* Probing stops after this time, so that a hanging port does not block opening
+ * a device. The enumerators run in parallel, so this is a bound for the
+ * slowest connection type, not for the sum of all of them.
+ */
+constexpr uint16_t enumeration_timeout_ms = 2000;
+
+/* Complete enumeration results are reused for this time, as long as no device
+ * has been attached or removed in the meantime. This makes the typical
+ * sequence of get_list followed by open_by_uuid enumerate only once.
+ */
+constexpr uint32_t enumeration_cache_lifetime_ms = 10000;
+
 /* board_manager may be used by multiple threads concurrently. Each access to
  * board_manager must be protected using the mutex mutex_board_manager. This
  * presents "weird" behavior like that some boards are not found if you
@@ -71,6 +83,80 @@ constexpr bool use_libusb = false;
  */
 std::mutex mutex_board_manager;
 
+/* Sensors identified for the boards of the last enumeration, in the order of
+ * the enumerated list. They are valid as long as BoardManager returns the same
+ * (cached) list, so get_list does not have to open every board again.
+ * Protected by mutex_board_manager.
+ */
+struct IdentifiedBoard
+{
+    bool supported;
+    ifx_Radar_Sensor_List_Entry_t entry;
+};
+
+std::vector<IdentifiedBoard> identified_boards;
+bool identified_boards_valid = false;
+
+
+void enumerate(BoardManager& board_manager)
+{
+    if (use_serial)
+    {
+        board_manager.useSerial();
+    }
+    if (use_ethernet)
+    {
+        board_manager.useUdp();
+    }
+    if (use_uvc)
+    {
+        board_manager.useUvc();
+    }
+    if (use_wiggler)
+    {
+        board_manager.useWiggler();
+    }
+    if (use_libusb)
+    {
+        board_manager.useLibusb();
+    }
+    board_manager.setEnumerationTimeout(enumeration_timeout_ms);
+    board_manager.setCacheLifetime(enumeration_cache_lifetime_ms);
+    board_manager.enumerate();
+
+    if (!board_manager.isFromCache())
+    {
+        identified_boards_valid = false;
+    }
+}
+
+std::unique_ptr<BoardInstance> open_enumerated(BoardManager& board_manager, const uint8_t uuid[16])
+{
+    try
+    {
+        return board_manager.createSpecificBoardInstance(uuid);
+    }
+    catch (EException&)
+    {
+    }
+
+    if (board_manager.isFromCache())
+    {
+        // the cached board might have been replaced by another one with the same port, so enumerate again
+        BoardManager::invalidateCache();
+        enumerate(board_manager);
+        try
+        {
+            return board_manager.createSpecificBoardInstance(uuid);
+        }
+        catch (EException&)
+        {
+        }
+    }
+
+    return nullptr;
+}
+
 
 ifx_Radar_Sensor_t get_avian_type(std::unique_ptr<BoardInstance>& board, uint8_t id = 0)
 {
@@ -121,36 +207,55 @@ bool get_sensor_type_legacy(std::unique_ptr<BoardInstance>& board, ifx_Radar_Sen
     return false;
 }
 
-std::vector<ifx_Radar_Sensor_List_Entry_t> get_list(BoardManager& board_manager, rdk::RadarDeviceCommon::SelectorFunction&& selector)
+void identify_boards(BoardManager& board_manager)
 {
-    std::vector<ifx_Radar_Sensor_List_Entry_t> list;
+    const auto& descriptors = board_manager.getEnumeratedList();
+    if (identified_boards_valid && (identified_boards.size() == descriptors.size()))
+    {
+        return;
+    }
+
+    identified_boards.clear();
+    identified_boards_valid = true;
 
-    for (const auto& descriptor : board_manager.getEnumeratedList())
+    for (const auto& descriptor : descriptors)
     {
-        ifx_Radar_Sensor_List_Entry_t entry = {};
+        IdentifiedBoard identified = {};
 
         try
         {
             std::unique_ptr<BoardInstance> board = descriptor->createBoardInstance();
-            if (!get_sensor_type(board, entry.sensor_type))
+            // otherwise not a radar sensor that we support
+            identified.supported = get_sensor_type(board, identified.entry.sensor_type);
+            if (identified.supported)
             {
-                // not a radar sensor that we support
-                continue;
-            }
-
-            entry.board_type = rdk::RadarDeviceCommon::get_boardtype_from_pid(board->getPid());
+                identified.entry.board_type = rdk::RadarDeviceCommon::get_boardtype_from_pid(board->getPid());
 
-            // read uuid
-            const auto uuid = board->getUuidString();
-            std::copy(uuid.begin(), uuid.end(), entry.uuid);
-
-            if (selector(entry))
-                list.push_back(entry);
+                // read uuid
+                const auto uuid = board->getUuidString();
+                std::copy(uuid.begin(), uuid.end(), identified.entry.uuid);
+            }
         }
         catch (const EException&)
         {
-            continue;
+            // the board might only be busy, so try again next time
+            identified_boards_valid = false;
         }
+
+        identified_boards.push_back(identified);
+    }
+}
+
+std::vector<ifx_Radar_Sensor_List_Entry_t> get_list(BoardManager& board_manager, rdk::RadarDeviceCommon::SelectorFunction&& selector)
+{
+    std::vector<ifx_Radar_Sensor_List_Entry_t> list;
+
+    identify_boards(board_manager);
+
+    for (const auto& identified : identified_boards)
+    {
+        if (identified.supported && selector(identified.entry))
+            list.push_back(identified.entry);
     }
 
     return list;
@@ -211,42 +316,16 @@ std::unique_ptr<BoardInstance> rdk::RadarDeviceCommon::open(SelectorFunction&& s
     std::unique_lock<std::mutex> lock(mutex_board_manager);
 
     BoardManager board_manager;
-    if (use_serial)
-    {
-        board_manager.useSerial();
-    }
-    if (use_ethernet)
-    {
-        board_manager.useUdp();
-    }
-    if (use_uvc)
-    {
-        board_manager.useUvc();
-    }
-    if (use_wiggler)
-    {
-        board_manager.useWiggler();
-    }
-    if (use_libusb)
-    {
-        board_manager.useLibusb();
-    }
-    board_manager.enumerate();
+    enumerate(board_manager);
 
     auto list = ::get_list(board_manager, std::forward<SelectorFunction>(selector));
     if (list.empty())
         return nullptr;
 
-    try
-    {
-        uint8_t uuid_array[16];
-        if (ifx_uuid_from_string(list[0].uuid, uuid_array))
-        {
-            return board_manager.createSpecificBoardInstance(uuid_array);
-        }
-    }
-    catch (EException&)
+    uint8_t uuid_array[16];
+    if (ifx_uuid_from_string(list[0].uuid, uuid_array))
     {
+        return open_enumerated(board_manager, uuid_array);
     }
 
     return nullptr;
@@ -275,37 +354,9 @@ std::unique_ptr<BoardInstance> rdk::RadarDeviceCommon::open_by_uuid(const char u
     std::unique_lock<std::mutex> lock(mutex_board_manager);
 
     BoardManager board_manager;
-    if (use_serial)
-    {
-        board_manager.useSerial();
-    }
-    if (use_ethernet)
-    {
-        board_manager.useUdp();
-    }
-    if (use_uvc)
-    {
-        board_manager.useUvc();
-    }
-    if (use_wiggler)
-    {
-        board_manager.useWiggler();
-    }
-    if (use_libusb)
-    {
-        board_manager.useLibusb();
-    }
-    board_manager.enumerate();
+    enumerate(board_manager);
 
-    try
-    {
-        return board_manager.createSpecificBoardInstance(uuid_array);
-    }
-    catch (EException&)
-    {
-    }
-
-    return nullptr;
+    return open_enumerated(board_manager, uuid_array);
 }
 
 std::vector<ifx_Radar_Sensor_List_Entry_t> rdk::RadarDeviceCommon::get_list(SelectorFunction&& selector)
@@ -313,27 +364,7 @@ std::vector<ifx_Radar_Sensor_List_Entry_t> rdk::RadarDeviceCommon::get_list(Sele
     std::unique_lock<std::mutex> lock(mutex_board_manager);
 
     BoardManager board_manager;
-    if (use_serial)
-    {
-        board_manager.useSerial();
-    }
-    if (use_ethernet)
-    {
-        board_manager.useUdp();
-    }
-    if (use_uvc)
-    {
-        board_manager.useUvc();
-    }
-    if (use_wiggler)
-    {
-        board_manager.useWiggler();
-    }
-    if (use_libusb)
-    {
-        board_manager.useLibusb();
-    }
-    board_manager.enumerate();
+    enumerate(board_manager);
 
     return ::get_list(board_manager, std::forward<SelectorFunction>(selector));
 }
@@ -43,6 +43,8 @@ classdef MimoseDevice < handle
 
     properties (Access = private, Hidden)
         active_frame
+        stream_handle = 0 % handle of the running stream (see start_streaming)
+        stream_dims       % [num_pulses, num_samples] of streamed frames
     end
 
     methods
@@ -181,6 +183,7 @@ classdef MimoseDevice < handle
             % Dev.disconnect();
 
             if obj.device_handle ~= 0
+                obj.stop_streaming();
                 ec = DeviceControlM_Mimose('destroy', obj.device_handle);
                 obj.check_error_code(ec);
                 obj.device_handle = 0;
@@ -212,6 +215,67 @@ classdef MimoseDevice < handle
             RxFrame = reshape(complex_samples, num_pulses, num_samples);
         end
 
+        function start_streaming(obj, num_frames, varargin)
+            %START_STREAMING API starts a background acquisition into a ring buffer
+            %   A thread of the MEX file fetches frames into a ring buffer
+            %   of num_frames frames, so no frames are lost while MATLAB is
+            %   busy. If the acquisition is not started, then this is also
+            %   started. Use read_frames to collect the frames. While
+            %   streaming, the device must not be accessed otherwise.
+            %
+            %USAGE
+            %  Dev.start_streaming(256);
+            %  Dev.start_streaming(16, 'decimation', 10, 'record_filename', 'rec.bin');
+            %  % every frame is written to rec.bin (raw float32, real and
+            %  % imaginary part interleaved), every 10th frame is returned
+            %  % by read_frames
+            p = inputParser;
+            addParameter(p, 'decimation', 1);
+            addParameter(p, 'record_filename', '');
+            parse(p, varargin{:});
+
+            obj.stop_streaming();
+            [ec, handle, cube_dim_1, num_pulses, num_samples] = DeviceControlM_Mimose('stream_start', obj.device_handle, num_frames, p.Results.decimation, p.Results.record_filename);
+            obj.check_error_code(ec);
+            obj.stream_handle = handle;
+            if(cube_dim_1 ~=1)
+                obj.stop_streaming();
+                ME = MException(['RadarDevice:error'], 'wrong dimension retrieved');
+                throw(ME);
+            end
+            obj.stream_dims = double([num_pulses, num_samples]);
+        end
+
+        function Frames = read_frames(obj, max_frames, timeout_ms)
+            %READ_FRAMES API returns the frames acquired since the last call
+            %
+            %USAGE
+            %  frames = Dev.read_frames(64, 100) % the returned 'frames' is a complex
+            %  array with dimensions (num_pulses x num_samples x num_frames),
+            %  empty if no frame arrived within the timeout
+            [ec, num_frames, Data] = DeviceControlM_Mimose('stream_read', obj.stream_handle, max_frames, timeout_ms);
+            obj.check_error_code(ec);
+            Frames = reshape(complex(Data(1:2:end, :), Data(2:2:end, :)), [obj.stream_dims, double(num_frames)]);
+        end
+
+        function stats = get_stream_stats(obj)
+            %GET_STREAM_STATS API returns the counters of the running stream
+            [ec, counters] = DeviceControlM_Mimose('stream_get_stats', obj.stream_handle);
+            obj.check_error_code(ec);
+            stats = struct('frames_fetched', counters(1), 'frames_recorded', counters(2), ...
+                           'frames_dropped', counters(3), 'frames_read', counters(4), ...
+                           'frames_queued', counters(5), 'running', counters(6) ~= 0);
+        end
+
+        function stop_streaming(obj)
+            %STOP_STREAMING API stops the background acquisition started by start_streaming
+            if obj.stream_handle ~= 0
+                ec = DeviceControlM_Mimose('stream_stop', obj.stream_handle);
+                obj.stream_handle = 0;
+                obj.check_error_code(ec);
+            end
+        end
+
         function start_acquisition(obj)
             %START_ACQUISITION API starts the acquisition of raw data
             %   This method starts the acquisition of raw data when the radar device is connected
@@ -461,6 +461,182 @@ static void get_next_frame_timeout(WrapperContext *ctx)
 }
 
 
+/*
+ * Streaming acquisition
+ *
+ * A stream fetches frames in a background thread into a ring buffer of
+ * num_frames frames. stream_read returns all frames acquired since the last
+ * call (at most max_frames) as one single precision matrix with one frame per
+ * column. Each column has the same layout as RxFrame of get_next_frame and
+ * can be reshaped to (2, num_rx, num_chirps_per_frame, num_samples_per_chirp)
+ * (real and imaginary part interleaved).
+ *
+ * Only every decimation-th frame is put into the ring buffer. If
+ * record_filename is not empty, every frame (independent of decimation) is
+ * appended to this file as raw float32 values. While a stream is running the
+ * device must not be accessed by other commands.
+ */
+typedef struct
+{
+  ifx_Mimose_Device_t* device;
+  ifx_Cube_C_t* cube;
+  bool pending; // the cube holds a frame that was not passed to the stream yet
+  ifx_Stream_t* stream;
+} MimoseStream;
+
+#define stream_handle(ctx, argnum)  ((MimoseStream*)arg_pointer_valid((ctx), (argnum)))
+
+static void ret_scalar_uint32(WrapperContext *ctx, int argnum, uint32_t value)
+{
+  mxArray* out = mxCreateNumericMatrix(1, 1, mxUINT32_CLASS, mxREAL);
+  *(uint32_t*)mxGetData(out) = value;
+  ret(ctx, argnum, out);
+}
+
+static bool stream_fetch(void* context, float* frame)
+{
+  MimoseStream* s = (MimoseStream*)context;
+  const uint32_t num_rx = IFX_CUBE_ROWS(s->cube);
+  const uint32_t num_chirps_per_frame = IFX_CUBE_COLS(s->cube);
+  const uint32_t num_samples_per_chirp = IFX_CUBE_SLICES(s->cube);
+
+  if (!s->pending)
+  {
+    ifx_mimose_get_next_frame_timeout(s->device, s->cube, NULL, 1000);
+    if (ifx_error_get() != IFX_OK)
+      return false;
+  }
+  s->pending = false;
+
+  // same order as get_next_frame
+  for (uint32_t sample = 0; sample < num_samples_per_chirp; ++sample)
+  {
+    for (uint32_t chirp = 0; chirp < num_chirps_per_frame; ++chirp)
+    {
+      for (uint32_t rxidx = 0; rxidx < num_rx; ++rxidx)
+      {
+        *frame++ = IFX_COMPLEX_REAL(IFX_CUBE_AT(s->cube, rxidx, chirp, sample));
+        *frame++ = IFX_COMPLEX_IMAG(IFX_CUBE_AT(s->cube, rxidx, chirp, sample));
+      }
+    }
+  }
+  return true;
+}
+
+
+static void stream_start(WrapperContext *ctx)
+{
+  ifx_Mimose_Device_t* device = mimose_handle(ctx, 0);
+  const uint32_t num_frames = arg_uint32(ctx, 1);
+  const uint32_t decimation = arg_uint32(ctx, 2);
+  const char* record_filename = arg_string(ctx, 3);
+
+  MimoseStream* s = ifx_mem_calloc(1, sizeof(MimoseStream));
+  if (!s)
+  {
+    ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+  }
+  else
+  {
+    // The first frame determines the dimensions of the frames in the ring
+    // buffer and is handed to the stream by the first fetch.
+    s->device = device;
+    ifx_mimose_start_acquisition(device);
+    s->cube = ifx_mimose_get_next_frame_timeout(device, NULL, NULL, 10000);
+    s->pending = true;
+  }
+
+  if (s && s->cube)
+  {
+    ifx_Stream_Config_t config;
+    config.frame_size = 2 * (size_t)IFX_CUBE_ROWS(s->cube) * IFX_CUBE_COLS(s->cube) * IFX_CUBE_SLICES(s->cube);
+    config.num_frames = num_frames;
+    config.decimation = decimation;
+    config.record_filename = (record_filename && *record_filename) ? record_filename : NULL;
+
+    s->stream = ifx_stream_create(&config, stream_fetch, s);
+  }
+
+  if (!s || !s->stream)
+  {
+    if (s)
+    {
+      ifx_cube_destroy_c(s->cube);
+      ifx_mem_free(s);
+    }
+    ret_error(ctx, 0);
+    ret_error(ctx, 1);
+    ret_error(ctx, 2);
+    ret_error(ctx, 3);
+    ret_error(ctx, 4);
+    return;
+  }
+
+  ret_error(ctx, 0);
+  ret_pointer(ctx, 1, s);
+  ret_scalar_uint32(ctx, 2, IFX_CUBE_ROWS(s->cube));
+  ret_scalar_uint32(ctx, 3, IFX_CUBE_COLS(s->cube));
+  ret_scalar_uint32(ctx, 4, IFX_CUBE_SLICES(s->cube));
+}
+
+
+static void stream_read(WrapperContext *ctx)
+{
+  MimoseStream* s = stream_handle(ctx, 0);
+  const uint32_t max_frames = arg_uint32(ctx, 1);
+  const uint16_t timeout = arg_uint16(ctx, 2);
+  const size_t frame_size = 2 * (size_t)IFX_CUBE_ROWS(s->cube) * IFX_CUBE_COLS(s->cube) * IFX_CUBE_SLICES(s->cube);
+
+  // The frames are copied straight from the ring buffer into the output
+  // array; unused columns are cut off afterwards without copying.
+  mxArray* frames = mxCreateNumericMatrix(frame_size, max_frames, mxSINGLE_CLASS, mxREAL);
+  const uint32_t num_frames = ifx_stream_read(s->stream, (float*)mxGetData(frames), max_frames, timeout);
+  mxSetN(frames, num_frames);
+
+  // A timeout only means that no new frame is available yet.
+  if (ifx_error_get() == IFX_ERROR_TIMEOUT)
+    ifx_error_get_and_clear();
+
+  ret_error(ctx, 0);
+  ret_scalar_uint32(ctx, 1, num_frames);
+  ret(ctx, 2, frames);
+}
+
+
+static void stream_get_stats(WrapperContext *ctx)
+{
+  MimoseStream* s = stream_handle(ctx, 0);
+
+  ifx_Stream_Stats_t stats;
+  ifx_stream_get_stats(s->stream, &stats);
+
+  // [frames_fetched, frames_recorded, frames_dropped, frames_read, frames_queued, running]
+  mxArray* out = mxCreateNumericMatrix(1, 6, mxUINT64_CLASS, mxREAL);
+  uint64_t* data = mxGetData(out);
+  data[0] = stats.frames_fetched;
+  data[1] = stats.frames_recorded;
+  data[2] = stats.frames_dropped;
+  data[3] = stats.frames_read;
+  data[4] = stats.frames_queued;
+  data[5] = stats.running;
+
+  ret_error(ctx, 0);
+  ret(ctx, 1, out);
+}
+
+
+static void stream_stop(WrapperContext *ctx)
+{
+  MimoseStream* s = stream_handle(ctx, 0);
+
+  ifx_stream_destroy(s->stream);
+  ifx_cube_destroy_c(s->cube);
+  ifx_mem_free(s);
+
+  ret_error(ctx, 0);
+}
+
+
 static const CommandDescriptor commands[] = {
     { "get_version", get_version, 2, 0 },
     { "get_version_full", get_version_full, 2, 0 },
@@ -479,6 +655,10 @@ static const CommandDescriptor commands[] = {
     { "stop_acquisition", stop_acquisition, 1, 1 },
     { "get_next_frame", get_next_frame, 5, 1 },
     { "get_next_frame_timeout", get_next_frame_timeout, 5, 2 },
+    { "stream_start", stream_start, 5, 4 },
+    { "stream_read", stream_read, 3, 3 },
+    { "stream_get_stats", stream_get_stats, 2, 1 },
+    { "stream_stop", stream_stop, 1, 1 },
     { NULL, NULL, 0, 0 }
 };
 
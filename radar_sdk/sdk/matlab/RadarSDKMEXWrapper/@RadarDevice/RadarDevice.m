@@ -46,6 +46,8 @@ classdef RadarDevice < handle
 
     properties (Access = private)
         device_handle;      % device handle given by radar sdk
+        stream_handle = 0;  % handle of the running stream (see start_streaming)
+        stream_dims;        % [num_rx, num_chirps_per_frame, num_samples_per_chirp] of streamed frames
     end
 
     methods
@@ -92,6 +94,7 @@ classdef RadarDevice < handle
             %DISCONNECT disconnect from a Radar Device attached via USB
             %   This method disconnects from the port where the radar device is connected
             if obj.device_handle ~= 0
+                obj.stop_streaming();
                 if(obj.cw_control_handle ~= 0)
                     obj.cw_control_handle.delete();
                 end
@@ -160,6 +163,58 @@ classdef RadarDevice < handle
             obj.check_error_code(ec);
         end
 
+        function start_streaming(obj, num_frames, varargin)
+            %START_STREAMING starts a background acquisition into a ring buffer
+            %   A thread of the MEX file fetches frames into a ring buffer
+            %   of num_frames frames, so no frames are lost while MATLAB is
+            %   busy. Use read_frames to collect the frames. Optional
+            %   parameters:
+            %   - 'decimation': only every n-th frame is put into the ring
+            %     buffer (default 1)
+            %   - 'record_filename': every frame is appended to this file as
+            %     raw float32 values, independent of 'decimation'
+            %   While streaming, the device must not be accessed otherwise.
+            p = inputParser;
+            addParameter(p, 'decimation', 1);
+            addParameter(p, 'record_filename', '');
+            parse(p, varargin{:});
+
+            obj.stop_streaming();
+            [ec, handle, num_rx, num_chirps_per_frame, num_samples_per_chirp] = DeviceControlM('stream_start', obj.device_handle, num_frames, p.Results.decimation, p.Results.record_filename);
+            obj.check_error_code(ec);
+            obj.stream_handle = handle;
+            obj.stream_dims = double([num_rx, num_chirps_per_frame, num_samples_per_chirp]);
+        end
+
+        function Frames = read_frames(obj, max_frames, timeout_ms)
+            %READ_FRAMES returns the frames acquired since the last call
+            %   Returns at most max_frames frames as a single precision
+            %   array of size num_rx x num_chirps_per_frame x
+            %   num_samples_per_chirp x num_frames. If no frame arrives
+            %   within timeout_ms, an empty array is returned.
+            [ec, num_frames, Data] = DeviceControlM('stream_read', obj.stream_handle, max_frames, timeout_ms);
+            obj.check_error_code(ec);
+            Frames = reshape(Data, [obj.stream_dims, double(num_frames)]);
+        end
+
+        function stats = get_stream_stats(obj)
+            %GET_STREAM_STATS returns the counters of the running stream
+            [ec, counters] = DeviceControlM('stream_get_stats', obj.stream_handle);
+            obj.check_error_code(ec);
+            stats = struct('frames_fetched', counters(1), 'frames_recorded', counters(2), ...
+                           'frames_dropped', counters(3), 'frames_read', counters(4), ...
+                           'frames_queued', counters(5), 'running', counters(6) ~= 0);
+        end
+
+        function stop_streaming(obj)
+            %STOP_STREAMING stops the background acquisition started by start_streaming
+            if obj.stream_handle ~= 0
+                ec = DeviceControlM('stream_stop', obj.stream_handle);
+                obj.stream_handle = 0;
+                obj.check_error_code(ec);
+            end
+        end
+
         function sensor_info = get_sensor_information(obj)
             %GET_SENSOR_INFORMATION Gets information about the connected device
             oSensorInfo = SensorInfo();
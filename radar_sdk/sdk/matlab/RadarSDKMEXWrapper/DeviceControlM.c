@@ -43,6 +43,11 @@
  *      create          ifx_avian_create               device_config       device_handle
  *      get_next_frame  ifx_avian_get_next_frame       device_handle       err_code, num_rx, num_samples_per_chirp, num_chirpts_per_frame, RxFrame
  *      destroy         ifx_avian_destroy              device_handle       VOID
+ *      stream_start    ifx_stream_create              device_handle, num_frames, decimation, record_filename
+ *                                                                          err_code, stream_handle, num_rx, num_chirps_per_frame, num_samples_per_chirp
+ *      stream_read     ifx_stream_read                stream_handle, max_frames, timeout_ms
+ *                                                                          err_code, num_frames, Frames
+ *      stream_stop     ifx_stream_destroy             stream_handle       err_code
  *
  * e.g.:
  *      device_handle = DeviceControl('create',device_config)
@@ -810,6 +815,180 @@ static void cw_capture_frame(WrapperContext *ctx)
 }
 
 
+/*
+ * Streaming acquisition
+ *
+ * A stream fetches frames in a background thread into a ring buffer of
+ * num_frames frames. stream_read returns all frames acquired since the last
+ * call (at most max_frames) as one single precision matrix with one frame per
+ * column. Each column has the same layout as RxFrame of get_next_frame and
+ * can be reshaped to (num_rx, num_chirps_per_frame, num_samples_per_chirp).
+ *
+ * Only every decimation-th frame is put into the ring buffer. If
+ * record_filename is not empty, every frame (independent of decimation) is
+ * appended to this file as raw float32 values, so MATLAB can poll decimated
+ * previews while the file is written at full rate. While a stream is running
+ * the device must not be accessed by other commands.
+ */
+typedef struct
+{
+  ifx_Avian_Device_t* device;
+  ifx_Cube_R_t* cube;
+  bool pending; // the cube holds a frame that was not passed to the stream yet
+  ifx_Stream_t* stream;
+} AvianStream;
+
+#define stream_handle(ctx, argnum)  ((AvianStream*)arg_pointer_valid((ctx), (argnum)))
+
+static void ret_scalar_uint32(WrapperContext *ctx, int argnum, uint32_t value)
+{
+  mxArray* out = mxCreateNumericMatrix(1, 1, mxUINT32_CLASS, mxREAL);
+  *(uint32_t*)mxGetData(out) = value;
+  ret(ctx, argnum, out);
+}
+
+static bool stream_fetch(void* context, float* frame)
+{
+  AvianStream* s = (AvianStream*)context;
+  const uint32_t num_rx = IFX_CUBE_ROWS(s->cube);
+  const uint32_t num_chirps_per_frame = IFX_CUBE_COLS(s->cube);
+  const uint32_t num_samples_per_chirp = IFX_CUBE_SLICES(s->cube);
+
+  if (!s->pending)
+  {
+    ifx_avian_get_next_frame_timeout(s->device, s->cube, 1000);
+    if (ifx_error_get() != IFX_OK)
+      return false;
+  }
+  s->pending = false;
+
+  // same order as get_next_frame
+  for (uint32_t sample = 0; sample < num_samples_per_chirp; ++sample)
+  {
+    for (uint32_t chirp = 0; chirp < num_chirps_per_frame; ++chirp)
+    {
+      for (uint32_t rxidx = 0; rxidx < num_rx; ++rxidx)
+      {
+        *frame++ = IFX_CUBE_AT(s->cube, rxidx, chirp, sample);
+      }
+    }
+  }
+  return true;
+}
+
+
+static void stream_start(WrapperContext *ctx)
+{
+  ifx_Avian_Device_t* device = device_handle(ctx, 0);
+  const uint32_t num_frames = arg_uint32(ctx, 1);
+  const uint32_t decimation = arg_uint32(ctx, 2);
+  const char* record_filename = arg_string(ctx, 3);
+
+  AvianStream* s = ifx_mem_calloc(1, sizeof(AvianStream));
+  if (!s)
+  {
+    ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+  }
+  else
+  {
+    // The first frame determines the dimensions of the frames in the ring
+    // buffer and is handed to the stream by the first fetch.
+    s->device = device;
+    s->cube = ifx_avian_get_next_frame_timeout(device, NULL, 10000);
+    s->pending = true;
+  }
+
+  if (s && s->cube)
+  {
+    ifx_Stream_Config_t config;
+    config.frame_size = (size_t)IFX_CUBE_ROWS(s->cube) * IFX_CUBE_COLS(s->cube) * IFX_CUBE_SLICES(s->cube);
+    config.num_frames = num_frames;
+    config.decimation = decimation;
+    config.record_filename = (record_filename && *record_filename) ? record_filename : NULL;
+
+    s->stream = ifx_stream_create(&config, stream_fetch, s);
+  }
+
+  if (!s || !s->stream)
+  {
+    if (s)
+    {
+      ifx_cube_destroy_r(s->cube);
+      ifx_mem_free(s);
+    }
+    ret_error(ctx, 0);
+    ret_error(ctx, 1);
+    ret_error(ctx, 2);
+    ret_error(ctx, 3);
+    ret_error(ctx, 4);
+    return;
+  }
+
+  ret_error(ctx, 0);
+  ret_pointer(ctx, 1, s);
+  ret_scalar_uint32(ctx, 2, IFX_CUBE_ROWS(s->cube));
+  ret_scalar_uint32(ctx, 3, IFX_CUBE_COLS(s->cube));
+  ret_scalar_uint32(ctx, 4, IFX_CUBE_SLICES(s->cube));
+}
+
+
+static void stream_read(WrapperContext *ctx)
+{
+  AvianStream* s = stream_handle(ctx, 0);
+  const uint32_t max_frames = arg_uint32(ctx, 1);
+  const uint16_t timeout = arg_uint16(ctx, 2);
+  const size_t frame_size = (size_t)IFX_CUBE_ROWS(s->cube) * IFX_CUBE_COLS(s->cube) * IFX_CUBE_SLICES(s->cube);
+
+  // The frames are copied straight from the ring buffer into the output
+  // array; unused columns are cut off afterwards without copying.
+  mxArray* frames = mxCreateNumericMatrix(frame_size, max_frames, mxSINGLE_CLASS, mxREAL);
+  const uint32_t num_frames = ifx_stream_read(s->stream, (float*)mxGetData(frames), max_frames, timeout);
+  mxSetN(frames, num_frames);
+
+  // A timeout only means that no new frame is available yet.
+  if (ifx_error_get() == IFX_ERROR_TIMEOUT)
+    ifx_error_get_and_clear();
+
+  ret_error(ctx, 0);
+  ret_scalar_uint32(ctx, 1, num_frames);
+  ret(ctx, 2, frames);
+}
+
+
+static void stream_get_stats(WrapperContext *ctx)
+{
+  AvianStream* s = stream_handle(ctx, 0);
+
+  ifx_Stream_Stats_t stats;
+  ifx_stream_get_stats(s->stream, &stats);
+
+  // [frames_fetched, frames_recorded, frames_dropped, frames_read, frames_queued, running]
+  mxArray* out = mxCreateNumericMatrix(1, 6, mxUINT64_CLASS, mxREAL);
+  uint64_t* data = mxGetData(out);
+  data[0] = stats.frames_fetched;
+  data[1] = stats.frames_recorded;
+  data[2] = stats.frames_dropped;
+  data[3] = stats.frames_read;
+  data[4] = stats.frames_queued;
+  data[5] = stats.running;
+
+  ret_error(ctx, 0);
+  ret(ctx, 1, out);
+}
+
+
+static void stream_stop(WrapperContext *ctx)
+{
+  AvianStream* s = stream_handle(ctx, 0);
+
+  ifx_stream_destroy(s->stream);
+  ifx_cube_destroy_r(s->cube);
+  ifx_mem_free(s);
+
+  ret_error(ctx, 0);
+}
+
+
 static const CommandDescriptor commands[] = {
     { "get_version", get_version, 2, 0 },
     { "get_version_full", get_version_full, 2, 0 },
@@ -847,6 +1026,10 @@ static const CommandDescriptor commands[] = {
     { "cw_measure_temperature", cw_measure_temperature, 2, 1 },
     { "cw_measure_tx_power", cw_measure_tx_power, 2, 2 },
     { "cw_capture_frame", cw_capture_frame, 4, 1 },
+    { "stream_start", stream_start, 5, 4 },
+    { "stream_read", stream_read, 3, 3 },
+    { "stream_get_stats", stream_get_stats, 2, 1 },
+    { "stream_stop", stream_stop, 1, 1 },
     { NULL, NULL, 0, 0 }
 };
 
@@ -0,0 +1,242 @@
+# ===========================================================================
+# Copyright (C) 2022 Infineon Technologies AG
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from
+#    this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+# ===========================================================================
+
+"""Background prefetching of frames from radar devices"""
+
+import asyncio
+import collections
+import threading
+import typing
+from enum import Enum
+
+from .exceptions import ErrorFifoOverflow, ErrorTimeout
+
+
+_END = object()  # returned by _next once the prefetcher stopped and the queue is empty
+
+
+class OverflowPolicy(Enum):
+    """Behavior of a FramePrefetcher receiving a frame while its queue is full"""
+    DROP_OLDEST = 0  # drop the oldest queued frame and count it in dropped_frames
+    BLOCK = 1        # stop fetching until the consumer made room in the queue
+    RAISE = 2        # stop the prefetcher and raise ErrorFifoOverflow from get
+
+
+class FramePrefetcher():
+    """Fetch frames from a device in a background thread
+
+    A worker thread repeatedly calls fetch (typically the get_next_frame
+    method of a device) and stores the results in a bounded queue. The SDK
+    functions are called through ctypes which releases the global interpreter
+    lock while the C function blocks, so other Python threads (including
+    prefetchers of other devices) keep running while the worker waits for the
+    next frame.
+
+    The overflow policy decides what happens if the queue is full when a new
+    frame arrives. By default the oldest frame is dropped and counted in
+    dropped_frames, so the latency stays bounded if the consumer is too slow.
+    Recordings that must not have gaps should use OverflowPolicy.BLOCK, which
+    leaves further frames in the device until the consumer catches up (if the
+    device buffer overflows in turn, get raises the device error), or
+    OverflowPolicy.RAISE, which stops the prefetcher and raises
+    ErrorFifoOverflow from get once the queued frames have been returned.
+
+    While the prefetcher is running the device must not be used from other
+    threads. Frames are consumed using get, by iterating over the prefetcher,
+    or asynchronously using "async for".
+
+    Example:
+        with device.prefetch(queue_depth=16) as frames:
+            for frame in frames:
+                process(frame)
+    """
+
+    def __init__(self, fetch: typing.Callable[[], typing.Any], queue_depth: int = 8,
+                 overflow: OverflowPolicy = OverflowPolicy.DROP_OLDEST):
+        """Start prefetching
+
+        Parameters:
+            fetch: Function returning the next frame. ErrorTimeout raised by
+                   fetch is ignored, any other exception stops the prefetcher
+                   and is raised again by get.
+            queue_depth: Maximum number of frames kept in the queue.
+            overflow: Behavior if a frame arrives while the queue is full.
+        """
+        if queue_depth < 1:
+            raise ValueError("queue_depth must be at least 1")
+        if not isinstance(overflow, OverflowPolicy):
+            raise ValueError("overflow must be an OverflowPolicy")
+
+        self._fetch = fetch
+        self._queue_depth = queue_depth
+        self._overflow = overflow
+        self._queue = collections.deque()
+        self._condition = threading.Condition()
+        self._frames_received = 0
+        self._dropped_frames = 0
+        self._error = None
+        self._running = True
+
+        self._thread = threading.Thread(target=self._run, name="ifxradarsdk-prefetch", daemon=True)
+        self._thread.start()
+
+    @property
+    def queue_depth(self) -> int:
+        """Maximum number of frames kept in the queue"""
+        return self._queue_depth
+
+    @property
+    def overflow(self) -> OverflowPolicy:
+        """Behavior if a frame arrives while the queue is full"""
+        return self._overflow
+
+    @property
+    def queued_frames(self) -> int:
+        """Number of frames currently waiting in the queue"""
+        with self._condition:
+            return len(self._queue)
+
+    @property
+    def frames_received(self) -> int:
+        """Number of frames received from the device since the start"""
+        with self._condition:
+            return self._frames_received
+
+    @property
+    def dropped_frames(self) -> int:
+        """Number of frames dropped because the queue was full
+
+        With OverflowPolicy.BLOCK this stays 0, with OverflowPolicy.RAISE it is
+        at most 1.
+        """
+        with self._condition:
+            return self._dropped_frames
+
+    @property
+    def running(self) -> bool:
+        """True while the worker thread fetches frames"""
+        with self._condition:
+            return self._running
+
+    def _run(self):
+        while self.running:
+            try:
+                frame = self._fetch()
+            except ErrorTimeout:
+                continue
+            except Exception as e:
+                with self._condition:
+                    self._error = e
+                    self._running = False
+                    self._condition.notify_all()
+                return
+
+            with self._condition:
+                self._frames_received += 1
+
+                if len(self._queue) >= self._queue_depth:
+                    if self._overflow is OverflowPolicy.BLOCK:
+                        self._condition.wait_for(lambda: len(self._queue) < self._queue_depth or not self._running)
+                        if not self._running:
+                            return
+                    elif self._overflow is OverflowPolicy.RAISE:
+                        self._dropped_frames += 1
+                        self._error = ErrorFifoOverflow("Prefetch queue full, frame could not be stored")
+                        self._running = False
+                        self._condition.notify_all()
+                        return
+                    else:
+                        self._queue.popleft()
+                        self._dropped_frames += 1
+
+                self._queue.append(frame)
+                self._condition.notify_all()
+
+    def get(self, timeout_ms: typing.Optional[int] = None):
+        """Return the oldest frame from the queue
+
+        Blocks until a frame is available. If timeout_ms is given and no frame
+        is available within timeout_ms milliseconds, ErrorTimeout is raised.
+        If the worker thread stopped because fetching a frame failed, the
+        exception is raised once all queued frames have been returned. If the
+        prefetcher was stopped, StopIteration is raised.
+        """
+        frame = self._next(timeout_ms)
+        if frame is _END:
+            raise StopIteration
+        return frame
+
+    def _next(self, timeout_ms: typing.Optional[int] = None):
+        timeout = timeout_ms / 1000 if timeout_ms else None
+        with self._condition:
+            if not self._condition.wait_for(lambda: self._queue or not self._running, timeout):
+                raise ErrorTimeout("No frame available within timeout")
+
+            if self._queue:
+                frame = self._queue.popleft()
+                self._condition.notify_all()  # wakes a worker blocked on a full queue
+                return frame
+            if self._error:
+                error, self._error = self._error, None
+                raise error
+            return _END
+
+    def stop(self) -> None:
+        """Stop the worker thread
+
+        Waits until the pending call to fetch has returned. Frames already
+        queued can still be retrieved afterwards.
+        """
+        with self._condition:
+            self._running = False
+            self._condition.notify_all()
+        if self._thread is not threading.current_thread():
+            self._thread.join()
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        return self.get()
+
+    def __aiter__(self):
+        return self
+
+    async def __anext__(self):
+        # StopIteration cannot be passed through a future, hence _next
+        loop = asyncio.get_running_loop()
+        frame = await loop.run_in_executor(None, self._next)
+        if frame is _END:
+            raise StopAsyncIteration
+        return frame
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.stop()
@@ -42,6 +42,7 @@ from ..common.common_types import (
     RadarSensor,
     SensorInfo
 )
+from ..common.prefetch import FramePrefetcher, OverflowPolicy
 from ..common.sdk_base import ifx_mda_destroy_r, move_ifx_list_to_python_list
 from .types import AdcConfig, BasebandConfig, TestSignalGeneratorConfig
 
@@ -250,6 +251,17 @@ class DeviceCw():
         ifx_mda_destroy_r(frame)
         return frame_numpy
 
+    def prefetch(self, queue_depth: int = 8,
+                 overflow: OverflowPolicy = OverflowPolicy.DROP_OLDEST) -> FramePrefetcher:
+        """Capture frames in a background thread
+
+        Returns a FramePrefetcher which calls capture_frame in a background
+        thread and keeps up to queue_depth frames. overflow selects what happens
+        when a frame arrives while the queue is full. While the prefetcher is
+        running the device must not be used otherwise.
+        """
+        return FramePrefetcher(self.capture_frame, queue_depth, overflow)
+
     def __enter__(self):
         return self
 
@@ -41,6 +41,7 @@ from ..common.common_types import (
     RadarSensor,
     SensorInfo
 )
+from ..common.prefetch import FramePrefetcher, OverflowPolicy
 from ..common.sdk_base import move_ifx_list_to_python_list
 from .types import (
     FmcwElementType,
@@ -82,6 +83,8 @@ class DeviceFmcw():
         declare_prototype(dll, "ifx_fmcw_get_temperature", [c_void_p], c_float)
         declare_prototype(dll, "ifx_fmcw_start_acquisition", [c_void_p], None)
         declare_prototype(dll, "ifx_fmcw_stop_acquisition", [c_void_p], None)
+        declare_prototype(dll, "ifx_fmcw_reconnect", [c_void_p, c_uint32], None)
+        declare_prototype(dll, "ifx_fmcw_set_auto_reconnect", [c_void_p, c_uint32], None)
         declare_prototype(dll, "ifx_fmcw_get_next_frame", [c_void_p, POINTER(FmcwFrame)], None)
         declare_prototype(dll, "ifx_fmcw_get_next_frame_timeout", [c_void_p, POINTER(FmcwFrame), c_uint16], None)
         declare_prototype(dll, "ifx_fmcw_allocate_frame", [c_void_p], POINTER(FmcwFrame))
@@ -327,6 +330,25 @@ class DeviceFmcw():
         """
         self._cdll.ifx_fmcw_stop_acquisition(self.handle)
 
+    def reconnect(self, timeout_ms: int) -> None:
+        """Reconnect to the board after the connection was lost
+
+        Waits up to timeout_ms milliseconds until the board with the same UUID
+        is available again, restores the configuration and restarts the
+        acquisition if it was running. Must not be called while a prefetcher
+        is running.
+        """
+        self._cdll.ifx_fmcw_reconnect(self.handle, timeout_ms)
+
+    def set_auto_reconnect(self, timeout_ms: int) -> None:
+        """Enable automatic reconnects when fetching frames
+
+        If the connection is lost while waiting for a frame, get_next_frame
+        reconnects once, waiting up to timeout_ms milliseconds for the board.
+        A value of 0 (default) disables automatic reconnects.
+        """
+        self._cdll.ifx_fmcw_set_auto_reconnect(self.handle, timeout_ms)
+
     def get_next_frame(self, timeout_ms: typing.Optional[int] = None) -> np.ndarray:
         """Retrieve next frame of time domain data from device
 
@@ -362,6 +384,19 @@ class DeviceFmcw():
         self._cdll.ifx_fmcw_destroy_frame(frame)
         return frame_contents
 
+    def prefetch(self, queue_depth: int = 8, timeout_ms: typing.Optional[int] = None,
+                 overflow: OverflowPolicy = OverflowPolicy.DROP_OLDEST) -> FramePrefetcher:
+        """Fetch frames in a background thread
+
+        Returns a FramePrefetcher which calls get_next_frame in a background thread
+        and keeps up to queue_depth frames. timeout_ms is passed to each call
+        of get_next_frame. overflow selects what happens when a frame arrives
+        while the queue is full. While the prefetcher is running the device must
+        not be used otherwise. Stop the prefetcher before stopping the acquisition
+        or closing the device.
+        """
+        return FramePrefetcher(lambda: self.get_next_frame(timeout_ms), queue_depth, overflow)
+
     def __enter__(self):
         return self
 
@@ -41,6 +41,7 @@ from ..common.common_types import (
     FirmwareInfo,
     SensorInfo
 )
+from ..common.prefetch import FramePrefetcher, OverflowPolicy
 from ..common.sdk_base import ifx_mda_destroy_c, move_ifx_list_to_python_list
 from .types import (
     GenericLimits,
@@ -236,6 +237,19 @@ class DeviceLtr11():
 
         return frame_numpy, metadata
 
+    def prefetch(self, queue_depth: int = 8, timeout_ms: typing.Optional[int] = None,
+                 overflow: OverflowPolicy = OverflowPolicy.DROP_OLDEST) -> FramePrefetcher:
+        """Fetch frames in a background thread
+
+        Returns a FramePrefetcher which calls get_next_frame in a background thread
+        and keeps up to queue_depth frames. timeout_ms is passed to each call
+        of get_next_frame. overflow selects what happens when a frame arrives
+        while the queue is full. While the prefetcher is running the device must
+        not be used otherwise. Stop the prefetcher before stopping the acquisition
+        or closing the device.
+        """
+        return FramePrefetcher(lambda: self.get_next_frame(timeout_ms), queue_depth, overflow)
+
     def get_active_mode_power(self, config: Ltr11Config) -> float:
         """ Return the power in active mode for a given configuration. 
             i.e when the APRT (Adaptive prt LTR11 feature) is disabled,
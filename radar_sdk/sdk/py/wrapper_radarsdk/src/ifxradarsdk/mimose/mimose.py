@@ -35,6 +35,7 @@ import numpy as np
 
 from ..common.base_types import MdaComplex
 from ..common.cdll_helper import load_library, declare_prototype
+from ..common.prefetch import FramePrefetcher, OverflowPolicy
 from ..common.sdk_base import ifx_mda_destroy_c
 from .types import ifx_Mimose_Config_t, MimoseMetadata
 
@@ -225,6 +226,19 @@ class DeviceMimose():
 
         return frame_numpy, metadata
 
+    def prefetch(self, queue_depth: int = 8, timeout_ms: typing.Optional[int] = None,
+                 overflow: OverflowPolicy = OverflowPolicy.DROP_OLDEST) -> FramePrefetcher:
+        """Fetch frames in a background thread
+
+        Returns a FramePrefetcher which calls get_next_frame in a background thread
+        and keeps up to queue_depth frames. timeout_ms is passed to each call
+        of get_next_frame. overflow selects what happens when a frame arrives
+        while the queue is full. While the prefetcher is running the device must
+        not be used otherwise. Stop the prefetcher before stopping the acquisition
+        or closing the device.
+        """
+        return FramePrefetcher(lambda: self.get_next_frame(timeout_ms), queue_depth, overflow)
+
     def update_rc_lut(self) -> None:
         """updates RC look up table through device tuning.
         
@@ -0,0 +1,109 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Test.h
+ *
+ * Minimal helpers for the unit tests in this directory. A test is a plain
+ * executable which returns \ref TEST_RESULT from main; failed checks are
+ * reported on stderr and counted, the test continues after a failure.
+ */
+
+#ifndef IFX_TEST_H
+#define IFX_TEST_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Returns the counter of failed checks */
+static inline int* test_failure_counter(void)
+{
+    static int failures = 0;
+    return &failures;
+}
+
+/** Counts a failed check; use after reporting the failure on stderr */
+#define TEST_FAIL() (++*test_failure_counter())
+
+/** Checks that cond is true */
+#define TEST_CHECK(cond)                                                          \
+    do                                                                            \
+    {                                                                             \
+        if (!(cond))                                                              \
+        {                                                                         \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            TEST_FAIL();                                                          \
+        }                                                                         \
+    } while (0)
+
+/** Checks that |a - b| <= tol */
+#define TEST_CHECK_NEAR(a, b, tol)                                                   \
+    do                                                                               \
+    {                                                                                \
+        const double test_a_ = (double)(a);                                          \
+        const double test_b_ = (double)(b);                                          \
+        if (!(fabs(test_a_ - test_b_) <= (double)(tol)))                             \
+        {                                                                            \
+            fprintf(stderr, "%s:%d: check failed: %s = %.9g, %s = %.9g, tol = %g\n", \
+                    __FILE__, __LINE__, #a, test_a_, #b, test_b_, (double)(tol));   \
+            TEST_FAIL();                                                             \
+        }                                                                            \
+    } while (0)
+
+/** Value to return from main */
+#define TEST_RESULT() (*test_failure_counter() ? EXIT_FAILURE : EXIT_SUCCESS)
+
+static uint32_t test_random_state = 0x12345678;
+
+/** Seeds the generator of \ref test_random and \ref test_uniform */
+static inline void test_seed(uint32_t seed)
+{
+    test_random_state = seed ? seed : 0x12345678;
+}
+
+/** Returns a pseudo random number (xorshift32), identical on all platforms */
+static inline uint32_t test_random(void)
+{
+    uint32_t x = test_random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    test_random_state = x;
+    return x;
+}
+
+/** Returns a pseudo random number uniformly distributed in [lo, hi) */
+static inline float test_uniform(float lo, float hi)
+{
+    return lo + (hi - lo) * (float)(test_random() >> 8) * (1.0f / 16777216.0f);
+}
+
+#endif  // IFX_TEST_H
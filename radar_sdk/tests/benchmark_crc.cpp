@@ -0,0 +1,143 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file benchmark_crc.cpp
+ *
+ * Measures the throughput of the strata CRC functions in MB/s. For
+ * Crc16CcittFalse over bytes the table path is measured by processing the
+ * buffer in pieces shorter than the minimum length of the carry-less
+ * multiplication path. The time is the minimum of several batches of calls.
+ *
+ * Usage: benchmark_crc [bytes] [repetitions]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <common/crc/Crc16.hpp>
+#include <common/crc/Crc32.hpp>
+#include <common/crc/Crc8.hpp>
+
+#include "Test.h"
+
+namespace {
+
+struct Benchmark
+{
+    std::string name;
+    std::function<void()> run;
+};
+
+volatile uint32_t crc_sink;
+
+// minimum over several batches to suppress interference by other processes
+double time_per_call_us(const Benchmark& benchmark, int repetitions)
+{
+    constexpr int batches = 5;
+    const int per_batch = (repetitions + batches - 1) / batches;
+    double best = 0;
+
+    benchmark.run();  // warm up caches
+
+    for (int batch = 0; batch < batches; batch++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < per_batch; i++)
+            benchmark.run();
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double us = std::chrono::duration<double, std::micro>(stop - start).count() / per_batch;
+        if (batch == 0 || us < best)
+            best = us;
+    }
+
+    return best;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t bytes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    const int repetitions = (argc > 2) ? std::atoi(argv[2]) : 2000;
+
+    // the 16-bit length of the word based functions limits the buffer size
+    if (bytes < 2 || bytes > 65534 || repetitions <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [bytes (2 to 65534)] [repetitions]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> data(bytes);
+    for (auto& b : data)
+        b = static_cast<uint8_t>(test_random());
+    std::vector<uint16_t> words(bytes / 2);
+    for (auto& w : words)
+        w = static_cast<uint16_t>(test_random());
+    std::vector<uint16_t> samples(words);
+    for (auto& s : samples)
+        s &= 0xFFF;
+
+    const auto len = static_cast<unsigned int>(bytes);
+    const auto num_words = static_cast<uint16_t>(words.size());
+
+    const std::vector<Benchmark> benchmarks = {
+        {"crc16 bytes", [&]() { crc_sink = Crc16CcittFalse(data.data(), len); }},
+        {"crc16 bytes (tables)", [&]() {
+             uint16_t crc = CRC16_CCITT_FALSE_SEED;
+             for (unsigned int i = 0; i < len; i += 48)
+                 crc = Crc16CcittFalse(data.data() + i, std::min(48u, len - i), crc);
+             crc_sink = crc;
+         }},
+        {"crc16 12-bit words", [&]() { crc_sink = Crc16CcittFalse(samples.data(), num_words, 12); }},
+        {"crc16 16-bit words", [&]() { crc_sink = Crc16CcittFalse(words.data(), num_words, 16); }},
+        {"mpeg2 12-bit words", [&]() { crc_sink = Crc32Mpeg2(samples.data(), num_words, 12); }},
+        {"mpeg2 16-bit words", [&]() { crc_sink = Crc32Mpeg2(words.data(), num_words, 16); }},
+        {"ethernet 16-bit words", [&]() { crc_sink = Crc32Ethernet(words.data(), num_words, 16); }},
+        {"autosar bytes", [&]() { crc_sink = Crc32Autosar(data.data(), static_cast<uint16_t>(len)); }},
+        {"bzip2 bytes", [&]() { crc_sink = Crc32Bzip2(data.data(), static_cast<uint16_t>(len)); }},
+        {"smbus bytes", [&]() { crc_sink = Crc8Smbus(data.data(), static_cast<uint16_t>(len)); }},
+    };
+
+    std::printf("%zu bytes, %d repetitions\n\n", bytes, repetitions);
+    std::printf("%-24s%14s%12s\n", "function", "us per call", "MB/s");
+    for (const auto& benchmark : benchmarks)
+    {
+        const double us = time_per_call_us(benchmark, repetitions);
+        std::printf("%-24s%14.3f%12.1f\n", benchmark.name.c_str(), us, static_cast<double>(bytes) / us);
+    }
+
+    return EXIT_SUCCESS;
+}
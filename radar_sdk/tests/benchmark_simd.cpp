@@ -0,0 +1,206 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file benchmark_simd.cpp
+ *
+ * Measures the throughput of the SIMD kernels (internal/Simd*.h) for all
+ * instruction sets available on this CPU and prints the time per call and
+ * the speedup compared to the scalar reference. The time is the minimum of
+ * several batches of calls.
+ *
+ * Usage: benchmark_simd [length] [repetitions]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ifxBase/internal/Simd.h"
+#include "ifxBase/internal/SimdAdc.h"
+#include "ifxBase/internal/SimdFixed.h"
+#include "ifxBase/internal/SimdMonopulse.h"
+#include "ifxBase/internal/SimdMti.h"
+
+#include "Test.h"
+
+namespace {
+
+struct Buffers
+{
+    explicit Buffers(size_t len) :
+        x(4 * len + 4), y(4 * len + 4), z(4 * len + 4), h(4 * len + 4),
+        raw(4 * len), q15(2 * len), q15_out(2 * len), twiddles(2 * len), s8(len), index(len)
+    {
+        for (auto& v : x)
+            v = test_uniform(-1, 1);
+        for (auto& v : y)
+            v = test_uniform(0, 1);
+        for (auto& v : raw)
+            v = static_cast<uint16_t>(test_random());
+        for (auto& v : q15)
+            v = static_cast<int16_t>(test_random() % 32768) - 16384;
+        for (auto& v : twiddles)
+            v = static_cast<int16_t>(test_random() % 32768) - 16384;
+        for (auto& v : s8)
+            v = static_cast<int8_t>(test_random());
+    }
+
+    std::vector<float> x, y, z, h;
+    std::vector<uint16_t> raw;
+    std::vector<int16_t> q15, q15_out, twiddles;
+    std::vector<int8_t> s8;
+    std::vector<uint32_t> index;
+};
+
+struct Benchmark
+{
+    std::string name;
+    // runs the kernel of the given instruction set once
+    std::function<void(ifx_Simd_Isa_t)> run;
+};
+
+volatile float float_sink;
+volatile int32_t int_sink;
+
+// minimum over several batches to suppress interference by other processes
+double time_per_call_us(const Benchmark& benchmark, ifx_Simd_Isa_t isa, int repetitions)
+{
+    constexpr int batches = 5;
+    const int per_batch = (repetitions + batches - 1) / batches;
+    double best = 0;
+
+    benchmark.run(isa);  // warm up caches
+
+    for (int batch = 0; batch < batches; batch++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < per_batch; i++)
+            benchmark.run(isa);
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double us = std::chrono::duration<double, std::micro>(stop - start).count() / per_batch;
+        if (batch == 0 || us < best)
+            best = us;
+    }
+
+    return best;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t len = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    const int repetitions = (argc > 2) ? std::atoi(argv[2]) : 2000;
+
+    if (len < 4 || (len & (len - 1)) != 0 || repetitions <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [length (power of 2, at least 4)] [repetitions]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Buffers b(len);
+
+    const auto k = [](ifx_Simd_Isa_t isa) { return ifx_simd_kernels_for_isa(isa); };
+    const auto mti = [](ifx_Simd_Isa_t isa) { return ifx_simd_mti_kernels_for_isa(isa); };
+    const auto mono = [](ifx_Simd_Isa_t isa) { return ifx_simd_monopulse_kernels_for_isa(isa); };
+    const auto adc = [](ifx_Simd_Isa_t isa) { return ifx_simd_adc_kernels_for_isa(isa); };
+    const auto fixed = [](ifx_Simd_Isa_t isa) { return ifx_simd_fixed_kernels_for_isa(isa); };
+
+    // len real values or len complex values per call
+    const std::vector<Benchmark> benchmarks = {
+        {"sum_r", [&](ifx_Simd_Isa_t isa) { float_sink = k(isa)->sum_r(b.x.data(), len); }},
+        {"sqsum_r", [&](ifx_Simd_Isa_t isa) { float_sink = k(isa)->sqsum_r(b.x.data(), len); }},
+        {"dot_r", [&](ifx_Simd_Isa_t isa) { float_sink = k(isa)->dot_r(b.x.data(), b.y.data(), len); }},
+        {"add_r", [&](ifx_Simd_Isa_t isa) { k(isa)->add_r(b.x.data(), b.y.data(), b.z.data(), len); }},
+        {"sub_r", [&](ifx_Simd_Isa_t isa) { k(isa)->sub_r(b.x.data(), b.y.data(), b.z.data(), len); }},
+        {"mul_r", [&](ifx_Simd_Isa_t isa) { k(isa)->mul_r(b.x.data(), b.y.data(), b.z.data(), len); }},
+        {"scale_r", [&](ifx_Simd_Isa_t isa) { k(isa)->scale_r(b.x.data(), 0.5f, b.z.data(), len); }},
+        {"mac_r", [&](ifx_Simd_Isa_t isa) { k(isa)->mac_r(b.x.data(), b.y.data(), 0.5f, b.z.data(), len); }},
+        {"clip_r", [&](ifx_Simd_Isa_t isa) { k(isa)->clip_r(b.x.data(), -0.5f, 0.5f, b.z.data(), len); }},
+        {"max_r", [&](ifx_Simd_Isa_t isa) { k(isa)->max_r(b.x.data(), b.y.data(), b.z.data(), len); }},
+        {"mul_c", [&](ifx_Simd_Isa_t isa) { k(isa)->mul_c(b.x.data(), b.y.data(), b.z.data(), len); }},
+        {"mul_cr", [&](ifx_Simd_Isa_t isa) { k(isa)->mul_cr(b.x.data(), b.y.data(), b.z.data(), len); }},
+        {"abs_c", [&](ifx_Simd_Isa_t isa) { k(isa)->abs_c(b.x.data(), b.z.data(), len); }},
+        {"sqnorm_c", [&](ifx_Simd_Isa_t isa) { k(isa)->sqnorm_c(b.x.data(), b.z.data(), len); }},
+        {"pow2db_r", [&](ifx_Simd_Isa_t isa) {
+             // in place: restore the input so all iterations do the same work
+             k(isa)->mul_r(b.y.data(), b.y.data(), b.z.data(), len);
+             k(isa)->pow2db_r(b.z.data(), 10, 1e-6f, -60, len);
+         }},
+        {"local_max_r", [&](ifx_Simd_Isa_t isa) { int_sink = static_cast<int32_t>(k(isa)->local_max_r(b.x.data(), 2, len, 0.5f, b.index.data())); }},
+        {"mti_r", [&](ifx_Simd_Isa_t isa) { mti(isa)->mti_r(b.x.data(), b.h.data(), 0.1f, b.z.data(), len); }},
+        {"mti_vr", [&](ifx_Simd_Isa_t isa) { mti(isa)->mti_vr(b.x.data(), b.h.data(), b.y.data(), b.z.data(), len); }},
+        {"cancel3_r", [&](ifx_Simd_Isa_t isa) { mti(isa)->cancel3_r(b.x.data(), b.y.data(), b.h.data(), b.z.data(), len); }},
+        {"monopulse_c", [&](ifx_Simd_Isa_t isa) { mono(isa)->monopulse_c(b.x.data(), b.y.data(), nullptr, 0.5f, b.z.data(), len); }},
+        {"adc8_c", [&](ifx_Simd_Isa_t isa) { adc(isa)->adc8_c(b.raw.data(), 4, b.z.data(), len); }},
+        {"adc12_c", [&](ifx_Simd_Isa_t isa) { adc(isa)->adc12_c(b.raw.data(), b.z.data(), len); }},
+        {"dot_s8", [&](ifx_Simd_Isa_t isa) { int_sink = fixed(isa)->dot_s8(b.s8.data(), b.s8.data(), len); }},
+        {"mul_q15", [&](ifx_Simd_Isa_t isa) { fixed(isa)->mul_q15(b.q15.data(), b.q15.data(), b.q15_out.data(), len); }},
+        {"bfly_q15", [&](ifx_Simd_Isa_t isa) {
+             b.q15_out = b.q15;
+             int_sink = fixed(isa)->bfly_q15(b.q15_out.data(), b.twiddles.data(), 1, len / 4, len);
+         }},
+    };
+
+    std::vector<ifx_Simd_Isa_t> isas;
+    for (ifx_Simd_Isa_t isa : {IFX_SIMD_ISA_SCALAR, IFX_SIMD_ISA_SSE2, IFX_SIMD_ISA_AVX2, IFX_SIMD_ISA_NEON})
+        if (ifx_simd_kernels_for_isa(isa))
+            isas.push_back(isa);
+
+    std::printf("length %zu, %d repetitions, time per call in us (speedup vs. scalar)\n\n", len, repetitions);
+    std::printf("%-12s", "kernel");
+    for (ifx_Simd_Isa_t isa : isas)
+        std::printf("%18s", ifx_simd_kernels_for_isa(isa)->name);
+    std::printf("\n");
+
+    for (const auto& benchmark : benchmarks)
+    {
+        std::printf("%-12s", benchmark.name.c_str());
+        double scalar = 0;
+        for (ifx_Simd_Isa_t isa : isas)
+        {
+            const double us = time_per_call_us(benchmark, isa, repetitions);
+            if (isa == IFX_SIMD_ISA_SCALAR)
+            {
+                scalar = us;
+                std::printf("%18.3f", us);
+            }
+            else
+                std::printf("%10.3f (%4.1fx)", us, scalar / us);
+        }
+        std::printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+"""
+Creates the models and reference outputs used by test_inference.c.
+
+A small Keras model with the structure of the gesture classifier
+(saved_model/model.keras) and fixed random weights is converted with
+src/export_native_model.py into a float and an int8 model. The converter
+writes the check inputs, the outputs of its reference implementation of the
+engine and the Keras outputs to a .ref file (float32).
+
+Usage (from this directory):
+    python make_inference_data.py
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+
+import numpy as np
+import keras
+
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+CONVERTER = os.path.join(HERE, "..", "..", "..", "src", "export_native_model.py")
+
+ROWS = 16
+COLUMNS = 8
+CHECK = 8
+
+
+def make_model(rng):
+    model = keras.Sequential([
+        keras.Input((ROWS, COLUMNS)),
+        keras.layers.Normalization(axis=-1, mean=rng.normal(0, 0.5, COLUMNS), variance=rng.uniform(0.5, 2, COLUMNS)),
+        keras.layers.Conv1D(8, 3, padding="same", activation="relu"),
+        keras.layers.MaxPooling1D(2),
+        keras.layers.Conv1D(8, 3, activation="relu"),
+        keras.layers.MaxPooling1D(2),
+        keras.layers.Flatten(),
+        keras.layers.Dense(16, activation="relu"),
+        keras.layers.Dropout(0.2),
+        keras.layers.Dense(3),
+    ])
+    for layer in model.layers:
+        if layer.__class__.__name__ in ("Conv1D", "Dense"):
+            kernel, bias = layer.get_weights()
+            scale = 1.0 / np.sqrt(np.prod(kernel.shape[:-1]))
+            layer.set_weights([rng.normal(0, scale, kernel.shape), rng.normal(0, 0.1, bias.shape)])
+    return model
+
+
+def main():
+    rng = np.random.default_rng(48)
+    model = make_model(rng)
+    calibration = rng.standard_normal((64, ROWS, COLUMNS)).astype(np.float32)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        model_file = os.path.join(tmp, "model.keras")
+        calibration_file = os.path.join(tmp, "calibration.npy")
+        model.save(model_file)
+        np.save(calibration_file, calibration)
+
+        for name, options in (("inference_float", []), ("inference_int8", ["--int8"])):
+            subprocess.run([sys.executable, CONVERTER, model_file, os.path.join(HERE, name + ".ifxn"), "--softmax",
+                            "--calibration", calibration_file, "--check", str(CHECK),
+                            "--reference", os.path.join(HERE, name + ".ref")] + options, check=True)
+
+
+if __name__ == "__main__":
+    main()
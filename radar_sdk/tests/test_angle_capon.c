@@ -0,0 +1,361 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_angle_capon.c
+ *
+ * Compares the Capon spectrum computed with the Cholesky factorization and
+ * diagonal loading against the original formulation using an explicit
+ * matrix inverse (computed in double precision here). Also checks the angle
+ * returned by the run functions and the behaviour for rank-deficient
+ * covariance matrices.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Cube.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Vector.h"
+#include "ifxRadar/AngleCapon.h"
+
+#include "Test.h"
+
+#define PI 3.14159265358979323846
+
+#define NUM_ANTENNAS 4
+#define NUM_RANGE_BINS 8
+#define NUM_CHIRPS 16
+#define NUM_BEAMS 61
+#define MAX_WIN 9
+
+/* Relative deviation from the explicit inverse without diagonal loading. The
+ * covariance matrices of the test signal have a condition number of a few
+ * thousand, this limits the accuracy in single precision. */
+#define TOL_NO_LOADING 2e-3
+/* Relative deviation from the explicit inverse with the default loading of
+ * 1e-6. The loading raises the smallest eigenvalue by 1e-6 * trace/N which
+ * changes the spectrum by up to 1e-6 * trace/(N * lambda_min). */
+#define TOL_DEFAULT_LOADING 1e-2
+
+static ifx_AngleCapon_Config_t make_config(uint8_t range_win_size)
+{
+    ifx_AngleCapon_Config_t config = {0};
+    config.range_win_size = range_win_size;
+    config.selected_rx = 0;
+    config.chirps_per_frame = NUM_CHIRPS;
+    config.phase_offset_degrees = 0;
+    config.num_virtual_antennas = NUM_ANTENNAS;
+    config.num_beams = NUM_BEAMS;
+    config.min_angle_degrees = -60;
+    config.max_angle_degrees = 60;
+    config.d_by_lambda = 0.5;
+    return config;
+}
+
+/* Two targets at different angles and Doppler frequencies plus noise */
+static ifx_Cube_C_t* make_spectrum(double noise)
+{
+    static const double angle_deg[] = {-20.0, 25.0};
+    static const double doppler_freq[] = {0.13, -0.27};
+    static const double amplitude[] = {1.0, 0.5};
+
+    ifx_Cube_C_t* cube = ifx_cube_create_c(NUM_RANGE_BINS, NUM_CHIRPS, NUM_ANTENNAS);
+
+    test_seed(26);
+    for (uint32_t r = 0; r < NUM_RANGE_BINS; r++)
+    {
+        for (uint32_t c = 0; c < NUM_CHIRPS; c++)
+        {
+            for (uint32_t a = 0; a < NUM_ANTENNAS; a++)
+            {
+                double complex x = 0;
+                for (int t = 0; t < 2; t++)
+                {
+                    const double phase = 2 * PI * (0.5 * a * sin(angle_deg[t] * PI / 180) + doppler_freq[t] * c + 0.1 * r);
+                    x += amplitude[t] * cexp(I * phase);
+                }
+                x += noise * (test_uniform(-1, 1) + I * test_uniform(-1, 1));
+                IFX_COMPLEX_SET(IFX_CUBE_AT(cube, r, c, a), (ifx_Float_t)creal(x), (ifx_Float_t)cimag(x));
+            }
+        }
+    }
+    return cube;
+}
+
+/* Inverts the n x n matrix A using Gauss-Jordan elimination with partial pivoting */
+static int invert(double complex A[NUM_ANTENNAS][NUM_ANTENNAS], double complex inv[NUM_ANTENNAS][NUM_ANTENNAS])
+{
+    const int n = NUM_ANTENNAS;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            inv[i][j] = (i == j) ? 1 : 0;
+
+    for (int col = 0; col < n; col++)
+    {
+        int pivot = col;
+        for (int i = col + 1; i < n; i++)
+            if (cabs(A[i][col]) > cabs(A[pivot][col]))
+                pivot = i;
+        if (cabs(A[pivot][col]) == 0)
+            return 0;
+
+        for (int j = 0; j < n; j++)
+        {
+            double complex t = A[col][j];
+            A[col][j] = A[pivot][j];
+            A[pivot][j] = t;
+            t = inv[col][j];
+            inv[col][j] = inv[pivot][j];
+            inv[pivot][j] = t;
+        }
+
+        const double complex d = A[col][col];
+        for (int j = 0; j < n; j++)
+        {
+            A[col][j] /= d;
+            inv[col][j] /= d;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            if (i == col)
+                continue;
+            const double complex f = A[i][col];
+            for (int j = 0; j < n; j++)
+            {
+                A[i][j] -= f * A[col][j];
+                inv[i][j] -= f * inv[col][j];
+            }
+        }
+    }
+    return 1;
+}
+
+/* Capon spectrum 1/(w^H R^-1 w) as computed by the original implementation */
+static void reference_spectrum(const ifx_AngleCapon_Config_t* config,
+                               const ifx_Cube_C_t* cube,
+                               uint32_t range_bin,
+                               double* spectrum)
+{
+    const uint32_t half = (config->range_win_size - 1) / 2;
+    const uint32_t k = half * 2 + 1;
+
+    /* Doppler index of the maximum in the selected Rx channel */
+    uint32_t doppler_idx = 0;
+    double maximum = -1;
+    for (uint32_t c = 0; c < NUM_CHIRPS; c++)
+    {
+        const ifx_Complex_t v = IFX_CUBE_AT(cube, range_bin, c, config->selected_rx);
+        const double m = hypot(IFX_COMPLEX_REAL(v), IFX_COMPLEX_IMAG(v));
+        if (m > maximum)
+        {
+            maximum = m;
+            doppler_idx = c;
+        }
+    }
+    if (doppler_idx + half >= NUM_CHIRPS)
+        doppler_idx = NUM_CHIRPS - half - 1;
+    else if (doppler_idx < half)
+        doppler_idx = half;
+
+    double complex X[NUM_ANTENNAS][MAX_WIN];
+    for (uint32_t a = 0; a < NUM_ANTENNAS; a++)
+    {
+        for (uint32_t s = 0; s < k; s++)
+        {
+            const ifx_Complex_t v = IFX_CUBE_AT(cube, range_bin, doppler_idx - half + s, a);
+            X[a][s] = IFX_COMPLEX_REAL(v) + I * IFX_COMPLEX_IMAG(v);
+        }
+    }
+
+    double complex R[NUM_ANTENNAS][NUM_ANTENNAS];
+    double complex inv[NUM_ANTENNAS][NUM_ANTENNAS];
+    for (uint32_t i = 0; i < NUM_ANTENNAS; i++)
+    {
+        for (uint32_t j = 0; j < NUM_ANTENNAS; j++)
+        {
+            R[i][j] = 0;
+            for (uint32_t s = 0; s < k; s++)
+                R[i][j] += X[i][s] * conj(X[j][s]);
+        }
+    }
+    TEST_CHECK(invert(R, inv));
+
+    const double step = (config->max_angle_degrees - config->min_angle_degrees) / (config->num_beams - 1);
+    for (uint32_t beam = 0; beam < config->num_beams; beam++)
+    {
+        const double theta = (config->min_angle_degrees + step * beam) * PI / 180;
+        double complex w[NUM_ANTENNAS];
+        for (uint32_t a = 0; a < NUM_ANTENNAS; a++)
+            w[a] = cexp(I * 2 * PI * config->d_by_lambda * a * sin(theta)) / sqrt(NUM_ANTENNAS);
+
+        double complex q = 0;
+        for (uint32_t i = 0; i < NUM_ANTENNAS; i++)
+            for (uint32_t j = 0; j < NUM_ANTENNAS; j++)
+                q += conj(w[i]) * inv[i][j] * w[j];
+
+        spectrum[beam] = 1 / cabs(q);
+    }
+}
+
+static uint32_t argmax(const double* x, uint32_t n)
+{
+    uint32_t idx = 0;
+    for (uint32_t i = 1; i < n; i++)
+        if (x[i] > x[idx])
+            idx = i;
+    return idx;
+}
+
+/* Returns the maximum relative deviation of the spectrum from the reference */
+static double compare_spectrum(ifx_AngleCapon_t* capon,
+                               const ifx_AngleCapon_Config_t* config,
+                               const ifx_Cube_C_t* cube,
+                               uint32_t range_bin)
+{
+    double expected[NUM_BEAMS];
+    reference_spectrum(config, cube, range_bin, expected);
+
+    ifx_Vector_R_t* spectrum = ifx_vec_create_r(NUM_BEAMS);
+    ifx_anglecapon_get_spectrum(capon, range_bin, cube, spectrum);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    double max_rel = 0;
+    for (uint32_t beam = 0; beam < NUM_BEAMS; beam++)
+    {
+        const double rel = fabs(IFX_VEC_AT(spectrum, beam) - expected[beam]) / expected[beam];
+        if (rel > max_rel)
+            max_rel = rel;
+    }
+
+    ifx_vec_destroy_r(spectrum);
+    return max_rel;
+}
+
+static void test_spectrum(void)
+{
+    const ifx_AngleCapon_Config_t config = make_config(7);
+    ifx_Cube_C_t* cube = make_spectrum(0.05);
+    ifx_AngleCapon_t* capon = ifx_anglecapon_create(&config);
+    TEST_CHECK(capon != NULL);
+
+    double worst_default = 0;
+    double worst_unloaded = 0;
+    for (uint32_t r = 0; r < NUM_RANGE_BINS; r++)
+    {
+        ifx_anglecapon_set_diagonal_loading(capon, 0);
+        const double unloaded = compare_spectrum(capon, &config, cube, r);
+        ifx_anglecapon_set_diagonal_loading(capon, (ifx_Float_t)1e-6);
+        const double loaded = compare_spectrum(capon, &config, cube, r);
+
+        TEST_CHECK(unloaded <= TOL_NO_LOADING);
+        TEST_CHECK(loaded <= TOL_DEFAULT_LOADING);
+        worst_unloaded = fmax(worst_unloaded, unloaded);
+        worst_default = fmax(worst_default, loaded);
+    }
+    printf("max relative deviation from the explicit inverse: %.3g without loading, %.3g with default loading\n",
+           worst_unloaded, worst_default);
+
+    ifx_anglecapon_destroy(capon);
+    ifx_cube_destroy_c(cube);
+}
+
+static void test_angle(void)
+{
+    const ifx_AngleCapon_Config_t config = make_config(7);
+    ifx_Cube_C_t* cube = make_spectrum(0.05);
+    ifx_AngleCapon_t* capon = ifx_anglecapon_create(&config);
+
+    const double step = (config.max_angle_degrees - config.min_angle_degrees) / (config.num_beams - 1);
+    uint32_t range_bins[NUM_RANGE_BINS];
+    ifx_Float_t angles[NUM_RANGE_BINS];
+    for (uint32_t r = 0; r < NUM_RANGE_BINS; r++)
+        range_bins[r] = r;
+
+    ifx_anglecapon_run_batch(capon, range_bins, NUM_RANGE_BINS, cube, angles);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    for (uint32_t r = 0; r < NUM_RANGE_BINS; r++)
+    {
+        double expected[NUM_BEAMS];
+        reference_spectrum(&config, cube, r, expected);
+        const double expected_angle = config.min_angle_degrees + step * argmax(expected, NUM_BEAMS);
+
+        TEST_CHECK_NEAR(ifx_anglecapon_run(capon, r, cube), expected_angle, 1e-3);
+        TEST_CHECK_NEAR(angles[r], expected_angle, 1e-3);
+    }
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    ifx_anglecapon_destroy(capon);
+    ifx_cube_destroy_c(cube);
+}
+
+/* With two antennas without signal the covariance matrix is singular: the
+ * loading is required to get a spectrum at all. */
+static void test_rank_deficient(void)
+{
+    const ifx_AngleCapon_Config_t config = make_config(7);
+    ifx_Cube_C_t* cube = make_spectrum(0.05);
+    for (uint32_t c = 0; c < NUM_CHIRPS; c++)
+    {
+        IFX_COMPLEX_SET(IFX_CUBE_AT(cube, 0, c, 2), 0, 0);
+        IFX_COMPLEX_SET(IFX_CUBE_AT(cube, 0, c, 3), 0, 0);
+    }
+    ifx_AngleCapon_t* capon = ifx_anglecapon_create(&config);
+    ifx_Vector_R_t* spectrum = ifx_vec_create_r(NUM_BEAMS);
+
+    ifx_anglecapon_set_diagonal_loading(capon, 0);
+    ifx_anglecapon_get_spectrum(capon, 0, cube, spectrum);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_MATRIX_SINGULAR);
+
+    ifx_anglecapon_set_diagonal_loading(capon, (ifx_Float_t)1e-6);
+    ifx_anglecapon_get_spectrum(capon, 0, cube, spectrum);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    for (uint32_t beam = 0; beam < NUM_BEAMS; beam++)
+        TEST_CHECK(isfinite(IFX_VEC_AT(spectrum, beam)) && IFX_VEC_AT(spectrum, beam) > 0);
+
+    ifx_anglecapon_set_diagonal_loading(capon, -1);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    ifx_vec_destroy_r(spectrum);
+    ifx_anglecapon_destroy(capon);
+    ifx_cube_destroy_c(cube);
+}
+
+int main(void)
+{
+    test_spectrum();
+    test_angle();
+    test_rank_deficient();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,236 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_angle_monopulse.c
+ *
+ * Checks that the batched monopulse functions give the azimuth and
+ * elevation of synthetic cells of a range Doppler cube, agree with
+ * ifx_anglemonopulse_scalar_run, apply the phase calibration and clip
+ * phase differences without a physical angle.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Cube.h"
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Vector.h"
+#include "ifxRadar/AngleMonopulse.h"
+
+#include "Test.h"
+
+#define ROWS       5
+#define COLS       70  // more than one block of cells per row
+#define ANTENNAS   3
+#define WAVELENGTH 0.005f
+#define SPACING    (WAVELENGTH / 2)
+#define TOLERANCE  2e-3f  // degrees
+
+/* as on BGT60TR13C */
+static const ifx_AngleMonopulse_Antennas_t antennas = {2, 0, 1};
+
+static ifx_Float_t azimuth_of(uint32_t r, uint32_t c)
+{
+    return -70.0f + 140.0f * (ifx_Float_t)(r * COLS + c) / (ROWS * COLS);
+}
+
+static ifx_Float_t elevation_of(uint32_t r, uint32_t c)
+{
+    return 60.0f - 120.0f * (ifx_Float_t)((r * 7 + c * 3) % (ROWS * COLS)) / (ROWS * COLS);
+}
+
+static ifx_Complex_t polar(ifx_Float_t magnitude, ifx_Float_t phase)
+{
+    ifx_Complex_t z;
+    IFX_COMPLEX_SET(z, magnitude * cosf(phase), magnitude * sinf(phase));
+    return z;
+}
+
+/* Fills the cube such that each cell has the given angles, with the given phase offset per antenna */
+static void fill_cube(ifx_Cube_C_t* cube, const ifx_Float_t* phase_offset)
+{
+    // phase difference for the spacing of half a wavelength: pi * sin(angle)
+    for (uint32_t r = 0; r < ROWS; r++)
+    {
+        for (uint32_t c = 0; c < COLS; c++)
+        {
+            const ifx_Float_t phase = test_uniform(-IFX_PI, IFX_PI);
+            const ifx_Float_t d_azimuth = IFX_PI * sinf(azimuth_of(r, c) * IFX_PI / 180);
+            const ifx_Float_t d_elevation = IFX_PI * sinf(elevation_of(r, c) * IFX_PI / 180);
+
+            IFX_CUBE_AT(cube, r, c, antennas.rx_reference) = polar(test_uniform(0.1f, 10), phase + phase_offset[antennas.rx_reference]);
+            IFX_CUBE_AT(cube, r, c, antennas.rx_azimuth) = polar(test_uniform(0.1f, 10), phase + d_azimuth + phase_offset[antennas.rx_azimuth]);
+            IFX_CUBE_AT(cube, r, c, antennas.rx_elevation) = polar(test_uniform(0.1f, 10), phase + d_elevation + phase_offset[antennas.rx_elevation]);
+        }
+    }
+}
+
+static void check_map(void)
+{
+    const ifx_Float_t no_offset[ANTENNAS] = {0, 0, 0};
+    ifx_AngleMonopulse_t* handle = ifx_anglemonopulse_create(WAVELENGTH, SPACING);
+    ifx_Cube_C_t* cube = ifx_cube_create_c(ROWS, COLS, ANTENNAS);
+    ifx_Matrix_R_t* azimuth = ifx_mat_create_r(ROWS, COLS);
+    ifx_Matrix_R_t* elevation = ifx_mat_create_r(ROWS, COLS);
+
+    test_seed(38);
+    fill_cube(cube, no_offset);
+    ifx_anglemonopulse_map_run(handle, cube, &antennas, azimuth, elevation);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    for (uint32_t r = 0; r < ROWS; r++)
+    {
+        for (uint32_t c = 0; c < COLS; c++)
+        {
+            TEST_CHECK_NEAR(IFX_MAT_AT(azimuth, r, c), azimuth_of(r, c), TOLERANCE);
+            TEST_CHECK_NEAR(IFX_MAT_AT(elevation, r, c), elevation_of(r, c), TOLERANCE);
+
+            // the same angles as computed with the math library
+            const ifx_Complex_t reference = IFX_CUBE_AT(cube, r, c, antennas.rx_reference);
+            TEST_CHECK_NEAR(IFX_MAT_AT(azimuth, r, c),
+                            ifx_anglemonopulse_scalar_run(handle, IFX_CUBE_AT(cube, r, c, antennas.rx_azimuth), reference),
+                            TOLERANCE);
+            TEST_CHECK_NEAR(IFX_MAT_AT(elevation, r, c),
+                            ifx_anglemonopulse_scalar_run(handle, IFX_CUBE_AT(cube, r, c, antennas.rx_elevation), reference),
+                            TOLERANCE);
+        }
+    }
+
+    // each output is optional
+    ifx_mat_clear_r(azimuth);
+    ifx_anglemonopulse_map_run(handle, cube, &antennas, azimuth, NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    TEST_CHECK_NEAR(IFX_MAT_AT(azimuth, ROWS - 1, COLS - 1), azimuth_of(ROWS - 1, COLS - 1), TOLERANCE);
+
+    ifx_mat_destroy_r(elevation);
+    ifx_mat_destroy_r(azimuth);
+    ifx_cube_destroy_c(cube);
+    ifx_anglemonopulse_destroy(handle);
+}
+
+static void check_cells_with_calibration(void)
+{
+    const ifx_Float_t offset[ANTENNAS] = {0.7f, -2.1f, 1.3f};
+    ifx_AngleMonopulse_t* handle = ifx_anglemonopulse_create(WAVELENGTH, SPACING);
+    ifx_Cube_C_t* cube = ifx_cube_create_c(ROWS, COLS, ANTENNAS);
+
+    test_seed(380);
+    fill_cube(cube, offset);
+
+    ifx_Vector_R_t* calibration = ifx_vec_create_r(ANTENNAS);
+    for (uint32_t i = 0; i < ANTENNAS; i++)
+        IFX_VEC_AT(calibration, i) = offset[i];
+    ifx_anglemonopulse_set_phase_calibration(handle, calibration);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    // all cells in a scattered order, several blocks
+    const uint32_t num_cells = ROWS * COLS;
+    uint32_t* range_bins = malloc(sizeof(uint32_t) * num_cells);
+    uint32_t* doppler_bins = malloc(sizeof(uint32_t) * num_cells);
+    for (uint32_t i = 0; i < num_cells; i++)
+    {
+        const uint32_t cell = (i * 101) % num_cells;
+        range_bins[i] = cell / COLS;
+        doppler_bins[i] = cell % COLS;
+    }
+
+    ifx_Vector_R_t* azimuth = ifx_vec_create_r(num_cells);
+    ifx_Vector_R_t* elevation = ifx_vec_create_r(num_cells);
+    ifx_anglemonopulse_cells_run(handle, cube, &antennas, range_bins, doppler_bins, num_cells, azimuth, elevation);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    for (uint32_t i = 0; i < num_cells; i++)
+    {
+        TEST_CHECK_NEAR(IFX_VEC_AT(azimuth, i), azimuth_of(range_bins[i], doppler_bins[i]), TOLERANCE);
+        TEST_CHECK_NEAR(IFX_VEC_AT(elevation, i), elevation_of(range_bins[i], doppler_bins[i]), TOLERANCE);
+    }
+
+    // a cell outside the cube and an antenna without calibration are rejected
+    range_bins[3] = ROWS;
+    ifx_anglemonopulse_cells_run(handle, cube, &antennas, range_bins, doppler_bins, num_cells, azimuth, NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ifx_Vector_R_t short_calibration;
+    ifx_vec_view_r(&short_calibration, calibration, 0, ANTENNAS - 1, 1);
+    ifx_anglemonopulse_set_phase_calibration(handle, &short_calibration);
+    ifx_anglemonopulse_cells_run(handle, cube, &antennas, range_bins, doppler_bins, 1, azimuth, NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    ifx_vec_destroy_r(elevation);
+    ifx_vec_destroy_r(azimuth);
+    free(doppler_bins);
+    free(range_bins);
+    ifx_vec_destroy_r(calibration);
+    ifx_cube_destroy_c(cube);
+    ifx_anglemonopulse_destroy(handle);
+}
+
+static void check_clipping(void)
+{
+    // for a spacing of a quarter wavelength a phase difference above pi/2 has no physical angle
+    ifx_AngleMonopulse_t* handle = ifx_anglemonopulse_create(WAVELENGTH, WAVELENGTH / 4);
+    ifx_Cube_C_t* cube = ifx_cube_create_c(1, 2, ANTENNAS);
+
+    for (uint32_t c = 0; c < 2; c++)
+    {
+        const ifx_Float_t d_phi = (c == 0) ? 2.5f : -2.5f;
+        IFX_CUBE_AT(cube, 0, c, antennas.rx_reference) = polar(1, 0);
+        IFX_CUBE_AT(cube, 0, c, antennas.rx_azimuth) = polar(1, d_phi);
+        IFX_CUBE_AT(cube, 0, c, antennas.rx_elevation) = polar(1, 0);
+    }
+
+    const uint32_t range_bins[] = {0, 0};
+    const uint32_t doppler_bins[] = {0, 1};
+    ifx_Vector_R_t* azimuth = ifx_vec_create_r(2);
+    ifx_Vector_R_t* elevation = ifx_vec_create_r(2);
+    ifx_anglemonopulse_cells_run(handle, cube, &antennas, range_bins, doppler_bins, 2, azimuth, elevation);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    TEST_CHECK_NEAR(IFX_VEC_AT(azimuth, 0), 90, TOLERANCE);
+    TEST_CHECK_NEAR(IFX_VEC_AT(azimuth, 1), -90, TOLERANCE);
+    TEST_CHECK_NEAR(IFX_VEC_AT(elevation, 0), 0, TOLERANCE);
+
+    ifx_vec_destroy_r(elevation);
+    ifx_vec_destroy_r(azimuth);
+    ifx_cube_destroy_c(cube);
+    ifx_anglemonopulse_destroy(handle);
+}
+
+int main(void)
+{
+    check_map();
+    check_cells_with_calibration();
+    check_clipping();
+
+    return TEST_RESULT();
+}
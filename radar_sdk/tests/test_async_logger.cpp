@@ -0,0 +1,207 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_async_logger.cpp
+ *
+ * Tests the asynchronous logger: records of each thread are written in the
+ * order they were logged, flush() writes all records logged before the
+ * call, the rate limit suppresses records of a busy call site, and
+ * ifx_log only routes messages for the default stream through the
+ * asynchronous logger. The records are checked in the binary log file
+ * with the console log disabled; this also checks that LOGF and ifx_log
+ * record messages for the binary file if the console level is off.
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <common/AsyncLogger.hpp>
+
+#include "ifxBase/Log.h"
+
+#include "Test.h"
+
+namespace {
+
+constexpr int numThreads  = 4;
+constexpr int numMessages = 2000;
+
+std::string binaryPath()
+{
+    return (std::filesystem::temp_directory_path() / "test_async_logger.bin").string();
+}
+
+// decodes the binary log file into lines
+std::vector<std::string> decodeLines(const std::string &path)
+{
+    std::vector<std::string> lines;
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream text;
+    TEST_CHECK(AsyncLogger::decode(in, text));
+
+    std::string line;
+    while (std::getline(text, line))
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+void test_order_and_flush()
+{
+    auto &logger = AsyncLogger::instance();
+    logger.setRateLimit(0);
+    logger.setBufferSize(1 << 20);
+    logger.setBinaryFile(binaryPath().c_str());
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([t] {
+            for (int i = 0; i < numMessages; i++)
+            {
+                LOGF(INFO, "thread %d message %d", t, i);
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    // the binary file stays open, flush() must have written everything
+    logger.flush();
+    const auto lines = decodeLines(binaryPath());
+
+    int next[numThreads] = {};
+    int outOfOrder       = 0;
+    for (const auto &line : lines)
+    {
+        int t, i;
+        const auto pos = line.find("thread ");
+        if (pos == std::string::npos || std::sscanf(line.c_str() + pos, "thread %d message %d", &t, &i) != 2)
+            continue;
+        if (t < 0 || t >= numThreads)
+            continue;
+        if (i != next[t])
+            outOfOrder++;
+        next[t] = i + 1;
+    }
+
+    TEST_CHECK(outOfOrder == 0);
+    for (int t = 0; t < numThreads; t++)
+    {
+        TEST_CHECK(next[t] == numMessages);
+    }
+    TEST_CHECK(logger.getDroppedCount() == 0);
+
+    logger.setBinaryFile(nullptr);
+}
+
+void test_rate_limit()
+{
+    auto &logger = AsyncLogger::instance();
+    logger.setRateLimit(10);
+    logger.setBinaryFile(binaryPath().c_str());
+
+    for (int i = 0; i < 1000; i++)
+    {
+        LOGF(WARN, "busy call site %d", i);
+    }
+    logger.flush();
+
+    int count = 0;
+    for (const auto &line : decodeLines(binaryPath()))
+    {
+        if (line.find("busy call site") != std::string::npos)
+            count++;
+    }
+
+    // the loop may span two rate limit windows
+    TEST_CHECK(count >= 1 && count <= 20);
+
+    logger.setBinaryFile(nullptr);
+    logger.setRateLimit(0);
+}
+
+void test_ifx_log_stream()
+{
+    ifx_log_set_async(true);
+    ifx_log_set_binary_file(binaryPath().c_str());
+
+    // other streams than the default one are written synchronously
+    FILE *f = std::tmpfile();
+    TEST_CHECK(f != nullptr);
+    if (f)
+    {
+        ifx_log(f, IFX_LOG_INFO, "value %d", 42);
+        std::rewind(f);
+        char buffer[64] = {};
+        TEST_CHECK(std::fgets(buffer, sizeof(buffer), f) != nullptr);
+        TEST_CHECK(std::string(buffer) == "INFO: value 42\n");
+        std::fclose(f);
+    }
+
+    // messages for the default stream go to the asynchronous logger
+    ifx_log(IFX_STDOUT, IFX_LOG_INFO, "async value %d", 7);
+    ifx_log_flush();
+
+    int count = 0;
+    for (const auto &line : decodeLines(binaryPath()))
+    {
+        if (line.find("async value 7") != std::string::npos)
+            count++;
+        TEST_CHECK(line.find("value 42") == std::string::npos);
+    }
+    TEST_CHECK(count == 1);
+
+    ifx_log_set_binary_file(nullptr);
+    ifx_log_set_async(false);
+}
+
+}
+
+int main()
+{
+    // keep the console quiet, records are only written to the binary file
+    LOG_LEVEL(NONE);
+
+    test_order_and_flush();
+    test_rate_limit();
+    test_ifx_log_stream();
+
+    std::filesystem::remove(binaryPath());
+    return TEST_RESULT();
+}
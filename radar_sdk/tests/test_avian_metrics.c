@@ -0,0 +1,202 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_avian_metrics.c
+ *
+ * Checks ifx_avian_metrics_solve against ifx_avian_metrics_to_config: both
+ * must produce the same RF range, samples and chirps, and the solution must
+ * meet all metrics and be accepted by a device. The solver's own search is
+ * checked for the power limit and the optimization goals.
+ */
+
+#include <string.h>
+
+#include "ifxAvian/DeviceControl.h"
+#include "ifxAvian/Metrics.h"
+#include "ifxBase/Error.h"
+
+#include "Test.h"
+
+static const ifx_Radar_Sensor_t sensors[] = {IFX_AVIAN_BGT60TR13C, IFX_AVIAN_BGT60ATR24C, IFX_AVIAN_BGT60UTR11AIP};
+#define NUM_SENSORS (sizeof(sensors) / sizeof(sensors[0]))
+
+/* range resolution, max range, max speed, speed resolution, center frequency */
+static const ifx_Avian_Metrics_t metrics_list[] = {
+    {0.15f, 9.6f, 2.45f, 0.08f, 61.0e9},
+    {0.05f, 3.0f, 5.00f, 0.20f, 61.0e9},
+    {0.30f, 12.0f, 1.50f, 0.10f, 60.5e9},
+    {0.10f, 4.0f, 8.00f, 0.40f, 61.5e9},
+};
+#define NUM_METRICS (sizeof(metrics_list) / sizeof(metrics_list[0]))
+
+// relative tolerance for metrics computed in single precision
+#define REL_TOL 1e-4
+
+static void check_against_to_config(ifx_Radar_Sensor_t sensor, const ifx_Avian_Metrics_t* metrics, bool round_to_power_of_2)
+{
+    ifx_Avian_Device_t* dummy = ifx_avian_create_dummy(sensor);
+    TEST_CHECK(dummy != NULL);
+    if (!dummy)
+        return;
+
+    ifx_Avian_Config_t reference;
+    ifx_avian_get_config(dummy, &reference);
+    ifx_avian_metrics_to_config(dummy, metrics, round_to_power_of_2, &reference);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    const ifx_Avian_Device_Traits_t traits = {sensor, 0};
+    ifx_Avian_Metrics_Target_t target;
+    memset(&target, 0, sizeof(target));
+    target.metrics = *metrics;
+    target.frame_rate_Hz = 5;
+    target.goal = IFX_AVIAN_SOLVER_MIN_POWER;
+
+    ifx_Avian_Config_t config;
+    ifx_avian_get_config(dummy, &config);
+    ifx_Avian_Metrics_Solution_t solution;
+    const bool found = ifx_avian_metrics_solve(&traits, &target, round_to_power_of_2, &config, &solution);
+    TEST_CHECK(found);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    if (!found)
+    {
+        ifx_avian_destroy(dummy);
+        return;
+    }
+
+    // same RF range, samples and chirps as the plain conversion
+    TEST_CHECK(config.start_frequency_Hz == reference.start_frequency_Hz);
+    TEST_CHECK(config.end_frequency_Hz == reference.end_frequency_Hz);
+    TEST_CHECK(config.num_samples_per_chirp == reference.num_samples_per_chirp);
+    TEST_CHECK(config.num_chirps_per_frame == reference.num_chirps_per_frame);
+
+    // the plain conversion uses the longest chirp repetition time
+    TEST_CHECK(config.chirp_repetition_time_s <= reference.chirp_repetition_time_s * (1 + REL_TOL));
+    TEST_CHECK_NEAR(config.frame_repetition_time_s, 1.0 / target.frame_rate_Hz, 1e-6);
+
+    // all metrics are met
+    ifx_Avian_Metrics_t achieved;
+    ifx_avian_metrics_from_config(dummy, &config, &achieved);
+    TEST_CHECK_NEAR(achieved.range_resolution_m, metrics->range_resolution_m, metrics->range_resolution_m * REL_TOL);
+    TEST_CHECK(achieved.max_range_m >= metrics->max_range_m * (1 - REL_TOL));
+    TEST_CHECK(achieved.speed_resolution_m_s <= metrics->speed_resolution_m_s * (1 + REL_TOL));
+    TEST_CHECK(achieved.max_speed_m_s >= metrics->max_speed_m_s * (1 - REL_TOL));
+
+    TEST_CHECK(solution.average_power_W > 0);
+    TEST_CHECK(solution.acquisition_time_s > 0);
+    TEST_CHECK(solution.acquisition_time_s < config.frame_repetition_time_s);
+
+    // the device accepts the configuration
+    ifx_avian_set_config(dummy, &config);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    ifx_avian_destroy(dummy);
+}
+
+static void check_search(ifx_Radar_Sensor_t sensor)
+{
+    ifx_Avian_Device_t* dummy = ifx_avian_create_dummy(sensor);
+    ifx_Avian_Config_t defaults;
+    ifx_avian_get_config(dummy, &defaults);
+    ifx_avian_destroy(dummy);
+
+    const ifx_Avian_Device_Traits_t traits = {sensor, 0};
+    ifx_Avian_Metrics_Target_t target;
+    memset(&target, 0, sizeof(target));
+    target.metrics = metrics_list[0];
+    target.frame_rate_Hz = 10;
+
+    ifx_Avian_Config_t min_power_config = defaults;
+    ifx_Avian_Metrics_Solution_t min_power;
+    target.goal = IFX_AVIAN_SOLVER_MIN_POWER;
+    TEST_CHECK(ifx_avian_metrics_solve(&traits, &target, false, &min_power_config, &min_power));
+
+    ifx_Avian_Config_t min_time_config = defaults;
+    ifx_Avian_Metrics_Solution_t min_time;
+    target.goal = IFX_AVIAN_SOLVER_MIN_ACQUISITION_TIME;
+    TEST_CHECK(ifx_avian_metrics_solve(&traits, &target, false, &min_time_config, &min_time));
+
+    TEST_CHECK(min_power.average_power_W <= min_time.average_power_W);
+    TEST_CHECK(min_time.acquisition_time_s <= min_power.acquisition_time_s);
+
+    // a power limit below the minimum cannot be met, config is not modified
+    ifx_Avian_Config_t config = defaults;
+    target.goal = IFX_AVIAN_SOLVER_MIN_ACQUISITION_TIME;
+    target.max_power_W = min_power.average_power_W * 0.99f;
+    TEST_CHECK(!ifx_avian_metrics_solve(&traits, &target, false, &config, NULL));
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    TEST_CHECK(memcmp(&config, &defaults, sizeof(config)) == 0);
+
+    // a limit at the minimum power yields the minimum power solution
+    ifx_Avian_Metrics_Solution_t limited;
+    target.max_power_W = min_power.average_power_W * 1.0001f;
+    TEST_CHECK(ifx_avian_metrics_solve(&traits, &target, false, &config, &limited));
+    TEST_CHECK(limited.average_power_W <= target.max_power_W);
+
+    // a limited ADC sampling rate is respected
+    config = defaults;
+    target.max_power_W = 0;
+    target.max_sample_rate_Hz = 1000000;
+    TEST_CHECK(ifx_avian_metrics_solve(&traits, &target, false, &config, NULL));
+    TEST_CHECK(config.sample_rate_Hz <= target.max_sample_rate_Hz);
+}
+
+static void check_arguments(void)
+{
+    ifx_Avian_Metrics_Target_t target;
+    memset(&target, 0, sizeof(target));
+    target.metrics = metrics_list[0];
+    target.frame_rate_Hz = 10;
+
+    ifx_Avian_Config_t config;
+    memset(&config, 0, sizeof(config));
+
+    const ifx_Avian_Device_Traits_t unknown = {IFX_AVIAN_UNKNOWN, 0};
+    TEST_CHECK(!ifx_avian_metrics_solve(&unknown, &target, false, &config, NULL));
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    TEST_CHECK(!ifx_avian_metrics_solve(NULL, &target, false, &config, NULL));
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_NULL);
+}
+
+int main(void)
+{
+    for (size_t s = 0; s < NUM_SENSORS; s++)
+    {
+        for (size_t m = 0; m < NUM_METRICS; m++)
+        {
+            check_against_to_config(sensors[s], &metrics_list[m], false);
+            check_against_to_config(sensors[s], &metrics_list[m], true);
+        }
+        check_search(sensors[s]);
+    }
+    check_arguments();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,167 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_board_enumeration.cpp
+ *
+ * Tests that BoardManager::enumerate with a maximum board count returns the
+ * first boards in the order of the enumerators, independent of which of the
+ * parallel enumerators finds its boards first, and that an enumerator stops
+ * once it and the enumerators before it found enough boards.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <platform/BoardDescriptor.hpp>
+#include <platform/BoardManager.hpp>
+
+#include "Test.h"
+
+namespace {
+
+std::unique_ptr<BoardInstance> noBoard(std::shared_ptr<IBridge> &&, BoardDescriptor *)
+{
+    return nullptr;
+}
+
+const BoardData boardData[] = {
+    {0x1234, 0x0001, noBoard},
+};
+
+// reports the given boards, each one after the given delay
+class FakeEnumerator :
+    public IEnumerator
+{
+public:
+    FakeEnumerator(std::vector<std::string> names, std::chrono::milliseconds delay) :
+        m_names {std::move(names)},
+        m_delay {delay}
+    {}
+
+    void enumerate(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator) override
+    {
+        for (const auto &name : m_names)
+        {
+            if (listener.isStopped())
+            {
+                return;
+            }
+            std::this_thread::sleep_for(m_delay);
+
+            ++m_reported;
+            if (listener.onEnumerate(std::make_unique<BoardDescriptor>(*begin, name.c_str(), nullptr)))
+            {
+                return;
+            }
+        }
+    }
+
+    std::atomic<int> m_reported {0};
+
+private:
+    const std::vector<std::string> m_names;
+    const std::chrono::milliseconds m_delay;
+};
+
+class TestBoardManager :
+    public BoardManager
+{
+public:
+    using BoardManager::ConnectionType;
+
+    // enumerators run in the order of their connection types
+    FakeEnumerator &add(ConnectionType type, std::vector<std::string> names, std::chrono::milliseconds delay)
+    {
+        auto enumerator = std::make_unique<FakeEnumerator>(std::move(names), delay);
+        auto &ref       = *enumerator;
+        m_enumerators[type] = std::move(enumerator);
+        return ref;
+    }
+};
+
+std::vector<std::string> names(BoardManager &manager)
+{
+    std::vector<std::string> result;
+    for (auto &d : manager.getEnumeratedList())
+    {
+        result.emplace_back(d->getName());
+    }
+    return result;
+}
+
+void testTruncatedInEnumeratorOrder()
+{
+    using namespace std::chrono_literals;
+
+    for (uint16_t maxCount = 1; maxCount <= 5; maxCount++)
+    {
+        // the first enumerator is slow, the second one finds all its boards right away
+        TestBoardManager manager;
+        auto &slow = manager.add(TestBoardManager::ConnectionType::serial, {"a0", "a1", "a2"}, 20ms);
+        auto &fast = manager.add(TestBoardManager::ConnectionType::udp, {"b0", "b1", "b2"}, 0ms);
+
+        const std::vector<std::string> all = {"a0", "a1", "a2", "b0", "b1", "b2"};
+        const std::vector<std::string> expected(all.begin(), all.begin() + maxCount);
+
+        TEST_CHECK(manager.enumerate(std::begin(boardData), std::end(boardData), maxCount) == maxCount);
+        TEST_CHECK(names(manager) == expected);
+
+        // the first enumerator stops as soon as it found maxCount boards on its own
+        TEST_CHECK(slow.m_reported == std::min<int>(maxCount, 3));
+        // the second one may stop early only based on the boards found before it
+        TEST_CHECK(fast.m_reported >= maxCount - std::min<int>(maxCount, 3));
+    }
+}
+
+void testUnlimited()
+{
+    using namespace std::chrono_literals;
+
+    TestBoardManager manager;
+    manager.add(TestBoardManager::ConnectionType::serial, {"a0"}, 10ms);
+    manager.add(TestBoardManager::ConnectionType::udp, {"b0", "b1"}, 0ms);
+    manager.add(TestBoardManager::ConnectionType::tcp, {}, 0ms);
+
+    TEST_CHECK(manager.enumerate(std::begin(boardData), std::end(boardData)) == 3);
+    TEST_CHECK(names(manager) == (std::vector<std::string> {"a0", "b0", "b1"}));
+}
+
+}  // namespace
+
+int main()
+{
+    testTruncatedInEnumeratorOrder();
+    testUnlimited();
+    return TEST_RESULT();
+}
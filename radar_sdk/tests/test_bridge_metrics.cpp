@@ -0,0 +1,218 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_bridge_metrics.cpp
+ *
+ * Streams frames through BridgeEthernetData with a fake socket, in datagram
+ * (UDP) and in stream (TCP) mode. Every packet is delivered with a delay;
+ * the bridge_receive latency must include this delay since it measures from
+ * before the read. A gap in the packet counter must be reported as an error
+ * frame and counted in bridge_packets_lost.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <common/Metrics.hpp>
+#include <platform/ethernet/BridgeEthernetData.hpp>
+#include <platform/interfaces/IFrame.hpp>
+#include <universal/data_definitions.h>
+#include <universal/protocol/protocol_definitions.h>
+
+#include "Test.h"
+
+namespace {
+
+constexpr auto packetDelay        = std::chrono::milliseconds(2);
+constexpr uint16_t payloadSize    = 8;
+constexpr uint16_t frameHeaderLen = 6;
+
+/*
+ * Socket that delivers the packets given by push(). Each read which returns
+ * data takes packetDelay. In stream mode the packets are delivered as a
+ * byte stream which may be read in pieces.
+ */
+class FakeSocket : public ISocket
+{
+public:
+    explicit FakeSocket(Mode mode) :
+        m_mode {mode}
+    {}
+
+    void push(const std::vector<uint8_t> &packet)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_packets.push_back(packet);
+    }
+
+    Mode getMode() const override { return m_mode; }
+    uint16_t maxPayload() const override { return 1024; }
+    bool isOpened() override { return true; }
+    void close() override {}
+    void setInputBufferSize(uint32_t) override {}
+    bool checkInputBuffer() override { return true; }
+    void setTimeout(uint16_t) override {}
+    void open(uint16_t, uint16_t, ipAddress_t, uint16_t) override {}
+    void send(const uint8_t[], uint16_t) override {}
+
+    uint16_t receive(uint8_t buffer[], uint16_t length) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (m_packets.empty())
+            {
+                length = 0;
+            }
+        }
+        if (!length)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            return 0;
+        }
+
+        std::this_thread::sleep_for(packetDelay);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto &packet      = m_packets.front();
+        const auto count  = static_cast<uint16_t>(std::min<std::size_t>(length, packet.size() - m_offset));
+        std::memcpy(buffer, packet.data() + m_offset, count);
+        m_offset += count;
+        if (m_mode == Mode::Datagram || m_offset == packet.size())
+        {
+            m_packets.pop_front();
+            m_offset = 0;
+        }
+        return count;
+    }
+
+    bool dumpPacket() override
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_packets.empty())
+            return false;
+        m_packets.pop_front();
+        m_offset = 0;
+        return true;
+    }
+
+private:
+    const Mode m_mode;
+    std::mutex m_lock;
+    std::deque<std::vector<uint8_t>> m_packets;
+    std::size_t m_offset = 0;
+};
+
+// single packet frame whose payload bytes are counter + i
+std::vector<uint8_t> makePacket(uint16_t counter)
+{
+    std::vector<uint8_t> packet(frameHeaderLen + payloadSize);
+    packet[0] = DATA_FRAME_SINGLE_PACKET;
+    packet[1] = 0;
+    packet[2] = static_cast<uint8_t>(counter);
+    packet[3] = static_cast<uint8_t>(counter >> 8);
+    packet[4] = static_cast<uint8_t>(payloadSize);
+    packet[5] = 0;
+    for (uint16_t i = 0; i < payloadSize; i++)
+    {
+        packet[frameHeaderLen + i] = static_cast<uint8_t>(counter + i);
+    }
+    return packet;
+}
+
+bool checkDataFrame(IFrame *frame, uint16_t counter)
+{
+    if (!frame || frame->getStatusCode() != 0 || frame->getDataSize() != payloadSize)
+        return false;
+    for (uint16_t i = 0; i < payloadSize; i++)
+    {
+        if (frame->getData()[i] != static_cast<uint8_t>(counter + i))
+            return false;
+    }
+    return true;
+}
+
+void test_stream(ISocket::Mode mode)
+{
+    auto &metrics      = Metrics::instance();
+    auto &receive      = metrics.latency("bridge_receive");
+    auto &packetsLost  = metrics.counter("bridge_packets_lost");
+    metrics.reset();
+
+    FakeSocket socket(mode);
+    ipAddress_t ip = {127, 0, 0, 1};
+    BridgeEthernetData bridge(socket, ip);
+    bridge.setFrameBufferSize(64);
+    bridge.setFramePoolCount(8);
+    bridge.startStreaming();
+
+    // packet 3 is lost
+    const uint16_t counters[] = {0, 1, 2, 4, 5};
+    for (auto counter : counters)
+    {
+        socket.push(makePacket(counter));
+    }
+
+    for (auto counter : counters)
+    {
+        IFrame *frame = bridge.getFrame(1000);
+        if (counter == 4)
+        {
+            TEST_CHECK(frame && frame->getStatusCode() == DataError_FrameDropped);
+            if (frame)
+                frame->release();
+            frame = bridge.getFrame(1000);
+        }
+        TEST_CHECK(checkDataFrame(frame, counter));
+        if (frame)
+            frame->release();
+    }
+
+    bridge.stopStreaming();
+
+    const auto delay = static_cast<uint64_t>(std::chrono::nanoseconds(packetDelay).count());
+    TEST_CHECK(receive.getCount() >= 5);
+    TEST_CHECK(receive.getMin() >= delay);
+    TEST_CHECK(packetsLost.get() == 1);
+}
+
+}
+
+int main()
+{
+    test_stream(ISocket::Mode::Datagram);
+    test_stream(ISocket::Mode::Stream);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,311 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_bridge_serial.cpp
+ *
+ * Runs BridgeSerial on the slave side of a pseudo terminal and plays the
+ * board on the master side. Data frames split into several packets and
+ * written in small pieces must be reassembled; a gap in the packet counter
+ * and a CRC error must be reported as dropped frames. A control response
+ * whose payload arrives slowly must not keep the command from timing out.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <common/crc/Crc16.hpp>
+#include <platform/interfaces/IFrame.hpp>
+#include <platform/serial/BridgeSerial.hpp>
+#include <universal/data_definitions.h>
+#include <universal/protocol/protocol_definitions.h>
+
+#include "Test.h"
+
+namespace {
+
+constexpr uint16_t payloadSize = 8;
+
+// Master side of a pseudo terminal, the slave side is opened by the bridge
+class PseudoTerminal
+{
+public:
+    PseudoTerminal() :
+        m_master {posix_openpt(O_RDWR | O_NOCTTY)}
+    {
+        if (m_master < 0 || grantpt(m_master) || unlockpt(m_master))
+        {
+            fprintf(stderr, "no pseudo terminal available\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    ~PseudoTerminal()
+    {
+        close(m_master);
+    }
+
+    const char *slaveName() const
+    {
+        return ptsname(m_master);
+    }
+
+    // writes the data in pieces of the given size with a delay between them
+    void write(const std::vector<uint8_t> &data, std::size_t pieceSize = SIZE_MAX,
+               std::chrono::milliseconds delay = std::chrono::milliseconds(0))
+    {
+        for (std::size_t offset = 0; offset < data.size(); offset += pieceSize)
+        {
+            const auto count = std::min(pieceSize, data.size() - offset);
+            if (::write(m_master, data.data() + offset, count) != static_cast<ssize_t>(count))
+            {
+                fprintf(stderr, "write to pseudo terminal failed\n");
+                exit(EXIT_FAILURE);
+            }
+            std::this_thread::sleep_for(delay);
+        }
+    }
+
+    // reads exactly count bytes, returns false on timeout
+    bool read(std::vector<uint8_t> &data, std::size_t count)
+    {
+        data.resize(count);
+        std::size_t received = 0;
+        while (received < count)
+        {
+            pollfd fd = {m_master, POLLIN, 0};
+            if (poll(&fd, 1, 1000) <= 0)
+                return false;
+            const auto ret = ::read(m_master, data.data() + received, count - received);
+            if (ret <= 0)
+                return false;
+            received += static_cast<std::size_t>(ret);
+        }
+        return true;
+    }
+
+private:
+    int m_master;
+};
+
+void appendCrc(std::vector<uint8_t> &packet)
+{
+    const uint16_t crc = Crc16CcittFalse(packet.data(), static_cast<unsigned int>(packet.size()));
+    packet.push_back(static_cast<uint8_t>(crc >> 8));
+    packet.push_back(static_cast<uint8_t>(crc));
+}
+
+// data packet whose payload bytes are base + i
+std::vector<uint8_t> makeDataPacket(uint8_t type, uint16_t counter, uint8_t base)
+{
+    std::vector<uint8_t> packet = {
+        type,
+        0,
+        static_cast<uint8_t>(counter),
+        static_cast<uint8_t>(counter >> 8),
+        static_cast<uint8_t>(payloadSize),
+        0,
+    };
+    for (uint16_t i = 0; i < payloadSize; i++)
+    {
+        packet.push_back(static_cast<uint8_t>(base + i));
+    }
+    appendCrc(packet);
+    return packet;
+}
+
+std::vector<uint8_t> makeResponse(uint8_t type, const std::vector<uint8_t> &payload)
+{
+    std::vector<uint8_t> packet = {
+        type,
+        0,
+        static_cast<uint8_t>(payload.size()),
+        static_cast<uint8_t>(payload.size() >> 8),
+    };
+    for (auto byte : payload)
+    {
+        packet.push_back(byte);
+    }
+    appendCrc(packet);
+    return packet;
+}
+
+bool checkDataFrame(IFrame *frame, uint8_t base, uint16_t size)
+{
+    if (!frame || frame->getStatusCode() != 0 || frame->getDataSize() != size)
+        return false;
+    for (uint16_t i = 0; i < size; i++)
+    {
+        if (frame->getData()[i] != static_cast<uint8_t>(base + i))
+            return false;
+    }
+    return true;
+}
+
+bool checkErrorFrame(IFrame *frame, uint32_t code)
+{
+    return frame && frame->getStatusCode() == code;
+}
+
+void releaseFrame(IFrame *frame)
+{
+    if (frame)
+        frame->release();
+}
+
+void test_data_frames()
+{
+    PseudoTerminal terminal;
+    BridgeSerial bridge(terminal.slaveName());
+    bridge.setFrameBufferSize(64);
+    bridge.setFramePoolCount(8);
+    bridge.startStreaming();
+    auto *data = bridge.getIBridgeData();
+
+    // a frame of two packets, written in pieces of 3 bytes
+    std::vector<uint8_t> stream = makeDataPacket(DATA_FRAME_FIRST_PACKET, 0, 0);
+    for (auto byte : makeDataPacket(DATA_FRAME_LAST_PACKET, 1, payloadSize))
+    {
+        stream.push_back(byte);
+    }
+    terminal.write(stream, 3, std::chrono::milliseconds(1));
+
+    // packet 3 is lost, packet 5 has a broken CRC
+    terminal.write(makeDataPacket(DATA_FRAME_SINGLE_PACKET, 2, 20));
+    terminal.write(makeDataPacket(DATA_FRAME_SINGLE_PACKET, 4, 40));
+    auto broken = makeDataPacket(DATA_FRAME_SINGLE_PACKET, 5, 50);
+    broken.back() ^= 1;
+    terminal.write(broken);
+    terminal.write(makeDataPacket(DATA_FRAME_SINGLE_PACKET, 6, 60));
+
+    IFrame *frame = data->getFrame(1000);
+    TEST_CHECK(checkDataFrame(frame, 0, 2 * payloadSize));
+    releaseFrame(frame);
+
+    frame = data->getFrame(1000);
+    TEST_CHECK(checkDataFrame(frame, 20, payloadSize));
+    releaseFrame(frame);
+
+    frame = data->getFrame(1000);
+    TEST_CHECK(checkErrorFrame(frame, DataError_FrameDropped));
+    releaseFrame(frame);
+
+    frame = data->getFrame(1000);
+    TEST_CHECK(checkDataFrame(frame, 40, payloadSize));
+    releaseFrame(frame);
+
+    frame = data->getFrame(1000);
+    TEST_CHECK(checkErrorFrame(frame, DataError_FrameDropped));
+    releaseFrame(frame);
+
+    frame = data->getFrame(1000);
+    TEST_CHECK(checkDataFrame(frame, 60, payloadSize));
+    releaseFrame(frame);
+
+    bridge.stopStreaming();
+}
+
+void test_control_responses()
+{
+    PseudoTerminal terminal;
+    BridgeSerial bridge(terminal.slaveName());
+
+    const std::vector<uint8_t> expected = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const std::size_t requestSize       = 8 + 2;  // header and CRC
+    std::atomic<bool> requestReceived {false};
+
+    // the header of the first response arrives in time, but its payload much slower
+    // than the command timeout
+    std::thread board([&]() {
+        std::vector<uint8_t> request;
+        if (!terminal.read(request, requestSize))
+            return;
+        requestReceived = true;
+        const auto response = makeResponse(VENDOR_REQ_READ, expected);
+        terminal.write({response.begin(), response.begin() + 4});
+        terminal.write({response.begin() + 4, response.end()}, 1, std::chrono::milliseconds(40));
+
+        if (!terminal.read(request, requestSize))
+            return;
+        terminal.write(makeResponse(VENDOR_REQ_READ, expected), 5, std::chrono::milliseconds(1));
+    });
+
+    std::vector<uint8_t> buffer(expected.size());
+    const auto start = std::chrono::steady_clock::now();
+    bool failed      = false;
+    try
+    {
+        bridge.vendorRead(0x01, 0, 0, static_cast<uint16_t>(buffer.size()), buffer.data());
+    }
+    catch (const std::exception &)
+    {
+        failed = true;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    TEST_CHECK(requestReceived);
+    TEST_CHECK(failed);
+    TEST_CHECK(elapsed < std::chrono::milliseconds(400));
+
+    // wait until the late response has been sent, the next command succeeds
+    std::this_thread::sleep_for(std::chrono::milliseconds(900));
+    bool succeeded = false;
+    try
+    {
+        bridge.setDefaultTimeout();
+        bridge.vendorRead(0x01, 0, 0, static_cast<uint16_t>(buffer.size()), buffer.data());
+        succeeded = true;
+    }
+    catch (const std::exception &e)
+    {
+        fprintf(stderr, "%s\n", e.what());
+    }
+    TEST_CHECK(succeeded);
+    TEST_CHECK(buffer == expected);
+
+    board.join();
+}
+
+}
+
+int main()
+{
+    test_data_frames();
+    test_control_responses();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,202 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_crc.cpp
+ *
+ * Cross-checks the strata CRC functions against bitwise reference
+ * implementations. Crc16CcittFalse processes long buffers with carry-less
+ * multiplication where the CPU supports it and short ones with tables, so
+ * it is also checked that both paths agree by splitting buffers into short
+ * pieces.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <common/crc/Crc16.hpp>
+#include <common/crc/Crc32.hpp>
+#include <common/crc/Crc8.hpp>
+
+#include "Test.h"
+
+namespace {
+
+// MSB first, one bit per step, the last bits of each word
+template <typename Register>
+Register crcBitwise(Register crc, uint32_t data, unsigned int bits, Register polynomial)
+{
+    constexpr Register top = Register(1) << (sizeof(Register) * 8 - 1);
+    for (unsigned int b = bits; b--;)
+    {
+        const bool feedback = ((crc & top) != 0) != (((data >> b) & 1) != 0);
+        crc = static_cast<Register>(crc << 1);
+        if (feedback)
+            crc ^= polynomial;
+    }
+    return crc;
+}
+
+// LSB first, as used by Ethernet
+uint32_t crcReflectedBitwise(uint32_t crc, uint32_t data, unsigned int bits)
+{
+    for (unsigned int b = 0; b < bits; b++)
+    {
+        const bool feedback = ((crc & 1) != 0) != (((data >> b) & 1) != 0);
+        crc >>= 1;
+        if (feedback)
+            crc ^= 0xEDB88320;
+    }
+    return crc;
+}
+
+std::vector<uint8_t> randomBytes(size_t len)
+{
+    std::vector<uint8_t> bytes(len);
+    for (auto& b : bytes)
+        b = static_cast<uint8_t>(test_random());
+    return bytes;
+}
+
+std::vector<uint16_t> randomWords(size_t len, unsigned int bits)
+{
+    std::vector<uint16_t> words(len);
+    for (auto& w : words)
+        w = static_cast<uint16_t>(test_random() & ((1u << bits) - 1));
+    return words;
+}
+
+void testCrc16Bytes()
+{
+    // all lengths around the block sizes of the folding, at all alignments
+    for (unsigned int len = 0; len < 300; len++)
+    {
+        const auto data = randomBytes(len + 16);
+        const unsigned int offset = len % 16;
+        const auto* buf = data.data() + offset;
+        const auto seed = static_cast<uint16_t>(test_random());
+
+        uint16_t reference = seed;
+        for (unsigned int i = 0; i < len; i++)
+            reference = crcBitwise<uint16_t>(reference, buf[i], 8, 0x1021);
+        TEST_CHECK(Crc16CcittFalse(buf, len, seed) == reference);
+
+        // pieces shorter than the minimum length of the folding use the tables only
+        uint16_t pieces = seed;
+        for (unsigned int i = 0; i < len; i += 63)
+            pieces = Crc16CcittFalse(buf + i, (len - i < 63) ? (len - i) : 63, pieces);
+        TEST_CHECK(pieces == reference);
+    }
+
+    // a large serial packet
+    const auto packet = randomBytes(64 * 1024 + 5);
+    uint16_t pieces = CRC16_CCITT_FALSE_SEED;
+    for (size_t i = 0; i < packet.size(); i += 48)
+        pieces = Crc16CcittFalse(packet.data() + i, static_cast<unsigned int>(std::min<size_t>(48, packet.size() - i)), pieces);
+    TEST_CHECK(Crc16CcittFalse(packet.data(), static_cast<unsigned int>(packet.size())) == pieces);
+
+    // check value of the CRC-16/CCITT-FALSE catalogue
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    TEST_CHECK(Crc16CcittFalse(check, sizeof(check)) == 0x29B1);
+}
+
+void testWords()
+{
+    for (unsigned int bits = 1; bits <= 16; bits++)
+    {
+        for (unsigned int len : {0u, 1u, 7u, 100u})
+        {
+            const auto words = randomWords(len, bits);
+            const auto seed16 = static_cast<uint16_t>(test_random());
+            const auto seed32 = test_random();
+            // Crc16CcittFalse processes words with less than 8 bits as whole byte
+            const unsigned int crc16Bits = (bits < 8) ? 8 : bits;
+
+            uint16_t crc16 = seed16;
+            uint32_t mpeg2 = seed32;
+            uint32_t ethernet = seed32;
+            for (auto w : words)
+            {
+                crc16 = crcBitwise<uint16_t>(crc16, w, crc16Bits, 0x1021);
+                mpeg2 = crcBitwise<uint32_t>(mpeg2, w, bits, 0x04C11DB7);
+                ethernet = crcReflectedBitwise(ethernet, w, bits);
+            }
+
+            const auto n = static_cast<uint16_t>(len);
+            TEST_CHECK(Crc16CcittFalse(words.data(), len, bits, seed16) == crc16);
+            TEST_CHECK(Crc32Mpeg2(words.data(), n, bits, seed32) == mpeg2);
+            TEST_CHECK(Crc32Ethernet(words.data(), n, bits, seed32) == static_cast<uint32_t>(~ethernet));
+        }
+    }
+}
+
+void testCrc32Bytes()
+{
+    for (unsigned int len = 0; len < 70; len++)
+    {
+        const auto data = randomBytes(len);
+        const auto seed = test_random();
+
+        uint32_t autosar = seed;
+        uint32_t mpeg2 = seed;
+        uint32_t reflected = seed;
+        for (auto b : data)
+        {
+            autosar = crcBitwise<uint32_t>(autosar, b, 8, 0xF4ACFB13);
+            mpeg2 = crcBitwise<uint32_t>(mpeg2, b, 8, 0x04C11DB7);
+            // reflected input, processed MSB first
+            uint32_t r = 0;
+            for (unsigned int i = 0; i < 8; i++)
+                r |= ((b >> i) & 1u) << (7 - i);
+            reflected = crcBitwise<uint32_t>(reflected, r, 8, 0x04C11DB7);
+        }
+
+        const auto n = static_cast<uint16_t>(len);
+        TEST_CHECK(Crc32Autosar(data.data(), n, seed) == autosar);
+        TEST_CHECK(Crc32(data.data(), n, 0x04C11DB7, false, false, false, seed) == mpeg2);
+        TEST_CHECK(Crc32(data.data(), n, 0x04C11DB7, false, false, true, seed) == static_cast<uint32_t>(~mpeg2));
+        TEST_CHECK(Crc32(data.data(), n, 0x04C11DB7, true, false, false, seed) == reflected);
+        TEST_CHECK(Crc8Smbus(data.data(), n) == Crc8(data.data(), n, 0x07, 0));
+    }
+
+    // check value of the CRC-32/BZIP2 catalogue
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    TEST_CHECK(Crc32Bzip2(check, sizeof(check)) == 0xFC891918);
+}
+
+}  // namespace
+
+int main()
+{
+    testCrc16Bytes();
+    testWords();
+    testCrc32Bytes();
+    return TEST_RESULT();
+}
@@ -0,0 +1,421 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_cw_streaming.cpp
+ *
+ * Tests CW streaming of DeviceCwAvian with a fake Avian port that delivers
+ * numbered captures: frames arrive complete and in order in queue and
+ * callback mode, a slow callback does not delay the next capture while raw
+ * buffers are free, and a device that stops responding ends the stream
+ * with an error and a reset.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ifxBase/Exception.hpp"
+#include "ifxCw/avian/DeviceCwAvian.hpp"
+
+#include "Test.h"
+
+namespace {
+
+using namespace Infineon::Avian;
+using Clock = std::chrono::steady_clock;
+
+constexpr auto capture_duration = std::chrono::milliseconds(20);
+
+// STAT0.PM == 1 (active power mode)
+constexpr HW::Spi_Response_t status_active = 1u << 5;
+
+/*
+ * Emulates an Avian device in CW mode. A write to the MAIN register with
+ * FRAME_START set starts a capture into the buffer set by set_buffer, if
+ * there is one. The capture is delivered by a worker thread after
+ * capture_duration. Sample i of capture k holds (k * num_samples + i) mod 4096.
+ */
+class FakeAvianPort : public HW::IPort<HW::Packed_Raw_Data_t>
+{
+public:
+    FakeAvianPort() :
+        m_worker([this]() { run(); })
+    {}
+
+    ~FakeAvianPort() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_shutdown = true;
+        }
+        m_notifier.notify_all();
+        m_worker.join();
+    }
+
+    const Properties& get_properties() const override
+    {
+        return m_properties;
+    }
+
+    void send_commands(const HW::Spi_Command_t* commands, size_t num_words,
+                       HW::Spi_Response_t* response = nullptr) override
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (size_t i = 0; i < num_words; i++)
+        {
+            if (response)
+                response[i] = m_responding ? status_active : 0;
+
+            const bool main_write = (commands[i] >> 24) == 0x01;
+            if (main_write && (commands[i] & 1) && m_armed && m_responding)
+            {
+                if (m_num_drops)
+                {
+                    m_num_drops--;
+                    continue;
+                }
+                m_capturing = m_armed;
+                m_armed = nullptr;
+                m_trigger_times.push_back(Clock::now());
+                m_notifier.notify_all();
+            }
+        }
+    }
+
+    void generate_reset_sequence() override
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_num_resets++;
+    }
+
+    bool read_irq_level() override
+    {
+        return false;
+    }
+
+    void start_reader(HW::Spi_Command_t, size_t burst_size, Data_Ready_Callback_t callback) override
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_burst_size = burst_size;
+        m_callback = std::move(callback);
+    }
+
+    void stop_reader() override
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_notifier.wait(lock, [this]() { return !m_delivering; });
+        m_callback = nullptr;
+        m_armed = nullptr;
+        m_capturing = nullptr;
+    }
+
+    void set_buffer(HW::Packed_Raw_Data_t* buffer) override
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_armed = buffer;
+    }
+
+    void set_responding(bool responding)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_responding = responding;
+    }
+
+    void drop_captures(unsigned count)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_num_drops = count;
+    }
+
+    unsigned num_resets()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_num_resets;
+    }
+
+    // Returns the longest time the device was idle between the end of a
+    // capture and the trigger of the next one.
+    Clock::duration max_idle_time()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        Clock::duration max_idle {};
+        for (size_t k = 0; k < m_done_times.size() && k + 1 < m_trigger_times.size(); k++)
+            max_idle = std::max(max_idle, m_trigger_times[k + 1] - m_done_times[k]);
+        return max_idle;
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        while (true)
+        {
+            m_notifier.wait(lock, [this]() { return m_shutdown || m_capturing; });
+            if (m_shutdown)
+                return;
+
+            lock.unlock();
+            std::this_thread::sleep_for(capture_duration);
+            lock.lock();
+            if (!m_capturing || !m_callback)
+                continue;
+
+            // two 12 bit values are packed into three bytes
+            auto* write_ptr = m_capturing;
+            for (size_t i = 0; i < m_burst_size; i += 2)
+            {
+                const uint16_t first = (m_num_captures * m_burst_size + i) % 4096;
+                const uint16_t second = (first + 1) % 4096;
+                *write_ptr++ = uint8_t(first >> 4);
+                *write_ptr++ = uint8_t(((first & 0x0F) << 4) | (second >> 8));
+                *write_ptr++ = uint8_t(second);
+            }
+            m_num_captures++;
+            m_capturing = nullptr;
+            m_done_times.push_back(Clock::now());
+
+            m_delivering = true;
+            auto callback = m_callback;
+            lock.unlock();
+            callback(0);
+            lock.lock();
+            m_delivering = false;
+            m_notifier.notify_all();
+        }
+    }
+
+    Properties m_properties {"Fake Avian", false, 2};
+    std::mutex m_lock;
+    std::condition_variable m_notifier;
+    Data_Ready_Callback_t m_callback;
+    size_t m_burst_size = 0;
+    HW::Packed_Raw_Data_t* m_armed = nullptr;
+    HW::Packed_Raw_Data_t* m_capturing = nullptr;
+    bool m_delivering = false;
+    bool m_responding = true;
+    bool m_shutdown = false;
+    unsigned m_num_drops = 0;
+    unsigned m_num_resets = 0;
+    unsigned m_num_captures = 0;
+    std::vector<Clock::time_point> m_trigger_times;
+    std::vector<Clock::time_point> m_done_times;
+    std::thread m_worker;
+};
+
+// Replaces the dummy port of a DeviceCwAvian by a fake port
+FakeAvianPort* attach_fake_port(DeviceCwAvian& device)
+{
+    auto port = std::make_unique<FakeAvianPort>();
+    auto* fake = port.get();
+    device.m_cw_controller = std::make_unique<Continuous_Wave_Controller>(*port, device.m_cw_controller->get_driver());
+    device.m_avian_port = std::move(port);
+    return fake;
+}
+
+// Returns the number k of the capture in frame, or -1 if the samples do not
+// follow the pattern of the fake port.
+int capture_number(const ifx_Matrix_R_t* frame)
+{
+    const uint32_t num_samples = IFX_MAT_COLS(frame);
+    long first = -1;
+    for (uint32_t i = 0; i < num_samples; i++)
+    {
+        const long value = std::lround((IFX_MAT_AT(frame, 0, i) + 1) * 4095 / 2);
+        if (i == 0)
+            first = value;
+        else if (value != (first + i) % 4096)
+            return -1;
+    }
+    if (first % num_samples)
+        return -1;
+    return int(first / num_samples);
+}
+
+template <typename Exception, typename Function>
+bool throws(Function&& function)
+{
+    try
+    {
+        function();
+    }
+    catch (const Exception&)
+    {
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return false;
+}
+
+struct CallbackRecord
+{
+    std::mutex lock;
+    std::condition_variable notifier;
+    std::vector<int> captures;
+    unsigned num_errors = 0;
+    ifx_Error_t last_error = IFX_OK;
+    unsigned slow_frame = ~0u;
+};
+
+void record_frame(const ifx_Matrix_R_t* frame, ifx_Error_t error, void* context)
+{
+    auto* record = static_cast<CallbackRecord*>(context);
+    unsigned index;
+    {
+        std::lock_guard<std::mutex> lock(record->lock);
+        if (frame)
+            record->captures.push_back(capture_number(frame));
+        else
+            record->num_errors++;
+        record->last_error = error;
+        index = unsigned(record->captures.size());
+    }
+    record->notifier.notify_all();
+
+    // a slow callback takes as long as 2.5 captures
+    if (frame && index == record->slow_frame)
+        std::this_thread::sleep_for(capture_duration * 5 / 2);
+}
+
+template <typename Predicate>
+bool wait_for_record(CallbackRecord& record, Predicate predicate)
+{
+    std::unique_lock<std::mutex> lock(record.lock);
+    return record.notifier.wait_for(lock, std::chrono::seconds(10), [&]() { return predicate(record); });
+}
+
+}  // namespace
+
+// Frames are queued in order; a lost capture is counted as gap
+static void test_queue_mode()
+{
+    DeviceCwAvian device(IFX_AVIAN_BGT60TR13C);
+    auto* port = attach_fake_port(device);
+    device.start_signal();
+
+    port->drop_captures(1);
+    device.start_streaming(4, nullptr, nullptr);
+    TEST_CHECK(device.is_streaming());
+
+    ifx_Matrix_R_t* frame = nullptr;
+    int previous = -1;
+    for (int i = 0; i < 10; i++)
+    {
+        frame = device.get_next_frame(frame, 2000);
+        const int k = capture_number(frame);
+        TEST_CHECK(k == previous + 1);
+        previous = k;
+    }
+    ifx_mat_destroy_r(frame);
+
+    const unsigned resets_before_stop = port->num_resets();
+    device.stop_streaming();
+    TEST_CHECK(!device.is_streaming());
+    TEST_CHECK(port->num_resets() == resets_before_stop + 1);
+    TEST_CHECK(device.m_cw_controller->is_continuous_wave_enabled());
+
+    ifx_Cw_Stream_Statistics_t statistics;
+    device.get_stream_statistics(&statistics);
+    TEST_CHECK(statistics.num_frames >= 10);
+    TEST_CHECK(statistics.num_gaps == 1);
+    TEST_CHECK(throws<rdk::exception::not_possible>([&]() { device.get_next_frame(nullptr, 10); }));
+}
+
+// A callback slower than one capture does not delay the next capture
+static void test_slow_callback()
+{
+    DeviceCwAvian device(IFX_AVIAN_BGT60TR13C);
+    auto* port = attach_fake_port(device);
+    device.start_signal();
+
+    CallbackRecord record;
+    record.slow_frame = 3;
+    device.start_streaming(4, record_frame, &record);
+    TEST_CHECK(wait_for_record(record, [](CallbackRecord& r) { return r.captures.size() >= 10; }));
+    device.stop_streaming();
+
+    for (size_t i = 0; i < record.captures.size(); i++)
+        TEST_CHECK(record.captures[i] == int(i));
+    TEST_CHECK(record.num_errors == 0);
+    TEST_CHECK(record.last_error == IFX_OK);
+
+    // the idle time stays far below the 30 ms the slow callback overruns a capture
+    TEST_CHECK(port->max_idle_time() < capture_duration / 2);
+}
+
+// A device that stops responding ends the stream with an error and a reset
+static void test_failure()
+{
+    DeviceCwAvian device(IFX_AVIAN_BGT60TR13C);
+    auto* port = attach_fake_port(device);
+    device.start_signal();
+
+    CallbackRecord record;
+    device.start_streaming(2, record_frame, &record);
+    TEST_CHECK(wait_for_record(record, [](CallbackRecord& r) { return r.captures.size() >= 3; }));
+
+    const unsigned resets_before_failure = port->num_resets();
+    port->set_responding(false);
+    TEST_CHECK(wait_for_record(record, [](CallbackRecord& r) { return r.num_errors > 0; }));
+    TEST_CHECK(record.num_errors == 1);
+    TEST_CHECK(record.last_error == IFX_ERROR_COMMUNICATION_ERROR);
+
+    device.stop_streaming();
+    TEST_CHECK(!device.is_streaming());
+    TEST_CHECK(port->num_resets() == resets_before_failure + 1);
+    TEST_CHECK(!device.m_cw_controller->is_continuous_wave_enabled());
+
+    // in queue mode the failure is reported by get_next_frame
+    port->set_responding(true);
+    device.start_signal();
+    device.start_streaming(2, nullptr, nullptr);
+    ifx_Matrix_R_t* frame = device.get_next_frame(nullptr, 2000);
+    port->set_responding(false);
+    bool failed = false;
+    for (int i = 0; i < 10 && !failed; i++)
+        failed = throws<rdk::exception::communication_error>([&]() { device.get_next_frame(frame, 2000); });
+    TEST_CHECK(failed);
+    ifx_mat_destroy_r(frame);
+}
+
+int main()
+{
+    test_queue_mode();
+    test_slow_callback();
+    test_failure();
+    return TEST_RESULT();
+}
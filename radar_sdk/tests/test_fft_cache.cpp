@@ -0,0 +1,217 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_fft_cache.cpp
+ *
+ * Tests the process-wide cache of window coefficients and FFT plans: equal
+ * configurations share one object that is destroyed with its last user,
+ * shared windows equal freshly computed ones, and FFT handles sharing a
+ * plan give the DFT, also when they run concurrently.
+ */
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "ifxAlgo/FFT.h"
+#include "ifxAlgo/Window.h"
+#include "ifxBase/Complex.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Vector.h"
+#include "ifxBase/internal/Cache.h"
+
+#include "Test.h"
+
+static void test_window_sharing()
+{
+    const size_t objects = ifx_cache_size();
+
+    ifx_Window_Config_t config = {IFX_WINDOW_CHEBYSHEV, 64, 60, 1};
+    const ifx_Vector_R_t* first = ifx_window_acquire(&config, false);
+    const ifx_Vector_R_t* second = ifx_window_acquire(&config, false);
+    TEST_CHECK(first != nullptr && first == second);
+    TEST_CHECK(ifx_cache_size() == objects + 1);
+
+    // the coefficients equal a window computed without the cache
+    ifx_Vector_R_t* expected = ifx_vec_create_r(64);
+    ifx_window_init(&config, expected);
+    for (uint32_t i = 0; i < 64; i++)
+        TEST_CHECK(IFX_VEC_AT(first, i) == IFX_VEC_AT(expected, i));
+
+    // attenuation, normalization and scale are part of the key
+    config.at_dB = 80;
+    const ifx_Vector_R_t* other_attenuation = ifx_window_acquire(&config, false);
+    const ifx_Vector_R_t* normalized = ifx_window_acquire(&config, true);
+    config.scale = 2;
+    const ifx_Vector_R_t* scaled = ifx_window_acquire(&config, true);
+    TEST_CHECK(other_attenuation != first && normalized != other_attenuation && scaled != normalized);
+    TEST_CHECK(ifx_cache_size() == objects + 4);
+
+    float sum = 0, scaled_sum = 0;
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        sum += IFX_VEC_AT(normalized, i);
+        scaled_sum += IFX_VEC_AT(scaled, i);
+    }
+    TEST_CHECK_NEAR(sum, 1, 1e-5);
+    TEST_CHECK_NEAR(scaled_sum, 2, 1e-5);
+
+    // the attenuation only matters for Chebyshev windows
+    ifx_Window_Config_t hann_a = {IFX_WINDOW_HANN, 64, 10, 1};
+    ifx_Window_Config_t hann_b = {IFX_WINDOW_HANN, 64, 20, 0};
+    const ifx_Vector_R_t* hann = ifx_window_acquire(&hann_a, false);
+    TEST_CHECK(ifx_window_acquire(&hann_b, false) == hann);
+    ifx_window_release(hann);
+    ifx_window_release(hann);
+
+    // an object is destroyed when its last user releases it
+    ifx_window_release(first);
+    TEST_CHECK(ifx_cache_size() == objects + 4);
+    ifx_window_release(second);
+    TEST_CHECK(ifx_cache_size() == objects + 3);
+    ifx_window_release(other_attenuation);
+    ifx_window_release(normalized);
+    ifx_window_release(scaled);
+    ifx_window_release(nullptr);
+    TEST_CHECK(ifx_cache_size() == objects);
+
+    config.type = static_cast<ifx_Window_Type_t>(9);
+    TEST_CHECK(ifx_window_acquire(&config, false) == nullptr);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    ifx_vec_destroy_r(expected);
+}
+
+static const double pi = 3.14159265358979323846;
+
+// Compares the FFT of input with the DFT
+static void check_dft(const std::vector<ifx_Complex_t>& input, const ifx_Vector_C_t* output, uint32_t bins)
+{
+    const size_t n = input.size();
+    for (uint32_t k = 0; k < bins; k++)
+    {
+        double re = 0, im = 0;
+        for (size_t j = 0; j < n; j++)
+        {
+            const double phi = -2 * pi * double(k * j % n) / double(n);
+            re += IFX_COMPLEX_REAL(input[j]) * std::cos(phi) - IFX_COMPLEX_IMAG(input[j]) * std::sin(phi);
+            im += IFX_COMPLEX_REAL(input[j]) * std::sin(phi) + IFX_COMPLEX_IMAG(input[j]) * std::cos(phi);
+        }
+        TEST_CHECK_NEAR(IFX_COMPLEX_REAL(IFX_VEC_AT(output, k)), re, 1e-3);
+        TEST_CHECK_NEAR(IFX_COMPLEX_IMAG(IFX_VEC_AT(output, k)), im, 1e-3);
+    }
+}
+
+static void test_fft_plan_sharing()
+{
+    const uint32_t size = 128;
+    const size_t objects = ifx_cache_size();
+
+    // only the plan of the requested type is created and shared
+    ifx_FFT_t* real_a = ifx_fft_create(IFX_FFT_TYPE_R2C, size);
+    ifx_FFT_t* real_b = ifx_fft_create(IFX_FFT_TYPE_R2C, size);
+    TEST_CHECK(real_a != nullptr && real_b != nullptr);
+    TEST_CHECK(ifx_cache_size() == objects + 1);
+    ifx_FFT_t* complex = ifx_fft_create(IFX_FFT_TYPE_C2C, size);
+    TEST_CHECK(ifx_cache_size() == objects + 2);
+
+    test_seed(39);
+    std::vector<ifx_Complex_t> real_input(size), complex_input(size);
+    ifx_Vector_R_t* real_vector = ifx_vec_create_r(size);
+    ifx_Vector_C_t* complex_vector = ifx_vec_create_c(size);
+    for (uint32_t j = 0; j < size; j++)
+    {
+        IFX_COMPLEX_SET(real_input[j], test_uniform(-1, 1), 0);
+        IFX_COMPLEX_SET(complex_input[j], test_uniform(-1, 1), test_uniform(-1, 1));
+        IFX_VEC_AT(real_vector, j) = IFX_COMPLEX_REAL(real_input[j]);
+        IFX_VEC_AT(complex_vector, j) = complex_input[j];
+    }
+
+    // each handle has its own scratch buffer, so handles sharing a plan can run concurrently
+    const int num_threads = 4;
+    std::vector<ifx_FFT_t*> handles;
+    for (int t = 0; t < num_threads; t++)
+        handles.push_back(ifx_fft_create(IFX_FFT_TYPE_R2C, size));
+    TEST_CHECK(ifx_cache_size() == objects + 2);
+
+    std::vector<ifx_Vector_C_t*> outputs;
+    for (int t = 0; t < num_threads; t++)
+        outputs.push_back(ifx_vec_create_c(size / 2 + 1));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++)
+    {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 2000; i++)
+                ifx_fft_run_rc(handles[t], real_vector, outputs[t]);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int t = 0; t < num_threads; t++)
+    {
+        check_dft(real_input, outputs[t], size / 2 + 1);
+        ifx_vec_destroy_c(outputs[t]);
+        ifx_fft_destroy(handles[t]);
+    }
+
+    ifx_Vector_C_t* output = ifx_vec_create_c(size);
+    ifx_fft_run_rc(real_a, real_vector, output);
+    check_dft(real_input, output, size);
+    ifx_fft_run_c(complex, complex_vector, output);
+    check_dft(complex_input, output, size);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    // the raw real transform needs a real plan
+    ifx_fft_raw_rc(complex, &IFX_VEC_AT(real_vector, 0), &IFX_VEC_AT(output, 0));
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID_EXPECTED_REAL);
+
+    // the plan stays while a handle uses it
+    ifx_fft_destroy(real_a);
+    TEST_CHECK(ifx_cache_size() == objects + 2);
+    ifx_fft_run_rc(real_b, real_vector, output);
+    check_dft(real_input, output, size);
+    ifx_fft_destroy(real_b);
+    ifx_fft_destroy(complex);
+    TEST_CHECK(ifx_cache_size() == objects);
+
+    ifx_vec_destroy_c(output);
+    ifx_vec_destroy_c(complex_vector);
+    ifx_vec_destroy_r(real_vector);
+}
+
+int main()
+{
+    test_window_sharing();
+    test_fft_plan_sharing();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,416 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_fmcw_reconnect.cpp
+ *
+ * Tests the automatic reconnect of get_next_raw_frame with a fake bridge:
+ * a lost connection is recovered once per call, the acquisition is
+ * restarted on the new connection, and errors are reported when auto
+ * reconnect is disabled or the new connection fails as well.
+ */
+
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "ifxBase/Exception.hpp"
+#include "ifxFmcw/DeviceFmcwBase.hpp"
+
+#include <platform/BoardInstance.hpp>
+#include <platform/interfaces/IBoard.hpp>
+#include <platform/interfaces/IBridge.hpp>
+#include <universal/data_definitions.h>
+
+#include "Test.h"
+
+namespace {
+
+constexpr uint32_t num_chirps = 4;
+constexpr uint32_t num_samples_per_chirp = 8;
+constexpr uint32_t frame_size = num_chirps * num_samples_per_chirp;
+
+class FakeFrame : public IFrame
+{
+public:
+    FakeFrame(std::vector<uint8_t> data, uint32_t status) :
+        m_data {std::move(data)},
+        m_size {static_cast<uint32_t>(m_data.size())},
+        m_status {status}
+    {}
+
+    uint8_t* getData() const override { return const_cast<uint8_t*>(m_data.data()) + m_offset; }
+    uint32_t getDataSize() const override { return m_size; }
+    void setDataOffset(uint32_t offset) override { m_offset = offset; }
+    void setDataSize(uint32_t size) override { m_size = size; }
+    void setDataOffsetAndSize(uint32_t offset, uint32_t size) override
+    {
+        m_offset = offset;
+        m_size = size;
+    }
+    uint32_t getDataOffset() const override { return m_offset; }
+    uint8_t* getBuffer() const override { return const_cast<uint8_t*>(m_data.data()); }
+    uint32_t getBufferSize() const override { return static_cast<uint32_t>(m_data.size()); }
+    uint8_t getVirtualChannel() const override { return 0; }
+    void setVirtualChannel(uint8_t) override {}
+    uint64_t getTimestamp() const override { return 0; }
+    void setTimestamp(uint64_t) override {}
+    uint32_t getStatusCode() const override { return m_status; }
+    void hold() override {}
+    void release() override { delete this; }
+
+private:
+    std::vector<uint8_t> m_data;
+    uint32_t m_offset = 0;
+    uint32_t m_size;
+    uint32_t m_status;
+};
+
+// Bridge that returns queued slices, or a lost connection once the queue is empty
+class FakeBridge :
+    public IBridge,
+    public IBridgeControl,
+    public IBridgeData,
+    public IData
+{
+public:
+    explicit FakeBridge(const std::string& uuid) :
+        m_uuid {uuid}
+    {}
+
+    // queues one frame of raw 16-bit samples with the value first, first + 1, ...
+    void queueFrame(uint16_t first)
+    {
+        std::vector<uint8_t> data(frame_size * sizeof(uint16_t));
+        for (uint32_t i = 0; i < frame_size; i++)
+        {
+            const auto value = static_cast<uint16_t>(first + i);
+            std::memcpy(&data[i * sizeof(uint16_t)], &value, sizeof(value));
+        }
+        m_slices.emplace_back(std::move(data), DataError_NoError);
+    }
+
+    void queueLostConnection()
+    {
+        m_slices.emplace_back(std::vector<uint8_t>(), DataError_LowLevelError);
+    }
+
+    uint32_t m_starts = 0;
+    bool m_closed = false;
+
+    // IBridge
+    bool isConnected() override { return !m_closed; }
+    void openConnection() override { m_closed = false; }
+    void closeConnection() override { m_closed = true; }
+    IBridgeControl* getIBridgeControl() override { return this; }
+    IBridgeData* getIBridgeData() override { return this; }
+
+    // IBridgeControl
+    IVendorCommands* getIVendorCommands() override { return nullptr; }
+    void checkVersion() override {}
+    void getBoardInfo(BoardInfo_t&) override {}
+    const VersionInfo_t& getVersionInfo() override { return m_version; }
+    const std::string& getVersionString() override { return m_versionString; }
+    const std::string& getExtendedVersionString() override { return m_versionString; }
+    const Uuid_t& getUuid() override { return m_uuidBytes; }
+    const std::string& getUuidString() override { return m_uuid; }
+    void activateBootloader() override {}
+    void setDefaultTimeout() override {}
+    uint16_t getMaxTransfer() const override { return 1024; }
+    IData* getIData() override { return this; }
+    IGpio* getIGpio() override { return nullptr; }
+    II2c* getII2c() override { return nullptr; }
+    ISpi* getISpi() override { return nullptr; }
+    IFlash* getIFlash() override { return nullptr; }
+    IMemory<uint32_t>* getIMemory() override { return nullptr; }
+
+    // IBridgeData
+    void setFrameBufferSize(uint32_t) override {}
+    void setFrameQueueSize(uint16_t) override {}
+    void clearFrameQueue() override { m_slices.clear(); }
+    void startStreaming() override { m_starts++; }
+    void stopStreaming() override {}
+    void registerListener(IFrameListener<>*) override {}
+    IFrame* getFrame(uint16_t) override
+    {
+        if (m_closed || m_slices.empty())
+        {
+            return new FakeFrame({}, DataError_LowLevelError);
+        }
+        auto& slice = m_slices.front();
+        auto* frame = new FakeFrame(std::move(slice.first), slice.second);
+        m_slices.pop_front();
+        return frame;
+    }
+
+    // IData
+    void configure(uint8_t, const IDataProperties_t*, const uint8_t*, uint16_t) override {}
+    void start(uint8_t) override {}
+    void stop(uint8_t) override {}
+    uint32_t getStatusFlags(uint8_t) override { return 0; }
+
+private:
+    std::string m_uuid;
+    std::string m_versionString = "fake";
+    VersionInfo_t m_version = {3, 0, 0};
+    Uuid_t m_uuidBytes = {};
+    std::deque<std::pair<std::vector<uint8_t>, uint32_t>> m_slices;
+};
+
+class FakeBoard : public IBoard
+{
+public:
+    IModule* getIModule(uint16_t, uint8_t) override { return nullptr; }
+    IComponent* getIComponent(uint16_t, uint8_t) override { return nullptr; }
+    uint8_t getIModuleCount(uint16_t) override { return 0; }
+    uint8_t getIComponentCount(uint16_t) override { return 0; }
+};
+
+std::unique_ptr<BoardInstance> make_board(const std::shared_ptr<FakeBridge>& bridge)
+{
+    return std::make_unique<BoardInstance>(bridge, std::make_unique<FakeBoard>(), "fake board");
+}
+
+/*
+ * Device with a single chirp loop, reading raw 16-bit samples. Reconnecting
+ * takes the next board prepared by the test instead of enumerating, and
+ * otherwise does what DeviceFmcwAvian::reconnect does.
+ */
+struct FakeDevice : public DeviceFmcwBase
+{
+    explicit FakeDevice(const std::shared_ptr<FakeBridge>& bridge) :
+        DeviceFmcwBase(4095.0f, make_board(bridge))
+    {}
+
+    std::shared_ptr<FakeBridge> m_next_bridge;
+    uint32_t m_reconnects = 0;
+    bool m_data_started = false;
+
+    void reconnect(uint32_t) override
+    {
+        m_reconnects++;
+        const bool restart = m_data_started;
+
+        m_board->getIBridge()->closeConnection();
+        if (!m_next_bridge)
+        {
+            throw rdk::exception::no_device();
+        }
+        replace_board(make_board(m_next_bridge));
+        m_next_bridge.reset();
+
+        m_data_started = false;
+        if (restart)
+        {
+            start_acquisition();
+        }
+    }
+
+    void start_acquisition() override
+    {
+        if (m_data_started)
+        {
+            return;
+        }
+        update_defaults_if_not_configured();
+        configure_data(frame_size, 0, DataFormat_Raw16);
+        start_data();
+        m_data_started = true;
+    }
+
+    void stop_acquisition() override
+    {
+        if (m_data_started)
+        {
+            stop_data();
+        }
+        m_data_started = false;
+    }
+
+    ifx_Fmcw_Sequence_Element_t* get_acquisition_sequence() const override
+    {
+        auto* frame_loop = ifx_fmcw_create_sequence_element(IFX_SEQ_LOOP);
+        auto* chirp_loop = ifx_fmcw_create_sequence_element(IFX_SEQ_LOOP);
+        auto* chirp = ifx_fmcw_create_sequence_element(IFX_SEQ_CHIRP);
+        frame_loop->loop.sub_sequence = chirp_loop;
+        frame_loop->loop.repetition_time_s = 0.1f;
+        chirp_loop->loop.sub_sequence = chirp;
+        chirp_loop->loop.num_repetitions = num_chirps;
+        chirp->chirp.num_samples = num_samples_per_chirp;
+        chirp->chirp.rx_mask = 1;
+        return frame_loop;
+    }
+
+    void set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t*) override {}
+    ifx_Radar_Sensor_t get_sensor_type() const override { return IFX_AVIAN_BGT60TR13C; }
+    float get_temperature() override { return 0; }
+    float get_chirp_duration(const ifx_Fmcw_Sequence_Chirp_t&) const override { return 0; }
+    float get_minimum_chirp_repetition_time(uint32_t, float) const override { return 0; }
+    double get_chirp_sampling_range(const ifx_Fmcw_Sequence_Chirp_t*) const override { return 0; }
+    std::map<uint16_t, uint32_t>& get_register_list() override { return m_registers; }
+    void apply_register_list(const std::map<uint16_t, uint32_t>&) override {}
+    std::map<uint16_t, uint32_t> import_register_list(const char*) override { return {}; }
+    void export_register_list(const char*, const std::map<uint16_t, uint32_t>&) override {}
+    void load_register_file(const char*) override {}
+    void save_register_file(const char*) override {}
+    void initialize_sensor_info() override {}
+
+    std::map<uint16_t, uint32_t> m_registers;
+};
+
+bool frame_starts_with(const ifx_Fmcw_Raw_Frame_t* frame, uint16_t first)
+{
+    for (uint32_t i = 0; i < frame->num_samples; i++)
+    {
+        if (frame->samples[i] != static_cast<uint16_t>(first + i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Exception, typename Function>
+bool throws(Function&& function)
+{
+    try
+    {
+        function();
+    }
+    catch (const Exception&)
+    {
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return false;
+}
+
+}  // namespace
+
+// Without auto reconnect a lost connection is reported
+static void test_disabled()
+{
+    auto bridge = std::make_shared<FakeBridge>("0001");
+    bridge->queueFrame(100);
+    bridge->queueLostConnection();
+
+    FakeDevice device(bridge);
+    device.m_next_bridge = std::make_shared<FakeBridge>("0001");
+    SmartFmcwRawFrame frame(device.allocate_raw_frame());
+    TEST_CHECK(frame->num_samples == frame_size);
+
+    device.get_next_raw_frame(frame.get(), 100);
+    TEST_CHECK(frame_starts_with(frame.get(), 100));
+
+    TEST_CHECK(throws<rdk::exception::communication_error>([&]() { device.get_next_raw_frame(frame.get(), 100); }));
+    TEST_CHECK(device.m_reconnects == 0);
+}
+
+// A lost connection is replaced and the acquisition restarted within the same call
+static void test_reconnect()
+{
+    auto bridge = std::make_shared<FakeBridge>("0002");
+    bridge->queueFrame(100);
+    bridge->queueLostConnection();
+
+    auto next_bridge = std::make_shared<FakeBridge>("0002");
+    next_bridge->queueFrame(200);
+    next_bridge->queueFrame(300);
+
+    FakeDevice device(bridge);
+    device.set_auto_reconnect(1000);
+    device.m_next_bridge = next_bridge;
+    SmartFmcwRawFrame frame(device.allocate_raw_frame());
+
+    device.get_next_raw_frame(frame.get(), 100);
+    TEST_CHECK(frame_starts_with(frame.get(), 100));
+    TEST_CHECK(bridge->m_starts == 1);
+
+    device.get_next_raw_frame(frame.get(), 100);
+    TEST_CHECK(device.m_reconnects == 1);
+    TEST_CHECK(bridge->m_closed);
+    TEST_CHECK(next_bridge->m_starts == 1);
+    TEST_CHECK(frame_starts_with(frame.get(), 200));
+    TEST_CHECK(strcmp(device.get_board_uuid(), "0002") == 0);
+
+    device.get_next_raw_frame(frame.get(), 100);
+    TEST_CHECK(frame_starts_with(frame.get(), 300));
+    TEST_CHECK(device.m_reconnects == 1);
+}
+
+// Only one reconnect per call: a connection that is lost again is reported
+static void test_reconnect_once()
+{
+    auto bridge = std::make_shared<FakeBridge>("0003");
+    bridge->queueLostConnection();
+
+    auto next_bridge = std::make_shared<FakeBridge>("0003");
+    next_bridge->queueLostConnection();
+    next_bridge->queueFrame(400);
+
+    FakeDevice device(bridge);
+    device.set_auto_reconnect(1000);
+    device.m_next_bridge = next_bridge;
+    SmartFmcwRawFrame frame(device.allocate_raw_frame());
+
+    TEST_CHECK(throws<rdk::exception::communication_error>([&]() { device.get_next_raw_frame(frame.get(), 100); }));
+    TEST_CHECK(device.m_reconnects == 1);
+
+    // the next call reads from the new connection again
+    device.get_next_raw_frame(frame.get(), 100);
+    TEST_CHECK(frame_starts_with(frame.get(), 400));
+    TEST_CHECK(device.m_reconnects == 1);
+}
+
+// If the board does not come back, the error of the reconnect is reported
+static void test_reconnect_fails()
+{
+    auto bridge = std::make_shared<FakeBridge>("0004");
+    bridge->queueLostConnection();
+
+    FakeDevice device(bridge);
+    device.set_auto_reconnect(1000);
+    SmartFmcwRawFrame frame(device.allocate_raw_frame());
+
+    TEST_CHECK(throws<rdk::exception::no_device>([&]() { device.get_next_raw_frame(frame.get(), 100); }));
+    TEST_CHECK(device.m_reconnects == 1);
+}
+
+int main()
+{
+    test_disabled();
+    test_reconnect();
+    test_reconnect_once();
+    test_reconnect_fails();
+    return TEST_RESULT();
+}
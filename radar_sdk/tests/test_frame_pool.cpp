@@ -0,0 +1,244 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_frame_pool.cpp
+ *
+ * Tests the strata FramePool: the pool only grows when a maximum frame
+ * count is set, growing is done in the background instead of in
+ * dequeueFrame, and frames are neither lost nor handed out twice while
+ * several threads dequeue and queue them.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <platform/frames/FramePool.hpp>
+
+#include "Test.h"
+
+namespace {
+
+constexpr uint32_t bufferSize = 1000;
+
+// waits until the pool has the given number of frames, at most two seconds
+bool waitForFrameCount(FramePool &pool, uint32_t frameCount)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (pool.getStatistics().frameCount != frameCount)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void test_fixed_size()
+{
+    FramePool pool;
+    pool.setFrameBufferSize(bufferSize);
+    pool.setFrameCount(4);
+    TEST_CHECK(pool.initialized());
+
+    std::set<IFrame *> frames;
+    for (int i = 0; i < 4; i++)
+    {
+        IFrame *frame = pool.dequeueFrame();
+        TEST_CHECK(frame != nullptr);
+        if (frame)
+        {
+            TEST_CHECK(frame->getBufferSize() == bufferSize);
+            TEST_CHECK(reinterpret_cast<uintptr_t>(frame->getBuffer()) % 64 == 0);
+            frames.insert(frame);
+        }
+    }
+    TEST_CHECK(frames.size() == 4);
+
+    // without a maximum frame count the pool must not grow
+    TEST_CHECK(pool.dequeueFrame() == nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    TEST_CHECK(pool.dequeueFrame() == nullptr);
+
+    auto statistics = pool.getStatistics();
+    TEST_CHECK(statistics.frameCount == 4);
+    TEST_CHECK(statistics.available == 0);
+    TEST_CHECK(statistics.highWater == 4);
+    TEST_CHECK(statistics.starvations == 2);
+    TEST_CHECK(statistics.growths == 0);
+
+    for (auto frame : frames)
+        frame->release();
+    TEST_CHECK(pool.getStatistics().available == 4);
+
+    // queueing a frame twice or a foreign frame is refused
+    IFrame *frame = pool.dequeueFrame();
+    pool.queueFrame(frame);
+    bool refused = false;
+    try
+    {
+        pool.queueFrame(frame);
+    }
+    catch (const std::exception &)
+    {
+        refused = true;
+    }
+    TEST_CHECK(refused);
+
+    FramePool other;
+    other.setFrameBufferSize(bufferSize);
+    other.setFrameCount(1);
+    IFrame *foreign = other.dequeueFrame();
+    refused         = false;
+    try
+    {
+        pool.queueFrame(foreign);
+    }
+    catch (const std::exception &)
+    {
+        refused = true;
+    }
+    TEST_CHECK(refused);
+    foreign->release();
+}
+
+void test_growing()
+{
+    FramePool pool;
+    pool.setFrameBufferSize(bufferSize);
+    pool.setFrameCount(4);
+    pool.setMaxFrameCount(8);
+
+    // taking the last frame requests a refill, which doubles the pool
+    std::vector<IFrame *> frames;
+    for (int i = 0; i < 4; i++)
+        frames.push_back(pool.dequeueFrame());
+    TEST_CHECK(waitForFrameCount(pool, 8));
+
+    for (int i = 0; i < 4; i++)
+    {
+        IFrame *frame = pool.dequeueFrame();
+        TEST_CHECK(frame != nullptr);
+        frames.push_back(frame);
+    }
+
+    // the maximum is reached
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    TEST_CHECK(pool.dequeueFrame() == nullptr);
+
+    const auto statistics = pool.getStatistics();
+    TEST_CHECK(statistics.frameCount == 8);
+    TEST_CHECK(statistics.growths == 1);
+    TEST_CHECK(statistics.highWater == 8);
+    TEST_CHECK(std::set<IFrame *>(frames.begin(), frames.end()).size() == 8);
+
+    for (auto frame : frames)
+    {
+        if (frame)
+            frame->release();
+    }
+    TEST_CHECK(pool.getStatistics().available == 8);
+
+    // reconfiguring the frame count keeps the maximum
+    pool.setFrameCount(2);
+    frames.clear();
+    for (int i = 0; i < 2; i++)
+        frames.push_back(pool.dequeueFrame());
+    TEST_CHECK(waitForFrameCount(pool, 4));
+    for (auto frame : frames)
+        frame->release();
+}
+
+// Several threads dequeue and queue frames as fast as possible. Each frame is
+// marked while it is held, so a frame handed out twice is detected.
+void test_concurrent()
+{
+    FramePool pool;
+    pool.setFrameBufferSize(bufferSize);
+    pool.setFrameCount(8);
+
+    std::atomic<bool> stop {false};
+    std::atomic<uint64_t> cycles {0};
+    std::atomic<uint32_t> duplicates {0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&]() {
+            std::vector<IFrame *> held;
+            while (!stop.load())
+            {
+                for (int i = 0; i < 2; i++)
+                {
+                    IFrame *frame = pool.dequeueFrame();
+                    if (!frame)
+                        break;
+                    std::atomic<uint8_t> &mark = *reinterpret_cast<std::atomic<uint8_t> *>(frame->getBuffer());
+                    if (mark.exchange(1) != 0)
+                        duplicates++;
+                    held.push_back(frame);
+                }
+                for (auto frame : held)
+                {
+                    reinterpret_cast<std::atomic<uint8_t> *>(frame->getBuffer())->store(0);
+                    frame->release();
+                }
+                held.clear();
+                cycles++;
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    // with a single core the threads might not run before the loop is done
+    while (cycles.load() < 20000)
+        std::this_thread::yield();
+    stop.store(true);
+    for (auto &thread : threads)
+        thread.join();
+
+    const auto statistics = pool.getStatistics();
+    TEST_CHECK(duplicates.load() == 0);
+    TEST_CHECK(statistics.frameCount == 8);
+    TEST_CHECK(statistics.available == 8);
+}
+
+}  // namespace
+
+int main()
+{
+    test_fixed_size();
+    test_growing();
+    test_concurrent();
+    return TEST_RESULT();
+}
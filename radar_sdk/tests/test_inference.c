@@ -0,0 +1,194 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_inference.c
+ *
+ * Runs the float and int8 versions of a small model converted with
+ * src/export_native_model.py and compares the outputs with the reference
+ * implementation of the converter and with Keras. Also checks that NaN and
+ * infinite inputs are quantized without undefined behavior.
+ *
+ * The models and reference outputs in data/ are created with
+ * data/make_inference_data.py.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ifxAlgo/Inference.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+
+#include "Test.h"
+
+/*
+ * Reference file written by the converter: the check inputs, the outputs
+ * of the converted model (numpy implementation of the engine) and the
+ * Keras outputs, all float32.
+ */
+typedef struct
+{
+    uint32_t count;
+    float* inputs;
+    float* converted;
+    float* keras;
+} Reference_t;
+
+static int load_reference(const char* filename, uint32_t input_size, uint32_t output_size, Reference_t* reference)
+{
+    FILE* file = fopen(filename, "rb");
+    if (!file)
+        return 0;
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    const size_t per_sample = (input_size + 2 * (size_t)output_size) * sizeof(float);
+    float* data = size > 0 ? malloc((size_t)size) : NULL;
+    const int ok = data && (size_t)size % per_sample == 0 && fread(data, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+    if (!ok)
+    {
+        free(data);
+        return 0;
+    }
+
+    reference->count = (uint32_t)((size_t)size / per_sample);
+    reference->inputs = data;
+    reference->converted = data + (size_t)reference->count * input_size;
+    reference->keras = reference->converted + (size_t)reference->count * output_size;
+    return 1;
+}
+
+static uint32_t argmax(const ifx_Float_t* values, uint32_t size)
+{
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < size; i++)
+        if (values[i] > values[best])
+            best = i;
+    return best;
+}
+
+/*
+ * converted_tol: tolerance against the converter's reference implementation
+ * keras_tol:     tolerance against Keras
+ */
+static void check_model(const char* model_file, const char* reference_file, ifx_Inference_Data_Type_t data_type,
+                        float converted_tol, float keras_tol)
+{
+    ifx_Inference_t* model = ifx_inference_create_from_file(model_file);
+    TEST_CHECK(model != NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    if (!model)
+        return;
+    TEST_CHECK(ifx_inference_get_data_type(model) == data_type);
+
+    ifx_Inference_Shape_t shape;
+    ifx_inference_get_input_shape(model, &shape);
+    const uint32_t input_size = shape.height * shape.width * shape.channels;
+    const uint32_t output_size = ifx_inference_get_output_size(model);
+    TEST_CHECK(input_size == 16 * 8);
+    TEST_CHECK(output_size == 3);
+
+    Reference_t reference;
+    const int loaded = load_reference(reference_file, input_size, output_size, &reference);
+    TEST_CHECK(loaded);
+    if (!loaded)
+    {
+        ifx_inference_destroy(model);
+        return;
+    }
+    TEST_CHECK(reference.count > 0);
+
+    ifx_Float_t input[16 * 8];
+    ifx_Float_t output[3];
+    for (uint32_t n = 0; n < reference.count; n++)
+    {
+        for (uint32_t i = 0; i < input_size; i++)
+            input[i] = reference.inputs[n * input_size + i];
+        ifx_inference_run(model, input, output);
+
+        const float* converted = &reference.converted[n * output_size];
+        const float* keras = &reference.keras[n * output_size];
+        float sum = 0;
+        for (uint32_t k = 0; k < output_size; k++)
+        {
+            TEST_CHECK_NEAR(output[k], converted[k], converted_tol);
+            TEST_CHECK_NEAR(output[k], keras[k], keras_tol);
+            sum += output[k];
+        }
+        TEST_CHECK_NEAR(sum, 1, 1e-5);
+        TEST_CHECK(argmax(output, output_size) == argmax(converted, output_size));
+    }
+
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    free(reference.inputs);
+    ifx_inference_destroy(model);
+}
+
+/* NaN inputs are quantized to 0, infinite inputs saturate like huge ones */
+static void check_non_finite_input(void)
+{
+    ifx_Inference_t* model = ifx_inference_create_from_file("data/inference_int8.ifxn");
+    TEST_CHECK(model != NULL);
+    if (!model)
+        return;
+
+    ifx_Float_t input[16 * 8];
+    ifx_Float_t output[3], expected[3];
+
+    for (uint32_t i = 0; i < 16 * 8; i++)
+        input[i] = NAN;
+    ifx_inference_run(model, input, output);
+    for (uint32_t k = 0; k < 3; k++)
+        TEST_CHECK(isfinite(output[k]) && output[k] >= 0 && output[k] <= 1);
+
+    for (uint32_t i = 0; i < 16 * 8; i++)
+        input[i] = (i % 2) ? 1e30f : -1e30f;
+    ifx_inference_run(model, input, expected);
+    for (uint32_t i = 0; i < 16 * 8; i++)
+        input[i] = (i % 2) ? INFINITY : -INFINITY;
+    ifx_inference_run(model, input, output);
+    for (uint32_t k = 0; k < 3; k++)
+        TEST_CHECK(output[k] == expected[k]);
+
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    ifx_inference_destroy(model);
+}
+
+int main(void)
+{
+    check_model("data/inference_float.ifxn", "data/inference_float.ref", IFX_INFERENCE_FLOAT32, 1e-5f, 1e-5f);
+    check_model("data/inference_int8.ifxn", "data/inference_int8.ref", IFX_INFERENCE_INT8, 1e-3f, 2e-2f);
+    check_non_finite_input();
+    return TEST_RESULT();
+}
@@ -0,0 +1,236 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_mem.cpp
+ *
+ * Tests the arena and pool backends of ifx_mem: arenas only serve explicit
+ * requests, the statistics account for arena memory, and pools can be
+ * destroyed while other threads allocate.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+
+#include "Test.h"
+
+// Allocations made while an arena is bound must not come from the arena
+// unless requested explicitly; otherwise a reset would free them.
+static void test_arena_binding()
+{
+    const size_t capacity = 64 * 1024;
+    ifx_Mem_Arena_t* arena = ifx_mem_arena_create(capacity);
+    TEST_CHECK(arena != nullptr);
+
+    ifx_mem_arena_bind(arena);
+    const size_t mark = ifx_mem_arena_mark(arena);
+    void* scratch = ifx_mem_scratch_alloc(100);
+    TEST_CHECK(scratch != nullptr);
+    const size_t scratch_mark = ifx_mem_arena_mark(arena);
+    TEST_CHECK(scratch_mark > mark);
+
+    // the arena is not touched by regular allocations
+    ifx_mem_reset_stats();
+    void* persistent = ifx_mem_alloc(100);
+    void* aligned = ifx_mem_aligned_alloc(256, 64);
+    TEST_CHECK(persistent != nullptr && aligned != nullptr);
+    TEST_CHECK(ifx_mem_arena_mark(arena) == scratch_mark);
+    TEST_CHECK(IFX_IS_ALIGNED(aligned, 64));
+
+    ifx_Mem_Stats_t stats;
+    ifx_mem_get_stats(&stats);
+    TEST_CHECK(stats.arena_allocations == 0);
+    TEST_CHECK(stats.heap_allocations == 2);
+
+    void* explicit_mem = ifx_mem_arena_alloc(arena, 1000, 64);
+    TEST_CHECK(explicit_mem != nullptr && IFX_IS_ALIGNED(explicit_mem, 64));
+    ifx_mem_get_stats(&stats);
+    TEST_CHECK(stats.arena_allocations == 1);
+
+    // reset releases the arena memory only; the heap memory stays valid
+    ifx_mem_arena_reset(arena, mark);
+    TEST_CHECK(ifx_mem_arena_mark(arena) == mark);
+    static_cast<uint8_t*>(persistent)[99] = 1;
+    ifx_mem_free(persistent);
+    ifx_mem_aligned_free(aligned);
+    ifx_mem_free(scratch);  // no effect for arena memory
+
+    // exhausted arena falls back to the heap
+    void* large = ifx_mem_scratch_alloc(2 * capacity);
+    TEST_CHECK(large != nullptr);
+    ifx_mem_get_stats(&stats);
+    TEST_CHECK(stats.arena_overflows == 1);
+    ifx_mem_free(large);
+
+    // without a bound arena scratch memory comes from the heap
+    TEST_CHECK(ifx_mem_arena_bind(nullptr) == arena);
+    void* heap = ifx_mem_scratch_alloc(16);
+    TEST_CHECK(heap != nullptr);
+    ifx_mem_free(heap);
+
+    ifx_mem_arena_destroy(arena);
+}
+
+static void test_arena_stats()
+{
+    ifx_Mem_Arena_t* arena = ifx_mem_arena_create(4096);
+    ifx_mem_reset_stats();
+
+    ifx_Mem_Stats_t before;
+    ifx_mem_get_stats(&before);
+
+    ifx_mem_arena_alloc(arena, 1000, 16);
+    const size_t mark = ifx_mem_arena_mark(arena);
+    ifx_mem_arena_alloc(arena, 500, 16);
+    const size_t used = ifx_mem_arena_mark(arena);
+
+    ifx_Mem_Stats_t stats;
+    ifx_mem_get_stats(&stats);
+    TEST_CHECK(stats.arena_bytes_in_use - before.arena_bytes_in_use == used);
+    TEST_CHECK(stats.arena_bytes_high_water >= stats.arena_bytes_in_use);
+    TEST_CHECK(stats.bytes_in_use == before.bytes_in_use);
+
+    ifx_mem_arena_reset(arena, mark);
+    ifx_mem_get_stats(&stats);
+    TEST_CHECK(stats.arena_bytes_in_use - before.arena_bytes_in_use == mark);
+    TEST_CHECK(stats.arena_bytes_high_water - before.arena_bytes_in_use >= used);
+
+    ifx_mem_arena_destroy(arena);
+    ifx_mem_get_stats(&stats);
+    TEST_CHECK(stats.arena_bytes_in_use == before.arena_bytes_in_use);
+}
+
+static void test_pool()
+{
+    ifx_Mem_Pool_t* pool = ifx_mem_pool_create(4096, 4);
+    TEST_CHECK(pool != nullptr);
+
+    void* block = ifx_mem_alloc(3000);
+    TEST_CHECK(IFX_IS_ALIGNED(block, 64));
+    TEST_CHECK(ifx_mem_pool_blocks_in_use(pool) == 1);
+
+    // too small for the pool
+    void* small = ifx_mem_alloc(1000);
+    TEST_CHECK(ifx_mem_pool_blocks_in_use(pool) == 1);
+    ifx_mem_free(small);
+
+    // destroying a pool with blocks in use is refused
+    ifx_error_get_and_clear();
+    ifx_mem_pool_destroy(pool);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_NOT_POSSIBLE);
+
+    ifx_mem_free(block);
+    TEST_CHECK(ifx_mem_pool_blocks_in_use(pool) == 0);
+    ifx_mem_pool_destroy(pool);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+}
+
+// Pools are created and destroyed while other threads allocate blocks of
+// the pool size. Every destroy must either succeed or be refused; a freed
+// pool must never be used (run with a sanitizer to detect this reliably).
+static void test_pool_destroy_concurrent()
+{
+    std::atomic<bool> stop {false};
+    std::atomic<uint64_t> allocations {0};
+    ifx_mem_reset_stats();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; t++)
+    {
+        threads.emplace_back([&stop, &allocations]() {
+            while (!stop.load())
+            {
+                void* mem = ifx_mem_alloc(2000);
+                if (mem)
+                {
+                    static_cast<uint8_t*>(mem)[1999] = 0x5a;
+                    allocations.fetch_add(1);
+                }
+                ifx_mem_free(mem);
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    // with a single core the threads might not run before the loop is done
+    while (allocations.load() < 100)
+        std::this_thread::yield();
+
+    uint32_t destroyed = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        ifx_Mem_Pool_t* pool = ifx_mem_pool_create(2048, 2);
+        if (!pool)
+        {
+            TEST_FAIL();
+            break;
+        }
+
+        // give the other threads the chance to take blocks from the pool
+        for (int k = 0; k < 100 && ifx_mem_pool_blocks_in_use(pool) == 0; k++)
+            std::this_thread::yield();
+
+        // retry until no block is in use
+        for (;;)
+        {
+            ifx_mem_pool_destroy(pool);
+            const ifx_Error_t error = ifx_error_get_and_clear();
+            if (error == IFX_OK)
+                break;
+            TEST_CHECK(error == IFX_ERROR_NOT_POSSIBLE);
+            if (error != IFX_ERROR_NOT_POSSIBLE)
+                break;
+            std::this_thread::yield();
+        }
+        destroyed++;
+    }
+
+    stop.store(true);
+    for (auto& thread : threads)
+        thread.join();
+
+    ifx_Mem_Stats_t stats;
+    ifx_mem_get_stats(&stats);
+    TEST_CHECK(destroyed == 1000);
+    TEST_CHECK(stats.pool_allocations > 0);
+}
+
+int main()
+{
+    test_arena_binding();
+    test_arena_stats();
+    test_pool();
+    test_pool_destroy_concurrent();
+    return TEST_RESULT();
+}
@@ -0,0 +1,250 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_micro_doppler.c
+ *
+ * Feeds frames with a known Doppler frequency per frame for two radars
+ * into one micro-Doppler handle and checks when segments are emitted,
+ * that each radar has its own history in time order, the clipping
+ * relative to the maximum and the bilinear resize.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxRadar/MicroDoppler.h"
+
+#include "Test.h"
+
+#define ANTENNAS   2
+#define CHIRPS     8
+#define SAMPLES    16
+#define RANGE_FFT  32
+#define RANGE_BIN  4   // the target is in this range bin
+#define BINS       16  // Doppler FFT size
+#define LENGTH     6   // segment length
+#define HOP        3
+#define LOG_SCALE  20
+#define CLIP_MIN   1e-2f
+#define RADARS     2
+
+static ifx_MicroDoppler_Config_t default_config(void)
+{
+    ifx_MicroDoppler_Config_t config;
+    memset(&config, 0, sizeof(config));
+    config.num_radars = RADARS;
+    config.range_fft_config.fft_type = IFX_FFT_TYPE_R2C;
+    config.range_fft_config.fft_size = RANGE_FFT;
+    config.range_fft_config.mean_removal_enabled = true;
+    config.range_fft_config.window_config.type = IFX_WINDOW_HANN;
+    config.range_fft_config.window_config.size = SAMPLES;
+    config.range_fft_config.window_config.scale = 1;
+    config.doppler_fft_config.fft_type = IFX_FFT_TYPE_C2C;
+    config.doppler_fft_config.fft_size = BINS;
+    config.doppler_fft_config.window_config.type = IFX_WINDOW_HANN;
+    config.doppler_fft_config.window_config.size = CHIRPS;
+    config.doppler_fft_config.window_config.scale = 1;
+    config.range_bin_start = RANGE_BIN - 2;
+    config.range_bin_end = RANGE_BIN + 3;
+    config.segment_length = LENGTH;
+    config.hop_size = HOP;
+    config.clip_min_factor = CLIP_MIN;
+    config.clip_max_factor = 1;
+    config.log_scale = LOG_SCALE;
+    config.output_rows = BINS;
+    config.output_columns = LENGTH;
+    return config;
+}
+
+/* Doppler frequency of a frame in cycles per frame (multiples of 1/CHIRPS), differs between the radars */
+static int doppler_cycles(uint32_t radar, uint32_t frame)
+{
+    return (radar == 0) ? (int)(frame % 7) - 3 : 3 - (int)(frame % 5);
+}
+
+/* Row of the output with the peak of a Doppler frequency, the spectrum is FFT shifted */
+static uint32_t doppler_row(int cycles)
+{
+    return (uint32_t)((cycles * BINS / CHIRPS + BINS + BINS / 2) % BINS);
+}
+
+static void fill_frame(ifx_Cube_R_t* frame, uint32_t radar, uint32_t index)
+{
+    const int cycles = doppler_cycles(radar, index);
+    for (uint32_t rx = 0; rx < ANTENNAS; rx++)
+        for (uint32_t c = 0; c < CHIRPS; c++)
+            for (uint32_t s = 0; s < SAMPLES; s++)
+                IFX_CUBE_AT(frame, rx, c, s) = (1.0f + radar) * cosf(2 * IFX_PI * ((ifx_Float_t)RANGE_BIN * s / RANGE_FFT + (ifx_Float_t)cycles * c / CHIRPS));
+}
+
+/* Checks that each column has its peak at the Doppler frequency of the frame, oldest frame first */
+static void check_segment(const ifx_Float_t* image, uint32_t radar, uint32_t frames)
+{
+    ifx_Float_t max_value = image[0], min_value = image[0];
+    for (uint32_t i = 0; i < BINS * LENGTH; i++)
+    {
+        max_value = MAX(max_value, image[i]);
+        min_value = MIN(min_value, image[i]);
+    }
+
+    for (uint32_t c = 0; c < LENGTH; c++)
+    {
+        uint32_t peak = 0;
+        for (uint32_t r = 1; r < BINS; r++)
+        {
+            if (image[r * LENGTH + c] > image[peak * LENGTH + c])
+                peak = r;
+        }
+        TEST_CHECK(peak == doppler_row(doppler_cycles(radar, frames - LENGTH + c)));
+    }
+
+    // the image is clipped to CLIP_MIN relative to its maximum, in dB
+    TEST_CHECK_NEAR(min_value, max_value + LOG_SCALE * log10f(CLIP_MIN), 1e-3f);
+}
+
+static void check_segments(void)
+{
+    const ifx_MicroDoppler_Config_t config = default_config();
+    ifx_MicroDoppler_t* handle = ifx_microdoppler_create(&config);
+    TEST_CHECK(handle != NULL);
+    if (!handle)
+        return;
+    TEST_CHECK(ifx_microdoppler_get_num_doppler_bins(handle) == BINS);
+
+    ifx_Cube_R_t* frame = ifx_cube_create_r(ANTENNAS, CHIRPS, SAMPLES);
+    static ifx_Float_t image[BINS * LENGTH];
+
+    // the radars are interleaved, the second radar starts later
+    uint32_t frames[RADARS] = {0, 0};
+    for (uint32_t step = 0; step < 40; step++)
+    {
+        for (uint32_t radar = 0; radar < RADARS; radar++)
+        {
+            if (radar == 1 && step < 4)
+                continue;
+
+            fill_frame(frame, radar, frames[radar]);
+            const bool emitted = ifx_microdoppler_run_r(handle, radar, frame, image);
+            frames[radar]++;
+            TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+            // the first segment after LENGTH frames, then every HOP frames
+            const bool expected = frames[radar] >= LENGTH && (frames[radar] - LENGTH) % HOP == 0;
+            TEST_CHECK(emitted == expected);
+            if (emitted)
+                check_segment(image, radar, frames[radar]);
+        }
+    }
+
+    // after a reset the history has to be filled again
+    ifx_microdoppler_reset(handle, 0);
+    frames[0] = 0;
+    for (uint32_t i = 0; i < LENGTH; i++)
+    {
+        fill_frame(frame, 0, frames[0]++);
+        TEST_CHECK(ifx_microdoppler_run_r(handle, 0, frame, image) == (i == LENGTH - 1));
+    }
+    check_segment(image, 0, frames[0]);
+
+    ifx_microdoppler_run_r(handle, RADARS, frame, image);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_INDEX_OUT_OF_BOUNDS);
+
+    ifx_cube_destroy_r(frame);
+    ifx_microdoppler_destroy(handle);
+}
+
+static void check_resize(void)
+{
+    // the same segment at the original size and resized to twice the size
+    ifx_MicroDoppler_Config_t config = default_config();
+    config.num_radars = 1;
+    ifx_MicroDoppler_t* handle = ifx_microdoppler_create(&config);
+    config.output_rows = 2 * BINS;
+    config.output_columns = 2 * LENGTH;
+    ifx_MicroDoppler_t* resize_handle = ifx_microdoppler_create(&config);
+    TEST_CHECK(handle != NULL && resize_handle != NULL);
+    if (!handle || !resize_handle)
+        return;
+
+    ifx_Cube_R_t* frame = ifx_cube_create_r(ANTENNAS, CHIRPS, SAMPLES);
+    static ifx_Float_t image[BINS * LENGTH];
+    static ifx_Float_t resized[4 * BINS * LENGTH];
+    for (uint32_t i = 0; i < LENGTH; i++)
+    {
+        fill_frame(frame, 0, i);
+        ifx_microdoppler_run_r(handle, 0, frame, image);
+        ifx_microdoppler_run_r(resize_handle, 0, frame, resized);
+    }
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    // with aligned pixel centers output pixel 2i+1 is at input position i+0.25
+    for (uint32_t r = 0; r + 1 < BINS; r++)
+    {
+        for (uint32_t c = 0; c + 1 < LENGTH; c++)
+        {
+            const ifx_Float_t* a = &image[r * LENGTH + c];
+            const ifx_Float_t expected = 0.75f * (0.75f * a[0] + 0.25f * a[1]) + 0.25f * (0.75f * a[LENGTH] + 0.25f * a[LENGTH + 1]);
+            TEST_CHECK_NEAR(resized[(2 * r + 1) * 2 * LENGTH + 2 * c + 1], expected, 1e-3f);
+        }
+    }
+
+    // the edges are clamped
+    TEST_CHECK_NEAR(resized[0], image[0], 1e-3f);
+    TEST_CHECK_NEAR(resized[4 * BINS * LENGTH - 1], image[BINS * LENGTH - 1], 1e-3f);
+
+    ifx_cube_destroy_r(frame);
+    ifx_microdoppler_destroy(resize_handle);
+    ifx_microdoppler_destroy(handle);
+}
+
+static void check_invalid_config(void)
+{
+    ifx_MicroDoppler_Config_t config = default_config();
+    config.hop_size = LENGTH + 1;
+    TEST_CHECK(ifx_microdoppler_create(&config) == NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    config = default_config();
+    config.range_bin_end = RANGE_FFT / 2 + 1;
+    TEST_CHECK(ifx_microdoppler_create(&config) == NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+}
+
+int main(void)
+{
+    check_segments();
+    check_resize();
+    check_invalid_config();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,93 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_mimose_conversion.cpp
+ *
+ * Tests the conversion of Mimose pulse readouts into complex samples: the
+ * SIMD path taken for contiguous output and the scalar path taken for
+ * strided output both keep the low 12 bits of each I/Q word, scale them to
+ * [0, 1] and leave the samples between the strided outputs untouched.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "ifxBase/Complex.h"
+#include "ifxMimose/DeviceMimoseImpl.hpp"
+
+#include "Test.h"
+
+namespace {
+
+float expected(uint16_t word)
+{
+    return static_cast<float>(word & 0x0FFF) / 4095.0f;
+}
+
+void check_conversion(uint16_t num_samples, size_t stride)
+{
+    std::vector<uint16_t> data(num_samples * 2);
+    for (auto& word : data)
+        word = static_cast<uint16_t>(test_random());
+
+    const ifx_Complex_t marker = IFX_COMPLEX_DEF(-1, -1);
+    std::vector<ifx_Complex_t> samples(num_samples * stride, marker);
+
+    DeviceMimose::convertPulse(data.data(), samples.data(), stride, num_samples);
+
+    for (uint16_t i = 0; i < num_samples; ++i)
+    {
+        const auto& sample = samples[i * stride];
+        TEST_CHECK_NEAR(IFX_COMPLEX_REAL(sample), expected(data[2 * i]), 1e-6);
+        TEST_CHECK_NEAR(IFX_COMPLEX_IMAG(sample), expected(data[2 * i + 1]), 1e-6);
+
+        for (size_t k = 1; k < stride; ++k)
+        {
+            TEST_CHECK(IFX_COMPLEX_REAL(samples[i * stride + k]) == -1);
+            TEST_CHECK(IFX_COMPLEX_IMAG(samples[i * stride + k]) == -1);
+        }
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    test_seed(42);
+
+    // lengths around the SIMD vector widths, including the scalar tails
+    for (uint16_t num_samples : {1, 7, 8, 16, 37, 256})
+    {
+        check_conversion(num_samples, 1);
+        check_conversion(num_samples, 3);
+    }
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,276 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_mti.c
+ *
+ * Checks MTI and 2D MTI with all filter types, per bin (per row)
+ * coefficients and decimation against the filter equations, for
+ * contiguous and strided vectors, matrices and cubes.
+ */
+
+#include <string.h>
+
+#include "ifxAlgo/2DMTI.h"
+#include "ifxAlgo/MTI.h"
+#include "ifxBase/Complex.h"
+#include "ifxBase/Cube.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Vector.h"
+
+#include "Test.h"
+
+#define LEN        37  // not a multiple of any SIMD width
+#define RUNS       10
+#define DECIMATION 3
+#define STRIDE     2
+#define ROWS       5
+#define COLS       11
+#define SLICES     3
+#define ALPHA      0.25f
+
+/* Reference filter for a single value, see ifx_MTI_Type_t */
+typedef struct
+{
+    ifx_Float_t history;
+    ifx_Float_t history2;
+} Reference_t;
+
+static ifx_Float_t reference_run(Reference_t* ref, ifx_MTI_Type_t type, ifx_Float_t alpha, bool update, ifx_Float_t x)
+{
+    if (type == IFX_MTI_TYPE_THREE_PULSE)
+    {
+        const ifx_Float_t y = x - 2 * ref->history + ref->history2;
+        if (update)
+        {
+            ref->history2 = ref->history;
+            ref->history = x;
+        }
+        return y;
+    }
+
+    const ifx_Float_t y = x - ref->history;
+    if (update)
+        ref->history = (type == IFX_MTI_TYPE_TWO_PULSE) ? x : ref->history + alpha * y;
+    return y;
+}
+
+static ifx_Float_t alpha_of_bin(uint32_t j)
+{
+    return 0.1f + 0.8f * (ifx_Float_t)j / LEN;
+}
+
+static void check_mti(ifx_MTI_Type_t type, bool per_bin, uint32_t decimation, uint32_t stride)
+{
+    static ifx_Float_t input_data[LEN * STRIDE];
+    static ifx_Float_t output_data[LEN * STRIDE];
+    Reference_t ref[LEN];
+    memset(ref, 0, sizeof(ref));
+
+    ifx_MTI_t* mti = ifx_mti_create(ALPHA, LEN);
+    TEST_CHECK(mti != NULL);
+    if (!mti)
+        return;
+
+    ifx_mti_set_type(mti, type);
+    ifx_mti_set_decimation(mti, decimation);
+    TEST_CHECK(ifx_mti_get_type(mti) == type);
+
+    ifx_Vector_R_t* alpha = ifx_vec_create_r(LEN);
+    for (uint32_t j = 0; j < LEN; j++)
+        IFX_VEC_AT(alpha, j) = alpha_of_bin(j);
+    if (per_bin)
+        ifx_mti_set_alpha_per_bin(mti, alpha);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    ifx_Vector_R_t input, output;
+    ifx_vec_rawview_r(&input, input_data, LEN, stride);
+    ifx_vec_rawview_r(&output, output_data, LEN, stride);
+
+    test_seed(type * 100 + decimation * 10 + stride + per_bin);
+    for (uint32_t n = 0; n < RUNS; n++)
+    {
+        // a static part plus noise
+        for (uint32_t j = 0; j < LEN; j++)
+            IFX_VEC_AT(&input, j) = (ifx_Float_t)j + test_uniform(-1, 1);
+
+        ifx_mti_run(mti, &input, &output);
+        TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+        const bool update = (n % decimation) == 0;
+        for (uint32_t j = 0; j < LEN; j++)
+        {
+            const ifx_Float_t a = per_bin ? alpha_of_bin(j) : ALPHA;
+            const ifx_Float_t expected = reference_run(&ref[j], type, a, update, IFX_VEC_AT(&input, j));
+            TEST_CHECK_NEAR(IFX_VEC_AT(&output, j), expected, 1e-4f);
+        }
+    }
+
+    ifx_vec_destroy_r(alpha);
+    ifx_mti_destroy(mti);
+}
+
+static void check_2dmti(ifx_MTI_Type_t type, bool per_row, uint32_t decimation)
+{
+    // the cube handle filters all slices, the matrix handle one strided slice of the same data
+    Reference_t ref[ROWS][COLS][SLICES][2];
+    memset(ref, 0, sizeof(ref));
+
+    ifx_2DMTI_C_t* cube_mti = ifx_2dmti_create_cube_c(ALPHA, ROWS, COLS, SLICES);
+    ifx_2DMTI_C_t* slice_mti = ifx_2dmti_create_c(ALPHA, ROWS, COLS);
+    TEST_CHECK(cube_mti != NULL && slice_mti != NULL);
+    if (!cube_mti || !slice_mti)
+        return;
+
+    ifx_Vector_R_t* alpha = ifx_vec_create_r(ROWS);
+    for (uint32_t r = 0; r < ROWS; r++)
+        IFX_VEC_AT(alpha, r) = 0.1f + 0.2f * r;
+
+    ifx_2dmti_set_type_c(cube_mti, type);
+    ifx_2dmti_set_type_c(slice_mti, type);
+    ifx_2dmti_set_decimation_c(cube_mti, decimation);
+    ifx_2dmti_set_decimation_c(slice_mti, decimation);
+    if (per_row)
+    {
+        ifx_2dmti_set_alpha_per_row_c(cube_mti, alpha);
+        ifx_2dmti_set_alpha_per_row_c(slice_mti, alpha);
+    }
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    ifx_Cube_C_t* input = ifx_cube_create_c(ROWS, COLS, SLICES);
+    ifx_Cube_C_t* cube_output = ifx_cube_create_c(ROWS, COLS, SLICES);
+    ifx_Matrix_C_t* slice_output = ifx_mat_create_c(ROWS, COLS);
+    ifx_Matrix_C_t slice;
+
+    test_seed(type * 100 + decimation * 10 + per_row);
+    for (uint32_t n = 0; n < RUNS; n++)
+    {
+        for (uint32_t r = 0; r < ROWS; r++)
+            for (uint32_t c = 0; c < COLS; c++)
+                for (uint32_t s = 0; s < SLICES; s++)
+                    IFX_COMPLEX_SET(IFX_CUBE_AT(input, r, c, s), (ifx_Float_t)(r + s) + test_uniform(-1, 1), (ifx_Float_t)c + test_uniform(-1, 1));
+
+        // the slice is not contiguous in memory
+        ifx_cube_get_slice_c(input, 1, &slice);
+        ifx_2dmti_run_c(slice_mti, &slice, slice_output);
+
+        // even numbered runs are in place
+        if (n % 2 == 0)
+        {
+            ifx_cube_copy_c(input, cube_output);
+            ifx_2dmti_run_cube_c(cube_mti, cube_output, cube_output);
+        }
+        else
+        {
+            ifx_2dmti_run_cube_c(cube_mti, input, cube_output);
+        }
+        TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+        const bool update = (n % decimation) == 0;
+        for (uint32_t r = 0; r < ROWS; r++)
+        {
+            const ifx_Float_t a = per_row ? IFX_VEC_AT(alpha, r) : ALPHA;
+            for (uint32_t c = 0; c < COLS; c++)
+            {
+                for (uint32_t s = 0; s < SLICES; s++)
+                {
+                    const ifx_Complex_t x = IFX_CUBE_AT(input, r, c, s);
+                    const ifx_Complex_t y = IFX_CUBE_AT(cube_output, r, c, s);
+                    TEST_CHECK_NEAR(IFX_COMPLEX_REAL(y), reference_run(&ref[r][c][s][0], type, a, update, IFX_COMPLEX_REAL(x)), 1e-4f);
+                    TEST_CHECK_NEAR(IFX_COMPLEX_IMAG(y), reference_run(&ref[r][c][s][1], type, a, update, IFX_COMPLEX_IMAG(x)), 1e-4f);
+                }
+
+                // both handles start from zero history with the same settings
+                TEST_CHECK_NEAR(IFX_COMPLEX_REAL(IFX_MAT_AT(slice_output, r, c)), IFX_COMPLEX_REAL(IFX_CUBE_AT(cube_output, r, c, 1)), 1e-4f);
+                TEST_CHECK_NEAR(IFX_COMPLEX_IMAG(IFX_MAT_AT(slice_output, r, c)), IFX_COMPLEX_IMAG(IFX_CUBE_AT(cube_output, r, c, 1)), 1e-4f);
+            }
+        }
+    }
+
+    // the matrix handle has a single slice only, and the dimensions must match
+    ifx_2dmti_run_c(cube_mti, slice_output, slice_output);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_DIMENSION_MISMATCH);
+
+    ifx_mat_destroy_c(slice_output);
+    ifx_cube_destroy_c(cube_output);
+    ifx_cube_destroy_c(input);
+    ifx_vec_destroy_r(alpha);
+    ifx_2dmti_destroy_c(slice_mti);
+    ifx_2dmti_destroy_c(cube_mti);
+}
+
+static void check_invalid_arguments(void)
+{
+    TEST_CHECK(ifx_mti_create(1.5f, LEN) == NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    ifx_MTI_t* mti = ifx_mti_create(ALPHA, LEN);
+    ifx_mti_set_type(mti, (ifx_MTI_Type_t)3);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    ifx_Vector_R_t* alpha = ifx_vec_create_r(LEN);
+    ifx_vec_setall_r(alpha, 2);
+    ifx_mti_set_alpha_per_bin(mti, alpha);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+    ifx_vec_destroy_r(alpha);
+    ifx_mti_destroy(mti);
+
+    ifx_2DMTI_R_t* mti2d = ifx_2dmti_create_r(ALPHA, ROWS, COLS);
+    alpha = ifx_vec_create_r(ROWS + 1);
+    ifx_2dmti_set_alpha_per_row_r(mti2d, alpha);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_DIMENSION_MISMATCH);
+    ifx_vec_destroy_r(alpha);
+    ifx_2dmti_destroy_r(mti2d);
+}
+
+int main(void)
+{
+    const ifx_MTI_Type_t types[] = {IFX_MTI_TYPE_EXPONENTIAL, IFX_MTI_TYPE_TWO_PULSE, IFX_MTI_TYPE_THREE_PULSE};
+
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++)
+    {
+        for (uint32_t decimation = 1; decimation <= DECIMATION; decimation += DECIMATION - 1)
+        {
+            check_mti(types[t], false, decimation, 1);
+            check_mti(types[t], false, decimation, STRIDE);
+            check_2dmti(types[t], false, decimation);
+        }
+    }
+
+    // the coefficient per bin (per row) is only used by the exponential average
+    check_mti(IFX_MTI_TYPE_EXPONENTIAL, true, 1, 1);
+    check_mti(IFX_MTI_TYPE_EXPONENTIAL, true, DECIMATION, STRIDE);
+    check_2dmti(IFX_MTI_TYPE_EXPONENTIAL, true, 1);
+    check_2dmti(IFX_MTI_TYPE_EXPONENTIAL, true, DECIMATION);
+
+    check_invalid_arguments();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,261 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_peak_search.c
+ *
+ * Checks that the peak search finds the same peaks in contiguous and
+ * strided data sets with both threshold modes, that the run functions do
+ * not allocate and reject data larger than configured, and that invalid
+ * configurations are rejected.
+ */
+
+#include <string.h>
+
+#include "ifxBase/Error.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/Vector.h"
+#include "ifxRadar/PeakSearch.h"
+
+#include "Test.h"
+
+#define LEN    256
+#define STRIDE 3
+
+/* isolated peaks well above the noise floor, in scan order */
+static const uint32_t peak_bins[] = {20, 61, 130, 200};
+static const ifx_Float_t peak_values[] = {12, 9, 15, 7};
+#define NUM_PEAKS (sizeof(peak_bins) / sizeof(peak_bins[0]))
+
+static ifx_Peak_Search_Config_t default_config(ifx_Peak_Threshold_Mode_t mode)
+{
+    ifx_Peak_Search_Config_t config;
+    memset(&config, 0, sizeof(config));
+    config.value_per_bin = 1;
+    config.search_zone_start = 1;
+    config.search_zone_end = LEN;
+    config.threshold_factor = 3;
+    config.threshold_offset = 0;
+    config.max_num_peaks = 10;
+    config.interpolation = IFX_PEAK_INTERPOLATION_NONE;
+    config.threshold_mode = mode;
+    config.max_data_len = LEN;
+    config.max_num_rows = 2;
+    return config;
+}
+
+static void fill_spectrum(ifx_Float_t* data, uint32_t stride)
+{
+    for (uint32_t i = 0; i < LEN; i++)
+        data[i * stride] = test_uniform(0.5f, 1.5f);
+    for (uint32_t p = 0; p < NUM_PEAKS; p++)
+        data[peak_bins[p] * stride] = peak_values[p];
+}
+
+static void check_strided(ifx_Peak_Threshold_Mode_t mode)
+{
+    static ifx_Float_t contiguous_data[LEN];
+    static ifx_Float_t strided_data[LEN * STRIDE];
+
+    test_seed(1234);
+    fill_spectrum(contiguous_data, 1);
+    for (uint32_t i = 0; i < LEN * STRIDE; i++)
+        strided_data[i] = -100;  // values between the elements must not be seen
+    for (uint32_t i = 0; i < LEN; i++)
+        strided_data[i * STRIDE] = contiguous_data[i];
+
+    ifx_Vector_R_t contiguous, strided;
+    ifx_vec_rawview_r(&contiguous, contiguous_data, LEN, 1);
+    ifx_vec_rawview_r(&strided, strided_data, LEN, STRIDE);
+
+    const ifx_Peak_Search_Config_t config = default_config(mode);
+    ifx_Peak_Search_t* handle = ifx_peak_search_create(&config);
+    TEST_CHECK(handle != NULL);
+    if (!handle)
+        return;
+
+    // the strided data set is searched twice to catch scratch data left from a previous run
+    for (int run = 0; run < 3; run++)
+    {
+        ifx_Peak_Search_Result_t result;
+        ifx_peak_search_run(handle, (run == 0) ? &contiguous : &strided, &result);
+        TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+        TEST_CHECK(result.peak_count == NUM_PEAKS);
+        for (uint32_t p = 0; p < NUM_PEAKS && p < result.peak_count; p++)
+            TEST_CHECK(result.index[p] == peak_bins[p]);
+    }
+
+    // the data set must not be modified
+    for (uint32_t i = 0; i < LEN; i++)
+        TEST_CHECK(strided_data[i * STRIDE] == contiguous_data[i]);
+
+    ifx_peak_search_destroy(handle);
+}
+
+static void check_rows(ifx_Peak_Threshold_Mode_t mode)
+{
+    // rows of a matrix view with a larger leading dimension, searched after a strided vector
+    static ifx_Float_t matrix_data[2 * (LEN + 8)];
+    static ifx_Float_t strided_data[LEN * STRIDE];
+
+    test_seed(99);
+    fill_spectrum(matrix_data, 1);
+    fill_spectrum(matrix_data + LEN + 8, 1);
+    fill_spectrum(strided_data, STRIDE);
+
+    ifx_Matrix_R_t spectra;
+    ifx_mat_rawview_r(&spectra, matrix_data, 2, LEN, LEN + 8);
+    ifx_Vector_R_t strided;
+    ifx_vec_rawview_r(&strided, strided_data, LEN, STRIDE);
+
+    ifx_Peak_Search_Config_t config = default_config(mode);
+    config.max_num_peaks = 3;
+    ifx_Peak_Search_t* handle = ifx_peak_search_create(&config);
+    TEST_CHECK(handle != NULL);
+    if (!handle)
+        return;
+
+    ifx_Peak_Search_Result_t vector_result;
+    ifx_peak_search_run(handle, &strided, &vector_result);
+    TEST_CHECK(vector_result.peak_count == 3);
+
+    ifx_Peak_Search_Rows_Result_t result;
+    ifx_peak_search_run_rows(handle, &spectra, &result);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    TEST_CHECK(result.num_rows == 2);
+
+    // the strongest peaks by decreasing value
+    const uint32_t expected[] = {130, 20, 61};
+    for (uint32_t r = 0; r < result.num_rows; r++)
+    {
+        TEST_CHECK(result.peak_count[r] == 3);
+        for (uint32_t p = 0; p < 3 && p < result.peak_count[r]; p++)
+            TEST_CHECK(result.peaks[r * result.max_num_peaks + p].index == expected[p]);
+        TEST_CHECK(result.threshold[r] > 1.5f && result.threshold[r] < 4.5f);
+    }
+
+    ifx_peak_search_destroy(handle);
+}
+
+static uint64_t num_allocations(void)
+{
+    ifx_Mem_Stats_t stats;
+    ifx_mem_get_stats(&stats);
+    return stats.num_allocations;
+}
+
+static void check_limits(void)
+{
+    static ifx_Float_t data[(LEN + 1) * STRIDE];
+    test_seed(7);
+    fill_spectrum(data, STRIDE);
+
+    ifx_Peak_Search_Config_t config = default_config(IFX_PEAK_THRESHOLD_NOISE_FLOOR);
+    config.interpolation = IFX_PEAK_INTERPOLATION_PARABOLIC;
+    ifx_Peak_Search_t* handle = ifx_peak_search_create(&config);
+    TEST_CHECK(handle != NULL);
+    if (!handle)
+        return;
+
+    // all buffers are allocated by create, for both run functions
+    ifx_Vector_R_t strided;
+    ifx_vec_rawview_r(&strided, data, LEN, STRIDE);
+    ifx_Matrix_R_t spectra;
+    ifx_mat_rawview_r(&spectra, data, 2, LEN, LEN);
+
+    const uint64_t allocations = num_allocations();
+    ifx_Peak_Search_Result_t result;
+    ifx_peak_search_run(handle, &strided, &result);
+    ifx_Peak_Search_Rows_Result_t rows_result;
+    ifx_peak_search_run_rows(handle, &spectra, &rows_result);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    TEST_CHECK(num_allocations() == allocations);
+    TEST_CHECK(result.peak_count == NUM_PEAKS);
+
+    // larger inputs are rejected
+    ifx_Vector_R_t too_long;
+    ifx_vec_rawview_r(&too_long, data, LEN + 1, STRIDE);
+    ifx_peak_search_run(handle, &too_long, &result);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ifx_Matrix_R_t too_many_rows;
+    ifx_mat_rawview_r(&too_many_rows, data, 3, LEN, LEN);
+    ifx_peak_search_run_rows(handle, &too_many_rows, &rows_result);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ifx_Matrix_R_t too_many_cols;
+    ifx_mat_rawview_r(&too_many_cols, data, 1, LEN + 1, LEN + 1);
+    ifx_peak_search_run_rows(handle, &too_many_cols, &rows_result);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    TEST_CHECK(num_allocations() == allocations);
+
+    ifx_peak_search_destroy(handle);
+
+    // without max_num_rows only the vector search is available
+    config.max_num_rows = 0;
+    handle = ifx_peak_search_create(&config);
+    TEST_CHECK(handle != NULL);
+    if (!handle)
+        return;
+    ifx_peak_search_run_rows(handle, &spectra, &rows_result);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    ifx_peak_search_destroy(handle);
+}
+
+static void check_invalid_config(void)
+{
+    ifx_Peak_Search_Config_t config = default_config(IFX_PEAK_THRESHOLD_MEAN);
+    config.interpolation = (ifx_Peak_Interpolation_t)3;
+    TEST_CHECK(ifx_peak_search_create(&config) == NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    config = default_config(IFX_PEAK_THRESHOLD_MEAN);
+    config.threshold_mode = (ifx_Peak_Threshold_Mode_t)2;
+    TEST_CHECK(ifx_peak_search_create(&config) == NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    config = default_config(IFX_PEAK_THRESHOLD_MEAN);
+    config.max_data_len = 0;
+    TEST_CHECK(ifx_peak_search_create(&config) == NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+}
+
+int main(void)
+{
+    check_strided(IFX_PEAK_THRESHOLD_MEAN);
+    check_strided(IFX_PEAK_THRESHOLD_NOISE_FLOOR);
+    check_rows(IFX_PEAK_THRESHOLD_MEAN);
+    check_rows(IFX_PEAK_THRESHOLD_NOISE_FLOOR);
+    check_limits();
+    check_invalid_config();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,140 @@
+# ===========================================================================
+# Copyright (C) 2022 Infineon Technologies AG
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from
+#    this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+# ===========================================================================
+
+"""Tests the overflow policies of FramePrefetcher
+
+A fake fetch function delivers numbered frames. With DROP_OLDEST a full
+queue keeps the newest frames and counts the dropped ones, with BLOCK the
+worker waits for the consumer and no frame is lost, and with RAISE the
+queued frames are returned before get raises ErrorFifoOverflow.
+"""
+
+import pathlib
+import sys
+import threading
+import types
+import unittest
+
+# load ifxradarsdk.common without ifxradarsdk/__init__.py, which loads the
+# SDK library and numpy
+_PACKAGE_DIR = pathlib.Path(__file__).resolve().parent.parent / "sdk" / "py" / "wrapper_radarsdk" / "src" / "ifxradarsdk"
+_package = types.ModuleType("ifxradarsdk")
+_package.__path__ = [str(_PACKAGE_DIR)]
+sys.modules.setdefault("ifxradarsdk", _package)
+
+from ifxradarsdk.common.exceptions import ErrorFifoOverflow  # noqa: E402
+from ifxradarsdk.common.prefetch import FramePrefetcher, OverflowPolicy  # noqa: E402
+
+
+TIMEOUT_S = 5
+
+
+class FakeDevice():
+    """Delivers frames 0, 1, 2, ... and counts the calls to fetch"""
+
+    def __init__(self):
+        self.fetched = 0
+        self.condition = threading.Condition()
+
+    def fetch(self):
+        with self.condition:
+            frame = self.fetched
+            self.fetched += 1
+            self.condition.notify_all()
+            return frame
+
+    def wait_fetched(self, count, timeout=TIMEOUT_S):
+        with self.condition:
+            return self.condition.wait_for(lambda: self.fetched >= count, timeout)
+
+
+class TestPrefetchOverflow(unittest.TestCase):
+    def wait_until(self, predicate):
+        with self.prefetcher._condition:
+            return self.prefetcher._condition.wait_for(predicate, TIMEOUT_S)
+
+    def test_drop_oldest(self):
+        device = FakeDevice()
+        self.prefetcher = FramePrefetcher(device.fetch, queue_depth=4)
+        self.assertIs(self.prefetcher.overflow, OverflowPolicy.DROP_OLDEST)
+
+        self.assertTrue(device.wait_fetched(20))
+        self.prefetcher.stop()
+
+        received = self.prefetcher.frames_received
+        self.assertEqual(self.prefetcher.queued_frames, 4)
+        self.assertEqual(self.prefetcher.dropped_frames, received - 4)
+        self.assertEqual(list(self.prefetcher), list(range(received - 4, received)))
+
+    def test_block(self):
+        device = FakeDevice()
+        self.prefetcher = FramePrefetcher(device.fetch, queue_depth=4, overflow=OverflowPolicy.BLOCK)
+
+        # the worker holds one frame while it waits for room in the full queue
+        self.assertTrue(self.wait_until(lambda: len(self.prefetcher._queue) == 4))
+        self.assertTrue(device.wait_fetched(5))
+        self.assertFalse(device.wait_fetched(6, timeout=0.2))
+        self.assertTrue(self.prefetcher.running)
+
+        frames = [self.prefetcher.get(timeout_ms=TIMEOUT_S * 1000) for _ in range(50)]
+        self.prefetcher.stop()
+
+        self.assertEqual(frames, list(range(50)))
+        self.assertEqual(self.prefetcher.dropped_frames, 0)
+
+    def test_block_stop(self):
+        device = FakeDevice()
+        self.prefetcher = FramePrefetcher(device.fetch, queue_depth=2, overflow=OverflowPolicy.BLOCK)
+
+        self.assertTrue(device.wait_fetched(3))
+        # stop must wake the worker waiting for room in the queue
+        self.prefetcher.stop()
+        self.assertEqual(list(self.prefetcher), [0, 1])
+
+    def test_raise(self):
+        device = FakeDevice()
+        self.prefetcher = FramePrefetcher(device.fetch, queue_depth=3, overflow=OverflowPolicy.RAISE)
+
+        self.assertTrue(self.wait_until(lambda: not self.prefetcher._running))
+        self.assertEqual(device.fetched, 4)
+        self.assertEqual(self.prefetcher.frames_received, 4)
+        self.assertEqual(self.prefetcher.dropped_frames, 1)
+
+        self.assertEqual([self.prefetcher.get() for _ in range(3)], [0, 1, 2])
+        with self.assertRaises(ErrorFifoOverflow):
+            self.prefetcher.get()
+        with self.assertRaises(StopIteration):
+            self.prefetcher.get()
+
+    def test_invalid_policy(self):
+        with self.assertRaises(ValueError):
+            FramePrefetcher(lambda: 0, overflow="block")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,248 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_range_spectrum.c
+ *
+ * Checks that the integrating range spectrum modes, which reduce every
+ * chirp right after its FFT, give the mean, the root mean power and the
+ * strongest bin of the single chirp spectra, with and without storing the
+ * FFT matrix and for a chirp subset.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Vector.h"
+#include "ifxRadar/RangeSpectrum.h"
+
+#include "Test.h"
+
+#define CHIRPS   16
+#define SAMPLES  64
+#define FFT_SIZE 128
+
+static ifx_RS_t* create(ifx_FFT_Type_t fft_type)
+{
+    ifx_RS_Config_t config;
+    memset(&config, 0, sizeof(config));
+    config.spect_threshold = 1e-6f;
+    config.output_scale_type = IFX_SCALE_TYPE_LINEAR;
+    config.fft_config.fft_type = fft_type;
+    config.fft_config.fft_size = FFT_SIZE;
+    config.fft_config.mean_removal_enabled = true;
+    config.fft_config.window_config.type = IFX_WINDOW_HANN;
+    config.fft_config.window_config.size = SAMPLES;
+    config.fft_config.window_config.scale = 1;
+    config.fft_config.is_normalized_window = true;
+    config.num_of_chirps_per_frame = CHIRPS;
+    return ifx_rs_create(&config);
+}
+
+static void run(ifx_RS_t* handle, const ifx_Matrix_R_t* real, const ifx_Matrix_C_t* complex, ifx_Vector_C_t* output)
+{
+    if (real)
+        ifx_rs_run_rc(handle, real, output);
+    else
+        ifx_rs_run_c(handle, complex, output);
+}
+
+static ifx_Float_t power(ifx_Complex_t x)
+{
+    return IFX_COMPLEX_REAL(x) * IFX_COMPLEX_REAL(x) + IFX_COMPLEX_IMAG(x) * IFX_COMPLEX_IMAG(x);
+}
+
+static void check_mode(ifx_RS_t* handle, ifx_RS_Mode_t mode, const ifx_Matrix_C_t* reference,
+                       const ifx_Matrix_R_t* real, const ifx_Matrix_C_t* complex,
+                       uint32_t first, uint32_t count, uint32_t step)
+{
+    const uint32_t bins = IFX_MAT_COLS(reference);
+    ifx_Vector_C_t* output = ifx_vec_create_c(bins);
+    ifx_Matrix_C_t* fft_matrix = ifx_mat_create_c(CHIRPS, bins);
+
+    // the number of chirps used, as documented for ifx_rs_set_chirp_subset
+    uint32_t used = (CHIRPS - first + step - 1) / step;
+    if (count && count < used)
+        used = count;
+
+    ifx_rs_set_mode(handle, mode);
+    ifx_rs_set_chirp_subset(handle, first, count, step);
+
+    for (int matrix_enabled = 0; matrix_enabled < 2; matrix_enabled++)
+    {
+        ifx_rs_set_fft_matrix_enabled(handle, matrix_enabled != 0);
+        ifx_mat_clear_c(fft_matrix);
+        run(handle, real, complex, output);
+        TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+        for (uint32_t k = 0; k < bins; k++)
+        {
+            ifx_Float_t sum_re = 0, sum_im = 0, sum_power = 0, max_power = -1;
+            ifx_Complex_t strongest;
+            IFX_COMPLEX_SET(strongest, 0, 0);
+            for (uint32_t n = 0; n < used; n++)
+            {
+                const ifx_Complex_t x = IFX_MAT_AT(reference, first + n * step, k);
+                sum_re += IFX_COMPLEX_REAL(x);
+                sum_im += IFX_COMPLEX_IMAG(x);
+                sum_power += power(x);
+                if (power(x) > max_power)
+                {
+                    max_power = power(x);
+                    strongest = x;
+                }
+            }
+
+            ifx_Float_t expected_re, expected_im;
+            if (mode == IFX_RS_MODE_COHERENT_INTEGRATION)
+            {
+                expected_re = sum_re / used;
+                expected_im = sum_im / used;
+            }
+            else if (mode == IFX_RS_MODE_NONCOHERENT_INTEGRATION)
+            {
+                expected_re = sqrtf(sum_power / used);
+                expected_im = 0;
+            }
+            else  // IFX_RS_MODE_MAX_BIN
+            {
+                expected_re = IFX_COMPLEX_REAL(strongest);
+                expected_im = IFX_COMPLEX_IMAG(strongest);
+            }
+
+            const ifx_Complex_t y = IFX_VEC_AT(output, k);
+            TEST_CHECK_NEAR(IFX_COMPLEX_REAL(y), expected_re, 1e-4f);
+            TEST_CHECK_NEAR(IFX_COMPLEX_IMAG(y), expected_im, 1e-4f);
+        }
+
+        // the FFT matrix holds the used chirps only if it is enabled
+        TEST_CHECK(ifx_rs_get_fft_matrix_enabled(handle) == (matrix_enabled != 0));
+        if (matrix_enabled)
+        {
+            ifx_rs_copy_fft_matrix(handle, fft_matrix);
+            for (uint32_t n = 0; n < used; n++)
+            {
+                const uint32_t i = first + n * step;
+                for (uint32_t k = 0; k < bins; k++)
+                {
+                    TEST_CHECK_NEAR(IFX_COMPLEX_REAL(IFX_MAT_AT(fft_matrix, i, k)), IFX_COMPLEX_REAL(IFX_MAT_AT(reference, i, k)), 1e-4f);
+                    TEST_CHECK_NEAR(IFX_COMPLEX_IMAG(IFX_MAT_AT(fft_matrix, i, k)), IFX_COMPLEX_IMAG(IFX_MAT_AT(reference, i, k)), 1e-4f);
+                }
+            }
+        }
+    }
+
+    ifx_mat_destroy_c(fft_matrix);
+    ifx_vec_destroy_c(output);
+}
+
+static void check_integration(ifx_FFT_Type_t fft_type)
+{
+    const uint32_t bins = (fft_type == IFX_FFT_TYPE_R2C) ? FFT_SIZE / 2 : FFT_SIZE;
+
+    ifx_Matrix_R_t* real = NULL;
+    ifx_Matrix_C_t* complex = NULL;
+    test_seed(fft_type);
+    if (fft_type == IFX_FFT_TYPE_R2C)
+    {
+        real = ifx_mat_create_r(CHIRPS, SAMPLES);
+        for (uint32_t i = 0; i < CHIRPS; i++)
+            for (uint32_t j = 0; j < SAMPLES; j++)
+                IFX_MAT_AT(real, i, j) = test_uniform(-1, 1);
+    }
+    else
+    {
+        complex = ifx_mat_create_c(CHIRPS, SAMPLES);
+        for (uint32_t i = 0; i < CHIRPS; i++)
+            for (uint32_t j = 0; j < SAMPLES; j++)
+                IFX_COMPLEX_SET(IFX_MAT_AT(complex, i, j), test_uniform(-1, 1), test_uniform(-1, 1));
+    }
+
+    ifx_RS_t* handle = create(fft_type);
+    TEST_CHECK(handle != NULL);
+    if (!handle)
+        return;
+
+    // the spectrum of every chirp on its own
+    ifx_Matrix_C_t* reference = ifx_mat_create_c(CHIRPS, bins);
+    ifx_rs_set_mode(handle, IFX_RS_MODE_SINGLE_CHIRP);
+    for (uint32_t i = 0; i < CHIRPS; i++)
+    {
+        ifx_Vector_C_t row;
+        ifx_mat_get_rowview_c(reference, i, &row);
+        ifx_rs_set_single_chirp_mode_index(handle, i);
+        run(handle, real, complex, &row);
+    }
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    const ifx_RS_Mode_t modes[] = {IFX_RS_MODE_COHERENT_INTEGRATION,
+                                   IFX_RS_MODE_NONCOHERENT_INTEGRATION,
+                                   IFX_RS_MODE_MAX_BIN};
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+    {
+        check_mode(handle, modes[m], reference, real, complex, 0, 0, 1);
+        check_mode(handle, modes[m], reference, real, complex, 1, 4, 3);
+        check_mode(handle, modes[m], reference, real, complex, 5, 0, 2);
+    }
+
+    // a subset starting beyond the frame is rejected, also for a frame shorter than configured
+    ifx_rs_set_chirp_subset(handle, CHIRPS, 0, 1);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ifx_Vector_C_t* output = ifx_vec_create_c(bins);
+    ifx_Matrix_R_t short_real;
+    ifx_Matrix_C_t short_complex;
+    if (real)
+        ifx_mat_view_rows_r(&short_real, real, 0, 4);
+    else
+        ifx_mat_view_rows_c(&short_complex, complex, 0, 4);
+    ifx_rs_set_mode(handle, IFX_RS_MODE_COHERENT_INTEGRATION);
+    ifx_rs_set_chirp_subset(handle, 5, 0, 1);
+    run(handle, real ? &short_real : NULL, complex ? &short_complex : NULL, output);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_DIMENSION_MISMATCH);
+
+    ifx_vec_destroy_c(output);
+    ifx_mat_destroy_c(reference);
+    if (real)
+        ifx_mat_destroy_r(real);
+    if (complex)
+        ifx_mat_destroy_c(complex);
+    ifx_rs_destroy(handle);
+}
+
+int main(void)
+{
+    check_integration(IFX_FFT_TYPE_R2C);
+    check_integration(IFX_FFT_TYPE_C2C);
+
+    return TEST_RESULT();
+}
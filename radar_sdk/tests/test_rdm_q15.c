@@ -0,0 +1,238 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_rdm_q15.c
+ *
+ * Compares the fixed-point range Doppler map with the float path for real
+ * and complex input. Covers input close to full scale and chirps whose
+ * number of samples is not a power of two and smaller than the FFT size
+ * (zero padding).
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Matrix.h"
+#include "ifxRadar/RangeDopplerMap.h"
+
+#include "Test.h"
+
+#define PI 3.14159265358979323846
+
+/* bins within this distance from the peak must agree within PEAK_TOL_DB */
+#define PEAK_RANGE_DB 40.0
+#define PEAK_TOL_DB   0.1
+/* all bins within this distance from the peak must agree within FLOOR_TOL_DB */
+#define FLOOR_RANGE_DB 60.0
+#define FLOOR_TOL_DB   1.0
+
+typedef struct
+{
+    const char* name;
+    ifx_FFT_Type_t range_fft_type;
+    uint32_t samples;
+    uint32_t range_fft_size;
+    uint32_t chirps;
+    uint32_t doppler_fft_size;
+    double full_scale; /* peak amplitude of the input relative to the Q15 range */
+} Rdm_Case_t;
+
+/* Two targets at different range and Doppler bins with noise, as Q15 */
+static void make_input(const Rdm_Case_t* c, uint32_t components, int16_t* q15)
+{
+    static const double range_freq[] = {0.11, 0.31};
+    static const double doppler_freq[] = {0.07, -0.21};
+    static const double amplitude[] = {1.0, 0.25};
+
+    double peak = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        test_seed(49);
+        for (uint32_t chirp = 0; chirp < c->chirps; chirp++)
+        {
+            for (uint32_t s = 0; s < c->samples; s++)
+            {
+                double re = 0.2;  // DC offset, removed by the mean removal
+                double im = -0.1;
+                for (int t = 0; t < 2; t++)
+                {
+                    const double phase = 2 * PI * (range_freq[t] * s + doppler_freq[t] * chirp);
+                    re += amplitude[t] * cos(phase);
+                    im += amplitude[t] * sin(phase);
+                }
+                re += test_uniform(-0.01f, 0.01f);
+                im += test_uniform(-0.01f, 0.01f);
+
+                const size_t i = ((size_t)chirp * c->samples + s) * components;
+                if (pass == 0)
+                {
+                    peak = fmax(peak, fabs(re));
+                    if (components == 2)
+                        peak = fmax(peak, fabs(im));
+                    continue;
+                }
+
+                const double scale = c->full_scale * 32767.0 / peak;
+                q15[i] = (int16_t)fmin(fmax(round(re * scale), -32767), 32767);
+                if (components == 2)
+                    q15[i + 1] = (int16_t)fmin(fmax(round(im * scale), -32767), 32767);
+            }
+        }
+    }
+}
+
+static ifx_RDM_Config_t make_config(const Rdm_Case_t* c)
+{
+    ifx_RDM_Config_t config;
+    memset(&config, 0, sizeof(config));
+    config.spect_threshold = 1e-6f;
+    config.output_scale_type = IFX_SCALE_TYPE_DECIBEL_20LOG;
+
+    config.range_fft_config.fft_type = c->range_fft_type;
+    config.range_fft_config.fft_size = c->range_fft_size;
+    config.range_fft_config.mean_removal_enabled = true;
+    config.range_fft_config.window_config.type = IFX_WINDOW_HANN;
+    config.range_fft_config.window_config.size = c->samples;
+    config.range_fft_config.window_config.scale = 1;
+    config.range_fft_config.is_normalized_window = true;
+
+    config.doppler_fft_config.fft_type = IFX_FFT_TYPE_C2C;
+    config.doppler_fft_config.fft_size = c->doppler_fft_size;
+    config.doppler_fft_config.mean_removal_enabled = true;
+    config.doppler_fft_config.window_config.type = IFX_WINDOW_CHEBYSHEV;
+    config.doppler_fft_config.window_config.size = c->chirps;
+    config.doppler_fft_config.window_config.at_dB = 100;
+    config.doppler_fft_config.window_config.scale = 1;
+    config.doppler_fft_config.is_normalized_window = true;
+    return config;
+}
+
+static void check_case(const Rdm_Case_t* c)
+{
+    const uint32_t components = (c->range_fft_type == IFX_FFT_TYPE_R2C) ? 1 : 2;
+    const uint32_t rows = (components == 1) ? c->range_fft_size / 2 : c->range_fft_size;
+    const uint32_t cols = c->doppler_fft_size;
+
+    static int16_t q15[2 * 64 * 256];
+    TEST_CHECK((size_t)components * c->chirps * c->samples <= sizeof(q15) / sizeof(q15[0]));
+    make_input(c, components, q15);
+
+    const ifx_RDM_Config_t config = make_config(c);
+    ifx_RDM_t* rdm = ifx_rdm_create(&config);
+    ifx_RDM_Q15_t* rdm_q15 = ifx_rdm_q15_create(&config);
+    ifx_Matrix_R_t* expected = ifx_mat_create_r(rows, cols);
+    ifx_Matrix_R_t* output = ifx_mat_create_r(rows, cols);
+    TEST_CHECK(rdm && rdm_q15 && expected && output);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    if (!rdm || !rdm_q15 || !expected || !output)
+        goto out;
+
+    if (components == 1)
+    {
+        ifx_Matrix_R_t* input = ifx_mat_create_r(c->chirps, c->samples);
+        for (uint32_t r = 0; r < c->chirps; r++)
+            for (uint32_t s = 0; s < c->samples; s++)
+                IFX_MAT_AT(input, r, s) = (ifx_Float_t)q15[r * c->samples + s] / 32768;
+        ifx_rdm_run_r(rdm, input, expected);
+        ifx_rdm_q15_run_r(rdm_q15, q15, output);
+        ifx_mat_destroy_r(input);
+    }
+    else
+    {
+        ifx_Matrix_C_t* input = ifx_mat_create_c(c->chirps, c->samples);
+        for (uint32_t r = 0; r < c->chirps; r++)
+        {
+            for (uint32_t s = 0; s < c->samples; s++)
+            {
+                const int16_t* iq = &q15[2 * (r * c->samples + s)];
+                IFX_COMPLEX_SET(IFX_MAT_AT(input, r, s), (ifx_Float_t)iq[0] / 32768, (ifx_Float_t)iq[1] / 32768);
+            }
+        }
+        ifx_rdm_run_cr(rdm, input, expected);
+        ifx_rdm_q15_run_c(rdm_q15, q15, output);
+        ifx_mat_destroy_c(input);
+    }
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+
+    uint32_t peak_row = 0, peak_col = 0;
+    for (uint32_t r = 0; r < rows; r++)
+        for (uint32_t k = 0; k < cols; k++)
+            if (IFX_MAT_AT(expected, r, k) > IFX_MAT_AT(expected, peak_row, peak_col))
+                peak_row = r, peak_col = k;
+    const double peak = IFX_MAT_AT(expected, peak_row, peak_col);
+
+    double peak_error = 0, floor_error = 0;
+    uint32_t q15_peak_row = 0, q15_peak_col = 0;
+    for (uint32_t r = 0; r < rows; r++)
+    {
+        for (uint32_t k = 0; k < cols; k++)
+        {
+            const double e = IFX_MAT_AT(expected, r, k);
+            const double error = fabs(IFX_MAT_AT(output, r, k) - e);
+            if (e >= peak - PEAK_RANGE_DB)
+                peak_error = fmax(peak_error, error);
+            if (e >= peak - FLOOR_RANGE_DB)
+                floor_error = fmax(floor_error, error);
+            if (IFX_MAT_AT(output, r, k) > IFX_MAT_AT(output, q15_peak_row, q15_peak_col))
+                q15_peak_row = r, q15_peak_col = k;
+        }
+    }
+
+    printf("%s: peak %.2f dB, max error %.4f dB within %.0f dB, %.4f dB within %.0f dB of the peak\n",
+           c->name, peak, peak_error, PEAK_RANGE_DB, floor_error, FLOOR_RANGE_DB);
+    TEST_CHECK(peak_error <= PEAK_TOL_DB);
+    TEST_CHECK(floor_error <= FLOOR_TOL_DB);
+    TEST_CHECK(q15_peak_row == peak_row && q15_peak_col == peak_col);
+
+out:
+    ifx_mat_destroy_r(output);
+    ifx_mat_destroy_r(expected);
+    ifx_rdm_q15_destroy(rdm_q15);
+    ifx_rdm_destroy(rdm);
+}
+
+int main(void)
+{
+    static const Rdm_Case_t cases[] = {
+        {"real", IFX_FFT_TYPE_R2C, 64, 128, 32, 64, 0.5},
+        {"real full scale", IFX_FFT_TYPE_R2C, 128, 256, 64, 64, 0.999},
+        {"real padded", IFX_FFT_TYPE_R2C, 100, 128, 24, 32, 0.9},
+        {"complex", IFX_FFT_TYPE_C2C, 64, 64, 32, 64, 0.5},
+        {"complex full scale", IFX_FFT_TYPE_C2C, 64, 128, 32, 32, 0.999},
+        {"complex padded", IFX_FFT_TYPE_C2C, 50, 64, 20, 32, 0.9},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        check_case(&cases[i]);
+    return TEST_RESULT();
+}
@@ -0,0 +1,404 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_simd.c
+ *
+ * Compares every entry of the SIMD kernel tables (internal/Simd*.h) of all
+ * instruction sets available on this CPU against the scalar reference. The
+ * lengths cover the vectorized part as well as all tail lengths.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "ifxBase/internal/Simd.h"
+#include "ifxBase/internal/SimdAdc.h"
+#include "ifxBase/internal/SimdFixed.h"
+#include "ifxBase/internal/SimdMonopulse.h"
+#include "ifxBase/internal/SimdMti.h"
+
+#include "Test.h"
+
+#define MAX_LEN 260
+
+// number of function pointers in a kernel table
+#define NUM_KERNELS(type, first) ((sizeof(type) - offsetof(type, first)) / sizeof(void (*)(void)))
+
+static const size_t lengths[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 255, 256};
+#define NUM_LENGTHS (sizeof(lengths) / sizeof(lengths[0]))
+
+static float x[4 * MAX_LEN], y[4 * MAX_LEN], w[4 * MAX_LEN];
+static float ref[4 * MAX_LEN], out[4 * MAX_LEN];
+static float h_ref[4 * MAX_LEN], h_out[4 * MAX_LEN];
+
+static void fill(float* v, size_t len, float lo, float hi)
+{
+    for (size_t i = 0; i < len; i++)
+        v[i] = test_uniform(lo, hi);
+}
+
+// checks |a[i] - b[i]| <= tol * max(1, |a[i]|)
+static void check_arrays(const char* isa, const char* kernel, size_t len, const float* a, const float* b, size_t n, float tol)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const float scale = fabsf(a[i]) > 1 ? fabsf(a[i]) : 1;
+        if (!(fabsf(a[i] - b[i]) <= tol * scale))
+        {
+            fprintf(stderr, "%s %s len=%zu: element %zu: scalar %.9g, simd %.9g\n", isa, kernel, len, i, a[i], b[i]);
+            TEST_FAIL();
+            return;
+        }
+    }
+}
+
+static void check_scalar(const char* isa, const char* kernel, size_t len, float a, float b, float tol)
+{
+    check_arrays(isa, kernel, len, &a, &b, 1, tol);
+}
+
+/* ---------------------------------------------------------------------------
+ * ifx_Simd_Kernels_t
+ * ------------------------------------------------------------------------ */
+
+static size_t test_generic(const ifx_Simd_Kernels_t* s, const ifx_Simd_Kernels_t* k)
+{
+    const char* isa = k->name;
+
+    for (size_t t = 0; t < NUM_LENGTHS; t++)
+    {
+        const size_t n = lengths[t];
+        fill(x, 2 * n, -1, 1);
+        fill(y, 2 * n, -1, 1);
+
+        // the error of the sums grows with the number of terms
+        const float tol_sum = 1e-6f * (float)(n + 1);
+        check_scalar(isa, "sum_r", n, s->sum_r(x, n), k->sum_r(x, n), tol_sum);
+        check_scalar(isa, "sqsum_r", n, s->sqsum_r(x, n), k->sqsum_r(x, n), tol_sum);
+        check_scalar(isa, "dot_r", n, s->dot_r(x, y, n), k->dot_r(x, y, n), tol_sum);
+
+#define CHECK_BINARY(name, tol)                     \
+    s->name(x, y, ref, n);                          \
+    k->name(x, y, out, n);                          \
+    check_arrays(isa, #name, n, ref, out, n, (tol))
+
+        CHECK_BINARY(add_r, 0);
+        CHECK_BINARY(sub_r, 0);
+        CHECK_BINARY(mul_r, 0);
+        CHECK_BINARY(max_r, 0);
+
+        s->scale_r(x, 0.3f, ref, n);
+        k->scale_r(x, 0.3f, out, n);
+        check_arrays(isa, "scale_r", n, ref, out, n, 0);
+
+        // FMA rounds once
+        s->mac_r(x, y, -0.7f, ref, n);
+        k->mac_r(x, y, -0.7f, out, n);
+        check_arrays(isa, "mac_r", n, ref, out, n, 1e-6f);
+
+        s->clip_r(x, -0.5f, 0.25f, ref, n);
+        k->clip_r(x, -0.5f, 0.25f, out, n);
+        check_arrays(isa, "clip_r", n, ref, out, n, 0);
+
+        // complex kernels: n complex values
+        s->mul_c(x, y, ref, n);
+        k->mul_c(x, y, out, n);
+        check_arrays(isa, "mul_c", n, ref, out, 2 * n, 1e-6f);
+
+        s->mul_cr(x, y, ref, n);
+        k->mul_cr(x, y, out, n);
+        check_arrays(isa, "mul_cr", n, ref, out, 2 * n, 0);
+
+        s->abs_c(x, ref, n);
+        k->abs_c(x, out, n);
+        check_arrays(isa, "abs_c", n, ref, out, n, 1e-6f);
+
+        s->sqnorm_c(x, ref, n);
+        k->sqnorm_c(x, out, n);
+        check_arrays(isa, "sqnorm_c", n, ref, out, n, 1e-6f);
+
+        // squared magnitudes over several decades including values below
+        // the threshold and zero
+        for (size_t i = 0; i < n; i++)
+            ref[i] = out[i] = (i % 7 == 0) ? 0 : powf(10, test_uniform(-8, 4));
+        s->pow2db_r(ref, 10, 1e-6f, -60, n);
+        k->pow2db_r(out, 10, 1e-6f, -60, n);
+        check_arrays(isa, "pow2db_r", n, ref, out, n, 1e-5f);
+
+        // local maxima with two valid neighbours on each side; quantized
+        // values produce plateaus that exercise the >= and > conditions
+        {
+            uint32_t index_ref[MAX_LEN], index_out[MAX_LEN];
+            for (size_t i = 0; i < n + 4; i++)
+                x[i] = (float)(test_random() % 8);
+            const size_t count_ref = s->local_max_r(x, 2, n + 2, 3, index_ref);
+            const size_t count_out = k->local_max_r(x, 2, n + 2, 3, index_out);
+            TEST_CHECK(count_ref == count_out);
+            if (count_ref == count_out && memcmp(index_ref, index_out, count_ref * sizeof(uint32_t)) != 0)
+            {
+                fprintf(stderr, "%s local_max_r len=%zu: indices differ\n", isa, n);
+                TEST_FAIL();
+            }
+        }
+    }
+
+    return 16;
+}
+
+/* ---------------------------------------------------------------------------
+ * ifx_Simd_Mti_Kernels_t
+ * ------------------------------------------------------------------------ */
+
+static size_t test_mti(const char* isa, const ifx_Simd_Mti_Kernels_t* s, const ifx_Simd_Mti_Kernels_t* k)
+{
+    for (size_t t = 0; t < NUM_LENGTHS; t++)
+    {
+        const size_t n = lengths[t];
+        fill(x, n, -1, 1);
+        fill(w, n, 0, 1);
+        fill(h_ref, n, -1, 1);
+        memcpy(h_out, h_ref, n * sizeof(float));
+
+        s->mti_r(x, h_ref, 0.25f, ref, n);
+        k->mti_r(x, h_out, 0.25f, out, n);
+        check_arrays(isa, "mti_r", n, ref, out, n, 1e-6f);
+        check_arrays(isa, "mti_r (history)", n, h_ref, h_out, n, 1e-6f);
+
+        s->mti_vr(x, h_ref, w, ref, n);
+        k->mti_vr(x, h_out, w, out, n);
+        check_arrays(isa, "mti_vr", n, ref, out, n, 1e-6f);
+        check_arrays(isa, "mti_vr (history)", n, h_ref, h_out, n, 1e-6f);
+
+        // h_ref/h_out are the second last inputs, y the last one
+        fill(y, n, -1, 1);
+        s->cancel3_r(x, y, h_ref, ref, n);
+        k->cancel3_r(x, y, h_out, out, n);
+        check_arrays(isa, "cancel3_r", n, ref, out, n, 1e-6f);
+        check_arrays(isa, "cancel3_r (history)", n, h_ref, h_out, n, 0);
+    }
+
+    return 3;
+}
+
+/* ---------------------------------------------------------------------------
+ * ifx_Simd_Monopulse_Kernels_t
+ * ------------------------------------------------------------------------ */
+
+static size_t test_monopulse(const char* isa, const ifx_Simd_Monopulse_Kernels_t* s, const ifx_Simd_Monopulse_Kernels_t* k)
+{
+    const float c[2] = {0.6f, -0.8f};
+
+    for (size_t t = 0; t < NUM_LENGTHS; t++)
+    {
+        const size_t n = lengths[t];
+        fill(x, 2 * n, -1, 1);
+        fill(y, 2 * n, -1, 1);
+        // phase differences close to +-pi and scales which clip
+        if (n > 2)
+        {
+            x[0] = -1;
+            x[1] = 1e-7f;
+            y[0] = 1;
+            y[1] = 0;
+        }
+
+        // angles in degrees; the polynomials are accurate to 1e-6 rad
+        s->monopulse_c(x, y, NULL, 0.5f, ref, n);
+        k->monopulse_c(x, y, NULL, 0.5f, out, n);
+        check_arrays(isa, "monopulse_c", n, ref, out, n, 1e-3f);
+
+        s->monopulse_c(x, y, c, 0.8f, ref, n);
+        k->monopulse_c(x, y, c, 0.8f, out, n);
+        check_arrays(isa, "monopulse_c (calibrated)", n, ref, out, n, 1e-3f);
+    }
+
+    return 1;
+}
+
+/* ---------------------------------------------------------------------------
+ * ifx_Simd_Adc_Kernels_t
+ * ------------------------------------------------------------------------ */
+
+static size_t test_adc(const char* isa, const ifx_Simd_Adc_Kernels_t* s, const ifx_Simd_Adc_Kernels_t* k)
+{
+    static uint16_t raw[5 * MAX_LEN];
+    const size_t strides[] = {2, 4, 5};
+
+    for (size_t t = 0; t < NUM_LENGTHS; t++)
+    {
+        const size_t n = lengths[t];
+        for (size_t i = 0; i < 5 * n; i++)
+            raw[i] = (uint16_t)test_random();
+
+        for (size_t j = 0; j < sizeof(strides) / sizeof(strides[0]); j++)
+        {
+            s->adc8_c(raw, strides[j], ref, n);
+            k->adc8_c(raw, strides[j], out, n);
+            check_arrays(isa, "adc8_c", n, ref, out, 2 * n, 0);
+        }
+
+        s->adc12_c(raw, ref, n);
+        k->adc12_c(raw, out, n);
+        check_arrays(isa, "adc12_c", n, ref, out, 2 * n, 0);
+    }
+
+    return 2;
+}
+
+/* ---------------------------------------------------------------------------
+ * ifx_Simd_Fixed_Kernels_t
+ * ------------------------------------------------------------------------ */
+
+static void random_q15(int16_t* v, size_t len)
+{
+    // -32768 is excluded, see mul_q15
+    for (size_t i = 0; i < len; i++)
+        v[i] = (int16_t)((int32_t)(test_random() % 65535) - 32767);
+}
+
+static size_t test_fixed(const char* isa, const ifx_Simd_Fixed_Kernels_t* s, const ifx_Simd_Fixed_Kernels_t* k)
+{
+    static int8_t a8[MAX_LEN], b8[MAX_LEN];
+    static int16_t a[2 * MAX_LEN], b[2 * MAX_LEN], z_ref[2 * MAX_LEN], z_out[2 * MAX_LEN];
+    static int16_t tw[4 * MAX_LEN];
+
+    for (size_t t = 0; t < NUM_LENGTHS; t++)
+    {
+        const size_t n = lengths[t];
+        for (size_t i = 0; i < n; i++)
+        {
+            a8[i] = (int8_t)(test_random() & 0xFF);
+            b8[i] = (int8_t)(test_random() & 0xFF);
+        }
+        // includes -128 * -128
+        if (n > 0)
+            a8[0] = b8[0] = -128;
+        TEST_CHECK(s->dot_s8(a8, b8, n) == k->dot_s8(a8, b8, n));
+
+        random_q15(a, n);
+        random_q15(b, n);
+        s->mul_q15(a, b, z_ref, n);
+        k->mul_q15(a, b, z_out, n);
+        if (memcmp(z_ref, z_out, n * sizeof(int16_t)) != 0)
+        {
+            fprintf(stderr, "%s mul_q15 len=%zu: results differ\n", isa, n);
+            TEST_FAIL();
+        }
+    }
+
+    // butterfly stages of FFT sizes 2 ... 256 with all distances and shifts
+    for (size_t len = 2; len <= 256; len *= 2)
+    {
+        for (size_t half = 1; half < len; half *= 2)
+        {
+            for (uint32_t shift = 0; shift <= 2; shift++)
+            {
+                for (size_t i = 0; i < half; i++)
+                {
+                    const double phi = -3.14159265358979323846 * (double)i / (double)half;
+                    const int16_t re = (int16_t)lrint(32767 * cos(phi));
+                    const int16_t im = (int16_t)lrint(32767 * sin(phi));
+                    tw[4 * i] = re;
+                    tw[4 * i + 1] = (int16_t)-im;
+                    tw[4 * i + 2] = im;
+                    tw[4 * i + 3] = re;
+                }
+
+                random_q15(z_ref, 2 * len);
+                memcpy(z_out, z_ref, 2 * len * sizeof(int16_t));
+
+                const int32_t max_ref = s->bfly_q15(z_ref, tw, shift, half, len);
+                const int32_t max_out = k->bfly_q15(z_out, tw, shift, half, len);
+                if (max_ref != max_out || memcmp(z_ref, z_out, 2 * len * sizeof(int16_t)) != 0)
+                {
+                    fprintf(stderr, "%s bfly_q15 len=%zu half=%zu shift=%u: results differ\n", isa, len, half, shift);
+                    TEST_FAIL();
+                }
+            }
+        }
+    }
+
+    return 3;
+}
+
+/* ---------------------------------------------------------------------------
+ * main
+ * ------------------------------------------------------------------------ */
+
+int main(void)
+{
+    const ifx_Simd_Isa_t isas[] = {IFX_SIMD_ISA_SSE2, IFX_SIMD_ISA_AVX2, IFX_SIMD_ISA_NEON};
+
+    const ifx_Simd_Kernels_t* scalar = ifx_simd_kernels_for_isa(IFX_SIMD_ISA_SCALAR);
+    TEST_CHECK(scalar != NULL);
+    if (!scalar)
+        return TEST_RESULT();
+
+    // the module tables follow the table selected by ifx_simd_kernels
+    TEST_CHECK(ifx_simd_mti_kernels() == ifx_simd_mti_kernels_for_isa(ifx_simd_kernels()->isa));
+    TEST_CHECK(ifx_simd_fixed_kernels() == ifx_simd_fixed_kernels_for_isa(ifx_simd_kernels()->isa));
+
+    for (size_t i = 0; i < sizeof(isas) / sizeof(isas[0]); i++)
+    {
+        const ifx_Simd_Kernels_t* kernels = ifx_simd_kernels_for_isa(isas[i]);
+        if (!kernels)
+        {
+            TEST_CHECK(ifx_simd_mti_kernels_for_isa(isas[i]) == NULL);
+            continue;
+        }
+
+        test_seed(1 + (uint32_t)i);
+        printf("testing %s kernels\n", kernels->name);
+
+        // every entry of every table must be covered by the tests above
+        size_t tested = test_generic(scalar, kernels);
+        TEST_CHECK(tested == NUM_KERNELS(ifx_Simd_Kernels_t, sum_r));
+
+        tested = test_mti(kernels->name, ifx_simd_mti_kernels_for_isa(IFX_SIMD_ISA_SCALAR), ifx_simd_mti_kernels_for_isa(isas[i]));
+        TEST_CHECK(tested == NUM_KERNELS(ifx_Simd_Mti_Kernels_t, mti_r));
+
+        tested = test_monopulse(kernels->name, ifx_simd_monopulse_kernels_for_isa(IFX_SIMD_ISA_SCALAR),
+                                ifx_simd_monopulse_kernels_for_isa(isas[i]));
+        TEST_CHECK(tested == NUM_KERNELS(ifx_Simd_Monopulse_Kernels_t, monopulse_c));
+
+        tested = test_adc(kernels->name, ifx_simd_adc_kernels_for_isa(IFX_SIMD_ISA_SCALAR), ifx_simd_adc_kernels_for_isa(isas[i]));
+        TEST_CHECK(tested == NUM_KERNELS(ifx_Simd_Adc_Kernels_t, adc8_c));
+
+        tested = test_fixed(kernels->name, ifx_simd_fixed_kernels_for_isa(IFX_SIMD_ISA_SCALAR), ifx_simd_fixed_kernels_for_isa(isas[i]));
+        TEST_CHECK(tested == NUM_KERNELS(ifx_Simd_Fixed_Kernels_t, dot_s8));
+    }
+
+    // selecting an instruction set switches all tables
+    TEST_CHECK(ifx_simd_select_isa(IFX_SIMD_ISA_SCALAR));
+    TEST_CHECK(ifx_simd_mti_kernels() == ifx_simd_mti_kernels_for_isa(IFX_SIMD_ISA_SCALAR));
+    TEST_CHECK(ifx_simd_adc_kernels() == ifx_simd_adc_kernels_for_isa(IFX_SIMD_ISA_SCALAR));
+
+    return TEST_RESULT();
+}
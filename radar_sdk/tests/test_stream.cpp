@@ -0,0 +1,248 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_stream.cpp
+ *
+ * Tests the ring buffer stream used by the MATLAB streaming mode with a
+ * fake fetch callback: frames are read in order across the wrap-around of
+ * the ring, overwritten frames are counted as dropped, decimation only
+ * thins out the ring while every frame is recorded, and timeouts and
+ * acquisition errors reach the reader.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ifxBase/Error.h"
+#include "ifxBase/Stream.h"
+
+#include "Test.h"
+
+namespace {
+
+constexpr size_t frameSize = 5;
+
+// Fetches frames numbered from 0, value i of frame n is n * frameSize + i
+struct FakeSource
+{
+    std::atomic<uint32_t> available {0}; // frames that may be fetched
+    std::atomic<uint32_t> fetched {0};
+    ifx_Error_t error = IFX_OK;           // error once all available frames were fetched
+};
+
+bool fetch(void* context, float* frame)
+{
+    auto* source = static_cast<FakeSource*>(context);
+    const uint32_t n = source->fetched.load();
+    if (n >= source->available.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ifx_error_set(source->error == IFX_OK ? IFX_ERROR_TIMEOUT : source->error);
+        return false;
+    }
+
+    for (size_t i = 0; i < frameSize; i++)
+        frame[i] = float(n * frameSize + i);
+    source->fetched++;
+    return true;
+}
+
+ifx_Stream_Stats_t get_stats(ifx_Stream_t* stream)
+{
+    ifx_Stream_Stats_t stats;
+    ifx_stream_get_stats(stream, &stats);
+    return stats;
+}
+
+// waits until the stream has fetched the given number of frames
+bool wait_fetched(ifx_Stream_t* stream, uint64_t frames)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (get_stats(stream).frames_fetched < frames)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+bool is_frame(const float* frame, uint32_t n)
+{
+    for (size_t i = 0; i < frameSize; i++)
+    {
+        if (frame[i] != float(n * frameSize + i))
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+// Frames are read oldest first, also when the ring wraps around
+static void test_order()
+{
+    FakeSource source;
+    ifx_Stream_Config_t config = {frameSize, 4, 1, nullptr};
+    ifx_Stream_t* stream = ifx_stream_create(&config, fetch, &source);
+    TEST_CHECK(stream != nullptr);
+
+    std::vector<float> frames(4 * frameSize);
+    uint32_t expected = 0;
+    for (int round = 0; round < 5; round++)
+    {
+        // three frames per round, so the ring of four frames wraps around
+        source.available += 3;
+        TEST_CHECK(wait_fetched(stream, expected + 3));
+
+        uint32_t count = ifx_stream_read(stream, frames.data(), 2, 1000);
+        TEST_CHECK(count == 2);
+        count += ifx_stream_read(stream, frames.data() + 2 * frameSize, 2, 1000);
+        TEST_CHECK(count == 3);
+        for (uint32_t i = 0; i < count; i++)
+            TEST_CHECK(is_frame(frames.data() + i * frameSize, expected + i));
+        expected += count;
+    }
+
+    const ifx_Stream_Stats_t stats = get_stats(stream);
+    TEST_CHECK(stats.frames_fetched == 15 && stats.frames_read == 15);
+    TEST_CHECK(stats.frames_dropped == 0 && stats.frames_queued == 0);
+    TEST_CHECK(stats.running);
+
+    // no frame within the timeout
+    TEST_CHECK(ifx_stream_read(stream, frames.data(), 4, 20) == 0);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_TIMEOUT);
+
+    ifx_stream_destroy(stream);
+}
+
+// A full ring drops the oldest frames and counts them
+static void test_drops()
+{
+    FakeSource source;
+    ifx_Stream_Config_t config = {frameSize, 4, 1, nullptr};
+    ifx_Stream_t* stream = ifx_stream_create(&config, fetch, &source);
+
+    source.available = 10;
+    TEST_CHECK(wait_fetched(stream, 10));
+
+    std::vector<float> frames(8 * frameSize);
+    TEST_CHECK(ifx_stream_read(stream, frames.data(), 8, 1000) == 4);
+    for (uint32_t i = 0; i < 4; i++)
+        TEST_CHECK(is_frame(frames.data() + i * frameSize, 6 + i));
+
+    const ifx_Stream_Stats_t stats = get_stats(stream);
+    TEST_CHECK(stats.frames_dropped == 6);
+    TEST_CHECK(stats.frames_read == 4);
+    TEST_CHECK(stats.frames_queued == 0);
+
+    ifx_stream_destroy(stream);
+}
+
+// Decimation only applies to the ring, every frame is recorded
+static void test_decimation_and_recording()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "test_stream.bin").string();
+    FakeSource source;
+    ifx_Stream_Config_t config = {frameSize, 8, 3, path.c_str()};
+    ifx_Stream_t* stream = ifx_stream_create(&config, fetch, &source);
+    TEST_CHECK(stream != nullptr);
+
+    source.available = 9;
+    TEST_CHECK(wait_fetched(stream, 9));
+
+    std::vector<float> frames(8 * frameSize);
+    TEST_CHECK(ifx_stream_read(stream, frames.data(), 8, 1000) == 3);
+    for (uint32_t i = 0; i < 3; i++)
+        TEST_CHECK(is_frame(frames.data() + i * frameSize, 3 * i));
+
+    const ifx_Stream_Stats_t stats = get_stats(stream);
+    TEST_CHECK(stats.frames_recorded == 9);
+    TEST_CHECK(stats.frames_dropped == 0);
+    ifx_stream_destroy(stream);
+
+    std::vector<float> recorded(10 * frameSize);
+    std::ifstream in(path, std::ios::binary);
+    in.read(reinterpret_cast<char*>(recorded.data()), recorded.size() * sizeof(float));
+    TEST_CHECK(size_t(in.gcount()) == 9 * frameSize * sizeof(float));
+    for (uint32_t n = 0; n < 9; n++)
+        TEST_CHECK(is_frame(recorded.data() + n * frameSize, n));
+    in.close();
+    std::filesystem::remove(path);
+}
+
+// An acquisition error stops the thread; queued frames are still read before the error is reported
+static void test_error()
+{
+    FakeSource source;
+    source.error = IFX_ERROR_COMMUNICATION_ERROR;
+    ifx_Stream_Config_t config = {frameSize, 4, 1, nullptr};
+    ifx_Stream_t* stream = ifx_stream_create(&config, fetch, &source);
+
+    source.available = 2;
+    TEST_CHECK(wait_fetched(stream, 2));
+    while (get_stats(stream).running)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::vector<float> frames(4 * frameSize);
+    TEST_CHECK(ifx_stream_read(stream, frames.data(), 4, 1000) == 2);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_OK);
+    TEST_CHECK(is_frame(frames.data() + frameSize, 1));
+
+    TEST_CHECK(ifx_stream_read(stream, frames.data(), 4, 1000) == 0);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_COMMUNICATION_ERROR);
+    TEST_CHECK(!get_stats(stream).running);
+
+    ifx_stream_destroy(stream);
+}
+
+static void test_invalid_config()
+{
+    FakeSource source;
+    ifx_Stream_Config_t config = {frameSize, 0, 1, nullptr};
+    TEST_CHECK(ifx_stream_create(&config, fetch, &source) == nullptr);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+}
+
+int main()
+{
+    test_order();
+    test_drops();
+    test_decimation_and_recording();
+    test_error();
+    test_invalid_config();
+
+    return TEST_RESULT();
+}
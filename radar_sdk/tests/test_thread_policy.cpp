@@ -0,0 +1,132 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_thread_policy.cpp
+ *
+ * Tests that a thread keeps the first role applied to it, and that the
+ * thread of a frame forwarder takes the role requested by its listener.
+ * The policies keep the default scheduling, so no privileges are needed.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <common/ThreadPolicy.hpp>
+#include <platform/frames/FrameForwarder.hpp>
+#include <platform/frames/FramePool.hpp>
+#include <platform/frames/FrameQueue.hpp>
+
+#include "Test.h"
+
+namespace {
+
+// records the role of the thread calling it
+class ConvertingListener :
+    public IFrameListener<>
+{
+public:
+    void onNewFrame(IFrame *frame) override
+    {
+        role.store(static_cast<int>(ThreadPolicies::currentRole()));
+        frame->release();
+        frames++;
+    }
+
+    ThreadRole getThreadRole() const override
+    {
+        return ThreadRole::Converter;
+    }
+
+    std::atomic<int> role {-1};
+    std::atomic<int> frames {0};
+};
+
+void test_role_once()
+{
+    std::thread thread([]() {
+        TEST_CHECK(ThreadPolicies::currentRole() == ThreadRole::Count);
+        TEST_CHECK(ThreadPolicies::instance().apply(ThreadRole::DspWorker));
+        TEST_CHECK(ThreadPolicies::currentRole() == ThreadRole::DspWorker);
+
+        // the first role is kept
+        TEST_CHECK(!ThreadPolicies::instance().apply(ThreadRole::Converter));
+        TEST_CHECK(ThreadPolicies::currentRole() == ThreadRole::DspWorker);
+        TEST_CHECK(ThreadPolicies::instance().apply(ThreadRole::DspWorker));
+    });
+    thread.join();
+
+    // another thread starts without a role
+    std::thread other([]() {
+        TEST_CHECK(ThreadPolicies::currentRole() == ThreadRole::Count);
+        TEST_CHECK(ThreadPolicies::instance().apply(ThreadRole::Converter));
+        TEST_CHECK(ThreadPolicies::currentRole() == ThreadRole::Converter);
+    });
+    other.join();
+
+    TEST_CHECK(!ThreadPolicies::instance().apply(ThreadRole::Count));
+}
+
+void test_forwarder_role()
+{
+    FramePool pool;
+    pool.setFrameBufferSize(16);
+    pool.setFrameCount(2);
+
+    FrameQueue queue;
+    ConvertingListener listener;
+    {
+        FrameForwarder forwarder(&queue);
+        forwarder.registerListener(&listener);
+        queue.start();
+        forwarder.start();
+
+        queue.enqueue(pool.dequeueFrame());
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (listener.frames.load() == 0 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        TEST_CHECK(listener.frames.load() == 1);
+        TEST_CHECK(listener.role.load() == static_cast<int>(ThreadRole::Converter));
+
+        forwarder.stop();
+        queue.stop();
+    }
+    queue.clear();
+}
+
+}  // namespace
+
+int main()
+{
+    test_role_once();
+    test_forwarder_role();
+    return TEST_RESULT();
+}
@@ -0,0 +1,304 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file test_tracker.c
+ *
+ * Deterministic scenarios for the multi-target tracker: the life cycle of
+ * tracks (birth, confirmation, deletion and their events), two targets
+ * crossing each other in range and angle that must keep their ids,
+ * run-to-run determinism and the restart of ids after a reset.
+ */
+
+#include <string.h>
+
+#include "ifxBase/Error.h"
+#include "ifxRadar/Tracker.h"
+
+#include "Test.h"
+
+#define FRAME_PERIOD_S 0.1f
+#define NUM_FRAMES     100
+
+static ifx_Tracker_Config_t default_config(void)
+{
+    ifx_Tracker_Config_t config;
+    memset(&config, 0, sizeof(config));
+    config.model = IFX_TRACKER_MODEL_CONSTANT_VELOCITY;
+    config.frame_period_s = FRAME_PERIOD_S;
+    config.max_tracks = 8;
+    config.max_detections = 8;
+    config.range_std_m = 0.1f;
+    config.speed_std_m_s = 0.1f;
+    config.angle_std_deg = 1.f;
+    config.range_process_std = 0.5f;
+    config.angle_process_std = 5.f;
+    config.angle_rate_init_std = 10.f;
+    config.gate_threshold = 11.34f;
+    config.confirm_hits = 3;
+    config.max_misses = 3;
+    return config;
+}
+
+static const ifx_Tracker_Track_t* find_track(const ifx_Tracker_Result_t* result, uint32_t id)
+{
+    for (uint32_t i = 0; i < result->num_tracks; i++)
+    {
+        if (result->tracks[i].id == id)
+            return &result->tracks[i];
+    }
+    return NULL;
+}
+
+/* one target: born, confirmed, lost; plus a single false detection */
+static void test_life_cycle(void)
+{
+    const ifx_Tracker_Config_t config = default_config();
+    ifx_Tracker_t* tracker = ifx_tracker_create(&config);
+    TEST_CHECK(tracker != NULL);
+    if (!tracker)
+        return;
+
+    ifx_Tracker_Result_t result;
+    ifx_Tracker_Detection_t detections[2];
+
+    for (uint32_t frame = 0; frame < 10; frame++)
+    {
+        const ifx_Float_t t = frame * FRAME_PERIOD_S;
+        detections[0].range_m = 4.f + 0.5f * t;
+        detections[0].speed_m_s = 0.5f;
+        detections[0].angle_deg = 10.f;
+        uint32_t num_detections = 1;
+
+        // a false alarm far away from the target in frame 2
+        if (frame == 2)
+        {
+            detections[1].range_m = 12.f;
+            detections[1].speed_m_s = -3.f;
+            detections[1].angle_deg = -40.f;
+            num_detections = 2;
+        }
+
+        ifx_tracker_run(tracker, detections, num_detections, &result);
+        TEST_CHECK(ifx_error_get() == IFX_OK);
+
+        const ifx_Tracker_Track_t* target = find_track(&result, 1);
+        TEST_CHECK(target != NULL);
+        if (!target)
+            continue;
+        TEST_CHECK(target->detection == 0);
+        TEST_CHECK(target->hits == frame + 1);
+
+        if (frame < 2)
+            TEST_CHECK(target->state == IFX_TRACK_TENTATIVE && target->events == 0);
+        else if (frame == 2)
+            TEST_CHECK(target->state == IFX_TRACK_CONFIRMED && target->events == IFX_TRACK_EVENT_CONFIRMED);
+        else
+            TEST_CHECK(target->state == IFX_TRACK_CONFIRMED && target->events == 0);
+
+        if (frame == 2)
+        {
+            // the false alarm starts a tentative track with the next id
+            const ifx_Tracker_Track_t* clutter = find_track(&result, 2);
+            TEST_CHECK(result.num_tracks == 2);
+            TEST_CHECK(clutter != NULL && clutter->state == IFX_TRACK_TENTATIVE && clutter->detection == 1);
+        }
+        else if (frame == 3)
+        {
+            // and is deleted on its first miss, reported once
+            const ifx_Tracker_Track_t* clutter = find_track(&result, 2);
+            TEST_CHECK(result.num_tracks == 2);
+            TEST_CHECK(clutter != NULL && clutter->state == IFX_TRACK_DELETED && clutter->events == IFX_TRACK_EVENT_DELETED);
+            TEST_CHECK(result.tracks[0].id == 1);  // live tracks come first
+        }
+        else
+        {
+            TEST_CHECK(result.num_tracks == 1);
+        }
+    }
+
+    // the target disappears: coasting for max_misses - 1 frames, then deleted
+    for (uint32_t miss = 1; miss <= config.max_misses; miss++)
+    {
+        ifx_tracker_run(tracker, NULL, 0, &result);
+        TEST_CHECK(result.num_tracks == 1);
+        if (result.num_tracks != 1)
+            continue;
+        TEST_CHECK(result.tracks[0].id == 1);
+        TEST_CHECK(result.tracks[0].misses == miss);
+        TEST_CHECK(result.tracks[0].detection == -1);
+        if (miss < config.max_misses)
+            TEST_CHECK(result.tracks[0].state == IFX_TRACK_CONFIRMED && result.tracks[0].events == 0);
+        else
+            TEST_CHECK(result.tracks[0].state == IFX_TRACK_DELETED && result.tracks[0].events == IFX_TRACK_EVENT_DELETED);
+    }
+
+    ifx_tracker_run(tracker, NULL, 0, &result);
+    TEST_CHECK(result.num_tracks == 0);
+
+    // ids are never reused before a reset
+    detections[0].range_m = 4.f;
+    ifx_tracker_run(tracker, detections, 1, &result);
+    TEST_CHECK(result.num_tracks == 1 && result.tracks[0].id == 3);
+
+    // after a reset the tracker starts over
+    ifx_tracker_reset(tracker);
+    ifx_tracker_run(tracker, detections, 1, &result);
+    TEST_CHECK(result.num_tracks == 1 && result.tracks[0].id == 1);
+    TEST_CHECK(result.tracks[0].state == IFX_TRACK_TENTATIVE && result.tracks[0].hits == 1);
+
+    ifx_tracker_destroy(tracker);
+}
+
+/*
+ * Two targets approach each other and cross at t = 5 s, where range and
+ * angle coincide; only the radial speed tells them apart. Target A is
+ * missed in every seventh frame. Both tracks must keep their ids, and the
+ * outputs of two runs must be bitwise identical.
+ */
+static uint32_t run_crossing(ifx_Tracker_Track_t history[NUM_FRAMES][2])
+{
+    const ifx_Tracker_Config_t config = default_config();
+    ifx_Tracker_t* tracker = ifx_tracker_create(&config);
+    if (!tracker)
+        return 0;
+
+    test_seed(47);
+    uint32_t id_switches = 0;
+    uint32_t id_a = 0;
+    uint32_t id_b = 0;
+
+    for (uint32_t frame = 0; frame < NUM_FRAMES; frame++)
+    {
+        const ifx_Float_t t = frame * FRAME_PERIOD_S;
+        ifx_Tracker_Detection_t detections[2];
+        uint32_t num_detections = 0;
+        int32_t index_a = -1;
+
+        if (frame % 7 != 6)
+        {
+            index_a = (int32_t)num_detections;
+            detections[num_detections].range_m = 5.f + t + test_uniform(-0.1f, 0.1f);
+            detections[num_detections].speed_m_s = 1.f + test_uniform(-0.1f, 0.1f);
+            detections[num_detections].angle_deg = -10.f + 2.f * t + test_uniform(-1.f, 1.f);
+            num_detections++;
+        }
+        const int32_t index_b = (int32_t)num_detections;
+        detections[num_detections].range_m = 15.f - t + test_uniform(-0.1f, 0.1f);
+        detections[num_detections].speed_m_s = -1.f + test_uniform(-0.1f, 0.1f);
+        detections[num_detections].angle_deg = 10.f - 2.f * t + test_uniform(-1.f, 1.f);
+        num_detections++;
+
+        ifx_Tracker_Result_t result;
+        ifx_tracker_run(tracker, detections, num_detections, &result);
+        TEST_CHECK(result.num_tracks == 2);
+
+        memset(history[frame], 0, 2 * sizeof(ifx_Tracker_Track_t));
+        for (uint32_t i = 0; i < result.num_tracks && i < 2; i++)
+        {
+            const ifx_Tracker_Track_t* track = &result.tracks[i];
+            history[frame][i] = *track;
+            TEST_CHECK(track->state != IFX_TRACK_DELETED);
+
+            // identify the target by the sign of the filtered speed
+            uint32_t* id = (track->speed_m_s > 0) ? &id_a : &id_b;
+            if (*id == 0)
+                *id = track->id;
+            else if (*id != track->id)
+                id_switches++;
+
+            // the detections of a target go to its own track
+            if (track->id == id_a)
+                TEST_CHECK(track->detection == index_a);
+            else if (track->id == id_b)
+                TEST_CHECK(track->detection == index_b);
+        }
+    }
+
+    // the tracks follow the true trajectories
+    ifx_Tracker_Result_t result;
+    ifx_Tracker_Detection_t last[2] = {
+        {5.f + NUM_FRAMES * FRAME_PERIOD_S, 1.f, -10.f + 2.f * NUM_FRAMES * FRAME_PERIOD_S},
+        {15.f - NUM_FRAMES * FRAME_PERIOD_S, -1.f, 10.f - 2.f * NUM_FRAMES * FRAME_PERIOD_S}};
+    ifx_tracker_run(tracker, last, 2, &result);
+    const ifx_Tracker_Track_t* a = find_track(&result, id_a);
+    const ifx_Tracker_Track_t* b = find_track(&result, id_b);
+    TEST_CHECK(a != NULL && b != NULL);
+    if (a && b)
+    {
+        TEST_CHECK_NEAR(a->range_m, last[0].range_m, 0.2);
+        TEST_CHECK_NEAR(a->angle_deg, last[0].angle_deg, 2.0);
+        TEST_CHECK_NEAR(b->range_m, last[1].range_m, 0.2);
+        TEST_CHECK_NEAR(b->angle_deg, last[1].angle_deg, 2.0);
+        TEST_CHECK(a->state == IFX_TRACK_CONFIRMED && b->state == IFX_TRACK_CONFIRMED);
+    }
+
+    TEST_CHECK(id_a != 0 && id_b != 0 && id_a != id_b);
+    ifx_tracker_destroy(tracker);
+    return id_switches;
+}
+
+static void test_crossing(void)
+{
+    static ifx_Tracker_Track_t first[NUM_FRAMES][2];
+    static ifx_Tracker_Track_t second[NUM_FRAMES][2];
+
+    TEST_CHECK(run_crossing(first) == 0);
+    TEST_CHECK(run_crossing(second) == 0);
+    TEST_CHECK(memcmp(first, second, sizeof(first)) == 0);
+}
+
+static void test_invalid_config(void)
+{
+    ifx_Tracker_Config_t config = default_config();
+    config.confirm_hits = 0;
+    TEST_CHECK(ifx_tracker_create(&config) == NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    config = default_config();
+    config.model = (ifx_Tracker_Model_t)2;
+    TEST_CHECK(ifx_tracker_create(&config) == NULL);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_INVALID);
+
+    config = default_config();
+    ifx_Tracker_t* tracker = ifx_tracker_create(&config);
+    ifx_Tracker_Result_t result;
+    ifx_Tracker_Detection_t detections[9] = {{0}};
+    ifx_tracker_run(tracker, detections, 9, &result);
+    TEST_CHECK(ifx_error_get_and_clear() == IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+    ifx_tracker_destroy(tracker);
+}
+
+int main(void)
+{
+    test_life_cycle();
+    test_crossing();
+    test_invalid_config();
+    return TEST_RESULT();
+}
@@ -0,0 +1,113 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file log-decoder.cpp
+ *
+ * @brief This is a small tool that converts a binary log file written by the
+ *        asynchronous logger (see ifx_log_set_binary_file) into text.
+ *
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <iostream>
+
+#include <cstdlib>
+#include <fstream>
+
+#include <common/AsyncLogger.hpp>
+
+#include "argparse.h"
+
+static const char* const usage[] = {
+    "log-decoder [options] [[--] args]",
+    "log-decoder [options]",
+    nullptr,
+};
+
+int main(int argc, char* argv[])
+{
+    const char* input_path = nullptr;
+    const char* output_path = nullptr;
+
+    struct argparse_option options[] = {
+        OPT_HELP(),
+        OPT_GROUP("Options"),
+        OPT_STRING('i', "input", &input_path, "Path to the binary log file.", nullptr, 0, 0),
+        OPT_STRING('o', "output", &output_path, "Path to the generated text file (default: standard output).", nullptr, 0, 0),
+        OPT_END(),
+    };
+
+    struct argparse argparse;
+    argparse_init(&argparse, options, usage, 0);
+    argparse_describe(&argparse, "\nConverts a binary log file of the asynchronous logger into text.", "\n");
+    argc = argparse_parse(&argparse, argc, argv);
+
+    if (input_path == nullptr)
+    {
+        std::cout << "Error: Input file path is not set. Use the --input argument to set the binary log file." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input(input_path, std::ios::in | std::ios::binary);
+    if (!input.is_open())
+    {
+        std::cout << "Error: Could not open " << input_path << " for reading." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    bool ok;
+    if (output_path == nullptr)
+    {
+        ok = AsyncLogger::decode(input, std::cout);
+    }
+    else
+    {
+        std::ofstream output(output_path);
+        if (!output.is_open())
+        {
+            std::cout << "Error: Could not open " << output_path << " for writing." << std::endl;
+            return EXIT_FAILURE;
+        }
+        ok = AsyncLogger::decode(input, output);
+    }
+
+    if (!ok)
+    {
+        std::cout << "Error: " << input_path << " is not a valid binary log file or is truncated." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,534 @@
+"""
+Converts a Keras model into the model format of the native inference engine
+of the radar SDK (ifxAlgo/Inference.h), so the classifier can run next to
+the signal processing without TensorFlow.
+
+Usage:
+    python export_native_model.py saved_model/model.keras model.ifxn --softmax
+    python export_native_model.py saved_model/model.keras model_int8.ifxn --softmax \
+        --int8 --calibration calibration_data.npy
+
+Batch normalization layers are folded into the preceding convolution or
+dense layer, dropout layers are dropped. For int8 models the activation
+scales are taken from the maximum absolute values over the calibration
+inputs (an array of model inputs saved with numpy.save).
+
+The script evaluates the converted model with a numpy implementation of the
+engine (including the int8 arithmetic) and compares it with Keras on the
+calibration inputs (or random inputs), so a conversion error shows up before
+the file is deployed.
+"""
+
+import argparse
+import struct
+
+import numpy as np
+
+
+MAGIC = 0x4E584649
+VERSION = 1
+
+FLOAT32 = 0
+INT8 = 1
+
+CONV2D = 1
+DEPTHWISE_CONV2D = 2
+MAXPOOL2D = 3
+AVGPOOL2D = 4
+GLOBAL_AVGPOOL = 5
+DENSE = 6
+AFFINE = 7
+SOFTMAX = 8
+FLATTEN = 9
+
+ACTIVATION_NONE = 0
+ACTIVATION_RELU = 1
+
+PADDING = {"valid": 0, "same": 1}
+
+# layers whose output scale is the scale of their input
+SCALE_PRESERVING = (MAXPOOL2D, AVGPOOL2D, GLOBAL_AVGPOOL, FLATTEN, SOFTMAX)
+
+
+def to_numpy(value):
+    try:
+        import keras
+        return np.asarray(keras.ops.convert_to_numpy(value), dtype=np.float64)
+    except (ImportError, AttributeError):
+        return np.asarray(value, dtype=np.float64)
+
+
+def output_size(size, kernel, stride, padding):
+    if padding == "same":
+        return (size + stride - 1) // stride
+    return (size - kernel) // stride + 1
+
+
+def padding_before_after(size, kernel, stride, padding):
+    if padding != "same":
+        return 0, 0
+    out = output_size(size, kernel, stride, padding)
+    total = max((out - 1) * stride + kernel - size, 0)
+    return total // 2, total - total // 2
+
+
+class Layer:
+    """
+    One layer of the converted model
+    """
+
+    def __init__(self, layer_type, in_shape, out_shape, params=(), weights=None, bias=None):
+        self.type = layer_type
+        self.activation = ACTIVATION_NONE
+        self.in_shape = in_shape
+        self.out_shape = out_shape
+        self.params = list(params) + [0] * (6 - len(params))
+        self.weights = weights  # float64, affine layers: scale
+        self.bias = bias        # float64, affine layers: shift
+        self.out_scale = 1.0
+
+
+# ---------------------------------------------------------------------------
+# Keras model to layer list
+
+
+def flatten_keras_layers(model):
+    layers = []
+    for layer in model.layers:
+        if hasattr(layer, "layers") and not hasattr(layer, "kernel"):
+            layers.extend(flatten_keras_layers(layer))
+        else:
+            layers.append(layer)
+    return layers
+
+
+def input_shape_of(model):
+    shape = tuple(model.input_shape[1:])
+    if len(shape) == 1:
+        return (1, 1, shape[0])
+    if len(shape) == 2:
+        return (1, shape[0], shape[1])
+    if len(shape) == 3:
+        return shape
+    raise ValueError(f"unsupported input shape {model.input_shape}")
+
+
+def window_params(config, rank, key):
+    """
+    Returns (kernel height, kernel width, stride height, stride width) of a
+    1D or 2D convolution or pooling layer.
+    """
+    kernel = tuple(config[key]) if isinstance(config[key], (list, tuple)) else (config[key],) * rank
+    strides = config.get("strides") or kernel
+    strides = tuple(strides) if isinstance(strides, (list, tuple)) else (strides,) * rank
+    if rank == 1:
+        return 1, kernel[0], 1, strides[0]
+    return kernel[0], kernel[1], strides[0], strides[1]
+
+
+def window_layer(layer_type, shape, config, rank, key, channels, weights=None, bias=None):
+    kh, kw, sh, sw = window_params(config, rank, key)
+    padding = config.get("padding", "valid")
+    if padding not in PADDING:
+        raise ValueError(f"unsupported padding {padding}")
+    out = (output_size(shape[0], kh, sh, padding), output_size(shape[1], kw, sw, padding), channels)
+    params = [kh, kw, sh, sw, PADDING[padding]]
+    if layer_type == CONV2D:
+        params = [channels] + params
+    return Layer(layer_type, shape, out, params, weights, bias)
+
+
+def set_activation(layers, name, layer_name):
+    if name in ("linear", None):
+        return
+    if name == "relu" and layers and layers[-1].activation == ACTIVATION_NONE and layers[-1].type != SOFTMAX:
+        layers[-1].activation = ACTIVATION_RELU
+        return
+    if name == "softmax":
+        layers.append(Layer(SOFTMAX, layers[-1].out_shape, layers[-1].out_shape))
+        return
+    raise ValueError(f"unsupported activation {name} in layer {layer_name}")
+
+
+def fold_batch_norm(layers, shape, scale, shift):
+    """
+    Folds y = scale * x + shift into the previous layer if possible, otherwise
+    appends an affine layer.
+    """
+    previous = layers[-1] if layers else None
+    if previous is not None and previous.activation == ACTIVATION_NONE:
+        if previous.type in (CONV2D, DENSE):
+            previous.weights = previous.weights * scale.reshape((-1,) + (1,) * (previous.weights.ndim - 1))
+            previous.bias = previous.bias * scale + shift
+            return
+        if previous.type == DEPTHWISE_CONV2D:
+            previous.weights = previous.weights * scale
+            previous.bias = previous.bias * scale + shift
+            return
+        if previous.type == AFFINE:
+            previous.weights = previous.weights * scale
+            previous.bias = previous.bias * scale + shift
+            return
+    layers.append(Layer(AFFINE, shape, shape, (), scale, shift))
+
+
+def channel_vector(value, channels, layer_name):
+    value = to_numpy(value).reshape(-1)
+    if value.size == 1:
+        return np.full(channels, value[0])
+    if value.size == channels:
+        return value
+    raise ValueError(f"layer {layer_name}: only per channel statistics are supported")
+
+
+def convert(model):
+    """
+    Converts a Keras model into (input shape, list of layers)
+    """
+    input_shape = input_shape_of(model)
+    shape = input_shape
+    layers = []
+
+    for layer in flatten_keras_layers(model):
+        name = layer.__class__.__name__
+        config = layer.get_config()
+
+        if config.get("data_format", "channels_last") != "channels_last":
+            raise ValueError(f"layer {layer.name}: only channels_last is supported")
+        dilation = config.get("dilation_rate", 1)
+        if any(d != 1 for d in np.atleast_1d(dilation)):
+            raise ValueError(f"layer {layer.name}: dilation is not supported")
+
+        if name in ("InputLayer", "Dropout", "SpatialDropout1D", "SpatialDropout2D", "GaussianNoise"):
+            continue
+
+        if name == "Normalization":
+            if config.get("invert", False):
+                raise ValueError(f"layer {layer.name}: inverted normalization is not supported")
+            mean = channel_vector(layer.mean, shape[2], layer.name)
+            std = np.maximum(np.sqrt(channel_vector(layer.variance, shape[2], layer.name)), 1e-7)
+            fold_batch_norm(layers, shape, 1.0 / std, -mean / std)
+
+        elif name == "BatchNormalization":
+            weights = layer.get_weights()
+            gamma = weights.pop(0) if config.get("scale", True) else np.ones(shape[2])
+            beta = weights.pop(0) if config.get("center", True) else np.zeros(shape[2])
+            mean, variance = weights
+            scale = np.asarray(gamma, np.float64) / np.sqrt(np.asarray(variance, np.float64) + config["epsilon"])
+            fold_batch_norm(layers, shape, scale, np.asarray(beta, np.float64) - np.asarray(mean, np.float64) * scale)
+
+        elif name in ("Conv1D", "Conv2D"):
+            rank = 1 if name == "Conv1D" else 2
+            if config.get("groups", 1) != 1:
+                raise ValueError(f"layer {layer.name}: grouped convolutions are not supported")
+            kernel = to_numpy(layer.kernel)
+            if rank == 1:
+                kernel = kernel[np.newaxis]
+            # Keras: [kh][kw][cin][filters], engine: [filters][kh][kw][cin]
+            weights = np.transpose(kernel, (3, 0, 1, 2))
+            bias = to_numpy(layer.bias) if config.get("use_bias", True) else np.zeros(weights.shape[0])
+            layers.append(window_layer(CONV2D, shape, config, rank, "kernel_size", weights.shape[0], weights, bias))
+            set_activation(layers, config.get("activation"), layer.name)
+
+        elif name in ("DepthwiseConv1D", "DepthwiseConv2D"):
+            rank = 1 if name == "DepthwiseConv1D" else 2
+            if config.get("depth_multiplier", 1) != 1:
+                raise ValueError(f"layer {layer.name}: only a depth multiplier of 1 is supported")
+            kernel = to_numpy(layer.kernel)
+            if rank == 1:
+                kernel = kernel[np.newaxis]
+            # Keras: [kh][kw][c][1], engine: [kh][kw][c]
+            weights = kernel[..., 0]
+            bias = to_numpy(layer.bias) if config.get("use_bias", True) else np.zeros(shape[2])
+            layers.append(window_layer(DEPTHWISE_CONV2D, shape, config, rank, "kernel_size", shape[2], weights, bias))
+            set_activation(layers, config.get("activation"), layer.name)
+
+        elif name in ("MaxPooling1D", "MaxPool1D", "MaxPooling2D", "MaxPool2D"):
+            layers.append(window_layer(MAXPOOL2D, shape, config, 1 if "1D" in name else 2, "pool_size", shape[2]))
+
+        elif name in ("AveragePooling1D", "AvgPool1D", "AveragePooling2D", "AvgPool2D"):
+            layers.append(window_layer(AVGPOOL2D, shape, config, 1 if "1D" in name else 2, "pool_size", shape[2]))
+
+        elif name in ("GlobalAveragePooling1D", "GlobalAvgPool1D", "GlobalAveragePooling2D", "GlobalAvgPool2D"):
+            layers.append(Layer(GLOBAL_AVGPOOL, shape, (1, 1, shape[2])))
+
+        elif name == "Flatten":
+            layers.append(Layer(FLATTEN, shape, (1, 1, shape[0] * shape[1] * shape[2])))
+
+        elif name == "Dense":
+            if shape[0] != 1 or shape[1] != 1:
+                raise ValueError(f"layer {layer.name}: dense layers need a flattened input")
+            # Keras: [inputs][units], engine: [units][inputs]
+            weights = to_numpy(layer.kernel).T
+            bias = to_numpy(layer.bias) if config.get("use_bias", True) else np.zeros(weights.shape[0])
+            layers.append(Layer(DENSE, shape, (1, 1, weights.shape[0]), [weights.shape[0]], weights, bias))
+            set_activation(layers, config.get("activation"), layer.name)
+
+        elif name in ("Activation", "ReLU", "Softmax"):
+            activation = config.get("activation", name.lower())
+            if name == "ReLU" and (config.get("max_value") is not None or config.get("negative_slope", 0) != 0
+                                   or config.get("threshold", 0) != 0):
+                raise ValueError(f"layer {layer.name}: only plain ReLU is supported")
+            if activation == "relu" and (not layers or layers[-1].activation != ACTIVATION_NONE):
+                raise ValueError(f"layer {layer.name}: ReLU must follow a layer without activation")
+            set_activation(layers, activation, layer.name)
+
+        else:
+            raise ValueError(f"layer {layer.name}: unsupported layer type {name}")
+
+        if layers:
+            shape = layers[-1].out_shape
+
+    for i, layer in enumerate(layers[:-1]):
+        if layer.type == SOFTMAX:
+            raise ValueError(f"softmax is only supported as last layer (found at layer {i})")
+
+    return input_shape, layers
+
+
+# ---------------------------------------------------------------------------
+# Reference implementation of the engine
+
+
+def quantize(values, lower=-127):
+    """
+    Rounds half away from zero and saturates to [lower, 127] like the engine:
+    infinities saturate, NaN is quantized to 0.
+    """
+    values = np.asarray(values, np.float32)
+    values = np.nan_to_num(values, nan=0.0, posinf=127.0, neginf=float(lower))
+    rounded = np.sign(values) * np.floor(np.abs(values) + np.float32(0.5))
+    return np.clip(rounded, lower, 127).astype(np.int64)
+
+
+def windows(x, layer, fill):
+    """
+    Returns the (padded) input windows of a convolution or pooling layer as
+    array of shape (out height, out width, kernel height, kernel width, channels)
+    """
+    kh, kw, sh, sw = (layer.params[1:5] if layer.type == CONV2D else layer.params[0:4])
+    if layer.type == GLOBAL_AVGPOOL:
+        kh, kw, sh, sw = x.shape[0], x.shape[1], 1, 1
+    padding = "same" if (layer.params[5] if layer.type == CONV2D else layer.params[4]) == 1 else "valid"
+    if layer.type == GLOBAL_AVGPOOL:
+        padding = "valid"
+    pad_h = padding_before_after(x.shape[0], kh, sh, padding)
+    pad_w = padding_before_after(x.shape[1], kw, sw, padding)
+    padded = np.pad(x, (pad_h, pad_w, (0, 0)), constant_values=fill)
+    view = np.lib.stride_tricks.sliding_window_view(padded, (kh, kw), axis=(0, 1))[::sh, ::sw]
+    return np.moveaxis(view, 2, 4)
+
+
+def softmax_of(x):
+    e = np.exp(x - np.max(x))
+    return e / np.sum(e)
+
+
+def run_float(input_shape, layers, x, outputs=None):
+    """
+    Evaluates the model in floating point, optionally collecting the output
+    of every layer
+    """
+    x = np.asarray(x, np.float64).reshape(input_shape)
+    for layer in layers:
+        if layer.type == CONV2D:
+            x = np.tensordot(windows(x, layer, 0.0), layer.weights, axes=([2, 3, 4], [1, 2, 3])) + layer.bias
+        elif layer.type == DEPTHWISE_CONV2D:
+            x = np.sum(windows(x, layer, 0.0) * layer.weights, axis=(2, 3)) + layer.bias
+        elif layer.type == MAXPOOL2D:
+            x = np.max(windows(x, layer, -np.inf), axis=(2, 3))
+        elif layer.type in (AVGPOOL2D, GLOBAL_AVGPOOL):
+            x = np.nanmean(windows(x, layer, np.nan), axis=(2, 3))
+        elif layer.type == DENSE:
+            x = (layer.weights @ x.reshape(-1) + layer.bias).reshape(layer.out_shape)
+        elif layer.type == AFFINE:
+            x = x * layer.weights + layer.bias
+        elif layer.type == FLATTEN:
+            x = x.reshape(layer.out_shape)
+        elif layer.type == SOFTMAX:
+            x = softmax_of(x.reshape(-1)).reshape(layer.out_shape)
+        if layer.activation == ACTIVATION_RELU:
+            x = np.maximum(x, 0)
+        if outputs is not None:
+            outputs.append(x)
+    return x.reshape(-1)
+
+
+def quantize_weights(layer):
+    """
+    Per output channel symmetric quantization, returns (int8 weights, weight scales)
+    """
+    channel_axis = -1 if layer.type == DEPTHWISE_CONV2D else 0
+    weights = np.moveaxis(layer.weights, channel_axis, 0)
+    max_abs = np.max(np.abs(weights.reshape(weights.shape[0], -1)), axis=1)
+    scales = np.where(max_abs > 0, max_abs / 127, 1.0).astype(np.float32)
+    shape = (-1,) + (1,) * (weights.ndim - 1)
+    q = quantize(weights / scales.reshape(shape))
+    return np.moveaxis(q, 0, channel_axis), scales
+
+
+def quantize_model(input_shape, layers, calibration):
+    """
+    Sets the output scales of all layers from the calibration inputs and
+    returns the input scale
+    """
+    max_input = 0.0
+    max_outputs = np.zeros(len(layers))
+    for x in calibration:
+        outputs = []
+        run_float(input_shape, layers, x, outputs)
+        max_input = max(max_input, float(np.max(np.abs(x))))
+        max_outputs = np.maximum(max_outputs, [np.max(np.abs(o)) for o in outputs])
+
+    input_scale = np.float32(max(max_input, 1e-12) / 127)
+    scale = input_scale
+    for layer, max_output in zip(layers, max_outputs):
+        if layer.type in SCALE_PRESERVING:
+            layer.out_scale = scale
+        else:
+            layer.out_scale = np.float32(max(max_output, 1e-12) / 127)
+        scale = layer.out_scale
+    return input_scale
+
+
+def run_int8(input_shape, layers, input_scale, x):
+    """
+    Evaluates the model with the int8 arithmetic of the engine
+    """
+    x = np.asarray(x, np.float32).reshape(input_shape)
+    first = 0
+    if layers[0].type == AFFINE:
+        layer = layers[0]
+        lower = 0 if layer.activation == ACTIVATION_RELU else -127
+        a = np.float32(layer.weights / layer.out_scale)
+        b = np.float32(layer.bias / layer.out_scale)
+        q = quantize(x * a + b, lower)
+        scale = layer.out_scale
+        first = 1
+    else:
+        q = quantize(x * np.float32(1 / input_scale))
+        scale = input_scale
+
+    for layer in layers[first:]:
+        lower = 0 if layer.activation == ACTIVATION_RELU else -127
+        if layer.type in (CONV2D, DEPTHWISE_CONV2D, DENSE):
+            wq, ws = quantize_weights(layer)
+            bq = np.round(layer.bias / (np.float64(scale) * ws)).astype(np.int64)
+            if layer.type == CONV2D:
+                acc = np.tensordot(windows(q, layer, 0), wq, axes=([2, 3, 4], [1, 2, 3])) + bq
+            elif layer.type == DEPTHWISE_CONV2D:
+                acc = np.sum(windows(q, layer, 0) * wq, axis=(2, 3)) + bq
+            else:
+                acc = (wq @ q.reshape(-1) + bq).reshape(layer.out_shape)
+            q = quantize(acc.astype(np.float32) * np.float32(scale * ws / layer.out_scale), lower)
+        elif layer.type == MAXPOOL2D:
+            q = np.clip(np.max(windows(q.astype(np.float64), layer, -np.inf), axis=(2, 3)), lower, 127).astype(np.int64)
+        elif layer.type in (AVGPOOL2D, GLOBAL_AVGPOOL):
+            w = windows(q.astype(np.float64), layer, np.nan)
+            count = np.sum(~np.isnan(w[..., :1]), axis=(2, 3))
+            q = quantize(np.nansum(w, axis=(2, 3)).astype(np.float32) * (np.float32(1) / count.astype(np.float32)), lower)
+        elif layer.type == AFFINE:
+            a = np.float32(scale * layer.weights / layer.out_scale)
+            b = np.float32(layer.bias / layer.out_scale)
+            q = quantize(q.astype(np.float32) * a + b, lower)
+        elif layer.type == FLATTEN:
+            q = q.reshape(layer.out_shape)
+        scale = layer.out_scale
+
+    output = q.reshape(-1).astype(np.float32) * np.float32(scale)
+    if layers[-1].type == SOFTMAX:
+        output = softmax_of(output.astype(np.float64))
+    return output
+
+
+# ---------------------------------------------------------------------------
+# File format
+
+
+def serialize(input_shape, layers, data_type, input_scale=1.0):
+    data = bytearray(struct.pack("<IHHIIIIfI", MAGIC, VERSION, data_type, len(layers), *input_shape, input_scale, 0))
+
+    for layer in layers:
+        payload = b""
+        if layer.weights is not None:
+            if data_type == FLOAT32 or layer.type == AFFINE:
+                payload = layer.weights.astype("<f4").tobytes() + layer.bias.astype("<f4").tobytes()
+            else:
+                in_scale = np.float64(layer.in_scale)
+                wq, ws = quantize_weights(layer)
+                weights = wq.astype(np.int8).tobytes()
+                weights += b"\0" * (-len(weights) % 4)
+                bias = np.clip(np.round(layer.bias / (in_scale * ws)), -2**31, 2**31 - 1).astype("<i4")
+                payload = weights + bias.tobytes() + ws.astype("<f4").tobytes()
+
+        data += struct.pack("<HH6IfI", layer.type, layer.activation, *layer.params, layer.out_scale, len(payload))
+        data += payload
+
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a Keras model for the native inference engine of the radar SDK")
+    parser.add_argument("model", help="Keras model (.keras or .h5)")
+    parser.add_argument("output", help="converted model")
+    parser.add_argument("--softmax", action="store_true", help="append a softmax layer (as done in decider.py)")
+    parser.add_argument("--int8", action="store_true", help="quantize weights and activations to 8 bits")
+    parser.add_argument("--calibration", help="numpy file with representative model inputs (required for --int8)")
+    parser.add_argument("--check", type=int, default=20, help="number of inputs to compare against Keras")
+    parser.add_argument("--reference", help="write the check inputs, the outputs of the converted model and the Keras "
+                                            "outputs to this file (float32, for regression tests of the engine)")
+    args = parser.parse_args()
+
+    import keras
+
+    model = keras.models.load_model(args.model)
+    input_shape, layers = convert(model)
+    append_softmax = args.softmax and layers[-1].type != SOFTMAX
+    if append_softmax:
+        layers.append(Layer(SOFTMAX, layers[-1].out_shape, layers[-1].out_shape))
+
+    if args.calibration:
+        calibration = np.load(args.calibration).astype(np.float32)
+    else:
+        calibration = np.random.default_rng(0).standard_normal((max(args.check, 1),) + model.input_shape[1:]).astype(np.float32)
+    if args.int8 and not args.calibration:
+        parser.error("--int8 requires --calibration")
+
+    data_type = INT8 if args.int8 else FLOAT32
+    input_scale = 1.0
+    if args.int8:
+        input_scale = quantize_model(input_shape, layers, calibration)
+
+    scale = input_scale
+    for i, layer in enumerate(layers):
+        # an affine first layer of an int8 model is applied to the float input
+        layer.in_scale = 1.0 if (i == 0 and layer.type == AFFINE) else scale
+        scale = layer.out_scale
+
+    with open(args.output, "wb") as file:
+        file.write(serialize(input_shape, layers, data_type, input_scale))
+
+    samples = calibration[:args.check]
+    expected = np.asarray(model.predict(samples, verbose=0)).reshape(len(samples), -1)
+    if append_softmax:
+        expected = np.exp(expected - expected.max(axis=1, keepdims=True))
+        expected /= expected.sum(axis=1, keepdims=True)
+
+    outputs = np.array([run_float(input_shape, layers, x) for x in samples])
+    float_error = np.max(np.abs(outputs - expected))
+    print(f"{len(layers)} layers, input shape {input_shape}, max float deviation from Keras {float_error:.3g}")
+
+    if args.int8:
+        outputs = np.array([run_int8(input_shape, layers, input_scale, x) for x in samples])
+        int8_error = np.max(np.abs(outputs - expected))
+        agreement = np.mean(np.argmax(outputs, axis=1) == np.argmax(expected, axis=1))
+        print(f"max int8 deviation from Keras {int8_error:.3g}, same class for {agreement:.1%} of the inputs")
+
+    if args.reference:
+        with open(args.reference, "wb") as file:
+            for values in (samples, outputs, expected):
+                file.write(np.asarray(values, "<f4").tobytes())
+
+
+if __name__ == "__main__":
+    main()
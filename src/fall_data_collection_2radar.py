@@ -10,6 +10,8 @@
 # py .\src\fall_data_collection_2radar.py <sub-directory name>
 
 from ifxradarsdk import get_version_full
+from ifxradarsdk.common.exceptions import ErrorFifoOverflow
+from ifxradarsdk.common.prefetch import OverflowPolicy
 from ifxradarsdk.fmcw import DeviceFmcw
 from ifxradarsdk.fmcw.types import FmcwSimpleSequenceConfig, FmcwSequenceChirp, create_dict_from_sequence
 import numpy as np
@@ -133,15 +135,26 @@ while True:
     # AQUISITION SEQUENCE
     device1.start_acquisition()
     device2.start_acquisition()
-    while not keyboard.is_pressed('s'):
-        # the recording has been started. On each loop, collect a single frame of data.
-        frame_shell = device1.get_next_frame()
-        frame = frame_shell[0]
-        Recording['frames_R1'].append(frame) # frames_R1 means that the frames are for the first radar
-
-        frame_shell = device2.get_next_frame()
-        frame = frame_shell[0]
-        Recording['frames_R2'].append(frame)
+    # both radars are read in background threads, so acquiring from one does not block the other.
+    # a full queue blocks the prefetcher instead of dropping frames, so a recording never has gaps;
+    # if the radar's own buffer overflows as well, get raises ErrorFifoOverflow and the recording is discarded
+    try:
+        with device1.prefetch(queue_depth=64, overflow=OverflowPolicy.BLOCK) as frames1, \
+             device2.prefetch(queue_depth=64, overflow=OverflowPolicy.BLOCK) as frames2:
+            while not keyboard.is_pressed('s'):
+                # the recording has been started. On each loop, collect a single frame of data.
+                frame_shell = frames1.get()
+                frame = frame_shell[0]
+                Recording['frames_R1'].append(frame) # frames_R1 means that the frames are for the first radar
+
+                frame_shell = frames2.get()
+                frame = frame_shell[0]
+                Recording['frames_R2'].append(frame)
+    except ErrorFifoOverflow as e:
+        device1.stop_acquisition()
+        device2.stop_acquisition()
+        print(f"Frames were lost, recording discarded: {e}")
+        continue
 
     device1.stop_acquisition()
     device2.stop_acquisition()